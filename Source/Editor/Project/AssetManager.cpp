@@ -109,7 +109,10 @@ AssetManager::AssetManager(Context* context)
     : Object(context)
     , project_(GetSubsystem<Project>())
     , dataWatcher_(MakeShared<FileWatcher>(context))
+    , derivedDataCache_(MakeShared<DerivedDataCache>(context))
 {
+    derivedDataCache_->SetLocalBackend(
+        MakeShared<DirectoryDerivedDataBackend>(context, project_->GetProjectPath() + "Temp/DerivedData/"));
     for (const bool isPostTransform : {false, true})
         transformerHierarchy_[isPostTransform] = MakeShared<AssetTransformerHierarchy>(context_, isPostTransform);
 
@@ -712,7 +715,7 @@ ea::optional<AssetTransformerOutput> AssetManager::ProcessAsset(const AssetTrans
         transformerHierarchy_[input.isPostTransform_]->GetTransformerCandidates(input.resourceName_, input.flavor_);
 
     AssetTransformerOutput output;
-    if (AssetTransformer::ExecuteTransformersAndStore(input, cachePath, output, transformers))
+    if (AssetTransformer::ExecuteTransformersAndStore(input, cachePath, output, transformers, derivedDataCache_))
         return output;
     else
         return ea::nullopt;
@@ -28,6 +28,7 @@
 #include <Urho3D/Scene/Serializable.h>
 #include <Urho3D/Utility/AssetPipeline.h>
 #include <Urho3D/Utility/AssetTransformerHierarchy.h>
+#include <Urho3D/Utility/DerivedDataCache.h>
 
 #include <EASTL/array.h>
 #include <EASTL/functional.h>
@@ -78,6 +79,8 @@ public:
     ProgressInfo GetProgress() const { return progress_; }
     /// Return whether asset manager is currently processing assets.
     bool IsProcessing() const { return !requestQueue_.empty() || numOngoingRequests_ != 0; }
+    /// Return cache of asset processing results. Remote backend may be configured by plugins.
+    DerivedDataCache* GetDerivedDataCache() const { return derivedDataCache_; }
 
     /// Serialize
     /// @{
@@ -176,6 +179,7 @@ private:
 
     const WeakPtr<Project> project_;
     SharedPtr<FileWatcher> dataWatcher_;
+    SharedPtr<DerivedDataCache> derivedDataCache_;
 
     OnProcessAssetQueued processCallback_;
     unsigned maxConcurrentRequests_{};
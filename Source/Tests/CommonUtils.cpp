@@ -27,6 +27,7 @@
 #include "Urho3D/Input/Input.h"
 
 #include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/Engine/Engine.h>
 #include <Urho3D/Engine/EngineDefs.h>
 #include <Urho3D/IO/IOEvents.h>
@@ -35,6 +36,8 @@
 #include <Urho3D/Resource/XMLFile.h>
 #include <Urho3D/Scene/Serializable.h>
 
+#include <EASTL/optional.h>
+
 #include <iostream>
 
 namespace Tests
@@ -51,6 +54,30 @@ void PrintError(VariantMap& args)
     }
 }
 
+SharedPtr<Context> CreateEngineContext(ea::optional<unsigned> numWorkerThreads)
+{
+    auto context = MakeShared<Context>();
+    auto engine = new Engine(context);
+
+    // Engine doesn't change number of threads if WorkQueue is already initialized
+    if (numWorkerThreads)
+        context->GetSubsystem<WorkQueue>()->Initialize(*numWorkerThreads);
+
+    auto fs = context->GetSubsystem<FileSystem>();
+    auto exeDir = GetParentPath(fs->GetProgramFileName());
+    StringVariantMap parameters;
+    parameters[EP_HEADLESS] = true;
+    parameters[EP_LOG_QUIET] = true;
+    parameters[EP_RESOURCE_PATHS] = "CoreData;Data";
+    parameters[EP_RESOURCE_PREFIX_PATHS] = Format("{};{}", exeDir, GetParentPath(exeDir));
+    parameters[EP_LOG_NAME] = "";
+    const bool engineInitialized = engine->Initialize(parameters, {});
+
+    engine->SubscribeToEvent(E_LOGMESSAGE, PrintError);
+    REQUIRE(engineInitialized);
+    return context;
+}
+
 }
 
 static SharedPtr<Context> sharedContext;
@@ -76,21 +103,18 @@ void ResetContext()
 
 SharedPtr<Context> CreateCompleteContext()
 {
-    auto context = MakeShared<Context>();
-    auto engine = new Engine(context);
-    auto fs = context->GetSubsystem<FileSystem>();
-    auto exeDir = GetParentPath(fs->GetProgramFileName());
-    StringVariantMap parameters;
-    parameters[EP_HEADLESS] = true;
-    parameters[EP_LOG_QUIET] = true;
-    parameters[EP_RESOURCE_PATHS] = "CoreData;Data";
-    parameters[EP_RESOURCE_PREFIX_PATHS] = Format("{};{}", exeDir, GetParentPath(exeDir));
-    parameters[EP_LOG_NAME] = "";
-    const bool engineInitialized = engine->Initialize(parameters, {});
+    return CreateEngineContext(ea::nullopt);
+}
 
-    engine->SubscribeToEvent(E_LOGMESSAGE, PrintError);
-    REQUIRE(engineInitialized);
-    return context;
+SharedPtr<Context> CreateThreadedContext()
+{
+    static constexpr unsigned numWorkerThreads = 3;
+    return CreateEngineContext(numWorkerThreads);
+}
+
+void PrintBenchmarkResult(const ea::string& message)
+{
+    std::cout << message.c_str() << std::endl;
 }
 
 void RunFrame(Context* context, float timeStep, float maxTimeStep)
@@ -58,6 +58,12 @@ void ResetContext();
 /// Create test context with all subsystems ready.
 SharedPtr<Context> CreateCompleteContext();
 
+/// Create test context with all subsystems ready and worker threads, regardless of the number of CPU cores.
+SharedPtr<Context> CreateThreadedContext();
+
+/// Print benchmark result to standard output. Only errors are printed from the log in tests.
+void PrintBenchmarkResult(const ea::string& message);
+
 /// Run frame with given time step.
 void RunFrame(Context* context, float timeStep, float maxTimeStep = M_LARGE_VALUE);
 
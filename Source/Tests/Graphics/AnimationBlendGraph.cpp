@@ -0,0 +1,296 @@
+// Copyright (c) 2024-2025 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../ModelUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Graphics/Animation.h>
+#include <Urho3D/Graphics/AnimationBlendGraph.h>
+#include <Urho3D/Graphics/Model.h>
+
+namespace
+{
+
+/// Create animation that moves bone from one position to another over one second.
+Animation* GetOrCreateMoveAnimation(
+    Context* context, const ea::string& name, const ea::string& boneName, const Vector3& from, const Vector3& to)
+{
+    return Tests::GetOrCreateResource<Animation>(context, name,
+        [&](Context* context)
+    {
+        auto animation = MakeShared<Animation>(context);
+        animation->SetLength(1.0f);
+
+        AnimationTrack* track = animation->CreateTrack(boneName);
+        track->channelMask_ = CHANNEL_POSITION;
+        track->AddKeyFrame(Tests::MakeTranslationKeyFrame(0.0f, from));
+        track->AddKeyFrame(Tests::MakeTranslationKeyFrame(1.0f, to));
+        return animation;
+    });
+}
+
+AnimationBlendNode MakeClipNode(const ea::string& animation, bool looped = true)
+{
+    AnimationBlendNode node;
+    node.type_ = AnimationBlendNodeType::Clip;
+    node.animation_ = animation;
+    node.looped_ = looped;
+    return node;
+}
+
+AnimationBlendNode MakeBinaryNode(AnimationBlendNodeType type, unsigned lhs, unsigned rhs, const ea::string& parameter)
+{
+    AnimationBlendNode node;
+    node.type_ = type;
+    node.inputs_ = {lhs, rhs};
+    node.parameter_ = parameter;
+    return node;
+}
+
+}
+
+TEST_CASE("Animation blend graph blends clips in blend spaces")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto model = Tests::CreateSkinnedQuad_Model(context)->ExportModel();
+    const Skeleton& skeleton = model->GetSkeleton();
+
+    const Vector3 offset{0.0f, 1.0f, 0.0f};
+    GetOrCreateMoveAnimation(context, "@/BlendGraph/Left.ani", "Quad 2", offset - Vector3::RIGHT, offset - Vector3::RIGHT);
+    GetOrCreateMoveAnimation(context, "@/BlendGraph/Right.ani", "Quad 2", offset + Vector3::RIGHT, offset + Vector3::RIGHT);
+    GetOrCreateMoveAnimation(context, "@/BlendGraph/Back.ani", "Quad 2", offset - Vector3::FORWARD, offset - Vector3::FORWARD);
+    GetOrCreateMoveAnimation(context, "@/BlendGraph/Forward.ani", "Quad 2", offset + Vector3::FORWARD, offset + Vector3::FORWARD);
+
+    SECTION("1D blend space")
+    {
+        auto graph = MakeShared<AnimationBlendGraph>(context);
+        const unsigned right = graph->AddNode(MakeClipNode("@/BlendGraph/Right.ani"));
+        const unsigned left = graph->AddNode(MakeClipNode("@/BlendGraph/Left.ani"));
+
+        AnimationBlendNode blendSpace;
+        blendSpace.type_ = AnimationBlendNodeType::BlendSpace1D;
+        blendSpace.inputs_ = {right, left};
+        blendSpace.positions_ = {Vector2{1.0f, 0.0f}, Vector2{-1.0f, 0.0f}};
+        blendSpace.parameter_ = "X";
+        graph->SetRootNode(graph->AddNode(blendSpace));
+
+        AnimationBlendGraphInstance instance(graph, skeleton);
+        REQUIRE(instance.IsValid());
+
+        instance.SetParameter("X", -1.0f);
+        instance.Update(0.0f);
+        REQUIRE(instance.GetPose().size() == 3);
+        CHECK(instance.GetPose()[2].position_.Equals(offset - Vector3::RIGHT));
+        CHECK(instance.GetPose()[1].position_.Equals(Vector3::ZERO));
+
+        instance.SetParameter("X", 0.5f);
+        instance.Update(0.0f);
+        CHECK(instance.GetPose()[2].position_.Equals(offset + Vector3::RIGHT * 0.5f));
+
+        instance.SetParameter("X", 10.0f);
+        instance.Update(0.0f);
+        CHECK(instance.GetPose()[2].position_.Equals(offset + Vector3::RIGHT));
+    }
+
+    SECTION("2D blend space")
+    {
+        auto graph = MakeShared<AnimationBlendGraph>(context);
+        AnimationBlendNode blendSpace;
+        blendSpace.type_ = AnimationBlendNodeType::BlendSpace2D;
+        blendSpace.inputs_ = {
+            graph->AddNode(MakeClipNode("@/BlendGraph/Left.ani")),
+            graph->AddNode(MakeClipNode("@/BlendGraph/Right.ani")),
+            graph->AddNode(MakeClipNode("@/BlendGraph/Back.ani")),
+            graph->AddNode(MakeClipNode("@/BlendGraph/Forward.ani")),
+        };
+        blendSpace.positions_ = {Vector2::LEFT, Vector2::RIGHT, Vector2::DOWN, Vector2::UP};
+        blendSpace.parameter_ = "X";
+        blendSpace.parameterY_ = "Y";
+        graph->SetRootNode(graph->AddNode(blendSpace));
+
+        AnimationBlendGraphInstance instance(graph, skeleton);
+        REQUIRE(instance.IsValid());
+
+        instance.Update(0.0f);
+        CHECK(instance.GetPose()[2].position_.Equals(offset));
+
+        instance.SetParameter("X", 1.0f);
+        instance.Update(0.0f);
+        CHECK(instance.GetPose()[2].position_.Equals(offset + Vector3::RIGHT));
+
+        instance.SetParameter("X", 0.0f);
+        instance.SetParameter("Y", -1.0f);
+        instance.Update(0.0f);
+        CHECK(instance.GetPose()[2].position_.Equals(offset - Vector3::FORWARD));
+    }
+}
+
+TEST_CASE("Animation blend graph applies additive clips, masked layers and crossfades")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto model = Tests::CreateSkinnedQuad_Model(context)->ExportModel();
+    const Skeleton& skeleton = model->GetSkeleton();
+
+    const Vector3 offset{0.0f, 1.0f, 0.0f};
+    GetOrCreateMoveAnimation(context, "@/BlendGraph/Base.ani", "Quad 2", offset, offset);
+    GetOrCreateMoveAnimation(context, "@/BlendGraph/Lift.ani", "Quad 2", Vector3::ZERO, Vector3::UP * 2.0f);
+    Tests::GetOrCreateResource<Animation>(context, "@/BlendGraph/Layer.ani",
+        [&](Context* context)
+    {
+        auto quad1 = Tests::CreateLoopedTranslationAnimation(context, "", "Quad 1", Vector3::ONE, Vector3::ZERO, 1.0f);
+        auto quad2 = Tests::CreateLoopedTranslationAnimation(context, "", "Quad 2", Vector3::ONE * 2.0f, Vector3::ZERO, 1.0f);
+        return Tests::CreateCombinedAnimation(context, "", {quad1, quad2});
+    });
+
+    SECTION("Additive clip")
+    {
+        auto graph = MakeShared<AnimationBlendGraph>(context);
+        const unsigned base = graph->AddNode(MakeClipNode("@/BlendGraph/Base.ani"));
+        const unsigned lift = graph->AddNode(MakeClipNode("@/BlendGraph/Lift.ani", false));
+        graph->SetRootNode(graph->AddNode(MakeBinaryNode(AnimationBlendNodeType::Additive, base, lift, "Weight")));
+
+        AnimationBlendGraphInstance instance(graph, skeleton);
+        REQUIRE(instance.IsValid());
+
+        instance.SetParameter("Weight", 1.0f);
+        instance.Update(0.5f);
+        CHECK(instance.GetPose()[2].position_.Equals(offset + Vector3::UP));
+
+        instance.SetParameter("Weight", 0.5f);
+        instance.Update(0.5f);
+        CHECK(instance.GetPose()[2].position_.Equals(offset + Vector3::UP));
+
+        // Non-looped clip is clamped at the end
+        instance.SetParameter("Weight", 1.0f);
+        instance.Update(10.0f);
+        CHECK(instance.GetPose()[2].position_.Equals(offset + Vector3::UP * 2.0f));
+    }
+
+    SECTION("Masked layer")
+    {
+        auto graph = MakeShared<AnimationBlendGraph>(context);
+        const unsigned base = graph->AddNode(MakeClipNode("@/BlendGraph/Base.ani"));
+        const unsigned layer = graph->AddNode(MakeClipNode("@/BlendGraph/Layer.ani"));
+        AnimationBlendNode maskedLayer = MakeBinaryNode(AnimationBlendNodeType::MaskedLayer, base, layer, "");
+        maskedLayer.maskBone_ = "Quad 2";
+        graph->SetRootNode(graph->AddNode(maskedLayer));
+
+        AnimationBlendGraphInstance instance(graph, skeleton);
+        REQUIRE(instance.IsValid());
+
+        instance.Update(0.0f);
+        CHECK(instance.GetPose()[1].position_.Equals(Vector3::ZERO));
+        CHECK(instance.GetPose()[2].position_.Equals(Vector3::ONE * 2.0f));
+    }
+
+    SECTION("Crossfade")
+    {
+        auto graph = MakeShared<AnimationBlendGraph>(context);
+        const unsigned base = graph->AddNode(MakeClipNode("@/BlendGraph/Base.ani"));
+        const unsigned layer = graph->AddNode(MakeClipNode("@/BlendGraph/Layer.ani"));
+        AnimationBlendNode crossfade = MakeBinaryNode(AnimationBlendNodeType::Crossfade, base, layer, "Target");
+        crossfade.duration_ = 1.0f;
+        graph->SetRootNode(graph->AddNode(crossfade));
+
+        AnimationBlendGraphInstance instance(graph, skeleton);
+        REQUIRE(instance.IsValid());
+
+        instance.Update(0.0f);
+        CHECK(instance.GetPose()[2].position_.Equals(offset));
+
+        instance.SetParameter("Target", 1.0f);
+        instance.Update(0.25f);
+        CHECK(instance.GetPose()[1].position_.Equals(Vector3::ONE * 0.25f));
+        CHECK(instance.GetPose()[2].position_.Equals(offset.Lerp(Vector3::ONE * 2.0f, 0.25f)));
+
+        instance.Update(1.0f);
+        CHECK(instance.GetPose()[1].position_.Equals(Vector3::ONE));
+
+        instance.SetParameter("Target", 0.0f);
+        instance.Update(0.5f);
+        CHECK(instance.GetPose()[1].position_.Equals(Vector3::ONE * 0.5f));
+    }
+}
+
+TEST_CASE("Animation blend graph is compiled into compact program")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const Vector3 offset{0.0f, 1.0f, 0.0f};
+    GetOrCreateMoveAnimation(context, "@/BlendGraph/Base.ani", "Quad 2", offset, offset);
+    GetOrCreateMoveAnimation(context, "@/BlendGraph/Lift.ani", "Quad 2", Vector3::ZERO, Vector3::UP * 2.0f);
+
+    auto graph = MakeShared<AnimationBlendGraph>(context);
+    const unsigned base = graph->AddNode(MakeClipNode("@/BlendGraph/Base.ani"));
+    const unsigned lift = graph->AddNode(MakeClipNode("@/BlendGraph/Lift.ani"));
+    const unsigned additive = graph->AddNode(MakeBinaryNode(AnimationBlendNodeType::Additive, base, lift, ""));
+    const unsigned crossfade = graph->AddNode(MakeBinaryNode(AnimationBlendNodeType::Crossfade, base, additive, "A"));
+    graph->SetRootNode(crossfade);
+
+    AnimationBlendProgram* program = graph->GetProgram();
+    REQUIRE(program);
+    CHECK(program->clips_.size() == 2);
+    CHECK(program->parameters_.size() == 1);
+    CHECK(program->numRegisters_ == 3);
+    CHECK(program->instructions_.size() == 5);
+
+    // Cycles are rejected
+    const unsigned cyclic = graph->GetNodes().size();
+    graph->SetRootNode(graph->AddNode(MakeBinaryNode(AnimationBlendNodeType::Crossfade, base, cyclic, "A")));
+    CHECK(graph->GetProgram() == nullptr);
+}
+
+TEST_CASE("Many animation blend graphs are evaluated each frame")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto model = Tests::CreateSkinnedQuad_Model(context)->ExportModel();
+    const Skeleton& skeleton = model->GetSkeleton();
+
+    const Vector3 offset{0.0f, 1.0f, 0.0f};
+    GetOrCreateMoveAnimation(context, "@/BlendGraph/Left.ani", "Quad 2", offset - Vector3::RIGHT, offset - Vector3::RIGHT);
+    GetOrCreateMoveAnimation(context, "@/BlendGraph/Right.ani", "Quad 2", offset + Vector3::RIGHT, offset + Vector3::RIGHT);
+    GetOrCreateMoveAnimation(context, "@/BlendGraph/Lift.ani", "Quad 2", Vector3::ZERO, Vector3::UP * 2.0f);
+
+    auto graph = MakeShared<AnimationBlendGraph>(context);
+    AnimationBlendNode blendSpace;
+    blendSpace.type_ = AnimationBlendNodeType::BlendSpace1D;
+    blendSpace.inputs_ = {
+        graph->AddNode(MakeClipNode("@/BlendGraph/Left.ani")),
+        graph->AddNode(MakeClipNode("@/BlendGraph/Right.ani")),
+    };
+    blendSpace.positions_ = {Vector2{-1.0f, 0.0f}, Vector2{1.0f, 0.0f}};
+    blendSpace.parameter_ = "X";
+    const unsigned locomotion = graph->AddNode(blendSpace);
+    const unsigned lift = graph->AddNode(MakeClipNode("@/BlendGraph/Lift.ani"));
+    graph->SetRootNode(graph->AddNode(MakeBinaryNode(AnimationBlendNodeType::Additive, locomotion, lift, "")));
+
+    static constexpr unsigned numInstances = 1000;
+    static constexpr unsigned numFrames = 30;
+    ea::vector<ea::unique_ptr<AnimationBlendGraphInstance>> instances;
+    for (unsigned i = 0; i < numInstances; ++i)
+    {
+        instances.push_back(ea::make_unique<AnimationBlendGraphInstance>(graph, skeleton));
+        instances.back()->SetParameter("X", i % 2 == 0 ? -1.0f : 1.0f);
+    }
+
+    HiresTimer timer;
+    for (unsigned frame = 0; frame < numFrames; ++frame)
+    {
+        for (const auto& instance : instances)
+            instance->Update(1.0f / 60.0f);
+    }
+    const long long elapsedUs = timer.GetUSec(false);
+
+    Tests::PrintBenchmarkResult(Format("Animation blend graph: {} instances for {} frames, {:.3f} ms per frame, "
+                                       "{:.0f} evaluations/s",
+        numInstances, numFrames, elapsedUs / 1000.0 / numFrames,
+        numInstances * numFrames * 1000000.0 / ea::max(elapsedUs, 1ll)));
+
+    // After half a second the lift clip is in the middle
+    for (unsigned i = 0; i < numInstances; ++i)
+    {
+        const Vector3 expected = offset + Vector3::UP + (i % 2 == 0 ? -Vector3::RIGHT : Vector3::RIGHT);
+        REQUIRE(instances[i]->GetPose()[2].position_.Equals(expected, 0.01f));
+    }
+}
@@ -27,15 +27,60 @@
 
 #include <Urho3D/Particles/ParticleGraphLayer.h>
 #include <Urho3D/Particles/ParticleGraphLayerInstance.h>
+#include <Urho3D/Particles/ParticleGraphSystem.h>
+#include <Urho3D/Particles/SignedDistanceField.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Graphics/BillboardSet.h>
 #include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Graphics/Model.h>
 #include <Urho3D/Resource/ResourceCache.h>
 #include <Urho3D/Particles/ParticleGraphEffect.h>
 #include <Urho3D/Particles/All.h>
 #include <Urho3D/Scene/Scene.h>
+#include <EASTL/sort.h>
 #include <EASTL/variant.h>
 
 using namespace Urho3D;
 
+namespace
+{
+
+/// Create triangles of axis-aligned cube with outward facing normals.
+ea::vector<Vector3> CreateCubeTriangles(float halfSize)
+{
+    const Vector3 normals[] = {Vector3::RIGHT, Vector3::LEFT, Vector3::UP, Vector3::DOWN, Vector3::FORWARD, Vector3::BACK};
+
+    ea::vector<Vector3> triangles;
+    for (const Vector3& normal : normals)
+    {
+        const Vector3 u = Abs(normal.y_) > 0.5f ? Vector3::FORWARD : Vector3::UP;
+        const Vector3 v = normal.CrossProduct(u);
+        // Make sure that (u x v) points along the normal.
+        const Vector3 side = u.CrossProduct(v).DotProduct(normal) > 0.0f ? v : -v;
+        const Vector3 center = normal * halfSize;
+        const Vector3 p0 = center + (-u - side) * halfSize;
+        const Vector3 p1 = center + (u - side) * halfSize;
+        const Vector3 p2 = center + (u + side) * halfSize;
+        const Vector3 p3 = center + (-u + side) * halfSize;
+        triangles.insert(triangles.end(), {p0, p1, p2, p0, p2, p3});
+    }
+    return triangles;
+}
+
+/// Return exact signed distance to axis-aligned cube.
+float CubeDistance(const Vector3& position, float halfSize)
+{
+    const Vector3 q = position.Abs() - Vector3::ONE * halfSize;
+    const float outside = VectorMax(q, Vector3::ZERO).Length();
+    const float inside = Min(Max(q.x_, Max(q.y_, q.z_)), 0.0f);
+    return outside + inside;
+}
+
+}
+
 TEST_CASE("Test particle graph serialization")
 {
     auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
@@ -180,7 +225,20 @@ TEST_CASE("Test simple particle graph")
     CHECK(emitter->EmitNewParticle(0));
 
     Tests::RunFrame(context, 0.1f, 0.1f);
-    //emitter->Tick(0.1f);
+
+    BillboardSet* billboardSet = nullptr;
+    for (Drawable* drawable : scene->GetComponent<Octree>()->GetAllDrawables())
+    {
+        if (auto drawableBillboardSet = dynamic_cast<BillboardSet*>(drawable))
+            billboardSet = drawableBillboardSet;
+    }
+    REQUIRE(billboardSet);
+    CHECK(billboardSet->GetNumBillboards() == 1);
+
+    // Manual update applies results to drawables too
+    CHECK(emitter->EmitNewParticle(0));
+    emitter->Tick(0.1f);
+    CHECK(billboardSet->GetNumBillboards() == 2);
 
     auto l = emitter->GetLayer(0);
     //auto sizeMem = l->GetAttributeMemory(0);
@@ -492,3 +550,576 @@ TEST_CASE("Test Make IntVector2")
     auto attributeSpan = emitter->GetLayer(0)->GetAttributeValues<IntVector2>(0);
     CHECK(attributeSpan[0] == IntVector2(2, 3));
 }
+
+TEST_CASE("Test chunked element-wise nodes")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto effect = MakeShared<ParticleGraphEffect>(context);
+    auto xml = R"(<particleGraphEffect>
+    <layers>
+	    <layer type="ParticleGraphLayer" capacity="1000">
+		    <emit>
+			    <nodes>
+			    </nodes>
+		    </emit>
+		    <init>
+			    <nodes>
+				    <node id="1" name="Constant">
+					    <properties>
+						    <property name="Value" type="float" value="1" />
+					    </properties>
+					    <out>
+						    <pin type="float" name="out" />
+					    </out>
+				    </node>
+				    <node id="2" name="SetAttribute">
+					    <in>
+						    <pin type="float" name="" node="1" pin="out" />
+					    </in>
+					    <out>
+						    <pin type="float" name="value" />
+					    </out>
+				    </node>
+			    </nodes>
+		    </init>
+		    <update>
+			    <nodes>
+				    <node id="3" name="GetAttribute">
+					    <out>
+						    <pin type="float" name="value" />
+					    </out>
+				    </node>
+				    <node id="4" name="Add">
+					    <in>
+						    <pin name="x" type="float" node="3" pin="value" />
+						    <pin name="y" type="float" value="2" />
+					    </in>
+					    <out>
+						    <pin name="out" type="float" />
+					    </out>
+				    </node>
+				    <node id="5" name="Multiply">
+					    <in>
+						    <pin name="x" type="float" node="4" pin="out" />
+						    <pin name="y" type="float" value="2" />
+					    </in>
+					    <out>
+						    <pin name="out" type="float" />
+					    </out>
+				    </node>
+				    <node id="6" name="SetAttribute">
+					    <in>
+						    <pin type="float" name="" node="5" pin="out" />
+					    </in>
+					    <out>
+						    <pin type="float" name="value" />
+					    </out>
+				    </node>
+			    </nodes>
+		    </update>
+	    </layer>
+    </layers>
+</particleGraphEffect>)";
+    MemoryBuffer buffer(xml);
+    REQUIRE(effect->Load(buffer));
+
+    const auto& updatePlan = effect->GetLayer(0)->GetUpdatePlan();
+    // Constants are executed before the chunked range.
+    REQUIRE(updatePlan.ranges_.size() == 2);
+    CHECK_FALSE(updatePlan.ranges_[0].chunked_);
+    CHECK(updatePlan.ranges_[1].chunked_);
+    CHECK(updatePlan.ranges_[1].numNodes_ == 4);
+
+    const auto scene = MakeShared<Scene>(context);
+    const auto node = scene->CreateChild();
+    auto emitter = node->CreateComponent<ParticleGraphEmitter>();
+    emitter->SetEffect(effect);
+    emitter->SetEmitting(false);
+
+    auto layer = emitter->GetLayer(0);
+    REQUIRE(layer->EmitNewParticles(1000.0f));
+    REQUIRE(layer->GetNumActiveParticles() == 1000);
+
+    auto values = layer->GetAttributeValues<float>(0);
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+        REQUIRE(values[i] == 1.0f);
+        values[i] = static_cast<float>(i);
+    }
+
+    Tests::RunFrame(context, 0.1f, 0.1f);
+
+    values = layer->GetAttributeValues<float>(0);
+    for (unsigned i = 0; i < 1000; ++i)
+        REQUIRE(values[i] == (static_cast<float>(i) + 2.0f) * 2.0f);
+}
+
+TEST_CASE("Chunked execution of element-wise nodes on sample effects", "[.benchmark]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+
+    static constexpr unsigned capacity = 100000;
+    static constexpr unsigned numFrames = 100;
+    static constexpr float timeStep = 1.0f / 60.0f;
+
+    // Other sample graph effects are stored in outdated format
+    for (const char* effectName : {"Particle/RealFire.xml"})
+    {
+        for (bool chunkingEnabled : {false, true})
+        {
+            const auto effect = cache->GetTempResource<ParticleGraphEffect>(effectName);
+            REQUIRE(effect);
+            for (unsigned i = 0; i < effect->GetNumLayers(); ++i)
+            {
+                effect->GetLayer(i)->SetCapacity(capacity);
+                effect->GetLayer(i)->SetChunkingEnabled(chunkingEnabled);
+            }
+
+            const auto scene = MakeShared<Scene>(context);
+            auto emitter = scene->CreateChild()->CreateComponent<ParticleGraphEmitter>();
+            emitter->SetEffect(effect);
+            emitter->SetEmitting(false);
+
+            unsigned long long numParticles = 0;
+            long long elapsedTime = 0;
+            for (unsigned frame = 0; frame < numFrames; ++frame)
+            {
+                for (unsigned i = 0; i < effect->GetNumLayers(); ++i)
+                {
+                    // Keep layers full, only update time is measured
+                    ParticleGraphLayerInstance* layer = emitter->GetLayer(i);
+                    layer->EmitNewParticles(static_cast<float>(capacity - layer->GetNumActiveParticles()));
+                    numParticles += layer->GetNumActiveParticles();
+
+                    HiresTimer timer;
+                    layer->Update(timeStep, false);
+                    elapsedTime += timer.GetUSec(false);
+                }
+            }
+
+            CHECK(numParticles > 0);
+            Tests::PrintBenchmarkResult(Format("{} with chunked execution {}: {:.2f}M particles/s", effectName,
+                chunkingEnabled ? "enabled" : "disabled", numParticles / ea::max(1.0, static_cast<double>(elapsedTime))));
+        }
+    }
+}
+
+TEST_CASE("Test destroyed particles are compacted")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto effect = MakeShared<ParticleGraphEffect>(context);
+    auto xml = R"(<particleGraphEffect>
+    <layers>
+	    <layer type="ParticleGraphLayer" capacity="10">
+		    <emit>
+			    <nodes>
+			    </nodes>
+		    </emit>
+		    <init>
+			    <nodes>
+				    <node id="1" name="Constant">
+					    <properties>
+						    <property name="Value" type="float" value="0" />
+					    </properties>
+					    <out>
+						    <pin type="float" name="out" />
+					    </out>
+				    </node>
+				    <node id="2" name="SetAttribute">
+					    <in>
+						    <pin type="float" name="" node="1" pin="out" />
+					    </in>
+					    <out>
+						    <pin type="float" name="time" />
+					    </out>
+				    </node>
+			    </nodes>
+		    </init>
+		    <update>
+			    <nodes>
+				    <node id="3" name="GetAttribute">
+					    <out>
+						    <pin type="float" name="time" />
+					    </out>
+				    </node>
+				    <node id="4" name="Expire">
+					    <in>
+						    <pin name="time" type="float" node="3" pin="time" />
+						    <pin name="lifetime" type="float" value="5" />
+					    </in>
+				    </node>
+			    </nodes>
+		    </update>
+	    </layer>
+    </layers>
+</particleGraphEffect>)";
+    MemoryBuffer buffer(xml);
+    REQUIRE(effect->Load(buffer));
+
+    const auto scene = MakeShared<Scene>(context);
+    const auto node = scene->CreateChild();
+    auto emitter = node->CreateComponent<ParticleGraphEmitter>();
+    emitter->SetEffect(effect);
+    emitter->SetEmitting(false);
+
+    auto layer = emitter->GetLayer(0);
+    REQUIRE(layer->EmitNewParticles(10.0f));
+    REQUIRE(layer->GetNumActiveParticles() == 10);
+
+    // Interleave dead and alive particles.
+    const float times[] = {9.0f, 0.0f, 8.0f, 1.0f, 2.0f, 7.0f, 6.0f, 3.0f, 4.0f, 5.0f};
+    auto values = layer->GetAttributeValues<float>(0);
+    for (unsigned i = 0; i < 10; ++i)
+        values[i] = times[i];
+
+    Tests::RunFrame(context, 0.1f, 0.1f);
+
+    REQUIRE(layer->GetNumActiveParticles() == 5);
+    values = layer->GetAttributeValues<float>(0);
+    ea::vector<float> alive;
+    for (unsigned i = 0; i < 5; ++i)
+        alive.push_back(values[i]);
+    ea::sort(alive.begin(), alive.end());
+    CHECK(alive == ea::vector<float>{0.0f, 1.0f, 2.0f, 3.0f, 4.0f});
+}
+
+TEST_CASE("Test many emitters are updated deterministically")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto system = context->GetSubsystem<ParticleGraphSystem>();
+
+    const auto effect = MakeShared<ParticleGraphEffect>(context);
+    auto xml = R"(<particleGraphEffect>
+    <layers>
+	    <layer type="ParticleGraphLayer" capacity="100">
+		    <emit>
+			    <nodes>
+    			    <node id="1" name="Emit">
+					    <in>
+						    <pin name="count" type="float" value="10" />
+					    </in>
+				    </node>
+			    </nodes>
+		    </emit>
+		    <init>
+			    <nodes>
+				    <node id="2" name="Random">
+					    <properties>
+						    <property name="Min" type="float" value="0" />
+						    <property name="Max" type="float" value="1" />
+					    </properties>
+					    <out>
+						    <pin type="float" name="out" />
+					    </out>
+				    </node>
+				    <node id="3" name="SetAttribute">
+					    <in>
+						    <pin type="float" name="" node="2" pin="out" />
+					    </in>
+					    <out>
+						    <pin type="float" name="value" />
+					    </out>
+				    </node>
+			    </nodes>
+		    </init>
+		    <update>
+			    <nodes>
+				    <node id="4" name="GetAttribute">
+					    <out>
+						    <pin type="float" name="value" />
+					    </out>
+				    </node>
+				    <node id="5" name="Add">
+					    <in>
+						    <pin name="x" type="float" node="4" pin="value" />
+						    <pin name="y" type="float" value="1" />
+					    </in>
+					    <out>
+						    <pin name="out" type="float" />
+					    </out>
+				    </node>
+				    <node id="6" name="SetAttribute">
+					    <in>
+						    <pin type="float" name="" node="5" pin="out" />
+					    </in>
+					    <out>
+						    <pin type="float" name="value" />
+					    </out>
+				    </node>
+			    </nodes>
+		    </update>
+	    </layer>
+    </layers>
+</particleGraphEffect>)";
+    MemoryBuffer buffer(xml);
+    REQUIRE(effect->Load(buffer));
+
+    static constexpr unsigned numEmitters = 1000;
+    const unsigned numExistingEmitters = system->GetNumEmitters();
+
+    const auto simulate = [&]()
+    {
+        SetRandomSeed(1);
+
+        const auto scene = MakeShared<Scene>(context);
+        ea::vector<ParticleGraphEmitter*> emitters;
+        for (unsigned i = 0; i < numEmitters; ++i)
+        {
+            const auto node = scene->CreateChild();
+            node->SetPosition(Vector3(static_cast<float>(i), 0.0f, 0.0f));
+            auto emitter = node->CreateComponent<ParticleGraphEmitter>();
+            emitter->SetEffect(effect);
+            emitters.push_back(emitter);
+        }
+        REQUIRE(system->GetNumEmitters() == numExistingEmitters + numEmitters);
+
+        for (unsigned frame = 0; frame < 3; ++frame)
+            Tests::RunFrame(context, 0.1f, 0.1f);
+
+        ea::vector<float> result;
+        for (ParticleGraphEmitter* emitter : emitters)
+        {
+            auto layer = emitter->GetLayer(0);
+            REQUIRE(layer->GetNumActiveParticles() == 30);
+            const auto values = layer->GetAttributeValues<float>(0);
+            for (unsigned i = 0; i < layer->GetNumActiveParticles(); ++i)
+                result.push_back(values[i]);
+        }
+        return result;
+    };
+
+    const ea::vector<float> firstRun = simulate();
+    CHECK(system->GetNumEmitters() == numExistingEmitters);
+    const ea::vector<float> secondRun = simulate();
+    CHECK(firstRun == secondRun);
+
+    // Emitters removed in arbitrary order are unregistered, others keep updating
+    {
+        const auto scene = MakeShared<Scene>(context);
+        ea::vector<ParticleGraphEmitter*> emitters;
+        for (unsigned i = 0; i < 10; ++i)
+        {
+            auto emitter = scene->CreateChild()->CreateComponent<ParticleGraphEmitter>();
+            emitter->SetEffect(effect);
+            emitters.push_back(emitter);
+        }
+        for (unsigned i : {0, 9, 4, 5})
+            emitters[i]->Remove();
+        CHECK(system->GetNumEmitters() == numExistingEmitters + 6);
+
+        Tests::RunFrame(context, 0.1f, 0.1f);
+        for (unsigned i : {1, 2, 3, 6, 7, 8})
+            CHECK(emitters[i]->GetLayer(0)->GetNumActiveParticles() == 10);
+    }
+    CHECK(system->GetNumEmitters() == numExistingEmitters);
+}
+
+TEST_CASE("Test signed distance field bake")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    static constexpr float halfSize = 1.0f;
+    static constexpr float cellSize = 0.1f;
+    static constexpr float narrowBand = 0.5f;
+
+    const auto field = MakeShared<SignedDistanceField>(context);
+    field->Bake(CreateCubeTriangles(halfSize), BoundingBox(-3.0f, 3.0f), cellSize, narrowBand);
+
+    // Bricks far from surface shouldn't store samples.
+    const IntVector3 numBricks = field->GetNumBricks();
+    CHECK(field->GetNumAllocatedBricks() > 0);
+    CHECK(field->GetNumAllocatedBricks() < static_cast<unsigned>(numBricks.x_ * numBricks.y_ * numBricks.z_));
+
+    for (float x = -2.5f; x <= 2.5f; x += 0.13f)
+    {
+        for (float y = -2.5f; y <= 2.5f; y += 0.17f)
+        {
+            const Vector3 position{x, y, 0.31f};
+            const float expected = CubeDistance(position, halfSize);
+            const float actual = field->Sample(position);
+            if (Abs(expected) < narrowBand - cellSize)
+                REQUIRE(actual == Catch::Approx(expected).margin(cellSize));
+            else if (Abs(expected) > narrowBand + cellSize)
+                REQUIRE((actual < 0.0f) == (expected < 0.0f));
+        }
+    }
+
+    CHECK(field->SampleNormal(Vector3(1.2f, 0.1f, 0.0f)).Equals(Vector3::RIGHT, 0.01f));
+    CHECK(field->SampleNormal(Vector3(0.1f, -0.9f, 0.2f)).Equals(Vector3::DOWN, 0.01f));
+
+    // Field should survive serialization.
+    VectorBuffer buffer;
+    REQUIRE(field->Save(buffer, InternalResourceFormat::Binary));
+    buffer.Seek(0);
+    const auto loadedField = MakeShared<SignedDistanceField>(context);
+    REQUIRE(loadedField->Load(buffer));
+    CHECK(loadedField->GetNumAllocatedBricks() == field->GetNumAllocatedBricks());
+    CHECK(loadedField->Sample(Vector3(0.9f, 0.2f, 0.1f)) == field->Sample(Vector3(0.9f, 0.2f, 0.1f)));
+
+    // Brick pointing outside of samples should fail to load.
+    const unsigned lastOffset = (field->GetNumAllocatedBricks() - 1) * SignedDistanceField::BrickVolume;
+    const unsigned badOffset = field->GetNumAllocatedBricks() * SignedDistanceField::BrickVolume;
+    ByteVector data = buffer.GetBuffer();
+    const auto iter = ea::search(data.begin(), data.end(), reinterpret_cast<const unsigned char*>(&lastOffset),
+        reinterpret_cast<const unsigned char*>(&lastOffset) + sizeof(lastOffset));
+    REQUIRE(iter != data.end());
+    memcpy(&*iter, &badOffset, sizeof(badOffset));
+    MemoryBuffer corruptedBuffer{data};
+    const auto corruptedField = MakeShared<SignedDistanceField>(context);
+    CHECK_FALSE(corruptedField->Load(corruptedBuffer));
+
+    // Model without geometry cannot be baked.
+    const auto emptyModel = MakeShared<Model>(context);
+    CHECK_FALSE(field->BakeModel(emptyModel, Matrix3x4::IDENTITY, cellSize, narrowBand));
+}
+
+TEST_CASE("Test distance field collision")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+
+    const auto field = MakeShared<SignedDistanceField>(context);
+    field->SetName("Tests/ParticleGraph/Cube.sdf");
+    field->Bake(CreateCubeTriangles(1.0f), BoundingBox(-3.0f, 3.0f), 0.1f, 1.0f);
+    cache->AddManualResource(field);
+
+    const auto simulate = [&](ParticleGraphNodes::DistanceFieldCollisionMode mode, float bounceFactor)
+    {
+        const auto effect = MakeShared<ParticleGraphEffect>(context);
+        const ea::string xml = Format(R"(<particleGraphEffect>
+    <layers>
+	    <layer type="ParticleGraphLayer" capacity="1">
+		    <emit>
+			    <nodes>
+			    </nodes>
+		    </emit>
+		    <init>
+			    <nodes>
+				    <node id="1" name="Constant">
+					    <properties>
+						    <property name="Value" type="Vector3" value="0 1.5 0" />
+					    </properties>
+					    <out>
+						    <pin type="Vector3" name="out" />
+					    </out>
+				    </node>
+				    <node id="2" name="SetAttribute">
+					    <in>
+						    <pin type="Vector3" name="" node="1" pin="out" />
+					    </in>
+					    <out>
+						    <pin type="Vector3" name="pos" />
+					    </out>
+				    </node>
+				    <node id="3" name="Constant">
+					    <properties>
+						    <property name="Value" type="Vector3" value="0 -10 0" />
+					    </properties>
+					    <out>
+						    <pin type="Vector3" name="out" />
+					    </out>
+				    </node>
+				    <node id="4" name="SetAttribute">
+					    <in>
+						    <pin type="Vector3" name="" node="3" pin="out" />
+					    </in>
+					    <out>
+						    <pin type="Vector3" name="vel" />
+					    </out>
+				    </node>
+			    </nodes>
+		    </init>
+		    <update>
+			    <nodes>
+				    <node id="5" name="GetAttribute">
+					    <out>
+						    <pin type="Vector3" name="pos" />
+					    </out>
+				    </node>
+				    <node id="6" name="GetAttribute">
+					    <out>
+						    <pin type="Vector3" name="vel" />
+					    </out>
+				    </node>
+				    <node id="7" name="DistanceFieldCollision">
+					    <properties>
+						    <property name="Field" type="ResourceRef" value="SignedDistanceField;Tests/ParticleGraph/Cube.sdf" />
+						    <property name="Mode" type="int" value="{}" />
+						    <property name="BounceFactor" type="float" value="{}" />
+					    </properties>
+					    <in>
+						    <pin name="position" type="Vector3" node="5" pin="pos" />
+						    <pin name="velocity" type="Vector3" node="6" pin="vel" />
+					    </in>
+					    <out>
+						    <pin name="newPosition" type="Vector3" />
+						    <pin name="newVelocity" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="8" name="SetAttribute">
+					    <in>
+						    <pin type="Vector3" name="" node="7" pin="newPosition" />
+					    </in>
+					    <out>
+						    <pin type="Vector3" name="pos" />
+					    </out>
+				    </node>
+				    <node id="9" name="SetAttribute">
+					    <in>
+						    <pin type="Vector3" name="" node="7" pin="newVelocity" />
+					    </in>
+					    <out>
+						    <pin type="Vector3" name="vel" />
+					    </out>
+				    </node>
+			    </nodes>
+		    </update>
+	    </layer>
+    </layers>
+</particleGraphEffect>)", static_cast<int>(mode), bounceFactor);
+        MemoryBuffer buffer(xml);
+        REQUIRE(effect->Load(buffer));
+
+        const auto scene = MakeShared<Scene>(context);
+        const auto node = scene->CreateChild();
+        auto emitter = node->CreateComponent<ParticleGraphEmitter>();
+        emitter->SetEffect(effect);
+        emitter->SetEmitting(false);
+        REQUIRE(emitter->EmitNewParticle(0));
+
+        Tests::RunFrame(context, 0.1f, 0.1f);
+
+        auto layer = emitter->GetLayer(0);
+        ea::optional<ea::pair<Vector3, Vector3>> result;
+        if (layer->GetNumActiveParticles() > 0)
+            result = ea::make_pair(layer->GetAttributeValues<Vector3>(0)[0], layer->GetAttributeValues<Vector3>(1)[0]);
+        return result;
+    };
+
+    // Particle moves 1 unit down into the cube and is pushed back to the surface.
+    const auto bounce = simulate(ParticleGraphNodes::DistanceFieldCollisionMode::Bounce, 1.0f);
+    REQUIRE(bounce);
+    CHECK(bounce->first.Equals(Vector3(0.0f, 1.0f, 0.0f), 0.05f));
+    CHECK(bounce->second.Equals(Vector3(0.0f, 10.0f, 0.0f), 0.5f));
+
+    const auto slide = simulate(ParticleGraphNodes::DistanceFieldCollisionMode::Slide, 1.0f);
+    REQUIRE(slide);
+    CHECK(slide->first.Equals(Vector3(0.0f, 1.0f, 0.0f), 0.05f));
+    CHECK(slide->second.Equals(Vector3::ZERO, 0.5f));
+
+    const auto kill = simulate(ParticleGraphNodes::DistanceFieldCollisionMode::Kill, 0.0f);
+    CHECK_FALSE(kill);
+
+    // Mode is exposed to the editor by name
+    const auto* reflection = context->GetSubsystem<ParticleGraphSystem>()->GetReflection(
+        ParticleGraphNodes::DistanceFieldCollision::GetTypeStatic());
+    REQUIRE(reflection);
+    const AttributeInfo* modeAttribute = reflection->GetAttribute("Mode");
+    REQUIRE(modeAttribute);
+    CHECK(modeAttribute->enumNames_ == StringVector{"Bounce", "Slide", "Kill"});
+
+    cache->ReleaseResource(field->GetName(), true);
+}
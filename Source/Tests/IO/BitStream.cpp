@@ -0,0 +1,287 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/IO/BitStream.h>
+#include <Urho3D/Math/RandomEngine.h>
+
+namespace
+{
+
+enum class BitStreamOperation
+{
+    Bits,
+    Bool,
+    RangedInt,
+    VarUInt,
+    Float,
+    QuantizedFloat,
+    QuantizedUnitFloat,
+    QuantizedQuaternion,
+    String,
+
+    Count
+};
+
+struct BitStreamEntry
+{
+    BitStreamOperation operation_{};
+    unsigned numBits_{};
+    unsigned uintValue_{};
+    int intValue_{};
+    int minValue_{};
+    int maxValue_{};
+    double floatValue_{};
+    double range_{};
+    Quaternion quaternionValue_;
+    ea::string stringValue_;
+};
+
+unsigned GetRandomUInt32(RandomEngine& random)
+{
+    return random.GetUInt() ^ (random.GetUInt() << 16);
+}
+
+BitStreamEntry GenerateEntry(RandomEngine& random)
+{
+    BitStreamEntry entry;
+    entry.operation_ = static_cast<BitStreamOperation>(random.GetUInt(static_cast<unsigned>(BitStreamOperation::Count)));
+    switch (entry.operation_)
+    {
+    case BitStreamOperation::Bits:
+        entry.numBits_ = random.GetUInt(0, 33);
+        entry.uintValue_ = entry.numBits_ < 32 ? GetRandomUInt32(random) & ((1u << entry.numBits_) - 1) : GetRandomUInt32(random);
+        break;
+
+    case BitStreamOperation::Bool:
+        entry.uintValue_ = random.GetBool(0.5f) ? 1 : 0;
+        break;
+
+    case BitStreamOperation::RangedInt:
+        entry.minValue_ = random.GetInt(-1000, 1);
+        entry.maxValue_ = entry.minValue_ + random.GetInt(0, 100000);
+        entry.intValue_ = random.GetInt(entry.minValue_, entry.maxValue_ + 1);
+        break;
+
+    case BitStreamOperation::VarUInt:
+        entry.uintValue_ = GetRandomUInt32(random) >> random.GetUInt(32);
+        break;
+
+    case BitStreamOperation::Float:
+        entry.floatValue_ = random.GetFloat(-1000.0f, 1000.0f);
+        break;
+
+    case BitStreamOperation::QuantizedFloat:
+        entry.numBits_ = random.GetUInt(2, 33);
+        entry.range_ = random.GetDouble(0.1, 1000.0);
+        entry.floatValue_ = random.GetDouble(-entry.range_, entry.range_);
+        break;
+
+    case BitStreamOperation::QuantizedUnitFloat:
+        entry.numBits_ = random.GetUInt(1, 33);
+        entry.floatValue_ = random.GetFloat();
+        break;
+
+    case BitStreamOperation::QuantizedQuaternion:
+        entry.numBits_ = random.GetUInt(8, 17);
+        entry.quaternionValue_ = random.GetQuaternion();
+        break;
+
+    case BitStreamOperation::String:
+        entry.stringValue_.resize(random.GetUInt(20));
+        for (char& ch : entry.stringValue_)
+            ch = static_cast<char>(random.GetUInt(32, 127));
+        break;
+
+    default:
+        break;
+    }
+    return entry;
+}
+
+void WriteEntry(BitWriter& dest, const BitStreamEntry& entry)
+{
+    switch (entry.operation_)
+    {
+    case BitStreamOperation::Bits: dest.WriteBits(entry.uintValue_, entry.numBits_); break;
+    case BitStreamOperation::Bool: dest.WriteBool(entry.uintValue_ != 0); break;
+    case BitStreamOperation::RangedInt: dest.WriteRangedInt(entry.intValue_, entry.minValue_, entry.maxValue_); break;
+    case BitStreamOperation::VarUInt: dest.WriteVarUInt(entry.uintValue_); break;
+    case BitStreamOperation::Float: dest.WriteFloat(static_cast<float>(entry.floatValue_)); break;
+    case BitStreamOperation::QuantizedFloat: dest.WriteQuantizedFloat(entry.floatValue_, entry.range_, entry.numBits_); break;
+    case BitStreamOperation::QuantizedUnitFloat: dest.WriteQuantizedUnitFloat(entry.floatValue_, entry.numBits_); break;
+    case BitStreamOperation::QuantizedQuaternion: dest.WriteQuantizedQuaternion(entry.quaternionValue_, entry.numBits_); break;
+    case BitStreamOperation::String: dest.WriteString(entry.stringValue_); break;
+    default: break;
+    }
+}
+
+void CheckEntry(BitReader& src, const BitStreamEntry& entry)
+{
+    switch (entry.operation_)
+    {
+    case BitStreamOperation::Bits: CHECK(src.ReadBits(entry.numBits_) == entry.uintValue_); break;
+    case BitStreamOperation::Bool: CHECK(src.ReadBool() == (entry.uintValue_ != 0)); break;
+    case BitStreamOperation::RangedInt: CHECK(src.ReadRangedInt(entry.minValue_, entry.maxValue_) == entry.intValue_); break;
+    case BitStreamOperation::VarUInt: CHECK(src.ReadVarUInt() == entry.uintValue_); break;
+    case BitStreamOperation::Float: CHECK(src.ReadFloat() == static_cast<float>(entry.floatValue_)); break;
+
+    case BitStreamOperation::QuantizedFloat:
+    {
+        const double step = entry.range_ / ((1ull << (entry.numBits_ - 1)) - 1);
+        CHECK(Abs(src.ReadQuantizedFloat(entry.range_, entry.numBits_) - entry.floatValue_) <= step);
+        break;
+    }
+
+    case BitStreamOperation::QuantizedUnitFloat:
+    {
+        const double step = 1.0 / ((1ull << entry.numBits_) - 1);
+        CHECK(Abs(src.ReadQuantizedUnitFloat(entry.numBits_) - entry.floatValue_) <= step + M_EPSILON);
+        break;
+    }
+
+    case BitStreamOperation::QuantizedQuaternion:
+    {
+        const float step = 1.0f / ((1u << (entry.numBits_ - 1)) - 1);
+        const Quaternion value = src.ReadQuantizedQuaternion(entry.numBits_);
+        CHECK(Abs(value.DotProduct(entry.quaternionValue_)) >= 1.0f - step);
+        break;
+    }
+
+    case BitStreamOperation::String: CHECK(src.ReadString() == entry.stringValue_); break;
+    default: break;
+    }
+}
+
+} // namespace
+
+TEST_CASE("BitWriter and BitReader round-trip random values")
+{
+    RandomEngine random{0};
+    for (unsigned iteration = 0; iteration < 200; ++iteration)
+    {
+        ea::vector<BitStreamEntry> entries(random.GetUInt(1, 64));
+        for (BitStreamEntry& entry : entries)
+            entry = GenerateEntry(random);
+
+        ByteVector buffer;
+        BitWriter writer{buffer};
+        for (const BitStreamEntry& entry : entries)
+            WriteEntry(writer, entry);
+        writer.Flush();
+        REQUIRE(buffer.size() == (writer.GetNumBits() + 7) / 8);
+
+        BitReader reader{buffer};
+        for (const BitStreamEntry& entry : entries)
+            CheckEntry(reader, entry);
+        CHECK(reader.GetNumBits() == writer.GetNumBits());
+        CHECK(reader.GetNumBitsRemaining() < 8);
+        CHECK_FALSE(reader.IsOverflow());
+    }
+}
+
+TEST_CASE("Quantized values represent zero and range boundaries exactly")
+{
+    ByteVector buffer;
+    BitWriter writer{buffer};
+    writer.WriteQuantizedFloat(0.0, 10.0, 8);
+    writer.WriteQuantizedFloat(10.0, 10.0, 8);
+    writer.WriteQuantizedFloat(-25.0, 10.0, 8);
+    writer.WriteQuantizedVector3(DoubleVector3::ZERO, 100.0, 12);
+    writer.WriteQuantizedQuaternion(Quaternion::IDENTITY, 10);
+    writer.Flush();
+    CHECK(writer.GetNumBits() == 3 * 8 + 3 * 12 + 2 + 3 * 10);
+
+    BitReader reader{buffer};
+    CHECK(reader.ReadQuantizedFloat(10.0, 8) == 0.0);
+    CHECK(reader.ReadQuantizedFloat(10.0, 8) == 10.0);
+    CHECK(reader.ReadQuantizedFloat(10.0, 8) == -10.0);
+    CHECK(reader.ReadQuantizedVector3(100.0, 12) == DoubleVector3::ZERO);
+    CHECK(reader.ReadQuantizedQuaternion(10) == Quaternion::IDENTITY);
+    CHECK_FALSE(reader.IsOverflow());
+}
+
+TEST_CASE("Quantized quaternions keep unit length and exact components after round trip")
+{
+    const Quaternion rotations[] = {
+        Quaternion::IDENTITY,
+        Quaternion{90.0f, Vector3::UP},
+        Quaternion{-45.0f, Vector3::RIGHT},
+        Quaternion{180.0f, Vector3::FORWARD},
+        Quaternion{30.0f, Vector3::ONE.Normalized()},
+    };
+
+    ByteVector buffer;
+    BitWriter writer{buffer};
+    for (const Quaternion& rotation : rotations)
+        writer.WriteQuantizedQuaternion(rotation, 12);
+    writer.Flush();
+
+    BitReader reader{buffer};
+    for (const Quaternion& rotation : rotations)
+    {
+        const Quaternion result = reader.ReadQuantizedQuaternion(12);
+        CHECK(result.LengthSquared() == Catch::Approx(1.0f));
+        CHECK(Abs(result.DotProduct(rotation)) == Catch::Approx(1.0f).margin(0.0001f));
+
+        // Components that are zero in source rotation stay exactly zero
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            if (rotation.Data()[i] == 0.0f)
+                CHECK(result.Data()[i] == 0.0f);
+        }
+    }
+    CHECK_FALSE(reader.IsOverflow());
+}
+
+TEST_CASE("BitReader tolerates malformed data")
+{
+    RandomEngine random{1};
+    for (unsigned iteration = 0; iteration < 200; ++iteration)
+    {
+        ByteVector buffer(random.GetUInt(0, 32));
+        for (unsigned char& value : buffer)
+            value = static_cast<unsigned char>(random.GetUInt(256));
+
+        // Read random entries until data is exhausted, values are meaningless but must not crash
+        BitReader reader{buffer};
+        for (unsigned i = 0; i < 64; ++i)
+        {
+            const BitStreamEntry entry = GenerateEntry(random);
+            switch (entry.operation_)
+            {
+            case BitStreamOperation::Bits: reader.ReadBits(entry.numBits_); break;
+            case BitStreamOperation::Bool: reader.ReadBool(); break;
+            case BitStreamOperation::RangedInt:
+            {
+                const int value = reader.ReadRangedInt(entry.minValue_, entry.maxValue_);
+                CHECK(value >= entry.minValue_);
+                CHECK(value <= entry.maxValue_);
+                break;
+            }
+            case BitStreamOperation::VarUInt: reader.ReadVarUInt(); break;
+            case BitStreamOperation::Float: reader.ReadFloat(); break;
+            case BitStreamOperation::QuantizedFloat:
+                CHECK(Abs(reader.ReadQuantizedFloat(entry.range_, entry.numBits_)) <= entry.range_);
+                break;
+            case BitStreamOperation::QuantizedUnitFloat: reader.ReadQuantizedUnitFloat(entry.numBits_); break;
+            case BitStreamOperation::QuantizedQuaternion:
+                CHECK(reader.ReadQuantizedQuaternion(entry.numBits_).LengthSquared() == Catch::Approx(1.0f));
+                break;
+            case BitStreamOperation::String: CHECK(reader.ReadString().size() <= buffer.size()); break;
+            default: break;
+            }
+        }
+        CHECK(reader.GetNumBits() <= buffer.size() * 8);
+    }
+
+    // Reading past the end sets overflow flag and returns zeros
+    const ByteVector buffer{0xff};
+    BitReader reader{buffer};
+    CHECK(reader.ReadBits(4) == 0xf);
+    CHECK(reader.ReadBits(8) == 0);
+    CHECK(reader.IsOverflow());
+    CHECK(reader.ReadString().empty());
+}
@@ -0,0 +1,189 @@
+// Copyright (c) 2024-2025 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/MappedFile.h>
+#include <Urho3D/IO/MountedDirectory.h>
+#include <Urho3D/IO/PackageBuilder.h>
+#include <Urho3D/IO/PackageFile.h>
+#include <Urho3D/Resource/XMLFile.h>
+
+namespace
+{
+
+ByteVector CreateTestData(unsigned size)
+{
+    ByteVector data(size);
+    for (unsigned i = 0; i < size; ++i)
+        data[i] = static_cast<unsigned char>(i * 7 + i / 251);
+    return data;
+}
+
+void WriteTestFile(Context* context, const ea::string& fileName, const ByteVector& data)
+{
+    File file(context, fileName, FILE_WRITE);
+    REQUIRE(file.IsOpen());
+    REQUIRE(file.Write(data.data(), data.size()) == data.size());
+}
+
+}
+
+TEST_CASE("MappedFile provides view of file part")
+{
+    if (!MappedFile::IsSupported())
+        return;
+
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+    const ea::string fileName = fileSystem->GetTemporaryDir() + "MappedFileTest.bin";
+
+    const auto data = CreateTestData(100000);
+    WriteTestFile(context, fileName, data);
+
+    {
+        // Offset is not aligned to page size
+        const auto mappedFile = MappedFile::Open(fileName, 12345, 50000);
+        REQUIRE(mappedFile);
+        CHECK(mappedFile->GetSize() == 50000);
+
+        const ConstByteSpan view = mappedFile->GetContiguousData();
+        REQUIRE(view.size() == 50000);
+        CHECK(ea::equal(view.begin(), view.end(), data.begin() + 12345));
+
+        ByteVector buffer(100);
+        mappedFile->Seek(40000);
+        REQUIRE(mappedFile->Read(buffer.data(), buffer.size()) == buffer.size());
+        CHECK(ea::equal(buffer.begin(), buffer.end(), data.begin() + 12345 + 40000));
+
+        // Mapped files are read-only and cannot exceed the file
+        CHECK(mappedFile->Write(buffer.data(), buffer.size()) == 0);
+        CHECK_FALSE(MappedFile::Open(fileName, 90000, 20000));
+    }
+
+    {
+        const auto mappedFile = MappedFile::Open(fileName);
+        REQUIRE(mappedFile);
+        CHECK(mappedFile->GetContiguousData().size() == data.size());
+
+        File file(context, fileName);
+        CHECK(mappedFile->GetChecksum() == file.GetChecksum());
+    }
+
+    fileSystem->Delete(fileName);
+}
+
+TEST_CASE("Big files are memory mapped by mount points")
+{
+    if (!MappedFile::IsSupported())
+        return;
+
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+    const ea::string directory = fileSystem->GetTemporaryDir() + "MappedFileTest/";
+    fileSystem->CreateDir(directory);
+
+    const auto smallData = CreateTestData(1000);
+    const auto bigData = CreateTestData(MountPoint::DefaultMappedFileThreshold);
+    WriteTestFile(context, directory + "Small.bin", smallData);
+    WriteTestFile(context, directory + "Big.bin", bigData);
+
+    SECTION("MountedDirectory")
+    {
+        auto mountPoint = MakeShared<MountedDirectory>(context, directory);
+
+        // Loose files may be rewritten while mapped, so mapping is opt-in
+        const AbstractFilePtr defaultFile = mountPoint->OpenFile(FileIdentifier{"", "Big.bin"}, FILE_READ);
+        REQUIRE(defaultFile);
+        CHECK(defaultFile->GetContiguousData().empty());
+
+        mountPoint->SetMappedFileThreshold(MountPoint::DefaultMappedFileThreshold);
+        const AbstractFilePtr smallFile = mountPoint->OpenFile(FileIdentifier{"", "Small.bin"}, FILE_READ);
+        REQUIRE(smallFile);
+        CHECK(smallFile->GetContiguousData().empty());
+
+        const AbstractFilePtr bigFile = mountPoint->OpenFile(FileIdentifier{"", "Big.bin"}, FILE_READ);
+        REQUIRE(bigFile);
+        CHECK(bigFile->GetName() == "Big.bin");
+        const ConstByteSpan view = bigFile->GetContiguousData();
+        REQUIRE(view.size() == bigData.size());
+        CHECK(ea::equal(view.begin(), view.end(), bigData.begin()));
+
+        mountPoint->SetMappedFileThreshold(0);
+        const AbstractFilePtr unmappedFile = mountPoint->OpenFile(FileIdentifier{"", "Big.bin"}, FILE_READ);
+        REQUIRE(unmappedFile);
+        CHECK(unmappedFile->GetContiguousData().empty());
+    }
+
+    SECTION("PackageFile")
+    {
+        const ea::string packageName = directory + "Package.pak";
+        {
+            PackageBuilder builder(context);
+            REQUIRE(builder.Create(packageName));
+            REQUIRE(builder.Append("Small.bin", smallData.data(), smallData.size(), PackageCompression::None));
+            REQUIRE(builder.Append("Big.bin", bigData.data(), bigData.size(), PackageCompression::None));
+            REQUIRE(builder.Append("Compressed.bin", bigData.data(), bigData.size(), PackageCompression::LZ4));
+            REQUIRE(builder.Build());
+        }
+
+        auto package = MakeShared<PackageFile>(context, packageName);
+        REQUIRE(package->GetNumFiles() == 3);
+
+        const AbstractFilePtr smallFile = package->OpenFile(FileIdentifier{"", "Small.bin"}, FILE_READ);
+        REQUIRE(smallFile);
+        CHECK(smallFile->GetContiguousData().empty());
+
+        const AbstractFilePtr bigFile = package->OpenFile(FileIdentifier{"", "Big.bin"}, FILE_READ);
+        REQUIRE(bigFile);
+        const ConstByteSpan view = bigFile->GetContiguousData();
+        REQUIRE(view.size() == bigData.size());
+        CHECK(ea::equal(view.begin(), view.end(), bigData.begin()));
+        CHECK(bigFile->GetChecksum() == package->GetEntry("Big.bin")->checksum_);
+
+        const AbstractFilePtr compressedFile = package->OpenFile(FileIdentifier{"", "Compressed.bin"}, FILE_READ);
+        REQUIRE(compressedFile);
+        CHECK(compressedFile->GetContiguousData().empty());
+
+        ByteVector buffer(bigData.size());
+        REQUIRE(compressedFile->Read(buffer.data(), buffer.size()) == buffer.size());
+        CHECK(buffer == bigData);
+    }
+
+    fileSystem->RemoveDir(directory, true);
+}
+
+TEST_CASE("XMLFile is parsed from memory mapped file")
+{
+    if (!MappedFile::IsSupported())
+        return;
+
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+    const ea::string fileName = fileSystem->GetTemporaryDir() + "MappedFileTest.xml";
+
+    ea::string text = "<root>";
+    for (unsigned i = 0; i < 1000; ++i)
+        text += Format("<element index=\"{}\" />", i);
+    text += "</root>";
+    WriteTestFile(context, fileName, ByteVector(text.begin(), text.end()));
+
+    {
+        const auto mappedFile = MappedFile::Open(fileName);
+        REQUIRE(mappedFile);
+
+        auto xmlFile = MakeShared<XMLFile>(context);
+        REQUIRE(xmlFile->Load(*mappedFile));
+        CHECK(mappedFile->IsEof());
+
+        unsigned numElements = 0;
+        for (XMLElement child = xmlFile->GetRoot().GetChild("element"); child; child = child.GetNext("element"))
+            CHECK(child.GetUInt("index") == numElements++);
+        CHECK(numElements == 1000);
+    }
+
+    fileSystem->Delete(fileName);
+}
@@ -0,0 +1,330 @@
+// Copyright (c) 2024-2025 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IO/Compression.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/PackageBuilder.h>
+#include <Urho3D/IO/PackageFile.h>
+#include <Urho3D/IO/VectorBuffer.h>
+
+namespace
+{
+
+ea::vector<unsigned char> CreateTestData(unsigned size, bool compressible, unsigned seed)
+{
+    ea::vector<unsigned char> data(size);
+    unsigned state = seed;
+    for (unsigned i = 0; i < size; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        const bool noise = !compressible || (state >> 28) == 0;
+        data[i] = noise ? static_cast<unsigned char>(state >> 20) : static_cast<unsigned char>((i / 7) % 13);
+    }
+    return data;
+}
+
+/// Read file sequentially and at pseudo-random positions, including backward seeks.
+void CheckRandomAccess(File& file, const ea::vector<unsigned char>& expected)
+{
+    REQUIRE(file.GetSize() == expected.size());
+
+    const auto expectedSize = static_cast<unsigned>(expected.size());
+    ea::vector<unsigned char> buffer(expectedSize);
+    REQUIRE(file.Read(buffer.data(), buffer.size()) == buffer.size());
+    REQUIRE(buffer == expected);
+
+    unsigned state = 1;
+    for (unsigned i = 0; i < 200; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        const unsigned position = state % expectedSize;
+        const unsigned size = Min(1 + state % 5000, expectedSize - position);
+
+        REQUIRE(file.Seek(position) == position);
+        REQUIRE(file.Read(buffer.data(), size) == size);
+        REQUIRE(ea::equal(buffer.begin(), buffer.begin() + size, expected.begin() + position));
+    }
+}
+
+struct TestEntry
+{
+    ea::string name_;
+    PackageCompression compression_{};
+    PackageCompression expectedCompression_{};
+    ea::vector<unsigned char> data_;
+};
+
+ea::vector<TestEntry> CreateTestEntries()
+{
+    return {
+        {"Raw.bin", PackageCompression::None, PackageCompression::None, CreateTestData(100000, true, 1)},
+        {"LZ4.bin", PackageCompression::LZ4, PackageCompression::LZ4, CreateTestData(300000, true, 2)},
+        {"ZSTD.bin", PackageCompression::ZSTD, PackageCompression::ZSTD, CreateTestData(300000, true, 3)},
+        {"Noise.bin", PackageCompression::ZSTD, PackageCompression::None, CreateTestData(50000, false, 4)},
+        {"Empty.bin", PackageCompression::LZ4, PackageCompression::None, {}},
+    };
+}
+
+void BuildTestPackage(Context* context, const ea::string& fileName, unsigned long long startOffset,
+    const ea::vector<TestEntry>& entries)
+{
+    PackageBuilder builder(context);
+    builder.SetBlockSize(4096);
+    REQUIRE(builder.Create(fileName, startOffset));
+    for (const TestEntry& entry : entries)
+        REQUIRE(builder.Append(entry.name_, entry.data_.data(), entry.data_.size(), entry.compression_));
+    REQUIRE(builder.Build());
+}
+
+ea::vector<unsigned char> ReadWholeFile(Context* context, const ea::string& fileName)
+{
+    File file(context, fileName);
+    REQUIRE(file.IsOpen());
+    ea::vector<unsigned char> data(file.GetSize());
+    REQUIRE(file.Read(data.data(), data.size()) == data.size());
+    return data;
+}
+
+void CheckTestPackage(PackageFile* package, const ea::vector<TestEntry>& entries)
+{
+    REQUIRE(package->GetNumFiles() == entries.size());
+    CHECK(package->GetVersion() == 1);
+    CHECK(package->IsCompressed());
+
+    for (const TestEntry& entry : entries)
+    {
+        const PackageEntry* packageEntry = package->GetEntry(entry.name_);
+        REQUIRE(packageEntry);
+        CHECK(packageEntry->compression_ == entry.expectedCompression_);
+        if (entry.expectedCompression_ != PackageCompression::None)
+            CHECK(packageEntry->packedSize_ < entry.data_.size());
+
+        File file(package->GetContext(), package, entry.name_);
+        REQUIRE(file.IsOpen());
+        if (!entry.data_.empty())
+            CheckRandomAccess(file, entry.data_);
+        CHECK(file.GetChecksum() == packageEntry->checksum_);
+    }
+}
+
+}
+
+TEST_CASE("PackageFile supports random access to compressed files")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+    const ea::string fileName = fileSystem->GetTemporaryDir() + "PackageFileTest.pak";
+
+    const auto entries = CreateTestEntries();
+    BuildTestPackage(context, fileName, 0, entries);
+
+    auto package = MakeShared<PackageFile>(context);
+    REQUIRE(package->Open(fileName));
+    CheckTestPackage(package, entries);
+
+    package = nullptr;
+    fileSystem->Delete(fileName);
+}
+
+TEST_CASE("PackageFile supports files beyond 4GB")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+    const ea::string fileName = fileSystem->GetTemporaryDir() + "PackageFileTestSparse.pak";
+    fileSystem->Delete(fileName);
+
+    // Package is appended to sparse file, its start is found via package size in the end of the file
+    const unsigned long long startOffset = 5ull * 1024 * 1024 * 1024;
+    const auto entries = CreateTestEntries();
+    BuildTestPackage(context, fileName, startOffset, entries);
+
+    auto package = MakeShared<PackageFile>(context);
+    REQUIRE(package->Open(fileName));
+    CHECK(package->GetTotalSize() > startOffset);
+    CHECK(package->GetEntry("Raw.bin")->offset_ > startOffset);
+    CheckTestPackage(package, entries);
+
+    package = nullptr;
+    fileSystem->Delete(fileName);
+}
+
+TEST_CASE("PackageFile supports backward seek in legacy compressed files")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+    const ea::string fileName = fileSystem->GetTemporaryDir() + "PackageFileTestLegacy.pak";
+
+    const unsigned blockSize = 4096;
+    const auto data = CreateTestData(50000, true, 5);
+    {
+        File file(context, fileName, FILE_WRITE);
+        REQUIRE(file.IsOpen());
+
+        const ea::string entryName = "Legacy.bin";
+        const unsigned entryOffset = 4 + 4 + 4 + (entryName.length() + 1) + 4 + 4 + 4;
+        file.WriteFileID("ULZ4");
+        file.WriteUInt(1);
+        file.WriteUInt(0);
+        file.WriteString(entryName);
+        file.WriteUInt(entryOffset);
+        file.WriteUInt(data.size());
+        file.WriteUInt(0);
+        REQUIRE(file.GetSize() == entryOffset);
+
+        ea::vector<unsigned char> compressed(EstimateCompressBound(blockSize));
+        for (unsigned pos = 0; pos < data.size(); pos += blockSize)
+        {
+            const unsigned unpackedSize = Min<unsigned>(blockSize, data.size() - pos);
+            const unsigned packedSize = CompressData(compressed.data(), &data[pos], unpackedSize);
+            file.WriteUShort(unpackedSize);
+            file.WriteUShort(packedSize);
+            file.Write(compressed.data(), packedSize);
+        }
+        file.WriteUInt(file.GetSize() + sizeof(unsigned));
+    }
+
+    auto package = MakeShared<PackageFile>(context);
+    REQUIRE(package->Open(fileName));
+    CHECK(package->GetVersion() == 0);
+    REQUIRE(package->GetEntry("Legacy.bin"));
+    CHECK(package->GetEntry("Legacy.bin")->compression_ == PackageCompression::LZ4);
+
+    File file(context, package, "Legacy.bin");
+    REQUIRE(file.IsOpen());
+    CheckRandomAccess(file, data);
+
+    file.Close();
+    package = nullptr;
+    fileSystem->Delete(fileName);
+}
+
+TEST_CASE("PackageBuilder output doesn't depend on number of threads")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+    const ea::string serialName = fileSystem->GetTemporaryDir() + "PackageFileTestSerial.pak";
+    const ea::string parallelName = fileSystem->GetTemporaryDir() + "PackageFileTestParallel.pak";
+
+    const auto entries = CreateTestEntries();
+    for (const ea::string& fileName : {serialName, parallelName})
+    {
+        PackageBuilder builder(context);
+        builder.SetBlockSize(4096);
+        builder.SetWorkQueue(fileName == serialName ? nullptr : context->GetSubsystem<WorkQueue>());
+        REQUIRE(builder.Create(fileName));
+        for (const TestEntry& entry : entries)
+            REQUIRE(builder.Append(entry.name_, entry.data_.data(), entry.data_.size(), entry.compression_));
+        REQUIRE(builder.Build());
+    }
+
+    CHECK(ReadWholeFile(context, serialName) == ReadWholeFile(context, parallelName));
+
+    fileSystem->Delete(serialName);
+    fileSystem->Delete(parallelName);
+}
+
+TEST_CASE("PackageBuilder deduplicates files and reuses previous package")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+    const ea::string previousName = fileSystem->GetTemporaryDir() + "PackageFileTestPrevious.pak";
+    const ea::string manifestName = previousName + ".manifest";
+    const ea::string fileName = fileSystem->GetTemporaryDir() + "PackageFileTestIncremental.pak";
+
+    auto entries = CreateTestEntries();
+    entries.push_back({"Copy.bin", PackageCompression::LZ4, PackageCompression::LZ4, entries[1].data_});
+    {
+        PackageBuilder builder(context);
+        builder.SetBlockSize(4096);
+        REQUIRE(builder.Create(previousName));
+        for (const TestEntry& entry : entries)
+            REQUIRE(builder.Append(entry.name_, entry.data_.data(), entry.data_.size(), entry.compression_));
+        REQUIRE(builder.Build());
+        CHECK(builder.GetNumDeduplicatedFiles() == 1);
+        CHECK(builder.GetNumReusedFiles() == 0);
+
+        File manifestFile(context, manifestName, FILE_WRITE);
+        REQUIRE(builder.GetManifest().Save(manifestFile));
+    }
+
+    {
+        auto package = MakeShared<PackageFile>(context, previousName);
+        CHECK(package->GetEntry("Copy.bin")->offset_ == package->GetEntry("LZ4.bin")->offset_);
+        CheckTestPackage(package, entries);
+    }
+
+    // Change one file and rename another one
+    entries[2].data_ = CreateTestData(300000, true, 6);
+    entries[3].name_ = "RenamedNoise.bin";
+    {
+        PackageBuilder builder(context);
+        builder.SetBlockSize(4096);
+        REQUIRE(builder.Create(fileName));
+        REQUIRE(builder.SetPreviousPackage(previousName, manifestName));
+        for (const TestEntry& entry : entries)
+            REQUIRE(builder.Append(entry.name_, entry.data_.data(), entry.data_.size(), entry.compression_));
+        REQUIRE(builder.Build());
+        CHECK(builder.GetNumDeduplicatedFiles() == 1);
+        CHECK(builder.GetNumReusedFiles() == 2);
+    }
+
+    {
+        auto package = MakeShared<PackageFile>(context, fileName);
+        CheckTestPackage(package, entries);
+    }
+
+    fileSystem->Delete(previousName);
+    fileSystem->Delete(manifestName);
+    fileSystem->Delete(fileName);
+}
+
+TEST_CASE("PackageManifest rejects malformed data")
+{
+    PackageManifest manifest;
+    manifest.entries_.resize(2);
+    manifest.entries_[0].name_ = "First.bin";
+    manifest.entries_[0].size_ = 100;
+    manifest.entries_[1].name_ = "Second.bin";
+    manifest.entries_[1].compression_ = PackageCompression::LZ4;
+
+    VectorBuffer buffer;
+    REQUIRE(manifest.Save(buffer));
+    const ByteVector& data = buffer.GetBuffer();
+
+    {
+        PackageManifest loadedManifest;
+        MemoryBuffer source{data};
+        REQUIRE(loadedManifest.Load(source));
+        REQUIRE(loadedManifest.entries_.size() == 2);
+        CHECK(loadedManifest.entries_[1].name_ == "Second.bin");
+        CHECK(loadedManifest.entries_[1].compression_ == PackageCompression::LZ4);
+    }
+
+    // Truncated data
+    for (unsigned size : {4u, 5u, 20u, static_cast<unsigned>(data.size() - 1)})
+    {
+        PackageManifest loadedManifest;
+        MemoryBuffer source{data.data(), size};
+        CHECK_FALSE(loadedManifest.Load(source));
+        CHECK(loadedManifest.entries_.empty());
+    }
+
+    // Number of entries doesn't fit into data
+    {
+        VectorBuffer malformedBuffer;
+        malformedBuffer.WriteFileID("RPKM");
+        malformedBuffer.WriteVLE(0x10000000);
+        malformedBuffer.WriteString("Entry.bin");
+
+        PackageManifest loadedManifest;
+        MemoryBuffer source{malformedBuffer.GetBuffer()};
+        CHECK_FALSE(loadedManifest.Load(source));
+        CHECK(loadedManifest.entries_.empty());
+    }
+}
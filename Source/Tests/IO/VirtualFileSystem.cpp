@@ -21,8 +21,16 @@
 //
 #include "../CommonUtils.h"
 
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/MappedFile.h>
+#include <Urho3D/IO/PackageBuilder.h>
+#include <Urho3D/IO/PackageFile.h>
 #include <Urho3D/IO/VirtualFileSystem.h>
 
+#include <atomic>
+#include <thread>
+
 TEST_CASE("FileIdentifier tests")
 {
     REQUIRE(!FileIdentifier::Empty);
@@ -54,3 +62,109 @@ TEST_CASE("VirtualFileSystem can read and write text")
     auto restoredText = vfs->ReadAllText(fileId);
     REQUIRE(testString == restoredText);
 }
+
+TEST_CASE("VirtualFileSystem reads files asynchronously")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto vfs = context->GetSubsystem<VirtualFileSystem>();
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+    const ea::string packageName = fileSystem->GetTemporaryDir() + "AsyncReadTest.pak";
+
+    ea::vector<ByteVector> contents;
+    {
+        PackageBuilder builder(context);
+        REQUIRE(builder.Create(packageName));
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            ByteVector data(1000 + i * 100);
+            for (unsigned j = 0; j < data.size(); ++j)
+                data[j] = static_cast<unsigned char>(i * 31 + j % 7);
+
+            const auto compression = i == 3 ? PackageCompression::LZ4 : PackageCompression::None;
+            REQUIRE(builder.Append(Format("AsyncReadTest/{}.bin", i), data.data(), data.size(), compression));
+            contents.push_back(ea::move(data));
+        }
+
+        // Entry is big enough to be memory mapped
+        ByteVector data(MountPoint::DefaultMappedFileThreshold + 1000);
+        for (unsigned j = 0; j < data.size(); ++j)
+            data[j] = static_cast<unsigned char>(j % 251);
+        REQUIRE(builder.Append("AsyncReadTest/Mapped.bin", data.data(), data.size(), PackageCompression::None));
+        contents.push_back(ea::move(data));
+
+        REQUIRE(builder.Build());
+    }
+
+    MountPointGuard packageGuard(MakeShared<PackageFile>(context, packageName));
+
+    // Keep worker threads busy until all requests are queued, so they are processed in one batch
+    const unsigned numWorkerThreads = workQueue->GetNumProcessingThreads() - 1;
+    std::atomic<unsigned> numBlockedThreads{};
+    std::atomic<bool> areThreadsBlocked{true};
+    for (unsigned i = 1; i <= numWorkerThreads; ++i)
+    {
+        workQueue->PostTaskForThread([&]()
+        {
+            ++numBlockedThreads;
+            while (areThreadsBlocked)
+                std::this_thread::yield();
+        }, TaskPriority::High, i);
+    }
+    while (numBlockedThreads < numWorkerThreads)
+        std::this_thread::yield();
+
+    const unsigned numCoalescedReads = vfs->GetNumCoalescedReads();
+    const unsigned numMappedReads = vfs->GetNumMappedReads();
+    ea::vector<SharedPtr<AsyncReadRequest>> requests;
+    std::atomic<unsigned> numCallbacks{};
+    std::atomic<unsigned> numCompletedInCallbacks{};
+    for (unsigned i = 0; i < contents.size(); ++i)
+    {
+        const bool isMapped = i + 1 == contents.size();
+        const ea::string fileName = isMapped ? "AsyncReadTest/Mapped.bin" : Format("AsyncReadTest/{}.bin", i);
+        requests.push_back(vfs->ReadAsync(FileIdentifier{"", fileName}, 0, M_MAX_UNSIGNED,
+            [&](AsyncReadRequest* request)
+        {
+            ++numCallbacks;
+            if (request->IsCompleted())
+                ++numCompletedInCallbacks;
+        }));
+    }
+    const auto partialRequest = vfs->ReadAsync(FileIdentifier{"", "AsyncReadTest/1.bin"}, 500, 300);
+    const auto partialMappedRequest = vfs->ReadAsync(FileIdentifier{"", "AsyncReadTest/Mapped.bin"}, 5000, 300);
+    const auto missingRequest = vfs->ReadAsync(FileIdentifier{"", "AsyncReadTest/Missing.bin"});
+
+    areThreadsBlocked = false;
+    workQueue->CompleteAll();
+
+    CHECK(numCallbacks == contents.size());
+    CHECK(numCompletedInCallbacks == contents.size());
+    for (unsigned i = 0; i < contents.size(); ++i)
+    {
+        REQUIRE(requests[i]->IsCompleted());
+        CHECK(requests[i]->IsSucceeded());
+        CHECK(requests[i]->GetData() == contents[i]);
+    }
+
+    REQUIRE(partialRequest->IsCompleted());
+    CHECK(partialRequest->IsSucceeded());
+    CHECK(partialRequest->GetData() == ByteVector(contents[1].begin() + 500, contents[1].begin() + 800));
+
+    REQUIRE(partialMappedRequest->IsCompleted());
+    CHECK(partialMappedRequest->IsSucceeded());
+    CHECK(partialMappedRequest->GetData()
+        == ByteVector(contents.back().begin() + 5000, contents.back().begin() + 5300));
+
+    REQUIRE(missingRequest->IsCompleted());
+    CHECK_FALSE(missingRequest->IsSucceeded());
+
+    // Uncompressed files are stored next to each other and read at once
+    CHECK(vfs->GetNumCoalescedReads() - numCoalescedReads == 4);
+    // Mapped file is copied from memory
+    if (MappedFile::IsSupported())
+        CHECK(vfs->GetNumMappedReads() - numMappedReads == 2);
+
+    packageGuard.Release();
+    fileSystem->Delete(packageName);
+}
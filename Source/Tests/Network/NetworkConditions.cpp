@@ -0,0 +1,275 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Network/NetworkConditions.h>
+#include <Urho3D/Network/Protocol.h>
+#include <Urho3D/Network/Transport/Simulated/SimulatedConnection.h>
+
+namespace
+{
+
+struct DeliveredPacket
+{
+    long long timeMs_{};
+    unsigned index_{};
+
+    bool operator==(const DeliveredPacket& rhs) const { return timeMs_ == rhs.timeMs_ && index_ == rhs.index_; }
+};
+
+ByteVector MakePacket(unsigned index, unsigned size = 4)
+{
+    ByteVector data(ea::max(size, 4u));
+    data[0] = static_cast<unsigned char>(index);
+    data[1] = static_cast<unsigned char>(index >> 8);
+    data[2] = static_cast<unsigned char>(index >> 16);
+    data[3] = static_cast<unsigned char>(index >> 24);
+    return data;
+}
+
+unsigned ParsePacket(ConstByteSpan data)
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24);
+}
+
+/// Send packets every millisecond and collect all delivered packets.
+ea::vector<DeliveredPacket> SimulateTraffic(
+    NetworkConditionSimulator& simulator, unsigned numPackets, PacketTypeFlags type, unsigned packetSize = 4)
+{
+    ea::vector<DeliveredPacket> result;
+    const auto collect = [&](long long timeMs)
+    {
+        simulator.Deliver(timeMs, [&](ConstByteSpan data, PacketTypeFlags packetType)
+        {
+            CHECK(packetType == type);
+            result.push_back({timeMs, ParsePacket(data)});
+        });
+    };
+
+    long long timeMs = 0;
+    for (unsigned i = 0; i < numPackets; ++i, ++timeMs)
+    {
+        simulator.Send(MakePacket(i, packetSize), type, timeMs);
+        collect(timeMs);
+    }
+    for (; simulator.GetNumPacketsInFlight() != 0; ++timeMs)
+        collect(timeMs);
+    return result;
+}
+
+/// Transport that records sent messages.
+class RecordingConnection : public NetworkConnection
+{
+    URHO3D_OBJECT(RecordingConnection, NetworkConnection);
+
+public:
+    explicit RecordingConnection(Context* context)
+        : NetworkConnection(context)
+    {
+        state_ = State::Connected;
+    }
+
+    bool Connect(const URL& url) override { return true; }
+    void Disconnect() override { state_ = State::Disconnected; }
+    unsigned GetMaxMessageSize() const override { return MaxNetworkPacketSize; }
+    void SendMessage(ea::string_view data, PacketTypeFlags type) override { messages_.emplace_back(data); }
+
+    ea::vector<ea::string> messages_;
+};
+
+} // namespace
+
+TEST_CASE("Simulated network conditions are deterministic")
+{
+    NetworkConditions conditions;
+    conditions.latencyMs_ = 50.0f;
+    conditions.jitterMs_ = 20.0f;
+    conditions.spikeRate_ = 0.01f;
+    conditions.spikeLatencyMs_ = 200.0f;
+    conditions.lossRate_ = 0.05f;
+    conditions.lossBurstLength_ = 3.0f;
+    conditions.duplicateRate_ = 0.02f;
+    conditions.reorderRate_ = 0.05f;
+    conditions.bandwidth_ = 64 * 1024;
+    conditions.seed_ = 1;
+
+    NetworkConditionSimulator simulator1{conditions};
+    NetworkConditionSimulator simulator2{conditions};
+    conditions.seed_ = 2;
+    NetworkConditionSimulator simulator3{conditions};
+
+    const auto packets1 = SimulateTraffic(simulator1, 2000, PacketType::UnreliableUnordered, 40);
+    const auto packets2 = SimulateTraffic(simulator2, 2000, PacketType::UnreliableUnordered, 40);
+    const auto packets3 = SimulateTraffic(simulator3, 2000, PacketType::UnreliableUnordered, 40);
+
+    CHECK(packets1 == packets2);
+    CHECK_FALSE(packets1 == packets3);
+
+    const NetworkConditionStats& stats = simulator1.GetStats();
+    CHECK(stats.numPackets_ == 2000);
+    CHECK(stats.numLost_ > 0);
+    CHECK(stats.numDuplicated_ > 0);
+    CHECK(stats.numReordered_ > 0);
+    CHECK(packets1.size() == stats.numPackets_ - stats.numLost_ - stats.numDroppedByBandwidth_ + stats.numDuplicated_);
+}
+
+TEST_CASE("Simulated packet loss has expected rate and burst length")
+{
+    static constexpr unsigned numPackets = 50000;
+
+    const float burstLength = GENERATE(1.0f, 4.0f);
+
+    NetworkConditions conditions;
+    conditions.latencyMs_ = 10.0f;
+    conditions.lossRate_ = 0.1f;
+    conditions.lossBurstLength_ = burstLength;
+
+    NetworkConditionSimulator simulator{conditions};
+    const auto packets = SimulateTraffic(simulator, numPackets, PacketType::UnreliableUnordered);
+
+    ea::vector<bool> isReceived(numPackets);
+    for (const DeliveredPacket& packet : packets)
+    {
+        CHECK(packet.timeMs_ == packet.index_ + 10);
+        isReceived[packet.index_] = true;
+    }
+
+    unsigned numLost = 0;
+    unsigned numBursts = 0;
+    for (unsigned i = 0; i < numPackets; ++i)
+    {
+        if (!isReceived[i])
+        {
+            ++numLost;
+            if (i == 0 || isReceived[i - 1])
+                ++numBursts;
+        }
+    }
+
+    CHECK(numLost == simulator.GetStats().numLost_);
+    CHECK(numLost / static_cast<float>(numPackets) == Catch::Approx(0.1f).margin(0.015f));
+    CHECK(numLost / static_cast<float>(numBursts) == Catch::Approx(burstLength).epsilon(0.1f));
+}
+
+TEST_CASE("Simulated network delivers reliable packets and preserves order of ordered packets")
+{
+    static constexpr unsigned numPackets = 2000;
+
+    const PacketTypeFlags type = GENERATE(PacketTypeFlags{PacketType::ReliableOrdered},
+        PacketTypeFlags{PacketType::ReliableUnordered}, PacketTypeFlags{PacketType::UnreliableOrdered});
+    const bool isReliable = type.Test(PacketType::Reliable);
+    const bool isOrdered = type.Test(PacketType::Ordered);
+
+    NetworkConditions conditions;
+    conditions.latencyMs_ = 40.0f;
+    conditions.jitterMs_ = 30.0f;
+    conditions.lossRate_ = 0.2f;
+    conditions.lossBurstLength_ = 2.0f;
+    conditions.duplicateRate_ = 0.1f;
+    conditions.reorderRate_ = 0.1f;
+
+    NetworkConditionSimulator simulator{conditions};
+    const auto packets = SimulateTraffic(simulator, numPackets, type);
+
+    if (isReliable)
+    {
+        REQUIRE(packets.size() == numPackets);
+        CHECK(simulator.GetStats().numRetransmitted_ > 0);
+        CHECK(simulator.GetStats().numDuplicated_ == 0);
+    }
+
+    ea::vector<unsigned> numReceived(numPackets);
+    for (const DeliveredPacket& packet : packets)
+        ++numReceived[packet.index_];
+
+    for (unsigned i = 0; i < numPackets; ++i)
+    {
+        if (isReliable)
+            REQUIRE(numReceived[i] == 1);
+        else
+            REQUIRE(numReceived[i] <= 2);
+    }
+
+    bool isSorted = true;
+    for (unsigned i = 1; i < packets.size(); ++i)
+    {
+        if (packets[i].index_ < packets[i - 1].index_)
+            isSorted = false;
+    }
+    CHECK(isSorted == isOrdered);
+}
+
+TEST_CASE("Simulated network limits bandwidth")
+{
+    static constexpr unsigned packetSize = 100;
+    static constexpr unsigned bandwidth = 10000;
+
+    NetworkConditions conditions;
+    conditions.latencyMs_ = 20.0f;
+    conditions.bandwidth_ = bandwidth;
+    conditions.maxQueueDelayMs_ = 250.0f;
+
+    // Reliable packets are queued
+    {
+        NetworkConditionSimulator simulator{conditions};
+        for (unsigned i = 0; i < 100; ++i)
+            simulator.Send(MakePacket(i, packetSize), PacketType::ReliableOrdered, 0);
+
+        unsigned numDelivered = 0;
+        simulator.Deliver(1000, [&](ConstByteSpan data, PacketTypeFlags type) { ++numDelivered; });
+        CHECK(numDelivered == 100 - 2);
+        simulator.Deliver(1020, [&](ConstByteSpan data, PacketTypeFlags type) { ++numDelivered; });
+        CHECK(numDelivered == 100);
+    }
+
+    // Unreliable packets are dropped when queue is too long
+    {
+        NetworkConditionSimulator simulator{conditions};
+        for (unsigned i = 0; i < 100; ++i)
+            simulator.Send(MakePacket(i, packetSize), PacketType::UnreliableUnordered, 0);
+
+        unsigned numDelivered = 0;
+        simulator.Deliver(10000, [&](ConstByteSpan data, PacketTypeFlags type) { ++numDelivered; });
+        CHECK(numDelivered == 26);
+        CHECK(simulator.GetStats().numDroppedByBandwidth_ == 100 - 26);
+    }
+}
+
+TEST_CASE("SimulatedConnection delays outgoing messages")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    NetworkConditions conditions;
+    conditions.latencyMs_ = 1000.0f;
+
+    auto recordingConnection = MakeShared<RecordingConnection>(context);
+    auto connection = MakeShared<SimulatedConnection>(context, recordingConnection, conditions);
+    CHECK(connection->GetState() == NetworkConnection::State::Connected);
+
+    // Incoming messages are not affected
+    ea::vector<ea::string> receivedMessages;
+    connection->onMessage_ = [&](ea::string_view data) { receivedMessages.emplace_back(data); };
+    recordingConnection->onMessage_("incoming");
+    REQUIRE(receivedMessages.size() == 1);
+    CHECK(receivedMessages[0] == "incoming");
+
+    // Outgoing messages are delayed
+    connection->SendMessage("first", PacketType::ReliableOrdered);
+    connection->SendMessage("second", PacketType::ReliableOrdered);
+    connection->Update(10);
+    CHECK(recordingConnection->messages_.empty());
+
+    connection->Update(10000);
+    REQUIRE(recordingConnection->messages_.size() == 2);
+    CHECK(recordingConnection->messages_[0] == "first");
+    CHECK(recordingConnection->messages_[1] == "second");
+    CHECK(connection->GetStats().numPackets_ == 2);
+
+    // Messages are sent immediately if conditions are ideal
+    connection->SetConditions(NetworkConditions{});
+    connection->SendMessage("third", PacketType::UnreliableUnordered);
+    REQUIRE(recordingConnection->messages_.size() == 3);
+    CHECK(recordingConnection->messages_[2] == "third");
+}
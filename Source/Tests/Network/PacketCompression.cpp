@@ -0,0 +1,401 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/PackageBuilder.h>
+#include <Urho3D/IO/PackageFile.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Network/Connection.h>
+#include <Urho3D/Network/Network.h>
+#include <Urho3D/Network/NetworkEvents.h>
+#include <Urho3D/Network/PacketCompression.h>
+#include <Urho3D/Network/Transport/NetworkConnection.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+/// Transport that immediately delivers packets to the other end.
+class LoopbackConnection : public NetworkConnection
+{
+    URHO3D_OBJECT(LoopbackConnection, NetworkConnection);
+
+public:
+    explicit LoopbackConnection(Context* context)
+        : NetworkConnection(context)
+    {
+        state_ = State::Connected;
+    }
+
+    bool Connect(const URL& url) override { return true; }
+    void Disconnect() override { state_ = State::Disconnected; }
+    unsigned GetMaxMessageSize() const override { return MaxNetworkPacketSize; }
+
+    void SendMessage(ea::string_view data, PacketTypeFlags type) override
+    {
+        ++numPackets_;
+        numBytes_ += data.size();
+        if (peer_ && peer_->onMessage_)
+            peer_->onMessage_(data);
+    }
+
+    LoopbackConnection* peer_{};
+    unsigned numPackets_{};
+    unsigned long long numBytes_{};
+};
+
+ByteVector CreateGameTrafficPacket(RandomEngine& random)
+{
+    // Imitate replication message: object ids, component types and slowly changing values
+    VectorBuffer buffer;
+    const unsigned numObjects = random.GetUInt(4, 12);
+    for (unsigned i = 0; i < numObjects; ++i)
+    {
+        buffer.WriteUInt(1000 + random.GetUInt(16));
+        buffer.WriteStringHash(StringHash{"ReplicatedTransform"});
+        buffer.WriteVector3(Vector3{random.GetFloat(-2.0f, 2.0f), 0.0f, 10.0f});
+        buffer.WriteQuaternion(Quaternion::IDENTITY);
+    }
+    return buffer.GetBuffer();
+}
+
+ByteVector CreatePackageData(unsigned size)
+{
+    ByteVector data(size);
+    unsigned state = 1;
+    for (unsigned i = 0; i < size; ++i)
+    {
+        state = state * 1664525u + 1013904223u;
+        data[i] = (state >> 28) == 0 ? static_cast<unsigned char>(state >> 20) : static_cast<unsigned char>((i / 7) % 13);
+    }
+    return data;
+}
+
+struct PackageTransferResult
+{
+    unsigned long long numBytesSent_{};
+    unsigned long long numBytesSaved_{};
+    double timeSeconds_{};
+};
+
+/// Transfer package from server connection and reassemble it from raw packets.
+PackageTransferResult TransferPackage(Context* context, unsigned packageSize, bool compression)
+{
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+    const ea::string fileName = fileSystem->GetTemporaryDir() + "PacketCompressionTest.pak";
+    const ByteVector packageData = CreatePackageData(packageSize);
+    {
+        PackageBuilder builder(context);
+        REQUIRE(builder.Create(fileName));
+        REQUIRE(builder.Append("Data.bin", packageData.data(), packageData.size(), PackageCompression::None));
+        REQUIRE(builder.Build());
+    }
+
+    auto package = MakeShared<PackageFile>(context);
+    REQUIRE(package->Open(fileName));
+    auto scene = MakeShared<Scene>(context);
+    scene->AddRequiredPackageFile(package);
+
+    auto network = context->GetSubsystem<Network>();
+    network->SetPacketCompression(compression);
+
+    auto serverTransport = MakeShared<LoopbackConnection>(context);
+    auto clientTransport = MakeShared<LoopbackConnection>(context);
+    serverTransport->peer_ = clientTransport;
+    clientTransport->peer_ = serverTransport;
+
+    auto serverConnection = MakeShared<Connection>(context, serverTransport);
+    serverConnection->Initialize();
+    serverConnection->SetIsClient(true);
+    serverConnection->SetScene(scene);
+    serverConnection->SendAllBuffers();
+    network->SetPacketCompression(false);
+
+    // Reassemble package file from fragments
+    ByteVector receivedFile(package->GetTotalSize());
+    unsigned numFragments = 0;
+    PacketCompressor decompressor;
+    ByteVector decompressedPacket;
+    const auto processMessages = [&](MemoryBuffer& packet, auto& self) -> void
+    {
+        while (!packet.IsEof())
+        {
+            const unsigned messageId = packet.ReadUShort();
+            const unsigned messageSize = packet.ReadUShort();
+            MemoryBuffer message(packet.GetData() + packet.GetPosition(), messageSize);
+            packet.Seek(packet.GetPosition() + messageSize);
+
+            if (messageId == MSG_COMPRESSED_PACKET)
+            {
+                const unsigned originalSize = message.ReadUShort();
+                const ConstByteSpan compressedData{message.GetData() + 2, messageSize - 2};
+                REQUIRE(decompressor.Decompress(compressedData, originalSize, decompressedPacket));
+                MemoryBuffer decompressedBuffer{decompressedPacket};
+                self(decompressedBuffer, self);
+            }
+            else if (messageId == MSG_PACKAGEDATA)
+            {
+                message.ReadStringHash();
+                const unsigned fragment = message.ReadUInt();
+                const unsigned offset = fragment * (MaxNetworkPacketSize - NetworkMessageHeaderSize - 8);
+                const unsigned size = message.GetSize() - message.GetPosition();
+                REQUIRE(offset + size <= receivedFile.size());
+                message.Read(receivedFile.data() + offset, size);
+                ++numFragments;
+            }
+        }
+    };
+    clientTransport->onMessage_ = [&](ea::string_view data)
+    {
+        MemoryBuffer packet{data.data(), static_cast<unsigned>(data.size())};
+        processMessages(packet, processMessages);
+    };
+
+    // Client announces the same compression dictionary, so server may compress packets
+    VectorBuffer dictionaryMessage;
+    dictionaryMessage.WriteUShort(MSG_COMPRESSION_DICTIONARY);
+    dictionaryMessage.WriteUShort(4);
+    dictionaryMessage.WriteUInt(decompressor.GetDictionaryId());
+    MemoryBuffer dictionaryBuffer{dictionaryMessage.GetBuffer()};
+    REQUIRE(serverConnection->ProcessMessage(dictionaryBuffer));
+    CHECK(serverConnection->IsPacketCompressionActive() == compression);
+
+    VectorBuffer request;
+    request.WriteUShort(MSG_REQUESTPACKAGE);
+    request.WriteUShort(0);
+    request.WriteString(GetFileNameAndExtension(fileName));
+    reinterpret_cast<unsigned short*>(request.GetModifiableData())[1] = request.GetSize() - NetworkMessageHeaderSize;
+    MemoryBuffer requestBuffer{request.GetBuffer()};
+
+    const unsigned long long bytesBefore = serverTransport->numBytes_;
+    HiresTimer timer;
+    REQUIRE(serverConnection->ProcessMessage(requestBuffer));
+    serverConnection->SendPackages();
+    serverConnection->SendAllBuffers();
+
+    PackageTransferResult result;
+    result.timeSeconds_ = timer.GetUSec(false) / 1000000.0;
+    result.numBytesSent_ = serverTransport->numBytes_ - bytesBefore;
+    result.numBytesSaved_ = serverConnection->GetNumBytesSavedByCompression();
+
+    // Compare with the original package file
+    {
+        File file(context, fileName);
+        REQUIRE(file.IsOpen());
+        ByteVector expectedFile(file.GetSize());
+        REQUIRE(file.Read(expectedFile.data(), expectedFile.size()) == expectedFile.size());
+        CHECK(numFragments > 0);
+        CHECK(receivedFile == expectedFile);
+    }
+
+    serverConnection->SetScene(nullptr);
+    scene = nullptr;
+    package = nullptr;
+    fileSystem->Delete(fileName);
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("PacketCompressor compresses small packets with trained dictionary")
+{
+    RandomEngine random{0};
+    ea::vector<ByteVector> samples;
+    for (unsigned i = 0; i < 2000; ++i)
+        samples.push_back(CreateGameTrafficPacket(random));
+
+    const ByteVector dictionary = PacketCompressor::TrainDictionary(samples, 4096);
+    REQUIRE(!dictionary.empty());
+
+    PacketCompressor compressorWithoutDictionary;
+    PacketCompressor compressorWithDictionary{dictionary};
+    CHECK(compressorWithoutDictionary.GetDictionaryId() == 0);
+    CHECK(compressorWithDictionary.GetDictionaryId() != 0);
+
+    unsigned long long originalSize = 0;
+    unsigned long long sizeWithoutDictionary = 0;
+    unsigned long long sizeWithDictionary = 0;
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        const ByteVector packet = CreateGameTrafficPacket(random);
+        originalSize += packet.size();
+
+        ByteVector compressedPacket;
+        ByteVector decompressedPacket;
+        if (compressorWithoutDictionary.Compress(packet, compressedPacket))
+        {
+            REQUIRE(compressorWithoutDictionary.Decompress(compressedPacket, packet.size(), decompressedPacket));
+            CHECK(decompressedPacket == packet);
+        }
+        sizeWithoutDictionary += compressedPacket.empty() ? packet.size() : compressedPacket.size();
+
+        compressedPacket.clear();
+        REQUIRE(compressorWithDictionary.Compress(packet, compressedPacket));
+        REQUIRE(compressorWithDictionary.Decompress(compressedPacket, packet.size(), decompressedPacket));
+        CHECK(decompressedPacket == packet);
+        sizeWithDictionary += compressedPacket.size();
+
+        // Dictionary is required to decompress
+        CHECK_FALSE(compressorWithoutDictionary.Decompress(compressedPacket, packet.size(), decompressedPacket));
+    }
+
+    CHECK(sizeWithDictionary < sizeWithoutDictionary);
+    CHECK(sizeWithDictionary * 2 < originalSize);
+
+    // Malformed data is rejected
+    ByteVector decompressedPacket;
+    CHECK_FALSE(compressorWithDictionary.Decompress(ByteVector{1, 2, 3, 4}, 100, decompressedPacket));
+}
+
+TEST_CASE("Connection sends and receives compressed packets")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto network = context->GetSubsystem<Network>();
+
+    auto serverTransport = MakeShared<LoopbackConnection>(context);
+    auto clientTransport = MakeShared<LoopbackConnection>(context);
+    serverTransport->peer_ = clientTransport;
+    clientTransport->peer_ = serverTransport;
+
+    network->SetPacketCompression(true);
+    auto serverConnection = MakeShared<Connection>(context, serverTransport);
+    serverConnection->Initialize();
+    network->SetPacketCompression(false);
+
+    auto clientConnection = MakeShared<Connection>(context, clientTransport);
+    clientConnection->Initialize();
+
+    // Process packets immediately instead of queueing them until network update
+    clientTransport->onMessage_ = [&](ea::string_view data)
+    {
+        MemoryBuffer packet{data.data(), static_cast<unsigned>(data.size())};
+        REQUIRE(clientConnection->ProcessMessage(packet));
+    };
+    serverTransport->onMessage_ = [&](ea::string_view data)
+    {
+        MemoryBuffer packet{data.data(), static_cast<unsigned>(data.size())};
+        REQUIRE(serverConnection->ProcessMessage(packet));
+    };
+
+    // Compression is enabled only when both ends announced the same dictionary
+    CHECK_FALSE(serverConnection->IsPacketCompressionActive());
+    serverConnection->SendAllBuffers();
+    clientConnection->SendAllBuffers();
+    CHECK(serverConnection->IsPacketCompressionActive());
+    CHECK_FALSE(clientConnection->IsPacketCompressionActive());
+
+    ea::vector<ByteVector> receivedMessages;
+    clientConnection->SubscribeToEvent(clientConnection, E_NETWORKMESSAGE,
+        [&](VariantMap& eventData)
+    {
+        receivedMessages.push_back(eventData[NetworkMessage::P_DATA].GetBuffer());
+    });
+
+    RandomEngine random{1};
+    ea::vector<ByteVector> sentMessages;
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        sentMessages.push_back(CreateGameTrafficPacket(random));
+        serverConnection->SendMessage(MSG_USER, sentMessages.back(), PacketType::ReliableOrdered);
+    }
+    serverConnection->SendAllBuffers();
+
+    CHECK(receivedMessages == sentMessages);
+    CHECK(serverConnection->GetNumBytesSavedByCompression() > 0);
+    CHECK(clientConnection->GetNumBytesSavedByCompression() == 0);
+
+    clientConnection->UnsubscribeFromAllEvents();
+}
+
+TEST_CASE("Package is transferred through compressed packets")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const PackageTransferResult uncompressed = TransferPackage(context, 1024 * 1024, false);
+    const PackageTransferResult compressed = TransferPackage(context, 1024 * 1024, true);
+
+    CHECK(uncompressed.numBytesSaved_ == 0);
+    CHECK(compressed.numBytesSaved_ > 0);
+    CHECK(compressed.numBytesSent_ < uncompressed.numBytesSent_);
+}
+
+TEST_CASE("Connection sends uncompressed packets if dictionaries differ")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto network = context->GetSubsystem<Network>();
+
+    auto serverTransport = MakeShared<LoopbackConnection>(context);
+    auto clientTransport = MakeShared<LoopbackConnection>(context);
+    serverTransport->peer_ = clientTransport;
+    clientTransport->peer_ = serverTransport;
+
+    RandomEngine random{2};
+    ea::vector<ByteVector> samples;
+    for (unsigned i = 0; i < 2000; ++i)
+        samples.push_back(CreateGameTrafficPacket(random));
+
+    network->SetPacketCompression(true);
+    network->SetPacketCompressionDictionary(PacketCompressor::TrainDictionary(samples, 4096));
+    auto serverConnection = MakeShared<Connection>(context, serverTransport);
+    serverConnection->Initialize();
+    network->SetPacketCompression(false);
+    network->SetPacketCompressionDictionary({});
+
+    auto clientConnection = MakeShared<Connection>(context, clientTransport);
+    clientConnection->Initialize();
+
+    clientTransport->onMessage_ = [&](ea::string_view data)
+    {
+        MemoryBuffer packet{data.data(), static_cast<unsigned>(data.size())};
+        REQUIRE(clientConnection->ProcessMessage(packet));
+    };
+    serverTransport->onMessage_ = [&](ea::string_view data)
+    {
+        MemoryBuffer packet{data.data(), static_cast<unsigned>(data.size())};
+        REQUIRE(serverConnection->ProcessMessage(packet));
+    };
+    serverConnection->SendAllBuffers();
+    clientConnection->SendAllBuffers();
+    CHECK_FALSE(serverConnection->IsPacketCompressionActive());
+
+    ea::vector<ByteVector> receivedMessages;
+    clientConnection->SubscribeToEvent(clientConnection, E_NETWORKMESSAGE,
+        [&](VariantMap& eventData)
+    {
+        receivedMessages.push_back(eventData[NetworkMessage::P_DATA].GetBuffer());
+    });
+
+    ea::vector<ByteVector> sentMessages;
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        sentMessages.push_back(CreateGameTrafficPacket(random));
+        serverConnection->SendMessage(MSG_USER, sentMessages.back(), PacketType::ReliableOrdered);
+    }
+    serverConnection->SendAllBuffers();
+
+    CHECK(receivedMessages == sentMessages);
+    CHECK(serverConnection->GetNumBytesSavedByCompression() == 0);
+
+    clientConnection->UnsubscribeFromAllEvents();
+}
+
+TEST_CASE("Package transfer loopback benchmark", "[.benchmark]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    static constexpr unsigned packageSize = 50 * 1024 * 1024;
+    for (const bool compression : {false, true})
+    {
+        const PackageTransferResult result = TransferPackage(context, packageSize, compression);
+        URHO3D_LOGINFO("Package transfer{}: {:.1f} MB/s, {} bytes sent, {} bytes saved",
+            compression ? " with compression" : "", packageSize / (1024.0 * 1024.0) / result.timeSeconds_,
+            result.numBytesSent_, result.numBytesSaved_);
+    }
+}
@@ -0,0 +1,457 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/Mutex.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Network/Transport/UDP/UDPConnection.h>
+#include <Urho3D/Network/Transport/UDP/UDPServer.h>
+
+#include <EASTL/sort.h>
+
+#include <atomic>
+
+namespace
+{
+
+/// One direction of simulated network link with loss, duplication and reordering.
+class SimulatedLink
+{
+public:
+    SimulatedLink(unsigned seed, float lossRate, float duplicateRate, float jitterMs)
+        : state_(seed)
+        , lossRate_(lossRate)
+        , duplicateRate_(duplicateRate)
+        , jitterMs_(jitterMs)
+    {
+    }
+
+    void Send(ConstByteSpan data, long long timeMs)
+    {
+        if (Random() < lossRate_)
+            return;
+
+        const unsigned numCopies = Random() < duplicateRate_ ? 2 : 1;
+        for (unsigned i = 0; i < numCopies; ++i)
+        {
+            const long long deliveryTimeMs = timeMs + 10 + static_cast<long long>(Random() * jitterMs_);
+            datagrams_.push_back({deliveryTimeMs, ByteVector(data.begin(), data.end())});
+        }
+    }
+
+    template <class T> void Deliver(long long timeMs, const T& callback)
+    {
+        for (auto iter = datagrams_.begin(); iter != datagrams_.end();)
+        {
+            if (iter->first > timeMs)
+            {
+                ++iter;
+                continue;
+            }
+
+            callback(iter->second);
+            iter = datagrams_.erase(iter);
+        }
+    }
+
+private:
+    float Random()
+    {
+        state_ = state_ * 1664525u + 1013904223u;
+        return (state_ >> 8) / static_cast<float>(1u << 24);
+    }
+
+    unsigned state_{};
+    float lossRate_{};
+    float duplicateRate_{};
+    float jitterMs_{};
+    ea::vector<ea::pair<long long, ByteVector>> datagrams_;
+};
+
+ea::string MakeMessage(PacketType type, unsigned index)
+{
+    return Format("{}:{}", static_cast<unsigned>(type), index);
+}
+
+ea::pair<unsigned, unsigned> ParseMessage(ea::string_view message)
+{
+    const auto separator = message.find(':');
+    const ea::string type{message.substr(0, separator)};
+    const ea::string index{message.substr(separator + 1)};
+    return {ToUInt(type), ToUInt(index)};
+}
+
+template <class T> bool WaitFor(const T& condition, unsigned timeoutMs = 5000)
+{
+    Timer timer;
+    while (!condition())
+    {
+        if (timer.GetMSec(false) > timeoutMs)
+            return false;
+        Time::Sleep(1);
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("UDPSession delivers messages over lossy link")
+{
+    static constexpr unsigned numMessages = 300;
+    static constexpr PacketType packetTypes[] = {PacketType::UnreliableUnordered, PacketType::UnreliableOrdered,
+        PacketType::ReliableUnordered, PacketType::ReliableOrdered};
+
+    // Unreliable link also duplicates and reorders datagrams
+    const float lossRate = GENERATE(0.0f, 0.2f);
+    const bool isReliableLink = lossRate == 0.0f;
+    const float duplicateRate = isReliableLink ? 0.0f : 0.05f;
+    const float jitterMs = isReliableLink ? 0.0f : 20.0f;
+
+    UDPSession sender;
+    UDPSession receiver;
+    SimulatedLink forwardLink{1u, lossRate, duplicateRate, jitterMs};
+    SimulatedLink backwardLink{2u, lossRate, duplicateRate, jitterMs};
+
+    ea::vector<unsigned> received[4];
+    const auto onMessage = [&](ea::string_view message)
+    {
+        const auto [type, index] = ParseMessage(message);
+        REQUIRE(type < 4);
+        received[type].push_back(index);
+    };
+    const auto ignoreMessage = [](ea::string_view message) {};
+
+    long long timeMs = 0;
+    for (unsigned i = 0; i < numMessages; ++i)
+    {
+        for (PacketType type : packetTypes)
+            sender.QueueMessage(MakeMessage(type, i), type);
+
+        // Send in bursts to exercise coalescing
+        if (i % 10 == 9)
+        {
+            timeMs += 5;
+            sender.SendDatagrams(timeMs, [&](ConstByteSpan data) { forwardLink.Send(data, timeMs); });
+            receiver.SendDatagrams(timeMs, [&](ConstByteSpan data) { backwardLink.Send(data, timeMs); });
+            forwardLink.Deliver(timeMs, [&](ConstByteSpan data) { REQUIRE(receiver.ProcessDatagram(data, timeMs, onMessage)); });
+            backwardLink.Deliver(timeMs, [&](ConstByteSpan data) { REQUIRE(sender.ProcessDatagram(data, timeMs, ignoreMessage)); });
+        }
+    }
+
+    for (unsigned i = 0; i < 1000 && sender.HasPendingMessages(); ++i)
+    {
+        timeMs += 5;
+        sender.SendDatagrams(timeMs, [&](ConstByteSpan data) { forwardLink.Send(data, timeMs); });
+        receiver.SendDatagrams(timeMs, [&](ConstByteSpan data) { backwardLink.Send(data, timeMs); });
+        forwardLink.Deliver(timeMs, [&](ConstByteSpan data) { REQUIRE(receiver.ProcessDatagram(data, timeMs, onMessage)); });
+        backwardLink.Deliver(timeMs, [&](ConstByteSpan data) { REQUIRE(sender.ProcessDatagram(data, timeMs, ignoreMessage)); });
+    }
+    REQUIRE_FALSE(sender.HasPendingMessages());
+
+    ea::vector<unsigned> allIndices(numMessages);
+    for (unsigned i = 0; i < numMessages; ++i)
+        allIndices[i] = i;
+
+    // Reliable ordered messages are delivered exactly once and in order
+    CHECK(received[PacketType::ReliableOrdered] == allIndices);
+
+    // Reliable unordered messages are delivered exactly once
+    ea::vector<unsigned> reliableUnordered = received[PacketType::ReliableUnordered];
+    ea::sort(reliableUnordered.begin(), reliableUnordered.end());
+    CHECK(reliableUnordered == allIndices);
+
+    // Unreliable ordered messages are never delivered out of order
+    const ea::vector<unsigned>& unreliableOrdered = received[PacketType::UnreliableOrdered];
+    CHECK(ea::is_sorted(unreliableOrdered.begin(), unreliableOrdered.end(), ea::less_equal<unsigned>{}));
+    CHECK(ea::adjacent_find(unreliableOrdered.begin(), unreliableOrdered.end()) == unreliableOrdered.end());
+
+    // Duplicated datagrams are not delivered twice
+    ea::vector<unsigned> unreliableUnordered = received[PacketType::UnreliableUnordered];
+    ea::sort(unreliableUnordered.begin(), unreliableUnordered.end());
+    CHECK(ea::adjacent_find(unreliableUnordered.begin(), unreliableUnordered.end()) == unreliableUnordered.end());
+
+    const UDPSessionStats& stats = sender.GetStats();
+    CHECK(stats.numMessagesSent_ == numMessages * 4);
+    if (isReliableLink)
+    {
+        CHECK(received[PacketType::UnreliableOrdered].size() == numMessages);
+        CHECK(received[PacketType::UnreliableUnordered].size() == numMessages);
+        CHECK(stats.numMessagesResent_ == 0);
+        // Small messages are coalesced
+        CHECK(stats.numDatagramsSent_ < numMessages / 4);
+    }
+    else
+    {
+        CHECK(stats.numMessagesResent_ > 0);
+    }
+}
+
+TEST_CASE("UDPSession transfers megabytes of reliable data without excessive resends")
+{
+    static constexpr unsigned totalSize = 4 * 1024 * 1024;
+    static constexpr unsigned numMessages = totalSize / UDPSession::MaxMessageSize;
+
+    const float lossRate = GENERATE(0.0f, 0.05f);
+
+    UDPSession sender;
+    UDPSession receiver;
+    SimulatedLink forwardLink{1u, lossRate, 0.0f, 0.0f};
+    SimulatedLink backwardLink{2u, lossRate, 0.0f, 0.0f};
+
+    ea::vector<unsigned> received;
+    const auto onMessage = [&](ea::string_view message)
+    {
+        REQUIRE(message.size() == UDPSession::MaxMessageSize);
+        received.push_back(ToUInt(ea::string{message.substr(0, message.find(' '))}));
+    };
+    const auto ignoreMessage = [](ea::string_view message) {};
+
+    // Queue whole payload at once, like package upload does
+    for (unsigned i = 0; i < numMessages; ++i)
+    {
+        ea::string message = Format("{} ", i);
+        message.resize(UDPSession::MaxMessageSize, '*');
+        sender.QueueMessage(message, PacketType::ReliableOrdered);
+    }
+
+    long long timeMs = 0;
+    for (unsigned i = 0; i < 100000 && sender.HasPendingMessages(); ++i)
+    {
+        timeMs += 2;
+        sender.SendDatagrams(timeMs, [&](ConstByteSpan data) { forwardLink.Send(data, timeMs); });
+        receiver.SendDatagrams(timeMs, [&](ConstByteSpan data) { backwardLink.Send(data, timeMs); });
+        forwardLink.Deliver(timeMs, [&](ConstByteSpan data) { REQUIRE(receiver.ProcessDatagram(data, timeMs, onMessage)); });
+        backwardLink.Deliver(timeMs, [&](ConstByteSpan data) { REQUIRE(sender.ProcessDatagram(data, timeMs, ignoreMessage)); });
+    }
+    REQUIRE_FALSE(sender.HasPendingMessages());
+
+    REQUIRE(received.size() == numMessages);
+    for (unsigned i = 0; i < numMessages; ++i)
+        REQUIRE(received[i] == i);
+
+    // Only lost datagrams are resent
+    const UDPSessionStats& stats = sender.GetStats();
+    if (lossRate == 0.0f)
+        CHECK(stats.numMessagesResent_ == 0);
+    else
+        CHECK(stats.numMessagesResent_ < numMessages * lossRate * 4);
+}
+
+TEST_CASE("UDP transport connects and exchanges messages over loopback")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    Mutex mutex;
+    SharedPtr<NetworkConnection> serverConnection;
+    ea::vector<ea::string> serverMessages;
+    std::atomic<bool> serverDisconnected{};
+
+    auto server = MakeShared<UDPServer>(context);
+    server->onConnected_ = [&](NetworkConnection* connection)
+    {
+        MutexLock lock(mutex);
+        serverConnection = connection;
+        connection->onMessage_ = [&](ea::string_view message)
+        {
+            MutexLock lock(mutex);
+            serverMessages.emplace_back(message);
+        };
+    };
+    server->onDisconnected_ = [&](NetworkConnection* connection) { serverDisconnected = true; };
+    REQUIRE(server->Listen(URL("udp://localhost:0")));
+    REQUIRE(server->GetPort() != 0);
+
+    std::atomic<bool> clientConnected{};
+    std::atomic<bool> clientDisconnected{};
+    ea::vector<ea::string> clientMessages;
+
+    auto client = MakeShared<UDPConnection>(context);
+    client->onConnected_ = [&]() { clientConnected = true; };
+    client->onDisconnected_ = [&]() { clientDisconnected = true; };
+    client->onMessage_ = [&](ea::string_view message)
+    {
+        MutexLock lock(mutex);
+        clientMessages.emplace_back(message);
+    };
+    REQUIRE(client->Connect(URL(Format("udp://127.0.0.1:{}", server->GetPort()))));
+
+    REQUIRE(WaitFor([&] { return clientConnected.load(); }));
+    REQUIRE(WaitFor([&] { MutexLock lock(mutex); return serverConnection != nullptr; }));
+    CHECK(client->GetState() == NetworkConnection::State::Connected);
+    CHECK(server->GetNumConnections() == 1);
+
+    static constexpr unsigned numMessages = 100;
+    for (unsigned i = 0; i < numMessages; ++i)
+        client->SendMessage(MakeMessage(PacketType::ReliableOrdered, i), PacketType::ReliableOrdered);
+    REQUIRE(WaitFor([&] { MutexLock lock(mutex); return serverMessages.size() == numMessages; }));
+
+    {
+        MutexLock lock(mutex);
+        for (unsigned i = 0; i < numMessages; ++i)
+            CHECK(serverMessages[i] == MakeMessage(PacketType::ReliableOrdered, i));
+        serverConnection->SendMessage("Reply", PacketType::ReliableOrdered);
+    }
+    REQUIRE(WaitFor([&] { MutexLock lock(mutex); return clientMessages.size() == 1; }));
+    CHECK(clientMessages[0] == "Reply");
+
+    client->Disconnect();
+    REQUIRE(WaitFor([&] { return clientDisconnected.load() && serverDisconnected.load(); }));
+    CHECK(client->GetState() == NetworkConnection::State::Disconnected);
+    REQUIRE(WaitFor([&] { return server->GetNumConnections() == 0; }));
+
+    server->Stop();
+}
+
+TEST_CASE("UDP server creates connection only after challenge token is returned")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    std::atomic<unsigned> numConnected{};
+    auto server = MakeShared<UDPServer>(context);
+    server->onConnected_ = [&](NetworkConnection* connection) { ++numConnected; };
+    REQUIRE(server->Listen(URL("udp://localhost:0")));
+
+    UDPEndpoint serverEndpoint;
+    REQUIRE(UDPSocket::Resolve("127.0.0.1", server->GetPort(), serverEndpoint));
+
+    UDPSocket socket;
+    REQUIRE(socket.Open(0));
+
+    const auto sendConnect = [&](unsigned long long challengeToken)
+    {
+        VectorBuffer datagram;
+        datagram.WriteUByte(static_cast<unsigned char>(UDPDatagramKind::Connect));
+        datagram.WriteUInt(UDPConnection::ProtocolId);
+        datagram.WriteUInt64(challengeToken);
+
+        UDPSendQueue sendQueue;
+        sendQueue.Add(serverEndpoint, datagram.GetBuffer());
+        socket.Send(sendQueue);
+    };
+
+    const auto receiveResponse = [&](UDPDatagramKind kind, unsigned long long* challengeToken = nullptr)
+    {
+        ea::vector<UDPDatagram> incoming;
+        return WaitFor(
+            [&]
+        {
+            socket.Wait(UDPConnection::UpdateIntervalMs);
+            for (unsigned i = 0, numReceived = socket.Receive(incoming); i < numReceived; ++i)
+            {
+                MemoryBuffer source(incoming[i].data_);
+                if (source.ReadUByte() != static_cast<unsigned char>(kind))
+                    continue;
+                if (challengeToken)
+                    *challengeToken = source.ReadUInt64();
+                return true;
+            }
+            return false;
+        });
+    };
+
+    // Request without token is answered with challenge and doesn't create connection
+    unsigned long long challengeToken = 0;
+    sendConnect(0);
+    REQUIRE(receiveResponse(UDPDatagramKind::Challenge, &challengeToken));
+    CHECK(server->GetNumConnections() == 0);
+
+    // Wrong token is rejected too
+    sendConnect(challengeToken + 1);
+    REQUIRE(receiveResponse(UDPDatagramKind::Challenge));
+    CHECK(server->GetNumConnections() == 0);
+    CHECK(numConnected == 0);
+
+    // Returned token creates connection
+    sendConnect(challengeToken);
+    REQUIRE(receiveResponse(UDPDatagramKind::Accept));
+    CHECK(server->GetNumConnections() == 1);
+    CHECK(numConnected == 1);
+
+    server->Stop();
+}
+
+TEST_CASE("UDP transport loopback benchmark", "[.benchmark]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    static constexpr unsigned numClients = 64;
+    static constexpr unsigned numTicks = 60;
+    static constexpr unsigned tickIntervalMs = 16;
+    static constexpr unsigned numMessagesPerTick = 8;
+    static constexpr unsigned messageSize = 64;
+
+    Mutex mutex;
+    ea::vector<SharedPtr<NetworkConnection>> serverConnections;
+    std::atomic<unsigned> numReceived{};
+
+    auto server = MakeShared<UDPServer>(context);
+    server->onConnected_ = [&](NetworkConnection* connection)
+    {
+        connection->onMessage_ = [&](ea::string_view message) { ++numReceived; };
+        MutexLock lock(mutex);
+        serverConnections.emplace_back(connection);
+    };
+    REQUIRE(server->Listen(URL("udp://localhost:0")));
+
+    ea::vector<SharedPtr<UDPConnection>> clients;
+    for (unsigned i = 0; i < numClients; ++i)
+    {
+        auto client = MakeShared<UDPConnection>(context);
+        REQUIRE(client->Connect(URL(Format("udp://127.0.0.1:{}", server->GetPort()))));
+        clients.push_back(client);
+    }
+    REQUIRE(WaitFor([&] { return server->GetNumConnections() == numClients; }));
+    REQUIRE(WaitFor([&]
+    {
+        return ea::all_of(clients.begin(), clients.end(),
+            [](UDPConnection* client) { return client->GetState() == NetworkConnection::State::Connected; });
+    }));
+
+    const long long processingTimeBefore = server->GetProcessingTime();
+    const ea::string message(messageSize, 'x');
+    for (unsigned tick = 0; tick < numTicks; ++tick)
+    {
+        for (UDPConnection* client : clients)
+        {
+            for (unsigned i = 0; i < numMessagesPerTick; ++i)
+                client->SendMessage(message, i == 0 ? PacketType::ReliableOrdered : PacketType::UnreliableUnordered);
+        }
+
+        MutexLock lock(mutex);
+        for (NetworkConnection* connection : serverConnections)
+            connection->SendMessage(message, PacketType::UnreliableOrdered);
+        Time::Sleep(tickIntervalMs);
+    }
+    WaitFor([&] { return numReceived == numClients * numTicks * numMessagesPerTick; }, 1000);
+
+    const long long processingTime = server->GetProcessingTime() - processingTimeBefore;
+    unsigned long long bytesReceived = 0;
+    unsigned long long bytesSent = 0;
+    {
+        MutexLock lock(mutex);
+        for (NetworkConnection* connection : serverConnections)
+        {
+            const UDPSessionStats stats = static_cast<UDPConnection*>(connection)->GetStats();
+            bytesReceived += stats.numBytesReceived_;
+            bytesSent += stats.numBytesSent_;
+        }
+    }
+
+    const double timePerConnectionTickUs = static_cast<double>(processingTime) / (numClients * numTicks);
+    const double tickUs = tickIntervalMs * 1000.0;
+    URHO3D_LOGINFO("UDP server: {} of {} messages received, {:.2f} us per connection per tick, "
+                   "{:.0f} connections per core at {} ms tick, {:.0f} bytes received and {:.0f} bytes sent per connection per tick",
+        numReceived.load(), numClients * numTicks * numMessagesPerTick, timePerConnectionTickUs,
+        tickUs / ea::max(timePerConnectionTickUs, 0.001), tickIntervalMs,
+        static_cast<double>(bytesReceived) / (numClients * numTicks), static_cast<double>(bytesSent) / (numClients * numTicks));
+
+    for (UDPConnection* client : clients)
+        client->Disconnect();
+    WaitFor([&] { return server->GetNumConnections() == 0; }, 1000);
+    server->Stop();
+}
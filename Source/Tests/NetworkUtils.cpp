@@ -46,10 +46,44 @@ ManualConnection::ManualConnection(Context* context, ReplicationManager* sink, u
 {
 }
 
+void ManualConnection::SetConditions(const NetworkConditions& conditions)
+{
+    simulator_ = ea::make_unique<NetworkConditionSimulator>(conditions);
+}
+
+unsigned ManualConnection::GetPing() const
+{
+    if (simulator_)
+    {
+        const NetworkConditions& conditions = simulator_->GetConditions();
+        return RoundToInt(2 * (conditions.latencyMs_ + 0.8f * conditions.jitterMs_));
+    }
+    return RoundToInt(1000 * (quality_.minPing_ + quality_.maxPing_) / 2);
+}
+
 void ManualConnection::IncrementTime(unsigned delta)
 {
     currentTime_ += delta;
 
+    if (simulator_)
+    {
+        simulator_->Deliver(currentTime_, [&](ConstByteSpan data, PacketTypeFlags packetType)
+        {
+            const auto messageId = static_cast<NetworkMessageId>(data[0] | (data[1] << 8));
+            MemoryBuffer memoryBuffer(data.data() + 2, data.size() - 2);
+            sink_->ProcessMessage(sinkConnection_, messageId, memoryBuffer);
+        });
+        return;
+    }
+
+    // Allow bursts up to one network frame worth of data
+    if (quality_.bandwidth_ != 0)
+    {
+        const double maxBytesAvailable = static_cast<double>(quality_.bandwidth_) / NetworkSimulator::FramesInSecond;
+        bandwidthBytesAvailable_ =
+            ea::min(bandwidthBytesAvailable_ + quality_.bandwidth_ * delta / 1000.0, maxBytesAvailable);
+    }
+
     SendOrderedMessages(messages_[false][true]);
     SendOrderedMessages(messages_[true][true]);
 
@@ -57,6 +91,20 @@ void ManualConnection::IncrementTime(unsigned delta)
     SendUnorderedMessages(messages_[true][false]);
 }
 
+unsigned ManualConnection::GetNumBytesSent(NetworkMessageId messageId) const
+{
+    const auto iter = bytesSent_.find(messageId);
+    return iter != bytesSent_.end() ? iter->second : 0;
+}
+
+unsigned ManualConnection::GetTotalBytesSent() const
+{
+    unsigned result = 0;
+    for (const auto& [messageId, numBytes] : bytesSent_)
+        result += numBytes;
+    return result;
+}
+
 void ManualConnection::SendMessageInternal(NetworkMessageId messageId, const unsigned char* data, unsigned numBytes, PacketTypeFlags packetType)
 {
     const double currentDropRatio = droppedMessages_ / ea::max(1.0, static_cast<double>(totalUnreliableMessages_));
@@ -65,11 +113,22 @@ void ManualConnection::SendMessageInternal(NetworkMessageId messageId, const uns
     const bool inOrder = packetType & PacketType::Ordered;
 
     ++totalMessages_;
+    bytesSent_[messageId] += numBytes;
     if (!reliable)
         ++totalUnreliableMessages_;
     if (!inOrder)
         ++totalUnorderedMessages_;
 
+    if (simulator_)
+    {
+        simulatorBuffer_.clear();
+        simulatorBuffer_.push_back(static_cast<unsigned char>(messageId & 0xff));
+        simulatorBuffer_.push_back(static_cast<unsigned char>(messageId >> 8));
+        simulatorBuffer_.insert(simulatorBuffer_.end(), data, data + numBytes);
+        simulator_->Send(simulatorBuffer_, packetType, currentTime_);
+        return;
+    }
+
     // Simulate message loss
     if (!reliable && currentDropRatio < quality_.dropRate_)
     {
@@ -77,6 +136,17 @@ void ManualConnection::SendMessageInternal(NetworkMessageId messageId, const uns
         return;
     }
 
+    // Simulate bandwidth limit, reliable messages are always delivered
+    if (quality_.bandwidth_ != 0)
+    {
+        if (!reliable && numBytes > bandwidthBytesAvailable_)
+        {
+            ++bandwidthDroppedMessages_;
+            return;
+        }
+        bandwidthBytesAvailable_ -= numBytes;
+    }
+
     // Simulate shuffle
     auto& outgoingQueue = messages_[reliable][inOrder];
     unsigned index = outgoingQueue.size();
@@ -170,6 +240,20 @@ void NetworkSimulator::AddClient(Scene* clientScene, const ConnectionQuality& qu
     clients_.push_back(data);
 }
 
+void NetworkSimulator::AddClient(Scene* clientScene, const NetworkConditions& conditions)
+{
+    AddClient(clientScene, ConnectionQuality{});
+    PerClient& data = clients_.back();
+
+    NetworkConditions clientToServerConditions = conditions;
+    clientToServerConditions.seed_ += nextConditionsSeed_++;
+    data.clientToServer_->SetConditions(clientToServerConditions);
+
+    NetworkConditions serverToClientConditions = conditions;
+    serverToClientConditions.seed_ += nextConditionsSeed_++;
+    data.serverToClient_->SetConditions(serverToClientConditions);
+}
+
 void NetworkSimulator::RemoveClient(Scene* clientScene)
 {
     const auto iter = FindClientIter(clientScene);
@@ -254,6 +338,12 @@ AbstractConnection* NetworkSimulator::GetServerToClientConnection(Scene* clientS
     return iter != clients_.end() ? iter->serverToClient_ : nullptr;
 }
 
+ManualConnection* NetworkSimulator::GetClientToServerConnection(Scene* clientScene)
+{
+    const auto iter = FindClientIter(clientScene);
+    return iter != clients_.end() ? iter->clientToServer_ : nullptr;
+}
+
 Node* SpawnOnServer(Node* parent, StringHash objectType, PrefabResource* prefab, const ea::string& name,
     const Vector3& position, const Quaternion& rotation)
 {
@@ -25,8 +25,10 @@
 #include <Urho3D/Container/ByteVector.h>
 #include <Urho3D/Math/RandomEngine.h>
 #include <Urho3D/Network/AbstractConnection.h>
+#include <Urho3D/Network/NetworkConditions.h>
 #include <Urho3D/Replica/ReplicationManager.h>
 
+#include <EASTL/unique_ptr.h>
 #include <EASTL/vector.h>
 #include <EASTL/unordered_map.h>
 
@@ -50,6 +52,8 @@ struct ConnectionQuality
     float spikePing_{};
     float dropRate_{};
     float shuffleRate_{};
+    /// Bytes per second, zero means unlimited. Unreliable messages over the limit are dropped.
+    unsigned bandwidth_{};
 };
 
 /// Test implementation of AbstractConnection with manual control over message transmission.
@@ -62,6 +66,8 @@ public:
 
     void SetSinkConnection(AbstractConnection* sinkConnection) { sinkConnection_ = sinkConnection; }
     void SetQuality(const ConnectionQuality& quality) { quality_ = quality; }
+    /// Use NetworkConditionSimulator instead of ConnectionQuality.
+    void SetConditions(const NetworkConditions& conditions);
 
     void SendMessageInternal(NetworkMessageId messageId, const unsigned char* data, unsigned numBytes, PacketTypeFlags packetType = PacketType::ReliableOrdered) override;
     ea::string ToString() const override { return "Manual Connection"; }
@@ -70,9 +76,15 @@ public:
     unsigned LocalToRemoteTime(unsigned time) const override { return time; }
     unsigned GetLocalTime() const override { return systemTime; }
     unsigned GetLocalTimeOfLatestRoundtrip() const override { return systemTime; }
-    unsigned GetPing() const override { return RoundToInt(1000 * (quality_.minPing_ + quality_.maxPing_) / 2); }
+    unsigned GetPing() const override;
+    void Disconnect() override { isDisconnected_ = true; }
 
     void IncrementTime(unsigned delta);
+    unsigned GetNumMessagesDroppedByBandwidth() const { return bandwidthDroppedMessages_; }
+    unsigned GetNumBytesSent(NetworkMessageId messageId) const;
+    unsigned GetTotalBytesSent() const;
+    const NetworkConditionSimulator* GetConditionSimulator() const { return simulator_.get(); }
+    bool IsDisconnected() const { return isDisconnected_; }
 
 private:
     struct InternalMessage
@@ -92,8 +104,11 @@ private:
     RandomEngine random_;
 
     ConnectionQuality quality_;
+    ea::unique_ptr<NetworkConditionSimulator> simulator_;
+    ByteVector simulatorBuffer_;
 
     unsigned currentTime_{};
+    bool isDisconnected_{};
     ea::vector<InternalMessage> messages_[2][2];
 
     unsigned totalMessages_{};
@@ -101,6 +116,9 @@ private:
     unsigned totalUnreliableMessages_{};
     unsigned droppedMessages_{};
     unsigned shuffledMessages_{};
+    unsigned bandwidthDroppedMessages_{};
+    double bandwidthBytesAvailable_{};
+    ea::unordered_map<NetworkMessageId, unsigned> bytesSent_;
 };
 
 /// Network simulator for tests.
@@ -118,6 +136,8 @@ public:
     ~NetworkSimulator();
 
     void AddClient(Scene* clientScene, const ConnectionQuality& quality);
+    /// Add client with simulated network conditions in both directions. Each direction gets unique seed.
+    void AddClient(Scene* clientScene, const NetworkConditions& conditions);
     void RemoveClient(Scene* clientScene);
 
     static void SimulateEngineFrame(Context* context, float timeStep);
@@ -127,6 +147,7 @@ public:
     void SimulateTime(float time, unsigned millisecondsInQuant = MillisecondsInQuant);
 
     AbstractConnection* GetServerToClientConnection(Scene* clientScene);
+    ManualConnection* GetClientToServerConnection(Scene* clientScene);
 
     RandomEngine& GetRandom() { return random_; }
 
@@ -155,6 +176,7 @@ private:
     ReplicationManager* serverReplicationManager_{};
 
     ea::vector<PerClient> clients_;
+    unsigned nextConditionsSeed_{};
 };
 
 /// Spawn networked object on server.
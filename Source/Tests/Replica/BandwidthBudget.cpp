@@ -0,0 +1,172 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../NetworkUtils.h"
+#include "../SceneUtils.h"
+
+#include <Urho3D/Network/Network.h>
+#include <Urho3D/Replica/BehaviorNetworkObject.h>
+#include <Urho3D/Replica/NetworkPriorityAccumulator.h>
+#include <Urho3D/Replica/ReplicatedTransform.h>
+#include <Urho3D/Scene/PrefabResource.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+SharedPtr<PrefabResource> CreateBandwidthTestPrefab(Context* context)
+{
+    auto node = MakeShared<Node>(context);
+    node->CreateComponent<ReplicatedTransform>();
+
+    return Tests::ConvertNodeToPrefab(node);
+}
+
+}
+
+TEST_CASE("NetworkPriorityAccumulator is fair and bounds staleness")
+{
+    static constexpr unsigned numObjects = 10;
+    static constexpr unsigned objectSize = 100;
+    static constexpr unsigned objectsPerFrame = 3;
+    static constexpr unsigned numFrames = 100;
+
+    NetworkPriorityAccumulator accumulator;
+    ea::vector<unsigned> selectedObjects;
+    ea::vector<unsigned> numUpdates(numObjects);
+    ea::vector<unsigned> lastUpdateFrames(numObjects);
+    unsigned maxStaleness = 0;
+
+    // Object 0 has double priority
+    for (unsigned frame = 1; frame <= numFrames; ++frame)
+    {
+        for (unsigned index = 0; index < numObjects; ++index)
+            accumulator.AddObject(index, index == 0 ? 2.0f : 1.0f, objectSize);
+
+        accumulator.SelectObjects(objectSize * objectsPerFrame, selectedObjects);
+        REQUIRE(selectedObjects.size() == objectsPerFrame);
+
+        for (unsigned index : selectedObjects)
+        {
+            maxStaleness = ea::max(maxStaleness, frame - lastUpdateFrames[index]);
+            lastUpdateFrames[index] = frame;
+            ++numUpdates[index];
+        }
+    }
+
+    for (unsigned index = 0; index < numObjects; ++index)
+        maxStaleness = ea::max(maxStaleness, numFrames - lastUpdateFrames[index]);
+
+    // No object waits much longer than in round robin
+    CHECK(maxStaleness <= numObjects / objectsPerFrame + 2);
+
+    // Objects with equal priority are updated at comparable rate, higher priority is updated more often
+    const auto [minIter, maxIter] = ea::minmax_element(numUpdates.begin() + 1, numUpdates.end());
+    CHECK(*maxIter * 2 <= *minIter * 3);
+    CHECK(numUpdates[0] > *maxIter);
+}
+
+TEST_CASE("NetworkPriorityAccumulator respects budget and eligibility")
+{
+    NetworkPriorityAccumulator accumulator;
+    ea::vector<unsigned> selectedObjects;
+
+    // Large object doesn't fit, smaller one does
+    accumulator.AddObject(0, 3.0f, 60);
+    accumulator.AddObject(1, 2.0f, 60);
+    accumulator.AddObject(2, 1.0f, 30);
+    accumulator.SelectObjects(100, selectedObjects);
+    CHECK(selectedObjects == ea::vector<unsigned>{0, 2});
+    CHECK(accumulator.GetPriority(0) == 0.0f);
+    CHECK(accumulator.GetPriority(1) == 2.0f);
+
+    // Ineligible objects accumulate priority but are not selected
+    accumulator.AddObject(1, 2.0f, 60, false);
+    accumulator.AddObject(2, 1.0f, 30);
+    accumulator.SelectObjects(100, selectedObjects);
+    CHECK(selectedObjects == ea::vector<unsigned>{2});
+    CHECK(accumulator.GetPriority(1) == 4.0f);
+
+    // At least one object is sent even if budget is exceeded
+    accumulator.AddObject(1, 2.0f, 200);
+    accumulator.SelectObjects(100, selectedObjects);
+    CHECK(selectedObjects == ea::vector<unsigned>{1});
+
+    // Removed object forgets accumulated priority, so reused index starts from scratch
+    accumulator.AddObject(0, 5.0f, 60, false);
+    CHECK(accumulator.GetPriority(0) == 5.0f);
+    accumulator.RemoveObject(0);
+    CHECK(accumulator.GetPriority(0) == 0.0f);
+    accumulator.AddObject(0, 1.0f, 60);
+    accumulator.AddObject(1, 2.0f, 60);
+    accumulator.SelectObjects(60, selectedObjects);
+    CHECK(selectedObjects == ea::vector<unsigned>{1});
+    CHECK(accumulator.GetPriority(0) == 1.0f);
+}
+
+TEST_CASE("Unreliable updates are scheduled within connection bandwidth")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(
+        context, "@/BandwidthBudget/Test.prefab", CreateBandwidthTestPrefab);
+
+    static constexpr unsigned numObjects = 64;
+    static constexpr unsigned bandwidth = 20000;
+    static constexpr float velocity = 1.0f;
+
+    const auto runSimulation = [&](unsigned bandwidthLimit)
+    {
+        auto serverScene = MakeShared<Scene>(context);
+        auto clientScene = MakeShared<Scene>(context);
+
+        auto quality = Tests::ConnectionQuality{0.08f, 0.12f, 0.20f, 0.0f, 0.0f};
+        quality.bandwidth_ = bandwidth;
+
+        Tests::NetworkSimulator sim(serverScene);
+        sim.AddClient(clientScene, quality);
+        auto connection = static_cast<Tests::ManualConnection*>(sim.GetServerToClientConnection(clientScene));
+        connection->SetBandwidthLimit(bandwidthLimit);
+        sim.SimulateTime(5.0f);
+
+        for (unsigned i = 0; i < numObjects; ++i)
+            Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, Format("Object {}", i), Vector3{0.0f, 0.0f, i * 2.0f});
+        sim.SimulateTime(3.0f);
+
+        const unsigned droppedBefore = connection->GetNumMessagesDroppedByBandwidth();
+        const float timeStep = 1.0f / Tests::NetworkSimulator::FramesInSecond;
+        for (unsigned step = 0; step < 4 * Tests::NetworkSimulator::FramesInSecond; ++step)
+        {
+            for (Node* node : serverScene->GetChildren())
+                node->Translate(Vector3::RIGHT * velocity * timeStep);
+            sim.SimulateTime(timeStep);
+        }
+
+        // Every object should be close to the server state, i.e. no object is starved
+        float maxError = 0.0f;
+        for (unsigned i = 0; i < numObjects; ++i)
+        {
+            const ea::string name = Format("Object {}", i);
+            Node* serverNode = serverScene->GetChild(name, true);
+            Node* clientNode = clientScene->GetChild(name, true);
+            REQUIRE(serverNode);
+            REQUIRE(clientNode);
+            maxError = ea::max(maxError, (serverNode->GetWorldPosition() - clientNode->GetWorldPosition()).Length());
+        }
+
+        const unsigned numDropped = connection->GetNumMessagesDroppedByBandwidth() - droppedBefore;
+        return ea::make_pair(numDropped, maxError);
+    };
+
+    // Without budgeting, the connection is congested
+    const auto [droppedWithoutLimit, errorWithoutLimit] = runSimulation(0);
+    CHECK(droppedWithoutLimit > 0);
+
+    // With budgeting, nothing is dropped and all objects are updated
+    const auto [droppedWithLimit, errorWithLimit] = runSimulation(bandwidth * 7 / 10);
+    CHECK(droppedWithLimit == 0);
+    CHECK(errorWithLimit < velocity);
+}
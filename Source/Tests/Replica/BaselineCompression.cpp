@@ -0,0 +1,54 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Replica/BaselineCompression.h>
+
+TEST_CASE("Baseline delta encodes only changed bytes")
+{
+    const ByteVector baseline{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    ByteVector value = baseline;
+    value[1] = 20;
+    value[9] = 100;
+
+    ByteVector delta;
+    EncodeBaselineDelta(baseline, value, delta);
+    CHECK(delta.size() == 2 + 2);
+
+    ByteVector decodedValue;
+    REQUIRE(DecodeBaselineDelta(baseline, delta, decodedValue));
+    CHECK(decodedValue == value);
+
+    // Unchanged value costs only the mask
+    EncodeBaselineDelta(baseline, baseline, delta);
+    CHECK(delta.size() == 2);
+
+    // Malformed deltas are rejected
+    CHECK_FALSE(DecodeBaselineDelta(baseline, ByteVector{0xff}, decodedValue));
+    CHECK_FALSE(DecodeBaselineDelta(baseline, ByteVector{0x01, 0x00}, decodedValue));
+    CHECK_FALSE(DecodeBaselineDelta(baseline, ByteVector{0x00, 0x00, 0x01}, decodedValue));
+}
+
+TEST_CASE("Sequence acknowledgements track recent messages")
+{
+    NetworkSequenceAcks acks;
+    CHECK(acks.IsEmpty());
+
+    acks.Add(65534);
+    acks.Add(1);
+    CHECK(acks.GetLatest() == 1);
+    CHECK(acks.GetMask() == 0b100);
+
+    // Late message is acknowledged in the mask
+    acks.Add(0);
+    CHECK(acks.GetLatest() == 1);
+    CHECK(acks.GetMask() == 0b101);
+
+    // Old messages are forgotten
+    acks.Add(1 + NetworkSequenceAcks::MaskSize);
+    CHECK(acks.GetMask() == 1u << (NetworkSequenceAcks::MaskSize - 1));
+    acks.Add(2 + 2 * NetworkSequenceAcks::MaskSize);
+    CHECK(acks.GetMask() == 0);
+}
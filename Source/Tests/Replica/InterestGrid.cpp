@@ -0,0 +1,226 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../NetworkUtils.h"
+#include "../SceneUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Network/Network.h>
+#include <Urho3D/Network/NetworkEvents.h>
+#include <Urho3D/Replica/BehaviorNetworkObject.h>
+#include <Urho3D/Replica/FilteredByDistance.h>
+#include <Urho3D/Replica/NetworkInterestGrid.h>
+#include <Urho3D/Replica/ReplicatedTransform.h>
+#include <Urho3D/Replica/ReplicationManager.h>
+#include <Urho3D/Scene/PrefabResource.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+SharedPtr<PrefabResource> CreateInterestTestPrefab(Context* context)
+{
+    auto node = MakeShared<Node>(context);
+    node->CreateComponent<ReplicatedTransform>();
+
+    return Tests::ConvertNodeToPrefab(node);
+}
+
+SharedPtr<PrefabResource> CreateInterestBenchmarkPrefab(Context* context)
+{
+    auto node = MakeShared<Node>(context);
+    node->CreateComponent<ReplicatedTransform>();
+
+    auto filter = node->CreateComponent<FilteredByDistance>();
+    filter->SetRelevant(false);
+    filter->SetDistance(50.0f);
+
+    return Tests::ConvertNodeToPrefab(node);
+}
+
+}
+
+TEST_CASE("NetworkInterestArea tracks objects entering and leaving the area")
+{
+    NetworkInterestGrid grid(10.0f);
+    NetworkInterestArea area;
+
+    grid.UpdateObject(0, Vector3{5.0f, 0.0f, 5.0f});
+    grid.UpdateObject(1, Vector3{55.0f, 0.0f, 5.0f});
+    grid.UpdateObject(2, Vector3{-5.0f, 100.0f, -5.0f});
+
+    const Vector3 center{0.0f, 0.0f, 0.0f};
+    area.Update(grid, {&center, 1}, 10.0f);
+    CHECK(area.IsInterested(0));
+    CHECK_FALSE(area.IsInterested(1));
+    CHECK(area.IsInterested(2));
+    CHECK(area.GetObjects().size() == 2);
+
+    // Only objects that changed cell are re-evaluated
+    grid.ResetChangedObjects();
+    grid.UpdateObject(0, Vector3{6.0f, 0.0f, 6.0f});
+    grid.UpdateObject(1, Vector3{15.0f, 0.0f, 5.0f});
+    grid.UpdateObject(2, Vector3{-50.0f, 0.0f, -5.0f});
+    CHECK(grid.GetChangedObjects() == ea::vector<unsigned>{1, 2});
+
+    area.Update(grid, {&center, 1}, 10.0f);
+    CHECK(area.IsInterested(0));
+    CHECK(area.IsInterested(1));
+    CHECK_FALSE(area.IsInterested(2));
+    CHECK(area.GetLeftObjects() == ea::vector<unsigned>{2});
+    CHECK(area.GetObjects().size() == 2);
+
+    // Moving the area re-evaluates objects in changed cells
+    grid.ResetChangedObjects();
+    const Vector3 newCenter{-50.0f, 0.0f, 0.0f};
+    area.Update(grid, {&newCenter, 1}, 10.0f);
+    CHECK_FALSE(area.IsInterested(0));
+    CHECK_FALSE(area.IsInterested(1));
+    CHECK(area.IsInterested(2));
+    CHECK(area.GetObjects() == ea::vector<unsigned>{2});
+
+    grid.RemoveObject(2);
+    area.RemoveObject(2);
+    area.Update(grid, {&newCenter, 1}, 10.0f);
+    CHECK(area.GetObjects().empty());
+    CHECK(grid.GetObjectsInCell(IntVector2{-5, -1}).empty());
+}
+
+TEST_CASE("Interest grid limits replicated objects to area of interest")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/InterestGrid/Test.prefab", CreateInterestTestPrefab);
+
+    // Create scenes
+    auto serverScene = MakeShared<Scene>(context);
+    auto clientScene = MakeShared<Scene>(context);
+
+    auto replicationManager = serverScene->CreateComponent<ReplicationManager>();
+    replicationManager->SetInterestCellSize(10.0f);
+    replicationManager->SetInterestRadius(20.0f);
+
+    const auto quality = Tests::ConnectionQuality{0.08f, 0.12f, 0.20f, 0.02f, 0.02f};
+    Tests::NetworkSimulator sim(serverScene);
+    sim.AddClient(clientScene, quality);
+    sim.SimulateTime(5.0f);
+
+    // Spawn objects
+    {
+        auto clientNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, "Client Node");
+        clientNode->GetComponent<BehaviorNetworkObject>()->SetOwner(sim.GetServerToClientConnection(clientScene));
+
+        Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, "Near Node", Vector3{10.0f, 0.0f, 0.0f});
+        Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, "Far Node", Vector3{100.0f, 0.0f, 0.0f});
+
+        auto globalNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, "Global Node", Vector3{200.0f, 0.0f, 0.0f});
+        globalNode->GetComponent<BehaviorNetworkObject>()->SetGlobal(true);
+    }
+
+    sim.SimulateTime(8.0f);
+
+    CHECK(clientScene->GetChild("Client Node", true));
+    CHECK(clientScene->GetChild("Near Node", true));
+    CHECK_FALSE(clientScene->GetChild("Far Node", true));
+    CHECK(clientScene->GetChild("Global Node", true));
+
+    // Move objects in and out of the area
+    serverScene->GetChild("Near Node", true)->SetWorldPosition(Vector3{-100.0f, 0.0f, 0.0f});
+    serverScene->GetChild("Far Node", true)->SetWorldPosition(Vector3{0.0f, 0.0f, 15.0f});
+    sim.SimulateTime(8.0f);
+
+    CHECK_FALSE(clientScene->GetChild("Near Node", true));
+    CHECK(clientScene->GetChild("Far Node", true));
+    CHECK(clientScene->GetChild("Global Node", true));
+
+    // Move owned object to another object
+    serverScene->GetChild("Client Node", true)->SetWorldPosition(Vector3{-95.0f, 0.0f, 0.0f});
+    sim.SimulateTime(8.0f);
+
+    CHECK(clientScene->GetChild("Client Node", true));
+    CHECK(clientScene->GetChild("Near Node", true));
+    CHECK_FALSE(clientScene->GetChild("Far Node", true));
+    CHECK(clientScene->GetChild("Global Node", true));
+}
+
+TEST_CASE("Interest grid replication benchmark", "[.benchmark]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    static constexpr unsigned numClients = 256;
+    static constexpr unsigned numObjects = 4096;
+    static constexpr float worldSize = 1000.0f;
+    static constexpr float simulationTime = 4.0f;
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(
+        context, "@/InterestGrid/Benchmark.prefab", CreateInterestBenchmarkPrefab);
+
+    const auto runBenchmark = [&](float interestCellSize)
+    {
+        auto serverScene = MakeShared<Scene>(context);
+        auto replicationManager = serverScene->CreateComponent<ReplicationManager>();
+        replicationManager->SetInterestCellSize(interestCellSize);
+        replicationManager->SetInterestRadius(50.0f);
+
+        Tests::NetworkSimulator sim(serverScene);
+        RandomEngine& random = sim.GetRandom();
+
+        ea::vector<SharedPtr<Scene>> clientScenes;
+        for (unsigned i = 0; i < numClients; ++i)
+        {
+            auto clientScene = MakeShared<Scene>(context);
+            sim.AddClient(clientScene, Tests::ConnectionQuality{});
+            clientScenes.push_back(clientScene);
+        }
+        sim.SimulateTime(2.0f);
+
+        for (unsigned i = 0; i < numObjects; ++i)
+        {
+            const Vector3 position{random.GetFloat(0.0f, worldSize), 0.0f, random.GetFloat(0.0f, worldSize)};
+            auto node = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, "Object", position);
+            if (i < numClients)
+            {
+                auto connection = sim.GetServerToClientConnection(clientScenes[i]);
+                node->GetComponent<BehaviorNetworkObject>()->SetOwner(connection);
+            }
+        }
+        sim.SimulateTime(1.0f);
+
+        // Measure only server-side processing of network frame
+        HiresTimer timer;
+        long long serverTimeUs = 0;
+        unsigned numFrames = 0;
+        auto network = context->GetSubsystem<Network>();
+        serverScene->SubscribeToEvent(network, E_ENDSERVERNETWORKFRAME, [&](VariantMap& eventData) { timer.Reset(); });
+        serverScene->SubscribeToEvent(network, E_NETWORKUPDATESENT,
+            [&](VariantMap& eventData)
+        {
+            if (eventData[NetworkUpdateSent::P_ISSERVER].GetBool())
+            {
+                serverTimeUs += timer.GetUSec(false);
+                ++numFrames;
+            }
+        });
+
+        // Move objects so grid has some work to do
+        for (unsigned step = 0; step < simulationTime * Tests::NetworkSimulator::FramesInSecond; ++step)
+        {
+            for (Node* node : serverScene->GetChildren())
+                node->Translate(Vector3{random.GetFloat(-1.0f, 1.0f), 0.0f, random.GetFloat(-1.0f, 1.0f)});
+            sim.SimulateTime(1.0f / Tests::NetworkSimulator::FramesInSecond);
+        }
+        serverScene->UnsubscribeFromAllEvents();
+
+        return static_cast<double>(serverTimeUs) / ea::max(numFrames, 1u);
+    };
+
+    const double timeWithoutGrid = runBenchmark(0.0f);
+    const double timeWithGrid = runBenchmark(25.0f);
+    URHO3D_LOGINFO("Server tick with {} clients and {} objects: {:.0f} us without interest grid, {:.0f} us with interest grid",
+        numClients, numObjects, timeWithoutGrid, timeWithGrid);
+}
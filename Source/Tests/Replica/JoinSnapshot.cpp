@@ -0,0 +1,305 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../NetworkUtils.h"
+#include "../SceneUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Network/Network.h>
+#include <Urho3D/Network/NetworkEvents.h>
+#include <Urho3D/Network/Protocol.h>
+#include <Urho3D/Replica/BehaviorNetworkObject.h>
+#include <Urho3D/Replica/ClientReplica.h>
+#include <Urho3D/Replica/JoinSnapshot.h>
+#include <Urho3D/Replica/ReplicatedTransform.h>
+#include <Urho3D/Replica/ReplicationManager.h>
+#include <Urho3D/Replica/ServerReplicator.h>
+#include <Urho3D/Replica/StaticNetworkObject.h>
+#include <Urho3D/Scene/PrefabResource.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+SharedPtr<PrefabResource> CreateTestPrefab(Context* context)
+{
+    auto node = MakeShared<Node>(context);
+    return Tests::ConvertNodeToPrefab(node);
+}
+
+SharedPtr<PrefabResource> CreateDynamicTestPrefab(Context* context)
+{
+    auto node = MakeShared<Node>(context);
+    node->CreateComponent<ReplicatedTransform>();
+    return Tests::ConvertNodeToPrefab(node);
+}
+
+Vector3 GetStaticObjectPosition(unsigned index)
+{
+    return Vector3{(index % 16) * 2.0f, 0.0f, (index / 16) * 2.0f};
+}
+
+/// Check that client has exactly the same named objects as the server.
+void CheckSameObjects(Scene* serverScene, Scene* clientScene, const ea::vector<ea::string>& names)
+{
+    for (const ea::string& name : names)
+    {
+        Node* serverNode = serverScene->GetChild(name, true);
+        Node* clientNode = clientScene->GetChild(name, true);
+        if (serverNode)
+        {
+            REQUIRE(clientNode);
+            CHECK(clientNode->GetWorldPosition().Equals(serverNode->GetWorldPosition()));
+            CHECK(clientNode->GetParent()->GetName() == serverNode->GetParent()->GetName());
+        }
+        else
+        {
+            CHECK_FALSE(clientNode);
+        }
+    }
+}
+
+}
+
+TEST_CASE("Join snapshot replicates static objects to joining clients")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/JoinSnapshot/Test.prefab", CreateTestPrefab);
+    auto dynamicPrefab = Tests::GetOrCreateResource<PrefabResource>(
+        context, "@/JoinSnapshot/DynamicTest.prefab", CreateDynamicTestPrefab);
+
+    static constexpr unsigned numStaticObjects = 200;
+    const auto quality = Tests::ConnectionQuality{0.08f, 0.12f, 0.20f, 0.02f, 0.02f};
+
+    // Setup scene
+    auto serverScene = MakeShared<Scene>(context);
+    auto replicationManager = serverScene->CreateComponent<ReplicationManager>();
+    replicationManager->SetJoinSnapshot(true);
+
+    ea::vector<ea::string> names;
+    for (unsigned i = 0; i < numStaticObjects; ++i)
+    {
+        // Every 4th object is a child of the previous one
+        Node* parent = i % 4 == 3 ? serverScene->GetChild(names.back(), true) : serverScene.Get();
+        names.push_back(Format("Static Node {}", i));
+        Tests::SpawnOnServer<StaticNetworkObject>(parent, prefab, names.back(), GetStaticObjectPosition(i));
+    }
+    names.push_back("Dynamic Node");
+    Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, dynamicPrefab, names.back(), {0.0f, 1.0f, 0.0f});
+
+    Tests::NetworkSimulator sim(serverScene);
+    sim.SimulateTime(1.0f);
+
+    // Join first client and wait until snapshot is built for it
+    auto clientScene1 = MakeShared<Scene>(context);
+    sim.AddClient(clientScene1, quality);
+
+    ServerReplicator* serverReplicator = replicationManager->GetServerReplicator();
+    for (unsigned i = 0; i < 10 * Tests::NetworkSimulator::FramesInSecond && !serverReplicator->GetJoinSnapshot(); ++i)
+        sim.SimulateTime(1.0f / Tests::NetworkSimulator::FramesInSecond);
+
+    const NetworkJoinSnapshot* joinSnapshot = serverReplicator->GetJoinSnapshot();
+    REQUIRE(joinSnapshot);
+    CHECK(joinSnapshot->GetNetworkIds().size() == numStaticObjects);
+    CHECK(joinSnapshot->IsCompressed());
+    CHECK(joinSnapshot->GetSize() < joinSnapshot->GetUncompressedSize());
+    const NetworkFrame joinSnapshotFrame = joinSnapshot->GetFrame();
+
+    // Change objects while snapshot is still fresh
+    for (unsigned i = 0; i < numStaticObjects; i += 10)
+    {
+        Node* node = serverScene->GetChild(names[i], true);
+        if (node)
+            node->Remove();
+    }
+    for (unsigned i = numStaticObjects; i < numStaticObjects + 10; ++i)
+    {
+        names.push_back(Format("Static Node {}", i));
+        Tests::SpawnOnServer<StaticNetworkObject>(serverScene, prefab, names.back(), GetStaticObjectPosition(i));
+    }
+
+    // Join second client, it should receive the same snapshot and then catch up
+    auto clientScene2 = MakeShared<Scene>(context);
+    sim.AddClient(clientScene2, quality);
+    sim.SimulateTime(5.0f);
+
+    ClientReplica* clientReplica1 = clientScene1->GetComponent<ReplicationManager>()->GetClientReplica();
+    REQUIRE(clientReplica1);
+    CHECK(clientReplica1->IsJoinSnapshotLoaded());
+
+    ClientReplica* clientReplica2 = clientScene2->GetComponent<ReplicationManager>()->GetClientReplica();
+    REQUIRE(clientReplica2);
+    CHECK(clientReplica2->IsJoinSnapshotLoaded());
+    CHECK(clientReplica2->GetJoinSnapshotReceiver().GetFrame() == joinSnapshotFrame);
+    CHECK(clientReplica1->GetJoinSnapshotReceiver().GetFrame() == joinSnapshotFrame);
+    CheckSameObjects(serverScene, clientScene1, names);
+    CheckSameObjects(serverScene, clientScene2, names);
+}
+
+TEST_CASE("Join snapshot respects area of interest")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/JoinSnapshot/Test.prefab", CreateTestPrefab);
+    auto dynamicPrefab = Tests::GetOrCreateResource<PrefabResource>(
+        context, "@/JoinSnapshot/DynamicTest.prefab", CreateDynamicTestPrefab);
+
+    const auto quality = Tests::ConnectionQuality{0.08f, 0.12f, 0.20f, 0.02f, 0.02f};
+
+    // Setup scene
+    auto serverScene = MakeShared<Scene>(context);
+    auto replicationManager = serverScene->CreateComponent<ReplicationManager>();
+    replicationManager->SetJoinSnapshot(true);
+    replicationManager->SetInterestCellSize(10.0f);
+    replicationManager->SetInterestRadius(20.0f);
+
+    Tests::SpawnOnServer<StaticNetworkObject>(serverScene, prefab, "Near Node", Vector3{10.0f, 0.0f, 0.0f});
+    Tests::SpawnOnServer<StaticNetworkObject>(serverScene, prefab, "Far Node", Vector3{100.0f, 0.0f, 0.0f});
+
+    Tests::NetworkSimulator sim(serverScene);
+    sim.SimulateTime(1.0f);
+
+    // Join client, objects outside of the area should be removed after the snapshot is loaded
+    auto clientScene = MakeShared<Scene>(context);
+    sim.AddClient(clientScene, quality);
+
+    Node* clientNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, dynamicPrefab, "Client Node");
+    clientNode->GetComponent<BehaviorNetworkObject>()->SetOwner(sim.GetServerToClientConnection(clientScene));
+    sim.SimulateTime(8.0f);
+
+    ClientReplica* clientReplica = clientScene->GetComponent<ReplicationManager>()->GetClientReplica();
+    REQUIRE(clientReplica);
+    CHECK(clientReplica->IsJoinSnapshotLoaded());
+    CHECK(clientReplica->GetJoinSnapshotReceiver().GetNumObjects() == 2);
+
+    CHECK(clientScene->GetChild("Client Node", true));
+    CHECK(clientScene->GetChild("Near Node", true));
+    CHECK_FALSE(clientScene->GetChild("Far Node", true));
+
+    // Move owned object, snapshot objects should follow the area of interest
+    clientNode->SetWorldPosition(Vector3{95.0f, 0.0f, 0.0f});
+    sim.SimulateTime(8.0f);
+
+    CHECK(clientScene->GetChild("Client Node", true));
+    CHECK_FALSE(clientScene->GetChild("Near Node", true));
+    CHECK(clientScene->GetChild("Far Node", true));
+}
+
+TEST_CASE("Join snapshot disconnects client on malformed data")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/JoinSnapshot/Test.prefab", CreateTestPrefab);
+
+    auto serverScene = MakeShared<Scene>(context);
+    auto replicationManager = serverScene->CreateComponent<ReplicationManager>();
+    replicationManager->SetJoinSnapshot(true);
+    Tests::SpawnOnServer<StaticNetworkObject>(serverScene, prefab, "Static Node");
+
+    Tests::NetworkSimulator sim(serverScene);
+    sim.SimulateTime(1.0f);
+
+    auto clientScene = MakeShared<Scene>(context);
+    sim.AddClient(clientScene, Tests::ConnectionQuality{});
+    sim.SimulateTime(2.0f);
+
+    ClientReplica* clientReplica = clientScene->GetComponent<ReplicationManager>()->GetClientReplica();
+    REQUIRE(clientReplica);
+    REQUIRE(clientReplica->IsJoinSnapshotLoaded());
+    CHECK_FALSE(sim.GetClientToServerConnection(clientScene)->IsDisconnected());
+
+    // Send chunk that doesn't belong to the received snapshot
+    VectorBuffer msg;
+    msg.WriteInt64(0);
+    msg.WriteVLE(16);
+    msg.WriteVLE(0);
+    msg.WriteVLE(8);
+    msg.WriteUInt(0);
+    MemoryBuffer messageData{msg.GetBuffer()};
+    clientReplica->ProcessMessage(MSG_JOIN_SNAPSHOT, messageData);
+
+    CHECK(clientReplica->GetJoinSnapshotReceiver().IsMalformed());
+    CHECK(sim.GetClientToServerConnection(clientScene)->IsDisconnected());
+}
+
+TEST_CASE("Join snapshot receiver rejects oversized snapshot")
+{
+    const auto processChunk = [](unsigned totalSize, unsigned uncompressedSize)
+    {
+        VectorBuffer msg;
+        msg.WriteInt64(0);
+        msg.WriteVLE(totalSize);
+        msg.WriteVLE(uncompressedSize);
+        msg.WriteVLE(0);
+        msg.WriteUInt(0);
+        MemoryBuffer messageData{msg.GetBuffer()};
+
+        NetworkJoinSnapshotReceiver receiver;
+        const bool isAccepted = receiver.ProcessChunk(messageData);
+        CHECK(isAccepted == !receiver.IsMalformed());
+        return isAccepted;
+    };
+
+    CHECK(processChunk(16, 0));
+    CHECK(processChunk(16, NetworkJoinSnapshotReceiver::MaxSnapshotSize));
+    CHECK_FALSE(processChunk(NetworkJoinSnapshotReceiver::MaxSnapshotSize + 1, 0));
+    CHECK_FALSE(processChunk(16, NetworkJoinSnapshotReceiver::MaxSnapshotSize + 1));
+    CHECK_FALSE(processChunk(M_MAX_UNSIGNED, M_MAX_UNSIGNED));
+}
+
+TEST_CASE("Join snapshot reduces join time for scenes with many static objects", "[.benchmark]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/JoinSnapshot/Test.prefab", CreateTestPrefab);
+
+    static constexpr unsigned numStaticObjects = 50000;
+    const auto quality = Tests::ConnectionQuality{0.08f, 0.12f, 0.20f, 0.02f, 0.02f};
+
+    for (bool joinSnapshot : {false, true})
+    {
+        auto serverScene = MakeShared<Scene>(context);
+        auto replicationManager = serverScene->CreateComponent<ReplicationManager>();
+        replicationManager->SetJoinSnapshot(joinSnapshot);
+
+        for (unsigned i = 0; i < numStaticObjects; ++i)
+            Tests::SpawnOnServer<StaticNetworkObject>(serverScene, prefab, "Static Node", GetStaticObjectPosition(i));
+
+        Tests::NetworkSimulator sim(serverScene);
+        sim.SimulateTime(1.0f);
+
+        HiresTimer timer;
+        long long serverTime = 0;
+        auto network = context->GetSubsystem<Network>();
+        serverScene->SubscribeToEvent(network, E_ENDSERVERNETWORKFRAME, [&](VariantMap& eventData) { timer.Reset(); });
+        serverScene->SubscribeToEvent(network, E_NETWORKUPDATESENT,
+            [&](VariantMap& eventData)
+        {
+            if (eventData[NetworkUpdateSent::P_ISSERVER].GetBool())
+                serverTime += timer.GetUSec(false);
+        });
+
+        auto clientScene = MakeShared<Scene>(context);
+        sim.AddClient(clientScene, quality);
+
+        unsigned numFrames = 0;
+        while (clientScene->GetNumChildren() < numStaticObjects && numFrames < 300 * Tests::NetworkSimulator::FramesInSecond)
+        {
+            sim.SimulateTime(1.0f / Tests::NetworkSimulator::FramesInSecond);
+            ++numFrames;
+        }
+
+        CHECK(clientScene->GetNumChildren() == numStaticObjects);
+        URHO3D_LOGINFO("Join snapshot {}: client joined in {:.2f}s, server spent {:.2f}ms",
+            joinSnapshot ? "enabled" : "disabled", static_cast<float>(numFrames) / Tests::NetworkSimulator::FramesInSecond,
+            serverTime / 1000.0f);
+    }
+}
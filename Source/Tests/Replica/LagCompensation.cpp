@@ -0,0 +1,193 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../NetworkUtils.h"
+
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Network/Network.h>
+#include <Urho3D/Replica/BehaviorNetworkObject.h>
+#include <Urho3D/Replica/LagCompensation.h>
+#include <Urho3D/Replica/ReplicationManager.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SceneEvents.h>
+
+namespace
+{
+
+LagCompensationHitbox MakeHitbox(unsigned networkId, const Vector3& position)
+{
+    LagCompensationHitbox hitbox;
+    hitbox.networkId_ = static_cast<NetworkId>(networkId);
+    hitbox.position_ = position;
+    hitbox.localBox_ = BoundingBox{-Vector3::ONE * 0.5f, Vector3::ONE * 0.5f};
+    return hitbox;
+}
+
+/// Ray that goes down along Y axis through specified point.
+Ray MakeVerticalRay(float x, float z)
+{
+    return Ray{Vector3{x, 10.0f, z}, Vector3::DOWN};
+}
+
+}
+
+TEST_CASE("LagCompensation evaluates hits against rewound hitboxes")
+{
+    static constexpr unsigned historyLength = 8;
+
+    LagCompensation lagCompensation{historyLength};
+    CHECK_FALSE(lagCompensation.GetLatestFrame());
+    CHECK_FALSE(lagCompensation.RaycastSingle(NetworkTime{NetworkFrame{0}}, MakeVerticalRay(0.0f, 0.0f), M_INFINITY));
+
+    // Object 1 moves along X by 2 units per frame, object 2 is static
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        const LagCompensationHitbox hitboxes[] = {
+            MakeHitbox(1, Vector3{frame * 2.0f, 0.0f, 0.0f}),
+            MakeHitbox(2, Vector3{0.0f, 0.0f, 10.0f}),
+        };
+        lagCompensation.RecordHitboxes(NetworkFrame{frame}, hitboxes);
+        CHECK(lagCompensation.IsFrameReady(NetworkFrame{frame}));
+    }
+
+    REQUIRE(lagCompensation.GetLatestFrame() == NetworkFrame{19});
+    REQUIRE(lagCompensation.GetOldestFrame() == NetworkFrame{19 - historyLength + 1});
+
+    // Hit object in the past
+    {
+        const auto hit = lagCompensation.RaycastSingle(NetworkTime{NetworkFrame{15}}, MakeVerticalRay(30.0f, 0.0f), M_INFINITY);
+        REQUIRE(hit);
+        CHECK(hit->networkId_ == static_cast<NetworkId>(1));
+        CHECK(hit->boneIndex_ == LagCompensationHitbox::NoBone);
+        CHECK(hit->distance_ == Catch::Approx(9.5f));
+        CHECK(hit->position_.Equals(Vector3{30.0f, 0.5f, 0.0f}));
+
+        CHECK_FALSE(lagCompensation.RaycastSingle(NetworkTime{NetworkFrame{17}}, MakeVerticalRay(30.0f, 0.0f), M_INFINITY));
+        CHECK_FALSE(lagCompensation.RaycastSingle(NetworkTime{NetworkFrame{15}}, MakeVerticalRay(30.0f, 0.0f), 5.0f));
+    }
+
+    // Hitboxes are interpolated between frames
+    {
+        const NetworkTime time{NetworkFrame{15}, 0.5f};
+        CHECK(lagCompensation.RaycastSingle(time, MakeVerticalRay(31.0f, 0.0f), M_INFINITY));
+        CHECK_FALSE(lagCompensation.RaycastSingle(time, MakeVerticalRay(29.6f, 0.0f), M_INFINITY));
+        CHECK_FALSE(lagCompensation.RaycastSingle(time, MakeVerticalRay(32.4f, 0.0f), M_INFINITY));
+
+        const auto hitbox = lagCompensation.GetHitbox(time, static_cast<NetworkId>(1));
+        REQUIRE(hitbox);
+        CHECK(hitbox->position_.Equals(Vector3{31.0f, 0.0f, 0.0f}));
+    }
+
+    // Time is clamped to recorded history
+    {
+        const Ray ray = MakeVerticalRay(12.0f, 0.0f);
+        CHECK_FALSE(lagCompensation.RaycastSingle(NetworkTime{NetworkFrame{6}}, ray, M_INFINITY));
+        CHECK(lagCompensation.RaycastSingle(NetworkTime{NetworkFrame{6}}, MakeVerticalRay(24.0f, 0.0f), M_INFINITY));
+        CHECK(lagCompensation.RaycastSingle(NetworkTime{NetworkFrame{100}}, MakeVerticalRay(38.0f, 0.0f), M_INFINITY));
+    }
+
+    // All hits are sorted by distance
+    {
+        ea::vector<LagCompensationHit> hits;
+        const Ray ray{Vector3{64.0f, 0.0f, -10.0f}, Vector3{-32.0f, 0.0f, 10.0f}};
+        lagCompensation.Raycast(NetworkTime{NetworkFrame{16}}, ray, M_INFINITY, hits);
+        REQUIRE(hits.size() == 2);
+        CHECK(hits[0].networkId_ == static_cast<NetworkId>(1));
+        CHECK(hits[1].networkId_ == static_cast<NetworkId>(2));
+        CHECK(hits[0].distance_ < hits[1].distance_);
+    }
+
+    lagCompensation.Clear();
+    CHECK_FALSE(lagCompensation.GetLatestFrame());
+}
+
+TEST_CASE("LagCompensation finds rotated and scaled hitboxes among many objects")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    static constexpr unsigned numObjects = 1000;
+
+    LagCompensation lagCompensation{4, context->GetSubsystem<WorkQueue>()};
+
+    ea::vector<LagCompensationHitbox> hitboxes;
+    for (unsigned i = 0; i < numObjects; ++i)
+    {
+        LagCompensationHitbox hitbox = MakeHitbox(i, Vector3{(i % 32) * 4.0f, 0.0f, (i / 32) * 4.0f});
+        hitbox.rotation_ = Quaternion{45.0f, Vector3::UP};
+        hitbox.scale_ = Vector3{2.0f, 1.0f, 1.0f};
+        hitboxes.push_back(hitbox);
+    }
+    lagCompensation.RecordHitboxes(NetworkFrame{0}, hitboxes);
+
+    // Both linear search and hierarchy should produce the same results
+    for (bool isReady : {false, true})
+    {
+        if (isReady)
+        {
+            context->GetSubsystem<WorkQueue>()->CompleteAll();
+            REQUIRE(lagCompensation.IsFrameReady(NetworkFrame{0}));
+        }
+
+        const NetworkTime time{NetworkFrame{0}};
+
+        // Point inside of unrotated box is outside of rotated one
+        CHECK_FALSE(lagCompensation.RaycastSingle(time, MakeVerticalRay(40.0f - 0.9f, 40.0f), M_INFINITY));
+
+        const auto hit = lagCompensation.RaycastSingle(time, MakeVerticalRay(40.0f + 0.3f, 40.0f + 0.3f), M_INFINITY);
+        REQUIRE(hit);
+        CHECK(hit->networkId_ == static_cast<NetworkId>(10 * 32 + 10));
+    }
+}
+
+TEST_CASE("LagCompensation records network objects on server")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto model = MakeShared<Model>(context);
+    model->SetBoundingBox(BoundingBox{-Vector3::ONE * 0.5f, Vector3::ONE * 0.5f});
+
+    // Setup scene
+    auto serverScene = MakeShared<Scene>(context);
+    auto replicationManager = serverScene->CreateComponent<ReplicationManager>();
+    replicationManager->SetLagCompensation(true);
+
+    Node* node = serverScene->CreateChild("Node");
+    auto networkObject = node->CreateComponent<BehaviorNetworkObject>();
+    node->CreateComponent<StaticModel>()->SetModel(model);
+
+    // Move object forever
+    serverScene->SubscribeToEvent(serverScene, E_SCENEUPDATE,
+        [&](VariantMap& eventData)
+    {
+        const float timeStep = eventData[SceneUpdate::P_TIMESTEP].GetFloat();
+        node->Translate(timeStep * 4.0f * Vector3::RIGHT, TS_PARENT);
+    });
+
+    Tests::NetworkSimulator sim(serverScene);
+    ServerReplicator* serverReplicator = replicationManager->GetServerReplicator();
+    const LagCompensation* lagCompensation = serverReplicator->GetLagCompensation();
+    REQUIRE(lagCompensation);
+
+    sim.SimulateTime(5.0f);
+    const NetworkTime serverTime = serverReplicator->GetServerTime();
+    const Vector3 position = node->GetWorldPosition();
+
+    // Object is hit at old position in the past only
+    sim.SimulateTime(0.5f);
+    const Vector3 currentPosition = node->GetWorldPosition();
+    REQUIRE(currentPosition.x_ - position.x_ > 1.5f);
+
+    const auto pastHit = lagCompensation->RaycastSingle(serverTime, MakeVerticalRay(position.x_, position.z_), M_INFINITY);
+    REQUIRE(pastHit);
+    CHECK(pastHit->networkId_ == networkObject->GetNetworkId());
+
+    CHECK_FALSE(lagCompensation->RaycastSingle(
+        serverReplicator->GetServerTime(), MakeVerticalRay(position.x_, position.z_), M_INFINITY));
+    CHECK(lagCompensation->RaycastSingle(
+        serverReplicator->GetServerTime(), MakeVerticalRay(currentPosition.x_, currentPosition.z_), M_INFINITY));
+}
@@ -24,7 +24,10 @@
 #include "../NetworkUtils.h"
 #include "../SceneUtils.h"
 
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/Log.h>
 #include <Urho3D/Network/Network.h>
+#include <Urho3D/Network/NetworkEvents.h>
 #include <Urho3D/Physics/CollisionShape.h>
 #include <Urho3D/Physics/KinematicCharacterController.h>
 #include <Urho3D/Physics/PhysicsEvents.h>
@@ -272,3 +275,139 @@ TEST_CASE("PredictedKinematicController works standalone")
     CHECK(standaloneNode->GetWorldPosition().x_ == 0.0f);
     CHECK(standaloneNode->GetWorldPosition().z_ == Catch::Approx(10.0f).margin(0.1f));
 }
+
+TEST_CASE("Client-side prediction converges under simulated network conditions")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/PredictedKinematicController/Test.prefab", CreateTestPrefab);
+
+    // Setup scenes, 150 ms round trip with 2% loss
+    NetworkConditions conditions;
+    conditions.latencyMs_ = 70.0f;
+    conditions.jitterMs_ = 5.0f;
+    conditions.lossRate_ = 0.02f;
+    conditions.lossBurstLength_ = 2.0f;
+    conditions.seed_ = GENERATE(0, 1);
+
+    auto serverScene = CreateTestScene(context);
+    auto clientScene = CreateTestScene(context);
+
+    Tests::NetworkSimulator sim(serverScene);
+    sim.AddClient(clientScene, conditions);
+
+    Node* serverNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, "Player", {0.0f, 0.96f, 0.0f});
+    serverNode->GetComponent<BehaviorNetworkObject>()->SetOwner(sim.GetServerToClientConnection(clientScene));
+
+    sim.SimulateTime(10.0f);
+    Node* clientNode = clientScene->GetChild("Player", true);
+    REQUIRE(clientNode);
+    auto clientController = clientNode->GetComponent<PredictedKinematicController>();
+
+    // Move back and forth and stop
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        clientController->SetWalkVelocity((i % 2 == 0 ? Vector3::FORWARD : Vector3::LEFT) * 2.0f);
+        sim.SimulateTime(1.0f);
+    }
+    clientController->SetWalkVelocity(Vector3::ZERO);
+    sim.SimulateTime(2.0f);
+
+    const float positionError = ReplicatedTransform::DefaultMovementThreshold;
+    CHECK(serverNode->GetWorldPosition().Equals(clientNode->GetWorldPosition(), positionError));
+    CHECK(clientNode->GetWorldPosition().ToXZ().Equals(Vector2{-4.0f, 4.0f}, 0.2f));
+
+    const NetworkConditionSimulator* simulator = sim.GetClientToServerConnection(clientScene)->GetConditionSimulator();
+    REQUIRE(simulator);
+    CHECK(simulator->GetStats().numLost_ > 0);
+}
+
+TEST_CASE("Client-side prediction benchmark with simulated network conditions", "[.benchmark]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    static constexpr unsigned numClients = 64;
+    static constexpr float simulationTime = 10.0f;
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/PredictedKinematicController/Test.prefab", CreateTestPrefab);
+
+    // 150 ms round trip with 2% loss
+    NetworkConditions conditions;
+    conditions.latencyMs_ = 70.0f;
+    conditions.jitterMs_ = 5.0f;
+    conditions.spikeRate_ = 0.01f;
+    conditions.spikeLatencyMs_ = 100.0f;
+    conditions.lossRate_ = 0.02f;
+    conditions.lossBurstLength_ = 2.0f;
+
+    auto serverScene = CreateTestScene(context);
+    Tests::NetworkSimulator sim(serverScene);
+
+    ea::vector<SharedPtr<Scene>> clientScenes;
+    for (unsigned i = 0; i < numClients; ++i)
+    {
+        auto clientScene = CreateTestScene(context);
+        sim.AddClient(clientScene, conditions);
+        clientScenes.push_back(clientScene);
+
+        const Vector3 position{(i % 8) * 4.0f, 0.96f, (i / 8) * 4.0f};
+        Node* serverNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, Format("Player{}", i), position);
+        serverNode->GetComponent<BehaviorNetworkObject>()->SetOwner(sim.GetServerToClientConnection(clientScene));
+    }
+    sim.SimulateTime(5.0f);
+
+    ea::vector<PredictedKinematicController*> clientControllers;
+    unsigned numCorrectionsBefore = 0;
+    unsigned long long numBytesBefore = 0;
+    for (unsigned i = 0; i < numClients; ++i)
+    {
+        Node* clientNode = clientScenes[i]->GetChild(Format("Player{}", i), true);
+        REQUIRE(clientNode);
+        auto clientController = clientNode->GetComponent<PredictedKinematicController>();
+        clientControllers.push_back(clientController);
+        numCorrectionsBefore += clientController->GetNumCorrections();
+        numBytesBefore += static_cast<Tests::ManualConnection*>(sim.GetServerToClientConnection(clientScenes[i]))->GetTotalBytesSent();
+    }
+
+    // Measure only server-side processing of network frame
+    HiresTimer timer;
+    long long serverTimeUs = 0;
+    unsigned numFrames = 0;
+    auto network = context->GetSubsystem<Network>();
+    serverScene->SubscribeToEvent(network, E_ENDSERVERNETWORKFRAME, [&](VariantMap& eventData) { timer.Reset(); });
+    serverScene->SubscribeToEvent(network, E_NETWORKUPDATESENT,
+        [&](VariantMap& eventData)
+    {
+        if (eventData[NetworkUpdateSent::P_ISSERVER].GetBool())
+        {
+            serverTimeUs += timer.GetUSec(false);
+            ++numFrames;
+        }
+    });
+
+    // Change direction of every player every half a second
+    const Vector3 directions[] = {Vector3::FORWARD, Vector3::RIGHT, Vector3::BACK, Vector3::LEFT};
+    for (unsigned step = 0; step < simulationTime * 2; ++step)
+    {
+        for (unsigned i = 0; i < numClients; ++i)
+            clientControllers[i]->SetWalkVelocity(directions[(i + step) % 4] * 2.0f);
+        sim.SimulateTime(0.5f);
+    }
+    serverScene->UnsubscribeFromAllEvents();
+
+    unsigned numCorrections = 0;
+    unsigned long long numBytes = 0;
+    for (unsigned i = 0; i < numClients; ++i)
+    {
+        numCorrections += clientControllers[i]->GetNumCorrections();
+        numBytes += static_cast<Tests::ManualConnection*>(sim.GetServerToClientConnection(clientScenes[i]))->GetTotalBytesSent();
+    }
+
+    const double bandwidthPerClient = (numBytes - numBytesBefore) / (simulationTime * numClients);
+    const double correctionsPerClient = (numCorrections - numCorrectionsBefore) / (simulationTime * numClients);
+    const double serverTickUs = static_cast<double>(serverTimeUs) / ea::max(numFrames, 1u);
+    URHO3D_LOGINFO("{} clients at 150 ms and 2% loss: {:.0f} bytes/s and {:.2f} corrections/s per client, "
+        "server tick {:.0f} us", numClients, bandwidthPerClient, correctionsPerClient, serverTickUs);
+}
@@ -58,6 +58,8 @@ SharedPtr<PrefabResource> CreateTestPrefab(Context* context)
 
 TEST_CASE("Animation is synchronized between client and server")
 {
+    const bool bitPacking = GENERATE(false, true);
+
     auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
     context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
 
@@ -73,6 +75,7 @@ TEST_CASE("Animation is synchronized between client and server")
     auto clientScene = MakeShared<Scene>(context);
 
     Node* serverNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, "Node");
+    serverNode->GetComponent<ReplicatedAnimation>()->SetBitPacking(bitPacking);
     auto serverAnimationController = serverNode->GetComponent<AnimationController>();
     serverAnimationController->PlayNewExclusive(AnimationParameters{animation1}.Looped());
 
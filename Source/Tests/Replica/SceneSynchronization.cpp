@@ -26,6 +26,7 @@
 
 #include <Urho3D/Graphics/Light.h>
 #include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/IO/Log.h>
 #include <Urho3D/Network/Network.h>
 #include <Urho3D/Network/NetworkEvents.h>
 #include <Urho3D/Physics/PhysicsEvents.h>
@@ -374,6 +375,151 @@ TEST_CASE("Position and rotation are synchronized between client and server")
     }
 }
 
+TEST_CASE("Unreliable updates are compressed against acknowledged baselines")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/SceneSynchronization/SimpleTest.prefab", CreateSimpleTestPrefab);
+
+    const auto quality = Tests::ConnectionQuality{0.08f, 0.12f, 0.20f, 0.1f, 0.02f};
+    const float positionError = ReplicatedTransform::DefaultMovementThreshold;
+    const float simulationDuration = 4.0f;
+
+    const auto runSimulation = [&](bool baselineCompression)
+    {
+        auto serverScene = MakeShared<Scene>(context);
+        auto clientScene = MakeShared<Scene>(context);
+        serverScene->CreateComponent<ReplicationManager>()->SetBaselineCompression(baselineCompression);
+
+        Node* serverNodeA = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, "Node");
+        auto serverTransformA = serverNodeA->GetComponent<ReplicatedTransform>();
+        Node* serverNodeB = Tests::SpawnOnServer<BehaviorNetworkObject>(serverNodeA, prefab, "Node Child", { 0.0f, 0.0f, 1.0f });
+        auto serverTransformB = serverNodeB->GetComponent<ReplicatedTransform>();
+
+        serverScene->SubscribeToEvent(serverScene, E_SCENEUPDATE,
+            [&](VariantMap& eventData)
+        {
+            const float timeStep = eventData[SceneUpdate::P_TIMESTEP].GetFloat();
+            serverNodeA->Translate(timeStep * 1.0f * Vector3::LEFT, TS_PARENT);
+            serverNodeA->Rotate({ timeStep * 10.0f, Vector3::UP }, TS_PARENT);
+            serverNodeB->Translate(timeStep * 0.1f * Vector3::FORWARD, TS_PARENT);
+        });
+
+        Tests::NetworkSimulator sim(serverScene);
+        sim.AddClient(clientScene, quality);
+        sim.SimulateTime(9.0f);
+
+        auto connection = static_cast<Tests::ManualConnection*>(sim.GetServerToClientConnection(clientScene));
+        const unsigned bytesBefore = connection->GetNumBytesSent(MSG_UPDATE_OBJECTS_UNRELIABLE);
+        sim.SimulateTime(simulationDuration);
+        const unsigned bytes = connection->GetNumBytesSent(MSG_UPDATE_OBJECTS_UNRELIABLE) - bytesBefore;
+
+        // Lost updates should not corrupt the state decoded from later updates
+        const auto& clientReplica = *clientScene->GetComponent<ReplicationManager>()->GetClientReplica();
+        const NetworkTime replicaTime = clientReplica.GetReplicaTime();
+
+        auto clientNodeA = clientScene->GetChild("Node", true);
+        auto clientNodeB = clientScene->GetChild("Node Child", true);
+        REQUIRE(clientNodeA);
+        REQUIRE(clientNodeB);
+
+        REQUIRE(serverTransformA->SampleTemporalPosition(replicaTime).value_.Cast<Vector3>().Equals(clientNodeA->GetWorldPosition(), positionError));
+        REQUIRE(serverTransformA->SampleTemporalRotation(replicaTime).value_.Equivalent(clientNodeA->GetWorldRotation(), M_EPSILON));
+        REQUIRE(serverTransformB->SampleTemporalPosition(replicaTime).value_.Cast<Vector3>().Equals(clientNodeB->GetWorldPosition(), positionError));
+        REQUIRE(serverTransformB->SampleTemporalRotation(replicaTime).value_.Equivalent(clientNodeB->GetWorldRotation(), M_EPSILON));
+
+        return bytes / (simulationDuration * Tests::NetworkSimulator::FramesInSecond);
+    };
+
+    const float bytesPerTickWithoutCompression = runSimulation(false);
+    const float bytesPerTickWithCompression = runSimulation(true);
+    URHO3D_LOGINFO("Unreliable updates: {:.1f} bytes/tick without baseline compression, {:.1f} bytes/tick with",
+        bytesPerTickWithoutCompression, bytesPerTickWithCompression);
+
+    CHECK(bytesPerTickWithCompression < bytesPerTickWithoutCompression);
+}
+
+TEST_CASE("Bit-packed transforms reduce unreliable update size")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/SceneSynchronization/SimpleTest.prefab", CreateSimpleTestPrefab);
+
+    const auto quality = Tests::ConnectionQuality{0.08f, 0.12f, 0.20f, 0.02f, 0.02f};
+    const float positionError = 0.01f;
+    const float rotationError = 0.001f;
+    const float simulationDuration = 4.0f;
+
+    const auto runSimulation = [&](bool bitPacking)
+    {
+        auto serverScene = MakeShared<Scene>(context);
+        auto clientScene = MakeShared<Scene>(context);
+
+        Node* serverNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, "Node");
+        auto serverTransform = serverNode->GetComponent<ReplicatedTransform>();
+        serverTransform->SetBitPacking(bitPacking);
+
+        serverScene->SubscribeToEvent(serverScene, E_SCENEUPDATE,
+            [&](VariantMap& eventData)
+        {
+            const float timeStep = eventData[SceneUpdate::P_TIMESTEP].GetFloat();
+            serverNode->Translate(timeStep * 1.0f * Vector3::LEFT, TS_PARENT);
+            serverNode->Rotate({ timeStep * 10.0f, Vector3::UP }, TS_PARENT);
+        });
+
+        Tests::NetworkSimulator sim(serverScene);
+        sim.AddClient(clientScene, quality);
+        sim.SimulateTime(9.0f);
+
+        auto connection = static_cast<Tests::ManualConnection*>(sim.GetServerToClientConnection(clientScene));
+        const unsigned bytesBefore = connection->GetNumBytesSent(MSG_UPDATE_OBJECTS_UNRELIABLE);
+        sim.SimulateTime(simulationDuration);
+        const unsigned bytes = connection->GetNumBytesSent(MSG_UPDATE_OBJECTS_UNRELIABLE) - bytesBefore;
+
+        const auto& clientReplica = *clientScene->GetComponent<ReplicationManager>()->GetClientReplica();
+        const NetworkTime replicaTime = clientReplica.GetReplicaTime();
+
+        auto clientNode = clientScene->GetChild("Node", true);
+        REQUIRE(clientNode);
+        REQUIRE(clientNode->GetComponent<ReplicatedTransform>()->GetBitPacking() == bitPacking);
+
+        const Quaternion expectedRotation = serverTransform->SampleTemporalRotation(replicaTime).value_;
+        REQUIRE(serverTransform->SampleTemporalPosition(replicaTime).value_.Cast<Vector3>().Equals(clientNode->GetWorldPosition(), positionError));
+        REQUIRE(Abs(expectedRotation.DotProduct(clientNode->GetWorldRotation())) >= 1.0f - rotationError);
+
+        return bytes / (simulationDuration * Tests::NetworkSimulator::FramesInSecond);
+    };
+
+    const float bytesPerTickWithoutBitPacking = runSimulation(false);
+    const float bytesPerTickWithBitPacking = runSimulation(true);
+    URHO3D_LOGINFO("Unreliable updates: {:.1f} bytes/tick without bit packing, {:.1f} bytes/tick with",
+        bytesPerTickWithoutBitPacking, bytesPerTickWithBitPacking);
+
+    CHECK(bytesPerTickWithBitPacking < bytesPerTickWithoutBitPacking);
+}
+
+TEST_CASE("Bit-packed transform rejects unsupported number of bits")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto node = MakeShared<Node>(context);
+    auto transform = node->CreateComponent<ReplicatedTransform>();
+
+    transform->SetPositionBits(0);
+    CHECK(transform->GetPositionBits() == 0);
+    transform->SetVelocityBits(1);
+    CHECK(transform->GetVelocityBits() == 2);
+    transform->SetRotationBits(33);
+    CHECK(transform->GetRotationBits() == 32);
+
+    transform->SetAttribute("Angular Velocity Bits", 100u);
+    CHECK(transform->GetAngularVelocityBits() == 32);
+    transform->SetAttribute("Position Bits", 1u);
+    CHECK(transform->GetPositionBits() == 2);
+}
+
 TEST_CASE("Prefabs are replicated on clients")
 {
     auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
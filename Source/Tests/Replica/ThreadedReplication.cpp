@@ -0,0 +1,150 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../NetworkUtils.h"
+#include "../SceneUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Network/Network.h>
+#include <Urho3D/Network/NetworkEvents.h>
+#include <Urho3D/Replica/BehaviorNetworkObject.h>
+#include <Urho3D/Replica/ReplicatedTransform.h>
+#include <Urho3D/Replica/ReplicationManager.h>
+#include <Urho3D/Scene/PrefabResource.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+SharedPtr<PrefabResource> CreateThreadedTestPrefab(Context* context)
+{
+    auto node = MakeShared<Node>(context);
+    node->CreateComponent<ReplicatedTransform>();
+
+    return Tests::ConvertNodeToPrefab(node);
+}
+
+}
+
+TEST_CASE("Server replicates scene to clients in worker threads")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateThreadedContext);
+    REQUIRE(context->GetSubsystem<WorkQueue>()->GetNumProcessingThreads() > 1);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(
+        context, "@/ThreadedReplication/Test.prefab", CreateThreadedTestPrefab);
+
+    static constexpr unsigned numClients = 8;
+    static constexpr unsigned numObjects = 32;
+    static constexpr float velocity = 1.0f;
+
+    auto serverScene = MakeShared<Scene>(context);
+    serverScene->CreateComponent<ReplicationManager>()->SetThreadedUpdate(true);
+
+    Tests::NetworkSimulator sim(serverScene);
+    ea::vector<SharedPtr<Scene>> clientScenes;
+    for (unsigned i = 0; i < numClients; ++i)
+    {
+        auto clientScene = MakeShared<Scene>(context);
+        sim.AddClient(clientScene, Tests::ConnectionQuality{0.08f, 0.12f, 0.20f, 0.02f, 0.02f});
+        clientScenes.push_back(clientScene);
+    }
+    sim.SimulateTime(5.0f);
+
+    for (unsigned i = 0; i < numObjects; ++i)
+        Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, Format("Object {}", i), Vector3{0.0f, 0.0f, i * 2.0f});
+    sim.SimulateTime(3.0f);
+
+    const float timeStep = 1.0f / Tests::NetworkSimulator::FramesInSecond;
+    for (unsigned step = 0; step < 2 * Tests::NetworkSimulator::FramesInSecond; ++step)
+    {
+        for (Node* node : serverScene->GetChildren())
+            node->Translate(Vector3::RIGHT * velocity * timeStep);
+        sim.SimulateTime(timeStep);
+    }
+    sim.SimulateTime(1.0f);
+
+    // Every client should see every object at the final position
+    for (Scene* clientScene : clientScenes)
+    {
+        for (unsigned i = 0; i < numObjects; ++i)
+        {
+            const ea::string name = Format("Object {}", i);
+            Node* serverNode = serverScene->GetChild(name, true);
+            Node* clientNode = clientScene->GetChild(name, true);
+            REQUIRE(serverNode);
+            REQUIRE(clientNode);
+            CHECK(serverNode->GetWorldPosition().Equals(clientNode->GetWorldPosition(), M_LARGE_EPSILON));
+        }
+    }
+}
+
+TEST_CASE("Threaded server replication benchmark", "[.benchmark]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateThreadedContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    static constexpr unsigned numClients = 128;
+    static constexpr unsigned numObjects = 1024;
+    static constexpr float simulationTime = 4.0f;
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(
+        context, "@/ThreadedReplication/Test.prefab", CreateThreadedTestPrefab);
+
+    const auto runBenchmark = [&](bool threadedUpdate)
+    {
+        auto serverScene = MakeShared<Scene>(context);
+        serverScene->CreateComponent<ReplicationManager>()->SetThreadedUpdate(threadedUpdate);
+
+        Tests::NetworkSimulator sim(serverScene);
+        ea::vector<SharedPtr<Scene>> clientScenes;
+        for (unsigned i = 0; i < numClients; ++i)
+        {
+            auto clientScene = MakeShared<Scene>(context);
+            sim.AddClient(clientScene, Tests::ConnectionQuality{});
+            clientScenes.push_back(clientScene);
+        }
+        sim.SimulateTime(2.0f);
+
+        for (unsigned i = 0; i < numObjects; ++i)
+            Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, "Object", Vector3{0.0f, 0.0f, i * 1.0f});
+        sim.SimulateTime(1.0f);
+
+        // Measure only server-side processing of network frame
+        HiresTimer timer;
+        long long serverTimeUs = 0;
+        unsigned numFrames = 0;
+        auto network = context->GetSubsystem<Network>();
+        serverScene->SubscribeToEvent(network, E_ENDSERVERNETWORKFRAME, [&](VariantMap& eventData) { timer.Reset(); });
+        serverScene->SubscribeToEvent(network, E_NETWORKUPDATESENT,
+            [&](VariantMap& eventData)
+        {
+            if (eventData[NetworkUpdateSent::P_ISSERVER].GetBool())
+            {
+                serverTimeUs += timer.GetUSec(false);
+                ++numFrames;
+            }
+        });
+
+        for (unsigned step = 0; step < simulationTime * Tests::NetworkSimulator::FramesInSecond; ++step)
+        {
+            for (Node* node : serverScene->GetChildren())
+                node->Translate(Vector3::RIGHT * 0.1f);
+            sim.SimulateTime(1.0f / Tests::NetworkSimulator::FramesInSecond);
+        }
+        serverScene->UnsubscribeFromAllEvents();
+
+        return static_cast<double>(serverTimeUs) / ea::max(numFrames, 1u);
+    };
+
+    const unsigned numThreads = context->GetSubsystem<WorkQueue>()->GetNumProcessingThreads();
+    const double timeSingleThreaded = runBenchmark(false);
+    const double timeThreaded = runBenchmark(true);
+    URHO3D_LOGINFO("Server tick with {} clients and {} objects: {:.0f} us in main thread, {:.0f} us in {} threads",
+        numClients, numObjects, timeSingleThreaded, timeThreaded, numThreads);
+}
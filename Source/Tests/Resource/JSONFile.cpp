@@ -0,0 +1,65 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Resource/JSONFile.h>
+
+TEST_CASE("JSONFile builds values while parsing")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const ea::string text = R"(
+    {
+        // Comments and trailing commas are allowed in files
+        "int": -5,
+        "uint": 3000000000,
+        "big": 10000000000,
+        "double": 0.5,
+        "string": "text",
+        "null": null,
+        "array": [1, [true, false], {"nested": "value"},],
+        "object": {"a": {"b": {}}, "c": []},
+    })";
+
+    auto jsonFile = MakeShared<JSONFile>(context);
+    REQUIRE(jsonFile->FromString(text));
+
+    const JSONValue& root = jsonFile->GetRoot();
+    REQUIRE(root.IsObject());
+    CHECK(root.Size() == 8);
+
+    CHECK(root["int"].GetNumberType() == JSONNT_INT);
+    CHECK(root["int"].GetInt() == -5);
+    CHECK(root["uint"].GetNumberType() == JSONNT_UINT);
+    CHECK(root["uint"].GetUInt() == 3000000000u);
+    CHECK(root["big"].GetNumberType() == JSONNT_FLOAT_DOUBLE);
+    CHECK(root["big"].GetDouble() == 10000000000.0);
+    CHECK(root["double"].GetDouble() == 0.5);
+    CHECK(root["string"].GetString() == "text");
+    CHECK(root["null"].IsNull());
+
+    const JSONValue& array = root["array"];
+    REQUIRE(array.IsArray());
+    REQUIRE(array.Size() == 3);
+    CHECK(array[0].GetInt() == 1);
+    REQUIRE(array[1].Size() == 2);
+    CHECK(array[1][0].GetBool() == true);
+    CHECK(array[1][1].GetBool() == false);
+    CHECK(array[2]["nested"].GetString() == "value");
+
+    const JSONValue& object = root["object"];
+    CHECK(object["a"]["b"].IsObject());
+    CHECK(object["a"]["b"].Size() == 0);
+    CHECK(object["c"].IsArray());
+
+    // Failed parse doesn't leave partial content
+    CHECK_FALSE(jsonFile->FromString(R"({"a": [1, 2)"));
+    CHECK(jsonFile->GetRoot().IsNull());
+
+    JSONValue value;
+    REQUIRE(JSONFile::ParseJSON("[1, 2, 3]", value));
+    CHECK(value.Size() == 3);
+    CHECK_FALSE(JSONFile::ParseJSON("[1, 2, 3", value, false));
+}
@@ -22,9 +22,19 @@
 
 #include "../CommonUtils.h"
 
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/IO/MountedExternalMemory.h>
 #include <Urho3D/IO/VirtualFileSystem.h>
+#include <Urho3D/Resource/BinaryFile.h>
 #include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/ResourceEvents.h>
+#include <Urho3D/Scene/Node.h>
+
+#include <EASTL/numeric.h>
+
+#include <atomic>
+#include <thread>
 
 namespace Tests
 {
@@ -52,4 +62,263 @@ TEST_CASE("ResourceCache loads resources from memory")
     CHECK(xmlFile->GetRoot().GetName() == "something_else");
 }
 
+TEST_CASE("ResourceCache loads many resources in background")
+{
+    const auto context = Tests::GetOrCreateContext(Tests::CreateThreadedContext);
+    const auto resourceCache = context->GetSubsystem<ResourceCache>();
+    auto mountPoint = MakeShared<MountedExternalMemory>(context, "memory");
+    const MountPointGuard mountPointGuard(mountPoint);
+
+    // Mount point doesn't own linked memory, so keep it alive
+    static constexpr unsigned numResources = 2000;
+    ea::vector<ea::string> contents(numResources);
+    for (unsigned i = 0; i < numResources; ++i)
+    {
+        contents[i] = Format("<resource index=\"{}\"/>", i);
+        mountPoint->LinkMemory(Format("background/{}.xml", i), contents[i]);
+    }
+
+    resourceCache->ResetBackgroundLoadStats();
+    for (unsigned i = 0; i < numResources; ++i)
+    {
+        const float priority = static_cast<float>(i % 10);
+        REQUIRE(resourceCache->BackgroundLoadResource<XMLFile>(Format("memory://background/{}.xml", i), true, nullptr, priority));
+    }
+
+    for (unsigned frame = 0; frame < 10000 && resourceCache->GetNumBackgroundLoadResources() != 0; ++frame)
+        Tests::RunFrame(context, 0.01f);
+    REQUIRE(resourceCache->GetNumBackgroundLoadResources() == 0);
+
+    for (unsigned i = 0; i < numResources; ++i)
+    {
+        auto xmlFile = resourceCache->GetExistingResource<XMLFile>(Format("memory://background/{}.xml", i));
+        REQUIRE(xmlFile);
+        REQUIRE(xmlFile->GetRoot().GetUInt("index") == i);
+        resourceCache->ReleaseResource<XMLFile>(xmlFile->GetName(), true);
+    }
+
+    const BackgroundLoadStats stats = resourceCache->GetBackgroundLoadStats();
+    CHECK(stats.numLoaded_ == numResources);
+    CHECK(stats.numFailed_ == 0);
+    CHECK(ea::accumulate(stats.latencyHistogram_.begin(), stats.latencyHistogram_.end(), 0u) == numResources);
+    CHECK(stats.GetThroughput() > 0.0f);
+    CHECK(stats.GetLatencyPercentile(0.5f) <= stats.GetLatencyPercentile(0.99f));
+
+    Tests::PrintBenchmarkResult(Format("Background loading of {} resources in {} worker threads: {:.1f} ms elapsed, "
+                                       "{:.1f} ms in BeginLoad, {:.0f} resources/s, latency p50 {} ms, p99 {} ms",
+        numResources, context->GetSubsystem<WorkQueue>()->GetNumProcessingThreads() - 1, stats.elapsedTime_ / 1000.0,
+        stats.loadTime_ / 1000.0, stats.GetThroughput(), stats.GetLatencyPercentile(0.5f),
+        stats.GetLatencyPercentile(0.99f)));
+}
+
+TEST_CASE("ResourceCache background loading is prioritized and can be cancelled")
+{
+    const auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto resourceCache = context->GetSubsystem<ResourceCache>();
+    auto mountPoint = MakeShared<MountedExternalMemory>(context, "memory");
+    const MountPointGuard mountPointGuard(mountPoint);
+
+    mountPoint->LinkMemory("priority/low.xml", "<low/>");
+    mountPoint->LinkMemory("priority/high.xml", "<high/>");
+    mountPoint->LinkMemory("priority/raised.xml", "<raised/>");
+    mountPoint->LinkMemory("priority/cancelled.xml", "<cancelled/>");
+
+    ea::vector<ea::string> loadedResources;
+    auto receiver = MakeShared<Node>(context);
+    receiver->SubscribeToEvent(E_RESOURCEBACKGROUNDLOADED, [&](VariantMap& eventData)
+    {
+        loadedResources.push_back(eventData[ResourceBackgroundLoaded::P_RESOURCENAME].GetString());
+    });
+
+    resourceCache->ResetBackgroundLoadStats();
+    REQUIRE(resourceCache->BackgroundLoadResource<XMLFile>("memory://priority/low.xml", true, nullptr, 0.0f));
+    REQUIRE(resourceCache->BackgroundLoadResource<XMLFile>("memory://priority/high.xml", true, nullptr, 2.0f));
+    REQUIRE(resourceCache->BackgroundLoadResource<XMLFile>("memory://priority/raised.xml", true, nullptr, 0.0f));
+    REQUIRE(resourceCache->BackgroundLoadResource<XMLFile>("memory://priority/cancelled.xml", true, nullptr, 3.0f));
+    CHECK_FALSE(resourceCache->BackgroundLoadResource<XMLFile>("memory://priority/low.xml"));
+
+    resourceCache->SetBackgroundLoadPriority<XMLFile>("memory://priority/raised.xml", 1.0f);
+    REQUIRE(resourceCache->CancelBackgroundLoadResource<XMLFile>("memory://priority/cancelled.xml"));
+
+    for (unsigned frame = 0; frame < 100 && resourceCache->GetNumBackgroundLoadResources() != 0; ++frame)
+        Tests::RunFrame(context, 0.01f);
+    REQUIRE(resourceCache->GetNumBackgroundLoadResources() == 0);
+
+    CHECK_FALSE(resourceCache->GetExistingResource<XMLFile>("memory://priority/cancelled.xml"));
+    CHECK(resourceCache->GetBackgroundLoadStats().numCancelled_ == 1);
+    REQUIRE(loadedResources.size() == 3);
+
+    // Worker threads may finish resources in different frames
+    if (!context->GetSubsystem<WorkQueue>()->IsMultithreaded())
+    {
+        CHECK(loadedResources[0] == "memory://priority/high.xml");
+        CHECK(loadedResources[1] == "memory://priority/raised.xml");
+        CHECK(loadedResources[2] == "memory://priority/low.xml");
+    }
+
+    for (const ea::string& name : loadedResources)
+        resourceCache->ReleaseResource<XMLFile>(name, true);
+}
+
+TEST_CASE("ResourceCache background loading is prioritized in worker threads")
+{
+    const auto context = Tests::GetOrCreateContext(Tests::CreateThreadedContext);
+    const auto resourceCache = context->GetSubsystem<ResourceCache>();
+    const auto workQueue = context->GetSubsystem<WorkQueue>();
+    REQUIRE(workQueue->IsMultithreaded());
+
+    auto mountPoint = MakeShared<MountedExternalMemory>(context, "memory");
+    const MountPointGuard mountPointGuard(mountPoint);
+
+    mountPoint->LinkMemory("threaded/low.xml", "<low/>");
+    mountPoint->LinkMemory("threaded/high.xml", "<high/>");
+    mountPoint->LinkMemory("threaded/raised.xml", "<raised/>");
+    mountPoint->LinkMemory("threaded/cancelled.xml", "<cancelled/>");
+
+    ea::vector<ea::string> loadedResources;
+    auto receiver = MakeShared<Node>(context);
+    receiver->SubscribeToEvent(E_RESOURCEBACKGROUNDLOADED, [&](VariantMap& eventData)
+    {
+        loadedResources.push_back(eventData[ResourceBackgroundLoaded::P_RESOURCENAME].GetString());
+    });
+
+    // Keep worker threads busy until all resources are queued, then load resources one by one
+    const unsigned numWorkerThreads = workQueue->GetNumProcessingThreads() - 1;
+    std::atomic<unsigned> numBlockedThreads{};
+    std::atomic<bool> areThreadsBlocked{true};
+    for (unsigned i = 1; i <= numWorkerThreads; ++i)
+    {
+        workQueue->PostTaskForThread([&]()
+        {
+            ++numBlockedThreads;
+            while (areThreadsBlocked)
+                std::this_thread::yield();
+        }, TaskPriority::High, i);
+    }
+    while (numBlockedThreads < numWorkerThreads)
+        std::this_thread::yield();
+
+    resourceCache->SetMaxConcurrentBackgroundLoads(1);
+    REQUIRE(resourceCache->BackgroundLoadResource<XMLFile>("memory://threaded/low.xml", true, nullptr, 0.0f));
+    REQUIRE(resourceCache->BackgroundLoadResource<XMLFile>("memory://threaded/high.xml", true, nullptr, 2.0f));
+    REQUIRE(resourceCache->BackgroundLoadResource<XMLFile>("memory://threaded/raised.xml", true, nullptr, 0.0f));
+    REQUIRE(resourceCache->BackgroundLoadResource<XMLFile>("memory://threaded/cancelled.xml", true, nullptr, 3.0f));
+    resourceCache->SetBackgroundLoadPriority<XMLFile>("memory://threaded/raised.xml", 1.0f);
+    REQUIRE(resourceCache->CancelBackgroundLoadResource<XMLFile>("memory://threaded/cancelled.xml"));
+    areThreadsBlocked = false;
+
+    for (unsigned frame = 0; frame < 1000 && resourceCache->GetNumBackgroundLoadResources() != 0; ++frame)
+        Tests::RunFrame(context, 0.01f);
+    resourceCache->SetMaxConcurrentBackgroundLoads(0);
+    REQUIRE(resourceCache->GetNumBackgroundLoadResources() == 0);
+
+    CHECK_FALSE(resourceCache->GetExistingResource<XMLFile>("memory://threaded/cancelled.xml"));
+    REQUIRE(loadedResources.size() == 3);
+    CHECK(loadedResources[0] == "memory://threaded/high.xml");
+    CHECK(loadedResources[1] == "memory://threaded/raised.xml");
+    CHECK(loadedResources[2] == "memory://threaded/low.xml");
+
+    for (const ea::string& name : loadedResources)
+        resourceCache->ReleaseResource<XMLFile>(name, true);
+}
+
+
+TEST_CASE("ResourceCache releases least recently used resources over memory budget")
+{
+    const auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto resourceCache = context->GetSubsystem<ResourceCache>();
+    const StringHash type = BinaryFile::GetTypeStatic();
+
+    static constexpr unsigned numResources = 20;
+    static constexpr unsigned resourceSize = 1000;
+    static constexpr unsigned memoryBudget = 5 * resourceSize;
+
+    ea::vector<ea::string> contents;
+    for (unsigned i = 0; i < numResources; ++i)
+        contents.push_back(ea::string(resourceSize, static_cast<char>('a' + i)));
+
+    auto mountPoint = MakeShared<MountedExternalMemory>(context, "memory");
+    const MountPointGuard mountPointGuard(mountPoint);
+    for (unsigned i = 0; i < numResources; ++i)
+        mountPoint->LinkMemory(Format("churn/{}.bin", i), contents[i]);
+
+    const auto getName = [](unsigned i) { return Format("memory://churn/{}.bin", i); };
+    const auto churn = [&]
+    {
+        for (unsigned i = 0; i < numResources; ++i)
+        {
+            REQUIRE(resourceCache->GetResource<BinaryFile>(getName(i)));
+            Time::Sleep(2);
+        }
+        resourceCache->EnforceMemoryBudgets();
+    };
+
+    resourceCache->SetMemoryBudget(type, memoryBudget);
+    resourceCache->ResetEvictionStats();
+
+    // Resource in use is never released
+    const SharedPtr<BinaryFile> pinnedResource{resourceCache->GetResource<BinaryFile>(getName(0))};
+    REQUIRE(pinnedResource);
+
+    SECTION("Resources are removed from cache")
+    {
+        churn();
+        CHECK(resourceCache->GetMemoryUse(type) <= memoryBudget);
+        CHECK(resourceCache->GetExistingResource<BinaryFile>(getName(0)) == pinnedResource);
+        CHECK(resourceCache->GetExistingResource<BinaryFile>(getName(numResources - 1)));
+        CHECK_FALSE(resourceCache->GetExistingResource<BinaryFile>(getName(1)));
+
+        const ResourceEvictionStats stats = resourceCache->GetEvictionStats(type);
+        CHECK(stats.numEvicted_ >= numResources - memoryBudget / resourceSize);
+        CHECK(stats.numSoftEvicted_ == 0);
+    }
+
+    SECTION("Resource data is released and restored on request")
+    {
+        resourceCache->SetSoftEviction(type, true);
+        churn();
+        CHECK(resourceCache->GetMemoryUse(type) <= memoryBudget);
+
+        auto releasedResource = resourceCache->GetExistingResource<BinaryFile>(getName(1));
+        REQUIRE(releasedResource);
+        CHECK_FALSE(releasedResource->IsResident());
+        CHECK(releasedResource->GetData().empty());
+
+        auto restoredResource = resourceCache->GetResource<BinaryFile>(getName(1));
+        REQUIRE(restoredResource == releasedResource);
+        CHECK(restoredResource->IsResident());
+        CHECK(restoredResource->GetText() == contents[1]);
+
+        const ResourceEvictionStats stats = resourceCache->GetEvictionStats(type);
+        CHECK(stats.numEvicted_ == 0);
+        CHECK(stats.numSoftEvicted_ >= numResources - memoryBudget / resourceSize);
+        CHECK(stats.numRestored_ == 1);
+    }
+
+    SECTION("Resource data is restored in background")
+    {
+        resourceCache->SetSoftEviction(type, true);
+        churn();
+
+        const SharedPtr<BinaryFile> releasedResource{resourceCache->GetExistingResource<BinaryFile>(getName(1))};
+        REQUIRE(releasedResource);
+        REQUIRE_FALSE(releasedResource->IsResident());
+
+        REQUIRE(resourceCache->BackgroundLoadResource<BinaryFile>(getName(1)));
+        CHECK_FALSE(resourceCache->BackgroundLoadResource<BinaryFile>(getName(numResources - 1)));
+        for (unsigned frame = 0; frame < 100 && resourceCache->GetNumBackgroundLoadResources() != 0; ++frame)
+            Tests::RunFrame(context, 0.01f);
+        REQUIRE(resourceCache->GetNumBackgroundLoadResources() == 0);
+
+        CHECK(resourceCache->GetExistingResource<BinaryFile>(getName(1)) == releasedResource);
+        CHECK(releasedResource->IsResident());
+        CHECK(releasedResource->GetText() == contents[1]);
+        CHECK(resourceCache->GetEvictionStats(type).numRestored_ == 1);
+    }
+
+    resourceCache->SetMemoryBudget(type, 0);
+    resourceCache->SetSoftEviction(type, false);
+    resourceCache->ReleaseResources(type, "memory://churn/", true);
+}
+
 } // namespace Tests
@@ -0,0 +1,164 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../SceneUtils.h"
+
+#include <Urho3D/IO/MountedExternalMemory.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/IO/VirtualFileSystem.h>
+#include <Urho3D/Scene/CompactPrefab.h>
+#include <Urho3D/Scene/PrefabResource.h>
+#include <Urho3D/Scene/PrefabWriter.h>
+#include <Urho3D/Scene/ShakeComponent.h>
+
+namespace
+{
+
+SharedPtr<Scene> CreateTestScene(Context* context, unsigned numNodes)
+{
+    auto scene = MakeShared<Scene>(context);
+    for (unsigned i = 0; i < numNodes; ++i)
+    {
+        Node* node = scene->CreateChild(Format("Node{}", i % 16));
+        node->SetPosition({static_cast<float>(i), 1.0f, 2.0f});
+        node->AddTag(i % 2 ? "Odd" : "Even");
+        node->SetVar("Index", static_cast<int>(i));
+        node->SetVar("Label", Format("Label{}", i % 4));
+
+        if (i % 3 == 0)
+        {
+            auto shake = node->CreateComponent<ShakeComponent>();
+            shake->SetShiftRange({1.0f, 2.0f, static_cast<float>(i)});
+        }
+
+        Node* child = node->CreateChild("Child");
+        child->SetScale(2.0f);
+    }
+    return scene;
+}
+
+NodePrefab GenerateScenePrefab(Scene* scene)
+{
+    NodePrefab prefab;
+    PrefabWriterToMemory writer{prefab};
+    scene->Save(writer);
+    return prefab;
+}
+
+}
+
+TEST_CASE("CompactPrefab preserves prefab content")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = CreateTestScene(context, 50);
+    const NodePrefab prefab = GenerateScenePrefab(scene);
+
+    for (const bool compress : {false, true})
+    {
+        VectorBuffer buffer;
+        REQUIRE(CompactPrefab::Save(buffer, prefab, compress));
+
+        buffer.Seek(0);
+        REQUIRE(CompactPrefab::IsCompactPrefab(buffer));
+        CHECK(buffer.GetPosition() == 0);
+
+        NodePrefab loadedPrefab;
+        REQUIRE(CompactPrefab::Load(buffer, loadedPrefab, context));
+        CHECK(loadedPrefab == prefab);
+    }
+
+    // Truncated data is rejected
+    VectorBuffer buffer;
+    REQUIRE(CompactPrefab::Save(buffer, prefab));
+    buffer.Resize(buffer.GetSize() / 2);
+    buffer.Seek(0);
+    NodePrefab loadedPrefab;
+    CHECK_FALSE(CompactPrefab::Load(buffer, loadedPrefab, context));
+    CHECK(loadedPrefab.IsEmpty());
+
+    // Decompressed size is validated before allocation
+    VectorBuffer compressedBuffer;
+    REQUIRE(CompactPrefab::Save(compressedBuffer, prefab, true));
+    compressedBuffer.Seek(0);
+    compressedBuffer.ReadFileID();
+    const unsigned version = compressedBuffer.ReadVLE();
+    const unsigned char flags = compressedBuffer.ReadUByte();
+    const unsigned payloadSize = compressedBuffer.ReadVLE();
+    const unsigned storedSize = compressedBuffer.ReadVLE();
+    ByteVector storedPayload(storedSize);
+    REQUIRE(compressedBuffer.Read(storedPayload.data(), storedSize) == storedSize);
+
+    for (const unsigned claimedSize : {payloadSize - 1, payloadSize + 1, 0x0fffffffu})
+    {
+        VectorBuffer malformedBuffer;
+        malformedBuffer.WriteFileID("UCPF");
+        malformedBuffer.WriteVLE(version);
+        malformedBuffer.WriteUByte(flags);
+        malformedBuffer.WriteVLE(claimedSize);
+        malformedBuffer.WriteVLE(storedSize);
+        malformedBuffer.Write(storedPayload.data(), storedSize);
+        malformedBuffer.Seek(0);
+        CHECK_FALSE(CompactPrefab::Load(malformedBuffer, loadedPrefab, context));
+    }
+}
+
+TEST_CASE("Scene is saved to and loaded from compact format")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = CreateTestScene(context, 1000);
+
+    VectorBuffer binaryBuffer;
+    REQUIRE(scene->Save(binaryBuffer));
+
+    VectorBuffer compactBuffer;
+    REQUIRE(scene->SaveCompact(compactBuffer));
+    CHECK(compactBuffer.GetSize() < binaryBuffer.GetSize());
+
+    VectorBuffer compressedBuffer;
+    REQUIRE(scene->SaveCompact(compressedBuffer, true));
+    CHECK(compressedBuffer.GetSize() < compactBuffer.GetSize());
+
+    auto loadedScene = MakeShared<Scene>(context);
+    compressedBuffer.Seek(0);
+    REQUIRE(loadedScene->Load(compressedBuffer));
+    CHECK(GenerateScenePrefab(loadedScene) == GenerateScenePrefab(scene));
+
+    Node* node = loadedScene->GetChild("Node3");
+    REQUIRE(node);
+    CHECK(node->HasTag("Odd"));
+    CHECK(node->GetVar("Label") == Variant("Label3"));
+    CHECK(node->GetComponent<ShakeComponent>()->GetShiftRange() == Vector3{1.0f, 2.0f, 3.0f});
+    CHECK(node->GetChild("Child")->GetScale() == Vector3::ONE * 2.0f);
+
+    // Asynchronous loading is not supported for compact scenes
+    auto mountPoint = MakeShared<MountedExternalMemory>(context, "memory");
+    const MountPointGuard mountPointGuard(mountPoint);
+    mountPoint->LinkMemory("CompactScene.bin", MemoryBuffer{compressedBuffer.GetBuffer()});
+
+    auto asyncScene = MakeShared<Scene>(context);
+    const AbstractFilePtr compressedFile =
+        context->GetSubsystem<VirtualFileSystem>()->OpenFile(FileIdentifier{"memory", "CompactScene.bin"}, FILE_READ);
+    REQUIRE(compressedFile);
+    CHECK_FALSE(asyncScene->LoadAsync(compressedFile));
+    CHECK_FALSE(asyncScene->IsAsyncLoading());
+}
+
+TEST_CASE("PrefabResource is loaded from compact format")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = CreateTestScene(context, 10);
+
+    auto prefabResource = MakeShared<PrefabResource>(context);
+    scene->GetChild("Node5")->GeneratePrefab(prefabResource->GetMutableNodePrefab());
+
+    VectorBuffer buffer;
+    REQUIRE(prefabResource->SaveCompact(buffer));
+
+    auto loadedResource = MakeShared<PrefabResource>(context);
+    buffer.Seek(0);
+    REQUIRE(loadedResource->Load(buffer));
+    CHECK(loadedResource->GetNodePrefab() == prefabResource->GetNodePrefab());
+    CHECK(loadedResource->GetNodePrefab().GetNodeName() == "Node5");
+}
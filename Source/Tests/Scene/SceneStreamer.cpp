@@ -0,0 +1,146 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../SceneUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Scene/SceneStreamer.h>
+
+namespace
+{
+
+/// Create prefab of the cell with position attribute that can be patched.
+NodePrefab CreateCellTemplate(Context* context, unsigned numChildren)
+{
+    auto scene = MakeShared<Scene>(context);
+    Node* cellNode = scene->CreateChild("Cell");
+    cellNode->SetPosition({1.0f, 0.0f, 1.0f});
+    for (unsigned i = 0; i < numChildren; ++i)
+    {
+        Node* child = cellNode->CreateChild(Format("Object{}", i));
+        child->SetPosition({static_cast<float>(i), 0.0f, 0.0f});
+        child->CreateChild("Part");
+    }
+    return cellNode->GeneratePrefab();
+}
+
+}
+
+TEST_CASE("SceneStreamer streams cells around moving focus")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    const int worldSize = 100;
+    const float cellSize = 10.0f;
+    const unsigned numChildren = 10;
+    const NodePrefab cellTemplate = CreateCellTemplate(context, numChildren);
+
+    auto scene = MakeShared<Scene>(context);
+    auto streamer = scene->CreateComponent<SceneStreamer>();
+    streamer->SetCellSize(cellSize);
+    streamer->SetLoadDistance(30.0f);
+    streamer->SetUnloadDistance(40.0f);
+    streamer->SetAttachBudgetMs(1.0f);
+    streamer->SetCellLoader([&](const IntVector2& cell, NodePrefab& prefab)
+    {
+        if (cell.x_ < 0 || cell.y_ < 0 || cell.x_ >= worldSize || cell.y_ >= worldSize)
+            return false;
+
+        prefab = cellTemplate;
+        for (AttributePrefab& attribute : prefab.GetMutableNode().GetMutableAttributes())
+        {
+            if (attribute.GetName() == "Position")
+                attribute.SetValue(Vector3{cell.x_ * cellSize, 0.0f, cell.y_ * cellSize});
+        }
+        return true;
+    });
+
+    // Move diagonally through the whole world
+    const unsigned numFrames = 500;
+    long long totalUSec = 0;
+    long long maxUSec = 0;
+    unsigned maxCellNodes = 0;
+    for (unsigned frame = 0; frame <= numFrames; ++frame)
+    {
+        const float progress = static_cast<float>(frame) / numFrames;
+        const Vector3 focus = Vector3{1.0f, 0.0f, 1.0f} * progress * worldSize * cellSize;
+
+        HiresTimer timer;
+        streamer->UpdateStreaming(focus);
+        const long long frameUSec = timer.GetUSec(false);
+        totalUSec += frameUSec;
+        maxUSec = ea::max(maxUSec, frameUSec);
+        maxCellNodes = ea::max(maxCellNodes, scene->GetNumChildren());
+
+        workQueue->CompleteAll();
+    }
+
+    // Finish streaming around the final position
+    const Vector3 finalFocus{985.0f, 0.0f, 985.0f};
+    for (unsigned frame = 0; frame < 1000 && streamer->GetNumPendingCells() > 0; ++frame)
+    {
+        streamer->UpdateStreaming(finalFocus);
+        workQueue->CompleteAll();
+    }
+
+    INFO("Average main thread time per frame: " << totalUSec / (numFrames + 1) << " us");
+    INFO("Max main thread time per frame: " << maxUSec << " us");
+    CHECK(maxUSec < 100000);
+
+    // Only cells around the focus are kept
+    CHECK(maxCellNodes < 80);
+    CHECK(streamer->GetNumPendingCells() == 0);
+    CHECK(scene->GetNumChildren() <= streamer->GetNumAttachedCells());
+
+    Node* lastCell = streamer->GetCellNode({98, 98});
+    REQUIRE(lastCell);
+    CHECK(lastCell->GetName() == "Cell_98_98");
+    CHECK(lastCell->GetPosition().Equals({980.0f, 0.0f, 980.0f}));
+    CHECK(lastCell->GetNumChildren() == numChildren);
+    CHECK(lastCell->GetChild("Object3")->GetPosition().Equals({3.0f, 0.0f, 0.0f}));
+    CHECK(lastCell->GetChild("Object3")->GetChild("Part"));
+
+    CHECK_FALSE(streamer->GetCellNode({0, 0}));
+    CHECK_FALSE(streamer->GetCellNode({100, 100}));
+
+    // Streamed cells are not saved with the scene
+    CHECK(lastCell->IsTemporary());
+    CHECK(lastCell->GetChild("Object3")->IsTemporary());
+
+    VectorBuffer buffer;
+    REQUIRE(scene->Save(buffer));
+    buffer.Seek(0);
+    auto loadedScene = MakeShared<Scene>(context);
+    REQUIRE(loadedScene->Load(buffer));
+    CHECK(loadedScene->GetNumChildren() == 0);
+    CHECK(loadedScene->GetComponent<SceneStreamer>());
+
+    streamer->UnloadAllCells();
+    CHECK(scene->GetNumChildren() == 0);
+}
+
+TEST_CASE("SceneStreamer rejects unload distance below load distance")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = MakeShared<Scene>(context);
+    auto streamer = scene->CreateComponent<SceneStreamer>();
+
+    streamer->SetLoadDistance(100.0f);
+    streamer->SetUnloadDistance(50.0f);
+    CHECK(streamer->GetUnloadDistance() == 100.0f);
+
+    streamer->SetUnloadDistance(150.0f);
+    CHECK(streamer->GetUnloadDistance() == 150.0f);
+
+    streamer->SetLoadDistance(200.0f);
+    CHECK(streamer->GetLoadDistance() == 200.0f);
+    CHECK(streamer->GetUnloadDistance() == 200.0f);
+
+    streamer->SetAttribute("Unload Distance", 10.0f);
+    CHECK(streamer->GetUnloadDistance() == 200.0f);
+}
@@ -0,0 +1,229 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Utility/DerivedDataCache.h>
+
+namespace
+{
+
+class TestCachedTransformer : public AssetTransformer
+{
+    URHO3D_OBJECT(TestCachedTransformer, AssetTransformer);
+
+public:
+    using AssetTransformer::AssetTransformer;
+
+    static void RegisterObject(Context* context)
+    {
+        context->AddFactoryReflection<TestCachedTransformer>();
+        URHO3D_ATTRIBUTE("Suffix", ea::string, suffix_, EMPTY_STRING, AM_DEFAULT);
+    }
+
+    bool IsApplicable(const AssetTransformerInput& input) override { return true; }
+    unsigned GetVersion() const override { return version_; }
+
+    bool Execute(const AssetTransformerInput& input, AssetTransformerOutput& output,
+        const AssetTransformerVector& transformers) override
+    {
+        ++numExecutions_;
+
+        const ea::string dataFolder = GetPath(input.inputFileName_);
+        const ea::string dependencyFileName = dataFolder + "Dependency.txt";
+        AddDependency(input, output, dependencyFileName);
+
+        File source(context_, input.inputFileName_);
+        File dependency(context_, dependencyFileName);
+        const ea::string result = source.ReadText() + suffix_ + dependency.ReadText();
+
+        auto fs = GetSubsystem<FileSystem>();
+        fs->CreateDirsRecursive(input.outputFileName_ + "/Nested/");
+
+        File dest(context_, input.outputFileName_ + "/Result.txt", FILE_WRITE);
+        File destNested(context_, input.outputFileName_ + "/Nested/Copy.txt", FILE_WRITE);
+        return dest.Write(result.data(), result.size()) == result.size()
+            && destNested.Write(result.data(), result.size()) == result.size();
+    }
+
+    ea::string suffix_;
+    unsigned version_{};
+    unsigned numExecutions_{};
+};
+
+/// Backend that returns entries with output file size bigger than the entry itself.
+class MalformedDerivedDataBackend : public DerivedDataBackend
+{
+public:
+    using DerivedDataBackend::DerivedDataBackend;
+
+    bool Load(const ea::string& key, ByteVector& data) override
+    {
+        VectorBuffer dest;
+        dest.WriteFileID("UDDC");
+        dest.WriteVLE(DerivedDataCache::FormatVersion);
+        dest.WriteString(key);
+        dest.WriteString("Models/Asset.txt");
+        dest.WriteVLE(0);
+        dest.WriteVLE(0);
+        dest.WriteVLE(1);
+        dest.WriteString("Result.txt");
+        dest.WriteVLE(0xfffffff0);
+        data = dest.GetBuffer();
+        return true;
+    }
+
+    bool Store(const ea::string& key, const ByteVector& data) override { return false; }
+};
+
+void WriteText(Context* context, const ea::string& fileName, const ea::string& text)
+{
+    File file(context, fileName, FILE_WRITE);
+    REQUIRE(file.Write(text.data(), text.size()) == text.size());
+}
+
+ea::string ReadText(Context* context, const ea::string& fileName)
+{
+    File file(context, fileName);
+    return file.ReadText();
+}
+
+}
+
+TEST_CASE("DerivedDataCache restores transformer outputs")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<Tests::RegisterObject<TestCachedTransformer>>(context);
+    auto fs = context->GetSubsystem<FileSystem>();
+
+    const ea::string rootPath = fs->GetTemporaryDir() + "DerivedDataCacheTest/";
+    fs->RemoveDir(rootPath, true);
+    const ea::string dataPath = rootPath + "Data/";
+    const ea::string outputPath = rootPath + "Cache/";
+    REQUIRE(fs->CreateDirsRecursive(dataPath + "Models/"));
+
+    const ea::string resourceName = "Models/Asset.txt";
+    WriteText(context, dataPath + resourceName, "Asset");
+    WriteText(context, dataPath + "Models/Dependency.txt", "Dependency");
+
+    auto transformer = MakeShared<TestCachedTransformer>(context);
+    transformer->suffix_ = "+";
+    const AssetTransformerVector transformers{transformer};
+
+    unsigned numTempPaths = 0;
+    const auto execute = [&](DerivedDataCache* cache)
+    {
+        fs->RemoveDir(outputPath, true);
+        fs->CreateDirsRecursive(outputPath);
+
+        const ea::string tempPath = Format("{}Temp/{}/", rootPath, numTempPaths++);
+        const ea::string outputResourceName = resourceName + ".d";
+        const AssetTransformerInput baseInput{false, ApplicationFlavor{}, resourceName, dataPath + resourceName,
+            fs->GetLastModifiedTime(dataPath + resourceName, true)};
+        const AssetTransformerInput input{baseInput, tempPath, tempPath + outputResourceName, outputResourceName};
+
+        AssetTransformerOutput output;
+        REQUIRE(AssetTransformer::ExecuteTransformersAndStore(input, outputPath, output, transformers, cache));
+        ea::sort(output.outputResourceNames_.begin(), output.outputResourceNames_.end());
+        return output;
+    };
+
+    // Reference output without cache
+    const AssetTransformerOutput expectedOutput = execute(nullptr);
+    REQUIRE(expectedOutput.outputResourceNames_.size() == 2);
+    REQUIRE(transformer->numExecutions_ == 1);
+
+    ea::vector<ea::string> expectedContent;
+    for (const ea::string& fileName : expectedOutput.outputResourceNames_)
+        expectedContent.push_back(ReadText(context, outputPath + fileName));
+    CHECK(expectedContent[0] == "Asset+Dependency");
+
+    const auto checkOutput = [&](const AssetTransformerOutput& output)
+    {
+        REQUIRE(output.outputResourceNames_ == expectedOutput.outputResourceNames_);
+        CHECK(output.appliedTransformers_ == expectedOutput.appliedTransformers_);
+        CHECK(output.dependencyModificationTimes_ == expectedOutput.dependencyModificationTimes_);
+        for (unsigned i = 0; i < output.outputResourceNames_.size(); ++i)
+            CHECK(ReadText(context, outputPath + output.outputResourceNames_[i]) == expectedContent[i]);
+    };
+
+    auto cache = MakeShared<DerivedDataCache>(context);
+    cache->SetLocalBackend(MakeShared<DirectoryDerivedDataBackend>(context, rootPath + "Local/"));
+
+    // Miss, then hit
+    checkOutput(execute(cache));
+    CHECK(transformer->numExecutions_ == 2);
+    CHECK(cache->GetNumMisses() == 1);
+
+    checkOutput(execute(cache));
+    CHECK(transformer->numExecutions_ == 2);
+    CHECK(cache->GetNumHits() == 1);
+
+    // Measure hit path
+    {
+        static constexpr unsigned numIterations = 20;
+        HiresTimer timer;
+        for (unsigned i = 0; i < numIterations; ++i)
+            execute(cache);
+        URHO3D_LOGINFO("DerivedDataCache hit takes {} us on average", timer.GetUSec(false) / numIterations);
+        CHECK(transformer->numExecutions_ == 2);
+        CHECK(cache->GetNumHits() == 1 + numIterations);
+    }
+
+    // Remote backend is used when local cache is empty
+    {
+        auto otherCache = MakeShared<DerivedDataCache>(context);
+        otherCache->SetLocalBackend(MakeShared<DirectoryDerivedDataBackend>(context, rootPath + "OtherLocal/"));
+        otherCache->SetRemoteBackend(MakeShared<DirectoryDerivedDataBackend>(context, rootPath + "Local/"));
+
+        checkOutput(execute(otherCache));
+        CHECK(transformer->numExecutions_ == 2);
+        CHECK(otherCache->GetNumRemoteHits() == 1);
+
+        otherCache->SetRemoteBackend(nullptr);
+        checkOutput(execute(otherCache));
+        CHECK(otherCache->GetNumHits() == 2);
+        CHECK(otherCache->GetNumRemoteHits() == 1);
+    }
+
+    // Changed attributes and dependencies invalidate the entry
+    transformer->suffix_ = "-";
+    execute(cache);
+    CHECK(transformer->numExecutions_ == 3);
+    CHECK(ReadText(context, outputPath + expectedOutput.outputResourceNames_[0]) == "Asset-Dependency");
+
+    WriteText(context, dataPath + "Models/Dependency.txt", "Changed");
+    execute(cache);
+    CHECK(transformer->numExecutions_ == 4);
+    CHECK(ReadText(context, outputPath + expectedOutput.outputResourceNames_[0]) == "Asset-Changed");
+
+    execute(cache);
+    CHECK(transformer->numExecutions_ == 4);
+
+    // Changed transformer version invalidates the entry
+    transformer->version_ = 1;
+    execute(cache);
+    CHECK(transformer->numExecutions_ == 5);
+
+    execute(cache);
+    CHECK(transformer->numExecutions_ == 5);
+
+    // Malformed remote entry is rejected before allocating its content
+    {
+        auto otherCache = MakeShared<DerivedDataCache>(context);
+        otherCache->SetRemoteBackend(MakeShared<MalformedDerivedDataBackend>(context));
+
+        execute(otherCache);
+        CHECK(transformer->numExecutions_ == 6);
+        CHECK(otherCache->GetNumMisses() == 1);
+        CHECK(otherCache->GetNumHits() == 0);
+    }
+
+    fs->RemoveDir(rootPath, true);
+}
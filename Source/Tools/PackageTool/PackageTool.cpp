@@ -24,41 +24,36 @@
 
 #include <Urho3D/Core/Context.h>
 #include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/IO/File.h>
 #include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/PackageBuilder.h>
 #include <Urho3D/IO/PackageFile.h>
 
 #ifdef WIN32
 #include <windows.h>
 #endif
 
-#include <EASTL/unique_ptr.h>
-#include <LZ4/lz4.h>
-#include <LZ4/lz4hc.h>
-
 #include <Urho3D/DebugNew.h>
 
 
 using namespace Urho3D;
 
-static const unsigned COMPRESSED_BLOCK_SIZE = 32768;
-
 struct FileEntry
 {
     ea::string name_;
-    unsigned offset_{};
     unsigned size_{};
-    unsigned checksum_{};
 };
 
 Context* context_ = nullptr;
 FileSystem* fileSystem_ = nullptr;
 ea::string basePath_;
 ea::vector<FileEntry> entries_;
-unsigned checksum_ = 0;
-bool compress_ = false;
+PackageCompression compression_ = PackageCompression::None;
+unsigned numThreads_ = 0;
+bool incremental_ = false;
 bool quiet_ = false;
-unsigned blockSize_ = COMPRESSED_BLOCK_SIZE;
 
 ea::string ignoreExtensions_[] = {
     ".bak",
@@ -69,7 +64,6 @@ int main(int argc, char** argv);
 void Run(const ea::vector<ea::string>& arguments);
 void ProcessFile(const ea::string& fileName, const ea::string& rootDir);
 void WritePackageFile(const ea::string& fileName, const ea::string& rootDir);
-void WriteHeader(File& dest);
 
 int main(int argc, char** argv)
 {
@@ -97,6 +91,9 @@ void Run(const ea::vector<ea::string>& arguments)
             "\n"
             "Options:\n"
             "-c      Enable package file LZ4 compression\n"
+            "-z      Enable package file ZSTD compression\n"
+            "-j<N>   Compress files using N threads, all logical CPUs are used by default\n"
+            "-u      Reuse unchanged compressed files from the existing package\n"
             "-q      Enable quiet mode\n"
             "\n"
             "Basepath is an optional prefix that will be added to the file entries.\n\n"
@@ -123,7 +120,18 @@ void Run(const ea::vector<ea::string>& arguments)
                     switch (arguments[i][1])
                     {
                     case 'c':
-                        compress_ = true;
+                        compression_ = PackageCompression::LZ4;
+                        break;
+                    case 'z':
+                        compression_ = PackageCompression::ZSTD;
+                        break;
+                    case 'j':
+                        numThreads_ = ToUInt(arguments[i].substr(2));
+                        if (!numThreads_)
+                            ErrorExit("Invalid number of threads");
+                        break;
+                    case 'u':
+                        incremental_ = true;
                         break;
                     case 'q':
                         quiet_ = true;
@@ -206,6 +214,7 @@ void Run(const ea::vector<ea::string>& arguments)
             PrintLine("Package size: " + ea::to_string(packageFile->GetTotalSize()));
             PrintLine("Checksum: " + ea::to_string(packageFile->GetChecksum()));
             PrintLine("Compressed: " + ea::string(packageFile->IsCompressed() ? "yes" : "no"));
+            PrintLine("Version: " + ea::to_string(packageFile->GetVersion()));
             break;
         case 'L':
             if (!packageFile->IsCompressed())
@@ -215,17 +224,13 @@ void Run(const ea::vector<ea::string>& arguments)
         case 'l':
             {
                 const ea::unordered_map<ea::string, PackageEntry>& entries = packageFile->GetEntries();
-                for (auto i = entries.begin(); i != entries.end();)
+                for (const auto& [name, entry] : entries)
                 {
-                    auto current = i++;
-                    ea::string fileEntry(current->first);
+                    ea::string fileEntry(name);
                     if (outputCompressionRatio)
                     {
-                        unsigned compressedSize =
-                            (i == entries.end() ? packageFile->GetTotalSize() - sizeof(unsigned) : i->second.offset_) -
-                            current->second.offset_;
-                        fileEntry.append_sprintf("\tin: %u\tout: %u\tratio: %f", current->second.size_, compressedSize,
-                            compressedSize ? 1.f * current->second.size_ / compressedSize : 0.f);
+                        fileEntry.append_sprintf("\tin: %u\tout: %llu\tratio: %f", entry.size_, entry.packedSize_,
+                            entry.packedSize_ ? 1.f * entry.size_ / entry.packedSize_ : 0.f);
                     }
                     PrintLine(fileEntry);
                 }
@@ -246,9 +251,7 @@ void ProcessFile(const ea::string& fileName, const ea::string& rootDir)
 
     FileEntry newEntry;
     newEntry.name_ = fileName;
-    newEntry.offset_ = 0; // Offset not yet known
     newEntry.size_ = file.GetSize();
-    newEntry.checksum_ = 0; // Will be calculated later
     entries_.push_back(newEntry);
 }
 
@@ -257,121 +260,64 @@ void WritePackageFile(const ea::string& fileName, const ea::string& rootDir)
     if (!quiet_)
         PrintLine("Writing package");
 
-    File dest(context_);
-    if (!dest.Open(fileName, FILE_WRITE))
-        ErrorExit("Could not open output file " + fileName);
-
-    // Write ID, number of files & placeholder for checksum
-    WriteHeader(dest);
+    auto workQueue = MakeShared<WorkQueue>(context_);
+    workQueue->Initialize((numThreads_ ? numThreads_ : GetNumLogicalCPUs()) - 1);
+    context_->RegisterSubsystem(workQueue);
 
-    for (unsigned i = 0; i < entries_.size(); ++i)
-    {
-        // Write entry (correct offset is still unknown, will be filled in later)
-        dest.WriteString(basePath_ + entries_[i].name_);
-        dest.WriteUInt(entries_[i].offset_);
-        dest.WriteUInt(entries_[i].size_);
-        dest.WriteUInt(entries_[i].checksum_);
-    }
+    // Package is written to temporary file if the existing one is used as a source of compressed data
+    const ea::string manifestName = fileName + ".manifest";
+    const bool reusePackage = incremental_ && fileSystem_->FileExists(fileName) && fileSystem_->FileExists(manifestName);
+    const ea::string outputName = reusePackage ? fileName + ".tmp" : fileName;
 
-    unsigned totalDataSize = 0;
-    unsigned lastOffset;
+    PackageBuilder builder(context_);
+    if (!builder.Create(outputName))
+        ErrorExit("Could not open output file " + outputName);
+    if (reusePackage && !builder.SetPreviousPackage(fileName, manifestName))
+        PrintLine("Could not load previous package " + fileName + ", rebuilding all files", true);
 
-    // Write file data, calculate checksums & correct offsets
-    for (unsigned i = 0; i < entries_.size(); ++i)
+    for (const FileEntry& entry : entries_)
     {
-        lastOffset = entries_[i].offset_ = dest.GetSize();
-        ea::string fileFullPath = rootDir + "/" + entries_[i].name_;
+        ea::string fileFullPath = rootDir + "/" + entry.name_;
 
         File srcFile(context_, fileFullPath);
         if (!srcFile.IsOpen())
             ErrorExit("Could not open file " + fileFullPath);
 
-        unsigned dataSize = entries_[i].size_;
-        totalDataSize += dataSize;
-        ea::unique_ptr<unsigned char[]> buffer(new unsigned char[dataSize]);
+        if (!builder.Append(basePath_ + entry.name_, srcFile, compression_))
+            ErrorExit("Could not write file " + fileFullPath);
 
-        if (srcFile.Read(&buffer[0], dataSize) != dataSize)
-            ErrorExit("Could not read file " + fileFullPath);
-        srcFile.Close();
-
-        for (unsigned j = 0; j < dataSize; ++j)
-        {
-            checksum_ = SDBMHash(checksum_, buffer[j]);
-            entries_[i].checksum_ = SDBMHash(entries_[i].checksum_, buffer[j]);
-        }
-
-        if (!compress_)
+        if (!quiet_)
         {
-            if (!quiet_)
-                PrintLine(entries_[i].name_ + " size " + ea::to_string(dataSize));
-            dest.Write(&buffer[0], entries_[i].size_);
-        }
-        else
-        {
-            ea::unique_ptr<unsigned char[]> compressBuffer(new unsigned char[LZ4_compressBound(blockSize_)]);
-
-            unsigned pos = 0;
-
-            while (pos < dataSize)
-            {
-                unsigned unpackedSize = blockSize_;
-                if (pos + unpackedSize > dataSize)
-                    unpackedSize = dataSize - pos;
-
-                auto packedSize = (unsigned)LZ4_compress_HC((const char*)&buffer[pos], (char*)compressBuffer.get(), unpackedSize, LZ4_compressBound(unpackedSize), 0);
-                if (!packedSize)
-                    ErrorExit("LZ4 compression failed for file " + entries_[i].name_ + " at offset " + ea::to_string(pos));
-
-                dest.WriteUShort((unsigned short)unpackedSize);
-                dest.WriteUShort((unsigned short)packedSize);
-                dest.Write(compressBuffer.get(), packedSize);
-
-                pos += unpackedSize;
-            }
-
-            if (!quiet_)
-            {
-                unsigned totalPackedBytes = dest.GetSize() - lastOffset;
-                ea::string fileEntry(entries_[i].name_);
-                fileEntry.append_sprintf("\tin: %u\tout: %u\tratio: %f", dataSize, totalPackedBytes,
-                    totalPackedBytes ? 1.f * dataSize / totalPackedBytes : 0.f);
-                PrintLine(fileEntry);
-            }
+            const PackageEntry& packageEntry = builder.GetEntries().back().second;
+            ea::string fileEntry(entry.name_);
+            fileEntry.append_sprintf("\tin: %u\tout: %llu\tratio: %f", packageEntry.size_, packageEntry.packedSize_,
+                packageEntry.packedSize_ ? 1.f * packageEntry.size_ / packageEntry.packedSize_ : 0.f);
+            PrintLine(fileEntry);
         }
     }
 
-    // Write package size to the end of file to allow finding it linked to an executable file
-    unsigned currentSize = dest.GetSize();
-    dest.WriteUInt(currentSize + sizeof(unsigned));
-
-    // Write header again with correct offsets & checksums
-    dest.Seek(0);
-    WriteHeader(dest);
+    if (!builder.Build())
+        ErrorExit("Could not write package " + outputName);
 
-    for (unsigned i = 0; i < entries_.size(); ++i)
+    if (reusePackage)
     {
-        dest.WriteString(basePath_ + entries_[i].name_);
-        dest.WriteUInt(entries_[i].offset_);
-        dest.WriteUInt(entries_[i].size_);
-        dest.WriteUInt(entries_[i].checksum_);
+        builder.SetPreviousPackage(EMPTY_STRING, EMPTY_STRING);
+        if (!fileSystem_->Delete(fileName) || !fileSystem_->Rename(outputName, fileName))
+            ErrorExit("Could not replace package " + fileName);
     }
 
+    File manifestFile(context_, manifestName, FILE_WRITE);
+    if (!manifestFile.IsOpen() || !builder.GetManifest().Save(manifestFile))
+        ErrorExit("Could not write package manifest " + manifestName);
+
     if (!quiet_)
     {
         PrintLine("Number of files: " + ea::to_string(entries_.size()));
-        PrintLine("File data size: " + ea::to_string(totalDataSize));
-        PrintLine("Package size: " + ea::to_string(dest.GetSize()));
-        PrintLine("Checksum: " + ea::to_string(checksum_));
-        PrintLine("Compressed: " + ea::string(compress_ ? "yes" : "no"));
+        PrintLine("File data size: " + ea::to_string(builder.GetTotalDataSize()));
+        PrintLine("Package size: " + ea::to_string(builder.GetTotalSize()));
+        PrintLine("Checksum: " + ea::to_string(builder.GetChecksum()));
+        PrintLine("Compressed: " + ea::string(compression_ != PackageCompression::None ? "yes" : "no"));
+        PrintLine("Deduplicated files: " + ea::to_string(builder.GetNumDeduplicatedFiles()));
+        PrintLine("Reused files: " + ea::to_string(builder.GetNumReusedFiles()));
     }
 }
-
-void WriteHeader(File& dest)
-{
-    if (!compress_)
-        dest.WriteFileID("UPAK");
-    else
-        dest.WriteFileID("ULZ4");
-    dest.WriteUInt(entries_.size());
-    dest.WriteUInt(checksum_);
-}
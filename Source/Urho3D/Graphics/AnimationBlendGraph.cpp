@@ -0,0 +1,727 @@
+// Copyright (c) 2024-2025 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Graphics/AnimationBlendGraph.h"
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/Graphics/Animation.h"
+#include "Urho3D/Graphics/Skeleton.h"
+#include "Urho3D/IO/ArchiveSerialization.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/Resource/ResourceCache.h"
+#include "Urho3D/Scene/Node.h"
+
+#include <EASTL/sort.h>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const BinaryMagic AnimationBlendGraphBinaryMagic{{'\0', 'A', 'B', 'G'}};
+
+const char* animationBlendNodeTypeNames[] = {
+    "Clip",
+    "BlendSpace1D",
+    "BlendSpace2D",
+    "Additive",
+    "MaskedLayer",
+    "Crossfade",
+    nullptr
+};
+
+/// Helper class that compiles node tree into instruction streams.
+class AnimationBlendGraphCompiler
+{
+public:
+    AnimationBlendGraphCompiler(
+        const ea::vector<AnimationBlendNode>& nodes, ResourceCache* cache, AnimationBlendProgram& program)
+        : nodes_(nodes)
+        , cache_(cache)
+        , program_(program)
+        , nodeClips_(nodes.size(), M_MAX_UNSIGNED)
+    {
+    }
+
+    /// Compile node and return index of register with the result, or M_MAX_UNSIGNED on error.
+    unsigned CompileNode(unsigned nodeIndex)
+    {
+        if (nodeIndex >= nodes_.size())
+        {
+            URHO3D_LOGERROR("Animation blend graph references invalid node #{}", nodeIndex);
+            return M_MAX_UNSIGNED;
+        }
+
+        // Any path longer than the number of nodes is a cycle
+        if (depth_ > nodes_.size())
+        {
+            URHO3D_LOGERROR("Animation blend graph contains a cycle");
+            return M_MAX_UNSIGNED;
+        }
+
+        ++depth_;
+        const unsigned result = CompileNodeUnchecked(nodes_[nodeIndex], nodeIndex);
+        --depth_;
+        return result;
+    }
+
+private:
+    unsigned CompileNodeUnchecked(const AnimationBlendNode& node, unsigned nodeIndex)
+    {
+        switch (node.type_)
+        {
+        case AnimationBlendNodeType::Clip:
+        {
+            const unsigned clipIndex = GetClip(nodeIndex);
+            if (clipIndex == M_MAX_UNSIGNED)
+                return M_MAX_UNSIGNED;
+
+            const unsigned target = AllocateRegister();
+            Emit(AnimationBlendOpcode::SampleClip, target, 0, 0, 0, clipIndex);
+            return target;
+        }
+
+        case AnimationBlendNodeType::BlendSpace1D:
+        case AnimationBlendNodeType::BlendSpace2D:
+            return CompileBlendSpace(node, node.type_ == AnimationBlendNodeType::BlendSpace2D);
+
+        case AnimationBlendNodeType::Additive:
+        {
+            if (!CheckInputs(node, nodeIndex, 2))
+                return M_MAX_UNSIGNED;
+
+            const unsigned additiveNode = node.inputs_[1];
+            if (additiveNode >= nodes_.size() || nodes_[additiveNode].type_ != AnimationBlendNodeType::Clip)
+            {
+                URHO3D_LOGERROR("Additive input of animation blend graph node #{} should be a clip", nodeIndex);
+                return M_MAX_UNSIGNED;
+            }
+
+            const unsigned base = CompileNode(node.inputs_[0]);
+            const unsigned clipIndex = base != M_MAX_UNSIGNED ? GetClip(additiveNode) : M_MAX_UNSIGNED;
+            if (clipIndex == M_MAX_UNSIGNED)
+                return M_MAX_UNSIGNED;
+
+            const unsigned weight = AddParameterWeight(node.parameter_);
+            const unsigned delta = AllocateRegister();
+            Emit(AnimationBlendOpcode::SampleAdditiveClip, delta, 0, 0, 0, clipIndex);
+            Emit(AnimationBlendOpcode::ApplyAdditive, base, base, delta, weight);
+            FreeRegister(delta);
+            return base;
+        }
+
+        case AnimationBlendNodeType::MaskedLayer:
+        {
+            if (!CheckInputs(node, nodeIndex, 2))
+                return M_MAX_UNSIGNED;
+
+            const unsigned base = CompileNode(node.inputs_[0]);
+            const unsigned layer = base != M_MAX_UNSIGNED ? CompileNode(node.inputs_[1]) : M_MAX_UNSIGNED;
+            if (layer == M_MAX_UNSIGNED)
+                return M_MAX_UNSIGNED;
+
+            const unsigned weight = AddParameterWeight(node.parameter_);
+            const unsigned maskIndex = program_.masks_.size();
+            program_.masks_.push_back(node.maskBone_);
+            Emit(AnimationBlendOpcode::BlendMasked, base, base, layer, weight, maskIndex);
+            FreeRegister(layer);
+            return base;
+        }
+
+        case AnimationBlendNodeType::Crossfade:
+        {
+            if (!CheckInputs(node, nodeIndex, 2))
+                return M_MAX_UNSIGNED;
+
+            const unsigned from = CompileNode(node.inputs_[0]);
+            const unsigned to = from != M_MAX_UNSIGNED ? CompileNode(node.inputs_[1]) : M_MAX_UNSIGNED;
+            if (to == M_MAX_UNSIGNED)
+                return M_MAX_UNSIGNED;
+
+            AnimationBlendWeightInstruction instruction;
+            instruction.opcode_ = AnimationBlendWeightOpcode::Crossfade;
+            instruction.target_ = AddWeight(0.0f);
+            instruction.parameterX_ = GetParameter(node.parameter_);
+            instruction.rate_ = node.duration_ > M_EPSILON ? 1.0f / node.duration_ : M_LARGE_VALUE;
+            program_.weightInstructions_.push_back(instruction);
+
+            Emit(AnimationBlendOpcode::Blend, from, from, to, instruction.target_);
+            FreeRegister(to);
+            return from;
+        }
+
+        default:
+            URHO3D_LOGERROR("Animation blend graph node #{} has unknown type", nodeIndex);
+            return M_MAX_UNSIGNED;
+        }
+    }
+
+    unsigned CompileBlendSpace(const AnimationBlendNode& node, bool is2D)
+    {
+        const unsigned numInputs = node.inputs_.size();
+        if (numInputs == 0 || node.positions_.size() != numInputs)
+        {
+            URHO3D_LOGERROR("Animation blend space should have one position per input");
+            return M_MAX_UNSIGNED;
+        }
+
+        // 1D blend space expects inputs sorted by position
+        ea::vector<ea::pair<Vector2, unsigned>> inputs;
+        for (unsigned i = 0; i < numInputs; ++i)
+            inputs.emplace_back(node.positions_[i], node.inputs_[i]);
+        if (!is2D)
+        {
+            ea::stable_sort(inputs.begin(), inputs.end(),
+                [](const auto& lhs, const auto& rhs) { return lhs.first.x_ < rhs.first.x_; });
+        }
+
+        AnimationBlendWeightInstruction instruction;
+        instruction.opcode_ = is2D ? AnimationBlendWeightOpcode::BlendSpace2D : AnimationBlendWeightOpcode::BlendSpace1D;
+        instruction.target_ = program_.initialWeights_.size();
+        instruction.count_ = numInputs;
+        instruction.parameterX_ = GetParameter(node.parameter_);
+        instruction.parameterY_ = is2D ? GetParameter(node.parameterY_) : instruction.parameterX_;
+        instruction.firstPosition_ = program_.positions_.size();
+        for (const auto& [position, _] : inputs)
+        {
+            AddWeight(0.0f);
+            program_.positions_.push_back(position);
+        }
+        program_.weightInstructions_.push_back(instruction);
+
+        // Inputs are accumulated as soon as they are evaluated to keep number of live registers low
+        const unsigned target = AllocateRegister();
+        for (unsigned i = 0; i < numInputs; ++i)
+        {
+            const unsigned input = CompileNode(inputs[i].second);
+            if (input == M_MAX_UNSIGNED)
+                return M_MAX_UNSIGNED;
+
+            const auto opcode = i == 0 ? AnimationBlendOpcode::AccumulateFirst : AnimationBlendOpcode::Accumulate;
+            Emit(opcode, target, input, 0, instruction.target_ + i);
+            FreeRegister(input);
+        }
+        Emit(AnimationBlendOpcode::Normalize, target, target, 0, 0);
+        return target;
+    }
+
+    bool CheckInputs(const AnimationBlendNode& node, unsigned nodeIndex, unsigned numInputs) const
+    {
+        if (node.inputs_.size() != numInputs)
+        {
+            URHO3D_LOGERROR("Animation blend graph node #{} should have {} inputs", nodeIndex, numInputs);
+            return false;
+        }
+        return true;
+    }
+
+    unsigned GetClip(unsigned nodeIndex)
+    {
+        // Nodes referenced several times share playback time
+        if (nodeClips_[nodeIndex] != M_MAX_UNSIGNED)
+            return nodeClips_[nodeIndex];
+
+        const AnimationBlendNode& node = nodes_[nodeIndex];
+        auto animation = cache_->GetResource<Animation>(node.animation_);
+        if (!animation)
+        {
+            URHO3D_LOGERROR("Cannot load animation '{}' for animation blend graph", node.animation_);
+            return M_MAX_UNSIGNED;
+        }
+
+        nodeClips_[nodeIndex] = program_.clips_.size();
+        program_.clips_.push_back(AnimationBlendClip{SharedPtr<Animation>(animation), node.speed_, node.looped_});
+        return nodeClips_[nodeIndex];
+    }
+
+    unsigned GetParameter(const ea::string& name)
+    {
+        const auto iter = ea::find(program_.parameters_.begin(), program_.parameters_.end(), name);
+        if (iter != program_.parameters_.end())
+            return static_cast<unsigned>(iter - program_.parameters_.begin());
+
+        program_.parameters_.push_back(name);
+        return program_.parameters_.size() - 1;
+    }
+
+    unsigned AddWeight(float initialValue)
+    {
+        program_.initialWeights_.push_back(initialValue);
+        return program_.initialWeights_.size() - 1;
+    }
+
+    unsigned AddParameterWeight(const ea::string& name)
+    {
+        // Weights without parameter are constant and never updated
+        const unsigned weight = AddWeight(1.0f);
+        if (!name.empty())
+        {
+            AnimationBlendWeightInstruction instruction;
+            instruction.opcode_ = AnimationBlendWeightOpcode::Parameter;
+            instruction.target_ = weight;
+            instruction.parameterX_ = GetParameter(name);
+            program_.weightInstructions_.push_back(instruction);
+        }
+        return weight;
+    }
+
+    unsigned AllocateRegister()
+    {
+        if (!freeRegisters_.empty())
+        {
+            const unsigned index = freeRegisters_.back();
+            freeRegisters_.pop_back();
+            return index;
+        }
+        return program_.numRegisters_++;
+    }
+
+    void FreeRegister(unsigned index) { freeRegisters_.push_back(index); }
+
+    void Emit(AnimationBlendOpcode opcode, unsigned target, unsigned lhs, unsigned rhs, unsigned weight,
+        unsigned index = 0)
+    {
+        program_.instructions_.push_back(AnimationBlendInstruction{opcode, target, lhs, rhs, weight, index});
+    }
+
+    const ea::vector<AnimationBlendNode>& nodes_;
+    ResourceCache* cache_{};
+    AnimationBlendProgram& program_;
+
+    ea::vector<unsigned> nodeClips_;
+    ea::vector<unsigned> freeRegisters_;
+    unsigned depth_{};
+};
+
+/// Return whether the bone is the root bone or its descendant.
+bool IsBoneInHierarchy(const ea::vector<Bone>& bones, unsigned boneIndex, unsigned rootIndex)
+{
+    for (unsigned i = 0; i < bones.size() && boneIndex < bones.size(); ++i)
+    {
+        if (boneIndex == rootIndex)
+            return true;
+
+        const unsigned parentIndex = bones[boneIndex].parentIndex_;
+        if (parentIndex == boneIndex)
+            break;
+        boneIndex = parentIndex;
+    }
+    return false;
+}
+
+}
+
+void AnimationBlendNode::SerializeInBlock(Archive& archive)
+{
+    SerializeEnum(archive, "type", type_, animationBlendNodeTypeNames);
+    SerializeOptionalValue(archive, "inputs", inputs_);
+    SerializeOptionalValue(archive, "animation", animation_);
+    SerializeOptionalValue(archive, "speed", speed_, 1.0f);
+    SerializeOptionalValue(archive, "looped", looped_, true);
+    SerializeOptionalValue(archive, "parameter", parameter_);
+    SerializeOptionalValue(archive, "parameterY", parameterY_);
+    SerializeOptionalValue(archive, "positions", positions_);
+    SerializeOptionalValue(archive, "maskBone", maskBone_);
+    SerializeOptionalValue(archive, "duration", duration_);
+}
+
+AnimationBlendGraph::AnimationBlendGraph(Context* context)
+    : SimpleResource(context)
+{
+}
+
+AnimationBlendGraph::~AnimationBlendGraph() = default;
+
+void AnimationBlendGraph::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<AnimationBlendGraph>();
+}
+
+unsigned AnimationBlendGraph::AddNode(const AnimationBlendNode& node)
+{
+    nodes_.push_back(node);
+    program_ = nullptr;
+    compiled_ = false;
+    return nodes_.size() - 1;
+}
+
+void AnimationBlendGraph::SetRootNode(unsigned index)
+{
+    rootNode_ = index;
+    program_ = nullptr;
+    compiled_ = false;
+}
+
+void AnimationBlendGraph::Clear()
+{
+    nodes_.clear();
+    rootNode_ = 0;
+    program_ = nullptr;
+    compiled_ = false;
+}
+
+AnimationBlendProgram* AnimationBlendGraph::GetProgram()
+{
+    if (!compiled_)
+    {
+        program_ = Compile();
+        compiled_ = true;
+    }
+    return program_;
+}
+
+SharedPtr<AnimationBlendProgram> AnimationBlendGraph::Compile() const
+{
+    auto program = MakeShared<AnimationBlendProgram>();
+    AnimationBlendGraphCompiler compiler(nodes_, GetSubsystem<ResourceCache>(), *program);
+
+    program->resultRegister_ = compiler.CompileNode(rootNode_);
+    if (program->resultRegister_ == M_MAX_UNSIGNED)
+    {
+        URHO3D_LOGERROR("Cannot compile animation blend graph '{}'", GetName());
+        return nullptr;
+    }
+    return program;
+}
+
+void AnimationBlendGraph::SerializeInBlock(Archive& archive)
+{
+    if (archive.IsInput())
+    {
+        program_ = nullptr;
+        compiled_ = false;
+    }
+
+    SerializeVector(archive, "nodes", nodes_, "node");
+    SerializeValue(archive, "rootNode", rootNode_);
+}
+
+BinaryMagic AnimationBlendGraph::GetBinaryMagic() const
+{
+    return AnimationBlendGraphBinaryMagic;
+}
+
+AnimationBlendGraphInstance::AnimationBlendGraphInstance(AnimationBlendGraph* graph, const Skeleton& skeleton)
+    : program_(graph ? graph->GetProgram() : nullptr)
+    , numBones_(skeleton.GetNumBones())
+{
+    if (!program_)
+        return;
+
+    const ea::vector<Bone>& bones = skeleton.GetBones();
+    bindPose_.resize(numBones_);
+    for (unsigned i = 0; i < numBones_; ++i)
+        bindPose_[i] = Transform{bones[i].initialPosition_, bones[i].initialRotation_, bones[i].initialScale_};
+
+    poses_.resize(program_->numRegisters_ * numBones_);
+
+    masks_.resize(program_->masks_.size() * numBones_);
+    for (unsigned maskIndex = 0; maskIndex < program_->masks_.size(); ++maskIndex)
+    {
+        const unsigned rootIndex = skeleton.GetBoneIndex(program_->masks_[maskIndex]);
+        if (rootIndex == M_MAX_UNSIGNED)
+            URHO3D_LOGWARNING("Mask bone '{}' is not found in skeleton", program_->masks_[maskIndex]);
+
+        for (unsigned i = 0; i < numBones_; ++i)
+            masks_[maskIndex * numBones_ + i] = IsBoneInHierarchy(bones, i, rootIndex) ? 1.0f : 0.0f;
+    }
+
+    const unsigned numClips = program_->clips_.size();
+    for (const AnimationBlendClip& clip : program_->clips_)
+    {
+        clipTracks_.push_back(trackBindings_.size());
+        clipLengths_.push_back(clip.animation_->GetLength());
+        for (unsigned i = 0; i < numBones_; ++i)
+        {
+            const AnimationTrack* track = clip.animation_->GetTrack(bones[i].nameHash_);
+            if (!track || track->keyFrames_.empty())
+                continue;
+
+            const AnimationKeyFrame& firstKeyFrame = track->keyFrames_.front();
+            trackBindings_.push_back(TrackBinding{i, track});
+            additiveBase_.push_back(Transform{firstKeyFrame.position_, firstKeyFrame.rotation_, firstKeyFrame.scale_});
+        }
+    }
+    clipTracks_.push_back(trackBindings_.size());
+    keyFrameHints_.resize(trackBindings_.size());
+    clipTimes_.resize(numClips);
+
+    parameters_.resize(program_->parameters_.size());
+    weights_ = program_->initialWeights_;
+}
+
+AnimationBlendGraphInstance::~AnimationBlendGraphInstance() = default;
+
+unsigned AnimationBlendGraphInstance::GetParameterIndex(const ea::string& name) const
+{
+    if (!program_)
+        return M_MAX_UNSIGNED;
+
+    const auto& names = program_->parameters_;
+    const auto iter = ea::find(names.begin(), names.end(), name);
+    return iter != names.end() ? static_cast<unsigned>(iter - names.begin()) : M_MAX_UNSIGNED;
+}
+
+void AnimationBlendGraphInstance::SetParameter(const ea::string& name, float value)
+{
+    const unsigned index = GetParameterIndex(name);
+    if (index != M_MAX_UNSIGNED)
+        parameters_[index] = value;
+}
+
+void AnimationBlendGraphInstance::Update(float timeStep)
+{
+    if (!program_ || numBones_ == 0)
+        return;
+
+    EvaluateWeights(timeStep);
+    AdvanceClips(timeStep);
+    EvaluatePoses();
+}
+
+ea::span<const Transform> AnimationBlendGraphInstance::GetPose() const
+{
+    if (!program_ || numBones_ == 0)
+        return {};
+    return {&poses_[program_->resultRegister_ * numBones_], numBones_};
+}
+
+void AnimationBlendGraphInstance::ApplyToSkeleton(Skeleton& skeleton) const
+{
+    const ea::span<const Transform> pose = GetPose();
+    if (pose.size() != skeleton.GetNumBones())
+        return;
+
+    for (unsigned i = 0; i < pose.size(); ++i)
+    {
+        const Transform& transform = pose[i];
+        if (Node* node = skeleton.GetBone(i)->node_)
+            node->SetTransformSilent(transform.position_, transform.rotation_, transform.scale_);
+    }
+
+    // Transforms are applied silently to avoid repeated marking dirty
+    Bone* rootBone = skeleton.GetRootBone();
+    if (rootBone && rootBone->node_)
+        rootBone->node_->MarkDirty();
+}
+
+void AnimationBlendGraphInstance::EvaluateWeights(float timeStep)
+{
+    const float* parameters = parameters_.data();
+    const Vector2* positions = program_->positions_.data();
+    float* weights = weights_.data();
+
+    for (const AnimationBlendWeightInstruction& instruction : program_->weightInstructions_)
+    {
+        float* target = weights + instruction.target_;
+        const Vector2* points = positions + instruction.firstPosition_;
+        const unsigned count = instruction.count_;
+
+        switch (instruction.opcode_)
+        {
+        case AnimationBlendWeightOpcode::Parameter:
+        {
+            *target = Clamp(parameters[instruction.parameterX_], 0.0f, 1.0f);
+            break;
+        }
+
+        case AnimationBlendWeightOpcode::BlendSpace1D:
+        {
+            const float x = Clamp(parameters[instruction.parameterX_], points[0].x_, points[count - 1].x_);
+            unsigned segment = 0;
+            while (segment + 2 < count && x >= points[segment + 1].x_)
+                ++segment;
+
+            ea::fill_n(target, count, 0.0f);
+            if (count == 1)
+            {
+                target[0] = 1.0f;
+                break;
+            }
+
+            const float width = points[segment + 1].x_ - points[segment].x_;
+            const float factor = width > M_EPSILON ? (x - points[segment].x_) / width : 1.0f;
+            target[segment] = 1.0f - factor;
+            target[segment + 1] = factor;
+            break;
+        }
+
+        case AnimationBlendWeightOpcode::BlendSpace2D:
+        {
+            // Gradient band interpolation
+            const Vector2 point{parameters[instruction.parameterX_], parameters[instruction.parameterY_]};
+            float totalWeight = 0.0f;
+            for (unsigned i = 0; i < count; ++i)
+            {
+                const Vector2 offset = point - points[i];
+                float weight = 1.0f;
+                for (unsigned j = 0; j < count; ++j)
+                {
+                    const Vector2 edge = points[j] - points[i];
+                    const float lengthSquared = edge.LengthSquared();
+                    if (i != j && lengthSquared > M_EPSILON)
+                        weight = Min(weight, 1.0f - offset.DotProduct(edge) / lengthSquared);
+                }
+                target[i] = Max(weight, 0.0f);
+                totalWeight += target[i];
+            }
+
+            if (totalWeight > M_EPSILON)
+            {
+                const float scale = 1.0f / totalWeight;
+                for (unsigned i = 0; i < count; ++i)
+                    target[i] *= scale;
+            }
+            else
+                target[0] = 1.0f;
+            break;
+        }
+
+        case AnimationBlendWeightOpcode::Crossfade:
+        {
+            const float goal = parameters[instruction.parameterX_] > 0.5f ? 1.0f : 0.0f;
+            const float maxDelta = instruction.rate_ * timeStep;
+            *target += Clamp(goal - *target, -maxDelta, maxDelta);
+            break;
+        }
+        }
+    }
+}
+
+void AnimationBlendGraphInstance::AdvanceClips(float timeStep)
+{
+    const unsigned numClips = clipTimes_.size();
+    for (unsigned i = 0; i < numClips; ++i)
+    {
+        const AnimationBlendClip& clip = program_->clips_[i];
+        const float length = clipLengths_[i];
+        float time = clipTimes_[i] + timeStep * clip.speed_;
+        if (clip.looped_ && length > 0.0f)
+            time -= Floor(time / length) * length;
+        clipTimes_[i] = Clamp(time, 0.0f, length);
+    }
+}
+
+void AnimationBlendGraphInstance::SampleClip(Transform* pose, unsigned clipIndex, bool additive)
+{
+    const AnimationBlendClip& clip = program_->clips_[clipIndex];
+    const float time = clipTimes_[clipIndex];
+    const float length = clipLengths_[clipIndex];
+
+    // Bones without tracks keep bind pose, or zero delta for additive clips
+    if (additive)
+        ea::fill_n(pose, numBones_, Transform::Identity);
+    else
+        ea::copy(bindPose_.begin(), bindPose_.end(), pose);
+
+    const unsigned begin = clipTracks_[clipIndex];
+    const unsigned end = clipTracks_[clipIndex + 1];
+    for (unsigned i = begin; i < end; ++i)
+    {
+        const TrackBinding& binding = trackBindings_[i];
+        Transform& transform = pose[binding.bone_];
+        if (!additive)
+        {
+            binding.track_->Sample(time, length, clip.looped_, keyFrameHints_[i], transform);
+            continue;
+        }
+
+        // Channels missing in the track produce zero delta
+        const Transform& base = additiveBase_[i];
+        transform = base;
+        binding.track_->Sample(time, length, clip.looped_, keyFrameHints_[i], transform);
+        transform.position_ -= base.position_;
+        transform.rotation_ = base.rotation_.Inverse() * transform.rotation_;
+        transform.scale_ /= base.scale_;
+    }
+}
+
+void AnimationBlendGraphInstance::EvaluatePoses()
+{
+    const float* weights = weights_.data();
+    const float* masks = masks_.data();
+    const unsigned numBones = numBones_;
+
+    for (const AnimationBlendInstruction& instruction : program_->instructions_)
+    {
+        Transform* target = GetRegister(instruction.target_);
+        const Transform* lhs = GetRegister(instruction.lhs_);
+        const Transform* rhs = GetRegister(instruction.rhs_);
+        const float weight = weights[instruction.weight_];
+
+        switch (instruction.opcode_)
+        {
+        case AnimationBlendOpcode::SampleClip:
+            SampleClip(target, instruction.index_, false);
+            break;
+
+        case AnimationBlendOpcode::SampleAdditiveClip:
+            SampleClip(target, instruction.index_, true);
+            break;
+
+        case AnimationBlendOpcode::Blend:
+            for (unsigned i = 0; i < numBones; ++i)
+            {
+                target[i].position_ = lhs[i].position_.Lerp(rhs[i].position_, weight);
+                target[i].rotation_ = lhs[i].rotation_.Nlerp(rhs[i].rotation_, weight, true);
+                target[i].scale_ = lhs[i].scale_.Lerp(rhs[i].scale_, weight);
+            }
+            break;
+
+        case AnimationBlendOpcode::ApplyAdditive:
+            for (unsigned i = 0; i < numBones; ++i)
+            {
+                target[i].position_ = lhs[i].position_ + rhs[i].position_ * weight;
+                target[i].rotation_ = lhs[i].rotation_ * Quaternion::IDENTITY.Nlerp(rhs[i].rotation_, weight, true);
+                target[i].scale_ = lhs[i].scale_ * Vector3::ONE.Lerp(rhs[i].scale_, weight);
+            }
+            break;
+
+        case AnimationBlendOpcode::BlendMasked:
+        {
+            const float* mask = masks + instruction.index_ * numBones;
+            for (unsigned i = 0; i < numBones; ++i)
+            {
+                const float factor = weight * mask[i];
+                target[i].position_ = lhs[i].position_.Lerp(rhs[i].position_, factor);
+                target[i].rotation_ = lhs[i].rotation_.Nlerp(rhs[i].rotation_, factor, true);
+                target[i].scale_ = lhs[i].scale_.Lerp(rhs[i].scale_, factor);
+            }
+            break;
+        }
+
+        case AnimationBlendOpcode::AccumulateFirst:
+            for (unsigned i = 0; i < numBones; ++i)
+            {
+                target[i].position_ = lhs[i].position_ * weight;
+                target[i].rotation_ = lhs[i].rotation_ * weight;
+                target[i].scale_ = lhs[i].scale_ * weight;
+            }
+            break;
+
+        case AnimationBlendOpcode::Accumulate:
+            for (unsigned i = 0; i < numBones; ++i)
+            {
+                // Accumulate rotations in the same hemisphere
+                const float rotationWeight = target[i].rotation_.DotProduct(lhs[i].rotation_) < 0.0f ? -weight : weight;
+                target[i].position_ += lhs[i].position_ * weight;
+                target[i].rotation_ += lhs[i].rotation_ * rotationWeight;
+                target[i].scale_ += lhs[i].scale_ * weight;
+            }
+            break;
+
+        case AnimationBlendOpcode::Normalize:
+            for (unsigned i = 0; i < numBones; ++i)
+                target[i].rotation_.Normalize();
+            break;
+        }
+    }
+}
+
+}
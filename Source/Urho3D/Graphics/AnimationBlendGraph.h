@@ -0,0 +1,285 @@
+// Copyright (c) 2024-2025 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Container/RefCounted.h"
+#include "Urho3D/Math/Transform.h"
+#include "Urho3D/Math/Vector2.h"
+#include "Urho3D/Resource/Resource.h"
+
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Animation;
+class Skeleton;
+struct AnimationTrack;
+
+/// Type of animation blend graph node.
+enum class AnimationBlendNodeType
+{
+    /// Sample single animation clip.
+    Clip,
+    /// Blend inputs placed on a line, driven by one parameter.
+    BlendSpace1D,
+    /// Blend inputs placed on a plane, driven by two parameters.
+    BlendSpace2D,
+    /// Apply additive clip on top of the base input.
+    Additive,
+    /// Blend layer input over the base input for the bone hierarchy starting at mask bone.
+    MaskedLayer,
+    /// Fade between two inputs over time when the parameter switches.
+    Crossfade,
+};
+
+/// Description of animation blend graph node.
+struct URHO3D_API AnimationBlendNode
+{
+    /// Type of the node.
+    AnimationBlendNodeType type_{};
+    /// Indices of input nodes.
+    ea::vector<unsigned> inputs_;
+
+    /// Clip: animation resource name.
+    ea::string animation_;
+    /// Clip: playback speed.
+    float speed_{1.0f};
+    /// Clip: whether the animation is looped.
+    bool looped_{true};
+
+    /// Parameter that drives the node: blend weight, blend space X coordinate or crossfade target.
+    /// Weight is constant 1 if empty.
+    ea::string parameter_;
+    /// BlendSpace2D: parameter that drives Y coordinate.
+    ea::string parameterY_;
+    /// Blend space: positions of inputs. Only X coordinate is used by BlendSpace1D.
+    ea::vector<Vector2> positions_;
+    /// MaskedLayer: name of the first bone affected by the layer.
+    ea::string maskBone_;
+    /// Crossfade: duration of transition in seconds.
+    float duration_{};
+
+    /// Serialize content from/to archive. May throw ArchiveException.
+    void SerializeInBlock(Archive& archive);
+};
+
+/// Operation code of pose instruction.
+enum class AnimationBlendOpcode : unsigned char
+{
+    /// target = sample(clip)
+    SampleClip,
+    /// target = sample(clip) - first keyframe of clip
+    SampleAdditiveClip,
+    /// target = lerp(lhs, rhs, weight)
+    Blend,
+    /// target = lhs + rhs * weight
+    ApplyAdditive,
+    /// target = lerp(lhs, rhs, weight * mask)
+    BlendMasked,
+    /// target = lhs * weight
+    AccumulateFirst,
+    /// target += lhs * weight
+    Accumulate,
+    /// target = normalize(target)
+    Normalize,
+};
+
+/// Instruction that operates on pose registers.
+struct AnimationBlendInstruction
+{
+    AnimationBlendOpcode opcode_{};
+    unsigned target_{};
+    unsigned lhs_{};
+    unsigned rhs_{};
+    /// Index of weight slot.
+    unsigned weight_{};
+    /// Index of clip or mask.
+    unsigned index_{};
+};
+
+/// Operation code of weight instruction.
+enum class AnimationBlendWeightOpcode : unsigned char
+{
+    /// weight = clamp(parameter, 0, 1)
+    Parameter,
+    /// weights = blend space 1D weights for parameter
+    BlendSpace1D,
+    /// weights = blend space 2D weights for parameters
+    BlendSpace2D,
+    /// weight moves towards 0 or 1 depending on parameter
+    Crossfade,
+};
+
+/// Instruction that computes weight slots from parameters before poses are evaluated.
+struct AnimationBlendWeightInstruction
+{
+    AnimationBlendWeightOpcode opcode_{};
+    /// Index of the first weight slot.
+    unsigned target_{};
+    /// Number of weight slots written.
+    unsigned count_{1};
+    unsigned parameterX_{};
+    unsigned parameterY_{};
+    /// Index of the first blend space position.
+    unsigned firstPosition_{};
+    /// Crossfade: weight change per second.
+    float rate_{};
+};
+
+/// Animation clip referenced by compiled graph.
+struct AnimationBlendClip
+{
+    SharedPtr<Animation> animation_;
+    float speed_{1.0f};
+    bool looped_{true};
+};
+
+/// Animation blend graph compiled into linear instruction streams.
+struct URHO3D_API AnimationBlendProgram : public RefCounted
+{
+    /// Weight instructions, evaluated first.
+    ea::vector<AnimationBlendWeightInstruction> weightInstructions_;
+    /// Pose instructions, evaluated in order.
+    ea::vector<AnimationBlendInstruction> instructions_;
+    /// Initial values of weight slots.
+    ea::vector<float> initialWeights_;
+    /// Blend space positions.
+    ea::vector<Vector2> positions_;
+    /// Referenced clips.
+    ea::vector<AnimationBlendClip> clips_;
+    /// Names of mask root bones.
+    ea::vector<ea::string> masks_;
+    /// Names of parameters.
+    ea::vector<ea::string> parameters_;
+    /// Number of pose registers required.
+    unsigned numRegisters_{};
+    /// Register that contains the final pose.
+    unsigned resultRegister_{};
+};
+
+/// Tree of animation blending operations that is compiled into flat instruction list.
+class URHO3D_API AnimationBlendGraph : public SimpleResource
+{
+    URHO3D_OBJECT(AnimationBlendGraph, SimpleResource);
+
+public:
+    /// Construct.
+    explicit AnimationBlendGraph(Context* context);
+    /// Destruct.
+    ~AnimationBlendGraph() override;
+    /// Register object factory.
+    static void RegisterObject(Context* context);
+
+    /// Add node and return its index.
+    unsigned AddNode(const AnimationBlendNode& node);
+    /// Set index of the node that produces final pose.
+    void SetRootNode(unsigned index);
+    /// Remove all nodes.
+    void Clear();
+
+    /// Return nodes.
+    const ea::vector<AnimationBlendNode>& GetNodes() const { return nodes_; }
+    /// Return index of the root node.
+    unsigned GetRootNode() const { return rootNode_; }
+    /// Return compiled program. Graph is compiled on first call. Return null if the graph is invalid.
+    AnimationBlendProgram* GetProgram();
+
+    /// Serialize content from/to archive. May throw ArchiveException.
+    void SerializeInBlock(Archive& archive) override;
+
+protected:
+    /// Binary archive magic word. Should be 4 bytes.
+    BinaryMagic GetBinaryMagic() const override;
+    /// Root block name. Used for XML serialization only.
+    const char* GetRootBlockName() const override { return "animationBlendGraph"; }
+
+private:
+    /// Compile graph into program.
+    SharedPtr<AnimationBlendProgram> Compile() const;
+
+    /// Nodes of the graph.
+    ea::vector<AnimationBlendNode> nodes_;
+    /// Index of the root node.
+    unsigned rootNode_{};
+    /// Compiled program.
+    SharedPtr<AnimationBlendProgram> program_;
+    /// Whether the compilation was attempted.
+    bool compiled_{};
+};
+
+/// Instance of animation blend graph bound to skeleton.
+/// All memory is allocated on construction, evaluation doesn't allocate.
+class URHO3D_API AnimationBlendGraphInstance
+{
+public:
+    /// Construct and bind to skeleton.
+    AnimationBlendGraphInstance(AnimationBlendGraph* graph, const Skeleton& skeleton);
+    /// Destruct.
+    ~AnimationBlendGraphInstance();
+
+    /// Return whether the instance has valid program.
+    bool IsValid() const { return program_ != nullptr; }
+    /// Return index of parameter or M_MAX_UNSIGNED if not found.
+    unsigned GetParameterIndex(const ea::string& name) const;
+    /// Set parameter by index.
+    void SetParameter(unsigned index, float value) { parameters_[index] = value; }
+    /// Set parameter by name.
+    void SetParameter(const ea::string& name, float value);
+    /// Return parameter by index.
+    float GetParameter(unsigned index) const { return parameters_[index]; }
+
+    /// Advance time and evaluate pose.
+    void Update(float timeStep);
+    /// Return evaluated pose, transform per skeleton bone.
+    ea::span<const Transform> GetPose() const;
+    /// Apply evaluated pose to bone nodes of the skeleton.
+    void ApplyToSkeleton(Skeleton& skeleton) const;
+
+private:
+    /// Track bound to skeleton bone.
+    struct TrackBinding
+    {
+        unsigned bone_{};
+        const AnimationTrack* track_{};
+    };
+
+    /// Update weight slots from parameters.
+    void EvaluateWeights(float timeStep);
+    /// Advance clip times.
+    void AdvanceClips(float timeStep);
+    /// Evaluate pose instructions.
+    void EvaluatePoses();
+    /// Sample clip into pose register.
+    void SampleClip(Transform* pose, unsigned clipIndex, bool additive);
+    /// Return pose register.
+    Transform* GetRegister(unsigned index) { return &poses_[index * numBones_]; }
+
+    SharedPtr<AnimationBlendProgram> program_;
+    unsigned numBones_{};
+
+    /// Bind pose of the skeleton.
+    ea::vector<Transform> bindPose_;
+    /// Pose registers, numBones_ transforms each.
+    ea::vector<Transform> poses_;
+    /// Per-bone mask weights, numBones_ values per mask.
+    ea::vector<float> masks_;
+
+    /// Tracks of each clip, clipTracks_[clip] .. clipTracks_[clip + 1] in trackBindings_.
+    ea::vector<unsigned> clipTracks_;
+    ea::vector<TrackBinding> trackBindings_;
+    /// Keyframe hints, one per track binding.
+    ea::vector<unsigned> keyFrameHints_;
+    /// First keyframe of each track binding, used by additive clips.
+    ea::vector<Transform> additiveBase_;
+
+    ea::vector<float> clipTimes_;
+    ea::vector<float> clipLengths_;
+    ea::vector<float> parameters_;
+    ea::vector<float> weights_;
+};
+
+}
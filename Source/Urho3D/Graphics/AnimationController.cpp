@@ -30,6 +30,7 @@
 #include "../Graphics/AnimationState.h"
 #include "../Graphics/DrawableEvents.h"
 #include "../Graphics/Renderer.h"
+#include "../IO/BitStream.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
 #include "../IO/MemoryBuffer.h"
@@ -86,6 +87,33 @@ enum class AnimationParameterMask
 };
 URHO3D_FLAGSET(AnimationParameterMask, AnimationParameterFlags);
 
+constexpr unsigned NumAnimationParameterFlags = 15;
+/// Weights are stored with fixed precision when bit-packed.
+constexpr unsigned NumAnimationWeightBits = 12;
+
+AnimationParameterFlags GetSerializationFlags(const AnimationParameters& params)
+{
+    AnimationParameterFlags flags;
+    flags.Set(AnimationParameterMask::InstanceIndex, params.instanceIndex_ != 0);
+    flags.Set(AnimationParameterMask::Looped, params.looped_);
+    flags.Set(AnimationParameterMask::RemoveOnCompletion, params.removeOnCompletion_);
+    flags.Set(AnimationParameterMask::Layer, params.layer_ != 0);
+    flags.Set(AnimationParameterMask::Additive, params.blendMode_ == ABM_ADDITIVE);
+    flags.Set(AnimationParameterMask::StartBone, !params.startBone_.empty());
+    flags.Set(AnimationParameterMask::AutoFadeOutTime, params.autoFadeOutTime_ != 0.0f);
+    const WrappedScalar<float>& time = params.GetAnimationTime();
+    flags.Set(AnimationParameterMask::Time, time.Value() != 0.0f);
+    flags.Set(AnimationParameterMask::MinTime, time.Min() != 0.0f);
+    Animation* animation = params.GetAnimation();
+    flags.Set(AnimationParameterMask::MaxTime, animation && time.Max() != animation->GetLength());
+    flags.Set(AnimationParameterMask::Speed, params.speed_ != 1.0f);
+    flags.Set(AnimationParameterMask::RemoveOnZeroWeight, params.removeOnZeroWeight_);
+    flags.Set(AnimationParameterMask::Weight, params.weight_ != 1.0f);
+    flags.Set(AnimationParameterMask::TargetWeight, params.targetWeight_ != 1.0f);
+    flags.Set(AnimationParameterMask::TargetWeightDelay, params.targetWeightDelay_ != 0.0f);
+    return flags;
+}
+
 bool MatchesQuery(const AnimationParameters& params, Animation* animation, unsigned layer)
 {
     if (animation && params.GetAnimation() != animation)
@@ -339,22 +367,7 @@ AnimationParameters AnimationParameters::Deserialize(Animation* animation, Deser
 
 void AnimationParameters::Serialize(Serializer& dest) const
 {
-    AnimationParameterFlags flags;
-    flags.Set(AnimationParameterMask::InstanceIndex, instanceIndex_ != 0);
-    flags.Set(AnimationParameterMask::Looped, looped_);
-    flags.Set(AnimationParameterMask::RemoveOnCompletion, removeOnCompletion_);
-    flags.Set(AnimationParameterMask::Layer, layer_ != 0);
-    flags.Set(AnimationParameterMask::Additive, blendMode_ == ABM_ADDITIVE);
-    flags.Set(AnimationParameterMask::StartBone, startBone_.empty());
-    flags.Set(AnimationParameterMask::AutoFadeOutTime, autoFadeOutTime_ != 0.0f);
-    flags.Set(AnimationParameterMask::Time, time_.Value() != 0.0f);
-    flags.Set(AnimationParameterMask::MinTime, time_.Min() != 0.0f);
-    flags.Set(AnimationParameterMask::MaxTime, animation_ && time_.Max() != animation_->GetLength());
-    flags.Set(AnimationParameterMask::Speed, speed_ != 1.0f);
-    flags.Set(AnimationParameterMask::RemoveOnZeroWeight, removeOnZeroWeight_);
-    flags.Set(AnimationParameterMask::Weight, weight_ != 1.0f);
-    flags.Set(AnimationParameterMask::TargetWeight, targetWeight_ != 1.0f);
-    flags.Set(AnimationParameterMask::TargetWeightDelay, targetWeightDelay_ != 0.0f);
+    const AnimationParameterFlags flags = GetSerializationFlags(*this);
 
     dest.WriteVLE(flags.AsInteger());
     if (flags.Test(AnimationParameterMask::InstanceIndex))
@@ -381,6 +394,89 @@ void AnimationParameters::Serialize(Serializer& dest) const
         dest.WriteFloat(targetWeightDelay_);
 }
 
+AnimationParameters AnimationParameters::DeserializeBits(Animation* animation, BitReader& src)
+{
+    AnimationParameters result{animation};
+
+    const auto flags = static_cast<AnimationParameterFlags>(src.ReadBits(NumAnimationParameterFlags));
+
+    if (flags.Test(AnimationParameterMask::InstanceIndex))
+        result.instanceIndex_ = src.ReadVarUInt();
+
+    result.looped_ = flags.Test(AnimationParameterMask::Looped);
+
+    result.removeOnCompletion_ = flags.Test(AnimationParameterMask::RemoveOnCompletion);
+
+    if (flags.Test(AnimationParameterMask::Layer))
+        result.layer_ = src.ReadVarUInt();
+
+    result.blendMode_ = flags.Test(AnimationParameterMask::Additive) ? ABM_ADDITIVE : ABM_LERP;
+
+    if (flags.Test(AnimationParameterMask::StartBone))
+        result.startBone_ = src.ReadString();
+
+    if (flags.Test(AnimationParameterMask::AutoFadeOutTime))
+        result.autoFadeOutTime_ = src.ReadFloat();
+
+    float time = 0.0f;
+    float minTime = 0.0f;
+    float maxTime = result.animation_ ? result.animation_->GetLength() : 0.0f;
+
+    if (flags.Test(AnimationParameterMask::Time))
+        time = src.ReadFloat();
+    if (flags.Test(AnimationParameterMask::MinTime))
+        minTime = src.ReadFloat();
+    if (flags.Test(AnimationParameterMask::MaxTime))
+        maxTime = src.ReadFloat();
+
+    result.time_ = {time, minTime, maxTime};
+
+    if (flags.Test(AnimationParameterMask::Speed))
+        result.speed_ = src.ReadFloat();
+
+    result.removeOnZeroWeight_ = flags.Test(AnimationParameterMask::RemoveOnZeroWeight);
+
+    if (flags.Test(AnimationParameterMask::Weight))
+        result.weight_ = src.ReadQuantizedUnitFloat(NumAnimationWeightBits);
+
+    if (flags.Test(AnimationParameterMask::TargetWeight))
+        result.targetWeight_ = src.ReadQuantizedUnitFloat(NumAnimationWeightBits);
+
+    if (flags.Test(AnimationParameterMask::TargetWeightDelay))
+        result.targetWeightDelay_ = src.ReadFloat();
+
+    return result;
+}
+
+void AnimationParameters::SerializeBits(BitWriter& dest) const
+{
+    const AnimationParameterFlags flags = GetSerializationFlags(*this);
+
+    dest.WriteBits(flags.AsInteger(), NumAnimationParameterFlags);
+    if (flags.Test(AnimationParameterMask::InstanceIndex))
+        dest.WriteVarUInt(instanceIndex_);
+    if (flags.Test(AnimationParameterMask::Layer))
+        dest.WriteVarUInt(layer_);
+    if (flags.Test(AnimationParameterMask::StartBone))
+        dest.WriteString(startBone_);
+    if (flags.Test(AnimationParameterMask::AutoFadeOutTime))
+        dest.WriteFloat(autoFadeOutTime_);
+    if (flags.Test(AnimationParameterMask::Time))
+        dest.WriteFloat(time_.Value());
+    if (flags.Test(AnimationParameterMask::MinTime))
+        dest.WriteFloat(time_.Min());
+    if (flags.Test(AnimationParameterMask::MaxTime))
+        dest.WriteFloat(time_.Max());
+    if (flags.Test(AnimationParameterMask::Speed))
+        dest.WriteFloat(speed_);
+    if (flags.Test(AnimationParameterMask::Weight))
+        dest.WriteQuantizedUnitFloat(weight_, NumAnimationWeightBits);
+    if (flags.Test(AnimationParameterMask::TargetWeight))
+        dest.WriteQuantizedUnitFloat(targetWeight_, NumAnimationWeightBits);
+    if (flags.Test(AnimationParameterMask::TargetWeightDelay))
+        dest.WriteFloat(targetWeightDelay_);
+}
+
 bool AnimationParameters::IsMergeableWith(const AnimationParameters& rhs) const
 {
     return animation_ == rhs.animation_ && instanceIndex_ == rhs.instanceIndex_;
@@ -36,6 +36,8 @@ namespace Urho3D
 
 class AnimatedModel;
 class Animation;
+class BitReader;
+class BitWriter;
 struct AnimationTriggerPoint;
 struct Bone;
 
@@ -118,6 +120,9 @@ public:
 
     static AnimationParameters Deserialize(Animation* animation, Deserializer& src);
     void Serialize(Serializer& dest) const;
+    /// Compact serialization without byte alignment. Weights are quantized.
+    static AnimationParameters DeserializeBits(Animation* animation, BitReader& src);
+    void SerializeBits(BitWriter& dest) const;
 
     bool IsMergeableWith(const AnimationParameters& rhs) const;
 
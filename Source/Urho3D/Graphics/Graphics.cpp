@@ -26,6 +26,7 @@
 #include "../Core/Profiler.h"
 #include "../Graphics/AnimatedModel.h"
 #include "../Graphics/Animation.h"
+#include "../Graphics/AnimationBlendGraph.h"
 #include "../Graphics/AnimationController.h"
 #include "../Graphics/Camera.h"
 #include "../Graphics/CameraOperator.h"
@@ -688,6 +689,7 @@ unsigned Graphics::GetMaxBones()
 void RegisterGraphicsLibrary(Context* context)
 {
     Animation::RegisterObject(context);
+    AnimationBlendGraph::RegisterObject(context);
     Material::RegisterObject(context);
     Model::RegisterObject(context);
     Shader::RegisterObject(context);
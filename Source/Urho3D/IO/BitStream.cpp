@@ -0,0 +1,294 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/IO/BitStream.h"
+
+#include "Urho3D/Core/Assert.h"
+
+#include <cstring>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Largest component of normalized quaternion is at least 0.5, the rest are below 1/sqrt(2).
+constexpr double MaxSmallestQuaternionComponent = 0.70710678118654752440;
+
+/// Number of value bits in one group of variable-length integer.
+constexpr unsigned VarUIntGroupBits = 4;
+
+unsigned long long GetMaxQuantizedValue(unsigned numBits)
+{
+    return (1ull << numBits) - 1;
+}
+
+} // namespace
+
+unsigned GetNumBitsForRange(unsigned maxValue)
+{
+    unsigned numBits = 0;
+    while (numBits < 32 && (maxValue >> numBits) != 0)
+        ++numBits;
+    return numBits;
+}
+
+BitWriter::BitWriter(ByteVector& buffer)
+    : buffer_(buffer)
+{
+}
+
+void BitWriter::WriteBits(unsigned value, unsigned numBits)
+{
+    URHO3D_ASSERT(numBits <= 32);
+
+    if (numBits < 32)
+        value &= (1u << numBits) - 1;
+
+    scratch_ |= static_cast<unsigned long long>(value) << scratchBits_;
+    scratchBits_ += numBits;
+    numBits_ += numBits;
+
+    while (scratchBits_ >= 8)
+    {
+        buffer_.push_back(static_cast<unsigned char>(scratch_ & 0xff));
+        scratch_ >>= 8;
+        scratchBits_ -= 8;
+    }
+}
+
+void BitWriter::WriteBool(bool value)
+{
+    WriteBits(value ? 1 : 0, 1);
+}
+
+void BitWriter::WriteRangedInt(int value, int minValue, int maxValue)
+{
+    URHO3D_ASSERT(minValue <= maxValue);
+
+    const auto range = static_cast<unsigned>(static_cast<long long>(maxValue) - minValue);
+    const auto offset = static_cast<unsigned>(static_cast<long long>(Clamp(value, minValue, maxValue)) - minValue);
+    WriteBits(offset, GetNumBitsForRange(range));
+}
+
+void BitWriter::WriteVarUInt(unsigned value)
+{
+    do
+    {
+        const unsigned group = value & ((1u << VarUIntGroupBits) - 1);
+        value >>= VarUIntGroupBits;
+        WriteBits(group, VarUIntGroupBits);
+        WriteBool(value != 0);
+    } while (value != 0);
+}
+
+void BitWriter::WriteFloat(float value)
+{
+    unsigned bits{};
+    std::memcpy(&bits, &value, sizeof(bits));
+    WriteBits(bits, 32);
+}
+
+void BitWriter::WriteString(ea::string_view value)
+{
+    WriteVarUInt(value.size());
+    for (const char ch : value)
+        WriteBits(static_cast<unsigned char>(ch), 8);
+}
+
+void BitWriter::WriteQuantizedFloat(double value, double range, unsigned numBits)
+{
+    URHO3D_ASSERT(numBits >= 2 && numBits <= 32 && range > 0.0);
+
+    // Use odd number of steps so zero is represented exactly
+    const auto maxOffset = static_cast<double>(GetMaxQuantizedValue(numBits - 1));
+    const double normalizedValue = Clamp(value / range, -1.0, 1.0);
+    const auto offset = static_cast<long long>(std::round(normalizedValue * maxOffset));
+    WriteBits(static_cast<unsigned>(offset + static_cast<long long>(maxOffset)), numBits);
+}
+
+void BitWriter::WriteQuantizedUnitFloat(float value, unsigned numBits)
+{
+    URHO3D_ASSERT(numBits >= 1 && numBits <= 32);
+
+    const auto maxValue = static_cast<double>(GetMaxQuantizedValue(numBits));
+    const double normalizedValue = Clamp(static_cast<double>(value), 0.0, 1.0);
+    WriteBits(static_cast<unsigned>(std::round(normalizedValue * maxValue)), numBits);
+}
+
+void BitWriter::WriteQuantizedVector3(const DoubleVector3& value, double range, unsigned numBits)
+{
+    WriteQuantizedFloat(value.x_, range, numBits);
+    WriteQuantizedFloat(value.y_, range, numBits);
+    WriteQuantizedFloat(value.z_, range, numBits);
+}
+
+void BitWriter::WriteQuantizedQuaternion(const Quaternion& value, unsigned numBits)
+{
+    const Quaternion normalized = value.Normalized();
+    const float components[4]{normalized.w_, normalized.x_, normalized.y_, normalized.z_};
+
+    unsigned largestIndex = 0;
+    for (unsigned i = 1; i < 4; ++i)
+    {
+        if (Abs(components[i]) > Abs(components[largestIndex]))
+            largestIndex = i;
+    }
+
+    // Quaternion and its negation represent the same rotation, so largest component is always positive
+    const float sign = components[largestIndex] < 0.0f ? -1.0f : 1.0f;
+    WriteBits(largestIndex, 2);
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (i != largestIndex)
+            WriteQuantizedFloat(components[i] * sign, MaxSmallestQuaternionComponent, numBits);
+    }
+}
+
+void BitWriter::Flush()
+{
+    if (scratchBits_ > 0)
+    {
+        buffer_.push_back(static_cast<unsigned char>(scratch_ & 0xff));
+        scratch_ = 0;
+        scratchBits_ = 0;
+    }
+}
+
+BitReader::BitReader(ConstByteSpan data)
+    : data_(data)
+{
+}
+
+unsigned BitReader::ReadBits(unsigned numBits)
+{
+    URHO3D_ASSERT(numBits <= 32);
+
+    if (numBits > GetNumBitsRemaining())
+    {
+        isOverflow_ = true;
+        position_ = data_.size() * 8;
+        return 0;
+    }
+
+    unsigned long long result = 0;
+    unsigned numBitsRead = 0;
+    while (numBitsRead < numBits)
+    {
+        const unsigned byteIndex = position_ / 8;
+        const unsigned bitIndex = position_ % 8;
+        const unsigned numBitsInByte = ea::min(8 - bitIndex, numBits - numBitsRead);
+
+        const unsigned bits = (data_[byteIndex] >> bitIndex) & ((1u << numBitsInByte) - 1);
+        result |= static_cast<unsigned long long>(bits) << numBitsRead;
+
+        numBitsRead += numBitsInByte;
+        position_ += numBitsInByte;
+    }
+    return static_cast<unsigned>(result);
+}
+
+bool BitReader::ReadBool()
+{
+    return ReadBits(1) != 0;
+}
+
+int BitReader::ReadRangedInt(int minValue, int maxValue)
+{
+    URHO3D_ASSERT(minValue <= maxValue);
+
+    const auto range = static_cast<unsigned>(static_cast<long long>(maxValue) - minValue);
+    const unsigned offset = ea::min(ReadBits(GetNumBitsForRange(range)), range);
+    return static_cast<int>(minValue + static_cast<long long>(offset));
+}
+
+unsigned BitReader::ReadVarUInt()
+{
+    unsigned result = 0;
+    for (unsigned shift = 0; shift < 32; shift += VarUIntGroupBits)
+    {
+        result |= ReadBits(VarUIntGroupBits) << shift;
+        if (!ReadBool())
+            break;
+    }
+    return result;
+}
+
+float BitReader::ReadFloat()
+{
+    const unsigned bits = ReadBits(32);
+    float value{};
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+ea::string BitReader::ReadString()
+{
+    const unsigned size = ReadVarUInt();
+    if (size > GetNumBitsRemaining() / 8)
+    {
+        isOverflow_ = true;
+        position_ = data_.size() * 8;
+        return {};
+    }
+
+    ea::string result(size, '\0');
+    for (char& ch : result)
+        ch = static_cast<char>(ReadBits(8));
+    return result;
+}
+
+double BitReader::ReadQuantizedFloat(double range, unsigned numBits)
+{
+    URHO3D_ASSERT(numBits >= 2 && numBits <= 32);
+
+    const auto maxOffset = static_cast<long long>(GetMaxQuantizedValue(numBits - 1));
+    const long long offset = Clamp(static_cast<long long>(ReadBits(numBits)) - maxOffset, -maxOffset, maxOffset);
+    return static_cast<double>(offset) / static_cast<double>(maxOffset) * range;
+}
+
+float BitReader::ReadQuantizedUnitFloat(unsigned numBits)
+{
+    URHO3D_ASSERT(numBits >= 1 && numBits <= 32);
+
+    const auto maxValue = static_cast<double>(GetMaxQuantizedValue(numBits));
+    return static_cast<float>(ReadBits(numBits) / maxValue);
+}
+
+DoubleVector3 BitReader::ReadQuantizedVector3(double range, unsigned numBits)
+{
+    DoubleVector3 result;
+    result.x_ = ReadQuantizedFloat(range, numBits);
+    result.y_ = ReadQuantizedFloat(range, numBits);
+    result.z_ = ReadQuantizedFloat(range, numBits);
+    return result;
+}
+
+Quaternion BitReader::ReadQuantizedQuaternion(unsigned numBits)
+{
+    const unsigned largestIndex = ReadBits(2);
+
+    float components[4]{};
+    float sumSquares = 0.0f;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (i != largestIndex)
+        {
+            components[i] = static_cast<float>(ReadQuantizedFloat(MaxSmallestQuaternionComponent, numBits));
+            sumSquares += components[i] * components[i];
+        }
+    }
+    components[largestIndex] = Sqrt(ea::max(0.0f, 1.0f - sumSquares));
+
+    // Valid data is normalized by construction, renormalizing it would make exact values inexact
+    const Quaternion result{components[0], components[1], components[2], components[3]};
+    return sumSquares > 1.0f ? result.Normalized() : result;
+}
+
+} // namespace Urho3D
@@ -0,0 +1,91 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Container/ByteVector.h"
+#include "Urho3D/Math/Quaternion.h"
+#include "Urho3D/Math/Vector3.h"
+
+#include <EASTL/string.h>
+
+namespace Urho3D
+{
+
+/// Return number of bits required to store integers in range [0, maxValue].
+URHO3D_API unsigned GetNumBitsForRange(unsigned maxValue);
+
+/// Writes values into byte buffer bit by bit, without byte alignment of individual values.
+/// Bits are written starting from the least significant bit of each byte.
+/// Quantized values are symmetric and represent zero exactly.
+class URHO3D_API BitWriter
+{
+public:
+    /// Construct writer that appends bits to the buffer. Call Flush when done.
+    explicit BitWriter(ByteVector& buffer);
+
+    /// Write up to 32 lower bits of the value.
+    void WriteBits(unsigned value, unsigned numBits);
+    void WriteBool(bool value);
+    /// Write integer clamped to range [minValue, maxValue] using minimal number of bits.
+    void WriteRangedInt(int value, int minValue, int maxValue);
+    /// Write unsigned integer in groups of 4 bits, small values take less space.
+    void WriteVarUInt(unsigned value);
+    void WriteFloat(float value);
+    void WriteString(ea::string_view value);
+
+    /// Write float clamped to range [-range, range] using given number of bits (2 to 32).
+    void WriteQuantizedFloat(double value, double range, unsigned numBits);
+    /// Write float clamped to range [0, 1] using given number of bits (1 to 32).
+    void WriteQuantizedUnitFloat(float value, unsigned numBits);
+    /// Write vector clamped to range [-range, range] per component.
+    void WriteQuantizedVector3(const DoubleVector3& value, double range, unsigned numBits);
+    /// Write normalized quaternion as three smallest components, 2 + 3 * numBits bits total.
+    void WriteQuantizedQuaternion(const Quaternion& value, unsigned numBits);
+
+    /// Write pending bits to the buffer, padding last byte with zeros.
+    void Flush();
+    /// Return number of bits written.
+    unsigned GetNumBits() const { return numBits_; }
+
+private:
+    ByteVector& buffer_;
+    unsigned long long scratch_{};
+    unsigned scratchBits_{};
+    unsigned numBits_{};
+};
+
+/// Reads values written by BitWriter.
+/// Reading past the end of data returns zeros and sets overflow flag instead of failing.
+class URHO3D_API BitReader
+{
+public:
+    explicit BitReader(ConstByteSpan data);
+
+    unsigned ReadBits(unsigned numBits);
+    bool ReadBool();
+    int ReadRangedInt(int minValue, int maxValue);
+    unsigned ReadVarUInt();
+    float ReadFloat();
+    ea::string ReadString();
+
+    double ReadQuantizedFloat(double range, unsigned numBits);
+    float ReadQuantizedUnitFloat(unsigned numBits);
+    DoubleVector3 ReadQuantizedVector3(double range, unsigned numBits);
+    Quaternion ReadQuantizedQuaternion(unsigned numBits);
+
+    /// Return whether reader attempted to read past the end of data.
+    bool IsOverflow() const { return isOverflow_; }
+    /// Return number of bits read.
+    unsigned GetNumBits() const { return position_; }
+    /// Return number of bits remaining, including padding.
+    unsigned GetNumBitsRemaining() const { return data_.size() * 8 - position_; }
+
+private:
+    ConstByteSpan data_;
+    unsigned position_{};
+    bool isOverflow_{};
+};
+
+} // namespace Urho3D
@@ -58,6 +58,9 @@ public:
     /// Return whether the end of stream has been reached.
     /// @property
     virtual bool IsEof() const { return position_ >= size_; }
+    /// Return whole content of the stream if it is stored in contiguous memory and can be accessed without copying.
+    /// Return empty span otherwise.
+    virtual ConstByteSpan GetContiguousData() const { return {}; }
 
     /// Set position relative to current position. Return actual new position.
     unsigned SeekRelative(int delta);
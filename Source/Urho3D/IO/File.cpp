@@ -39,6 +39,7 @@
 
 #include <cstdio>
 #include <LZ4/lz4.h>
+#include <zstd.h>
 
 #include "../DebugNew.h"
 
@@ -68,6 +69,43 @@ static const unsigned READ_BUFFER_SIZE = 32768;
 #endif
 static const unsigned SKIP_BUFFER_SIZE = 1024;
 
+static int SeekFile(FILE* handle, long long offset, int origin)
+{
+#ifdef _WIN32
+    return _fseeki64(handle, offset, origin);
+#else
+    return fseeko(handle, static_cast<off_t>(offset), origin);
+#endif
+}
+
+static long long TellFile(FILE* handle)
+{
+#ifdef _WIN32
+    return _ftelli64(handle);
+#else
+    return ftello(handle);
+#endif
+}
+
+static bool DecompressBlock(PackageCompression compression, void* dest, unsigned destSize, const void* src, unsigned srcSize)
+{
+    switch (compression)
+    {
+    case PackageCompression::LZ4:
+        return LZ4_decompress_safe(static_cast<const char*>(src), static_cast<char*>(dest), srcSize, destSize)
+            == static_cast<int>(destSize);
+
+    case PackageCompression::ZSTD:
+    {
+        const size_t result = ZSTD_decompress(dest, destSize, src, srcSize);
+        return !ZSTD_isError(result) && result == destSize;
+    }
+
+    default:
+        return false;
+    }
+}
+
 File::File(Context* context) :
     Object(context),
     mode_(FILE_READ),
@@ -131,6 +169,19 @@ bool File::Open(const ea::string& fileName, FileMode mode)
     return OpenInternal(fileName, mode);
 }
 
+bool File::Open(const ea::string& fileName, FileMode mode, unsigned long long offset)
+{
+    if (!OpenInternal(fileName, mode, true))
+        return false;
+
+    const unsigned long long fileSize = GetUnderlyingSize();
+    const unsigned long long viewSize = fileSize > offset ? fileSize - offset : 0;
+    offset_ = offset;
+    size_ = static_cast<unsigned>(Min<unsigned long long>(viewSize, M_MAX_UNSIGNED));
+    SeekInternal(offset_);
+    return true;
+}
+
 bool File::Open(PackageFile* package, const ea::string& fileName)
 {
     if (!package)
@@ -151,7 +202,11 @@ bool File::Open(PackageFile* package, const ea::string& fileName)
     offset_ = entry->offset_;
     checksum_ = entry->checksum_;
     size_ = entry->size_;
-    compressed_ = package->IsCompressed();
+    compression_ = entry->compression_;
+    compressed_ = compression_ != PackageCompression::None;
+    blockSize_ = entry->blockSize_;
+    blockOffsets_ = entry->blockOffsets_;
+    currentBlock_ = M_MAX_UNSIGNED;
 
     // Seek to beginning of package entry's file data
     SeekInternal(offset_);
@@ -212,6 +267,9 @@ unsigned File::Read(void* dest, unsigned size)
     }
 #endif
 
+    if (compressed_ && !blockOffsets_.empty())
+        return ReadBlocks(dest, size);
+
     if (compressed_)
     {
         unsigned sizeLeft = size;
@@ -285,25 +343,31 @@ unsigned File::Seek(unsigned position)
     if (mode_ == FILE_READ && position > size_)
         position = size_;
 
+    // Blocks are located via block index on read
+    if (compressed_ && !blockOffsets_.empty())
+    {
+        position_ = position;
+        return position_;
+    }
+
     if (compressed_)
     {
         // Start over from the beginning
-        if (position == 0)
+        if (position < position_)
         {
             position_ = 0;
             readBufferOffset_ = 0;
             readBufferSize_ = 0;
             SeekInternal(offset_);
         }
+
         // Skip bytes
-        else if (position >= position_)
+        unsigned char skipBuffer[SKIP_BUFFER_SIZE];
+        while (position > position_)
         {
-            unsigned char skipBuffer[SKIP_BUFFER_SIZE];
-            while (position > position_)
-                Read(skipBuffer, Min(position - position_, SKIP_BUFFER_SIZE));
+            if (!Read(skipBuffer, Min(position - position_, SKIP_BUFFER_SIZE)))
+                break;
         }
-        else
-            URHO3D_LOGERROR("Seeking backward in a compressed file is not supported");
 
         return position_;
     }
@@ -335,14 +399,14 @@ unsigned File::Write(const void* data, unsigned size)
     // Need to reassign the position due to internal buffering when transitioning from reading to writing
     if (writeSyncNeeded_)
     {
-        fseek((FILE*)handle_, (long)position_ + offset_, SEEK_SET);
+        SeekInternal(position_ + offset_);
         writeSyncNeeded_ = false;
     }
 
     if (fwrite(data, size, 1, (FILE*)handle_) != 1)
     {
         // Return to the position where the write began
-        fseek((FILE*)handle_, (long)position_ + offset_, SEEK_SET);
+        SeekInternal(position_ + offset_);
         URHO3D_LOGERROR("Error while writing to file " + GetName());
         return 0;
     }
@@ -401,6 +465,11 @@ void File::Close()
 
     readBuffer_.reset();
     inputBuffer_.reset();
+    compressed_ = false;
+    compression_ = PackageCompression::None;
+    blockSize_ = 0;
+    blockOffsets_.clear();
+    currentBlock_ = M_MAX_UNSIGNED;
 
     if (handle_)
     {
@@ -505,9 +574,9 @@ bool File::OpenInternal(const ea::string& fileName, FileMode mode, bool fromPack
 
     if (!fromPackage)
     {
-        fseek((FILE*)handle_, 0, SEEK_END);
-        long size = ftell((FILE*)handle_);
-        fseek((FILE*)handle_, 0, SEEK_SET);
+        SeekFile((FILE*)handle_, 0, SEEK_END);
+        const long long size = TellFile((FILE*)handle_);
+        SeekFile((FILE*)handle_, 0, SEEK_SET);
         if (size > M_MAX_UNSIGNED)
         {
             URHO3D_LOGERRORF("Could not open file %s which is larger than 4GB", fileName.c_str());
@@ -540,7 +609,7 @@ bool File::ReadInternal(void* dest, unsigned size)
         return fread(dest, size, 1, (FILE*)handle_) == 1;
 }
 
-void File::SeekInternal(unsigned newPosition)
+void File::SeekInternal(unsigned long long newPosition)
 {
 #ifdef __ANDROID__
     if (assetHandle_)
@@ -552,7 +621,92 @@ void File::SeekInternal(unsigned newPosition)
     }
     else
 #endif
-        fseek((FILE*)handle_, newPosition, SEEK_SET);
+        SeekFile((FILE*)handle_, static_cast<long long>(newPosition), SEEK_SET);
+}
+
+unsigned File::ReadBlocks(void* dest, unsigned size)
+{
+    unsigned sizeLeft = size;
+    auto* destPtr = static_cast<unsigned char*>(dest);
+
+    while (sizeLeft)
+    {
+        const unsigned blockIndex = position_ / blockSize_;
+        if (blockIndex != currentBlock_ && !LoadBlock(blockIndex))
+        {
+            URHO3D_LOGERROR("Error while decompressing file " + GetName());
+            break;
+        }
+
+        const unsigned blockOffset = position_ - blockIndex * blockSize_;
+        const unsigned copySize = Min(readBufferSize_ - blockOffset, sizeLeft);
+        memcpy(destPtr, readBuffer_.get() + blockOffset, copySize);
+        destPtr += copySize;
+        sizeLeft -= copySize;
+        position_ += copySize;
+    }
+
+    return size - sizeLeft;
+}
+
+bool File::LoadBlock(unsigned index)
+{
+    if (index + 1 >= blockOffsets_.size())
+        return false;
+
+    if (!readBuffer_)
+    {
+        readBuffer_ = new unsigned char[blockSize_];
+        inputBuffer_ = new unsigned char[blockSize_];
+    }
+
+    // Blocks that don't benefit from compression are stored as is
+    const unsigned long long packedOffset = blockOffsets_[index];
+    const unsigned long long packedSize = blockOffsets_[index + 1] - packedOffset;
+    const unsigned unpackedSize = Min(blockSize_, size_ - index * blockSize_);
+    if (packedSize > unpackedSize)
+        return false;
+
+    // Blocks are stored sequentially, don't seek if the next block is read
+    if (currentBlock_ == M_MAX_UNSIGNED || currentBlock_ + 1 != index)
+        SeekInternal(offset_ + packedOffset);
+    currentBlock_ = M_MAX_UNSIGNED;
+    readBufferSize_ = 0;
+
+    if (packedSize == unpackedSize)
+    {
+        if (!ReadInternal(readBuffer_.get(), unpackedSize))
+            return false;
+    }
+    else
+    {
+        if (!ReadInternal(inputBuffer_.get(), static_cast<unsigned>(packedSize)))
+            return false;
+        if (!DecompressBlock(
+                compression_, readBuffer_.get(), unpackedSize, inputBuffer_.get(), static_cast<unsigned>(packedSize)))
+            return false;
+    }
+
+    readBufferSize_ = unpackedSize;
+    currentBlock_ = index;
+    return true;
+}
+
+unsigned long long File::GetUnderlyingSize() const
+{
+#ifdef __ANDROID__
+    if (assetHandle_)
+        return static_cast<unsigned long long>(SDL_RWsize(assetHandle_));
+#endif
+    if (!handle_)
+        return 0;
+
+    auto* handle = static_cast<FILE*>(handle_);
+    const long long position = TellFile(handle);
+    SeekFile(handle, 0, SEEK_END);
+    const long long size = TellFile(handle);
+    SeekFile(handle, position, SEEK_SET);
+    return size > 0 ? static_cast<unsigned long long>(size) : 0;
 }
 
 void File::ReadBinary(ea::vector<unsigned char>& buffer)
@@ -51,6 +51,7 @@ static const char* APK = "";
 #endif
 
 class PackageFile;
+enum class PackageCompression : unsigned char;
 
 /// %File opened either through the filesystem or from within a package file.
 class URHO3D_API File : public Object, public AbstractFile
@@ -82,6 +83,9 @@ public:
 
     /// Open a filesystem file. Return true if successful.
     bool Open(const ea::string& fileName, FileMode mode = FILE_READ);
+    /// Open a view of filesystem file that starts at specified offset. Return true if successful.
+    /// Offset may exceed 4GB, size of the view is clamped to 4GB.
+    bool Open(const ea::string& fileName, FileMode mode, unsigned long long offset);
     /// Open from within a package file. Return true if successful.
     bool Open(PackageFile* package, const ea::string& fileName);
     /// Close the file.
@@ -103,6 +107,12 @@ public:
     /// Return whether the file originates from a package.
     /// @property
     bool IsPackaged() const { return offset_ != 0; }
+    /// Return start position within the underlying file.
+    unsigned long long GetOffset() const { return offset_; }
+    /// Return whether the file is compressed within a package.
+    bool IsCompressed() const { return compressed_; }
+    /// Return size of the underlying file. May exceed 4GB.
+    unsigned long long GetUnderlyingSize() const;
 
     /// Reads a binary file to buffer.
     void ReadBinary(ea::vector<unsigned char>& buffer);
@@ -126,7 +136,11 @@ private:
     /// Perform the file read internally using either C standard IO functions or SDL RWops for Android asset files. Return true if successful. This does not handle compressed package file reading.
     bool ReadInternal(void* dest, unsigned size);
     /// Seek in file internally using either C standard IO functions or SDL RWops for Android asset files.
-    void SeekInternal(unsigned newPosition);
+    void SeekInternal(unsigned long long newPosition);
+    /// Read from package file with block index. Return number of bytes actually read.
+    unsigned ReadBlocks(void* dest, unsigned size);
+    /// Read and decompress block of package file. Return true if successful.
+    bool LoadBlock(unsigned index);
 
     /// Absolute file name.
     ea::string absoluteFileName_;
@@ -147,11 +161,19 @@ private:
     /// Bytes in the current read buffer.
     unsigned readBufferSize_;
     /// Start position within a package file, 0 for regular files.
-    unsigned offset_;
+    unsigned long long offset_;
     /// Content checksum.
     unsigned checksum_;
     /// Compression flag.
     bool compressed_;
+    /// Compression of package file.
+    PackageCompression compression_{};
+    /// Size of uncompressed block of package file.
+    unsigned blockSize_{};
+    /// Offsets of compressed blocks of package file. Empty if blocks should be read sequentially.
+    ea::vector<unsigned long long> blockOffsets_;
+    /// Index of the block in the read buffer.
+    unsigned currentBlock_{M_MAX_UNSIGNED};
     /// Synchronization needed before read -flag.
     bool readSyncNeeded_;
     /// Synchronization needed before write -flag.
@@ -0,0 +1,176 @@
+// Copyright (c) 2024-2025 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/IO/MappedFile.h"
+
+#include "Urho3D/IO/File.h"
+#include "Urho3D/IO/FileSystem.h"
+
+#if defined(_WIN32) && !defined(UWP)
+    #include <windows.h>
+    #define URHO3D_MAPPED_FILE_WIN32
+#elif !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define URHO3D_MAPPED_FILE_POSIX
+#endif
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+#if defined(URHO3D_MAPPED_FILE_WIN32)
+unsigned long long GetMappingAlignment()
+{
+    SYSTEM_INFO info{};
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+}
+#elif defined(URHO3D_MAPPED_FILE_POSIX)
+unsigned long long GetMappingAlignment()
+{
+    return static_cast<unsigned long long>(sysconf(_SC_PAGESIZE));
+}
+#endif
+
+}
+
+SharedPtr<MappedFile> MappedFile::Open(const ea::string& fileName, unsigned long long offset, unsigned size)
+{
+    if (!size)
+        return nullptr;
+
+#ifdef __ANDROID__
+    // Assets are stored inside APK and cannot be mapped directly
+    if (URHO3D_IS_ASSET(fileName))
+        return nullptr;
+#endif
+
+#if defined(URHO3D_MAPPED_FILE_WIN32) || defined(URHO3D_MAPPED_FILE_POSIX)
+    // Mapping should start at page boundary
+    const unsigned long long alignment = GetMappingAlignment();
+    const unsigned long long mappingOffset = offset / alignment * alignment;
+    const auto dataOffset = static_cast<unsigned>(offset - mappingOffset);
+    const auto mappingSize = static_cast<size_t>(dataOffset + static_cast<unsigned long long>(size));
+#endif
+
+#if defined(URHO3D_MAPPED_FILE_WIN32)
+    HANDLE file = CreateFileW(GetWideNativePath(fileName).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || static_cast<unsigned long long>(fileSize.QuadPart) < offset + size)
+    {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE fileMapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!fileMapping)
+        return nullptr;
+
+    // View keeps the mapping alive
+    void* mapping = MapViewOfFile(fileMapping, FILE_MAP_READ, static_cast<DWORD>(mappingOffset >> 32),
+        static_cast<DWORD>(mappingOffset & 0xffffffffu), mappingSize);
+    CloseHandle(fileMapping);
+    if (!mapping)
+        return nullptr;
+
+    return SharedPtr<MappedFile>(new MappedFile(fileName, mapping, mappingSize, dataOffset, size));
+
+#elif defined(URHO3D_MAPPED_FILE_POSIX)
+    const int file = open(GetNativePath(fileName).c_str(), O_RDONLY);
+    if (file < 0)
+        return nullptr;
+
+    struct stat st{};
+    if (fstat(file, &st) != 0 || static_cast<unsigned long long>(st.st_size) < offset + size)
+    {
+        close(file);
+        return nullptr;
+    }
+
+    // Mapping stays valid after the file is closed
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, file, static_cast<off_t>(mappingOffset));
+    close(file);
+    if (mapping == MAP_FAILED)
+        return nullptr;
+
+    return SharedPtr<MappedFile>(new MappedFile(fileName, mapping, mappingSize, dataOffset, size));
+
+#else
+    return nullptr;
+#endif
+}
+
+SharedPtr<MappedFile> MappedFile::Open(const ea::string& fileName)
+{
+#if defined(URHO3D_MAPPED_FILE_WIN32)
+    WIN32_FILE_ATTRIBUTE_DATA data{};
+    if (!GetFileAttributesExW(GetWideNativePath(fileName).c_str(), GetFileExInfoStandard, &data))
+        return nullptr;
+    const unsigned long long fileSize = (static_cast<unsigned long long>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+#elif defined(URHO3D_MAPPED_FILE_POSIX)
+    struct stat st{};
+    if (stat(GetNativePath(fileName).c_str(), &st) != 0)
+        return nullptr;
+    const auto fileSize = static_cast<unsigned long long>(st.st_size);
+#else
+    const unsigned long long fileSize = 0;
+#endif
+
+    if (fileSize > M_MAX_UNSIGNED)
+        return nullptr;
+    return Open(fileName, 0, static_cast<unsigned>(fileSize));
+}
+
+bool MappedFile::IsSupported()
+{
+#if defined(URHO3D_MAPPED_FILE_WIN32) || defined(URHO3D_MAPPED_FILE_POSIX)
+    return true;
+#else
+    return false;
+#endif
+}
+
+MappedFile::MappedFile(const ea::string& fileName, void* mapping, size_t mappingSize, unsigned dataOffset, unsigned size)
+    : MemoryBuffer(static_cast<const unsigned char*>(mapping) + dataOffset, size)
+    , absoluteFileName_(fileName)
+    , mapping_(mapping)
+    , mappingSize_(mappingSize)
+{
+    name_ = fileName;
+}
+
+MappedFile::~MappedFile()
+{
+#if defined(URHO3D_MAPPED_FILE_WIN32)
+    UnmapViewOfFile(mapping_);
+#elif defined(URHO3D_MAPPED_FILE_POSIX)
+    munmap(mapping_, mappingSize_);
+#endif
+}
+
+unsigned MappedFile::GetChecksum()
+{
+    if (checksum_)
+        return checksum_;
+
+    for (const unsigned char value : GetContiguousData())
+        checksum_ = SDBMHash(checksum_, value);
+    return checksum_;
+}
+
+}
@@ -0,0 +1,51 @@
+// Copyright (c) 2024-2025 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Container/RefCounted.h"
+#include "Urho3D/IO/MemoryBuffer.h"
+
+namespace Urho3D
+{
+
+/// Read-only file mapped into memory.
+/// Content is accessible via GetContiguousData() without copying.
+/// Underlying file must not be truncated while mapped, access to truncated pages crashes the application.
+/// Only map files that are not modified by other processes, e.g. packages.
+class URHO3D_API MappedFile : public RefCounted, public MemoryBuffer
+{
+public:
+    /// Map part of the file. Return null if the file cannot be mapped.
+    static SharedPtr<MappedFile> Open(const ea::string& fileName, unsigned long long offset, unsigned size);
+    /// Map whole file. Return null if the file cannot be mapped or is bigger than 4GB.
+    static SharedPtr<MappedFile> Open(const ea::string& fileName);
+    /// Return whether memory mapping is supported on current platform.
+    static bool IsSupported();
+
+    /// Destruct and unmap.
+    ~MappedFile() override;
+
+    /// Return absolute file name in file system.
+    const ea::string& GetAbsoluteName() const override { return absoluteFileName_; }
+    /// Return a checksum of the file contents using the SDBM hash algorithm.
+    unsigned GetChecksum() override;
+    /// Mapped memory is read-only, writing always fails.
+    unsigned Write(const void*, unsigned) override { return 0; }
+
+private:
+    /// Construct from mapped memory.
+    MappedFile(const ea::string& fileName, void* mapping, size_t mappingSize, unsigned dataOffset, unsigned size);
+
+    /// Absolute file name.
+    ea::string absoluteFileName_;
+    /// Beginning of mapped memory, aligned to page size.
+    void* mapping_{};
+    /// Size of mapped memory.
+    size_t mappingSize_{};
+    /// Content checksum.
+    unsigned checksum_{};
+};
+
+}
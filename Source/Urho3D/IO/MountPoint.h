@@ -38,6 +38,9 @@ class URHO3D_API MountPoint : public Object
     URHO3D_OBJECT(MountPoint, Object);
 
 public:
+    /// Default minimum size of files that are memory mapped by mount points with immutable content, e.g. packages.
+    static constexpr unsigned DefaultMappedFileThreshold = 256 * 1024;
+
     /// Construct.
     explicit MountPoint(Context* context);
     /// Destruct.
@@ -78,6 +81,21 @@ public:
     /// Enumerate objects in the mount point. Only files enumeration is guaranteed to be supported.
     virtual void Scan(ea::vector<ea::string>& result, const ea::string& pathName, const ea::string& filter,
         ScanFlags flags) const = 0;
+
+    /// Set minimum size of files that are memory mapped when opened for reading, if supported by mount point.
+    /// Memory mapped files can be parsed without copying. 0 disables memory mapping.
+    /// Disabled by default for mount points with files that may be modified by other processes,
+    /// because accessing mapped memory of truncated file crashes the application.
+    void SetMappedFileThreshold(unsigned size) { mappedFileThreshold_ = size; }
+    /// Return minimum size of files that are memory mapped.
+    unsigned GetMappedFileThreshold() const { return mappedFileThreshold_; }
+
+protected:
+    /// Return whether the file of given size should be memory mapped.
+    bool ShouldMapFile(unsigned size) const { return mappedFileThreshold_ != 0 && size >= mappedFileThreshold_; }
+
+private:
+    unsigned mappedFileThreshold_{};
 };
 
 /// Base implementation of watchable mount point.
@@ -27,6 +27,7 @@
 #include "Urho3D/IO/File.h"
 #include "Urho3D/IO/FileSystem.h"
 #include "Urho3D/IO/Log.h"
+#include "Urho3D/IO/MappedFile.h"
 #include "Urho3D/Resource/ResourceEvents.h"
 
 namespace Urho3D
@@ -138,6 +139,16 @@ AbstractFilePtr MountedDirectory::OpenFile(const FileIdentifier& fileName, FileM
     if (!file->IsOpen())
         return nullptr;
 
+    // Map big files into memory so they can be parsed without copying
+    if (mode == FILE_READ && ShouldMapFile(file->GetSize()))
+    {
+        if (const auto mappedFile = MappedFile::Open(fullPath, 0, file->GetSize()))
+        {
+            mappedFile->SetName(fileName.ToUri());
+            return mappedFile;
+        }
+    }
+
     file->SetName(fileName.ToUri());
     return file;
 }
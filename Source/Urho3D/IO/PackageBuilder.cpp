@@ -0,0 +1,429 @@
+// Copyright (c) 2024-2025 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/IO/PackageBuilder.h"
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/Core/WorkQueue.h"
+#include "Urho3D/IO/File.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/IO/VectorBuffer.h"
+#include "Urho3D/Math/Hash.h"
+
+#include <LZ4/lz4.h>
+#include <LZ4/lz4hc.h>
+#include <zstd.h>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Size of package header: ID, number of files, checksum, version and file list offset.
+const unsigned PackageHeaderSize = 24;
+/// Current version of package format.
+const unsigned PackageVersion = 1;
+
+/// Return key that identifies stored data of the entry.
+unsigned long long GetContentKey(const PackageManifestEntry& entry)
+{
+    unsigned long long key = entry.contentHash_;
+    CombineHash(key, static_cast<unsigned long long>(entry.size_));
+    CombineHash(key, static_cast<unsigned long long>(entry.compression_));
+    CombineHash(key, static_cast<unsigned long long>(entry.blockSize_));
+    return key;
+}
+
+unsigned EstimateBlockBound(PackageCompression compression, unsigned size)
+{
+    switch (compression)
+    {
+    case PackageCompression::LZ4: return static_cast<unsigned>(LZ4_compressBound(static_cast<int>(size)));
+    case PackageCompression::ZSTD: return static_cast<unsigned>(ZSTD_compressBound(size));
+    default: return size;
+    }
+}
+
+/// Compress block and return compressed size, or 0 on error.
+unsigned CompressBlock(
+    PackageCompression compression, int level, void* dest, unsigned destSize, const void* src, unsigned srcSize)
+{
+    switch (compression)
+    {
+    case PackageCompression::LZ4:
+        return static_cast<unsigned>(LZ4_compress_HC(static_cast<const char*>(src), static_cast<char*>(dest),
+            static_cast<int>(srcSize), static_cast<int>(destSize), 0));
+
+    case PackageCompression::ZSTD:
+    {
+        const size_t result = ZSTD_compress(dest, destSize, src, srcSize, level);
+        return ZSTD_isError(result) ? 0 : static_cast<unsigned>(result);
+    }
+
+    default:
+        return 0;
+    }
+}
+
+}
+
+bool PackageManifest::Load(Deserializer& source)
+{
+    if (source.ReadFileID() != "RPKM" || source.IsEof())
+        return false;
+
+    // Entry is at least name terminator and fixed fields, so malformed count is rejected before allocation
+    static constexpr unsigned entryFieldsSize = 8 + 4 + 4 + 1 + 4;
+    const unsigned numEntries = source.ReadVLE();
+    if (numEntries > (source.GetSize() - source.GetPosition()) / (entryFieldsSize + 1))
+        return false;
+
+    entries_.resize(numEntries);
+    for (PackageManifestEntry& entry : entries_)
+    {
+        entry.name_ = source.ReadString();
+        if (source.GetSize() - source.GetPosition() < entryFieldsSize)
+        {
+            entries_.clear();
+            return false;
+        }
+
+        entry.contentHash_ = source.ReadUInt64();
+        entry.size_ = source.ReadUInt();
+        entry.checksum_ = source.ReadUInt();
+        entry.compression_ = static_cast<PackageCompression>(source.ReadUByte());
+        entry.blockSize_ = source.ReadUInt();
+    }
+    return true;
+}
+
+bool PackageManifest::Save(Serializer& dest) const
+{
+    bool success = dest.WriteFileID("RPKM");
+    success = success && dest.WriteVLE(entries_.size());
+    for (const PackageManifestEntry& entry : entries_)
+    {
+        success = success && dest.WriteString(entry.name_);
+        success = success && dest.WriteUInt64(entry.contentHash_);
+        success = success && dest.WriteUInt(entry.size_);
+        success = success && dest.WriteUInt(entry.checksum_);
+        success = success && dest.WriteUByte(static_cast<unsigned char>(entry.compression_));
+        success = success && dest.WriteUInt(entry.blockSize_);
+    }
+    return success;
+}
+
+PackageBuilder::PackageBuilder(Context* context)
+    : context_(context)
+    , workQueue_(context->GetSubsystem<WorkQueue>())
+{
+}
+
+PackageBuilder::~PackageBuilder() = default;
+
+void PackageBuilder::SetWorkQueue(WorkQueue* workQueue)
+{
+    workQueue_ = workQueue;
+}
+
+bool PackageBuilder::SetPreviousPackage(const ea::string& packageName, const ea::string& manifestName)
+{
+    previousPackage_ = nullptr;
+    previousEntries_.clear();
+    if (packageName.empty())
+        return false;
+
+    auto package = MakeShared<PackageFile>(context_);
+    if (!package->Open(packageName) || package->GetVersion() < 1)
+        return false;
+
+    File manifestFile(context_, manifestName);
+    PackageManifest manifest;
+    if (!manifestFile.IsOpen() || !manifest.Load(manifestFile))
+    {
+        URHO3D_LOGERROR("Could not load package manifest " + manifestName);
+        return false;
+    }
+
+    for (const PackageManifestEntry& entry : manifest.entries_)
+        previousEntries_.emplace(GetContentKey(entry), entry);
+    previousPackage_ = package;
+    return true;
+}
+
+bool PackageBuilder::Create(const ea::string& fileName, unsigned long long startOffset)
+{
+    // Keep existing content of the file if package is appended to it
+    file_ = MakeShared<File>(context_);
+    if (!file_->Open(fileName, startOffset ? FILE_READWRITE : FILE_WRITE, startOffset))
+    {
+        file_ = nullptr;
+        return false;
+    }
+
+    fileName_ = fileName;
+    startOffset_ = startOffset;
+    viewOffset_ = startOffset;
+    writeOffset_ = 0;
+    entries_.clear();
+    manifest_.entries_.clear();
+    totalDataSize_ = 0;
+    checksum_ = 0;
+    contentToEntry_.clear();
+    numDeduplicatedFiles_ = 0;
+    previousPackage_ = nullptr;
+    previousEntries_.clear();
+    numReusedFiles_ = 0;
+
+    // Header is written on build
+    const unsigned char header[PackageHeaderSize]{};
+    return WriteData(header, PackageHeaderSize);
+}
+
+void PackageBuilder::SetBlockSize(unsigned blockSize)
+{
+    blockSize_ = Clamp(blockSize, 1024u, 16u * 1024u * 1024u);
+}
+
+bool PackageBuilder::Append(
+    const ea::string& entryName, const void* data, unsigned size, PackageCompression compression)
+{
+    if (!file_)
+    {
+        URHO3D_LOGERROR("Package is not created");
+        return false;
+    }
+
+    const auto* bytes = static_cast<const unsigned char*>(data);
+
+    PackageEntry entry{};
+    entry.offset_ = writeOffset_;
+    entry.size_ = size;
+
+    // Content is hashed with 64-bit FNV-1a
+    PackageManifestEntry manifestEntry;
+    manifestEntry.name_ = entryName;
+    manifestEntry.contentHash_ = 14695981039346656037ull;
+    manifestEntry.size_ = size;
+    manifestEntry.compression_ = compression;
+    manifestEntry.blockSize_ = compression != PackageCompression::None ? blockSize_ : 0;
+    for (unsigned i = 0; i < size; ++i)
+    {
+        checksum_ = SDBMHash(checksum_, bytes[i]);
+        entry.checksum_ = SDBMHash(entry.checksum_, bytes[i]);
+        manifestEntry.contentHash_ = (manifestEntry.contentHash_ ^ bytes[i]) * 1099511628211ull;
+    }
+    manifestEntry.checksum_ = entry.checksum_;
+
+    // Identical files are stored only once
+    const unsigned long long contentKey = GetContentKey(manifestEntry);
+    const auto iter = contentToEntry_.find(contentKey);
+    if (iter != contentToEntry_.end() && manifest_.entries_[iter->second].IsSameContent(manifestEntry))
+    {
+        PackageEntry duplicateEntry = entries_[iter->second].second;
+        totalDataSize_ += size;
+        ++numDeduplicatedFiles_;
+        entries_.emplace_back(entryName, ea::move(duplicateEntry));
+        manifest_.entries_.push_back(manifestEntry);
+        return true;
+    }
+
+    if (!CopyFromPreviousPackage(entry, manifestEntry))
+    {
+        entry.compression_ = compression;
+        if (compression != PackageCompression::None && !CompressBlocks(entry, bytes, size))
+        {
+            entry.compression_ = PackageCompression::None;
+            entry.blockSize_ = 0;
+            entry.blockOffsets_.clear();
+        }
+    }
+
+    const bool success = entry.compression_ != PackageCompression::None
+        ? WriteData(compressBuffer_.data(), compressBuffer_.size())
+        : WriteData(bytes, size);
+    if (!success)
+    {
+        URHO3D_LOGERROR("Could not write file " + entryName + " to package " + fileName_);
+        return false;
+    }
+
+    entry.packedSize_ = writeOffset_ - entry.offset_;
+    totalDataSize_ += size;
+    contentToEntry_.emplace(contentKey, entries_.size());
+    entries_.emplace_back(entryName, ea::move(entry));
+    manifest_.entries_.push_back(manifestEntry);
+    return true;
+}
+
+bool PackageBuilder::Append(const ea::string& entryName, Deserializer& source, PackageCompression compression)
+{
+    ea::vector<unsigned char> buffer(source.GetSize() - source.GetPosition());
+    if (source.Read(buffer.data(), buffer.size()) != buffer.size())
+    {
+        URHO3D_LOGERROR("Could not read file " + entryName);
+        return false;
+    }
+
+    return Append(entryName, buffer.data(), buffer.size(), compression);
+}
+
+bool PackageBuilder::Build()
+{
+    if (!file_)
+    {
+        URHO3D_LOGERROR("Package is not created");
+        return false;
+    }
+
+    const unsigned long long fileListOffset = writeOffset_;
+
+    VectorBuffer fileList;
+    for (const auto& [name, entry] : entries_)
+    {
+        fileList.WriteString(name);
+        fileList.WriteUInt64(entry.offset_);
+        fileList.WriteUInt(entry.size_);
+        fileList.WriteUInt(entry.checksum_);
+        fileList.WriteUByte(static_cast<unsigned char>(entry.compression_));
+        if (entry.compression_ != PackageCompression::None)
+        {
+            fileList.WriteUInt(entry.blockSize_);
+            for (unsigned i = 0; i + 1 < entry.blockOffsets_.size(); ++i)
+                fileList.WriteVLE(static_cast<unsigned>(entry.blockOffsets_[i + 1] - entry.blockOffsets_[i]));
+        }
+    }
+
+    // Write package size to the end of file to allow finding it linked to an executable file.
+    // Packages bigger than 4GB should be opened with explicit start offset.
+    const unsigned long long packageSize = writeOffset_ + fileList.GetSize() + sizeof(unsigned);
+    fileList.WriteUInt(packageSize <= M_MAX_UNSIGNED ? static_cast<unsigned>(packageSize) : 0u);
+
+    if (!WriteData(fileList.GetData(), fileList.GetSize()))
+    {
+        URHO3D_LOGERROR("Could not write file list to package " + fileName_);
+        return false;
+    }
+
+    // Write header in the beginning of the package
+    bool success = file_->Open(fileName_, FILE_READWRITE, startOffset_);
+    success = success && file_->WriteFileID("RPAK");
+    success = success && file_->WriteUInt(entries_.size());
+    success = success && file_->WriteUInt(checksum_);
+    success = success && file_->WriteUInt(PackageVersion);
+    success = success && file_->WriteInt64(static_cast<long long>(fileListOffset));
+    file_ = nullptr;
+
+    if (!success)
+        URHO3D_LOGERROR("Could not write header to package " + fileName_);
+    return success;
+}
+
+bool PackageBuilder::WriteData(const void* data, unsigned size)
+{
+    // File views are limited to 4GB, so move the view forward when needed
+    const unsigned long long viewPosition = startOffset_ + writeOffset_ - viewOffset_;
+    if (viewPosition + size > M_MAX_UNSIGNED)
+    {
+        viewOffset_ = startOffset_ + writeOffset_;
+        if (!file_->Open(fileName_, FILE_READWRITE, viewOffset_))
+            return false;
+    }
+
+    if (size && file_->Write(data, size) != size)
+        return false;
+
+    writeOffset_ += size;
+    return true;
+}
+
+bool PackageBuilder::CompressBlocks(PackageEntry& entry, const unsigned char* data, unsigned size)
+{
+    const unsigned numBlocks = (size + blockSize_ - 1) / blockSize_;
+    const unsigned bound = EstimateBlockBound(entry.compression_, blockSize_);
+    blockBuffer_.resize(static_cast<size_t>(numBlocks) * bound);
+    blockSizes_.resize(numBlocks);
+
+    // Blocks are compressed independently, so the result doesn't depend on the number of threads
+    const auto compressBlocks = [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            const unsigned char* block = data + i * blockSize_;
+            const unsigned blockSize = Min(blockSize_, size - i * blockSize_);
+            unsigned char* dest = blockBuffer_.data() + static_cast<size_t>(i) * bound;
+
+            // Blocks that don't benefit from compression are stored as is
+            unsigned packedSize = CompressBlock(entry.compression_, compressionLevel_, dest, bound, block, blockSize);
+            if (!packedSize || packedSize >= blockSize)
+            {
+                memcpy(dest, block, blockSize);
+                packedSize = blockSize;
+            }
+            blockSizes_[i] = packedSize;
+        }
+    };
+
+    if (workQueue_)
+        ForEachParallel(workQueue_, 1, numBlocks, compressBlocks);
+    else
+        compressBlocks(0, numBlocks);
+
+    entry.blockSize_ = blockSize_;
+    entry.blockOffsets_.resize(numBlocks + 1);
+    entry.blockOffsets_[0] = 0;
+    compressBuffer_.clear();
+    for (unsigned i = 0; i < numBlocks; ++i)
+    {
+        const unsigned char* packedBlock = blockBuffer_.data() + static_cast<size_t>(i) * bound;
+        compressBuffer_.insert(compressBuffer_.end(), packedBlock, packedBlock + blockSizes_[i]);
+        entry.blockOffsets_[i + 1] = compressBuffer_.size();
+    }
+
+    return compressBuffer_.size() < size;
+}
+
+bool PackageBuilder::CopyFromPreviousPackage(PackageEntry& entry, const PackageManifestEntry& manifestEntry)
+{
+    if (!previousPackage_ || !manifestEntry.size_ || manifestEntry.compression_ == PackageCompression::None)
+        return false;
+
+    const auto iter = previousEntries_.find(GetContentKey(manifestEntry));
+    if (iter == previousEntries_.end() || !iter->second.IsSameContent(manifestEntry))
+        return false;
+
+    const PackageEntry* previousEntry = previousPackage_->GetEntry(iter->second.name_);
+    if (!previousEntry || previousEntry->size_ != manifestEntry.size_)
+        return false;
+
+    // Compression didn't help last time, store file as is
+    if (previousEntry->compression_ == PackageCompression::None)
+    {
+        entry.compression_ = PackageCompression::None;
+        ++numReusedFiles_;
+        return true;
+    }
+
+    File source(context_);
+    if (!source.Open(previousPackage_->GetName(), FILE_READ, previousEntry->offset_)
+        || previousEntry->packedSize_ > source.GetSize())
+        return false;
+
+    compressBuffer_.resize(previousEntry->packedSize_);
+    if (source.Read(compressBuffer_.data(), compressBuffer_.size()) != compressBuffer_.size())
+        return false;
+
+    entry.compression_ = previousEntry->compression_;
+    entry.blockSize_ = previousEntry->blockSize_;
+    entry.blockOffsets_ = previousEntry->blockOffsets_;
+    ++numReusedFiles_;
+    return true;
+}
+
+}
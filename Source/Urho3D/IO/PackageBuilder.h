@@ -0,0 +1,149 @@
+// Copyright (c) 2024-2025 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Container/Ptr.h"
+#include "Urho3D/IO/PackageFile.h"
+
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Deserializer;
+class File;
+class Serializer;
+class WorkQueue;
+
+/// Description of package file content used for incremental package builds.
+struct URHO3D_API PackageManifestEntry
+{
+    /// Name of the entry.
+    ea::string name_;
+    /// 64-bit hash of the uncompressed content.
+    unsigned long long contentHash_{};
+    /// Uncompressed size.
+    unsigned size_{};
+    /// Checksum of the uncompressed content.
+    unsigned checksum_{};
+    /// Requested compression. Entry may be stored uncompressed if compression doesn't reduce its size.
+    PackageCompression compression_{};
+    /// Size of compressed block.
+    unsigned blockSize_{};
+
+    /// Return whether the stored data of the entry can be reused for another entry.
+    bool IsSameContent(const PackageManifestEntry& other) const
+    {
+        return contentHash_ == other.contentHash_ && size_ == other.size_ && checksum_ == other.checksum_
+            && compression_ == other.compression_ && blockSize_ == other.blockSize_;
+    }
+};
+
+/// Manifest of package file, stored next to the package.
+struct URHO3D_API PackageManifest
+{
+    /// Entries in the order of appending.
+    ea::vector<PackageManifestEntry> entries_;
+
+    /// Load manifest from stream. Return true if successful.
+    bool Load(Deserializer& source);
+    /// Save manifest to stream. Return true if successful.
+    bool Save(Serializer& dest) const;
+};
+
+/// Writes package file of the latest version.
+/// Package may be bigger than 4GB, but each file in the package is limited to 4GB.
+class URHO3D_API PackageBuilder : private NonCopyable
+{
+public:
+    /// Default size of compressed block.
+    static constexpr unsigned DefaultBlockSize = 65536;
+
+    /// Construct.
+    explicit PackageBuilder(Context* context);
+    /// Destruct. Package is not finalized automatically.
+    ~PackageBuilder();
+
+    /// Create package file. Package may start at non-zero offset within existing file, e.g. when appended to executable.
+    bool Create(const ea::string& fileName, unsigned long long startOffset = 0);
+    /// Set size of uncompressed block. Smaller blocks make random access cheaper, bigger blocks compress better.
+    void SetBlockSize(unsigned blockSize);
+    /// Set ZSTD compression level, 0 is default level. LZ4 always uses high compression mode.
+    void SetCompressionLevel(int level) { compressionLevel_ = level; }
+    /// Set work queue used to compress blocks in parallel. Blocks are compressed in the calling thread if null.
+    /// Work queue subsystem is used by default. Output doesn't depend on the number of threads.
+    void SetWorkQueue(WorkQueue* workQueue);
+    /// Set previous version of the package. Files with unchanged content are copied from it without recompression.
+    /// Should be called after Create. Return true if both package and manifest are loaded. Empty name releases the package.
+    bool SetPreviousPackage(const ea::string& packageName, const ea::string& manifestName);
+
+    /// Append file. Compressed file is stored as is if compression doesn't reduce its size.
+    bool Append(const ea::string& entryName, const void* data, unsigned size, PackageCompression compression);
+    /// Append file with the remaining content of the stream.
+    bool Append(const ea::string& entryName, Deserializer& source, PackageCompression compression);
+    /// Write file list and header and close the file. Return true if successful.
+    bool Build();
+
+    /// Return written entries. Offsets are relative to the package start.
+    const ea::vector<ea::pair<ea::string, PackageEntry>>& GetEntries() const { return entries_; }
+    /// Return manifest of written entries.
+    const PackageManifest& GetManifest() const { return manifest_; }
+    /// Return number of files stored as references to identical files.
+    unsigned GetNumDeduplicatedFiles() const { return numDeduplicatedFiles_; }
+    /// Return number of files copied from previous version of the package.
+    unsigned GetNumReusedFiles() const { return numReusedFiles_; }
+    /// Return total size of the package written so far.
+    unsigned long long GetTotalSize() const { return writeOffset_; }
+    /// Return total size of uncompressed files.
+    unsigned long long GetTotalDataSize() const { return totalDataSize_; }
+    /// Return checksum of the package file contents.
+    unsigned GetChecksum() const { return checksum_; }
+
+private:
+    /// Write data at the end of the package.
+    bool WriteData(const void* data, unsigned size);
+    /// Compress file into blocks. Return false if compression doesn't reduce file size.
+    bool CompressBlocks(PackageEntry& entry, const unsigned char* data, unsigned size);
+    /// Copy stored data of the file from previous version of the package. Return false if not found.
+    bool CopyFromPreviousPackage(PackageEntry& entry, const PackageManifestEntry& manifestEntry);
+
+    Context* context_{};
+    SharedPtr<File> file_;
+    ea::string fileName_;
+    unsigned long long startOffset_{};
+    /// Offset of the file view used for writing. File views are limited to 4GB.
+    unsigned long long viewOffset_{};
+    /// Offset of the package end relative to the package start.
+    unsigned long long writeOffset_{};
+
+    unsigned blockSize_{DefaultBlockSize};
+    int compressionLevel_{};
+    WeakPtr<WorkQueue> workQueue_;
+
+    ea::vector<ea::pair<ea::string, PackageEntry>> entries_;
+    PackageManifest manifest_;
+    unsigned long long totalDataSize_{};
+    unsigned checksum_{};
+
+    /// Index of the first entry with given content hash.
+    ea::unordered_map<unsigned long long, unsigned> contentToEntry_;
+    unsigned numDeduplicatedFiles_{};
+
+    /// Previous version of the package.
+    SharedPtr<PackageFile> previousPackage_;
+    /// Entries of previous version of the package by content hash.
+    ea::unordered_map<unsigned long long, PackageManifestEntry> previousEntries_;
+    unsigned numReusedFiles_{};
+
+    /// Buffer for compressed blocks.
+    ea::vector<unsigned char> compressBuffer_;
+    /// Buffer for blocks compressed in parallel, one fixed size slot per block.
+    ea::vector<unsigned char> blockBuffer_;
+    /// Compressed sizes of blocks in parallel buffer.
+    ea::vector<unsigned> blockSizes_;
+};
+
+}
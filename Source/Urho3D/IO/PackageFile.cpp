@@ -24,12 +24,23 @@
 
 #include "../IO/File.h"
 #include "../IO/Log.h"
+#include "../IO/MappedFile.h"
 #include "../IO/PackageFile.h"
 #include "../IO/FileSystem.h"
 
 namespace Urho3D
 {
 
+namespace
+{
+
+bool IsPackageFileID(const ea::string& id)
+{
+    return id == "UPAK" || id == "ULZ4" || id == "RPAK" || id == "RLZ4";
+}
+
+}
+
 PackageFile::PackageFile(Context* context) :
     MountPoint(context),
     totalSize_(0),
@@ -37,86 +48,179 @@ PackageFile::PackageFile(Context* context) :
     checksum_(0),
     compressed_(false)
 {
+    SetMappedFileThreshold(DefaultMappedFileThreshold);
 }
 
-PackageFile::PackageFile(Context* context, const ea::string& fileName, unsigned startOffset) :
+PackageFile::PackageFile(Context* context, const ea::string& fileName, unsigned long long startOffset) :
     MountPoint(context),
     totalSize_(0),
     totalDataSize_(0),
     checksum_(0),
     compressed_(false)
 {
+    SetMappedFileThreshold(DefaultMappedFileThreshold);
     Open(fileName, startOffset);
 }
 
 PackageFile::~PackageFile() = default;
 
-bool PackageFile::Open(const ea::string& fileName, unsigned startOffset)
+bool PackageFile::Open(const ea::string& fileName, unsigned long long startOffset)
 {
-    auto file = MakeShared<File>(context_, fileName);
-    if (!file->IsOpen())
+    // Package may be bigger than 4GB, so it's read via file views
+    auto file = MakeShared<File>(context_);
+    if (!file->Open(fileName, FILE_READ, startOffset))
         return false;
 
     // Check ID, then read the directory
-    file->Seek(startOffset);
     ea::string id = file->ReadFileID();
-    if (id != "UPAK" && id != "ULZ4" && id != "RPAK" && id != "RLZ4")
+    if (!IsPackageFileID(id))
     {
         // If start offset has not been explicitly specified, also try to read package size from the end of file
         // to know how much we must rewind to find the package start
-        if (!startOffset)
+        const unsigned long long fileSize = file->GetUnderlyingSize();
+        if (!startOffset && fileSize >= sizeof(unsigned))
         {
-            unsigned fileSize = file->GetSize();
-            file->Seek((unsigned)(fileSize - sizeof(unsigned)));
-            unsigned newStartOffset = fileSize - file->ReadUInt();
-            if (newStartOffset < fileSize)
+            file->Open(fileName, FILE_READ, fileSize - sizeof(unsigned));
+            const unsigned packageSize = file->ReadUInt();
+            if (packageSize > 0 && packageSize <= fileSize)
             {
-                startOffset = newStartOffset;
-                file->Seek(startOffset);
+                startOffset = fileSize - packageSize;
+                file->Open(fileName, FILE_READ, startOffset);
                 id = file->ReadFileID();
             }
         }
 
-        if (id != "UPAK" && id != "ULZ4" && id != "RPAK" && id != "RLZ4")
+        if (!IsPackageFileID(id))
         {
             URHO3D_LOGERROR(fileName + " is not a valid package file");
             return false;
         }
     }
 
+    entries_.clear();
     fileName_ = fileName;
     nameHash_ = fileName_;
-    totalSize_ = file->GetSize();
+    totalSize_ = file->GetUnderlyingSize();
+    totalDataSize_ = 0;
     compressed_ = id == "ULZ4" || id == "RLZ4";
+    version_ = 0;
     unsigned numFiles = file->ReadUInt();
     checksum_ = file->ReadUInt();
 
+    // Legacy packages have file data after the file list, with package size in the end of the file
+    unsigned long long dataEnd = totalSize_ - sizeof(unsigned);
     if (id == "RPAK" || id == "RLZ4")
     {
         // New PAK file format includes two extra PAK header fields:
-        // * Version. At this time this field is unused and is always 0. It will be used in the future if PAK format needs to be extended.
+        // * Version. Version 0 uses 32-bit offsets and sequentially compressed files. Version 1 uses 64-bit offsets,
+        //   per-file compression and block index for each compressed file.
         // * File list offset. New format writes file list in the end of the file. This allows PAK creation without knowing entire file list
         //   beforehand.
-        unsigned version = file->ReadUInt();                        // Reserved for future use.
-        assert(version == 0);
-        int64_t fileListOffset = file->ReadInt64();                 // New format has file list at the end of the file.
-        file->Seek(static_cast<unsigned>(fileListOffset));                                 // TODO: Serializer/Deserializer do not support files bigger than 4 GB
+        version_ = file->ReadUInt();
+        if (version_ > 1)
+        {
+            URHO3D_LOGERROR("Unsupported version {} of package file {}", version_, fileName);
+            return false;
+        }
+
+        // Version 0 stores absolute offset of the file list, version 1 stores offset from the package start
+        const auto fileListOffset = static_cast<unsigned long long>(file->ReadInt64());
+        dataEnd = version_ == 0 ? fileListOffset : startOffset + fileListOffset;
+        file->Open(fileName, FILE_READ, dataEnd);
     }
 
+    if (version_ == 0)
+        return ReadLegacyEntries(*file, numFiles, startOffset, dataEnd);
+    else
+        return ReadEntries(*file, numFiles, startOffset);
+}
+
+bool PackageFile::ReadLegacyEntries(File& file, unsigned numFiles, unsigned long long startOffset, unsigned long long dataEnd)
+{
+    ea::vector<PackageEntry*> entriesByOffset;
     for (unsigned i = 0; i < numFiles; ++i)
     {
-        ea::string entryName = file->ReadString();
+        ea::string entryName = file.ReadString();
         PackageEntry newEntry{};
-        newEntry.offset_ = file->ReadUInt() + startOffset;
-        totalDataSize_ += (newEntry.size_ = file->ReadUInt());
-        newEntry.checksum_ = file->ReadUInt();
+        newEntry.offset_ = file.ReadUInt() + startOffset;
+        totalDataSize_ += (newEntry.size_ = file.ReadUInt());
+        newEntry.checksum_ = file.ReadUInt();
+        newEntry.compression_ = compressed_ ? PackageCompression::LZ4 : PackageCompression::None;
+        newEntry.packedSize_ = newEntry.size_;
         if (!compressed_ && newEntry.offset_ + newEntry.size_ > totalSize_)
         {
             URHO3D_LOGERROR("File entry " + entryName + " outside package file");
             return false;
         }
         else
-            entries_[entryName] = newEntry;
+            entriesByOffset.push_back(&(entries_[entryName] = newEntry));
+    }
+
+    // Compressed files are stored back to back, so packed size is the distance to the next file
+    if (compressed_)
+    {
+        ea::sort(entriesByOffset.begin(), entriesByOffset.end(),
+            [](const PackageEntry* lhs, const PackageEntry* rhs) { return lhs->offset_ < rhs->offset_; });
+        for (unsigned i = 0; i < entriesByOffset.size(); ++i)
+        {
+            const unsigned long long nextOffset =
+                i + 1 < entriesByOffset.size() ? entriesByOffset[i + 1]->offset_ : dataEnd;
+            entriesByOffset[i]->packedSize_ = nextOffset - entriesByOffset[i]->offset_;
+        }
+    }
+
+    return true;
+}
+
+bool PackageFile::ReadEntries(File& file, unsigned numFiles, unsigned long long startOffset)
+{
+    for (unsigned i = 0; i < numFiles; ++i)
+    {
+        ea::string entryName = file.ReadString();
+        PackageEntry newEntry{};
+        newEntry.offset_ = file.ReadUInt64() + startOffset;
+        totalDataSize_ += (newEntry.size_ = file.ReadUInt());
+        newEntry.checksum_ = file.ReadUInt();
+        newEntry.compression_ = static_cast<PackageCompression>(file.ReadUByte());
+
+        switch (newEntry.compression_)
+        {
+        case PackageCompression::None:
+            newEntry.packedSize_ = newEntry.size_;
+            break;
+
+        case PackageCompression::LZ4:
+        case PackageCompression::ZSTD:
+        {
+            newEntry.blockSize_ = file.ReadUInt();
+            if (!newEntry.blockSize_)
+            {
+                URHO3D_LOGERROR("File entry " + entryName + " has invalid block size");
+                return false;
+            }
+
+            const unsigned numBlocks = (newEntry.size_ + newEntry.blockSize_ - 1) / newEntry.blockSize_;
+            newEntry.blockOffsets_.resize(numBlocks + 1);
+            newEntry.blockOffsets_[0] = 0;
+            for (unsigned j = 0; j < numBlocks; ++j)
+                newEntry.blockOffsets_[j + 1] = newEntry.blockOffsets_[j] + file.ReadVLE();
+            newEntry.packedSize_ = newEntry.blockOffsets_.back();
+            compressed_ = true;
+            break;
+        }
+
+        default:
+            URHO3D_LOGERROR("File entry " + entryName + " has unknown compression");
+            return false;
+        }
+
+        if (newEntry.offset_ + newEntry.packedSize_ > totalSize_)
+        {
+            URHO3D_LOGERROR("File entry " + entryName + " outside package file");
+            return false;
+        }
+
+        entries_[entryName] = ea::move(newEntry);
     }
 
     return true;
@@ -220,6 +324,17 @@ AbstractFilePtr PackageFile::OpenFile(const FileIdentifier& fileName, FileMode m
     if (!Exists(fileName.fileName_))
         return {};
 
+    // Map big uncompressed files into memory so they can be parsed without copying
+    const PackageEntry* entry = GetEntry(fileName.fileName_);
+    if (entry->compression_ == PackageCompression::None && ShouldMapFile(entry->size_))
+    {
+        if (const auto mappedFile = MappedFile::Open(fileName_, entry->offset_, entry->size_))
+        {
+            mappedFile->SetName(fileName.ToUri());
+            return mappedFile;
+        }
+    }
+
     auto file = MakeShared<File>(context_, this, fileName.fileName_);
     file->SetName(fileName.ToUri());
     return file;
@@ -28,15 +28,34 @@
 namespace Urho3D
 {
 
+class File;
+
+/// Compression of the package entry data.
+enum class PackageCompression : unsigned char
+{
+    None,
+    LZ4,
+    ZSTD,
+};
+
 /// %File entry within the package file.
 struct PackageEntry
 {
     /// Offset from the beginning.
-    unsigned offset_;
+    unsigned long long offset_;
     /// File size.
     unsigned size_;
     /// File checksum.
     unsigned checksum_;
+    /// Compression of the entry data.
+    PackageCompression compression_{};
+    /// Size of the entry data stored in the package.
+    unsigned long long packedSize_{};
+    /// Size of uncompressed block. Only used by compressed entries.
+    unsigned blockSize_{};
+    /// Offsets of compressed blocks relative to the entry offset, with the end of the last block appended.
+    /// Empty for compressed entries of legacy packages, which can only be read sequentially.
+    ea::vector<unsigned long long> blockOffsets_;
 };
 
 /// Stores files of a directory tree sequentially for convenient access.
@@ -48,12 +67,12 @@ public:
     /// Construct.
     explicit PackageFile(Context* context);
     /// Construct and open.
-    PackageFile(Context* context, const ea::string& fileName, unsigned startOffset = 0);
+    PackageFile(Context* context, const ea::string& fileName, unsigned long long startOffset = 0);
     /// Destruct.
     ~PackageFile() override;
 
     /// Open the package file. Return true if successful.
-    bool Open(const ea::string& fileName, unsigned startOffset = 0);
+    bool Open(const ea::string& fileName, unsigned long long startOffset = 0);
     /// Check if a file exists within the package file. This will be case-insensitive on Windows and case-sensitive on other platforms.
     bool Exists(const ea::string& fileName) const;
     /// Return the file entry corresponding to the name, or null if not found. This will be case-insensitive on Windows and case-sensitive on other platforms.
@@ -71,20 +90,23 @@ public:
 
     /// Return total size of the package file.
     /// @property
-    unsigned GetTotalSize() const { return totalSize_; }
+    unsigned long long GetTotalSize() const { return totalSize_; }
 
     /// Return total data size from all the file entries in the package file.
     /// @property
-    unsigned GetTotalDataSize() const { return totalDataSize_; }
+    unsigned long long GetTotalDataSize() const { return totalDataSize_; }
 
     /// Return checksum of the package file contents.
     /// @property
     unsigned GetChecksum() const { return checksum_; }
 
-    /// Return whether the files are compressed.
+    /// Return whether any of the files are compressed.
     /// @property
     bool IsCompressed() const { return compressed_; }
 
+    /// Return package format version. Version 1 supports 64-bit offsets and random access to compressed files.
+    unsigned GetVersion() const { return version_; }
+
     /// Return list of file names in the package.
     const ea::vector<ea::string> GetEntryNames() const { return entries_.keys(); }
 
@@ -115,6 +137,11 @@ public:
     /// @}
 
 private:
+    /// Read file list of version 0 package.
+    bool ReadLegacyEntries(File& file, unsigned numFiles, unsigned long long startOffset, unsigned long long dataEnd);
+    /// Read file list of version 1 package.
+    bool ReadEntries(File& file, unsigned numFiles, unsigned long long startOffset);
+
     /// File entries.
     ea::unordered_map<ea::string, PackageEntry> entries_;
     /// File name.
@@ -122,13 +149,15 @@ private:
     /// Package file name hash.
     StringHash nameHash_;
     /// Package file total size.
-    unsigned totalSize_;
+    unsigned long long totalSize_;
     /// Total data size in the package using each entry's actual size if it is a compressed package file.
-    unsigned totalDataSize_;
+    unsigned long long totalDataSize_;
     /// Package file checksum.
     unsigned checksum_;
     /// Compressed flag.
     bool compressed_;
+    /// Package format version.
+    unsigned version_{};
 };
 
 }
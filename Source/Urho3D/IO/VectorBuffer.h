@@ -50,6 +50,8 @@ public:
     unsigned Seek(unsigned position) override;
     /// Write bytes to the buffer. Return number of bytes actually written.
     unsigned Write(const void* data, unsigned size) override;
+    /// Return buffer content as span.
+    ConstByteSpan GetContiguousData() const override { return {GetData(), size_}; }
 
     /// Set data from another buffer.
     void SetData(const ByteVector& data);
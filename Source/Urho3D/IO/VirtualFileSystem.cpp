@@ -9,6 +9,8 @@
 
 #include "Urho3D/Core/Context.h"
 #include "Urho3D/Core/CoreEvents.h"
+#include "Urho3D/Core/WorkQueue.h"
+#include "Urho3D/IO/File.h"
 #include "Urho3D/IO/FileSystem.h"
 #include "Urho3D/IO/Log.h"
 #include "Urho3D/IO/MountPoint.h"
@@ -17,10 +19,52 @@
 #include "Urho3D/IO/PackageFile.h"
 
 #include <EASTL/bonus/adaptors.h>
+#include <EASTL/sort.h>
 
 namespace Urho3D
 {
 
+namespace
+{
+
+/// Gap between ranges that is read instead of issuing separate read.
+const unsigned MaxCoalescingGap = 4096;
+/// Max size of merged read.
+const unsigned MaxCoalescedReadSize = 16 * 1024 * 1024;
+
+/// Range of asynchronous read in the underlying file.
+struct PhysicalRange
+{
+    ea::string fileName_;
+    unsigned long long offset_{};
+    AsyncReadRequest* request_{};
+};
+
+}
+
+AsyncReadRequest::AsyncReadRequest(
+    const FileIdentifier& fileName, unsigned offset, unsigned size, AsyncReadCallback callback)
+    : fileName_(fileName)
+    , offset_(offset)
+    , size_(size)
+    , callback_(ea::move(callback))
+{
+}
+
+void AsyncReadRequest::Complete(bool succeeded)
+{
+    succeeded_ = succeeded;
+    if (!succeeded_)
+        data_.clear();
+
+    // Request is already completed when observed from its own callback
+    const AsyncReadCallback callback = ea::move(callback_);
+    callback_ = nullptr;
+    completed_.store(true, std::memory_order_release);
+    if (callback)
+        callback(this);
+}
+
 VirtualFileSystem::VirtualFileSystem(Context* context)
     : Object(context)
 {
@@ -277,6 +321,125 @@ bool VirtualFileSystem::WriteAllText(const FileIdentifier& fileName, const ea::s
     return file->Write(text.data(), text.length()) == text.length();
 }
 
+SharedPtr<AsyncReadRequest> VirtualFileSystem::ReadAsync(
+    const FileIdentifier& fileName, unsigned offset, unsigned size, AsyncReadCallback callback)
+{
+    auto request = MakeShared<AsyncReadRequest>(fileName, offset, size, ea::move(callback));
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (!workQueue)
+    {
+        {
+            MutexLock lock(asyncReadMutex_);
+            pendingReads_.push_back(request);
+        }
+        ProcessAsyncReads();
+        return request;
+    }
+
+    MutexLock lock(asyncReadMutex_);
+    pendingReads_.push_back(request);
+    if (!asyncReadTaskPosted_)
+    {
+        asyncReadTaskPosted_ = true;
+        workQueue->PostTask([weakSelf = WeakPtr<VirtualFileSystem>(this)]()
+        {
+            if (auto self = weakSelf.Lock())
+                self->ProcessAsyncReads();
+        }, TaskPriority::Low);
+    }
+    return request;
+}
+
+void VirtualFileSystem::ProcessAsyncReads()
+{
+    ea::vector<SharedPtr<AsyncReadRequest>> requests;
+    {
+        MutexLock lock(asyncReadMutex_);
+        requests.swap(pendingReads_);
+        asyncReadTaskPosted_ = false;
+    }
+
+    // Uncompressed files from packages are read directly from the package, other files are read one by one.
+    // Big package entries are memory mapped, they are copied from memory and never coalesced.
+    ea::vector<PhysicalRange> ranges;
+    for (AsyncReadRequest* request : requests)
+    {
+        const AbstractFilePtr file = OpenFile(request->fileName_, FILE_READ);
+        if (!file || request->offset_ > file->GetSize())
+        {
+            request->Complete(false);
+            continue;
+        }
+
+        request->size_ = ea::min(request->size_, file->GetSize() - request->offset_);
+        request->data_.resize(request->size_);
+
+        const ConstByteSpan mappedData = file->GetContiguousData();
+        if (!mappedData.empty())
+        {
+            if (request->size_ > 0)
+                memcpy(request->data_.data(), mappedData.data() + request->offset_, request->size_);
+            numMappedReads_.fetch_add(1, std::memory_order_relaxed);
+            request->Complete(true);
+            continue;
+        }
+
+        const auto packagedFile = dynamic_cast<File*>(file.Get());
+        if (packagedFile && packagedFile->IsPackaged() && !packagedFile->IsCompressed())
+        {
+            ranges.push_back({packagedFile->GetAbsoluteName(), packagedFile->GetOffset() + request->offset_, request});
+            continue;
+        }
+
+        const bool succeeded = file->Seek(request->offset_) == request->offset_
+            && file->Read(request->data_.data(), request->size_) == request->size_;
+        request->Complete(succeeded);
+    }
+
+    ea::sort(ranges.begin(), ranges.end(), [](const PhysicalRange& lhs, const PhysicalRange& rhs)
+    {
+        return ea::tie(lhs.fileName_, lhs.offset_) < ea::tie(rhs.fileName_, rhs.offset_);
+    });
+
+    ByteVector buffer;
+    for (unsigned first = 0; first < ranges.size();)
+    {
+        // Merge ranges that are adjacent or close to each other
+        const unsigned long long beginOffset = ranges[first].offset_;
+        unsigned long long endOffset = beginOffset + ranges[first].request_->size_;
+        unsigned last = first + 1;
+        for (; last < ranges.size(); ++last)
+        {
+            const PhysicalRange& range = ranges[last];
+            const unsigned long long rangeEnd = range.offset_ + range.request_->size_;
+            if (range.fileName_ != ranges[first].fileName_ || range.offset_ > endOffset + MaxCoalescingGap
+                || ea::max(endOffset, rangeEnd) - beginOffset > MaxCoalescedReadSize)
+                break;
+            endOffset = ea::max(endOffset, rangeEnd);
+        }
+
+        if (last - first > 1)
+            numCoalescedReads_.fetch_add(last - first, std::memory_order_relaxed);
+
+        const auto readSize = static_cast<unsigned>(endOffset - beginOffset);
+        buffer.resize(readSize);
+
+        File source(context_);
+        const bool succeeded = source.Open(ranges[first].fileName_, FILE_READ, beginOffset)
+            && source.Read(buffer.data(), readSize) == readSize;
+
+        for (unsigned i = first; i < last; ++i)
+        {
+            AsyncReadRequest* request = ranges[i].request_;
+            if (succeeded && request->size_ > 0)
+                memcpy(request->data_.data(), &buffer[ranges[i].offset_ - beginOffset], request->size_);
+            request->Complete(succeeded);
+        }
+        first = last;
+    }
+}
+
 FileTime VirtualFileSystem::GetLastModifiedTime(const FileIdentifier& fileName, bool creationIsModification) const
 {
     MutexLock lock(mountMutex_);
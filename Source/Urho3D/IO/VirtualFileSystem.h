@@ -10,9 +10,53 @@
 #include "Urho3D/IO/MountPoint.h"
 #include "Urho3D/IO/MountedAliasRoot.h"
 
+#include <atomic>
+
 namespace Urho3D
 {
 
+class AsyncReadRequest;
+
+/// Callback of asynchronous file read. Invoked from the thread that performed the read.
+using AsyncReadCallback = ea::function<void(AsyncReadRequest* request)>;
+
+/// Asynchronous read of file range. Data should not be accessed until the request is completed.
+class URHO3D_API AsyncReadRequest : public RefCounted
+{
+    friend class VirtualFileSystem;
+
+public:
+    /// Construct.
+    AsyncReadRequest(const FileIdentifier& fileName, unsigned offset, unsigned size, AsyncReadCallback callback);
+
+    /// Return file name.
+    const FileIdentifier& GetFileName() const { return fileName_; }
+    /// Return offset of the range within the file.
+    unsigned GetOffset() const { return offset_; }
+    /// Return whether the request is completed.
+    bool IsCompleted() const { return completed_.load(std::memory_order_acquire); }
+    /// Return whether the file is found and the range is read.
+    bool IsSucceeded() const { return succeeded_; }
+    /// Return read data. The range is clamped to the end of the file.
+    const ByteVector& GetData() const { return data_; }
+    /// Take ownership of read data.
+    ByteVector TakeData() { return ea::move(data_); }
+
+private:
+    /// Store result and notify the caller.
+    void Complete(bool succeeded);
+
+    const FileIdentifier fileName_;
+    const unsigned offset_{};
+    /// Requested size. Resolved to the actual size before read.
+    unsigned size_{};
+    AsyncReadCallback callback_;
+
+    ByteVector data_;
+    bool succeeded_{};
+    std::atomic_bool completed_{};
+};
+
 /// Subsystem for virtual file system.
 class URHO3D_API VirtualFileSystem : public Object
 {
@@ -65,6 +109,14 @@ public:
     ea::string ReadAllText(const FileIdentifier& fileName) const;
     /// Write text file to the virtual file system. Returns true if file is written successfully.
     bool WriteAllText(const FileIdentifier& fileName, const ea::string& text) const;
+    /// Read range of the file on WorkQueue threads. Reads posted together are batched,
+    /// adjacent ranges of the same package are read with single request.
+    SharedPtr<AsyncReadRequest> ReadAsync(const FileIdentifier& fileName, unsigned offset = 0,
+        unsigned size = M_MAX_UNSIGNED, AsyncReadCallback callback = nullptr);
+    /// Return total number of asynchronous reads that were merged with other reads.
+    unsigned GetNumCoalescedReads() const { return numCoalescedReads_.load(std::memory_order_relaxed); }
+    /// Return total number of asynchronous reads that were copied from memory mapped files.
+    unsigned GetNumMappedReads() const { return numMappedReads_.load(std::memory_order_relaxed); }
     /// Return modification time. Return 0 if not supported or file doesn't exist.
     FileTime GetLastModifiedTime(const FileIdentifier& fileName, bool creationIsModification) const;
     /// Return absolute file name for *existing* identifier in this mount point, if supported.
@@ -91,6 +143,8 @@ public:
 private:
     /// Return or create internal alias:// mount point.
     MountedAliasRoot* GetOrCreateAliasRoot();
+    /// Perform all pending asynchronous reads.
+    void ProcessAsyncReads();
 
     /// Mutex for thread-safe access to the mount points.
     mutable Mutex mountMutex_;
@@ -100,6 +154,17 @@ private:
     SharedPtr<MountedAliasRoot> aliasMountPoint_;
     /// Are file watchers enabled.
     bool isWatching_{};
+
+    /// Mutex for pending asynchronous reads.
+    Mutex asyncReadMutex_;
+    /// Asynchronous reads waiting for processing.
+    ea::vector<SharedPtr<AsyncReadRequest>> pendingReads_;
+    /// Whether the task that processes pending reads is posted.
+    bool asyncReadTaskPosted_{};
+    /// Number of asynchronous reads that were merged with other reads.
+    std::atomic<unsigned> numCoalescedReads_{};
+    /// Number of asynchronous reads that were copied from memory mapped files.
+    std::atomic<unsigned> numMappedReads_{};
 };
 
 /// Helper class to mount and unmount an object automatically.
@@ -39,13 +39,25 @@ void AbstractConnection::SendMessage(
         return;
     }
 
-    SendMessageInternal(messageId, payload.data(), payload.size(), packetType);
+    if (isSendDeferred_)
+    {
+        deferredMessages_.push_back(DeferredMessage{messageId, packetType, deferredMessagesData_.size(), payload.size()});
+        deferredMessagesData_.insert(deferredMessagesData_.end(), payload.begin(), payload.end());
+    }
+    else
+        SendMessageInternal(messageId, payload.data(), payload.size(), packetType);
+
+    LogMessageSent(messageId, payload.size(), packetType, debugInfo);
+}
 
+void AbstractConnection::LogMessageSent(
+    NetworkMessageId messageId, unsigned numBytes, PacketTypeFlags packetType, ea::string_view debugInfo) const
+{
     const LogLevel logLevel = GetMessageLogLevel(messageId);
     if (logLevel != LOG_NONE)
     {
-        Log::GetLogger().Write(GetMessageLogLevel(messageId), "{}: Message #{} ({} bytes) sent{}{}{}{}", ToString(),
-            static_cast<unsigned>(messageId), payload.size(), (packetType & PacketType::Reliable) ? ", reliable" : "",
+        Log::GetLogger().Write(logLevel, "{}: Message #{} ({} bytes) sent{}{}{}{}", ToString(),
+            static_cast<unsigned>(messageId), numBytes, (packetType & PacketType::Reliable) ? ", reliable" : "",
             (packetType & PacketType::Ordered) ? ", ordered" : "", debugInfo.empty() ? "" : ": ", debugInfo);
     }
 }
@@ -56,6 +68,20 @@ void AbstractConnection::SendMessage(
     SendMessage(messageId, msg.GetBuffer(), packetType, debugInfo);
 }
 
+void AbstractConnection::FlushDeferredMessages()
+{
+    isSendDeferred_ = false;
+
+    for (const DeferredMessage& message : deferredMessages_)
+    {
+        SendMessageInternal(
+            message.messageId_, deferredMessagesData_.data() + message.offset_, message.size_, message.packetType_);
+    }
+
+    deferredMessages_.clear();
+    deferredMessagesData_.clear();
+}
+
 void AbstractConnection::LogMessagePayload(NetworkMessageId messageId, ea::string_view debugInfo) const
 {
     const LogLevel logLevel = GetMessageLogLevel(messageId);
@@ -73,6 +99,7 @@ LogLevel AbstractConnection::GetMessageLogLevel(NetworkMessageId messageId) cons
         MSG_CONNECTION_LIMIT_EXCEEDED,
         MSG_SCENELOADED,
         MSG_REQUESTPACKAGE,
+        MSG_COMPRESSION_DICTIONARY,
 
         MSG_LOADSCENE,
         MSG_SCENECHECKSUMERROR,
@@ -33,8 +33,13 @@ public:
     /// @{
     unsigned GetMaxPacketSize() const;
     unsigned GetMaxMessageSize() const;
+    unsigned GetBandwidthLimit() const { return bandwidthLimit_; }
     /// @}
 
+    /// Set bandwidth available for the connection in bytes per second, e.g. measured by transport or configured by user.
+    /// Server uses it to budget unreliable updates of replicated objects. Zero means unlimited.
+    void SetBandwidthLimit(unsigned bytesPerSecond) { bandwidthLimit_ = bytesPerSecond; }
+
     /// Set maximum size of network packet. Connection transport may override this value.
     virtual void SetMaxPacketSize(unsigned limit);
     /// Send message to the other end of the connection.
@@ -53,6 +58,8 @@ public:
     virtual unsigned GetLocalTimeOfLatestRoundtrip() const = 0;
     /// Return ping of the connection.
     virtual unsigned GetPing() const = 0;
+    /// Disconnect from the other end of the connection.
+    virtual void Disconnect() = 0;
 
     /// Syntax sugar for sending and receiving messages.
     /// @{
@@ -72,6 +79,15 @@ public:
 
     LogLevel GetMessageLogLevel(NetworkMessageId messageId) const;
 
+    /// Defer sending of messages until FlushDeferredMessages is called.
+    /// Messages of single connection may be written from any thread while sending is deferred,
+    /// as long as only one thread at a time writes to the connection.
+    void BeginDeferredSend() { isSendDeferred_ = true; }
+    /// Pass deferred messages to transport in order and stop deferring.
+    void FlushDeferredMessages();
+    /// Return whether sending of messages is deferred.
+    bool IsSendDeferred() const { return isSendDeferred_; }
+
 #ifndef SWIG
     VectorBuffer& GetOutgoingMessageBuffer() { return msg_; }
     ByteVector& GetIncomingMessageBuffer() { return incomingMessageBuffer_; }
@@ -80,12 +96,28 @@ public:
     /// @}
 
 protected:
+    void LogMessageSent(NetworkMessageId messageId, unsigned numBytes, PacketTypeFlags packetType,
+        ea::string_view debugInfo = {}) const;
+
     VectorBuffer msg_;
 
 private:
+    struct DeferredMessage
+    {
+        NetworkMessageId messageId_{};
+        PacketTypeFlags packetType_{};
+        unsigned offset_{};
+        unsigned size_{};
+    };
+
     unsigned maxPacketSize_{};
+    unsigned bandwidthLimit_{};
     bool logAllMessages_{};
 
+    bool isSendDeferred_{};
+    ea::vector<DeferredMessage> deferredMessages_;
+    ByteVector deferredMessagesData_;
+
     ByteVector incomingMessageBuffer_;
     ea::string debugInfoBuffer_;
 };
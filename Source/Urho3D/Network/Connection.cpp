@@ -21,6 +21,7 @@
 #include "Urho3D/Network/MessageUtils.h"
 #include "Urho3D/Network/Network.h"
 #include "Urho3D/Network/NetworkEvents.h"
+#include "Urho3D/Network/PacketCompression.h"
 #include "Urho3D/Network/Protocol.h"
 #include "Urho3D/Network/Transport/NetworkConnection.h"
 #include "Urho3D/Replica/ReplicationManager.h"
@@ -50,6 +51,15 @@ static constexpr unsigned PackageFragmentHeaderSize = 8;
 static constexpr unsigned PACKAGE_FRAGMENT_SIZE =
     MaxNetworkPacketSize - PackageFragmentHeaderSize - NetworkMessageHeaderSize;
 
+/// Size of compressed packet header: message header and original packet size.
+static constexpr unsigned CompressedPacketHeaderSize = NetworkMessageHeaderSize + 2;
+
+void WriteUShortAt(unsigned char* dest, unsigned value)
+{
+    const auto data = static_cast<unsigned short>(value);
+    memcpy(dest, &data, sizeof(data));
+}
+
 unsigned CalculateMaxPacketSize(unsigned requestedLimit, unsigned transportLimit)
 {
     const unsigned effectiveRequestedLimit = requestedLimit != 0 ? requestedLimit : M_MAX_UNSIGNED;
@@ -81,7 +91,9 @@ Connection::Connection(Context* context, NetworkConnection* connection)
         connection->onMessage_ = [this](ea::string_view msg)
         {
             MutexLock lock(packetQueueLock_);
-            incomingPackets_.emplace_back(VectorBuffer(msg.data(), static_cast<unsigned>(msg.size())));
+            if (numIncomingPackets_ == incomingPackets_.size())
+                incomingPackets_.emplace_back();
+            incomingPackets_[numIncomingPackets_++].SetData(msg.data(), static_cast<unsigned>(msg.size()));
         };
     }
 }
@@ -99,6 +111,14 @@ void Connection::Initialize()
     clock_ = ea::make_unique<ClockSynchronizer>(network->GetPingIntervalMs(), network->GetMaxPingIntervalMs(),
         network->GetClockBufferSize(), network->GetPingBufferSize());
 
+    compressor_ = ea::make_unique<PacketCompressor>(network->GetPacketCompressionDictionary());
+    compressPackets_ = network->GetPacketCompression();
+
+    // Compressed packets are always accepted, so the dictionary is announced regardless of own settings
+    msg_.Clear();
+    msg_.WriteUInt(compressor_->GetDictionaryId());
+    SendMessage(MSG_COMPRESSION_DICTIONARY, msg_);
+
     // Re-set the limit to apply transport limitations.
     const unsigned requestedMaxPacketSize = GetMaxPacketSize();
     SetMaxPacketSize(requestedMaxPacketSize);
@@ -120,6 +140,13 @@ void Connection::SendMessageInternal(NetworkMessageId messageId, const unsigned
     URHO3D_ASSERT(numBytes <= GetMaxMessageSize());
     URHO3D_ASSERT((data == nullptr && numBytes == 0) || (data != nullptr && numBytes > 0));
 
+    VectorBuffer& buffer = BeginMessage(messageId, numBytes, packetType);
+    if (numBytes)
+        buffer.Write(data, numBytes);
+}
+
+VectorBuffer& Connection::BeginMessage(NetworkMessageId messageId, unsigned numBytes, PacketTypeFlags packetType)
+{
     VectorBuffer& buffer = outgoingBuffer_[packetType];
 
     // Flush buffer if it overflows on this message.
@@ -128,8 +155,7 @@ void Connection::SendMessageInternal(NetworkMessageId messageId, const unsigned
 
     buffer.WriteUShort(messageId);
     buffer.WriteUShort(numBytes);
-    if (numBytes)
-        buffer.Write(data, numBytes);
+    return buffer;
 }
 
 void Connection::SendRemoteEvent(StringHash eventType, bool inOrder, const VariantMap& eventData)
@@ -247,23 +273,36 @@ void Connection::SendRemoteEvents()
 
 void Connection::SendPackages()
 {
+    URHO3D_ASSERT(!IsSendDeferred());
+
     while (!uploads_.empty())
     {
-        unsigned char buffer[PACKAGE_FRAGMENT_SIZE];
-
         for (auto i = uploads_.begin(); i != uploads_.end();)
         {
             auto current = i++;
             PackageUpload& upload = current->second;
             auto fragmentSize =
                 (unsigned)Min((int)(upload.file_->GetSize() - upload.file_->GetPosition()), (int)PACKAGE_FRAGMENT_SIZE);
-            upload.file_->Read(buffer, fragmentSize);
 
-            msg_.Clear();
-            msg_.WriteStringHash(current->first);
-            msg_.WriteUInt(upload.fragment_++);
-            msg_.Write(buffer, fragmentSize);
-            SendMessage(MSG_PACKAGEDATA, msg_, PacketType::ReliableUnordered);
+            // Read fragment directly into outgoing packet instead of copying it through temporary buffers
+            const unsigned messageSize = PackageFragmentHeaderSize + fragmentSize;
+            if (messageSize > GetMaxMessageSize())
+            {
+                URHO3D_LOGERROR("{}: Package fragment ({} bytes) is too big to send", ToString(), messageSize);
+                uploads_.erase(current);
+                continue;
+            }
+
+            VectorBuffer& buffer = BeginMessage(MSG_PACKAGEDATA, messageSize, PacketType::ReliableUnordered);
+            buffer.WriteStringHash(current->first);
+            buffer.WriteUInt(upload.fragment_++);
+
+            const unsigned fragmentOffset = buffer.GetPosition();
+            buffer.Resize(fragmentOffset + fragmentSize);
+            upload.file_->Read(buffer.GetModifiableData() + fragmentOffset, fragmentSize);
+            buffer.Seek(fragmentOffset + fragmentSize);
+
+            LogMessageSent(MSG_PACKAGEDATA, messageSize, PacketType::ReliableUnordered);
 
             // Check if upload finished
             if (upload.fragment_ == upload.totalFragments_)
@@ -279,9 +318,27 @@ void Connection::SendBuffer(PacketTypeFlags type, VectorBuffer& buffer)
 
     if (transportConnection_)
     {
+        ConstByteSpan packet{buffer.GetData(), buffer.GetSize()};
+
+        // Replace packet with single compressed message if it's beneficial
+        if (IsPacketCompressionActive() && buffer.GetSize() <= MaxNetworkMessageSize)
+        {
+            compressedPacket_.resize(CompressedPacketHeaderSize);
+            if (compressor_->Compress(packet, compressedPacket_)
+                && compressedPacket_.size() < packet.size() && compressedPacket_.size() <= GetMaxPacketSize())
+            {
+                WriteUShortAt(&compressedPacket_[0], MSG_COMPRESSED_PACKET);
+                WriteUShortAt(&compressedPacket_[2], compressedPacket_.size() - NetworkMessageHeaderSize);
+                WriteUShortAt(&compressedPacket_[4], packet.size());
+
+                numBytesSavedByCompression_ += packet.size() - compressedPacket_.size();
+                packet = compressedPacket_;
+            }
+        }
+
         packetCounterOutgoing_.AddSample(1);
-        bytesCounterOutgoing_.AddSample(buffer.GetSize());
-        transportConnection_->SendMessage({(const char*)buffer.GetData(), buffer.GetSize()}, type);
+        bytesCounterOutgoing_.AddSample(packet.size());
+        transportConnection_->SendMessage({reinterpret_cast<const char*>(packet.data()), packet.size()}, type);
     }
     buffer.Clear();
 }
@@ -312,6 +369,26 @@ bool Connection::ProcessMessage(MemoryBuffer& buffer)
     packetCounterIncoming_.AddSample(1);
     bytesCounterIncoming_.AddSample(buffer.GetSize());
 
+    return ProcessPacketMessages(buffer, false);
+}
+
+bool Connection::ProcessCompressedPacket(MemoryBuffer& msg)
+{
+    const unsigned originalSize = msg.ReadUShort();
+    const ConstByteSpan compressedData{msg.GetData() + msg.GetPosition(), msg.GetSize() - msg.GetPosition()};
+    if (msg.IsEof() || !compressor_ || !compressor_->Decompress(compressedData, originalSize, decompressedPacket_))
+    {
+        URHO3D_LOGERROR("{}: Failed to decompress network packet", ToString());
+        return false;
+    }
+
+    // Nested compressed packets are rejected, so the buffer is not reused until processing is finished
+    MemoryBuffer packetBuffer{decompressedPacket_};
+    return ProcessPacketMessages(packetBuffer, true);
+}
+
+bool Connection::ProcessPacketMessages(MemoryBuffer& buffer, bool isDecompressed)
+{
     if (buffer.GetSize() < NetworkMessageHeaderSize)
     {
         URHO3D_LOGERROR("Invalid network message size {}: too small.", buffer.GetSize());
@@ -363,6 +440,20 @@ bool Connection::ProcessMessage(MemoryBuffer& buffer)
             ProcessPackageInfo(msgID, msg);
             break;
 
+        case MSG_COMPRESSION_DICTIONARY:
+            ProcessCompressionDictionary(msgID, msg);
+            break;
+
+        case MSG_COMPRESSED_PACKET:
+            if (isDecompressed)
+            {
+                URHO3D_LOGERROR("{}: Nested compressed network packet", ToString());
+                return false;
+            }
+            if (!ProcessCompressedPacket(msg))
+                return false;
+            break;
+
         case MSG_CLOCK_SYNC:
             if (clock_)
             {
@@ -970,6 +1061,17 @@ void Connection::ProcessPackageInfo(int msgID, MemoryBuffer& msg)
     RequestNeededPackages(1, msg);
 }
 
+void Connection::ProcessCompressionDictionary(int msgID, MemoryBuffer& msg)
+{
+    const unsigned dictionaryId = msg.ReadUInt();
+    peerDictionaryMatches_ = compressor_ && dictionaryId == compressor_->GetDictionaryId();
+    if (compressPackets_ && !peerDictionaryMatches_)
+    {
+        URHO3D_LOGWARNING(
+            "{}: Remote end uses different packet compression dictionary, packets are sent uncompressed", ToString());
+    }
+}
+
 void Connection::ProcessUnknownMessage(int msgID, MemoryBuffer& msg)
 {
     // If message was not handled internally, forward as an event
@@ -999,16 +1101,16 @@ unsigned short Connection::GetPort() const
 void Connection::ProcessPackets()
 {
     MutexLock lock(packetQueueLock_);
-    for (auto& packet : incomingPackets_)
+    for (unsigned i = 0; i < numIncomingPackets_; ++i)
     {
-        MemoryBuffer msg(packet);
+        MemoryBuffer msg(incomingPackets_[i]);
         if (!ProcessMessage(msg))
         {
             Disconnect();
             break;
         }
     }
-    incomingPackets_.clear();
+    numIncomingPackets_ = 0;
 }
 
 }
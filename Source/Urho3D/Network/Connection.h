@@ -43,6 +43,7 @@ class Node;
 class Scene;
 class Serializable;
 class PackageFile;
+class PacketCompressor;
 class NetworkConnection;
 
 /// Queued remote event.
@@ -137,7 +138,7 @@ public:
     /// @property
     void SetLogStatistics(bool enable);
     /// Disconnect. If wait time is non-zero, will block while waiting for disconnect to finish.
-    void Disconnect();
+    void Disconnect() override;
     /// Send queued remote events. Called by Network.
     void SendRemoteEvents();
     /// Send package files to client. Called by network.
@@ -202,6 +203,12 @@ public:
     /// @property
     int GetPacketsOutPerSec() const;
 
+    /// Return number of bytes saved by compression of outgoing packets.
+    unsigned long long GetNumBytesSavedByCompression() const { return numBytesSavedByCompression_; }
+    /// Return whether outgoing packets are compressed.
+    /// Compression is enabled only after the remote end reports the same compression dictionary.
+    bool IsPacketCompressionActive() const { return compressPackets_ && peerDictionaryMatches_; }
+
     /// Return number of package downloads remaining.
     /// @property
     unsigned GetNumDownloads() const;
@@ -234,6 +241,8 @@ private:
     void ProcessRemoteEvent(int msgID, MemoryBuffer& msg);
     /// Process a SyncPackagesInfo message from server.
     void ProcessPackageInfo(int msgID, MemoryBuffer& msg);
+    /// Process compression dictionary id of the remote end.
+    void ProcessCompressionDictionary(int msgID, MemoryBuffer& msg);
     /// Process unknown message. All unknown messages are forwarded as an events
     void ProcessUnknownMessage(int msgID, MemoryBuffer& msg);
     /// Check a package list received from server and initiate package downloads as necessary. Return true on success, or false if failed to initialze downloads (cache dir not set).
@@ -250,6 +259,12 @@ private:
     void OnPackagesReady();
     /// Handles queued packets. Should only be called from main thread.
     void ProcessPackets();
+    /// Process messages of the packet. Compressed packet may contain only uncompressed messages.
+    bool ProcessPacketMessages(MemoryBuffer& buffer, bool isDecompressed);
+    /// Process compressed packet.
+    bool ProcessCompressedPacket(MemoryBuffer& msg);
+    /// Write message header into outgoing packet and return packet buffer to write payload into.
+    VectorBuffer& BeginMessage(NetworkMessageId messageId, unsigned numBytes, PacketTypeFlags packetType);
 
     /// Packet handling.
     /// @{
@@ -266,6 +281,16 @@ private:
     ea::vector<RemoteEvent> remoteEvents_;
     /// @}
 
+    /// Packet compression.
+    /// @{
+    ea::unique_ptr<PacketCompressor> compressor_;
+    bool compressPackets_{};
+    bool peerDictionaryMatches_{};
+    ByteVector compressedPacket_;
+    ByteVector decompressedPacket_;
+    unsigned long long numBytesSavedByCompression_{};
+    /// @}
+
     /// Scene synchronization.
     /// @{
     /// Utility to keep server and client clocks synchronized.
@@ -297,7 +322,9 @@ private:
 
     SharedPtr<NetworkConnection> transportConnection_;
     Mutex packetQueueLock_;
+    /// Incoming packets are stored in reused buffers, only first numIncomingPackets_ are valid.
     ea::vector<VectorBuffer> incomingPackets_;
+    unsigned numIncomingPackets_{};
 
 };
 
@@ -38,6 +38,8 @@
 #include "../Network/Protocol.h"
 #include "../Network/Transport/DataChannel/DataChannelConnection.h"
 #include "../Network/Transport/DataChannel/DataChannelServer.h"
+#include "../Network/Transport/UDP/UDPConnection.h"
+#include "../Network/Transport/UDP/UDPServer.h"
 #include "../Replica/BehaviorNetworkObject.h"
 #include "../Replica/FilteredByDistance.h"
 #include "../Replica/FilteredByOwner.h"
@@ -343,6 +345,22 @@ void Network::SetPingBufferSize(unsigned size)
     pingBufferSize_ = size;
 }
 
+void Network::SetPacketCompression(bool enable)
+{
+    if (IsServerRunning() || GetServerConnection())
+        URHO3D_LOGWARNING("Cannot change packet compression for currently active connections.");
+
+    packetCompression_ = enable;
+}
+
+void Network::SetPacketCompressionDictionary(const ByteVector& dictionary)
+{
+    if (IsServerRunning() || GetServerConnection())
+        URHO3D_LOGWARNING("Cannot change packet compression dictionary for currently active connections.");
+
+    packetCompressionDictionary_ = dictionary;
+}
+
 void Network::RegisterRemoteEvent(StringHash eventType)
 {
     allowedRemoteEvents_.insert(eventType);
@@ -394,6 +412,16 @@ void Network::SetTransportWebRTC()
     createConnection_ = [](Context* context) { return MakeShared<DataChannelConnection>(context); };
 }
 
+void Network::SetTransportUDP()
+{
+#ifndef URHO3D_PLATFORM_WEB
+    createServer_ = [](Context* context) { return MakeShared<UDPServer>(context); };
+    createConnection_ = [](Context* context) { return MakeShared<UDPConnection>(context); };
+#else
+    URHO3D_LOGERROR("UDP transport is not supported in web builds");
+#endif
+}
+
 void Network::SetTransportCustom(
     const CreateServerCallback& createServer, const CreateConnectionCallback& createConnection)
 {
@@ -583,6 +611,10 @@ void RegisterNetworkLibrary(Context* context)
     Connection::RegisterObject(context);
     DataChannelConnection::RegisterObject(context);
     DataChannelServer::RegisterObject(context);
+#ifndef URHO3D_PLATFORM_WEB
+    UDPConnection::RegisterObject(context);
+    UDPServer::RegisterObject(context);
+#endif
 }
 
 }
@@ -78,6 +78,11 @@ public:
     void SetClockBufferSize(unsigned size);
     /// Set number of ping samples used.
     void SetPingBufferSize(unsigned size);
+    /// Set whether to compress outgoing packets. Compressed packets are always accepted.
+    void SetPacketCompression(bool enable);
+    /// Set dictionary used for packet compression. Should be identical on client and server.
+    /// @see PacketCompressor::TrainDictionary
+    void SetPacketCompressionDictionary(const ByteVector& dictionary);
     /// Register a remote event as allowed to be received. There is also a fixed blacklist of events that can not be allowed in any case, such as ConsoleCommand.
     void RegisterRemoteEvent(StringHash eventType);
     /// Unregister a remote event as allowed to received.
@@ -100,6 +105,10 @@ public:
     unsigned GetClockBufferSize() const { return clockBufferSize_; }
     /// Return number of ping synchronization samples used.
     unsigned GetPingBufferSize() const { return pingBufferSize_; }
+    /// Return whether to compress outgoing packets.
+    bool GetPacketCompression() const { return packetCompression_; }
+    /// Return dictionary used for packet compression.
+    const ByteVector& GetPacketCompressionDictionary() const { return packetCompressionDictionary_; }
 
     /// Return the amount of time that happened after fixed-time network update.
     float GetUpdateOvertime() const { return updateAcc_; }
@@ -108,6 +117,8 @@ public:
     void SetTransportDefault();
     /// Use the WebRTC transport
     void SetTransportWebRTC();
+    /// Use the native UDP transport. Not available in web builds.
+    void SetTransportUDP();
     /// Use a user defined transport
     void SetTransportCustom(const CreateServerCallback& createServer, const CreateConnectionCallback& createConnection);
 
@@ -165,6 +176,8 @@ private:
     unsigned maxPingMs_{10000};
     unsigned clockBufferSize_{40};
     unsigned pingBufferSize_{10};
+    bool packetCompression_{};
+    ByteVector packetCompressionDictionary_;
     /// @}
 
     /// Client's server connection.
@@ -0,0 +1,155 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Network/NetworkConditions.h"
+
+#include <EASTL/algorithm.h>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Reliable packet is not lost more than this number of times in a row.
+constexpr unsigned MaxRetransmissions = 8;
+
+}
+
+bool NetworkConditions::IsIdeal() const
+{
+    return latencyMs_ <= 0.0f && jitterMs_ <= 0.0f && (spikeRate_ <= 0.0f || spikeLatencyMs_ <= 0.0f)
+        && lossRate_ <= 0.0f && duplicateRate_ <= 0.0f && reorderRate_ <= 0.0f && bandwidth_ == 0;
+}
+
+NetworkConditionSimulator::NetworkConditionSimulator(const NetworkConditions& conditions)
+    : conditions_(conditions)
+    , random_(conditions.seed_)
+{
+}
+
+void NetworkConditionSimulator::SetConditions(const NetworkConditions& conditions)
+{
+    conditions_ = conditions;
+}
+
+void NetworkConditionSimulator::Send(ConstByteSpan data, PacketTypeFlags type, long long timeMs)
+{
+    const bool isReliable = type.Test(PacketType::Reliable);
+    const bool isOrdered = type.Test(PacketType::Ordered);
+
+    ++stats_.numPackets_;
+    stats_.numBytes_ += data.size();
+
+    // Packets are sent one by one if bandwidth is limited
+    double sendTimeMs = static_cast<double>(timeMs);
+    if (conditions_.bandwidth_ != 0)
+    {
+        const double startTimeMs = ea::max(linkFreeTimeMs_, sendTimeMs);
+        if (!isReliable && startTimeMs - sendTimeMs > conditions_.maxQueueDelayMs_)
+        {
+            ++stats_.numDroppedByBandwidth_;
+            return;
+        }
+
+        linkFreeTimeMs_ = startTimeMs + data.size() * 1000.0 / conditions_.bandwidth_;
+        sendTimeMs = linkFreeTimeMs_;
+    }
+
+    const auto baseTimeMs = static_cast<long long>(std::ceil(sendTimeMs));
+    long long deliveryTimeMs = baseTimeMs + GetNextLatency();
+
+    // Reliable packets are retransmitted after about one round trip
+    if (IsNextPacketLost())
+    {
+        if (!isReliable)
+        {
+            ++stats_.numLost_;
+            return;
+        }
+
+        const auto retransmissionDelayMs = static_cast<long long>(std::round(2.0f * conditions_.latencyMs_)) + 1;
+        unsigned numRetransmissions = 1;
+        while (numRetransmissions < MaxRetransmissions && IsNextPacketLost())
+            ++numRetransmissions;
+
+        deliveryTimeMs += numRetransmissions * retransmissionDelayMs;
+        stats_.numRetransmitted_ += numRetransmissions;
+    }
+
+    if (!isOrdered && random_.GetBool(conditions_.reorderRate_))
+    {
+        deliveryTimeMs += static_cast<long long>(std::round(conditions_.reorderDelayMs_));
+        ++stats_.numReordered_;
+    }
+
+    if (isOrdered)
+    {
+        long long& lastDeliveryTimeMs = lastOrderedDeliveryTimeMs_[isReliable];
+        deliveryTimeMs = ea::max(deliveryTimeMs, lastDeliveryTimeMs);
+        lastDeliveryTimeMs = deliveryTimeMs;
+    }
+
+    QueuePacket(data, type, deliveryTimeMs);
+
+    // Duplicates of reliable packets are discarded by transport, so don't bother
+    if (!isReliable && random_.GetBool(conditions_.duplicateRate_))
+    {
+        // Late duplicates of ordered packets are discarded by transport as well
+        const long long duplicateDeliveryTimeMs = isOrdered ? deliveryTimeMs : baseTimeMs + GetNextLatency();
+        QueuePacket(data, type, duplicateDeliveryTimeMs);
+        ++stats_.numDuplicated_;
+    }
+}
+
+bool NetworkConditionSimulator::IsNextPacketLost()
+{
+    if (conditions_.lossRate_ <= 0.0f)
+        return false;
+    if (conditions_.lossRate_ >= 1.0f)
+        return true;
+
+    // Two-state Markov chain, average loss rate matches lossRate_ and average burst length matches lossBurstLength_
+    const float exitBurstChance = 1.0f / ea::max(1.0f, conditions_.lossBurstLength_);
+    const float enterBurstChance = conditions_.lossRate_ * exitBurstChance / (1.0f - conditions_.lossRate_);
+    isLossBurst_ = random_.GetBool(isLossBurst_ ? 1.0f - exitBurstChance : ea::min(1.0f, enterBurstChance));
+    return isLossBurst_;
+}
+
+long long NetworkConditionSimulator::GetNextLatency()
+{
+    float latencyMs = conditions_.latencyMs_;
+    if (conditions_.jitterMs_ > 0.0f)
+        latencyMs += Abs(random_.GetStandardNormalFloat()) * conditions_.jitterMs_;
+    if (conditions_.spikeRate_ > 0.0f && random_.GetBool(conditions_.spikeRate_))
+        latencyMs += conditions_.spikeLatencyMs_;
+    return static_cast<long long>(std::round(ea::max(0.0f, latencyMs)));
+}
+
+void NetworkConditionSimulator::QueuePacket(ConstByteSpan data, PacketTypeFlags type, long long deliveryTimeMs)
+{
+    const auto isEarlier = [](long long timeMs, const Packet& packet) { return timeMs < packet.deliveryTimeMs_; };
+    const auto iter = ea::upper_bound(packets_.begin(), packets_.end(), deliveryTimeMs, isEarlier);
+
+    Packet& packet = *packets_.emplace(iter);
+    packet.deliveryTimeMs_ = deliveryTimeMs;
+    packet.type_ = type;
+    packet.data_.assign(data.begin(), data.end());
+}
+
+void NetworkConditionSimulator::PopDeliveredPackets(long long timeMs)
+{
+    const auto isEarlier = [](long long timeMs, const Packet& packet) { return timeMs < packet.deliveryTimeMs_; };
+    const auto iter = ea::upper_bound(packets_.begin(), packets_.end(), timeMs, isEarlier);
+
+    deliveredPackets_.insert(deliveredPackets_.end(), ea::make_move_iterator(packets_.begin()),
+        ea::make_move_iterator(iter));
+    packets_.erase(packets_.begin(), iter);
+}
+
+} // namespace Urho3D
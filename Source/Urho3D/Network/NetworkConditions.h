@@ -0,0 +1,123 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Urho3D.h"
+
+#include "Urho3D/Container/ByteVector.h"
+#include "Urho3D/Math/RandomEngine.h"
+#include "Urho3D/Network/PacketTypeFlags.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+/// Properties of simulated network link in one direction.
+struct URHO3D_API NetworkConditions
+{
+    /// Minimal one-way latency, in milliseconds.
+    float latencyMs_{};
+    /// Scale of random latency added on top of minimal latency, in milliseconds.
+    /// Extra latency has half-normal distribution, so the mean latency is about latencyMs_ + 0.8 * jitterMs_.
+    float jitterMs_{};
+    /// Probability of latency spike and extra latency of the spike, in milliseconds.
+    float spikeRate_{};
+    float spikeLatencyMs_{};
+
+    /// Average fraction of lost packets.
+    float lossRate_{};
+    /// Average length of loss bursts, in packets. 1 means that losses are independent.
+    float lossBurstLength_{1.0f};
+    /// Probability of unreliable packet being duplicated.
+    float duplicateRate_{};
+    /// Probability of unordered packet being delayed by extra time, so it is received after next packets.
+    float reorderRate_{};
+    float reorderDelayMs_{20.0f};
+
+    /// Link throughput in bytes per second, zero means unlimited.
+    unsigned bandwidth_{};
+    /// Unreliable packets are dropped if they would wait in the link queue longer than this, in milliseconds.
+    float maxQueueDelayMs_{250.0f};
+
+    /// Seed of random generator. Same seed and same sequence of sent packets result in same delivery schedule.
+    unsigned seed_{};
+
+    /// Return whether the link has no latency and never loses or reorders packets.
+    bool IsIdeal() const;
+};
+
+/// Statistics of simulated network link.
+struct NetworkConditionStats
+{
+    unsigned numPackets_{};
+    unsigned long long numBytes_{};
+
+    /// Number of unreliable packets lost.
+    unsigned numLost_{};
+    /// Number of reliable packets "lost" and delivered with retransmission delay.
+    unsigned numRetransmitted_{};
+    unsigned numDuplicated_{};
+    unsigned numReordered_{};
+    /// Number of unreliable packets dropped due to bandwidth limit.
+    unsigned numDroppedByBandwidth_{};
+};
+
+/// Deterministic simulation of network link with latency, jitter, loss bursts, reordering,
+/// duplication and bandwidth limit. Reliable packets are never lost, but lost reliable packets
+/// are delayed as if they were retransmitted. Ordered packets are never reordered.
+/// Not thread-safe.
+class URHO3D_API NetworkConditionSimulator
+{
+public:
+    explicit NetworkConditionSimulator(const NetworkConditions& conditions);
+
+    /// Update conditions of the link. Packets already in flight are not affected.
+    void SetConditions(const NetworkConditions& conditions);
+    /// Queue packet sent at specified time.
+    void Send(ConstByteSpan data, PacketTypeFlags type, long long timeMs);
+    /// Deliver all packets received before or at specified time, in order of receiving.
+    /// Callback is invoked with ConstByteSpan and PacketTypeFlags. It may send new packets.
+    template <class T> void Deliver(long long timeMs, const T& callback);
+
+    const NetworkConditions& GetConditions() const { return conditions_; }
+    const NetworkConditionStats& GetStats() const { return stats_; }
+    unsigned GetNumPacketsInFlight() const { return packets_.size(); }
+
+private:
+    struct Packet
+    {
+        long long deliveryTimeMs_{};
+        PacketTypeFlags type_{};
+        ByteVector data_;
+    };
+
+    bool IsNextPacketLost();
+    long long GetNextLatency();
+    void QueuePacket(ConstByteSpan data, PacketTypeFlags type, long long deliveryTimeMs);
+    void PopDeliveredPackets(long long timeMs);
+
+    NetworkConditions conditions_;
+    RandomEngine random_;
+    NetworkConditionStats stats_;
+
+    bool isLossBurst_{};
+    double linkFreeTimeMs_{};
+    long long lastOrderedDeliveryTimeMs_[2]{};
+
+    /// Sorted by delivery time, packets with same delivery time are sorted by send order.
+    ea::vector<Packet> packets_;
+    ea::vector<Packet> deliveredPackets_;
+};
+
+template <class T> void NetworkConditionSimulator::Deliver(long long timeMs, const T& callback)
+{
+    PopDeliveredPackets(timeMs);
+    for (const Packet& packet : deliveredPackets_)
+        callback(ConstByteSpan{packet.data_}, packet.type_);
+    deliveredPackets_.clear();
+}
+
+} // namespace Urho3D
@@ -0,0 +1,115 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Network/PacketCompression.h"
+
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/Math/StringHash.h"
+
+#include <zdict.h>
+#include <zstd.h>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+PacketCompressor::PacketCompressor(ConstByteSpan dictionary, int compressionLevel)
+    : compressionContext_(ZSTD_createCCtx())
+    , decompressionContext_(ZSTD_createDCtx())
+    , compressionLevel_(compressionLevel)
+{
+    if (!dictionary.empty())
+    {
+        compressionDictionary_ = ZSTD_createCDict(dictionary.data(), dictionary.size(), compressionLevel_);
+        decompressionDictionary_ = ZSTD_createDDict(dictionary.data(), dictionary.size());
+
+        // Raw content dictionaries have no id of their own
+        dictionaryId_ = ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size());
+        if (dictionaryId_ == 0)
+        {
+            dictionaryId_ = StringHash::Calculate(
+                reinterpret_cast<const char*>(dictionary.data()), static_cast<unsigned>(dictionary.size()));
+        }
+    }
+}
+
+PacketCompressor::~PacketCompressor()
+{
+    ZSTD_freeCDict(compressionDictionary_);
+    ZSTD_freeDDict(decompressionDictionary_);
+    ZSTD_freeCCtx(compressionContext_);
+    ZSTD_freeDCtx(decompressionContext_);
+}
+
+ByteVector PacketCompressor::TrainDictionary(const ea::vector<ByteVector>& samples, unsigned maxDictionarySize)
+{
+    ByteVector samplesData;
+    ea::vector<size_t> sampleSizes;
+    for (const ByteVector& sample : samples)
+    {
+        samplesData.insert(samplesData.end(), sample.begin(), sample.end());
+        sampleSizes.push_back(sample.size());
+    }
+
+    ByteVector dictionary(maxDictionarySize);
+    const size_t dictionarySize = ZDICT_trainFromBuffer(
+        dictionary.data(), dictionary.size(), samplesData.data(), sampleSizes.data(), sampleSizes.size());
+    if (ZDICT_isError(dictionarySize))
+    {
+        URHO3D_LOGWARNING("Failed to train packet compression dictionary: {}", ZDICT_getErrorName(dictionarySize));
+        return {};
+    }
+
+    dictionary.resize(dictionarySize);
+    return dictionary;
+}
+
+bool PacketCompressor::Compress(ConstByteSpan data, ByteVector& compressedData)
+{
+    if (data.size() < MinCompressedSize)
+        return false;
+
+    const unsigned offset = compressedData.size();
+    compressedData.resize(offset + ZSTD_compressBound(data.size()));
+
+    unsigned char* dest = compressedData.data() + offset;
+    const size_t destSize = compressedData.size() - offset;
+    const size_t compressedSize = compressionDictionary_
+        ? ZSTD_compress_usingCDict(
+            compressionContext_, dest, destSize, data.data(), data.size(), compressionDictionary_)
+        : ZSTD_compressCCtx(compressionContext_, dest, destSize, data.data(), data.size(), compressionLevel_);
+
+    if (ZSTD_isError(compressedSize) || compressedSize >= data.size())
+    {
+        compressedData.resize(offset);
+        return false;
+    }
+
+    compressedData.resize(offset + compressedSize);
+    return true;
+}
+
+bool PacketCompressor::Decompress(ConstByteSpan compressedData, unsigned originalSize, ByteVector& data)
+{
+    // Frames compressed with a trained dictionary carry its id, zero means that the id is not stored
+    const unsigned frameDictionaryId = ZSTD_getDictID_fromFrame(compressedData.data(), compressedData.size());
+    const unsigned expectedDictionaryId =
+        decompressionDictionary_ ? ZSTD_getDictID_fromDDict(decompressionDictionary_) : 0;
+    if (frameDictionaryId != 0 && frameDictionaryId != expectedDictionaryId)
+        return false;
+
+    data.resize(originalSize);
+    const size_t size = decompressionDictionary_
+        ? ZSTD_decompress_usingDDict(decompressionContext_, data.data(), data.size(), compressedData.data(),
+            compressedData.size(), decompressionDictionary_)
+        : ZSTD_decompressDCtx(
+            decompressionContext_, data.data(), data.size(), compressedData.data(), compressedData.size());
+
+    return !ZSTD_isError(size) && size == originalSize;
+}
+
+} // namespace Urho3D
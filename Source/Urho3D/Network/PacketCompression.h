@@ -0,0 +1,56 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Urho3D.h"
+
+#include "Urho3D/Container/ByteVector.h"
+
+#include <EASTL/vector.h>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace Urho3D
+{
+
+/// Compresses network packets independently from each other, so unreliable packets may be lost.
+/// Optional dictionary trained on typical game traffic makes compression of small packets efficient.
+/// Dictionary should be identical on both ends of the connection.
+class URHO3D_API PacketCompressor
+{
+public:
+    static constexpr int DefaultCompressionLevel = 3;
+    /// Packets smaller than this are sent as is.
+    static constexpr unsigned MinCompressedSize = 64;
+
+    explicit PacketCompressor(ConstByteSpan dictionary = {}, int compressionLevel = DefaultCompressionLevel);
+    ~PacketCompressor();
+
+    /// Train dictionary from sample packets. Returns empty dictionary if there is not enough samples.
+    static ByteVector TrainDictionary(const ea::vector<ByteVector>& samples, unsigned maxDictionarySize);
+
+    /// Compress packet and append compressed data to the buffer.
+    /// Returns false and keeps the buffer intact if packet is too small or compression doesn't reduce size.
+    bool Compress(ConstByteSpan data, ByteVector& compressedData);
+    /// Decompress packet of known original size.
+    /// Returns false if data is malformed or compressed with another dictionary.
+    bool Decompress(ConstByteSpan compressedData, unsigned originalSize, ByteVector& data);
+
+    /// Return id of the dictionary, or 0 if there is no dictionary.
+    unsigned GetDictionaryId() const { return dictionaryId_; }
+
+private:
+    ZSTD_CCtx_s* compressionContext_{};
+    ZSTD_DCtx_s* decompressionContext_{};
+    ZSTD_CDict_s* compressionDictionary_{};
+    ZSTD_DDict_s* decompressionDictionary_{};
+    int compressionLevel_{};
+    unsigned dictionaryId_{};
+};
+
+} // namespace Urho3D
@@ -52,6 +52,12 @@ enum NetworkMessageId : uint16_t
 
     /// Message used to synchronize clock between client and server.
     MSG_CLOCK_SYNC = 0x9A,
+    /// Client->server and server->client: packet of messages compressed as a whole.
+    /// Contains original packet size followed by compressed data.
+    MSG_COMPRESSED_PACKET = 0x9B,
+    /// Client->server and server->client: id of the packet compression dictionary.
+    /// Packets are compressed only if both ends use the same dictionary.
+    MSG_COMPRESSION_DICTIONARY = 0x9C,
 
     /// Server->Client. ReplicationManager message. Deliver networking settings.
     MSG_CONFIGURE = 200,
@@ -71,6 +77,10 @@ enum NetworkMessageId : uint16_t
     MSG_UPDATE_OBJECTS_UNRELIABLE,
     /// Client->Server. ReplicationManager message. Perform unordered and unreliable update of owned NetworkObjects from client to server.
     MSG_OBJECTS_FEEDBACK_UNRELIABLE,
+    /// Server->Client. ReplicationManager message. Chunk of compressed join snapshot of static NetworkObjects.
+    MSG_JOIN_SNAPSHOT,
+    /// Client->Server. ReplicationManager message. Acknowledge received size of join snapshot and whether it's loaded.
+    MSG_JOIN_SNAPSHOT_ACK,
 
     /// Message IDs starting from MSG_USER are reserved for the end user.
     MSG_USER = 512,
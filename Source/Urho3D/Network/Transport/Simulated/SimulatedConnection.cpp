@@ -0,0 +1,150 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Network/Transport/Simulated/SimulatedConnection.h"
+
+#include "Urho3D/Core/CoreEvents.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+SimulatedConnection::SimulatedConnection(
+    Context* context, NetworkConnection* connection, const NetworkConditions& conditions)
+    : NetworkConnection(context)
+    , connection_(connection)
+    , simulator_(conditions)
+{
+    URHO3D_ASSERT(connection_);
+
+    // Server connections are already connected when wrapped
+    state_ = connection_->GetState();
+    address_ = connection_->GetAddress();
+    port_ = connection_->GetPort();
+
+    ConnectCallbacks();
+}
+
+SimulatedConnection::~SimulatedConnection()
+{
+    connection_->onConnected_ = nullptr;
+    connection_->onDisconnected_ = nullptr;
+    connection_->onError_ = nullptr;
+    connection_->onMessage_ = nullptr;
+}
+
+void SimulatedConnection::ConnectCallbacks()
+{
+    connection_->onConnected_ = [this]()
+    {
+        address_ = connection_->GetAddress();
+        port_ = connection_->GetPort();
+        state_ = State::Connected;
+        if (onConnected_)
+            onConnected_();
+    };
+    connection_->onDisconnected_ = [this]()
+    {
+        state_ = State::Disconnected;
+        if (onDisconnected_)
+            onDisconnected_();
+    };
+    connection_->onError_ = [this]()
+    {
+        state_ = State::Disconnected;
+        if (onError_)
+            onError_();
+    };
+    connection_->onMessage_ = [this](ea::string_view data)
+    {
+        if (onMessage_)
+            onMessage_(data);
+    };
+}
+
+bool SimulatedConnection::Connect(const URL& url)
+{
+    state_ = State::Connecting;
+    SubscribeToEvent(E_BEGINFRAME, [this](VariantMap& eventData) { Update(); });
+    return connection_->Connect(url);
+}
+
+void SimulatedConnection::Disconnect()
+{
+    if (state_ == State::Connecting || state_ == State::Connected)
+        state_ = State::Disconnecting;
+    UnsubscribeFromEvent(E_BEGINFRAME);
+    connection_->Disconnect();
+}
+
+void SimulatedConnection::SendMessage(ea::string_view data, PacketTypeFlags type)
+{
+    MutexLock lock(mutex_);
+
+    if (simulator_.GetConditions().IsIdeal() && simulator_.GetNumPacketsInFlight() == 0)
+    {
+        connection_->SendMessage(data, type);
+        return;
+    }
+
+    const long long timeMs = GetTime();
+    const auto bytes = reinterpret_cast<const unsigned char*>(data.data());
+    simulator_.Send(ConstByteSpan{bytes, static_cast<unsigned>(data.size())}, type, timeMs);
+
+    // Messages without delay are sent immediately
+    SendDelayedMessages(timeMs);
+}
+
+unsigned SimulatedConnection::GetMaxMessageSize() const
+{
+    return connection_->GetMaxMessageSize();
+}
+
+void SimulatedConnection::Update()
+{
+    MutexLock lock(mutex_);
+    SendDelayedMessages(GetTime());
+}
+
+void SimulatedConnection::Update(long long timeMs)
+{
+    MutexLock lock(mutex_);
+    SendDelayedMessages(timeMs);
+}
+
+void SimulatedConnection::SendDelayedMessages(long long timeMs)
+{
+    simulator_.Deliver(timeMs, [this](ConstByteSpan message, PacketTypeFlags type)
+    {
+        connection_->SendMessage({reinterpret_cast<const char*>(message.data()), message.size()}, type);
+    });
+}
+
+void SimulatedConnection::SetConditions(const NetworkConditions& conditions)
+{
+    MutexLock lock(mutex_);
+    simulator_.SetConditions(conditions);
+}
+
+NetworkConditions SimulatedConnection::GetConditions() const
+{
+    MutexLock lock(mutex_);
+    return simulator_.GetConditions();
+}
+
+NetworkConditionStats SimulatedConnection::GetStats() const
+{
+    MutexLock lock(mutex_);
+    return simulator_.GetStats();
+}
+
+long long SimulatedConnection::GetTime()
+{
+    return timer_.GetUSec(false) / 1000;
+}
+
+} // namespace Urho3D
@@ -0,0 +1,66 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Core/Mutex.h"
+#include "Urho3D/Core/Timer.h"
+#include "Urho3D/Network/NetworkConditions.h"
+#include "Urho3D/Network/Transport/NetworkConnection.h"
+
+namespace Urho3D
+{
+
+/// Decorator of another connection that simulates network conditions for outgoing messages.
+/// Incoming messages are forwarded as is, wrap both ends of the connection to simulate both directions.
+/// Delayed messages are released by Update. Client connections call Update automatically at the beginning of each frame,
+/// server connections are updated by SimulatedServer.
+/// Use it with Network::SetTransportCustom:
+/// @code
+/// network->SetTransportCustom(
+///     [=](Context* context) { return MakeShared<SimulatedServer>(context, MakeShared<UDPServer>(context), conditions); },
+///     [=](Context* context) { return MakeShared<SimulatedConnection>(context, MakeShared<UDPConnection>(context), conditions); });
+/// @endcode
+class URHO3D_API SimulatedConnection : public NetworkConnection
+{
+    URHO3D_OBJECT(SimulatedConnection, NetworkConnection);
+
+public:
+    SimulatedConnection(Context* context, NetworkConnection* connection, const NetworkConditions& conditions);
+    ~SimulatedConnection() override;
+
+    /// Implement NetworkConnection.
+    /// @{
+    bool Connect(const URL& url) override;
+    void Disconnect() override;
+    void SendMessage(ea::string_view data, PacketTypeFlags type = PacketType::ReliableOrdered) override;
+    unsigned GetMaxMessageSize() const override;
+    /// @}
+
+    /// Send delayed messages that are due at current time.
+    void Update();
+    /// Send delayed messages that are due at specified time, in milliseconds since connection creation.
+    void Update(long long timeMs);
+
+    /// Update simulated conditions. Messages already in flight are not affected.
+    void SetConditions(const NetworkConditions& conditions);
+    NetworkConditions GetConditions() const;
+    /// Return statistics of simulated link.
+    NetworkConditionStats GetStats() const;
+    /// Return wrapped connection.
+    NetworkConnection* GetConnection() const { return connection_; }
+
+private:
+    void ConnectCallbacks();
+    void SendDelayedMessages(long long timeMs);
+    long long GetTime();
+
+    SharedPtr<NetworkConnection> connection_;
+    HiresTimer timer_;
+
+    mutable Mutex mutex_;
+    NetworkConditionSimulator simulator_;
+};
+
+} // namespace Urho3D
@@ -0,0 +1,114 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Network/Transport/Simulated/SimulatedServer.h"
+
+#include "Urho3D/Core/CoreEvents.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+SimulatedServer::SimulatedServer(Context* context, NetworkServer* server, const NetworkConditions& conditions)
+    : NetworkServer(context)
+    , server_(server)
+    , conditions_(conditions)
+{
+    URHO3D_ASSERT(server_);
+
+    server_->onConnected_ = [this](NetworkConnection* connection) { OnConnected(connection); };
+    server_->onDisconnected_ = [this](NetworkConnection* connection) { OnDisconnected(connection); };
+}
+
+SimulatedServer::~SimulatedServer()
+{
+    server_->onConnected_ = nullptr;
+    server_->onDisconnected_ = nullptr;
+}
+
+bool SimulatedServer::Listen(const URL& url)
+{
+    SubscribeToEvent(E_BEGINFRAME, [this](VariantMap& eventData) { Update(); });
+    return server_->Listen(url);
+}
+
+void SimulatedServer::Stop()
+{
+    UnsubscribeFromEvent(E_BEGINFRAME);
+    server_->Stop();
+
+    MutexLock lock(mutex_);
+    connections_.clear();
+}
+
+void SimulatedServer::Update()
+{
+    MutexLock lock(mutex_);
+    for (const auto& [connection, simulatedConnection] : connections_)
+        simulatedConnection->Update();
+}
+
+void SimulatedServer::SetConditions(const NetworkConditions& conditions)
+{
+    MutexLock lock(mutex_);
+    conditions_ = conditions;
+    for (const auto& [connection, simulatedConnection] : connections_)
+        simulatedConnection->SetConditions(conditions);
+}
+
+NetworkConditionStats SimulatedServer::GetStats() const
+{
+    MutexLock lock(mutex_);
+    NetworkConditionStats result;
+    for (const auto& [connection, simulatedConnection] : connections_)
+    {
+        const NetworkConditionStats stats = simulatedConnection->GetStats();
+        result.numPackets_ += stats.numPackets_;
+        result.numBytes_ += stats.numBytes_;
+        result.numLost_ += stats.numLost_;
+        result.numRetransmitted_ += stats.numRetransmitted_;
+        result.numDuplicated_ += stats.numDuplicated_;
+        result.numReordered_ += stats.numReordered_;
+        result.numDroppedByBandwidth_ += stats.numDroppedByBandwidth_;
+    }
+    return result;
+}
+
+void SimulatedServer::OnConnected(NetworkConnection* connection)
+{
+    SharedPtr<SimulatedConnection> simulatedConnection;
+    {
+        MutexLock lock(mutex_);
+        NetworkConditions conditions = conditions_;
+        conditions.seed_ += nextSeed_++;
+
+        simulatedConnection = MakeShared<SimulatedConnection>(context_, connection, conditions);
+        connections_[connection] = simulatedConnection;
+    }
+
+    if (onConnected_)
+        onConnected_(simulatedConnection);
+}
+
+void SimulatedServer::OnDisconnected(NetworkConnection* connection)
+{
+    SharedPtr<SimulatedConnection> simulatedConnection;
+    {
+        MutexLock lock(mutex_);
+        const auto iter = connections_.find(connection);
+        if (iter == connections_.end())
+            return;
+
+        simulatedConnection = iter->second;
+        connections_.erase(iter);
+    }
+
+    if (onDisconnected_)
+        onDisconnected_(simulatedConnection);
+}
+
+} // namespace Urho3D
@@ -0,0 +1,56 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Core/Mutex.h"
+#include "Urho3D/Network/NetworkConditions.h"
+#include "Urho3D/Network/Transport/NetworkServer.h"
+#include "Urho3D/Network/Transport/Simulated/SimulatedConnection.h"
+
+#include <EASTL/unordered_map.h>
+
+namespace Urho3D
+{
+
+/// Decorator of another server that wraps accepted connections into SimulatedConnection.
+/// Each connection gets its own random seed derived from the seed of the conditions.
+/// Connections are updated at the beginning of each frame while the server is listening.
+class URHO3D_API SimulatedServer : public NetworkServer
+{
+    URHO3D_OBJECT(SimulatedServer, NetworkServer);
+
+public:
+    SimulatedServer(Context* context, NetworkServer* server, const NetworkConditions& conditions);
+    ~SimulatedServer() override;
+
+    /// Implement NetworkServer.
+    /// @{
+    bool Listen(const URL& url) override;
+    void Stop() override;
+    /// @}
+
+    /// Send delayed messages of all connections that are due at current time.
+    void Update();
+
+    /// Update simulated conditions of all current and future connections.
+    void SetConditions(const NetworkConditions& conditions);
+    /// Return total statistics of all current connections.
+    NetworkConditionStats GetStats() const;
+    /// Return wrapped server.
+    NetworkServer* GetServer() const { return server_; }
+
+private:
+    void OnConnected(NetworkConnection* connection);
+    void OnDisconnected(NetworkConnection* connection);
+
+    SharedPtr<NetworkServer> server_;
+
+    mutable Mutex mutex_;
+    NetworkConditions conditions_;
+    unsigned nextSeed_{};
+    ea::unordered_map<NetworkConnection*, SharedPtr<SimulatedConnection>> connections_;
+};
+
+} // namespace Urho3D
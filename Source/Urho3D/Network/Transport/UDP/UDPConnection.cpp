@@ -0,0 +1,329 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Network/Transport/UDP/UDPConnection.h"
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/IO/MemoryBuffer.h"
+#include "Urho3D/IO/VectorBuffer.h"
+#include "Urho3D/Network/Transport/UDP/UDPServer.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+UDPConnection::UDPConnection(Context* context)
+    : NetworkConnection(context)
+    , Thread("UDPConnection")
+{
+}
+
+UDPConnection::~UDPConnection()
+{
+    Thread::Stop();
+
+    // Notify remote side if connection is destroyed before network thread finalized it
+    if (state_ != State::Disconnected && socket_.IsOpen())
+    {
+        UDPSendQueue sendQueue;
+        QueueControlDatagram(sendQueue, UDPDatagramKind::Disconnect);
+        socket_.Send(sendQueue);
+    }
+    state_ = State::Disconnected;
+}
+
+void UDPConnection::RegisterObject(Context* context)
+{
+    context->AddAbstractReflection<UDPConnection>(Category_Network);
+}
+
+bool UDPConnection::Connect(const URL& url)
+{
+    URHO3D_ASSERT(state_ == State::Disconnected);
+
+    if (!url.scheme_.empty() && url.scheme_ != "udp")
+    {
+        URHO3D_LOGERROR("UDP transport does not support scheme '{}'", url.scheme_);
+        return false;
+    }
+
+    UDPEndpoint endpoint;
+    if (!UDPSocket::Resolve(url.host_, url.port_, endpoint) || !socket_.Open(0))
+        return false;
+
+    {
+        MutexLock lock(mutex_);
+        endpoint_ = endpoint;
+        address_ = endpoint.GetAddressString();
+        port_ = endpoint.port_;
+        session_ = UDPSession{};
+        wasConnected_ = false;
+        state_ = State::Connecting;
+
+        timer_.Reset();
+        connectStartTimeMs_ = 0;
+        lastConnectRequestTimeMs_ = -static_cast<long long>(ConnectIntervalMs);
+        challengeToken_ = 0;
+    }
+
+    if (!Run())
+    {
+        URHO3D_LOGERROR("Failed to start UDP connection thread");
+        socket_.Close();
+        state_ = State::Disconnected;
+        return false;
+    }
+    return true;
+}
+
+void UDPConnection::Disconnect()
+{
+    MutexLock lock(mutex_);
+    if (state_ == State::Connecting || state_ == State::Connected)
+        state_ = State::Disconnecting;
+}
+
+void UDPConnection::SendMessage(ea::string_view data, PacketTypeFlags type)
+{
+    MutexLock lock(mutex_);
+    if (state_ != State::Connected)
+    {
+        URHO3D_LOGDEBUG("Network message was not sent: connection is not connected.");
+        return;
+    }
+
+    if (data.size() > GetMaxMessageSize())
+    {
+        URHO3D_LOGERROR("UDP connection tried to send {} bytes of data, which is more than max allowed {} bytes of data per message.",
+            data.size(), GetMaxMessageSize());
+        return;
+    }
+
+    session_.QueueMessage(data, type);
+}
+
+unsigned UDPConnection::GetMaxMessageSize() const
+{
+    return UDPSession::MaxMessageSize;
+}
+
+UDPSessionStats UDPConnection::GetStats() const
+{
+    MutexLock lock(mutex_);
+    return session_.GetStats();
+}
+
+float UDPConnection::GetRoundTripTime() const
+{
+    MutexLock lock(mutex_);
+    return session_.GetRoundTripTime();
+}
+
+void UDPConnection::ThreadFunction()
+{
+    ea::vector<UDPDatagram> incoming;
+    UDPSendQueue sendQueue;
+
+    while (shouldRun_)
+    {
+        socket_.Wait(UpdateIntervalMs);
+
+        const long long timeMs = timer_.GetUSec(false) / 1000;
+        while (const unsigned numReceived = socket_.Receive(incoming))
+        {
+            for (unsigned i = 0; i < numReceived; ++i)
+            {
+                if (incoming[i].endpoint_ == endpoint_)
+                    ProcessDatagram(incoming[i].data_, timeMs);
+            }
+            if (numReceived < UDPSocket::MaxReceiveBatch)
+                break;
+        }
+
+        const bool isAlive = Update(timeMs, sendQueue);
+        socket_.Send(sendQueue);
+        if (!isAlive)
+            break;
+    }
+}
+
+void UDPConnection::InitializeFromServer(UDPServer* server, const UDPEndpoint& endpoint, long long timeMs)
+{
+    MutexLock lock(mutex_);
+    server_ = server;
+    endpoint_ = endpoint;
+    address_ = endpoint.GetAddressString();
+    port_ = endpoint.port_;
+    wasConnected_ = true;
+    state_ = State::Connected;
+    session_.SetLastReceiveTime(timeMs);
+}
+
+void UDPConnection::ProcessDatagram(ConstByteSpan data, long long timeMs)
+{
+    if (data.empty())
+        return;
+
+    bool connected = false;
+    bool disconnected = false;
+    {
+        MutexLock lock(mutex_);
+        const auto kind = static_cast<UDPDatagramKind>(data[0]);
+
+        // Repeat connection request with the token immediately
+        if (kind == UDPDatagramKind::Challenge && state_ == State::Connecting && data.size() >= 1 + 8)
+        {
+            MemoryBuffer source(data.data(), data.size());
+            source.ReadUByte();
+            challengeToken_ = source.ReadUInt64();
+            lastConnectRequestTimeMs_ = -static_cast<long long>(ConnectIntervalMs);
+        }
+
+        // Data is accepted as confirmation of connection in case Accept datagram was lost
+        if ((kind == UDPDatagramKind::Accept || kind == UDPDatagramKind::Data) && state_ == State::Connecting)
+        {
+            state_ = State::Connected;
+            wasConnected_ = true;
+            session_.SetLastReceiveTime(timeMs);
+            connected = true;
+        }
+
+        if (kind == UDPDatagramKind::Data && (state_ == State::Connected || state_ == State::Disconnecting))
+        {
+            const auto onMessage = [this](ea::string_view message)
+            {
+                receivedMessages_.emplace_back(receivedData_.size(), message.size());
+                receivedData_.insert(receivedData_.end(), message.begin(), message.end());
+            };
+            if (!session_.ProcessDatagram(data, timeMs, onMessage))
+                URHO3D_LOGDEBUG("Malformed UDP datagram received from {}:{}", address_, port_);
+        }
+        else if (kind == UDPDatagramKind::Disconnect && state_ != State::Disconnected)
+            disconnected = true;
+    }
+
+    if (connected && onConnected_)
+        onConnected_();
+
+    DeliverMessages();
+
+    if (disconnected)
+        Finalize();
+}
+
+bool UDPConnection::Update(long long timeMs, UDPSendQueue& sendQueue)
+{
+    bool finalize = false;
+    {
+        MutexLock lock(mutex_);
+        const auto sendDatagram = [&](ConstByteSpan data) { sendQueue.Add(endpoint_, data); };
+
+        switch (state_)
+        {
+        case State::Disconnected:
+            return false;
+
+        case State::Connecting:
+            if (timeMs - connectStartTimeMs_ >= TimeoutMs)
+            {
+                URHO3D_LOGWARNING("UDP connection to {}:{} timed out", address_, port_);
+                finalize = true;
+            }
+            else if (timeMs - lastConnectRequestTimeMs_ >= ConnectIntervalMs)
+            {
+                QueueControlDatagram(sendQueue, UDPDatagramKind::Connect, challengeToken_);
+                lastConnectRequestTimeMs_ = timeMs;
+            }
+            break;
+
+        case State::Connected:
+            if (timeMs - session_.GetLastReceiveTime() >= TimeoutMs)
+            {
+                URHO3D_LOGWARNING("UDP connection with {}:{} timed out", address_, port_);
+                finalize = true;
+            }
+            else
+                session_.SendDatagrams(timeMs, sendDatagram);
+            break;
+
+        case State::Disconnecting:
+            // Flush queued messages on best effort basis, there will be no resends
+            if (wasConnected_)
+                session_.SendDatagrams(timeMs, sendDatagram);
+            QueueControlDatagram(sendQueue, UDPDatagramKind::Disconnect);
+            finalize = true;
+            break;
+        }
+    }
+
+    DeliverMessages();
+
+    if (finalize)
+    {
+        Finalize();
+        return false;
+    }
+    return true;
+}
+
+void UDPConnection::Finalize()
+{
+    bool wasConnected = false;
+    {
+        MutexLock lock(mutex_);
+        if (state_ == State::Disconnected)
+            return;
+
+        state_ = State::Disconnected;
+        wasConnected = wasConnected_;
+    }
+
+    if (wasConnected)
+    {
+        if (onDisconnected_)
+            onDisconnected_();
+    }
+    else
+    {
+        if (onError_)
+            onError_();
+    }
+
+    if (server_)
+        server_->OnDisconnected(this);
+}
+
+void UDPConnection::DeliverMessages()
+{
+    // Messages are kept until server-side user code subscribes to them
+    if (receivedMessages_.empty() || !onMessage_)
+        return;
+
+    for (const auto& [offset, size] : receivedMessages_)
+        onMessage_(ea::string_view{reinterpret_cast<const char*>(receivedData_.data() + offset), size});
+
+    receivedMessages_.clear();
+    receivedData_.clear();
+}
+
+void UDPConnection::QueueControlDatagram(
+    UDPSendQueue& sendQueue, UDPDatagramKind kind, unsigned long long challengeToken)
+{
+    VectorBuffer datagram;
+    datagram.WriteUByte(static_cast<unsigned char>(kind));
+    if (kind == UDPDatagramKind::Connect)
+    {
+        datagram.WriteUInt(ProtocolId);
+        datagram.WriteUInt64(challengeToken);
+    }
+
+    sendQueue.Add(endpoint_, datagram.GetBuffer());
+    session_.AddSentControlDatagram(datagram.GetSize());
+}
+
+} // namespace Urho3D
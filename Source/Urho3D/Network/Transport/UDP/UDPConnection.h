@@ -0,0 +1,101 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Core/Mutex.h"
+#include "Urho3D/Core/Thread.h"
+#include "Urho3D/Core/Timer.h"
+#include "Urho3D/Network/Transport/NetworkConnection.h"
+#include "Urho3D/Network/Transport/UDP/UDPSession.h"
+#include "Urho3D/Network/Transport/UDP/UDPSocket.h"
+
+namespace Urho3D
+{
+
+class UDPServer;
+
+/// Connection of native UDP transport.
+/// Client connections own socket and network thread, server connections are driven by the server thread.
+/// Messages are queued by SendMessage and sent from the network thread in coalesced datagrams.
+class URHO3D_API UDPConnection : public NetworkConnection, public Thread
+{
+    friend class UDPServer;
+    URHO3D_OBJECT(UDPConnection, NetworkConnection);
+
+public:
+    /// Protocol identifier sent in connection request.
+    static constexpr unsigned ProtocolId = 0x55445031;
+    /// Interval between connection requests, in milliseconds.
+    static constexpr unsigned ConnectIntervalMs = 100;
+    /// Interval between challenge token updates on the server, in milliseconds.
+    /// Token is valid for up to two intervals.
+    static constexpr unsigned ChallengeIntervalMs = 10000;
+    /// Connection is closed if nothing is received for this time, in milliseconds.
+    static constexpr unsigned TimeoutMs = 5000;
+    /// Interval between network thread updates, in milliseconds.
+    static constexpr unsigned UpdateIntervalMs = 2;
+
+    explicit UDPConnection(Context* context);
+    ~UDPConnection() override;
+    static void RegisterObject(Context* context);
+
+    /// Implement NetworkConnection.
+    /// @{
+    /// Supports "udp" scheme or no scheme. Host is resolved to IPv4 address.
+    bool Connect(const URL& url) override;
+    void Disconnect() override;
+    void SendMessage(ea::string_view data, PacketTypeFlags type = PacketType::ReliableOrdered) override;
+    unsigned GetMaxMessageSize() const override;
+    /// @}
+
+    /// Return statistics of the session.
+    UDPSessionStats GetStats() const;
+    /// Return smoothed round trip time in milliseconds.
+    float GetRoundTripTime() const;
+
+    /// Implement Thread. Only used by client connections.
+    void ThreadFunction() override;
+
+protected:
+    /// Initialize server connection after connection request from the endpoint.
+    void InitializeFromServer(UDPServer* server, const UDPEndpoint& endpoint, long long timeMs);
+    /// Process datagram received from remote endpoint. Called from network thread.
+    void ProcessDatagram(ConstByteSpan data, long long timeMs);
+    /// Send pending datagrams and check timeouts. Called from network thread.
+    /// Return false when connection is closed and should not be updated anymore.
+    bool Update(long long timeMs, UDPSendQueue& sendQueue);
+
+private:
+    /// Finalize connection and invoke callbacks. Called from network thread.
+    void Finalize();
+    /// Pass received messages to the user. Called from network thread outside of the lock.
+    void DeliverMessages();
+    /// Add control datagram to send queue. Challenge token is only used by Connect datagram.
+    void QueueControlDatagram(UDPSendQueue& sendQueue, UDPDatagramKind kind, unsigned long long challengeToken = 0);
+
+    /// Protects session and state.
+    mutable Mutex mutex_;
+    UDPSession session_;
+    UDPEndpoint endpoint_;
+    WeakPtr<UDPServer> server_;
+    bool wasConnected_{};
+
+    /// Client-only state.
+    /// @{
+    UDPSocket socket_;
+    HiresTimer timer_;
+    long long connectStartTimeMs_{};
+    long long lastConnectRequestTimeMs_{};
+    unsigned long long challengeToken_{};
+    /// @}
+
+    /// Messages received but not delivered yet. Only accessed from network thread.
+    /// @{
+    ByteVector receivedData_;
+    ea::vector<ea::pair<unsigned, unsigned>> receivedMessages_;
+    /// @}
+};
+
+} // namespace Urho3D
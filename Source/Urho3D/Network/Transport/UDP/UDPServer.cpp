@@ -0,0 +1,261 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Network/Transport/UDP/UDPServer.h"
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/IO/MemoryBuffer.h"
+#include "Urho3D/IO/VectorBuffer.h"
+#include "Urho3D/Network/Transport/UDP/UDPConnection.h"
+
+#include <random>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+unsigned long long RotateLeft(unsigned long long value, unsigned bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+/// SipHash-2-4 of the message consisting of 64-bit little-endian words.
+unsigned long long SipHash(const unsigned long long (&key)[2], std::initializer_list<unsigned long long> words)
+{
+    unsigned long long v0 = 0x736f6d6570736575ull ^ key[0];
+    unsigned long long v1 = 0x646f72616e646f6dull ^ key[1];
+    unsigned long long v2 = 0x6c7967656e657261ull ^ key[0];
+    unsigned long long v3 = 0x7465646279746573ull ^ key[1];
+
+    const auto round = [&]
+    {
+        v0 += v1; v1 = RotateLeft(v1, 13); v1 ^= v0; v0 = RotateLeft(v0, 32);
+        v2 += v3; v3 = RotateLeft(v3, 16); v3 ^= v2;
+        v0 += v3; v3 = RotateLeft(v3, 21); v3 ^= v0;
+        v2 += v1; v1 = RotateLeft(v1, 17); v1 ^= v2; v2 = RotateLeft(v2, 32);
+    };
+
+    const auto compress = [&](unsigned long long word)
+    {
+        v3 ^= word;
+        round();
+        round();
+        v0 ^= word;
+    };
+
+    for (unsigned long long word : words)
+        compress(word);
+    compress(static_cast<unsigned long long>(words.size() * 8) << 56);
+
+    v2 ^= 0xff;
+    round();
+    round();
+    round();
+    round();
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+} // namespace
+
+UDPServer::UDPServer(Context* context)
+    : NetworkServer(context)
+    , Thread("UDPServer")
+{
+}
+
+UDPServer::~UDPServer()
+{
+    Stop();
+}
+
+void UDPServer::RegisterObject(Context* context)
+{
+    context->AddAbstractReflection<UDPServer>(Category_Network);
+}
+
+bool UDPServer::Listen(const URL& url)
+{
+    if (!url.scheme_.empty() && url.scheme_ != "udp")
+    {
+        URHO3D_LOGERROR("UDP transport does not support scheme '{}'", url.scheme_);
+        return false;
+    }
+
+    Stop();
+    if (!socket_.Open(url.port_))
+        return false;
+
+    std::random_device randomDevice;
+    for (unsigned long long& keyPart : challengeKey_)
+        keyPart = (static_cast<unsigned long long>(randomDevice()) << 32) | randomDevice();
+
+    timer_.Reset();
+    lastUpdateTimeMs_ = 0;
+    if (!Run())
+    {
+        URHO3D_LOGERROR("Failed to start UDP server thread");
+        socket_.Close();
+        return false;
+    }
+    return true;
+}
+
+void UDPServer::Stop()
+{
+    Thread::Stop();
+
+    ea::vector<SharedPtr<UDPConnection>> connections;
+    {
+        MutexLock lock(mutex_);
+        for (const auto& [endpoint, connection] : connections_)
+            connections.push_back(connection);
+        connections_.clear();
+    }
+
+    // Notify clients so they don't have to wait for timeout
+    for (UDPConnection* connection : connections)
+    {
+        if (connection->GetState() == NetworkConnection::State::Disconnected)
+            continue;
+
+        connection->QueueControlDatagram(sendQueue_, UDPDatagramKind::Disconnect);
+        connection->Finalize();
+    }
+    socket_.Send(sendQueue_);
+    socket_.Close();
+}
+
+unsigned UDPServer::GetNumConnections() const
+{
+    MutexLock lock(mutex_);
+    return connections_.size();
+}
+
+long long UDPServer::GetProcessingTime() const
+{
+    return processingTimeUs_.load(std::memory_order_relaxed);
+}
+
+void UDPServer::ThreadFunction()
+{
+    while (shouldRun_)
+    {
+        socket_.Wait(UDPConnection::UpdateIntervalMs);
+
+        HiresTimer processingTimer;
+        const long long timeMs = timer_.GetUSec(false) / 1000;
+        while (const unsigned numReceived = socket_.Receive(incoming_))
+        {
+            for (unsigned i = 0; i < numReceived; ++i)
+                ProcessDatagram(incoming_[i], timeMs);
+            if (numReceived < UDPSocket::MaxReceiveBatch)
+                break;
+        }
+
+        // Datagrams are received as soon as possible, but sent in batches
+        if (timeMs - lastUpdateTimeMs_ >= UDPConnection::UpdateIntervalMs)
+        {
+            UpdateConnections(timeMs);
+            lastUpdateTimeMs_ = timeMs;
+        }
+
+        socket_.Send(sendQueue_);
+        processingTimeUs_.fetch_add(processingTimer.GetUSec(false), std::memory_order_relaxed);
+    }
+}
+
+void UDPServer::OnDisconnected(UDPConnection* connection)
+{
+    if (onDisconnected_)
+        onDisconnected_(connection);
+}
+
+void UDPServer::ProcessDatagram(const UDPDatagram& datagram, long long timeMs)
+{
+    if (datagram.data_.empty())
+        return;
+
+    // Connections are only modified from this thread, so lookup doesn't need lock
+    const auto iter = connections_.find(datagram.endpoint_);
+    SharedPtr<UDPConnection> connection = iter != connections_.end() ? iter->second : nullptr;
+
+    const auto kind = static_cast<UDPDatagramKind>(datagram.data_[0]);
+    if (kind != UDPDatagramKind::Connect)
+    {
+        if (connection)
+            connection->ProcessDatagram(datagram.data_, timeMs);
+        return;
+    }
+
+    MemoryBuffer source(datagram.data_);
+    source.ReadUByte();
+    if (source.ReadUInt() != UDPConnection::ProtocolId)
+        return;
+
+    // Challenge response is smaller than request, so it cannot be used for amplification
+    if (!IsChallengeTokenValid(datagram.endpoint_, source.ReadUInt64(), timeMs))
+    {
+        VectorBuffer response;
+        response.WriteUByte(static_cast<unsigned char>(UDPDatagramKind::Challenge));
+        response.WriteUInt64(GetChallengeToken(datagram.endpoint_, timeMs / UDPConnection::ChallengeIntervalMs));
+        sendQueue_.Add(datagram.endpoint_, response.GetBuffer());
+        return;
+    }
+
+    // Repeated request means that Accept was lost
+    if (connection && connection->GetState() != NetworkConnection::State::Disconnected)
+    {
+        connection->QueueControlDatagram(sendQueue_, UDPDatagramKind::Accept);
+        return;
+    }
+
+    connection = MakeShared<UDPConnection>(context_);
+    connection->InitializeFromServer(this, datagram.endpoint_, timeMs);
+    {
+        MutexLock lock(mutex_);
+        connections_[datagram.endpoint_] = connection;
+    }
+
+    connection->QueueControlDatagram(sendQueue_, UDPDatagramKind::Accept);
+    if (onConnected_)
+        onConnected_(connection);
+}
+
+unsigned long long UDPServer::GetChallengeToken(const UDPEndpoint& endpoint, long long interval) const
+{
+    const unsigned long long address = (static_cast<unsigned long long>(endpoint.address_) << 16) | endpoint.port_;
+    return SipHash(challengeKey_, {address, static_cast<unsigned long long>(interval)});
+}
+
+bool UDPServer::IsChallengeTokenValid(const UDPEndpoint& endpoint, unsigned long long token, long long timeMs) const
+{
+    const long long interval = timeMs / UDPConnection::ChallengeIntervalMs;
+    return token == GetChallengeToken(endpoint, interval) || token == GetChallengeToken(endpoint, interval - 1);
+}
+
+void UDPServer::UpdateConnections(long long timeMs)
+{
+    ea::vector<UDPEndpoint> closedConnections;
+    for (const auto& [endpoint, connection] : connections_)
+    {
+        if (!connection->Update(timeMs, sendQueue_))
+            closedConnections.push_back(endpoint);
+    }
+
+    if (!closedConnections.empty())
+    {
+        MutexLock lock(mutex_);
+        for (const UDPEndpoint& endpoint : closedConnections)
+            connections_.erase(endpoint);
+    }
+}
+
+} // namespace Urho3D
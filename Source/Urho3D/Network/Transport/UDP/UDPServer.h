@@ -0,0 +1,82 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Core/Mutex.h"
+#include "Urho3D/Core/Thread.h"
+#include "Urho3D/Core/Timer.h"
+#include "Urho3D/Network/Transport/NetworkServer.h"
+#include "Urho3D/Network/Transport/UDP/UDPSocket.h"
+
+#include <EASTL/unordered_map.h>
+
+#include <atomic>
+
+namespace Urho3D
+{
+
+class UDPConnection;
+
+/// Server of native UDP transport.
+/// All connections share one socket and one network thread that receives and sends datagrams in batches.
+/// Connection is created only after the client sends back the challenge token bound to its address.
+class URHO3D_API UDPServer : public NetworkServer, public Thread
+{
+    friend class UDPConnection;
+    URHO3D_OBJECT(UDPServer, NetworkServer);
+
+public:
+    explicit UDPServer(Context* context);
+    ~UDPServer() override;
+    static void RegisterObject(Context* context);
+
+    /// Implement NetworkServer.
+    /// @{
+    /// Supports "udp" scheme or no scheme. Host is ignored, server listens on all interfaces.
+    bool Listen(const URL& url) override;
+    void Stop() override;
+    /// @}
+
+    /// Return port the server is listening on. Useful if the server was started on port 0.
+    unsigned short GetPort() const { return socket_.GetLocalPort(); }
+    /// Return number of active connections.
+    unsigned GetNumConnections() const;
+    /// Return time spent by network thread on processing datagrams, in microseconds.
+    long long GetProcessingTime() const;
+
+    /// Implement Thread.
+    void ThreadFunction() override;
+
+protected:
+    void OnDisconnected(UDPConnection* connection);
+
+private:
+    void ProcessDatagram(const UDPDatagram& datagram, long long timeMs);
+    void UpdateConnections(long long timeMs);
+    /// Return challenge token for the endpoint in the given interval.
+    unsigned long long GetChallengeToken(const UDPEndpoint& endpoint, long long interval) const;
+    /// Return whether the challenge token is valid for the endpoint in current or previous interval.
+    bool IsChallengeTokenValid(const UDPEndpoint& endpoint, unsigned long long token, long long timeMs) const;
+
+    UDPSocket socket_;
+    HiresTimer timer_;
+
+    /// Protects the list of connections.
+    mutable Mutex mutex_;
+    ea::unordered_map<UDPEndpoint, SharedPtr<UDPConnection>> connections_;
+
+    /// Only accessed from network thread.
+    /// @{
+    ea::vector<UDPDatagram> incoming_;
+    UDPSendQueue sendQueue_;
+    long long lastUpdateTimeMs_{};
+    /// Secret key of challenge tokens, regenerated on every Listen.
+    unsigned long long challengeKey_[2]{};
+    /// @}
+
+    std::atomic<long long> processingTimeUs_{};
+};
+
+} // namespace Urho3D
@@ -0,0 +1,362 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Network/Transport/UDP/UDPSession.h"
+
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/IO/MemoryBuffer.h"
+#include "Urho3D/IO/VectorBuffer.h"
+#include "Urho3D/Math/MathDefs.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Return signed distance between 16-bit sequence numbers, taking wrap-around into account.
+int GetSequenceDifference(unsigned short lhs, unsigned short rhs)
+{
+    return static_cast<short>(static_cast<unsigned short>(lhs - rhs));
+}
+
+/// Return whether the packet type has per-channel sequence number.
+bool HasChannelSequence(PacketTypeFlags type)
+{
+    return type.Test(PacketType::Reliable) || type.Test(PacketType::Ordered);
+}
+
+unsigned GetMessageHeaderSize(const ByteVector& data, PacketTypeFlags type)
+{
+    unsigned sizeOfSize = 1;
+    for (unsigned size = data.size(); size >= 0x80; size >>= 7)
+        ++sizeOfSize;
+    return 1 + (HasChannelSequence(type) ? 2 : 0) + sizeOfSize;
+}
+
+} // namespace
+
+void UDPSession::QueueMessage(ea::string_view data, PacketTypeFlags type)
+{
+    if (data.size() > MaxMessageSize)
+    {
+        URHO3D_LOGERROR("UDP message of {} bytes exceeds max message size of {} bytes", data.size(), MaxMessageSize);
+        return;
+    }
+
+    QueuedMessage& message = sendQueue_.push_back();
+    message.data_.assign(data.begin(), data.end());
+    message.type_ = type;
+    if (HasChannelSequence(type))
+        message.sequence_ = channels_[GetChannelIndex(type)].nextOutgoingSequence_++;
+}
+
+void UDPSession::AddSentControlDatagram(unsigned size)
+{
+    ++stats_.numDatagramsSent_;
+    stats_.numBytesSent_ += size;
+}
+
+long long UDPSession::GetResendTimeout() const
+{
+    const auto timeout = static_cast<long long>(roundTripTimeMs_ * 2.0f);
+    return Clamp<long long>(timeout, MinResendTimeoutMs, MaxResendTimeoutMs);
+}
+
+ea::optional<unsigned short> UDPSession::GetOldestReliableDatagram() const
+{
+    ea::optional<unsigned short> result;
+    for (const auto& [id, reliableMessage] : reliableInFlight_)
+    {
+        if (!result || GetSequenceDifference(reliableMessage.datagramSequence_, *result) < 0)
+            result = reliableMessage.datagramSequence_;
+    }
+    return result;
+}
+
+void UDPSession::SendDatagrams(long long timeMs, const DatagramCallback& sendDatagram)
+{
+    VectorBuffer datagram;
+    SentDatagram* sentDatagram = nullptr;
+
+    const auto flushDatagram = [&]
+    {
+        if (!sentDatagram)
+            return;
+
+        sendDatagram(datagram.GetBuffer());
+        ++stats_.numDatagramsSent_;
+        stats_.numBytesSent_ += datagram.GetSize();
+        lastSendTimeMs_ = timeMs;
+        acknowledgementPending_ = false;
+        sentDatagram = nullptr;
+    };
+
+    const auto beginDatagram = [&]
+    {
+        // Sequence 0 is reserved to indicate that nothing was received yet
+        if (nextDatagramSequence_ == 0)
+            ++nextDatagramSequence_;
+        const unsigned short sequence = nextDatagramSequence_++;
+
+        sentDatagram = &sentDatagrams_[sequence % sentDatagrams_.size()];
+        sentDatagram->sequence_ = sequence;
+        sentDatagram->valid_ = true;
+        sentDatagram->sendTimeMs_ = timeMs;
+        sentDatagram->reliableIds_.clear();
+
+        datagram.Clear();
+        datagram.WriteUByte(static_cast<unsigned char>(UDPDatagramKind::Data));
+        datagram.WriteUShort(sequence);
+        datagram.WriteUShort(hasRemoteSequence_ ? remoteSequence_ : 0);
+        datagram.WriteUInt(hasRemoteSequence_ ? remoteAckBits_ : 0);
+    };
+
+    const auto fitsIntoDatagram = [&](const QueuedMessage& message)
+    {
+        const unsigned messageSize = GetMessageHeaderSize(message.data_, message.type_) + message.data_.size();
+        return sentDatagram && datagram.GetSize() + messageSize <= MaxDatagramSize;
+    };
+
+    const auto writeMessage = [&](const QueuedMessage& message)
+    {
+        if (sentDatagram && !fitsIntoDatagram(message))
+            flushDatagram();
+        if (!sentDatagram)
+            beginDatagram();
+
+        datagram.WriteUByte(static_cast<unsigned char>(message.type_.AsInteger()));
+        if (HasChannelSequence(message.type_))
+            datagram.WriteUShort(message.sequence_);
+        datagram.WriteVLE(message.data_.size());
+        datagram.Write(message.data_.data(), message.data_.size());
+    };
+
+    // Resend reliable messages that were not acknowledged in time, oldest first
+    const long long resendTimeout = GetResendTimeout();
+    for (auto& [id, reliableMessage] : reliableInFlight_)
+    {
+        if (timeMs - reliableMessage.lastSendTimeMs_ < resendTimeout)
+            continue;
+
+        writeMessage(reliableMessage.message_);
+        sentDatagram->reliableIds_.push_back(id);
+        reliableMessage.lastSendTimeMs_ = timeMs;
+        reliableMessage.datagramSequence_ = sentDatagram->sequence_;
+        ++stats_.numMessagesResent_;
+    }
+
+    // Datagrams outside of acknowledgement window would never be acknowledged and would be resent over and over,
+    // so new reliable messages wait until the oldest datagram with reliable messages is acknowledged
+    ea::optional<unsigned short> oldestReliableDatagram = GetOldestReliableDatagram();
+    const auto isInWindow = [&](const QueuedMessage& message)
+    {
+        if (!oldestReliableDatagram)
+            return true;
+
+        const unsigned short nextSequence = nextDatagramSequence_ != 0 ? nextDatagramSequence_ : 1;
+        const unsigned short sequence = fitsIntoDatagram(message) ? sentDatagram->sequence_ : nextSequence;
+        return GetSequenceDifference(sequence, *oldestReliableDatagram) < static_cast<int>(MaxDatagramsInFlight);
+    };
+
+    // Send new messages in the order they were queued
+    while (!sendQueue_.empty())
+    {
+        QueuedMessage& message = sendQueue_.front();
+        const bool isReliable = message.type_.Test(PacketType::Reliable);
+        if (isReliable && (reliableInFlight_.size() >= MaxReliableInFlight || !isInWindow(message)))
+            break;
+
+        writeMessage(message);
+        ++stats_.numMessagesSent_;
+
+        if (isReliable)
+        {
+            const unsigned id = nextReliableId_++;
+            sentDatagram->reliableIds_.push_back(id);
+            reliableInFlight_.emplace(id, ReliableMessage{ea::move(message), timeMs, sentDatagram->sequence_});
+            if (!oldestReliableDatagram)
+                oldestReliableDatagram = sentDatagram->sequence_;
+        }
+        sendQueue_.pop_front();
+    }
+
+    // Send acknowledgements even if there is no data
+    if (!sentDatagram && (acknowledgementPending_ || timeMs - lastSendTimeMs_ >= KeepAliveIntervalMs))
+        beginDatagram();
+
+    flushDatagram();
+}
+
+bool UDPSession::ProcessDatagram(ConstByteSpan datagram, long long timeMs, const MessageCallback& onMessage)
+{
+    if (datagram.size() < DataHeaderSize)
+        return false;
+
+    MemoryBuffer source(datagram.data(), datagram.size());
+    if (source.ReadUByte() != static_cast<unsigned char>(UDPDatagramKind::Data))
+        return false;
+
+    const unsigned short sequence = source.ReadUShort();
+    const unsigned short ackSequence = source.ReadUShort();
+    const unsigned ackBits = source.ReadUInt();
+
+    ++stats_.numDatagramsReceived_;
+    stats_.numBytesReceived_ += datagram.size();
+    lastReceiveTimeMs_ = timeMs;
+
+    if (ackSequence != 0)
+    {
+        ProcessAcknowledgement(ackSequence, timeMs);
+        for (unsigned i = 0; i < 32; ++i)
+        {
+            if (ackBits & (1u << i))
+                ProcessAcknowledgement(static_cast<unsigned short>(ackSequence - i - 1), timeMs);
+        }
+    }
+
+    if (sequence == 0 || !RecordIncomingSequence(sequence))
+        return sequence != 0;
+
+    // Empty datagrams carry only acknowledgements and don't need to be acknowledged
+    if (source.IsEof())
+        return true;
+
+    acknowledgementPending_ = true;
+    while (!source.IsEof())
+    {
+        const unsigned char type = source.ReadUByte();
+        if (type > PacketType::ReliableOrdered)
+            return false;
+
+        const PacketTypeFlags packetType{static_cast<PacketType>(type)};
+        const unsigned short messageSequence = HasChannelSequence(packetType) ? source.ReadUShort() : 0;
+        const unsigned size = source.ReadVLE();
+        if (size > source.GetSize() - source.GetPosition())
+            return false;
+
+        const auto data = reinterpret_cast<const char*>(datagram.data() + source.GetPosition());
+        source.Seek(source.GetPosition() + size);
+        ProcessMessage(packetType, messageSequence, ea::string_view{data, size}, onMessage);
+    }
+    return true;
+}
+
+void UDPSession::ProcessAcknowledgement(unsigned short sequence, long long timeMs)
+{
+    SentDatagram& sentDatagram = sentDatagrams_[sequence % sentDatagrams_.size()];
+    if (!sentDatagram.valid_ || sentDatagram.sequence_ != sequence)
+        return;
+
+    sentDatagram.valid_ = false;
+    for (unsigned id : sentDatagram.reliableIds_)
+        reliableInFlight_.erase(id);
+
+    const auto sample = static_cast<float>(timeMs - sentDatagram.sendTimeMs_);
+    roundTripTimeMs_ = Lerp(roundTripTimeMs_, sample, 0.125f);
+}
+
+bool UDPSession::RecordIncomingSequence(unsigned short sequence)
+{
+    if (!hasRemoteSequence_)
+    {
+        hasRemoteSequence_ = true;
+        remoteSequence_ = sequence;
+        remoteAckBits_ = 0;
+        return true;
+    }
+
+    const int difference = GetSequenceDifference(sequence, remoteSequence_);
+    if (difference > 0)
+    {
+        if (difference < 32)
+            remoteAckBits_ = (remoteAckBits_ << difference) | (1u << (difference - 1));
+        else if (difference == 32)
+            remoteAckBits_ = 1u << 31;
+        else
+            remoteAckBits_ = 0;
+        remoteSequence_ = sequence;
+        return true;
+    }
+
+    // Datagrams older than acknowledgement window are dropped, reliable messages in them will be resent
+    const int age = -difference;
+    if (age == 0 || age > 32)
+        return false;
+
+    const unsigned bit = 1u << (age - 1);
+    if (remoteAckBits_ & bit)
+        return false;
+
+    remoteAckBits_ |= bit;
+    return true;
+}
+
+void UDPSession::ProcessMessage(
+    PacketTypeFlags type, unsigned short sequence, ea::string_view data, const MessageCallback& onMessage)
+{
+    Channel& channel = channels_[GetChannelIndex(type)];
+
+    const auto deliver = [&](ea::string_view messageData)
+    {
+        ++stats_.numMessagesReceived_;
+        onMessage(messageData);
+    };
+
+    if (!type.Test(PacketType::Reliable))
+    {
+        if (type.Test(PacketType::Ordered))
+        {
+            if (channel.hasIncomingSequence_ && GetSequenceDifference(sequence, channel.lastIncomingSequence_) <= 0)
+                return;
+
+            channel.hasIncomingSequence_ = true;
+            channel.lastIncomingSequence_ = sequence;
+        }
+        deliver(data);
+        return;
+    }
+
+    const bool isOrdered = type.Test(PacketType::Ordered);
+    const int difference = GetSequenceDifference(sequence, channel.nextIncomingSequence_);
+    if (difference < 0)
+        return;
+
+    if (difference > 0)
+    {
+        if (channel.receivedAhead_.find(sequence) != channel.receivedAhead_.end())
+            return;
+
+        if (isOrdered)
+            channel.receivedAhead_.emplace(sequence, ByteVector(data.begin(), data.end()));
+        else
+        {
+            channel.receivedAhead_.emplace(sequence, ByteVector{});
+            deliver(data);
+        }
+        return;
+    }
+
+    deliver(data);
+    ++channel.nextIncomingSequence_;
+
+    // Advance over messages received ahead of time
+    while (!channel.receivedAhead_.empty())
+    {
+        const auto iter = channel.receivedAhead_.find(channel.nextIncomingSequence_);
+        if (iter == channel.receivedAhead_.end())
+            break;
+
+        if (isOrdered)
+            deliver(ea::string_view{reinterpret_cast<const char*>(iter->second.data()), iter->second.size()});
+        channel.receivedAhead_.erase(iter);
+        ++channel.nextIncomingSequence_;
+    }
+}
+
+} // namespace Urho3D
@@ -0,0 +1,192 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Urho3D.h"
+
+#include "Urho3D/Container/ByteVector.h"
+#include "Urho3D/Network/PacketTypeFlags.h"
+
+#include <EASTL/array.h>
+#include <EASTL/deque.h>
+#include <EASTL/functional.h>
+#include <EASTL/map.h>
+#include <EASTL/optional.h>
+#include <EASTL/string_view.h>
+#include <EASTL/unordered_map.h>
+
+namespace Urho3D
+{
+
+/// Kind of UDP transport datagram, stored in the first byte.
+enum class UDPDatagramKind : unsigned char
+{
+    /// Client requests connection. Repeated until accepted.
+    /// Contains protocol identifier and challenge token, which is zero until received from server.
+    Connect = 0xa1,
+    /// Server accepts connection. Sent in response to every Connect with valid challenge token.
+    Accept,
+    /// Messages and acknowledgements.
+    Data,
+    /// Connection is closed by either side.
+    Disconnect,
+    /// Server responds to Connect without valid token with the token for the client address.
+    /// Server doesn't keep any state until the token is sent back, so spoofed addresses cannot create connections.
+    Challenge,
+};
+
+/// Statistics of UDP session.
+struct URHO3D_API UDPSessionStats
+{
+    /// Number of sent datagrams, including control and resent ones.
+    unsigned numDatagramsSent_{};
+    /// Number of bytes sent in datagrams.
+    unsigned long long numBytesSent_{};
+    /// Number of messages sent for the first time.
+    unsigned numMessagesSent_{};
+    /// Number of resent reliable messages.
+    unsigned numMessagesResent_{};
+    /// Number of received datagrams.
+    unsigned numDatagramsReceived_{};
+    /// Number of bytes received in datagrams.
+    unsigned long long numBytesReceived_{};
+    /// Number of messages passed to user.
+    unsigned numMessagesReceived_{};
+};
+
+/// Reliability layer of UDP transport, independent from sockets. Not thread-safe.
+///
+/// Data datagram layout:
+/// - UByte kind, UShort sequence, UShort acknowledged sequence, UInt acknowledgement bits for 32 previous sequences;
+/// - messages until the end of datagram: UByte packet type, UShort channel sequence if reliable or ordered,
+///   VLE size, data.
+///
+/// Small messages are coalesced into datagrams of limited size.
+/// Each packet type is a separate channel with its own sequence numbers.
+/// Reliable messages are resent until the datagram containing them is acknowledged.
+/// Reliable messages are sent only within acknowledgement window, so every datagram with them can be acknowledged.
+/// Ordered unreliable messages older than the last received one are dropped.
+class URHO3D_API UDPSession
+{
+public:
+    /// Max size of datagram payload that is safe from IP fragmentation.
+    static constexpr unsigned MaxDatagramSize = 1200;
+    /// Size of data datagram header.
+    static constexpr unsigned DataHeaderSize = 1 + 2 + 2 + 4;
+    /// Max size of message header.
+    static constexpr unsigned MaxMessageHeaderSize = 1 + 2 + 2;
+    /// Max size of message that fits into one datagram.
+    static constexpr unsigned MaxMessageSize = MaxDatagramSize - DataHeaderSize - MaxMessageHeaderSize;
+    /// Max number of unacknowledged reliable messages. New reliable messages wait in queue if exceeded.
+    static constexpr unsigned MaxReliableInFlight = 8192;
+    /// Max distance between sequences of the oldest and the newest datagram with unacknowledged reliable messages.
+    /// Equals to the number of sequences covered by one acknowledgement.
+    static constexpr unsigned MaxDatagramsInFlight = 33;
+    /// Interval of keep-alive datagrams, in milliseconds.
+    static constexpr unsigned KeepAliveIntervalMs = 100;
+    /// Min and max resend timeout, in milliseconds.
+    static constexpr unsigned MinResendTimeoutMs = 30;
+    static constexpr unsigned MaxResendTimeoutMs = 1000;
+
+    using MessageCallback = ea::function<void(ea::string_view data)>;
+    using DatagramCallback = ea::function<void(ConstByteSpan data)>;
+
+    /// Queue message for sending. Message should not be larger than MaxMessageSize.
+    void QueueMessage(ea::string_view data, PacketTypeFlags type);
+    /// Process received Data datagram and pass received messages to the callback in delivery order.
+    /// Return false if the datagram is malformed.
+    bool ProcessDatagram(ConstByteSpan datagram, long long timeMs, const MessageCallback& onMessage);
+    /// Write outgoing Data datagrams: new messages, reliable messages to resend and acknowledgements.
+    void SendDatagrams(long long timeMs, const DatagramCallback& sendDatagram);
+
+    /// Return whether there are queued messages or unacknowledged reliable messages.
+    bool HasPendingMessages() const { return !sendQueue_.empty() || !reliableInFlight_.empty(); }
+    /// Return time of the last received datagram.
+    long long GetLastReceiveTime() const { return lastReceiveTimeMs_; }
+    /// Set time of the last received datagram. Used to start connection timeout.
+    void SetLastReceiveTime(long long timeMs) { lastReceiveTimeMs_ = timeMs; }
+    /// Return smoothed round trip time in milliseconds.
+    float GetRoundTripTime() const { return roundTripTimeMs_; }
+    /// Return statistics.
+    const UDPSessionStats& GetStats() const { return stats_; }
+    /// Account control datagram in statistics.
+    void AddSentControlDatagram(unsigned size);
+
+private:
+    struct QueuedMessage
+    {
+        ByteVector data_;
+        PacketTypeFlags type_;
+        unsigned short sequence_{};
+    };
+
+    struct ReliableMessage
+    {
+        QueuedMessage message_;
+        long long lastSendTimeMs_{};
+        /// Sequence of the datagram the message was last sent in.
+        unsigned short datagramSequence_{};
+    };
+
+    struct SentDatagram
+    {
+        unsigned short sequence_{};
+        bool valid_{};
+        long long sendTimeMs_{};
+        /// Reliable messages written to this datagram.
+        ea::vector<unsigned> reliableIds_;
+    };
+
+    struct Channel
+    {
+        /// Sequence of the next outgoing message.
+        unsigned short nextOutgoingSequence_{};
+        /// Sequence of the next expected incoming message, for reliable channels.
+        unsigned short nextIncomingSequence_{};
+        /// Sequence of the last delivered message, for unreliable ordered channel.
+        unsigned short lastIncomingSequence_{};
+        bool hasIncomingSequence_{};
+        /// Reliable messages received ahead of expected sequence.
+        /// Stores data for ordered channel, empty for unordered channel.
+        ea::unordered_map<unsigned short, ByteVector> receivedAhead_;
+    };
+
+    /// Return channel index for packet type.
+    static unsigned GetChannelIndex(PacketTypeFlags type) { return type.AsInteger() & 3; }
+
+    void ProcessAcknowledgement(unsigned short sequence, long long timeMs);
+    void ProcessMessage(PacketTypeFlags type, unsigned short sequence, ea::string_view data,
+        const MessageCallback& onMessage);
+    /// Return whether the incoming datagram sequence is new and record it.
+    bool RecordIncomingSequence(unsigned short sequence);
+    /// Return resend timeout in milliseconds.
+    long long GetResendTimeout() const;
+    /// Return sequence of the oldest datagram with unacknowledged reliable messages, if any.
+    ea::optional<unsigned short> GetOldestReliableDatagram() const;
+
+    ea::array<Channel, 4> channels_;
+    ea::deque<QueuedMessage> sendQueue_;
+    /// Unacknowledged reliable messages by internal id in sending order.
+    ea::map<unsigned, ReliableMessage> reliableInFlight_;
+    unsigned nextReliableId_{};
+
+    /// Ring buffer of sent datagrams indexed by sequence.
+    ea::array<SentDatagram, 1024> sentDatagrams_;
+    unsigned short nextDatagramSequence_{};
+    long long lastSendTimeMs_{};
+
+    /// Latest received datagram sequence and bits for previous sequences.
+    unsigned short remoteSequence_{};
+    unsigned remoteAckBits_{};
+    bool hasRemoteSequence_{};
+    /// Whether acknowledgement should be sent without waiting for keep-alive interval.
+    bool acknowledgementPending_{};
+
+    long long lastReceiveTimeMs_{};
+    float roundTripTimeMs_{100.0f};
+    UDPSessionStats stats_;
+};
+
+} // namespace Urho3D
@@ -0,0 +1,293 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Network/Transport/UDP/UDPSocket.h"
+
+#include "Urho3D/IO/Log.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#include <fcntl.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+int GetLastNetworkError()
+{
+#if _WIN32
+    return WSAGetLastError();
+#else
+    return errno;
+#endif
+}
+
+void CloseSocket(int socket)
+{
+#ifdef _WIN32
+    closesocket(socket);
+#else
+    close(socket);
+#endif
+}
+
+sockaddr_in ToSocketAddress(const UDPEndpoint& endpoint)
+{
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(endpoint.port_);
+    addr.sin_addr.s_addr = htonl(endpoint.address_);
+    return addr;
+}
+
+UDPEndpoint FromSocketAddress(const sockaddr_in& addr)
+{
+    return UDPEndpoint{ntohl(addr.sin_addr.s_addr), ntohs(addr.sin_port)};
+}
+
+} // namespace
+
+ea::string UDPEndpoint::GetAddressString() const
+{
+    return Format("{}.{}.{}.{}", (address_ >> 24) & 0xff, (address_ >> 16) & 0xff, (address_ >> 8) & 0xff,
+        address_ & 0xff);
+}
+
+UDPSocket::~UDPSocket()
+{
+    Close();
+}
+
+bool UDPSocket::Open(unsigned short port)
+{
+    Close();
+
+    socket_ = static_cast<int>(socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+    if (socket_ == -1)
+    {
+        URHO3D_LOGERROR("Failed to create UDP socket: error {}", GetLastNetworkError());
+        return false;
+    }
+
+#ifdef _WIN32
+    u_long noblock = 1;
+    ioctlsocket(socket_, FIONBIO, &noblock);
+#else
+    fcntl(socket_, F_SETFL, fcntl(socket_, F_GETFL) | O_NONBLOCK);
+#endif
+
+    // Large buffers absorb bursts from many connections between network thread wake-ups
+    int bufferSize = 4 * 1024 * 1024;
+    setsockopt(socket_, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&bufferSize), sizeof(bufferSize));
+    setsockopt(socket_, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&bufferSize), sizeof(bufferSize));
+
+    sockaddr_in addr = ToSocketAddress(UDPEndpoint{INADDR_ANY, port});
+    if (bind(socket_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == -1)
+    {
+        URHO3D_LOGERROR("Failed to bind UDP socket to port {}: error {}", port, GetLastNetworkError());
+        Close();
+        return false;
+    }
+
+#ifdef _WIN32
+    int addrLen = sizeof(addr);
+#else
+    socklen_t addrLen = sizeof(addr);
+#endif
+    getsockname(socket_, reinterpret_cast<sockaddr*>(&addr), &addrLen);
+    localPort_ = ntohs(addr.sin_port);
+    return true;
+}
+
+void UDPSocket::Close()
+{
+    if (socket_ == -1)
+        return;
+
+    CloseSocket(socket_);
+    socket_ = -1;
+    localPort_ = 0;
+}
+
+bool UDPSocket::Wait(unsigned timeoutMs)
+{
+    if (socket_ == -1)
+        return false;
+
+#ifdef _WIN32
+    WSAPOLLFD fd = {};
+    fd.fd = socket_;
+    fd.events = POLLRDNORM;
+    return WSAPoll(&fd, 1, static_cast<int>(timeoutMs)) > 0;
+#else
+    pollfd fd = {};
+    fd.fd = socket_;
+    fd.events = POLLIN;
+    return poll(&fd, 1, static_cast<int>(timeoutMs)) > 0;
+#endif
+}
+
+unsigned UDPSocket::Receive(ea::vector<UDPDatagram>& datagrams)
+{
+    if (socket_ == -1)
+        return 0;
+
+    if (datagrams.size() < MaxReceiveBatch)
+        datagrams.resize(MaxReceiveBatch);
+    for (UDPDatagram& datagram : datagrams)
+        datagram.data_.resize(MaxDatagramSize);
+
+#ifdef __linux__
+    sockaddr_in addrs[MaxReceiveBatch];
+    iovec iovecs[MaxReceiveBatch];
+    mmsghdr messages[MaxReceiveBatch] = {};
+    for (unsigned i = 0; i < MaxReceiveBatch; ++i)
+    {
+        iovecs[i].iov_base = datagrams[i].data_.data();
+        iovecs[i].iov_len = MaxDatagramSize;
+        messages[i].msg_hdr.msg_iov = &iovecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+        messages[i].msg_hdr.msg_name = &addrs[i];
+        messages[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+    }
+
+    const int result = recvmmsg(socket_, messages, MaxReceiveBatch, MSG_DONTWAIT, nullptr);
+    if (result <= 0)
+        return 0;
+
+    unsigned numReceived = 0;
+    for (int i = 0; i < result; ++i)
+    {
+        if (messages[i].msg_hdr.msg_flags & MSG_TRUNC)
+            continue;
+
+        UDPDatagram& datagram = datagrams[numReceived++];
+        if (numReceived - 1 != static_cast<unsigned>(i))
+            datagram.data_.swap(datagrams[i].data_);
+        datagram.endpoint_ = FromSocketAddress(addrs[i]);
+        datagram.data_.resize(messages[i].msg_len);
+    }
+    return numReceived;
+#else
+    unsigned numReceived = 0;
+    while (numReceived < MaxReceiveBatch)
+    {
+        UDPDatagram& datagram = datagrams[numReceived];
+        sockaddr_in addr = {};
+    #ifdef _WIN32
+        int addrLen = sizeof(addr);
+    #else
+        socklen_t addrLen = sizeof(addr);
+    #endif
+        const auto result = recvfrom(socket_, reinterpret_cast<char*>(datagram.data_.data()), MaxDatagramSize, 0,
+            reinterpret_cast<sockaddr*>(&addr), &addrLen);
+        if (result < 0)
+        {
+    #ifdef _WIN32
+            // Windows reports ICMP port unreachable as receive error, it should not stop receiving
+            if (GetLastNetworkError() == WSAECONNRESET || GetLastNetworkError() == WSAEMSGSIZE)
+                continue;
+    #endif
+            break;
+        }
+
+        datagram.endpoint_ = FromSocketAddress(addr);
+        datagram.data_.resize(static_cast<unsigned>(result));
+        ++numReceived;
+    }
+    return numReceived;
+#endif
+}
+
+void UDPSocket::Send(UDPSendQueue& queue)
+{
+    const ea::vector<UDPDatagram>& datagrams = queue.GetDatagrams();
+    const unsigned count = queue.GetSize();
+    queue.Clear();
+
+    if (socket_ == -1)
+        return;
+
+#ifdef __linux__
+    static constexpr unsigned MaxSendBatch = 64;
+    sockaddr_in addrs[MaxSendBatch];
+    iovec iovecs[MaxSendBatch];
+    mmsghdr messages[MaxSendBatch];
+
+    for (unsigned batchBegin = 0; batchBegin < count; batchBegin += MaxSendBatch)
+    {
+        const unsigned batchSize = ea::min(count - batchBegin, MaxSendBatch);
+        for (unsigned i = 0; i < batchSize; ++i)
+        {
+            const UDPDatagram& datagram = datagrams[batchBegin + i];
+            addrs[i] = ToSocketAddress(datagram.endpoint_);
+            iovecs[i].iov_base = const_cast<unsigned char*>(datagram.data_.data());
+            iovecs[i].iov_len = datagram.data_.size();
+            messages[i] = {};
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+            messages[i].msg_hdr.msg_name = &addrs[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+        }
+
+        unsigned numSent = 0;
+        while (numSent < batchSize)
+        {
+            const int result = sendmmsg(socket_, messages + numSent, batchSize - numSent, MSG_NOSIGNAL);
+            // Skip datagram that failed to send
+            numSent += result > 0 ? static_cast<unsigned>(result) : 1;
+        }
+    }
+#else
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const UDPDatagram& datagram = datagrams[i];
+        const sockaddr_in addr = ToSocketAddress(datagram.endpoint_);
+        sendto(socket_, reinterpret_cast<const char*>(datagram.data_.data()), static_cast<int>(datagram.data_.size()),
+            MSG_NOSIGNAL, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    }
+#endif
+}
+
+bool UDPSocket::Resolve(const ea::string& host, unsigned short port, UDPEndpoint& endpoint)
+{
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+
+    addrinfo* result = nullptr;
+    const char* hostName = host.empty() ? "localhost" : host.c_str();
+    if (getaddrinfo(hostName, nullptr, &hints, &result) != 0 || !result)
+    {
+        URHO3D_LOGERROR("Failed to resolve host '{}'", host);
+        return false;
+    }
+
+    const auto addr = reinterpret_cast<const sockaddr_in*>(result->ai_addr);
+    endpoint.address_ = ntohl(addr->sin_addr.s_addr);
+    endpoint.port_ = port;
+    freeaddrinfo(result);
+    return true;
+}
+
+} // namespace Urho3D
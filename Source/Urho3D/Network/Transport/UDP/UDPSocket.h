@@ -0,0 +1,114 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Urho3D.h"
+
+#include "Urho3D/Container/ByteVector.h"
+#include "Urho3D/Container/Hash.h"
+#include "Urho3D/Container/Str.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+/// IPv4 address and port of UDP endpoint, in host byte order.
+struct URHO3D_API UDPEndpoint
+{
+    unsigned address_{};
+    unsigned short port_{};
+
+    /// Return address in dotted notation.
+    ea::string GetAddressString() const;
+
+    bool operator==(const UDPEndpoint& rhs) const { return address_ == rhs.address_ && port_ == rhs.port_; }
+    bool operator!=(const UDPEndpoint& rhs) const { return !(*this == rhs); }
+    unsigned ToHash() const
+    {
+        unsigned result = 0;
+        CombineHash(result, address_);
+        CombineHash(result, port_);
+        return result;
+    }
+};
+
+/// Datagram with remote endpoint.
+struct UDPDatagram
+{
+    UDPEndpoint endpoint_;
+    ByteVector data_;
+};
+
+/// Queue of outgoing datagrams. Datagram buffers are reused between batches.
+class URHO3D_API UDPSendQueue
+{
+public:
+    /// Copy datagram into the queue.
+    void Add(const UDPEndpoint& endpoint, ConstByteSpan data)
+    {
+        if (size_ == datagrams_.size())
+            datagrams_.emplace_back();
+
+        UDPDatagram& datagram = datagrams_[size_++];
+        datagram.endpoint_ = endpoint;
+        datagram.data_.assign(data.begin(), data.end());
+    }
+    /// Remove all datagrams from the queue.
+    void Clear() { size_ = 0; }
+
+    /// Return queued datagrams. Only first GetSize() datagrams are valid.
+    const ea::vector<UDPDatagram>& GetDatagrams() const { return datagrams_; }
+    /// Return number of queued datagrams.
+    unsigned GetSize() const { return size_; }
+    /// Return whether the queue is empty.
+    bool IsEmpty() const { return size_ == 0; }
+
+private:
+    ea::vector<UDPDatagram> datagrams_;
+    unsigned size_{};
+};
+
+/// Non-blocking IPv4 UDP socket with batched receive and send.
+/// Batches are received and sent with single system call on Linux, one call per datagram on other platforms.
+class URHO3D_API UDPSocket
+{
+public:
+    /// Max number of datagrams received at once.
+    static constexpr unsigned MaxReceiveBatch = 64;
+    /// Size of receive buffer per datagram. Larger datagrams are truncated and ignored.
+    static constexpr unsigned MaxDatagramSize = 1500;
+
+    UDPSocket() = default;
+    UDPSocket(const UDPSocket& other) = delete;
+    UDPSocket& operator=(const UDPSocket& other) = delete;
+    ~UDPSocket();
+
+    /// Open socket and bind it to the port. Ephemeral port is used if port is 0.
+    bool Open(unsigned short port);
+    /// Close socket.
+    void Close();
+    /// Wait until there is incoming data or timeout expires. Return true if there is data.
+    bool Wait(unsigned timeoutMs);
+    /// Receive pending datagrams. Datagrams in the vector are reused to avoid allocations.
+    /// Return number of received datagrams.
+    unsigned Receive(ea::vector<UDPDatagram>& datagrams);
+    /// Send queued datagrams and clear the queue. Errors are ignored, as for any lost datagram.
+    void Send(UDPSendQueue& queue);
+
+    /// Return whether the socket is open.
+    bool IsOpen() const { return socket_ != -1; }
+    /// Return local port.
+    unsigned short GetLocalPort() const { return localPort_; }
+
+    /// Resolve host name or address to IPv4 endpoint.
+    static bool Resolve(const ea::string& host, unsigned short port, UDPEndpoint& endpoint);
+
+private:
+    int socket_{-1};
+    unsigned short localPort_{};
+};
+
+} // namespace Urho3D
@@ -75,6 +75,7 @@ void RegisterGraphNodes(ParticleGraphSystem* system)
     Cast::RegisterObject(system);
     Noise3D::RegisterObject(system);
     CurlNoise3D::RegisterObject(system);
+    DistanceFieldCollision::RegisterObject(system);
 }
 
 }
@@ -65,6 +65,7 @@
 #include "Nodes/Cast.h"
 #include "Nodes/CurlNoise3D.h"
 #include "Nodes/Noise3D.h"
+#include "Nodes/DistanceFieldCollision.h"
 
 namespace Urho3D
 {
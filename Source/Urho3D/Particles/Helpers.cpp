@@ -180,10 +180,10 @@ void PatternMatchingNode::Update(UpdateContext& context, const NodePattern& patt
     }
 
     // Index optimization
-    if (allScalar && context.indices_.size() > 1)
+    if (allScalar && context.numParticles_ > 1)
     {
         UpdateContext contextCopy = context;
-        contextCopy.indices_ = contextCopy.indices_.subspan(0, 1);
+        contextCopy.numParticles_ = 1;
         return pattern.updateFunction_(contextCopy, pinRefs.data());
     }
 
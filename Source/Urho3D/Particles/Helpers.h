@@ -51,7 +51,7 @@ template <typename Instance, typename... Values>
 void RunUpdate(const UpdateContext& context, Instance& instance, ParticleGraphPinRef* pinRefs)
 {
     auto spans = SpanVariantTuple<Values...>::Make(context, pinRefs);
-    ea::apply(instance, ea::tuple_cat(ea::tie(context), ea::make_tuple(static_cast<unsigned>(context.indices_.size())), spans));
+    ea::apply(instance, ea::tuple_cat(ea::tie(context), ea::make_tuple(context.numParticles_), spans));
 };
 
 template <template <typename> typename T, typename ... Args>
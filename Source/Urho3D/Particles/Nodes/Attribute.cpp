@@ -42,7 +42,7 @@ template <typename T> struct CopyValues
 {
     void operator()(const UpdateContext& context, const ParticleGraphPin& pin0, const ParticleGraphPin& pin1)
     {
-        const unsigned numParticles = context.indices_.size();
+        const unsigned numParticles = context.numParticles_;
 
         auto src = context.GetSpan<T>(pin1.GetMemoryReference());
         auto dst = context.GetSpan<T>(pin0.GetMemoryReference());
@@ -94,6 +94,8 @@ public:
         return new (ptr) Instance();
     }
 
+    bool IsElementWise() const override { return true; }
+
 protected:
     ParticleGraphPin* LoadOutputPin(ParticleGraphReader& reader, GraphOutPin& pin) override;
 
@@ -138,6 +140,8 @@ public:
         return new (ptr) Instance(this);
     }
 
+    bool IsElementWise() const override { return true; }
+
 protected:
     ParticleGraphPin* LoadOutputPin(ParticleGraphReader& reader, GraphOutPin& pin) override;
 
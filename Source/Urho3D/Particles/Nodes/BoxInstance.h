@@ -59,8 +59,8 @@ public:
         {
         case EmitFrom::Edge:
         {
-            const float x = Urho3D::Random(-1.0f, 1.0f);
-            switch (Urho3D::Random(12))
+            const float x = layer_->Random(-1.0f, 1.0f);
+            switch (layer_->Random(12))
             {
             case 0: pos = Vector3{x, -1.0f, -1.0f}; break;
             case 1: pos = Vector3{x, -1.0f, +1.0f}; break;
@@ -80,9 +80,9 @@ public:
         }
         case EmitFrom::Surface:
         {
-            const float x = Urho3D::Random(-1.0f, 1.0f);
-            const float y = Urho3D::Random(-1.0f, 1.0f);
-            switch (Urho3D::Random(6))
+            const float x = layer_->Random(-1.0f, 1.0f);
+            const float y = layer_->Random(-1.0f, 1.0f);
+            switch (layer_->Random(6))
             {
             case 0: pos = Vector3{x, y, -1.0f}; break;
             case 1: pos = Vector3{x, y, 1.0f}; break;
@@ -96,7 +96,7 @@ public:
         }
         default:
         {
-            pos = Vector3{Urho3D::Random(-1.0f, 1.0f), Urho3D::Random(-1.0f, 1.0f), Urho3D::Random(-1.0f, 1.0f)};
+            pos = Vector3{layer_->Random(-1.0f, 1.0f), layer_->Random(-1.0f, 1.0f), layer_->Random(-1.0f, 1.0f)};
             vel = pos.Normalized();
             break;
         }
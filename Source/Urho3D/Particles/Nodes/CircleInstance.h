@@ -55,7 +55,7 @@ public:
     {
         const Circle* circle = static_cast<Circle*>(GetGraphNode());
 
-        const float angle = Urho3D::Random(360.0f);
+        const float angle = layer_->Random(360.0f);
         const float cosinus = Cos(angle);
         const float sinus = Sin(angle);
         const Vector3 direction = Vector3(cosinus, sinus, 0.0f);
@@ -63,7 +63,7 @@ public:
         float r = circle->GetRadius();
         if (circle->GetRadiusThickness() > 0.0f)
         {
-            r *= 1.0f - Urho3D::Random() * circle->GetRadiusThickness();
+            r *= 1.0f - layer_->Random() * circle->GetRadiusThickness();
         }
         vel = direction;
         pos = Vector3(cosinus * (r), sinus * (r), 0.0f);
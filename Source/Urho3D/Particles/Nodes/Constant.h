@@ -70,6 +70,8 @@ public:
         return new (ptr) Instance(this);
     }
 
+    bool IsElementWise() const override { return true; }
+
     /// Serialize from/to archive. Return true if successful.
     //bool Serialize(Archive& archive) override;
 
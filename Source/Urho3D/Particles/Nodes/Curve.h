@@ -89,6 +89,8 @@ public:
     /// Place new instance at the provided address.
     ParticleGraphNodeInstance* CreateInstanceAt(void* ptr, ParticleGraphLayerInstance* layer) override;
 
+    bool IsElementWise() const override { return true; }
+
 private:
     float duration_;
     bool isLooped_;
@@ -37,11 +37,11 @@ public:
     void operator()(const UpdateContext& context, unsigned numParticles, const SparseSpan<bool>& pin0)
     {
         // Iterate all particles even if all pins are scalar.
-        for (unsigned i = 0; i < context.indices_.size(); ++i)
+        for (unsigned i = 0; i < context.numParticles_; ++i)
         {
             if (pin0[i])
             {
-                context.layer_->MarkForDeletion(i);
+                context.layer_->MarkForDeletion(context.firstParticle_ + i);
             }
         }
     }
@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2021-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../../Precompiled.h"
+
+#include "DistanceFieldCollision.h"
+
+#include "../ParticleGraphLayerInstance.h"
+#include "../ParticleGraphSystem.h"
+#include "../Span.h"
+#include "../UpdateContext.h"
+#include "DistanceFieldCollisionInstance.h"
+
+namespace Urho3D
+{
+namespace ParticleGraphNodes
+{
+namespace
+{
+
+const char* collisionModeNames[]{"Bounce", "Slide", "Kill", nullptr};
+
+}
+
+void DistanceFieldCollision::RegisterObject(ParticleGraphSystem* context)
+{
+    context->AddReflection<DistanceFieldCollision>();
+    URHO3D_ACCESSOR_ATTRIBUTE("Field", GetField, SetField, ResourceRef,
+        ResourceRef{SignedDistanceField::GetTypeStatic()}, AM_DEFAULT);
+    URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Mode", GetMode, SetMode, DistanceFieldCollisionMode, collisionModeNames,
+        DistanceFieldCollisionMode::Bounce, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Radius", GetRadius, SetRadius, float, float{}, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Dampen", GetDampen, SetDampen, float, float{}, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("BounceFactor", GetBounceFactor, SetBounceFactor, float, float{}, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Worldspace", GetIsWorldspace, SetIsWorldspace, bool, bool{}, AM_DEFAULT);
+}
+
+
+DistanceFieldCollision::DistanceFieldCollision(Context* context)
+    : BaseNodeType(context
+    , PinArray {
+        ParticleGraphPin(ParticleGraphPinFlag::Input, "position", ParticleGraphContainerType::Auto),
+        ParticleGraphPin(ParticleGraphPinFlag::Input, "velocity", ParticleGraphContainerType::Auto),
+        ParticleGraphPin(ParticleGraphPinFlag::Output, "newPosition", ParticleGraphContainerType::Auto),
+        ParticleGraphPin(ParticleGraphPinFlag::Output, "newVelocity", ParticleGraphContainerType::Auto),
+    })
+{
+}
+
+/// Evaluate size required to place new node instance.
+unsigned DistanceFieldCollision::EvaluateInstanceSize() const
+{
+    return sizeof(DistanceFieldCollisionInstance);
+}
+
+/// Place new instance at the provided address.
+ParticleGraphNodeInstance* DistanceFieldCollision::CreateInstanceAt(void* ptr, ParticleGraphLayerInstance* layer)
+{
+    DistanceFieldCollisionInstance* instance = new (ptr) DistanceFieldCollisionInstance();
+    instance->Init(this, layer);
+    return instance;
+}
+
+void DistanceFieldCollision::SetField(ResourceRef value) { field_ = value; }
+
+ResourceRef DistanceFieldCollision::GetField() const { return field_; }
+
+void DistanceFieldCollision::SetMode(DistanceFieldCollisionMode value) { mode_ = value; }
+
+DistanceFieldCollisionMode DistanceFieldCollision::GetMode() const { return mode_; }
+
+void DistanceFieldCollision::SetRadius(float value) { radius_ = value; }
+
+float DistanceFieldCollision::GetRadius() const { return radius_; }
+
+void DistanceFieldCollision::SetDampen(float value) { dampen_ = value; }
+
+float DistanceFieldCollision::GetDampen() const { return dampen_; }
+
+void DistanceFieldCollision::SetBounceFactor(float value) { bounceFactor_ = value; }
+
+float DistanceFieldCollision::GetBounceFactor() const { return bounceFactor_; }
+
+void DistanceFieldCollision::SetIsWorldspace(bool value) { isWorldspace_ = value; }
+
+bool DistanceFieldCollision::GetIsWorldspace() const { return isWorldspace_; }
+
+} // namespace ParticleGraphNodes
+} // namespace Urho3D
@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2021-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../TemplateNode.h"
+#include "../ParticleGraphNode.h"
+#include "../ParticleGraphNodeInstance.h"
+
+namespace Urho3D
+{
+class ParticleGraphSystem;
+
+namespace ParticleGraphNodes
+{
+class DistanceFieldCollisionInstance;
+
+/// Reaction of particle on contact with distance field surface.
+enum class DistanceFieldCollisionMode
+{
+    /// Reflect velocity from the surface.
+    Bounce,
+    /// Remove velocity component along surface normal.
+    Slide,
+    /// Destroy particle.
+    Kill
+};
+
+/// Collide particles with baked signed distance field.
+class URHO3D_API DistanceFieldCollision
+    : public TemplateNode<DistanceFieldCollisionInstance, Vector3, Vector3, Vector3, Vector3>
+{
+    URHO3D_OBJECT(DistanceFieldCollision, ParticleGraphNode)
+public:
+    /// Construct DistanceFieldCollision.
+    explicit DistanceFieldCollision(Context* context);
+    /// Register particle node factory.
+    static void RegisterObject(ParticleGraphSystem* context);
+
+    /// Evaluate size required to place new node instance.
+    unsigned EvaluateInstanceSize() const override;
+
+    /// Place new instance at the provided address.
+    ParticleGraphNodeInstance* CreateInstanceAt(void* ptr, ParticleGraphLayerInstance* layer) override;
+
+    /// Set Field.
+    void SetField(ResourceRef value);
+    /// Get Field.
+    ResourceRef GetField() const;
+
+    /// Set Mode.
+    void SetMode(DistanceFieldCollisionMode value);
+    /// Get Mode.
+    DistanceFieldCollisionMode GetMode() const;
+
+    /// Set Radius.
+    void SetRadius(float value);
+    /// Get Radius.
+    float GetRadius() const;
+
+    /// Set Dampen.
+    void SetDampen(float value);
+    /// Get Dampen.
+    float GetDampen() const;
+
+    /// Set BounceFactor.
+    void SetBounceFactor(float value);
+    /// Get BounceFactor.
+    float GetBounceFactor() const;
+
+    /// Set Is Worldspace.
+    void SetIsWorldspace(bool value);
+    /// Get Is Worldspace.
+    bool GetIsWorldspace() const;
+
+protected:
+    ResourceRef field_{};
+    DistanceFieldCollisionMode mode_{};
+    float radius_{};
+    float dampen_{};
+    float bounceFactor_{};
+    bool isWorldspace_{};
+};
+
+} // namespace ParticleGraphNodes
+
+} // namespace Urho3D
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2021-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "DistanceFieldCollision.h"
+#include "../SignedDistanceField.h"
+#include "../../Scene/Node.h"
+
+namespace Urho3D
+{
+class ParticleGraphSystem;
+
+namespace ParticleGraphNodes
+{
+
+class DistanceFieldCollisionInstance final : public DistanceFieldCollision::InstanceBase
+{
+public:
+    void Init(ParticleGraphNode* node, ParticleGraphLayerInstance* layer) override;
+
+    void operator()(const UpdateContext& context, unsigned numParticles, const SparseSpan<Vector3>& pin0,
+        const SparseSpan<Vector3>& pin1, const SparseSpan<Vector3>& pin2, const SparseSpan<Vector3>& pin3)
+    {
+        if (!field_)
+        {
+            for (unsigned i = 0; i < numParticles; ++i)
+            {
+                pin3[i] = pin1[i];
+                pin2[i] = pin0[i] + pin1[i] * context.timeStep_;
+            }
+            return;
+        }
+
+        const auto collision = static_cast<DistanceFieldCollision*>(GetGraphNode());
+        const Node* sceneNode = collision->GetIsWorldspace() ? nullptr : GetNode();
+        const Matrix3x4 localToWorld = sceneNode ? sceneNode->GetWorldTransform() : Matrix3x4::IDENTITY;
+        const Matrix3x4 worldToLocal = localToWorld.Inverse();
+        const Matrix3 localToWorldRotation = localToWorld.ToMatrix3();
+        const Matrix3 worldToLocalRotation = worldToLocal.ToMatrix3();
+        const auto mode = collision->GetMode();
+        const float radius = collision->GetRadius();
+        const float velocityScale = 1.0f - collision->GetDampen();
+        const float reflection = mode == DistanceFieldCollisionMode::Bounce ? 1.0f + collision->GetBounceFactor() : 1.0f;
+
+        for (unsigned i = 0; i < numParticles; ++i)
+        {
+            Vector3 position = localToWorld * (pin0[i] + pin1[i] * context.timeStep_);
+            Vector3 velocity = pin1[i];
+
+            const float distance = field_->Sample(position) - radius;
+            if (distance < 0.0f)
+            {
+                if (mode == DistanceFieldCollisionMode::Kill)
+                    layer_->MarkForDeletion(context.firstParticle_ + i);
+
+                // Push particle out of geometry and remove velocity towards the surface.
+                const Vector3 normal = field_->SampleNormal(position);
+                position -= normal * distance;
+                const Vector3 worldVelocity = localToWorldRotation * velocity;
+                const float normalVelocity = worldVelocity.DotProduct(normal);
+                if (normalVelocity < 0.0f)
+                    velocity = worldToLocalRotation * ((worldVelocity - normal * (normalVelocity * reflection)) * velocityScale);
+            }
+
+            pin2[i] = worldToLocal * position;
+            pin3[i] = velocity;
+        }
+    }
+
+private:
+    /// Baked distance field.
+    SharedPtr<SignedDistanceField> field_;
+};
+
+} // namespace ParticleGraphNodes
+
+} // namespace Urho3D
@@ -38,11 +38,11 @@ public:
         const SparseSpan<float>& lifetime)
     {
         // Iterate all particles even if all pins are scalar.
-        for (unsigned i = 0; i < context.indices_.size(); ++i)
+        for (unsigned i = 0; i < context.numParticles_; ++i)
         {
             if (time[i] >= lifetime[i])
             {
-                context.layer_->MarkForDeletion(i);
+                context.layer_->MarkForDeletion(context.firstParticle_ + i);
             }
         }
     }
@@ -51,7 +51,7 @@ namespace
     {
         void operator()(const UpdateContext& context, const ParticleGraphPin& pin0)
         {
-            const unsigned numParticles = context.indices_.size();
+            const unsigned numParticles = context.numParticles_;
 
             LogSpan<T>(LOG_INFO, numParticles, context.GetSpan<T>(pin0.GetMemoryReference()));
         }
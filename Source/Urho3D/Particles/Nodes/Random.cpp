@@ -42,9 +42,9 @@ struct Generate
     void operator()(const UpdateContext& context, const ParticleGraphPin& pin0, const Variant& min, const Variant& max)
     {
         auto span = context.GetSpan<T>(pin0.GetMemoryReference());
-        for (unsigned i = 0; i < context.indices_.size(); ++i)
+        for (unsigned i = 0; i < context.numParticles_; ++i)
         {
-            span[i] = min.Lerp(max, Urho3D::Random()).Get<T>();
+            span[i] = min.Lerp(max, context.layer_->Random()).Get<T>();
         }
     }
 };
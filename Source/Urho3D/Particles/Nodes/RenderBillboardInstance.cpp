@@ -81,21 +81,8 @@ void RenderBillboardInstance::Prepare(unsigned numParticles)
 {
     auto* renderBillboard = static_cast<RenderBillboard*>(GetGraphNode());
 
-    if (!renderBillboard->GetIsWorldspace())
-    {
-        sceneNode_->SetWorldTransform(GetNode()->GetWorldTransform());
-    }
-    unsigned numBillboards = billboardSet_->GetNumBillboards();
-    //if (numBillboards < numParticles)
-    {
-        billboardSet_->SetNumBillboards(numParticles);
-        numBillboards = numParticles;
-    }
-    auto& billboards = billboardSet_->GetBillboards();
-    for (unsigned i = numParticles; i < numBillboards; ++i)
-    {
-        billboards[i].enabled_ = false;
-    }
+    billboards_.resize(numParticles);
+    commitPending_ = true;
     cols_ = Max(1, renderBillboard->GetColumns());
     rows_ = Max(1, renderBillboard->GetRows());
     auto crop = renderBillboard->GetCrop();
@@ -107,8 +94,9 @@ void RenderBillboardInstance::Prepare(unsigned numParticles)
 void RenderBillboardInstance::UpdateParticle(
     unsigned index, const Vector3& pos, const Vector2& size, float frameIndex, Color& color, float rotation, Vector3& direction)
 {
-    auto* billboard = billboardSet_->GetBillboard(index);
+    Billboard* billboard = &billboards_[index];
     billboard->enabled_ = true;
+    billboard->screenScaleFactor_ = 1.0f;
     billboard->position_ = pos;
     billboard->size_ = size * cropSize_;
     billboard->color_ = color;
@@ -122,7 +110,22 @@ void RenderBillboardInstance::UpdateParticle(
     billboard->uv_ = Rect(uvMin, uvMax);
 }
 
-void RenderBillboardInstance::Commit() { billboardSet_->Commit(); }
+void RenderBillboardInstance::CommitDrawables()
+{
+    if (!commitPending_)
+        return;
+    commitPending_ = false;
+
+    auto* renderBillboard = static_cast<RenderBillboard*>(GetGraphNode());
+    if (!renderBillboard->GetIsWorldspace())
+    {
+        sceneNode_->SetWorldTransform(GetNode()->GetWorldTransform());
+    }
+
+    billboardSet_->SetNumBillboards(billboards_.size());
+    billboardSet_->GetBillboards().swap(billboards_);
+    billboardSet_->Commit();
+}
 
 } // namespace ParticleGraphNodes
 
@@ -41,11 +41,11 @@ public:
     void Init(ParticleGraphNode* node, ParticleGraphLayerInstance* layer) override;
     void OnSceneSet(Scene* scene) override;
     void UpdateDrawableAttributes() override;
+    void CommitDrawables() override;
 
     void Prepare(unsigned numParticles);
     void UpdateParticle(unsigned index, const Vector3& pos, const Vector2& size, float frameIndex, Color& color,
         float rotation, Vector3& direction);
-    void Commit();
 
     void operator()(const UpdateContext& context, unsigned numParticles, const SparseSpan<Vector3>& pin0,
         const SparseSpan<Vector2>& pin1, const SparseSpan<float>& frame, const SparseSpan<Color>& color,
@@ -56,13 +56,16 @@ public:
         {
             UpdateParticle(i, pin0[i], pin1[i], frame[i], color[i], rotation[i], direction[i]);
         }
-        Commit();
     }
 
 protected:
     SharedPtr<Urho3D::Node> sceneNode_;
     SharedPtr<Urho3D::BillboardSet> billboardSet_;
     SharedPtr<Urho3D::Octree> octree_;
+    /// Billboards filled by the update, possibly in worker thread. Swapped into billboard set on commit.
+    ea::vector<Billboard> billboards_;
+    /// Whether there are billboards to commit.
+    bool commitPending_{};
     unsigned cols_{};
     unsigned rows_{};
     Vector2 uvTileSize_;
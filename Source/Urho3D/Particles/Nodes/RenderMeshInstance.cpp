@@ -116,11 +116,21 @@ RenderMeshInstance::~RenderMeshInstance()
 
 ea::vector<Matrix3x4>& RenderMeshInstance::Prepare(unsigned numParticles)
 {
-    drawable_->transforms_.resize(numParticles);
-    sceneNode_->SetWorldTransform(GetNode()->GetWorldTransform());
+    transforms_.resize(numParticles);
+    commitPending_ = true;
     // if (node_->material_ != drawable_->GetMaterial(0))
     //    drawable_->SetMaterial(node_->material_);
-    return drawable_->transforms_;
+    return transforms_;
+}
+
+void RenderMeshInstance::CommitDrawables()
+{
+    if (!commitPending_)
+        return;
+    commitPending_ = false;
+
+    sceneNode_->SetWorldTransform(GetNode()->GetWorldTransform());
+    drawable_->transforms_.swap(transforms_);
 }
 
 } // namespace ParticleGraphNodes
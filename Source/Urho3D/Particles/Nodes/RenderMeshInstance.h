@@ -56,6 +56,7 @@ public:
 
     void OnSceneSet(Scene* scene) override;
     void UpdateDrawableAttributes() override;
+    void CommitDrawables() override;
 
     ~RenderMeshInstance() override;
 
@@ -86,6 +87,10 @@ protected:
     SharedPtr<Urho3D::Node> sceneNode_;
     SharedPtr<RenderMeshDrawable> drawable_{};
     SharedPtr<Urho3D::Octree> octree_;
+    /// Transforms filled by the update, possibly in worker thread. Swapped into drawable on commit.
+    ea::vector<Matrix3x4> transforms_;
+    /// Whether there are transforms to commit.
+    bool commitPending_{};
 };
 
 
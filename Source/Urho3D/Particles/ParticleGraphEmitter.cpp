@@ -28,9 +28,9 @@
 #include "../Resource/ResourceCache.h"
 #include "../Resource/ResourceEvents.h"
 #include "../Scene/Scene.h"
-#include "../Scene/SceneEvents.h"
 #include "ParticleGraphLayer.h"
 #include "ParticleGraphLayerInstance.h"
+#include "ParticleGraphSystem.h"
 
 namespace Urho3D
 {
@@ -39,7 +39,11 @@ ParticleGraphEmitter::ParticleGraphEmitter(Context* context)
 {
 }
 
-ParticleGraphEmitter::~ParticleGraphEmitter() = default;
+ParticleGraphEmitter::~ParticleGraphEmitter()
+{
+    if (auto system = GetSubsystem<ParticleGraphSystem>())
+        system->RemoveEmitter(this);
+}
 
 void ParticleGraphEmitter::RegisterObject(Context* context)
 {
@@ -58,14 +62,7 @@ void ParticleGraphEmitter::OnSetEnabled()
 {
     Component::OnSetEnabled();
 
-    Scene* scene = GetScene();
-    if (scene)
-    {
-        if (IsEnabledEffective())
-            SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(ParticleGraphEmitter, HandleScenePostUpdate));
-        else
-            UnsubscribeFromEvent(scene, E_SCENEPOSTUPDATE);
-    }
+    UpdateSystemRegistration(GetScene());
 }
 
 void ParticleGraphEmitter::Reset()
@@ -195,10 +192,7 @@ ResourceRef ParticleGraphEmitter::GetEffectAttr() const
 
 void ParticleGraphEmitter::OnSceneSet(Scene* previousScene, Scene* scene)
 {
-    if (scene && IsEnabledEffective())
-        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(ParticleGraphEmitter, HandleScenePostUpdate));
-    else if (!scene)
-        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+    UpdateSystemRegistration(scene);
 
     for (unsigned i = 0; i < layers_.size(); ++i)
     {
@@ -217,10 +211,24 @@ bool ParticleGraphEmitter::EmitNewParticle(unsigned layer)
 }
 
 void ParticleGraphEmitter::Tick(float timeStep)
+{
+    UpdateParticles(timeStep);
+    CommitDrawables();
+}
+
+void ParticleGraphEmitter::UpdateParticles(float timeStep, WorkQueue* workQueue)
 {
     for (unsigned i = 0; i < layers_.size(); ++i)
     {
-        layers_[i].Update(timeStep, emitting_);
+        layers_[i].Update(timeStep, emitting_, workQueue);
+    }
+}
+
+void ParticleGraphEmitter::CommitDrawables()
+{
+    for (auto& layer : layers_)
+    {
+        layer.CommitDrawables();
     }
 }
 
@@ -249,45 +257,24 @@ bool ParticleGraphEmitter::CheckActiveParticles() const
     return false;
 }
 
-void ParticleGraphEmitter::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+unsigned ParticleGraphEmitter::GetMaxLayerParticles() const
 {
-    // Store scene's timestep and use it instead of global timestep, as time scale may be other than 1
-    using namespace ScenePostUpdate;
-
-    lastTimeStep_ = eventData[P_TIMESTEP].GetFloat();
-
-
-    Tick(lastTimeStep_);
-
-    //// If no invisible update, check that the billboardset is in view (framenumber has changed)
-    //if ((effect_ && effect_->GetUpdateInvisible()) || viewFrameNumber_ != lastUpdateFrameNumber_)
-    //{
-    //    lastUpdateFrameNumber_ = viewFrameNumber_;
-    //    needUpdate_ = true;
-    //    MarkForUpdate();
-    //}
-
-    //// Send finished event only once all particles are gone
-    //if (node_ && !emitting_ && sendFinishedEvent_ && !CheckActiveParticles())
-    //{
-    //    sendFinishedEvent_ = false;
-
-    //    // Make a weak pointer to self to check for destruction during event handling
-    //    WeakPtr<ParticleGraphEmitter> self(this);
-
-    //    using namespace ParticleEffectFinished;
-
-    //    VariantMap& eventData = GetEventDataMap();
-    //    eventData[P_NODE] = node_;
-    //    eventData[P_EFFECT] = effect_;
-
-    //    node_->SendEvent(E_PARTICLEEFFECTFINISHED, eventData);
+    unsigned maxParticles = 0;
+    for (const ParticleGraphLayerInstance& layer : layers_)
+        maxParticles = ea::max(maxParticles, layer.GetNumActiveParticles());
+    return maxParticles;
+}
 
-    //    if (self.Expired())
-    //        return;
+void ParticleGraphEmitter::UpdateSystemRegistration(Scene* scene)
+{
+    auto system = GetSubsystem<ParticleGraphSystem>();
+    if (!system)
+        return;
 
-    //    DoAutoRemove(autoRemove_);
-    //}
+    if (scene && IsEnabledEffective())
+        system->AddEmitter(this);
+    else
+        system->RemoveEmitter(this);
 }
 
 void ParticleGraphEmitter::HandleEffectReloadFinished(StringHash eventType, VariantMap& eventData)
@@ -33,11 +33,13 @@ namespace Urho3D
 
 class ParticleGraphLayerInstance;
 class ParticleGraphNodeInstance;
+class WorkQueue;
 
 /// %Particle graph emitter component.
 class URHO3D_API ParticleGraphEmitter : public Component
 {
     URHO3D_OBJECT(ParticleGraphEmitter, Component)
+    friend class ParticleGraphSystem;
 
 public:
     /// Construct.
@@ -98,8 +100,13 @@ public:
     /// Create a new particle. Return true if there was room.
     bool EmitNewParticle(unsigned layer);
 
-    /// Manually update emitter.
+    /// Manually update emitter and apply results to drawables. Should be called from the main thread.
     void Tick(float timeStep);
+    /// Update particles without applying results to drawables. If work queue is provided, large layers are updated
+    /// using multiple threads. May be called from worker thread. Call CommitDrawables from the main thread afterwards.
+    void UpdateParticles(float timeStep, WorkQueue* workQueue = nullptr);
+    /// Apply results of the last update to drawables.
+    void CommitDrawables();
 
     /// Get layer by index.
     const ParticleGraphLayerInstance* GetLayer(unsigned layer) const;
@@ -109,14 +116,16 @@ public:
 
     /// Return whether has active particles.
     bool CheckActiveParticles() const;
+    /// Return the largest number of active particles in a layer.
+    unsigned GetMaxLayerParticles() const;
 
 protected:
     /// Handle scene being assigned.
     void OnSceneSet(Scene* previousScene, Scene* scene) override;
 
 private:
-    /// Handle scene post-update event.
-    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+    /// Register or unregister the emitter in particle graph system depending on the state.
+    void UpdateSystemRegistration(Scene* scene);
     /// Handle live reload of the particle effect.
     void HandleEffectReloadFinished(StringHash eventType, VariantMap& eventData);
     /// Update all drawable attributes.
@@ -136,11 +145,10 @@ private:
     /// Zone mask.
     unsigned zoneMask_{DEFAULT_ZONEMASK};
 
-    /// Last scene timestep.
-    float lastTimeStep_{};
-
     /// Currently emitting flag.
     bool emitting_{true};
+    /// Index in the emitters of ParticleGraphSystem, M_MAX_UNSIGNED if not registered.
+    unsigned systemIndex_{M_MAX_UNSIGNED};
 };
 
 }
@@ -30,6 +30,8 @@
 #include "ParticleGraphNode.h"
 #include "ParticleGraphPin.h"
 
+#include <EASTL/sort.h>
+
 namespace Urho3D
 {
 
@@ -38,10 +40,13 @@ namespace
 
 ParticleGraphSpan Append(ParticleGraphLayer::AttributeBufferLayout* layout, unsigned bytes)
 {
+    // Keep every span aligned so any value type could be placed after it.
+    static constexpr unsigned alignmentMask = alignof(double) - 1;
+
     ParticleGraphSpan span;
     span.offset_ = layout->attributeBufferSize_;
     span.size_ = bytes;
-    layout->attributeBufferSize_ += bytes;
+    layout->attributeBufferSize_ += (bytes + alignmentMask) & ~alignmentMask;
     return span;
 }
 
@@ -50,6 +55,80 @@ template <typename T> ParticleGraphSpan Append(ParticleGraphLayer::AttributeBuff
     return Append(layout, sizeof(T) * count);
 }
 
+/// Return whether all outputs of the node are scalar. Such node doesn't depend on particle values.
+bool HasOnlyScalarOutputs(const ParticleGraphNode& node)
+{
+    bool hasOutputs = false;
+    for (unsigned i = 0; i < node.GetNumPins(); ++i)
+    {
+        const ParticleGraphPin& pin = node.GetPin(i);
+        if (pin.IsInput())
+            continue;
+        if (pin.GetContainerType() != ParticleGraphContainerType::Scalar)
+            return false;
+        hasOutputs = true;
+    }
+    return hasOutputs;
+}
+
+/// Append nodes to the plan, merging them into the last range if possible.
+void AppendNodeRange(ParticleGraphLayer::ExecutionPlan& plan, const ea::vector<unsigned>& nodes, bool chunked)
+{
+    if (nodes.empty())
+        return;
+
+    const auto firstNode = static_cast<unsigned>(plan.nodes_.size());
+    plan.nodes_.insert(plan.nodes_.end(), nodes.begin(), nodes.end());
+    if (!chunked && !plan.ranges_.empty() && !plan.ranges_.back().chunked_)
+        plan.ranges_.back().numNodes_ += nodes.size();
+    else
+        plan.ranges_.push_back(ParticleGraphLayer::NodeRange{firstNode, static_cast<unsigned>(nodes.size()), chunked});
+}
+
+/// Split graph into ranges of nodes. Chains of element-wise nodes are grouped into a single chunked range.
+/// Element-wise nodes with only scalar outputs are moved in front of the chain, so chunks of the range
+/// never write to shared values and could be executed in parallel.
+ParticleGraphLayer::ExecutionPlan BuildExecutionPlan(const ParticleGraph& graph, bool allowChunking)
+{
+    ParticleGraphLayer::ExecutionPlan plan;
+    ea::vector<unsigned> scalarNodes;
+    ea::vector<unsigned> chainNodes;
+
+    const unsigned numNodes = graph.GetNumNodes();
+    unsigned index = 0;
+    while (index < numNodes)
+    {
+        scalarNodes.clear();
+        chainNodes.clear();
+        if (allowChunking)
+        {
+            for (; index < numNodes && graph.GetNode(index)->IsElementWise(); ++index)
+            {
+                if (HasOnlyScalarOutputs(*graph.GetNode(index)))
+                    scalarNodes.push_back(index);
+                else
+                    chainNodes.push_back(index);
+            }
+        }
+
+        // Chunked execution of a single node is pointless.
+        if (chainNodes.size() <= 1)
+        {
+            // Keep original order if nothing is chunked.
+            for (unsigned nodeIndex : chainNodes)
+                scalarNodes.push_back(nodeIndex);
+            ea::sort(scalarNodes.begin(), scalarNodes.end());
+            chainNodes.clear();
+        }
+        if (scalarNodes.empty() && chainNodes.empty())
+            scalarNodes.push_back(index++);
+
+        AppendNodeRange(plan, scalarNodes, false);
+        AppendNodeRange(plan, chainNodes, true);
+    }
+    return plan;
+}
+
 } // namespace
 
 struct ParticleGraphAttributeBuilder
@@ -243,6 +322,12 @@ void ParticleGraphLayer::SetDuration(float duration)
     duration_ = ea::max(1e-6f, duration);
 }
 
+void ParticleGraphLayer::SetChunkingEnabled(bool enabled)
+{
+    chunkingEnabled_ = enabled;
+    Invalidate();
+}
+
 ParticleGraph& ParticleGraphLayer::GetEmitGraph() { return *emit_; }
 
 ParticleGraph& ParticleGraphLayer::GetInitGraph() { return *init_; }
@@ -255,6 +340,9 @@ void ParticleGraphLayer::Invalidate()
     memset(&attributeBufferLayout_, 0, sizeof(AttributeBufferLayout));
     tempMemory_.Reset(0);
     attributes_.Reset(0, 0);
+    emitPlan_ = {};
+    initPlan_ = {};
+    updatePlan_ = {};
 }
 
 void ParticleGraphLayer::AttributeBufferLayout::EvaluateLayout(const ParticleGraphLayer& layer)
@@ -283,10 +371,8 @@ void ParticleGraphLayer::AttributeBufferLayout::EvaluateLayout(const ParticleGra
         instanceSize += node->EvaluateInstanceSize();
     }
     nodeInstances_ = Append(this, instanceSize);
-    indices_ = Append<unsigned>(this, layer.capacity_);
-    scalarIndices_ = Append<unsigned>(this, layer.capacity_);
-    naturalIndices_ = Append<unsigned>(this, layer.capacity_);
     destructionQueue_ = Append<unsigned>(this, layer.capacity_);
+    destructionFlags_ = Append<uint8_t>(this, layer.capacity_);
     values_ = Append(this, 0);
 }
 
@@ -319,6 +405,10 @@ bool ParticleGraphLayer::Commit()
     attributeBufferLayout_.attributeBufferSize_ = attributes_.GetRequiredMemory();
     ParticleGraphSpan& values = attributeBufferLayout_.values_;
     values = ParticleGraphSpan(values.offset_, attributeBufferLayout_.attributeBufferSize_ - values.offset_);
+    // Emit graph is executed for a single particle, so there is nothing to gain from chunks.
+    emitPlan_ = BuildExecutionPlan(*emit_, false);
+    initPlan_ = BuildExecutionPlan(*init_, chunkingEnabled_);
+    updatePlan_ = BuildExecutionPlan(*update_, chunkingEnabled_);
     committed_ = true;
     return committed_.value();
 }
@@ -55,14 +55,10 @@ public:
         ParticleGraphSpan updateNodePointers_;
         /// Node instances.
         ParticleGraphSpan nodeInstances_;
-        /// Indices.
-        ParticleGraphSpan indices_;
-        /// Indices.
-        ParticleGraphSpan scalarIndices_;
-        /// Indices.
-        ParticleGraphSpan naturalIndices_;
         /// Indices to destroy.
         ParticleGraphSpan destructionQueue_;
+        /// Per-particle flags of pending destruction.
+        ParticleGraphSpan destructionFlags_;
         /// Particle attribute values.
         ParticleGraphSpan values_;
 
@@ -70,6 +66,26 @@ public:
         void EvaluateLayout(const ParticleGraphLayer& layer);
     };
 
+    /// Range of consecutive graph nodes executed together.
+    struct NodeRange
+    {
+        /// Index of the first node in the execution order.
+        unsigned firstNode_{};
+        /// Number of nodes in the range.
+        unsigned numNodes_{};
+        /// Whether the nodes are executed in chunks. All nodes of the range are run for one chunk of particles
+        /// before moving to the next one, and chunks may be processed in parallel.
+        bool chunked_{};
+    };
+    /// Order of graph node execution split into ranges.
+    struct ExecutionPlan
+    {
+        /// Indices of graph nodes in execution order.
+        ea::vector<unsigned> nodes_;
+        /// Ranges of nodes in execution order.
+        ea::vector<NodeRange> ranges_;
+    };
+
     /// Construct.
     explicit ParticleGraphLayer(Context* context);
     /// Destruct.
@@ -101,6 +117,12 @@ public:
     /// Set effect duration in seconds.
     void SetDuration(float duration);
 
+    /// Is chunked execution of element-wise nodes enabled.
+    bool IsChunkingEnabled() const { return chunkingEnabled_; }
+
+    /// Set whether element-wise nodes are executed in chunks. Disabling it is only useful for profiling.
+    void SetChunkingEnabled(bool enabled);
+
     /// Get emit graph.
     ParticleGraph& GetEmitGraph();
 
@@ -130,6 +152,15 @@ public:
     /// Return size of temp buffer in bytes.
     unsigned GetTempBufferSize() const;
 
+    /// Return execution plan of emit graph.
+    const ExecutionPlan& GetEmitPlan() const { return emitPlan_; }
+
+    /// Return execution plan of initialization graph.
+    const ExecutionPlan& GetInitPlan() const { return initPlan_; }
+
+    /// Return execution plan of update graph.
+    const ExecutionPlan& GetUpdatePlan() const { return updatePlan_; }
+
     /// Serialize from/to archive.
     void SerializeInBlock(Archive& archive) override;
 
@@ -144,6 +175,8 @@ private:
     float duration_{DefaultDuration};
     /// Loop effect.
     bool loop_{};
+    /// Execute element-wise nodes in chunks.
+    bool chunkingEnabled_{true};
     /// Emission graph.
     SharedPtr<ParticleGraph> emit_;
     /// Initialization graph.
@@ -156,6 +189,12 @@ private:
     ParticleGraphAttributeLayout attributes_;
     /// Intermediate memory layout.
     ParticleGraphBufferLayout tempMemory_;
+    /// Execution plan of emit graph.
+    ExecutionPlan emitPlan_;
+    /// Execution plan of initialization graph.
+    ExecutionPlan initPlan_;
+    /// Execution plan of update graph.
+    ExecutionPlan updatePlan_;
 };
 
 } // namespace Urho3D
@@ -24,6 +24,7 @@
 
 #include "ParticleGraphLayerInstance.h"
 
+#include "../Core/WorkQueue.h"
 #include "ParticleGraphNode.h"
 #include "ParticleGraphNodeInstance.h"
 #include "Span.h"
@@ -76,22 +77,19 @@ void ParticleGraphLayerInstance::Apply(const SharedPtr<ParticleGraphLayer>& laye
     updateNodeInstances_ = layout.updateNodePointers_.MakeSpan<ParticleGraphNodeInstance*>(attributes_);
     nodeInstances = InitNodeInstances(nodeInstances, updateNodeInstances_, layer_->GetUpdateGraph());
 
-    // Initialize indices
-    indices_ = layout.indices_.MakeSpan<unsigned>(attributes_);
-    scalarIndices_ = layout.scalarIndices_.MakeSpan<unsigned>(attributes_);
-    naturalIndices_ = layout.naturalIndices_.MakeSpan<unsigned>(attributes_);
-    for (unsigned i = 0; i < indices_.size(); ++i)
-    {
-        indices_[i] = i;
-        scalarIndices_[i] = 0;
-        naturalIndices_[i] = i;
-    }
     destructionQueue_ = layout.destructionQueue_.MakeSpan<unsigned>(attributes_);
+    destructionFlags_ = layout.destructionFlags_.MakeSpan<uint8_t>(attributes_);
+    ea::fill(destructionFlags_.begin(), destructionFlags_.end(), uint8_t{0});
     Reset();
 }
 
 /// Remove all current particles.
-void ParticleGraphLayerInstance::RemoveAllParticles() { activeParticles_ = 0; }
+void ParticleGraphLayerInstance::RemoveAllParticles()
+{
+    activeParticles_ = 0;
+    destructionQueueSize_ = 0;
+    ea::fill(destructionFlags_.begin(), destructionFlags_.end(), uint8_t{0});
+}
 
 bool ParticleGraphLayerInstance::EmitNewParticles(float numParticles)
 {
@@ -103,7 +101,7 @@ bool ParticleGraphLayerInstance::EmitNewParticles(float numParticles)
     unsigned particlesToEmit = static_cast<unsigned>(emitCounterReminder_);
     emitCounterReminder_ -= static_cast<float>(particlesToEmit);
 
-    particlesToEmit = Urho3D::Min(particlesToEmit, indices_.size() - activeParticles_);
+    particlesToEmit = Urho3D::Min(particlesToEmit, layer_->GetCapacity() - activeParticles_);
     if (!particlesToEmit)
         return false;
 
@@ -111,26 +109,27 @@ bool ParticleGraphLayerInstance::EmitNewParticles(float numParticles)
     activeParticles_ += particlesToEmit;
 
     auto autoContext = MakeUpdateContext(0.0f);
-    autoContext.indices_ = autoContext.indices_.subspan(startIndex, particlesToEmit);
-    RunGraph(initNodeInstances_, autoContext);
+    autoContext.firstParticle_ = startIndex;
+    autoContext.numParticles_ = particlesToEmit;
+    RunGraph(initNodeInstances_, layer_->GetInitPlan(), autoContext);
 
     return true;
 }
 
-void ParticleGraphLayerInstance::Update(float timeStep, bool emitting)
+void ParticleGraphLayerInstance::Update(float timeStep, bool emitting, WorkQueue* workQueue)
 {
     timeStep *= layer_->GetTimeScale();
     auto emitContext = MakeUpdateContext(timeStep);
-    if (indices_.empty())
+    if (layer_->GetCapacity() == 0)
         return;
     if (emitting)
     {
-        emitContext.indices_ = indices_.subspan(0, 1);
-        RunGraph(emitNodeInstances_, emitContext);
+        emitContext.numParticles_ = 1;
+        RunGraph(emitNodeInstances_, layer_->GetEmitPlan(), emitContext);
     }
 
     auto updateContext = MakeUpdateContext(timeStep);
-    RunGraph(updateNodeInstances_, updateContext);
+    RunGraph(updateNodeInstances_, layer_->GetUpdatePlan(), updateContext, workQueue);
     DestroyParticles();
     time_ += timeStep;
 }
@@ -142,15 +141,56 @@ unsigned ParticleGraphLayerInstance::GetNumAttributes() const
 
 void ParticleGraphLayerInstance::MarkForDeletion(unsigned particleIndex)
 {
-    if (particleIndex >= activeParticles_)
+    if (particleIndex >= activeParticles_ || destructionFlags_[particleIndex])
         return;
 
-    //TODO: if buffer is full sort and eliminate duplicates.
-    if (destructionQueueSize_ < destructionQueue_.size())
+    destructionFlags_[particleIndex] = 1;
+    destructionQueue_[destructionQueueSize_] = particleIndex;
+    ++destructionQueueSize_;
+}
+
+void ParticleGraphLayerInstance::DestroyParticles()
+{
+    for (unsigned i = 0; i < destructionQueueSize_; ++i)
     {
-        destructionQueue_[destructionQueueSize_] = particleIndex;
-        ++destructionQueueSize_;
+        const unsigned index = destructionQueue_[i];
+        // The slot may be already released when the tail of the particle range was trimmed.
+        if (index >= activeParticles_)
+            continue;
+
+        // Drop dead particles from the tail, down to the current particle at most.
+        while (activeParticles_ > index && destructionFlags_[activeParticles_ - 1])
+        {
+            destructionFlags_[activeParticles_ - 1] = 0;
+            --activeParticles_;
+        }
+        if (index >= activeParticles_)
+            continue;
+
+        // Move the last live particle into the freed slot.
+        --activeParticles_;
+        CopyParticle(activeParticles_, index);
+        destructionFlags_[index] = 0;
     }
+    destructionQueueSize_ = 0;
+}
+
+void ParticleGraphLayerInstance::CopyParticle(unsigned sourceIndex, unsigned destIndex)
+{
+    const ParticleGraphAttributeLayout& layout = layer_->GetAttributeLayout();
+    for (unsigned i = 0; i < layout.GetNumAttributes(); ++i)
+    {
+        const unsigned valueSize = GetVariantTypeSize(layout.GetType(i));
+        uint8_t* values = attributes_.data() + layout.GetSpan(i).offset_;
+        memcpy(values + destIndex * valueSize, values + sourceIndex * valueSize, valueSize);
+    }
+}
+
+int ParticleGraphLayerInstance::Rand()
+{
+    // Same generator as global Rand(), but with own state.
+    randomSeed_ = randomSeed_ * 214013 + 2531011;
+    return (randomSeed_ >> 16u) & 32767u;
 }
 
 /// Get uniform index. Creates new uniform slot on demand.
@@ -176,8 +216,10 @@ void ParticleGraphLayerInstance::Reset()
         node->Reset();
     for (ParticleGraphNodeInstance* node : updateNodeInstances_)
         node->Reset();
-    activeParticles_ = 0;
+    RemoveAllParticles();
     time_ = 0.0f;
+    // Layers may be updated in parallel, so each layer has its own random sequence.
+    randomSeed_ = (static_cast<unsigned>(Urho3D::Rand()) << 16u) | static_cast<unsigned>(Urho3D::Rand());
 }
 
 void ParticleGraphLayerInstance::UpdateDrawables()
@@ -196,6 +238,22 @@ void ParticleGraphLayerInstance::UpdateDrawables()
     }
 }
 
+void ParticleGraphLayerInstance::CommitDrawables()
+{
+    for (ParticleGraphNodeInstance* node : initNodeInstances_)
+    {
+        node->CommitDrawables();
+    }
+    for (ParticleGraphNodeInstance* node : emitNodeInstances_)
+    {
+        node->CommitDrawables();
+    }
+    for (ParticleGraphNodeInstance* node : updateNodeInstances_)
+    {
+        node->CommitDrawables();
+    }
+}
+
 void ParticleGraphLayerInstance::SetEmitter(ParticleGraphEmitter* emitter)
 {
     emitter_ = emitter;
@@ -222,8 +280,7 @@ void ParticleGraphLayerInstance::OnSceneSet(Scene* scene)
 UpdateContext ParticleGraphLayerInstance::MakeUpdateContext(float timeStep)
 {
     UpdateContext context;
-    if (activeParticles_ > 0)
-        context.indices_ = indices_.subspan(0, activeParticles_);
+    context.numParticles_ = activeParticles_;
     context.attributes_ = attributes_;
     context.tempBuffer_ = temp_;
     context.timeStep_ = timeStep;
@@ -232,11 +289,38 @@ UpdateContext ParticleGraphLayerInstance::MakeUpdateContext(float timeStep)
     return context;
 }
 
-void ParticleGraphLayerInstance::RunGraph(ea::span<ParticleGraphNodeInstance*>& nodes, UpdateContext& updateContext)
+void ParticleGraphLayerInstance::RunGraph(ea::span<ParticleGraphNodeInstance*>& nodes,
+    const ParticleGraphLayer::ExecutionPlan& plan, UpdateContext& updateContext, WorkQueue* workQueue)
 {
-    for (ParticleGraphNodeInstance* node : nodes)
+    const unsigned numParticles = updateContext.numParticles_;
+    for (const ParticleGraphLayer::NodeRange& range : plan.ranges_)
     {
-        node->Update(updateContext);
+        const auto rangeNodes = ea::span<const unsigned>(plan.nodes_).subspan(range.firstNode_, range.numNodes_);
+        if (!range.chunked_ || numParticles <= ChunkSize)
+        {
+            for (unsigned nodeIndex : rangeNodes)
+                nodes[nodeIndex]->Update(updateContext);
+            continue;
+        }
+
+        // Run all nodes of the range for one chunk of particles before moving to the next one.
+        // Chunks are independent, so the result doesn't depend on the number of threads.
+        const auto runChunks = [&](unsigned beginParticle, unsigned endParticle)
+        {
+            UpdateContext chunkContext = updateContext;
+            for (unsigned firstParticle = beginParticle; firstParticle < endParticle; firstParticle += ChunkSize)
+            {
+                chunkContext.firstParticle_ = updateContext.firstParticle_ + firstParticle;
+                chunkContext.numParticles_ = ea::min(ChunkSize, endParticle - firstParticle);
+                for (unsigned nodeIndex : rangeNodes)
+                    nodes[nodeIndex]->Update(chunkContext);
+            }
+        };
+
+        if (workQueue)
+            ForEachParallel(workQueue, ChunkSize, numParticles, runChunks);
+        else
+            runChunks(0, numParticles);
     }
 }
 
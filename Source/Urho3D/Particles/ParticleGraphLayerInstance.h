@@ -24,15 +24,19 @@
 
 #include "ParticleGraphLayer.h"
 #include "ParticleGraphNodeInstance.h"
-#include <EASTL/sort.h>
 
 namespace Urho3D
 {
 
+class WorkQueue;
+
 /// Instance of particle graph layer in emitter.
 class URHO3D_API ParticleGraphLayerInstance
 {
 public:
+    /// Number of particles processed at once by chunked node ranges.
+    static constexpr unsigned ChunkSize = 256;
+
     /// Construct.
     ParticleGraphLayerInstance();
 
@@ -51,8 +55,8 @@ public:
     /// Create a new particles. Return true if there was room.
     bool EmitNewParticles(float numParticles = 1.0f);
 
-    /// Run update step.
-    void Update(float timeStep, bool emitting);
+    /// Run update step. If work queue is provided, chunks of chunked node ranges are processed in parallel.
+    void Update(float timeStep, bool emitting, WorkQueue* workQueue = nullptr);
 
     /// Get number of attributes.
     unsigned GetNumAttributes() const;
@@ -61,10 +65,9 @@ public:
     template <typename T>
     SparseSpan<T> GetAttributeValues(unsigned attributeIndex);
 
-    template <typename ValueType>
-    SparseSpan<ValueType> GetSparse(unsigned attributeIndex, const ea::span<unsigned>& indices);
+    template <typename ValueType> SparseSpan<ValueType> GetSparse(unsigned attributeIndex, unsigned offset = 0);
     template <typename ValueType> SparseSpan<ValueType> GetScalar(unsigned pinIndex);
-    template <typename ValueType> SparseSpan<ValueType> GetSpan(unsigned pinIndex);
+    template <typename ValueType> SparseSpan<ValueType> GetSpan(unsigned pinIndex, unsigned offset = 0);
 
     /// Get emitter.
     ParticleGraphEmitter* GetEmitter() const { return emitter_; }
@@ -85,9 +88,27 @@ public:
     /// Update all drawable attributes. Executed by ParticleGraphEmitter.
     void UpdateDrawables();
 
+    /// Apply results of the last update to drawables. Executed by ParticleGraphEmitter in the main thread.
+    void CommitDrawables();
+
     /// Get effect layer.
     ParticleGraphLayer* GetLayer() const { return layer_; }
 
+    /// Set seed of the layer random number generator.
+    void SetRandomSeed(unsigned seed) { randomSeed_ = seed; }
+    /// Return seed of the layer random number generator.
+    unsigned GetRandomSeed() const { return randomSeed_; }
+    /// Return a random integer between 0 and 32767. Unlike global Rand(), doesn't depend on other layers.
+    int Rand();
+    /// Return a random float between 0.0 (inclusive) and 1.0 (exclusive).
+    float Random() { return Rand() / 32768.0f; }
+    /// Return a random float between 0.0 and range, inclusive from both ends.
+    float Random(float range) { return Rand() * range / 32767.0f; }
+    /// Return a random float between min and max, inclusive from both ends.
+    float Random(float min, float max) { return Rand() * (max - min) / 32767.0f + min; }
+    /// Return a random integer between 0 and range - 1.
+    int Random(int range) { return static_cast<int>(Random() * range); }
+
 protected:
     /// Handle scene change in instance.
     void OnSceneSet(Scene* scene);
@@ -99,11 +120,16 @@ protected:
     UpdateContext MakeUpdateContext(float timeStep);
 
     /// Run graph.
-    void RunGraph(ea::span<ParticleGraphNodeInstance*>& nodes, UpdateContext& updateContext);
+    void RunGraph(ea::span<ParticleGraphNodeInstance*>& nodes, const ParticleGraphLayer::ExecutionPlan& plan,
+        UpdateContext& updateContext, WorkQueue* workQueue = nullptr);
 
-    /// Destroy particles.
+    /// Destroy particles marked for deletion. Live particles are kept contiguous by moving the last live particle
+    /// into each freed slot.
     void DestroyParticles();
 
+    /// Copy all attribute values of one particle into another particle slot.
+    void CopyParticle(unsigned sourceIndex, unsigned destIndex);
+
     ea::span<uint8_t> InitNodeInstances(ea::span<uint8_t> nodeInstanceBuffer,
         ea::span<ParticleGraphNodeInstance*>& nodeInstances, const ParticleGraph& particle_graph);
 
@@ -121,14 +147,10 @@ private:
     ea::span<ParticleGraphNodeInstance*> initNodeInstances_;
     /// Node instances for update graph
     ea::span<ParticleGraphNodeInstance*> updateNodeInstances_;
-    /// All indices of the particle system.
-    ea::span<unsigned> indices_;
-    /// All indices set to 0.
-    ea::span<unsigned> scalarIndices_;
-    /// All indices going in natural order (0, 1, ...).
-    ea::span<unsigned> naturalIndices_;
     /// Particle indices to be removed.
     ea::span<unsigned> destructionQueue_;
+    /// Whether the particle is marked for deletion.
+    ea::span<uint8_t> destructionFlags_;
     /// Number of particles to destroy at end of the frame.
     unsigned destructionQueueSize_;
     /// Number of active particles.
@@ -139,52 +161,39 @@ private:
     ParticleGraphEmitter* emitter_{};
     /// Time since emitter start.
     float time_{};
+    /// Random number generator state.
+    unsigned randomSeed_{1};
 
     friend class ParticleGraphEmitter;
 };
 
-inline void ParticleGraphLayerInstance::DestroyParticles()
-{
-    if (!destructionQueueSize_)
-        return;
-    auto queue = destructionQueue_.subspan(0, destructionQueueSize_);
-    ea::sort(queue.begin(), queue.end(), ea::greater<unsigned>());
-    //TODO: Eliminate duplicates.
-    for (unsigned index: queue)
-    {
-        ea::swap(indices_[index], indices_[activeParticles_ - 1]);
-        --activeParticles_;
-    }
-    destructionQueueSize_ = 0;
-}
-
 /// Get attribute values.
 template <typename T> inline SparseSpan<T> ParticleGraphLayerInstance::GetAttributeValues(unsigned attributeIndex)
 {
     if (activeParticles_ == 0)
         return {};
-    return GetSparse<T>(attributeIndex, indices_.subspan(0, activeParticles_));
+    return GetSparse<T>(attributeIndex);
 }
 
-template <typename ValueType> SparseSpan<ValueType> ParticleGraphLayerInstance::GetSparse(unsigned attributeIndex, const ea::span<unsigned>& indices)
+template <typename ValueType> SparseSpan<ValueType> ParticleGraphLayerInstance::GetSparse(unsigned attributeIndex, unsigned offset)
 {
     const auto& attr = layer_->GetAttributeLayout().GetSpan(attributeIndex);
     const auto values = attr.MakeSpan<ValueType>(attributes_);
-    return SparseSpan<ValueType>(values, indices);
+    return SparseSpan<ValueType>(values.subspan(offset));
 }
 
 template <typename ValueType> SparseSpan<ValueType> ParticleGraphLayerInstance::GetScalar(unsigned pinIndex)
 {
     const auto& attr = layer_->GetIntermediateValues()[pinIndex];
     const auto values = attr.MakeSpan<ValueType>(temp_);
-    return SparseSpan<ValueType>(values, scalarIndices_);
+    return SparseSpan<ValueType>(values, 0);
 }
 
-template <typename ValueType> SparseSpan<ValueType> ParticleGraphLayerInstance::GetSpan(unsigned pinIndex)
+template <typename ValueType> SparseSpan<ValueType> ParticleGraphLayerInstance::GetSpan(unsigned pinIndex, unsigned offset)
 {
     const auto& attr = layer_->GetIntermediateValues()[pinIndex];
     const auto values = attr.MakeSpan<ValueType>(temp_);
-    return SparseSpan<ValueType>(values, naturalIndices_);
+    return SparseSpan<ValueType>(values.subspan(offset));
 }
 
 } // namespace Urho3D
@@ -84,6 +84,10 @@ public:
     /// Place new instance at the provided address.
     virtual ParticleGraphNodeInstance* CreateInstanceAt(void* ptr, ParticleGraphLayerInstance* layer) = 0;
 
+    /// Return true if the node only reads and writes values of the same particle and has no side effects.
+    /// Consecutive element-wise nodes are executed together in small chunks of particles.
+    virtual bool IsElementWise() const { return false; }
+
     /// Load node.
     virtual bool Load(ParticleGraphReader& reader, GraphNode& node);
     /// Save node.
@@ -40,6 +40,8 @@ public:
     virtual void OnSceneSet(Scene* scene);
     /// Handle drawable attribute change.
     virtual void UpdateDrawableAttributes();
+    /// Apply results of the update to drawables. Called from the main thread after all emitters are updated.
+    virtual void CommitDrawables();
 
     virtual void Reset();
 protected:
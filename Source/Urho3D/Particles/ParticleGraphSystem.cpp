@@ -24,8 +24,14 @@
 
 #include "ParticleGraphSystem.h"
 
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
 #include "ParticleGraphEmitter.h"
 #include "ParticleGraphLayer.h"
+#include "ParticleGraphLayerInstance.h"
+#include "SignedDistanceField.h"
 
 namespace Urho3D
 {
@@ -41,17 +47,98 @@ ParticleGraphSystem::ParticleGraphSystem(Context* context)
     , ObjectReflectionRegistry(context)
 {
     RegisterParticleGraphLibrary(context, this);
+
+    SubscribeToEvent(E_SCENEPOSTUPDATE, URHO3D_HANDLER(ParticleGraphSystem, HandleScenePostUpdate));
 }
 
 ParticleGraphSystem::~ParticleGraphSystem()
 {
 }
 
+void ParticleGraphSystem::AddEmitter(ParticleGraphEmitter* emitter)
+{
+    if (!emitter || emitter->systemIndex_ != M_MAX_UNSIGNED)
+        return;
+
+    emitter->systemIndex_ = emitters_.size();
+    emitters_.push_back(emitter);
+}
+
+void ParticleGraphSystem::RemoveEmitter(ParticleGraphEmitter* emitter)
+{
+    if (!emitter || emitter->systemIndex_ == M_MAX_UNSIGNED)
+        return;
+
+    // Order of emitters doesn't matter, so the last emitter takes place of the removed one
+    const unsigned index = emitter->systemIndex_;
+    emitters_[index] = emitters_.back();
+    emitters_[index]->systemIndex_ = index;
+    emitters_.pop_back();
+    emitter->systemIndex_ = M_MAX_UNSIGNED;
+}
+
+void ParticleGraphSystem::Update(Scene* scene, float timeStep)
+{
+    URHO3D_PROFILE("UpdateParticleGraphEmitters");
+
+    smallEmitters_.clear();
+    largeEmitters_.clear();
+    for (ParticleGraphEmitter* emitter : emitters_)
+    {
+        if (emitter->GetScene() != scene || !emitter->IsEnabledEffective())
+            continue;
+
+        // Update cached world transform in main thread, nodes may read it from worker threads.
+        emitter->GetNode()->GetWorldTransform();
+
+        if (emitter->GetMaxLayerParticles() >= LargeLayerThreshold)
+            largeEmitters_.push_back(emitter);
+        else
+            smallEmitters_.push_back(emitter);
+    }
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (!workQueue->IsMultithreaded())
+    {
+        for (ParticleGraphEmitter* emitter : smallEmitters_)
+            emitter->UpdateParticles(timeStep);
+        for (ParticleGraphEmitter* emitter : largeEmitters_)
+            emitter->UpdateParticles(timeStep);
+    }
+    else
+    {
+        scene->BeginThreadedUpdate();
+        ForEachParallel(workQueue, smallEmitters_,
+            [&](unsigned /*index*/, ParticleGraphEmitter* emitter) { emitter->UpdateParticles(timeStep); });
+        for (ParticleGraphEmitter* emitter : largeEmitters_)
+            emitter->UpdateParticles(timeStep, workQueue);
+        scene->EndThreadedUpdate();
+    }
+
+    // Drawables and scene nodes are not thread-safe, so render nodes apply their results in the main thread
+    for (ParticleGraphEmitter* emitter : smallEmitters_)
+        emitter->CommitDrawables();
+    for (ParticleGraphEmitter* emitter : largeEmitters_)
+        emitter->CommitDrawables();
+}
+
+void ParticleGraphSystem::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    // Use scene's timestep instead of global timestep, as time scale may be other than 1
+    using namespace ScenePostUpdate;
+
+    auto scene = static_cast<Scene*>(eventData[P_SCENE].GetPtr());
+    const float timeStep = eventData[P_TIMESTEP].GetFloat();
+    if (scene)
+        Update(scene, timeStep);
+}
+
 void RegisterParticleGraphLibrary(Context* context, ParticleGraphSystem* system)
 {
     ParticleGraphEffect::RegisterObject(context);
     ParticleGraphLayer::RegisterObject(context);
     ParticleGraphEmitter::RegisterObject(context);
+    SignedDistanceField::RegisterObject(context);
 
     ParticleGraphNodes::RegisterGraphNodes(system);
 }
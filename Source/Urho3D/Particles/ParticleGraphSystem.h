@@ -28,15 +28,44 @@
 
 namespace Urho3D
 {
-/// %Particle graph effect definition.
+
+class ParticleGraphEmitter;
+class Scene;
+
+/// %Particle graph subsystem. Updates all active emitters of a scene using worker threads.
 class URHO3D_API ParticleGraphSystem : public Object, public ObjectReflectionRegistry
 {
     URHO3D_OBJECT(ParticleGraphSystem, Object);
 
 public:
+    /// Emitters with at least this number of particles in a layer are updated one by one,
+    /// with particles of the layer split between threads.
+    static constexpr unsigned LargeLayerThreshold = 4096;
+
     ParticleGraphSystem(Context* context);
 
     ~ParticleGraphSystem() override;
+
+    /// Add emitter to be updated by the system.
+    void AddEmitter(ParticleGraphEmitter* emitter);
+    /// Remove emitter from the system.
+    void RemoveEmitter(ParticleGraphEmitter* emitter);
+    /// Return number of registered emitters.
+    unsigned GetNumEmitters() const { return emitters_.size(); }
+
+    /// Update all active emitters of the scene.
+    void Update(Scene* scene, float timeStep);
+
+private:
+    /// Handle scene post-update event.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+
+    /// Registered emitters.
+    ea::vector<ParticleGraphEmitter*> emitters_;
+    /// Emitters updated in parallel in current frame.
+    ea::vector<ParticleGraphEmitter*> smallEmitters_;
+    /// Emitters with large layers updated in current frame.
+    ea::vector<ParticleGraphEmitter*> largeEmitters_;
 };
 
 
@@ -102,6 +102,8 @@ public:
     /// Place new instance at the provided address.
     ParticleGraphNodeInstance* CreateInstanceAt(void* ptr, ParticleGraphLayerInstance* layer) override;
 
+    bool IsElementWise() const override { return true; }
+
 protected:
     /// Load input pin.
     ParticleGraphPin* LoadInputPin(ParticleGraphReader& reader, GraphInPin& pin) override;
@@ -0,0 +1,403 @@
+//
+// Copyright (c) 2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "SignedDistanceField.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/Model.h"
+#include "../Graphics/ModelView.h"
+#include "../Graphics/StaticModel.h"
+#include "../IO/ArchiveSerialization.h"
+#include "../IO/Log.h"
+#include "../Scene/Scene.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const BinaryMagic SignedDistanceFieldBinaryMagic{{'\0', 'S', 'D', 'F'}};
+
+/// Return closest point on triangle.
+Vector3 ClosestPointOnTriangle(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c)
+{
+    const Vector3 ab = b - a;
+    const Vector3 ac = c - a;
+    const Vector3 ap = p - a;
+    const float d1 = ab.DotProduct(ap);
+    const float d2 = ac.DotProduct(ap);
+    if (d1 <= 0.0f && d2 <= 0.0f)
+        return a;
+
+    const Vector3 bp = p - b;
+    const float d3 = ab.DotProduct(bp);
+    const float d4 = ac.DotProduct(bp);
+    if (d3 >= 0.0f && d4 <= d3)
+        return b;
+
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        return a + ab * (d1 / (d1 - d3));
+
+    const Vector3 cp = p - c;
+    const float d5 = ab.DotProduct(cp);
+    const float d6 = ac.DotProduct(cp);
+    if (d6 >= 0.0f && d5 <= d6)
+        return c;
+
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        return a + ac * (d2 / (d2 - d6));
+
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+    const float denom = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+/// Triangle prepared for distance evaluation.
+struct BakeTriangle
+{
+    Vector3 a_;
+    Vector3 b_;
+    Vector3 c_;
+    Vector3 normal_;
+    BoundingBox bounds_;
+};
+
+/// Evaluate signed distance to the closest triangle. When several triangles share the closest point,
+/// the triangle facing the point the most is used to determine the sign.
+float EvaluateSignedDistance(const Vector3& position, const ea::vector<BakeTriangle>& triangles,
+    const ea::vector<unsigned>& candidates)
+{
+    float bestDistance = M_LARGE_VALUE;
+    float bestAlignment = 0.0f;
+    float bestSign = 1.0f;
+    for (unsigned index : candidates)
+    {
+        const BakeTriangle& triangle = triangles[index];
+        const Vector3 offset = position - ClosestPointOnTriangle(position, triangle.a_, triangle.b_, triangle.c_);
+        const float distance = offset.Length();
+        const float alignment = distance > M_EPSILON ? triangle.normal_.DotProduct(offset) / distance : 1.0f;
+
+        const float tolerance = M_LARGE_EPSILON * Max(1.0f, distance);
+        const bool isCloser = distance < bestDistance - tolerance;
+        const bool isSameDistance = !isCloser && distance <= bestDistance + tolerance;
+        if (isCloser || (isSameDistance && Abs(alignment) > Abs(bestAlignment)))
+        {
+            bestDistance = Min(distance, bestDistance);
+            bestAlignment = alignment;
+            bestSign = alignment < 0.0f ? -1.0f : 1.0f;
+        }
+    }
+    return bestDistance * bestSign;
+}
+
+/// Append triangles of the most detailed LOD of each model geometry. Return false if model cannot be imported.
+bool AppendModelTriangles(
+    Context* context, const Model* model, const Matrix3x4& transform, ea::vector<Vector3>& triangles)
+{
+    ModelView modelView(context);
+    if (!modelView.ImportModel(model))
+        return false;
+
+    for (GeometryView& geometry : modelView.GetGeometries())
+    {
+        if (geometry.lods_.empty() || !geometry.lods_[0].IsTriangleGeometry())
+            continue;
+
+        GeometryLODView& lod = geometry.lods_[0];
+        lod.ForEachTriangle([&](unsigned i0, unsigned i1, unsigned i2)
+        {
+            triangles.push_back(transform * lod.vertices_[i0].GetPosition());
+            triangles.push_back(transform * lod.vertices_[i1].GetPosition());
+            triangles.push_back(transform * lod.vertices_[i2].GetPosition());
+        });
+    }
+    return true;
+}
+
+}
+
+SignedDistanceField::SignedDistanceField(Context* context)
+    : SimpleResource(context)
+{
+}
+
+SignedDistanceField::~SignedDistanceField() = default;
+
+void SignedDistanceField::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<SignedDistanceField>();
+}
+
+void SignedDistanceField::Bake(
+    const ea::vector<Vector3>& triangles, const BoundingBox& bounds, float cellSize, float narrowBand)
+{
+    origin_ = bounds.min_;
+    cellSize_ = Max(cellSize, M_EPSILON);
+    narrowBand_ = Max(narrowBand, cellSize_);
+
+    const float brickExtent = cellSize_ * BrickCells;
+    const Vector3 size = bounds.Size();
+    numBricks_ = VectorMax(VectorCeilToInt(size / brickExtent), IntVector3::ONE);
+
+    const unsigned numBricks = numBricks_.x_ * numBricks_.y_ * numBricks_.z_;
+    brickOffsets_.assign(numBricks, EmptyBrick);
+    brickValues_.assign(numBricks, narrowBand_);
+    samples_.clear();
+
+    ea::vector<BakeTriangle> bakeTriangles;
+    ea::vector<unsigned> allTriangles;
+    for (unsigned i = 0; i + 2 < triangles.size(); i += 3)
+    {
+        BakeTriangle triangle;
+        triangle.a_ = triangles[i];
+        triangle.b_ = triangles[i + 1];
+        triangle.c_ = triangles[i + 2];
+        triangle.normal_ = (triangle.b_ - triangle.a_).CrossProduct(triangle.c_ - triangle.a_).Normalized();
+        triangle.bounds_ = BoundingBox(triangle.a_, triangle.a_);
+        triangle.bounds_.Merge(triangle.b_);
+        triangle.bounds_.Merge(triangle.c_);
+        // Skip degenerate triangles, they have no normal to evaluate the sign.
+        if (triangle.normal_ == Vector3::ZERO)
+            continue;
+        allTriangles.push_back(bakeTriangles.size());
+        bakeTriangles.push_back(triangle);
+    }
+
+    if (bakeTriangles.empty())
+        return;
+
+    ea::vector<unsigned> candidates;
+    for (int z = 0; z < numBricks_.z_; ++z)
+    {
+        for (int y = 0; y < numBricks_.y_; ++y)
+        {
+            for (int x = 0; x < numBricks_.x_; ++x)
+            {
+                const IntVector3 brick{x, y, z};
+                const unsigned brickIndex = GetBrickIndex(brick);
+                const Vector3 brickMin = origin_ + brick.ToVector3() * brickExtent;
+                const BoundingBox brickBounds{brickMin, brickMin + Vector3::ONE * brickExtent};
+
+                // Only triangles within the narrow band could affect stored distance.
+                const BoundingBox searchBounds{
+                    brickBounds.min_ - Vector3::ONE * narrowBand_, brickBounds.max_ + Vector3::ONE * narrowBand_};
+                candidates.clear();
+                for (unsigned i = 0; i < bakeTriangles.size(); ++i)
+                {
+                    if (searchBounds.IsInside(bakeTriangles[i].bounds_) != OUTSIDE)
+                        candidates.push_back(i);
+                }
+
+                if (candidates.empty())
+                {
+                    const float distance = EvaluateSignedDistance(brickBounds.Center(), bakeTriangles, allTriangles);
+                    brickValues_[brickIndex] = distance < 0.0f ? -narrowBand_ : narrowBand_;
+                    continue;
+                }
+
+                brickOffsets_[brickIndex] = samples_.size();
+                samples_.resize(samples_.size() + BrickVolume);
+                float* brickSamples = &samples_[brickOffsets_[brickIndex]];
+                for (unsigned k = 0; k < BrickSize; ++k)
+                {
+                    for (unsigned j = 0; j < BrickSize; ++j)
+                    {
+                        for (unsigned i = 0; i < BrickSize; ++i)
+                        {
+                            const Vector3 position = brickMin + Vector3(i, j, k) * cellSize_;
+                            float distance = EvaluateSignedDistance(position, bakeTriangles, candidates);
+                            // Closest candidate may be not the closest triangle, so sign is unreliable.
+                            if (Abs(distance) >= narrowBand_)
+                                distance = EvaluateSignedDistance(position, bakeTriangles, allTriangles);
+                            *brickSamples++ = Clamp(distance, -narrowBand_, narrowBand_);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool SignedDistanceField::BakeModel(const Model* model, const Matrix3x4& transform, float cellSize, float narrowBand)
+{
+    if (!model)
+        return false;
+
+    ea::vector<Vector3> triangles;
+    if (!AppendModelTriangles(context_, model, transform, triangles))
+    {
+        URHO3D_LOGERROR("Cannot import geometry of model '{}'", model->GetName());
+        return false;
+    }
+
+    if (triangles.empty())
+    {
+        URHO3D_LOGERROR("Model '{}' has no triangle geometry to bake", model->GetName());
+        return false;
+    }
+
+    BoundingBox bounds{triangles.data(), static_cast<unsigned>(triangles.size())};
+    bounds.min_ -= Vector3::ONE * narrowBand;
+    bounds.max_ += Vector3::ONE * narrowBand;
+    Bake(triangles, bounds, cellSize, narrowBand);
+    return true;
+}
+
+bool SignedDistanceField::BakeScene(Scene* scene, float cellSize, float narrowBand)
+{
+    if (!scene)
+        return false;
+
+    ea::vector<Node*> nodes;
+    scene->GetChildrenWithComponent<StaticModel>(nodes, true);
+
+    ea::vector<Vector3> triangles;
+    ea::vector<Component*> components;
+    for (Node* node : nodes)
+    {
+        node->GetComponents(components, StaticModel::GetTypeStatic());
+        for (Component* component : components)
+        {
+            auto staticModel = static_cast<StaticModel*>(component);
+            Model* model = staticModel->GetModel();
+            if (!model || !staticModel->IsEnabledEffective())
+                continue;
+
+            if (!AppendModelTriangles(context_, model, node->GetWorldTransform(), triangles))
+                URHO3D_LOGWARNING("Cannot import geometry of model '{}'", model->GetName());
+        }
+    }
+
+    if (triangles.empty())
+    {
+        URHO3D_LOGERROR("Scene has no static geometry to bake");
+        return false;
+    }
+
+    BoundingBox bounds{triangles.data(), static_cast<unsigned>(triangles.size())};
+    bounds.min_ -= Vector3::ONE * narrowBand;
+    bounds.max_ += Vector3::ONE * narrowBand;
+    Bake(triangles, bounds, cellSize, narrowBand);
+    return true;
+}
+
+float SignedDistanceField::Sample(const Vector3& position) const
+{
+    if (brickOffsets_.empty())
+        return M_LARGE_VALUE;
+
+    // Clamp position to the field and account for distance to the field.
+    const BoundingBox bounds = GetBounds();
+    const Vector3 clampedPosition = VectorClamp(position, bounds.min_, bounds.max_);
+    const float outsideDistance = (position - clampedPosition).Length();
+
+    const Vector3 cellPosition = (clampedPosition - origin_) / cellSize_;
+    const IntVector3 brick = VectorMin(
+        VectorMax(VectorFloorToInt(cellPosition / static_cast<float>(BrickCells)), IntVector3::ZERO),
+        numBricks_ - IntVector3::ONE);
+    const unsigned brickIndex = GetBrickIndex(brick);
+    const unsigned offset = brickOffsets_[brickIndex];
+    if (offset == EmptyBrick)
+        return brickValues_[brickIndex] + outsideDistance;
+
+    const Vector3 localPosition = cellPosition - brick.ToVector3() * static_cast<float>(BrickCells);
+    const IntVector3 cell = VectorMin(VectorMax(VectorFloorToInt(localPosition), IntVector3::ZERO),
+        IntVector3::ONE * static_cast<int>(BrickCells - 1));
+    const Vector3 factor = localPosition - cell.ToVector3();
+
+    const float* samples = &samples_[offset + (cell.z_ * BrickSize + cell.y_) * BrickSize + cell.x_];
+    static constexpr unsigned strideY = BrickSize;
+    static constexpr unsigned strideZ = BrickSize * BrickSize;
+    const float x00 = Lerp(samples[0], samples[1], factor.x_);
+    const float x10 = Lerp(samples[strideY], samples[strideY + 1], factor.x_);
+    const float x01 = Lerp(samples[strideZ], samples[strideZ + 1], factor.x_);
+    const float x11 = Lerp(samples[strideZ + strideY], samples[strideZ + strideY + 1], factor.x_);
+    const float y0 = Lerp(x00, x10, factor.y_);
+    const float y1 = Lerp(x01, x11, factor.y_);
+    return Lerp(y0, y1, factor.z_) + outsideDistance;
+}
+
+Vector3 SignedDistanceField::SampleNormal(const Vector3& position) const
+{
+    const float step = cellSize_ * 0.5f;
+    const Vector3 gradient{
+        Sample(position + Vector3::RIGHT * step) - Sample(position - Vector3::RIGHT * step),
+        Sample(position + Vector3::UP * step) - Sample(position - Vector3::UP * step),
+        Sample(position + Vector3::FORWARD * step) - Sample(position - Vector3::FORWARD * step)};
+    return gradient.Normalized();
+}
+
+BoundingBox SignedDistanceField::GetBounds() const
+{
+    return BoundingBox{origin_, origin_ + numBricks_.ToVector3() * (cellSize_ * BrickCells)};
+}
+
+void SignedDistanceField::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "origin", origin_);
+    SerializeValue(archive, "cellSize", cellSize_);
+    SerializeValue(archive, "narrowBand", narrowBand_);
+    SerializeValue(archive, "numBricks", numBricks_);
+    SerializeVector(archive, "brickOffsets", brickOffsets_);
+    SerializeVector(archive, "brickValues", brickValues_);
+    SerializeVector(archive, "samples", samples_);
+
+    if (archive.IsInput())
+    {
+        if (numBricks_.x_ < 0 || numBricks_.y_ < 0 || numBricks_.z_ < 0)
+            throw ArchiveException("Signed distance field '{}' has negative number of bricks", GetName());
+
+        // Check every step so that the product cannot overflow
+        unsigned long long numBricks = numBricks_.x_;
+        numBricks *= numBricks_.y_;
+        if (numBricks <= M_MAX_UNSIGNED)
+            numBricks *= numBricks_.z_;
+        if (numBricks > M_MAX_UNSIGNED)
+            throw ArchiveException("Signed distance field '{}' has too many bricks", GetName());
+
+        if (brickOffsets_.size() != numBricks || brickValues_.size() != numBricks || samples_.size() % BrickVolume)
+            throw ArchiveException("Signed distance field '{}' has inconsistent brick data", GetName());
+
+        for (const unsigned offset : brickOffsets_)
+        {
+            if (offset != EmptyBrick && static_cast<unsigned long long>(offset) + BrickVolume > samples_.size())
+                throw ArchiveException("Signed distance field '{}' has brick outside of sample data", GetName());
+        }
+    }
+}
+
+BinaryMagic SignedDistanceField::GetBinaryMagic() const
+{
+    return SignedDistanceFieldBinaryMagic;
+}
+
+} // namespace Urho3D
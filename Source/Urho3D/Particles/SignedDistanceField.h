@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2024 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Math/BoundingBox.h"
+#include "../Math/Matrix3x4.h"
+#include "../Resource/Resource.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Model;
+class Scene;
+
+/// Sparse signed distance field stored in bricks. Only bricks close to geometry surface store samples,
+/// all other bricks store a single value. Negative distance is inside geometry.
+class URHO3D_API SignedDistanceField : public SimpleResource
+{
+    URHO3D_OBJECT(SignedDistanceField, SimpleResource);
+
+public:
+    /// Number of samples along each side of a brick. Adjacent bricks duplicate border samples.
+    static constexpr unsigned BrickSize = 8;
+    /// Number of cells along each side of a brick.
+    static constexpr unsigned BrickCells = BrickSize - 1;
+    /// Number of samples in a brick.
+    static constexpr unsigned BrickVolume = BrickSize * BrickSize * BrickSize;
+
+    /// Construct.
+    explicit SignedDistanceField(Context* context);
+    /// Destruct.
+    ~SignedDistanceField() override;
+    /// Register object factory.
+    static void RegisterObject(Context* context);
+
+    /// Bake field from triangle list. Distance is clamped to the narrow band.
+    void Bake(const ea::vector<Vector3>& triangles, const BoundingBox& bounds, float cellSize, float narrowBand);
+    /// Bake field from model geometry, using the most detailed LOD of each geometry.
+    bool BakeModel(const Model* model, const Matrix3x4& transform, float cellSize, float narrowBand);
+    /// Bake field from all static models in the scene.
+    bool BakeScene(Scene* scene, float cellSize, float narrowBand);
+
+    /// Sample signed distance at position. Positions outside of the field are clamped to the field bounds.
+    float Sample(const Vector3& position) const;
+    /// Sample normalized gradient of the distance at position, i.e. direction away from the surface.
+    Vector3 SampleNormal(const Vector3& position) const;
+
+    /// Return bounding box of the field.
+    BoundingBox GetBounds() const;
+    /// Return size of a cell.
+    float GetCellSize() const { return cellSize_; }
+    /// Return width of the narrow band around surface.
+    float GetNarrowBand() const { return narrowBand_; }
+    /// Return number of bricks along each axis.
+    const IntVector3& GetNumBricks() const { return numBricks_; }
+    /// Return number of bricks that store samples.
+    unsigned GetNumAllocatedBricks() const { return samples_.size() / BrickVolume; }
+
+    /// Serialize content from/to archive. May throw ArchiveException.
+    void SerializeInBlock(Archive& archive) override;
+
+protected:
+    /// Binary archive magic word. Should be 4 bytes.
+    BinaryMagic GetBinaryMagic() const override;
+    /// Root block name. Used for XML serialization only.
+    const char* GetRootBlockName() const override { return "signedDistanceField"; }
+    /// Default internal resource format on save.
+    InternalResourceFormat GetDefaultInternalFormat() const override { return InternalResourceFormat::Binary; }
+
+private:
+    /// Index of brick without samples.
+    static constexpr unsigned EmptyBrick = M_MAX_UNSIGNED;
+
+    /// Return linear index of the brick.
+    unsigned GetBrickIndex(const IntVector3& brick) const
+    {
+        return (static_cast<unsigned>(brick.z_) * numBricks_.y_ + brick.y_) * numBricks_.x_ + brick.x_;
+    }
+
+    /// Minimum corner of the field.
+    Vector3 origin_;
+    /// Size of a cell.
+    float cellSize_{};
+    /// Width of the narrow band around surface.
+    float narrowBand_{};
+    /// Number of bricks along each axis.
+    IntVector3 numBricks_;
+    /// Offset of brick samples in samples_ or EmptyBrick.
+    ea::vector<unsigned> brickOffsets_;
+    /// Distance value of bricks without samples.
+    ea::vector<float> brickValues_;
+    /// Samples of allocated bricks.
+    ea::vector<float> samples_;
+};
+
+}
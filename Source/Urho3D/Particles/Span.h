@@ -38,25 +38,27 @@ enum class ParticleGraphContainerType
     Auto
 };
 
+/// View over values of a contiguous range of particles.
+/// Scalar values are shared between all particles and use zero stride.
 template <typename T> struct SparseSpan
 {
     typedef T element_type;
     typedef ea::remove_cv_t<T> value_type;
 
     SparseSpan() = default;
-    SparseSpan(const ea::span<T>& data, const ea::span<unsigned>& indices)
+    SparseSpan(const ea::span<T>& data, unsigned stride = 1)
         : data_(data.data())
-        , indices_(indices.data())
+        , stride_(stride)
     {
     }
-    SparseSpan(T* data, unsigned* indices)
+    SparseSpan(T* data, unsigned stride)
         : data_(data)
-        , indices_(indices)
+        , stride_(stride)
     {
     }
-    inline T& operator[](unsigned index) const { return data_[indices_[index]]; }
-    T* data_;
-    unsigned* indices_;
+    inline T& operator[](unsigned index) const { return data_[index * stride_]; }
+    T* data_{};
+    unsigned stride_{};
 };
 
 template <typename... Values> struct SpanVariantTuple;
@@ -36,7 +36,10 @@ struct UpdateContext
     float timeStep_{};
     /// Time since emitter start.
     float time_{};
-    ea::span<unsigned> indices_;
+    /// Index of the first processed particle.
+    unsigned firstParticle_{};
+    /// Number of processed particles.
+    unsigned numParticles_{};
     ea::span<uint8_t> attributes_;
     ea::span<uint8_t> tempBuffer_;
     ParticleGraphLayerInstance* layer_;
@@ -48,10 +51,10 @@ template <typename ValueType> SparseSpan<ValueType> UpdateContext::GetSpan(const
 {
     switch (pin.type_)
     {
-    case ParticleGraphContainerType::Span: return layer_->GetSpan<ValueType>(pin.index_);
+    case ParticleGraphContainerType::Span: return layer_->GetSpan<ValueType>(pin.index_, firstParticle_);
     case ParticleGraphContainerType::Scalar: return layer_->GetScalar<ValueType>(pin.index_);
-    case ParticleGraphContainerType::Sparse: return layer_->GetSparse<ValueType>(pin.index_, indices_);
-    default: assert(!"Invalid pin container type"); return layer_->GetSparse<ValueType>(pin.index_, indices_);
+    case ParticleGraphContainerType::Sparse: return layer_->GetSparse<ValueType>(pin.index_, firstParticle_);
+    default: assert(!"Invalid pin container type"); return layer_->GetSparse<ValueType>(pin.index_, firstParticle_);
     }
 }
 
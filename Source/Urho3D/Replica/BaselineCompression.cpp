@@ -0,0 +1,113 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Replica/BaselineCompression.h"
+
+#include "Urho3D/Core/Assert.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+unsigned GetMaskSize(unsigned size)
+{
+    return (size + 7) / 8;
+}
+
+} // namespace
+
+void EncodeBaselineDelta(ConstByteSpan baseline, ConstByteSpan value, ByteVector& delta)
+{
+    URHO3D_ASSERT(baseline.size() == value.size());
+
+    const unsigned size = value.size();
+    const unsigned maskSize = GetMaskSize(size);
+
+    delta.clear();
+    delta.resize(maskSize);
+    for (unsigned i = 0; i < size; ++i)
+    {
+        const unsigned char diff = baseline[i] ^ value[i];
+        if (diff != 0)
+        {
+            delta[i / 8] |= 1 << (i % 8);
+            delta.push_back(diff);
+        }
+    }
+}
+
+bool DecodeBaselineDelta(ConstByteSpan baseline, ConstByteSpan delta, ByteVector& value)
+{
+    const unsigned size = baseline.size();
+    const unsigned maskSize = GetMaskSize(size);
+    if (delta.size() < maskSize)
+        return false;
+
+    value.assign(baseline.begin(), baseline.end());
+
+    unsigned nextDiff = maskSize;
+    for (unsigned i = 0; i < size; ++i)
+    {
+        if ((delta[i / 8] & (1 << (i % 8))) == 0)
+            continue;
+
+        if (nextDiff >= delta.size())
+            return false;
+        value[i] ^= delta[nextDiff++];
+    }
+
+    return nextDiff == delta.size();
+}
+
+void NetworkSequenceAcks::Add(unsigned short sequence)
+{
+    if (isEmpty_)
+    {
+        isEmpty_ = false;
+        latest_ = sequence;
+        mask_ = 0;
+        return;
+    }
+
+    const auto offset = static_cast<short>(sequence - latest_);
+    if (offset > 0)
+    {
+        const unsigned shift = offset;
+        mask_ = shift < MaskSize ? (mask_ << shift) : 0;
+        if (shift <= MaskSize)
+            mask_ |= 1u << (shift - 1);
+        latest_ = sequence;
+    }
+    else if (offset < 0 && static_cast<unsigned>(-offset) <= MaskSize)
+    {
+        mask_ |= 1u << (-offset - 1);
+    }
+}
+
+void NetworkBaselineHistory::Add(NetworkFrame frame, ConstByteSpan value)
+{
+    frames_[next_] = frame;
+    values_[next_].assign(value.begin(), value.end());
+
+    next_ = (next_ + 1) % MaxSize;
+    size_ = ea::min(size_ + 1, MaxSize);
+}
+
+const ByteVector* NetworkBaselineHistory::Find(NetworkFrame frame) const
+{
+    for (unsigned i = 0; i < size_; ++i)
+    {
+        if (frames_[i] == frame)
+            return &values_[i];
+    }
+    return nullptr;
+}
+
+} // namespace Urho3D
@@ -0,0 +1,64 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Container/ByteVector.h"
+#include "Urho3D/Replica/NetworkId.h"
+
+#include <EASTL/array.h>
+
+namespace Urho3D
+{
+
+/// Encode update as a delta against baseline of the same size.
+/// Delta is byte-wise XOR bit-packed as a mask of changed bytes followed by changed bytes,
+/// so unchanged bytes of quantized values cost one bit each.
+URHO3D_API void EncodeBaselineDelta(ConstByteSpan baseline, ConstByteSpan value, ByteVector& delta);
+/// Decode update from a delta against baseline. Return false if delta is malformed.
+URHO3D_API bool DecodeBaselineDelta(ConstByteSpan baseline, ConstByteSpan delta, ByteVector& value);
+
+/// Tracks sequence numbers of received messages so they can be acknowledged.
+/// Latest sequence is acknowledged along with a mask of 32 preceding sequences, so single lost ack doesn't matter.
+class URHO3D_API NetworkSequenceAcks
+{
+public:
+    /// Number of preceding sequences acknowledged in the mask.
+    static constexpr unsigned MaskSize = 32;
+
+    /// Mark sequence as received.
+    void Add(unsigned short sequence);
+    /// Return whether any sequence was received.
+    bool IsEmpty() const { return isEmpty_; }
+    /// Return latest received sequence.
+    unsigned short GetLatest() const { return latest_; }
+    /// Return mask of received sequences preceding the latest one, bit i corresponds to sequence `latest - i - 1`.
+    unsigned GetMask() const { return mask_; }
+
+private:
+    bool isEmpty_{true};
+    unsigned short latest_{};
+    unsigned mask_{};
+};
+
+/// Recently received updates of network object on the client, used as baselines for following updates.
+class URHO3D_API NetworkBaselineHistory
+{
+public:
+    /// Max number of updates kept. Server should not use older baselines.
+    static constexpr unsigned MaxSize = 16;
+
+    /// Store received update.
+    void Add(NetworkFrame frame, ConstByteSpan value);
+    /// Return update received for the frame, if any.
+    const ByteVector* Find(NetworkFrame frame) const;
+
+private:
+    ea::array<NetworkFrame, MaxSize> frames_{};
+    ea::array<ByteVector, MaxSize> values_;
+    unsigned size_{};
+    unsigned next_{};
+};
+
+} // namespace Urho3D
@@ -9,6 +9,7 @@
 #include "Urho3D/Core/Context.h"
 #include "Urho3D/Core/CoreEvents.h"
 #include "Urho3D/Core/Exception.h"
+#include "Urho3D/Core/Timer.h"
 #include "Urho3D/IO/Log.h"
 #include "Urho3D/Network/Connection.h"
 #include "Urho3D/Network/MessageUtils.h"
@@ -115,6 +116,8 @@ ClientReplica::ClientReplica(
     : ClientReplicaClock(scene, connection, initialClock, serverSettings)
     , network_(GetSubsystem<Network>())
     , objectRegistry_(scene->GetComponent<ReplicationManager>())
+    , baselineCompression_(GetSetting(NetworkSettings::BaselineCompression).GetBool())
+    , joinSnapshotEnabled_(GetSetting(NetworkSettings::JoinSnapshot).GetBool())
 {
     URHO3D_ASSERT(objectRegistry_);
 
@@ -181,6 +184,12 @@ bool ClientReplica::ProcessMessage(NetworkMessageId messageId, MemoryBuffer& mes
         return true;
     }
 
+    case MSG_JOIN_SNAPSHOT:
+    {
+        ProcessJoinSnapshot(messageData);
+        return true;
+    }
+
     default:
         return false;
     }
@@ -208,6 +217,8 @@ void ClientReplica::ProcessRemoveObjects(MemoryBuffer& messageData)
     while (!messageData.IsEof())
     {
         const auto networkId = static_cast<NetworkId>(messageData.ReadUInt());
+        baselineHistories_.erase(networkId);
+
         WeakPtr<NetworkObject> networkObject{ objectRegistry_->GetNetworkObject(networkId) };
         if (!networkObject)
         {
@@ -229,23 +240,85 @@ void ClientReplica::ProcessAddObjects(MemoryBuffer& messageData)
         const unsigned ownerConnectionId = messageData.ReadVLE();
 
         messageData.ReadBuffer(componentBuffer_.GetBuffer());
+        componentBuffer_.Resize(componentBuffer_.GetBuffer().size());
+        componentBuffer_.Seek(0);
+
+        CreateNetworkObjectFromSnapshot(messageFrame, networkId, componentType, ownerConnectionId, componentBuffer_);
+    }
+}
+
+void ClientReplica::ProcessJoinSnapshot(MemoryBuffer& messageData)
+{
+    if (!joinSnapshotEnabled_)
+    {
+        URHO3D_LOGWARNING("Received unexpected join snapshot");
+        return;
+    }
+
+    // Client is already disconnecting if snapshot is malformed
+    if (joinSnapshotReceiver_.IsMalformed())
+        return;
+
+    if (!joinSnapshotReceiver_.ProcessChunk(messageData))
+    {
+        DisconnectOnMalformedJoinSnapshot();
+        return;
+    }
+
+    hasPendingJoinSnapshotAck_ = true;
+}
 
-        const bool isOwned = ownerConnectionId == GetConnectionId();
-        if (NetworkObject* networkObject = CreateNetworkObject(networkId, componentType))
+void ClientReplica::LoadJoinSnapshot()
+{
+    if (joinSnapshotReceiver_.IsReceived() && !joinSnapshotReceiver_.IsLoaded())
+    {
+        URHO3D_PROFILE("LoadJoinSnapshot");
+
+        // Create at least one object per frame, so loading always progresses
+        const auto timeBudgetUs =
+            static_cast<long long>(GetSetting(NetworkSettings::JoinSnapshotTimeBudget).GetFloat() * 1000000);
+        HiresTimer timer;
+        NetworkJoinSnapshotObject object;
+        do
         {
-            componentBuffer_.Resize(componentBuffer_.GetBuffer().size());
-            componentBuffer_.Seek(0);
-            networkObject->InitializeFromSnapshot(messageFrame, componentBuffer_, isOwned);
+            if (!joinSnapshotReceiver_.ReadObject(object))
+                break;
 
-            if (isOwned)
-            {
-                networkObject->SetNetworkMode(NetworkObjectMode::ClientOwned);
-                ownedObjects_.emplace(WeakPtr<NetworkObject>(networkObject));
-            }
-            else
-                networkObject->SetNetworkMode(NetworkObjectMode::ClientReplicated);
+            MemoryBuffer objectData{object.data_.data(), static_cast<unsigned>(object.data_.size())};
+            CreateNetworkObjectFromSnapshot(joinSnapshotReceiver_.GetFrame(), object.networkId_,
+                object.componentType_, object.ownerConnectionId_, objectData);
+        } while (timer.GetUSec(false) < timeBudgetUs);
+
+        if (joinSnapshotReceiver_.IsMalformed())
+        {
+            DisconnectOnMalformedJoinSnapshot();
+            return;
+        }
+
+        if (joinSnapshotReceiver_.IsLoaded())
+        {
+            URHO3D_LOGINFO("Join snapshot of {} objects is loaded", joinSnapshotReceiver_.GetNumObjects());
+            hasPendingJoinSnapshotAck_ = true;
         }
     }
+
+    // Server sends next chunks and starts replication of other objects on acknowledgement
+    if (hasPendingJoinSnapshotAck_)
+    {
+        VectorBuffer& msg = connection_->GetOutgoingMessageBuffer();
+        msg.Clear();
+        msg.WriteVLE(joinSnapshotReceiver_.GetReceivedSize());
+        msg.WriteBool(joinSnapshotReceiver_.IsLoaded());
+        connection_->SendMessage(MSG_JOIN_SNAPSHOT_ACK, msg, PacketType::ReliableOrdered);
+        hasPendingJoinSnapshotAck_ = false;
+    }
+}
+
+void ClientReplica::DisconnectOnMalformedJoinSnapshot()
+{
+    // Snapshot cannot be loaded anymore, so the server would never start replication for this client
+    URHO3D_LOGERROR("Connection {}: Join snapshot is malformed, disconnecting", connection_->ToString());
+    connection_->Disconnect();
 }
 
 void ClientReplica::ProcessUpdateObjectsReliable(MemoryBuffer& messageData)
@@ -270,6 +343,11 @@ void ClientReplica::ProcessUpdateObjectsReliable(MemoryBuffer& messageData)
 void ClientReplica::ProcessUpdateObjectsUnreliable(MemoryBuffer& messageData)
 {
     const auto messageFrame = static_cast<NetworkFrame>(messageData.ReadInt64());
+    if (baselineCompression_)
+    {
+        ProcessUpdateObjectsUnreliableWithBaselines(messageFrame, messageData);
+        return;
+    }
 
     while (!messageData.IsEof())
     {
@@ -287,6 +365,54 @@ void ClientReplica::ProcessUpdateObjectsUnreliable(MemoryBuffer& messageData)
     }
 }
 
+void ClientReplica::ProcessUpdateObjectsUnreliableWithBaselines(NetworkFrame messageFrame, MemoryBuffer& messageData)
+{
+    const unsigned short sequence = messageData.ReadUShort();
+
+    // Acknowledge the message only if every update can be used as baseline later
+    bool isComplete = true;
+    while (!messageData.IsEof())
+    {
+        const auto networkId = static_cast<NetworkId>(messageData.ReadUInt());
+        const StringHash componentType = messageData.ReadStringHash();
+        const unsigned baselineAge = messageData.ReadVLE();
+
+        messageData.ReadBuffer(componentBuffer_.GetBuffer());
+
+        NetworkObject* networkObject = GetCheckedNetworkObject(networkId, componentType);
+        if (!networkObject)
+        {
+            isComplete = false;
+            continue;
+        }
+
+        NetworkBaselineHistory& history = baselineHistories_[networkId];
+        if (baselineAge != 0)
+        {
+            const ByteVector* baseline = history.Find(messageFrame - baselineAge);
+            if (!baseline || !DecodeBaselineDelta(*baseline, componentBuffer_.GetBuffer(), decodedUpdate_))
+            {
+                URHO3D_LOGDEBUG("Cannot decode update of NetworkObject {} against baseline of frame #{}",
+                    ToString(networkId), static_cast<long long>(messageFrame - baselineAge));
+                isComplete = false;
+                continue;
+            }
+            componentBuffer_.GetBuffer().swap(decodedUpdate_);
+        }
+        history.Add(messageFrame, componentBuffer_.GetBuffer());
+
+        componentBuffer_.Resize(componentBuffer_.GetBuffer().size());
+        componentBuffer_.Seek(0);
+        networkObject->ReadUnreliableDelta(messageFrame, componentBuffer_);
+    }
+
+    if (isComplete)
+    {
+        unreliableUpdatesAcks_.Add(sequence);
+        hasNewUnreliableUpdatesAcks_ = true;
+    }
+}
+
 NetworkObject* ClientReplica::CreateNetworkObject(NetworkId networkId, StringHash componentType)
 {
     auto networkObject = DynamicCast<NetworkObject>(context_->CreateObject(componentType));
@@ -311,6 +437,25 @@ NetworkObject* ClientReplica::CreateNetworkObject(NetworkId networkId, StringHas
     return networkObject;
 }
 
+void ClientReplica::CreateNetworkObjectFromSnapshot(NetworkFrame frame, NetworkId networkId,
+    StringHash componentType, unsigned ownerConnectionId, Deserializer& src)
+{
+    NetworkObject* networkObject = CreateNetworkObject(networkId, componentType);
+    if (!networkObject)
+        return;
+
+    const bool isOwned = ownerConnectionId == GetConnectionId();
+    networkObject->InitializeFromSnapshot(frame, src, isOwned);
+
+    if (isOwned)
+    {
+        networkObject->SetNetworkMode(NetworkObjectMode::ClientOwned);
+        ownedObjects_.emplace(WeakPtr<NetworkObject>(networkObject));
+    }
+    else
+        networkObject->SetNetworkMode(NetworkObjectMode::ClientReplicated);
+}
+
 NetworkObject* ClientReplica::GetCheckedNetworkObject(NetworkId networkId, StringHash componentType)
 {
     NetworkObject* networkObject = objectRegistry_->GetNetworkObject(networkId);
@@ -371,6 +516,9 @@ void ClientReplica::OnInputReady(float timeStep)
     UpdateClientClocks(timeStep, pendingClockUpdates_);
     pendingClockUpdates_.clear();
 
+    if (joinSnapshotEnabled_)
+        LoadJoinSnapshot();
+
     for (NetworkObject* networkObject : objectRegistry_->GetNetworkObjects())
         networkObject->InterpolateState(GetReplicaTimeStep(), GetInputTimeStep(), GetReplicaTime(), GetInputTime());
 
@@ -406,8 +554,18 @@ void ClientReplica::SendObjectsFeedbackUnreliable(NetworkFrame feedbackFrame)
     ea::string* debugInfo = writer.GetDebugInfo();
 
     msg.WriteInt64(static_cast<long long>(feedbackFrame));
+    if (baselineCompression_)
+    {
+        msg.WriteBool(!unreliableUpdatesAcks_.IsEmpty());
+        if (!unreliableUpdatesAcks_.IsEmpty())
+        {
+            msg.WriteUShort(unreliableUpdatesAcks_.GetLatest());
+            msg.WriteUInt(unreliableUpdatesAcks_.GetMask());
+        }
+    }
     writer.CompleteHeader();
 
+    bool hasPayloads = false;
     for (NetworkObject* networkObject : ownedObjects_)
     {
         if (!networkObject)
@@ -429,7 +587,13 @@ void ClientReplica::SendObjectsFeedbackUnreliable(NetworkFrame feedbackFrame)
         }
 
         writer.CompletePayload();
+        hasPayloads = true;
     }
+
+    // Acknowledgements are sent even if there is no feedback
+    if (hasNewUnreliableUpdatesAcks_ && !hasPayloads)
+        connection_->SendMessage(MSG_OBJECTS_FEEDBACK_UNRELIABLE, msg, PacketType::UnreliableUnordered);
+    hasNewUnreliableUpdatesAcks_ = false;
 }
 
 }
@@ -26,12 +26,15 @@
 
 #include "../IO/MemoryBuffer.h"
 #include "../IO/VectorBuffer.h"
+#include "../Replica/BaselineCompression.h"
+#include "../Replica/JoinSnapshot.h"
 #include "../Replica/TickSynchronizer.h"
 #include "../Replica/NetworkId.h"
 #include "../Replica/NetworkTime.h"
 #include "../Replica/ProtocolMessages.h"
 
 #include <EASTL/optional.h>
+#include <EASTL/unordered_map.h>
 #include <EASTL/unordered_set.h>
 #include <EASTL/bonus/ring_buffer.h>
 
@@ -136,6 +139,9 @@ public:
     const ea::unordered_set<WeakPtr<NetworkObject>>& GetOwnedNetworkObjects() const { return ownedObjects_; };
     bool HasOwnedNetworkObjects() const { return !ownedObjects_.empty(); }
     NetworkObject* GetOwnedNetworkObject() const { return ownedObjects_.size() == 1 ? *ownedObjects_.begin() : nullptr; }
+    /// Return whether all objects from join snapshot are created, or join snapshot is disabled.
+    bool IsJoinSnapshotLoaded() const { return !joinSnapshotEnabled_ || joinSnapshotReceiver_.IsLoaded(); }
+    const NetworkJoinSnapshotReceiver& GetJoinSnapshotReceiver() const { return joinSnapshotReceiver_; }
 
 private:
     void OnInputReady(float timeStep);
@@ -143,6 +149,8 @@ private:
     void SendObjectsFeedbackUnreliable(NetworkFrame feedbackFrame);
 
     NetworkObject* CreateNetworkObject(NetworkId networkId, StringHash componentType);
+    void CreateNetworkObjectFromSnapshot(NetworkFrame frame, NetworkId networkId, StringHash componentType,
+        unsigned ownerConnectionId, Deserializer& src);
     NetworkObject* GetCheckedNetworkObject(NetworkId networkId, StringHash componentType);
     void RemoveNetworkObject(WeakPtr<NetworkObject> networkObject);
 
@@ -151,6 +159,10 @@ private:
     void ProcessAddObjects(MemoryBuffer& messageData);
     void ProcessUpdateObjectsReliable(MemoryBuffer& messageData);
     void ProcessUpdateObjectsUnreliable(MemoryBuffer& messageData);
+    void ProcessUpdateObjectsUnreliableWithBaselines(NetworkFrame messageFrame, MemoryBuffer& messageData);
+    void ProcessJoinSnapshot(MemoryBuffer& messageData);
+    void LoadJoinSnapshot();
+    void DisconnectOnMalformedJoinSnapshot();
 
     const WeakPtr<Network> network_;
     const WeakPtr<NetworkObjectRegistry> objectRegistry_;
@@ -158,6 +170,22 @@ private:
     ea::vector<MsgSceneClock> pendingClockUpdates_;
     ea::unordered_set<WeakPtr<NetworkObject>> ownedObjects_;
 
+    /// Baseline compression of unreliable updates.
+    /// @{
+    const bool baselineCompression_{};
+    NetworkSequenceAcks unreliableUpdatesAcks_;
+    bool hasNewUnreliableUpdatesAcks_{};
+    ea::unordered_map<NetworkId, NetworkBaselineHistory> baselineHistories_;
+    ByteVector decodedUpdate_;
+    /// @}
+
+    /// Join snapshot of static objects, loaded over multiple frames.
+    /// @{
+    const bool joinSnapshotEnabled_{};
+    NetworkJoinSnapshotReceiver joinSnapshotReceiver_;
+    bool hasPendingJoinSnapshotAck_{};
+    /// @}
+
     VectorBuffer componentBuffer_;
 };
 
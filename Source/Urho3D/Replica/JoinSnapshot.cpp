@@ -0,0 +1,182 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Replica/JoinSnapshot.h"
+
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/IO/MemoryBuffer.h"
+#include "Urho3D/IO/VectorBuffer.h"
+#include "Urho3D/Network/PacketCompression.h"
+#include "Urho3D/Replica/StaticNetworkObject.h"
+
+#include <EASTL/unordered_set.h>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+NetworkJoinSnapshot::NetworkJoinSnapshot(NetworkFrame frame, ea::span<NetworkObject* const> sortedObjects)
+    : frame_(frame)
+{
+    ea::unordered_set<NetworkId> includedObjects;
+    ea::vector<NetworkObject*> staticObjects;
+    for (NetworkObject* networkObject : sortedObjects)
+    {
+        const NetworkId parentNetworkId = networkObject->GetParentNetworkId();
+        if (!IsStaticObject(networkObject))
+            continue;
+        if (parentNetworkId != NetworkId::None && !includedObjects.contains(parentNetworkId))
+            continue;
+
+        includedObjects.insert(networkObject->GetNetworkId());
+        networkIds_.push_back(networkObject->GetNetworkId());
+        staticObjects.push_back(networkObject);
+    }
+
+    VectorBuffer buffer;
+    VectorBuffer componentBuffer;
+    buffer.WriteVLE(staticObjects.size());
+    for (NetworkObject* networkObject : staticObjects)
+    {
+        buffer.WriteUInt(static_cast<unsigned>(networkObject->GetNetworkId()));
+        buffer.WriteStringHash(networkObject->GetType());
+        buffer.WriteVLE(networkObject->GetOwnerConnectionId());
+
+        componentBuffer.Clear();
+        networkObject->WriteSnapshot(frame_, componentBuffer);
+        buffer.WriteBuffer(componentBuffer.GetBuffer());
+    }
+
+    // Snapshot is built rarely and sent to many clients, so spend more time on compression
+    const ByteVector& uncompressedData = buffer.GetBuffer();
+    uncompressedSize_ = uncompressedData.size();
+    PacketCompressor compressor{{}, PacketCompressor::DefaultCompressionLevel * 2};
+    isCompressed_ = compressor.Compress(uncompressedData, data_);
+    if (!isCompressed_)
+        data_ = uncompressedData;
+}
+
+bool NetworkJoinSnapshot::IsStaticObject(const NetworkObject* networkObject)
+{
+    // Derived types like BehaviorNetworkObject are updated every frame and shouldn't be frozen into snapshot
+    return networkObject->GetType() == StaticNetworkObject::GetTypeStatic();
+}
+
+void NetworkJoinSnapshot::WriteChunk(VectorBuffer& msg, unsigned offset, unsigned size) const
+{
+    URHO3D_ASSERT(offset + size <= data_.size());
+
+    msg.WriteInt64(static_cast<long long>(frame_));
+    msg.WriteVLE(data_.size());
+    msg.WriteVLE(isCompressed_ ? uncompressedSize_ : 0);
+    msg.WriteVLE(offset);
+    msg.Write(data_.data() + offset, size);
+}
+
+bool NetworkJoinSnapshotReceiver::ProcessChunk(MemoryBuffer& messageData)
+{
+    const auto frame = static_cast<NetworkFrame>(messageData.ReadInt64());
+    const unsigned totalSize = messageData.ReadVLE();
+    const unsigned uncompressedSize = messageData.ReadVLE();
+    const unsigned offset = messageData.ReadVLE();
+    const unsigned size = messageData.GetSize() - messageData.GetPosition();
+
+    if (isMalformed_)
+        return false;
+
+    if (isReceived_)
+    {
+        URHO3D_LOGWARNING("Join snapshot is already received");
+        return MarkMalformed();
+    }
+
+    if (receivedSize_ == 0)
+    {
+        if (totalSize > MaxSnapshotSize || uncompressedSize > MaxSnapshotSize)
+        {
+            URHO3D_LOGWARNING("Join snapshot of size {} ({} uncompressed) exceeds the limit of {}", totalSize,
+                uncompressedSize, MaxSnapshotSize);
+            return MarkMalformed();
+        }
+
+        frame_ = frame;
+        totalSize_ = totalSize;
+        uncompressedSize_ = uncompressedSize;
+        receivedData_.reserve(totalSize_);
+    }
+
+    // Chunks are sent in order via reliable channel
+    if (frame != frame_ || totalSize != totalSize_ || offset != receivedSize_ || offset + size > totalSize_)
+    {
+        URHO3D_LOGWARNING("Join snapshot chunk at offset {} is unexpected", offset);
+        return MarkMalformed();
+    }
+
+    const unsigned char* data = messageData.GetData() + messageData.GetPosition();
+    receivedData_.insert(receivedData_.end(), data, data + size);
+    receivedSize_ += size;
+
+    if (receivedSize_ == totalSize_)
+        return Decode();
+    return true;
+}
+
+bool NetworkJoinSnapshotReceiver::Decode()
+{
+    if (uncompressedSize_ != 0)
+    {
+        PacketCompressor compressor;
+        if (!compressor.Decompress(receivedData_, uncompressedSize_, data_))
+        {
+            URHO3D_LOGWARNING("Cannot decompress join snapshot");
+            return MarkMalformed();
+        }
+    }
+    else
+        data_ = ea::move(receivedData_);
+
+    receivedData_ = {};
+
+    MemoryBuffer buffer{data_};
+    numObjects_ = buffer.ReadVLE();
+    readOffset_ = buffer.GetPosition();
+    isReceived_ = true;
+    return true;
+}
+
+bool NetworkJoinSnapshotReceiver::ReadObject(NetworkJoinSnapshotObject& object)
+{
+    if (!isReceived_ || isMalformed_ || numObjectsRead_ >= numObjects_)
+        return false;
+
+    MemoryBuffer buffer{data_};
+    buffer.Seek(readOffset_);
+
+    object.networkId_ = static_cast<NetworkId>(buffer.ReadUInt());
+    object.componentType_ = buffer.ReadStringHash();
+    object.ownerConnectionId_ = buffer.ReadVLE();
+
+    const unsigned size = buffer.ReadVLE();
+    if (buffer.GetPosition() + size > buffer.GetSize())
+    {
+        URHO3D_LOGWARNING("Join snapshot is malformed");
+        return MarkMalformed();
+    }
+
+    object.data_ = ConstByteSpan{data_.data() + buffer.GetPosition(), size};
+    readOffset_ = buffer.GetPosition() + size;
+    ++numObjectsRead_;
+    return true;
+}
+
+bool NetworkJoinSnapshotReceiver::MarkMalformed()
+{
+    isMalformed_ = true;
+    return false;
+}
+
+} // namespace Urho3D
@@ -0,0 +1,105 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Urho3D.h"
+
+#include "Urho3D/Container/ByteVector.h"
+#include "Urho3D/Math/StringHash.h"
+#include "Urho3D/Replica/NetworkId.h"
+
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class MemoryBuffer;
+class NetworkObject;
+class VectorBuffer;
+
+/// Snapshot of single object in the join snapshot, same as in MSG_ADD_OBJECTS.
+struct NetworkJoinSnapshotObject
+{
+    NetworkId networkId_{};
+    StringHash componentType_;
+    unsigned ownerConnectionId_{};
+    ConstByteSpan data_;
+};
+
+/// Compressed snapshot of all StaticNetworkObject-s that is sent to joining clients
+/// instead of creating each object individually.
+/// Snapshot is immutable once built, so the same buffer is shared by all clients joining while it's fresh.
+class URHO3D_API NetworkJoinSnapshot
+{
+public:
+    /// Build snapshot from objects sorted so that parents go before children.
+    /// Only static objects with static parents, if any, are included.
+    NetworkJoinSnapshot(NetworkFrame frame, ea::span<NetworkObject* const> sortedObjects);
+
+    /// Return whether the object may be included into join snapshot.
+    static bool IsStaticObject(const NetworkObject* networkObject);
+
+    /// Write chunk of the data starting from offset to the message.
+    void WriteChunk(VectorBuffer& msg, unsigned offset, unsigned size) const;
+
+    NetworkFrame GetFrame() const { return frame_; }
+    const ea::vector<NetworkId>& GetNetworkIds() const { return networkIds_; }
+    unsigned GetSize() const { return data_.size(); }
+    unsigned GetUncompressedSize() const { return uncompressedSize_; }
+    bool IsCompressed() const { return isCompressed_; }
+
+private:
+    NetworkFrame frame_{};
+    ea::vector<NetworkId> networkIds_;
+    ByteVector data_;
+    unsigned uncompressedSize_{};
+    bool isCompressed_{};
+};
+
+/// Assembles join snapshot from chunks on the client and reads objects one by one,
+/// so they can be created in batches over multiple frames.
+class URHO3D_API NetworkJoinSnapshotReceiver
+{
+public:
+    /// Max size of received snapshot data, both compressed and uncompressed.
+    /// Sizes are received from the network and should be validated before allocation.
+    static constexpr unsigned MaxSnapshotSize = 64 * 1024 * 1024;
+
+    /// Process chunk received from server. Return false if chunk is malformed.
+    bool ProcessChunk(MemoryBuffer& messageData);
+    /// Read next object. Return false if there are no more objects or the data is malformed.
+    bool ReadObject(NetworkJoinSnapshotObject& object);
+
+    /// Return current state.
+    /// @{
+    NetworkFrame GetFrame() const { return frame_; }
+    unsigned GetReceivedSize() const { return receivedSize_; }
+    bool IsReceived() const { return isReceived_; }
+    bool IsLoaded() const { return isReceived_ && numObjectsRead_ == numObjects_; }
+    bool IsMalformed() const { return isMalformed_; }
+    unsigned GetNumObjects() const { return numObjects_; }
+    unsigned GetNumObjectsRead() const { return numObjectsRead_; }
+    /// @}
+
+private:
+    bool Decode();
+    bool MarkMalformed();
+
+    NetworkFrame frame_{};
+    unsigned totalSize_{};
+    unsigned uncompressedSize_{};
+    unsigned receivedSize_{};
+    ByteVector receivedData_;
+
+    bool isReceived_{};
+    ByteVector data_;
+    unsigned readOffset_{};
+    unsigned numObjects_{};
+    unsigned numObjectsRead_{};
+    bool isMalformed_{};
+};
+
+} // namespace Urho3D
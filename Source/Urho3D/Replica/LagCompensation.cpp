@@ -0,0 +1,461 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Replica/LagCompensation.h"
+
+#include "Urho3D/Core/WorkQueue.h"
+#include "Urho3D/Graphics/AnimatedModel.h"
+#include "Urho3D/Graphics/Drawable.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/Replica/NetworkObject.h"
+#include "Urho3D/Replica/TrackedAnimatedModel.h"
+#include "Urho3D/Scene/Node.h"
+
+#include <EASTL/sort.h>
+
+#include <atomic>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Max number of hitboxes in leaf node of bounding volume hierarchy.
+constexpr unsigned MaxLeafSize = 4;
+/// Max depth of bounding volume hierarchy. Median split guarantees logarithmic depth.
+constexpr unsigned MaxTreeDepth = 64;
+
+struct BvhNode
+{
+    BoundingBox box_;
+    unsigned start_{};
+    /// Number of hitboxes for leaf node, zero for inner node.
+    unsigned count_{};
+    /// Index of the second child for inner node. The first child immediately follows the node.
+    unsigned secondChild_{};
+};
+
+bool IsHitboxLess(const LagCompensationHitbox& lhs, NetworkId networkId, unsigned boneIndex)
+{
+    if (lhs.networkId_ != networkId)
+        return static_cast<unsigned>(lhs.networkId_) < static_cast<unsigned>(networkId);
+    return lhs.boneIndex_ < boneIndex;
+}
+
+const LagCompensationHitbox* FindHitbox(
+    const ea::vector<LagCompensationHitbox>& hitboxes, NetworkId networkId, unsigned boneIndex)
+{
+    const auto iter = ea::lower_bound(hitboxes.begin(), hitboxes.end(), networkId,
+        [&](const LagCompensationHitbox& hitbox, NetworkId id) { return IsHitboxLess(hitbox, id, boneIndex); });
+    if (iter == hitboxes.end() || iter->networkId_ != networkId || iter->boneIndex_ != boneIndex)
+        return nullptr;
+    return &*iter;
+}
+
+LagCompensationHitbox InterpolateHitbox(const LagCompensationHitbox& from, const LagCompensationHitbox& to, float factor)
+{
+    LagCompensationHitbox result = to;
+    result.position_ = from.position_.Lerp(to.position_, factor);
+    result.rotation_ = from.rotation_.Slerp(to.rotation_, factor);
+    result.scale_ = from.scale_.Lerp(to.scale_, factor);
+    return result;
+}
+
+/// Return box that contains the hitbox with any rotation and any scale up to maxScale.
+BoundingBox GetRotationInvariantBox(const LagCompensationHitbox& hitbox, float maxScale)
+{
+    const Vector3 halfSize = hitbox.localBox_.HalfSize();
+    const float extent = maxScale * (hitbox.localBox_.Center().Length() + halfSize.Length());
+    return BoundingBox{hitbox.position_ - Vector3::ONE * extent, hitbox.position_ + Vector3::ONE * extent};
+}
+
+float GetMaxScale(const LagCompensationHitbox& hitbox)
+{
+    return ea::max({Abs(hitbox.scale_.x_), Abs(hitbox.scale_.y_), Abs(hitbox.scale_.z_)});
+}
+
+bool HitHitbox(const LagCompensationHitbox& hitbox, const Ray& ray, float maxDistance, LagCompensationHit& hit)
+{
+    const Matrix3x4 transform{hitbox.position_, hitbox.rotation_, hitbox.scale_};
+    const Ray localRay = ray.Transformed(transform.Inverse());
+    const float localDistance = localRay.HitDistance(hitbox.localBox_);
+    if (localDistance == M_INFINITY)
+        return false;
+
+    hit.networkId_ = hitbox.networkId_;
+    hit.boneIndex_ = hitbox.boneIndex_;
+    hit.position_ = transform * (localRay.origin_ + localRay.direction_ * localDistance);
+    hit.distance_ = (hit.position_ - ray.origin_).Length();
+    return hit.distance_ <= maxDistance;
+}
+
+}
+
+struct LagCompensation::FrameData
+{
+    NetworkFrame frame_{};
+    /// Sorted by NetworkId and bone index.
+    ea::vector<LagCompensationHitbox> hitboxes_;
+    /// Boxes that contain hitboxes at any time between the previous and this frame.
+    ea::vector<BoundingBox> sweptBoxes_;
+
+    /// Bounding volume hierarchy, may be built in another thread.
+    /// @{
+    ea::vector<BvhNode> nodes_;
+    ea::vector<unsigned> indices_;
+    std::atomic<bool> isReady_{};
+    /// @}
+
+    void BuildTree()
+    {
+        nodes_.clear();
+        indices_.resize(hitboxes_.size());
+        for (unsigned i = 0; i < indices_.size(); ++i)
+            indices_[i] = i;
+
+        if (!indices_.empty())
+            BuildNode(0, indices_.size());
+    }
+
+    void BuildNode(unsigned start, unsigned end)
+    {
+        const unsigned nodeIndex = nodes_.size();
+        nodes_.emplace_back();
+
+        BoundingBox box;
+        BoundingBox centers;
+        for (unsigned i = start; i < end; ++i)
+        {
+            box.Merge(sweptBoxes_[indices_[i]]);
+            centers.Merge(sweptBoxes_[indices_[i]].Center());
+        }
+        nodes_[nodeIndex].box_ = box;
+        nodes_[nodeIndex].start_ = start;
+
+        if (end - start <= MaxLeafSize)
+        {
+            nodes_[nodeIndex].count_ = end - start;
+            return;
+        }
+
+        // Split by median along the largest axis
+        const Vector3 size = centers.Size();
+        const unsigned axis = size.x_ >= size.y_ && size.x_ >= size.z_ ? 0 : (size.y_ >= size.z_ ? 1 : 2);
+        const unsigned middle = (start + end) / 2;
+        ea::nth_element(indices_.begin() + start, indices_.begin() + middle, indices_.begin() + end,
+            [&](unsigned lhs, unsigned rhs)
+        { return sweptBoxes_[lhs].Center().Data()[axis] < sweptBoxes_[rhs].Center().Data()[axis]; });
+
+        BuildNode(start, middle);
+        nodes_[nodeIndex].secondChild_ = nodes_.size();
+        BuildNode(middle, end);
+    }
+
+    void CollectCandidates(const Ray& ray, float maxDistance, ea::vector<unsigned>& candidates) const
+    {
+        candidates.clear();
+
+        // Use linear search until the tree is built
+        if (!isReady_.load(std::memory_order_acquire))
+        {
+            for (unsigned i = 0; i < sweptBoxes_.size(); ++i)
+            {
+                if (ray.HitDistance(sweptBoxes_[i]) <= maxDistance)
+                    candidates.push_back(i);
+            }
+            return;
+        }
+
+        if (nodes_.empty())
+            return;
+
+        unsigned stack[MaxTreeDepth];
+        unsigned stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0)
+        {
+            const BvhNode& node = nodes_[stack[--stackSize]];
+            if (ray.HitDistance(node.box_) > maxDistance)
+                continue;
+
+            if (node.count_ != 0)
+            {
+                for (unsigned i = node.start_; i < node.start_ + node.count_; ++i)
+                {
+                    if (ray.HitDistance(sweptBoxes_[indices_[i]]) <= maxDistance)
+                        candidates.push_back(indices_[i]);
+                }
+            }
+            else
+            {
+                const unsigned nodeIndex = &node - nodes_.data();
+                URHO3D_ASSERT(stackSize + 2 <= MaxTreeDepth);
+                stack[stackSize++] = node.secondChild_;
+                stack[stackSize++] = nodeIndex + 1;
+            }
+        }
+    }
+};
+
+LagCompensation::LagCompensation(unsigned historyLength, WorkQueue* workQueue)
+    : workQueue_(workQueue)
+    , frames_(ea::max(historyLength, 1u))
+{
+}
+
+LagCompensation::~LagCompensation()
+{
+}
+
+void LagCompensation::RecordObjects(NetworkFrame frame, ReplicationManager::NetworkObjectSpan objects)
+{
+    hitboxesBuffer_.clear();
+    for (NetworkObject* networkObject : objects)
+    {
+        Node* node = networkObject->GetNode();
+        if (!node)
+            continue;
+
+        LagCompensationHitbox hitbox;
+        hitbox.networkId_ = networkObject->GetNetworkId();
+
+        bool hasBones = false;
+        auto animatedModel = node->HasComponent<TrackedAnimatedModel>() ? node->GetComponent<AnimatedModel>() : nullptr;
+        if (animatedModel)
+        {
+            const auto& bones = animatedModel->GetSkeleton().GetBones();
+            for (unsigned boneIndex = 0; boneIndex < bones.size(); ++boneIndex)
+            {
+                const Bone& bone = bones[boneIndex];
+                if (!bone.node_ || !(bone.collisionMask_ & BONECOLLISION_BOX))
+                    continue;
+
+                hitbox.boneIndex_ = boneIndex;
+                hitbox.position_ = bone.node_->GetWorldPosition();
+                hitbox.rotation_ = bone.node_->GetWorldRotation();
+                hitbox.scale_ = bone.node_->GetWorldScale();
+                hitbox.localBox_ = bone.boundingBox_;
+                hitboxesBuffer_.push_back(hitbox);
+                hasBones = true;
+            }
+        }
+
+        if (hasBones)
+            continue;
+
+        if (auto drawable = node->GetDerivedComponent<Drawable>())
+        {
+            hitbox.boneIndex_ = LagCompensationHitbox::NoBone;
+            hitbox.position_ = node->GetWorldPosition();
+            hitbox.rotation_ = node->GetWorldRotation();
+            hitbox.scale_ = node->GetWorldScale();
+            hitbox.localBox_ = drawable->GetBoundingBox();
+            hitboxesBuffer_.push_back(hitbox);
+        }
+    }
+
+    RecordHitboxes(frame, hitboxesBuffer_);
+}
+
+void LagCompensation::RecordHitboxes(NetworkFrame frame, ea::span<const LagCompensationHitbox> hitboxes)
+{
+    if (latestFrame_ && frame <= *latestFrame_)
+    {
+        URHO3D_LOGWARNING("Lag compensation frame #{} is ignored because it's not newer than #{}",
+            static_cast<long long>(frame), static_cast<long long>(*latestFrame_));
+        return;
+    }
+
+    const ea::shared_ptr<FrameData> frameData = AllocateFrame(frame);
+    frameData->hitboxes_.assign(hitboxes.begin(), hitboxes.end());
+    ea::sort(frameData->hitboxes_.begin(), frameData->hitboxes_.end(),
+        [](const LagCompensationHitbox& lhs, const LagCompensationHitbox& rhs)
+    { return IsHitboxLess(lhs, rhs.networkId_, rhs.boneIndex_); });
+
+    FinalizeFrame(frameData);
+    latestFrame_ = frame;
+}
+
+void LagCompensation::Clear()
+{
+    for (auto& frameData : frames_)
+        frameData = nullptr;
+    latestFrame_ = ea::nullopt;
+}
+
+ea::shared_ptr<LagCompensation::FrameData> LagCompensation::AllocateFrame(NetworkFrame frame)
+{
+    const auto numFrames = static_cast<long long>(frames_.size());
+    const auto index = static_cast<unsigned>((static_cast<long long>(frame) % numFrames + numFrames) % numFrames);
+
+    // Reuse memory if the frame is not used by background task
+    ea::shared_ptr<FrameData>& frameData = frames_[index];
+    if (!frameData || frameData.use_count() > 1)
+        frameData = ea::make_shared<FrameData>();
+
+    frameData->frame_ = frame;
+    frameData->isReady_.store(false, std::memory_order_relaxed);
+    return frameData;
+}
+
+void LagCompensation::FinalizeFrame(const ea::shared_ptr<FrameData>& frameData)
+{
+    const FrameData* previousFrameData = FindFrame(frameData->frame_ - 1);
+
+    frameData->sweptBoxes_.resize(frameData->hitboxes_.size());
+    for (unsigned i = 0; i < frameData->hitboxes_.size(); ++i)
+    {
+        const LagCompensationHitbox& hitbox = frameData->hitboxes_[i];
+        const LagCompensationHitbox* previousHitbox =
+            previousFrameData ? FindHitbox(previousFrameData->hitboxes_, hitbox.networkId_, hitbox.boneIndex_) : nullptr;
+
+        const float maxScale = ea::max(GetMaxScale(hitbox), previousHitbox ? GetMaxScale(*previousHitbox) : 0.0f);
+        BoundingBox& sweptBox = frameData->sweptBoxes_[i];
+        sweptBox = GetRotationInvariantBox(hitbox, maxScale);
+        if (previousHitbox)
+            sweptBox.Merge(GetRotationInvariantBox(*previousHitbox, maxScale));
+    }
+
+    // Task keeps frame alive so the slot is not reused until the tree is built
+    const auto buildTree = [frameData]()
+    {
+        frameData->BuildTree();
+        frameData->isReady_.store(true, std::memory_order_release);
+    };
+
+    if (workQueue_)
+        workQueue_->PostTask(buildTree, TaskPriority::High);
+    else
+        buildTree();
+}
+
+const LagCompensation::FrameData* LagCompensation::FindFrame(NetworkFrame frame) const
+{
+    const auto numFrames = static_cast<long long>(frames_.size());
+    const auto index = static_cast<unsigned>((static_cast<long long>(frame) % numFrames + numFrames) % numFrames);
+
+    const FrameData* frameData = frames_[index].get();
+    return frameData && frameData->frame_ == frame ? frameData : nullptr;
+}
+
+ea::optional<NetworkFrame> LagCompensation::GetOldestFrame() const
+{
+    if (!latestFrame_)
+        return ea::nullopt;
+
+    const auto numFrames = static_cast<long long>(frames_.size());
+    for (NetworkFrame frame = *latestFrame_ - (numFrames - 1); frame != *latestFrame_; ++frame)
+    {
+        if (FindFrame(frame))
+            return frame;
+    }
+    return latestFrame_;
+}
+
+bool LagCompensation::IsFrameReady(NetworkFrame frame) const
+{
+    const FrameData* frameData = FindFrame(frame);
+    return frameData && frameData->isReady_.load(std::memory_order_acquire);
+}
+
+bool LagCompensation::FindFrames(
+    const NetworkTime& time, const FrameData*& fromFrameData, const FrameData*& toFrameData, float& factor) const
+{
+    if (!latestFrame_)
+        return false;
+
+    // Clamp time to recorded history
+    NetworkFrame frame = time.Frame();
+    factor = time.Fraction();
+    if (frame >= *latestFrame_)
+    {
+        frame = *latestFrame_;
+        factor = 0.0f;
+    }
+    else if (const auto oldestFrame = GetOldestFrame(); frame < *oldestFrame)
+    {
+        frame = *oldestFrame;
+        factor = 0.0f;
+    }
+
+    fromFrameData = FindFrame(frame);
+    if (!fromFrameData)
+        return false;
+
+    toFrameData = factor > 0.0f ? FindFrame(frame + 1) : nullptr;
+    if (!toFrameData)
+    {
+        toFrameData = fromFrameData;
+        factor = 0.0f;
+    }
+    return true;
+}
+
+void LagCompensation::Raycast(
+    const NetworkTime& time, const Ray& ray, float maxDistance, ea::vector<LagCompensationHit>& results) const
+{
+    results.clear();
+
+    const FrameData* fromFrameData{};
+    const FrameData* toFrameData{};
+    float factor{};
+    if (!FindFrames(time, fromFrameData, toFrameData, factor))
+        return;
+
+    // Swept boxes of the next frame cover hitboxes at any time between frames
+    toFrameData->CollectCandidates(ray, maxDistance, candidatesBuffer_);
+    for (const unsigned index : candidatesBuffer_)
+    {
+        LagCompensationHitbox hitbox = toFrameData->hitboxes_[index];
+        if (toFrameData != fromFrameData)
+        {
+            const LagCompensationHitbox* previousHitbox =
+                FindHitbox(fromFrameData->hitboxes_, hitbox.networkId_, hitbox.boneIndex_);
+            if (previousHitbox)
+                hitbox = InterpolateHitbox(*previousHitbox, hitbox, factor);
+        }
+
+        LagCompensationHit hit;
+        if (HitHitbox(hitbox, ray, maxDistance, hit))
+            results.push_back(hit);
+    }
+
+    ea::sort(results.begin(), results.end(),
+        [](const LagCompensationHit& lhs, const LagCompensationHit& rhs) { return lhs.distance_ < rhs.distance_; });
+}
+
+ea::optional<LagCompensationHit> LagCompensation::RaycastSingle(
+    const NetworkTime& time, const Ray& ray, float maxDistance) const
+{
+    thread_local ea::vector<LagCompensationHit> results;
+    Raycast(time, ray, maxDistance, results);
+    if (results.empty())
+        return ea::nullopt;
+    return results.front();
+}
+
+ea::optional<LagCompensationHitbox> LagCompensation::GetHitbox(
+    const NetworkTime& time, NetworkId networkId, unsigned boneIndex) const
+{
+    const FrameData* fromFrameData{};
+    const FrameData* toFrameData{};
+    float factor{};
+    if (!FindFrames(time, fromFrameData, toFrameData, factor))
+        return ea::nullopt;
+
+    const LagCompensationHitbox* toHitbox = FindHitbox(toFrameData->hitboxes_, networkId, boneIndex);
+    if (!toHitbox)
+        return ea::nullopt;
+
+    const LagCompensationHitbox* fromHitbox =
+        toFrameData != fromFrameData ? FindHitbox(fromFrameData->hitboxes_, networkId, boneIndex) : nullptr;
+    return fromHitbox ? InterpolateHitbox(*fromHitbox, *toHitbox, factor) : *toHitbox;
+}
+
+} // namespace Urho3D
@@ -0,0 +1,109 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Urho3D.h"
+
+#include "Urho3D/Math/BoundingBox.h"
+#include "Urho3D/Math/Quaternion.h"
+#include "Urho3D/Math/Ray.h"
+#include "Urho3D/Replica/NetworkId.h"
+#include "Urho3D/Replica/NetworkTime.h"
+#include "Urho3D/Replica/ReplicationManager.h"
+
+#include <EASTL/optional.h>
+#include <EASTL/shared_ptr.h>
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class WorkQueue;
+
+/// Oriented box attached to network object or to its bone at specific network frame.
+struct LagCompensationHitbox
+{
+    static constexpr unsigned NoBone = M_MAX_UNSIGNED;
+
+    NetworkId networkId_{};
+    /// Index of bone in AnimatedModel skeleton or NoBone if the box covers whole object.
+    unsigned boneIndex_{NoBone};
+
+    /// World transform of the box.
+    /// @{
+    Vector3 position_;
+    Quaternion rotation_;
+    Vector3 scale_{Vector3::ONE};
+    /// @}
+    /// Box in local space of the transform.
+    BoundingBox localBox_;
+};
+
+/// Result of ray query against rewound hitboxes.
+struct LagCompensationHit
+{
+    NetworkId networkId_{};
+    unsigned boneIndex_{LagCompensationHitbox::NoBone};
+    float distance_{};
+    Vector3 position_;
+};
+
+/// History of network object hitboxes used by server to evaluate hits against the world as seen by clients.
+/// Hitboxes are recorded once per network frame into ring buffer of fixed length.
+/// Each frame has bounding volume hierarchy over boxes swept from the previous frame,
+/// it is built in WorkQueue thread if available. Queries never wait for the build and use linear search instead.
+/// Should be used from the main thread.
+class URHO3D_API LagCompensation
+{
+public:
+    /// Construct with history length in frames. WorkQueue is optional.
+    LagCompensation(unsigned historyLength, WorkQueue* workQueue = nullptr);
+    ~LagCompensation();
+
+    /// Record hitboxes of network objects at the end of the network frame.
+    /// Whole object is covered by local bounding box of the first Drawable.
+    /// If object has TrackedAnimatedModel, bones with box collision are recorded instead.
+    void RecordObjects(NetworkFrame frame, ReplicationManager::NetworkObjectSpan objects);
+    /// Record explicitly provided hitboxes. Frames should be recorded in increasing order.
+    void RecordHitboxes(NetworkFrame frame, ea::span<const LagCompensationHitbox> hitboxes);
+    /// Forget all recorded frames.
+    void Clear();
+
+    /// Cast ray against hitboxes rewound to specified time, which is clamped to recorded history.
+    /// Hitboxes are interpolated between frames. Results are sorted by distance.
+    void Raycast(const NetworkTime& time, const Ray& ray, float maxDistance, ea::vector<LagCompensationHit>& results) const;
+    /// Return closest hit of the ray, if any.
+    ea::optional<LagCompensationHit> RaycastSingle(const NetworkTime& time, const Ray& ray, float maxDistance) const;
+    /// Return hitbox rewound to specified time, if it was recorded.
+    ea::optional<LagCompensationHitbox> GetHitbox(
+        const NetworkTime& time, NetworkId networkId, unsigned boneIndex = LagCompensationHitbox::NoBone) const;
+
+    unsigned GetHistoryLength() const { return frames_.size(); }
+    ea::optional<NetworkFrame> GetOldestFrame() const;
+    ea::optional<NetworkFrame> GetLatestFrame() const { return latestFrame_; }
+    /// Return whether bounding volume hierarchy is built for the frame.
+    bool IsFrameReady(NetworkFrame frame) const;
+
+private:
+    struct FrameData;
+
+    const FrameData* FindFrame(NetworkFrame frame) const;
+    /// Find frames surrounding the time clamped to recorded history. Return false if there are no frames.
+    bool FindFrames(
+        const NetworkTime& time, const FrameData*& fromFrameData, const FrameData*& toFrameData, float& factor) const;
+    ea::shared_ptr<FrameData> AllocateFrame(NetworkFrame frame);
+    void FinalizeFrame(const ea::shared_ptr<FrameData>& frameData);
+
+    WorkQueue* workQueue_{};
+
+    ea::vector<ea::shared_ptr<FrameData>> frames_;
+    ea::optional<NetworkFrame> latestFrame_;
+
+    ea::vector<LagCompensationHitbox> hitboxesBuffer_;
+    mutable ea::vector<unsigned> candidatesBuffer_;
+};
+
+} // namespace Urho3D
@@ -0,0 +1,185 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Replica/NetworkInterestGrid.h"
+
+#include "Urho3D/Core/Assert.h"
+
+#include <EASTL/algorithm.h>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+NetworkInterestGrid::NetworkInterestGrid(float cellSize)
+    : cellSize_(cellSize)
+{
+    URHO3D_ASSERT(cellSize_ > 0.0f);
+}
+
+void NetworkInterestGrid::ResetChangedObjects()
+{
+    changedObjects_.clear();
+}
+
+void NetworkInterestGrid::UpdateObject(unsigned index, const Vector3& position)
+{
+    if (index >= isInGrid_.size())
+    {
+        isInGrid_.resize(index + 1);
+        objectCells_.resize(index + 1);
+    }
+
+    const IntVector2 cell = GetCell(position);
+    if (isInGrid_[index])
+    {
+        if (objectCells_[index] == cell)
+            return;
+        RemoveObject(index);
+    }
+
+    isInGrid_[index] = true;
+    objectCells_[index] = cell;
+    cells_[cell].push_back(index);
+    changedObjects_.push_back(index);
+}
+
+void NetworkInterestGrid::RemoveObject(unsigned index)
+{
+    if (!HasObject(index))
+        return;
+
+    const auto iter = cells_.find(objectCells_[index]);
+    URHO3D_ASSERT(iter != cells_.end());
+
+    ea::vector<unsigned>& cellObjects = iter->second;
+    const auto objectIter = ea::find(cellObjects.begin(), cellObjects.end(), index);
+    URHO3D_ASSERT(objectIter != cellObjects.end());
+    *objectIter = cellObjects.back();
+    cellObjects.pop_back();
+
+    if (cellObjects.empty())
+        cells_.erase(iter);
+    isInGrid_[index] = false;
+}
+
+IntVector2 NetworkInterestGrid::GetCell(const Vector3& position) const
+{
+    return {FloorToInt(position.x_ / cellSize_), FloorToInt(position.z_ / cellSize_)};
+}
+
+const ea::vector<unsigned>& NetworkInterestGrid::GetObjectsInCell(const IntVector2& cell) const
+{
+    static const ea::vector<unsigned> emptyCollection;
+    const auto iter = cells_.find(cell);
+    return iter != cells_.end() ? iter->second : emptyCollection;
+}
+
+void NetworkInterestArea::Update(const NetworkInterestGrid& grid, ea::span<const Vector3> centers, float radius)
+{
+    leftObjects_.clear();
+
+    // Re-evaluate objects in the cells that entered or left the area
+    CalculateCells(grid, centers, radius);
+    if (newCells_ != cells_)
+    {
+        changedCells_.clear();
+        ea::set_difference(cells_.begin(), cells_.end(), newCells_.begin(), newCells_.end(),
+            ea::back_inserter(changedCells_));
+        for (const IntVector2& cell : changedCells_)
+        {
+            for (unsigned index : grid.GetObjectsInCell(cell))
+                LeaveObject(index);
+        }
+
+        changedCells_.clear();
+        ea::set_difference(newCells_.begin(), newCells_.end(), cells_.begin(), cells_.end(),
+            ea::back_inserter(changedCells_));
+        for (const IntVector2& cell : changedCells_)
+        {
+            for (unsigned index : grid.GetObjectsInCell(cell))
+                EnterObject(index);
+        }
+
+        ea::swap(cells_, newCells_);
+    }
+
+    // Re-evaluate objects that moved to another cell
+    for (unsigned index : grid.GetChangedObjects())
+    {
+        if (!grid.HasObject(index))
+            continue;
+
+        if (ea::binary_search(cells_.begin(), cells_.end(), grid.GetObjectCell(index)))
+            EnterObject(index);
+        else
+            LeaveObject(index);
+    }
+
+    // Compact the list of objects
+    const auto isRemoved = [&](unsigned index)
+    {
+        if (isInterested_[index])
+            return false;
+        isListed_[index] = false;
+        return true;
+    };
+    objects_.erase(ea::remove_if(objects_.begin(), objects_.end(), isRemoved), objects_.end());
+}
+
+void NetworkInterestArea::RemoveObject(unsigned index)
+{
+    if (index < isInterested_.size())
+        isInterested_[index] = false;
+}
+
+void NetworkInterestArea::CalculateCells(const NetworkInterestGrid& grid, ea::span<const Vector3> centers, float radius)
+{
+    newCells_.clear();
+
+    const Vector3 offset{radius, 0.0f, radius};
+    for (const Vector3& center : centers)
+    {
+        const IntVector2 minCell = grid.GetCell(center - offset);
+        const IntVector2 maxCell = grid.GetCell(center + offset);
+        for (int y = minCell.y_; y <= maxCell.y_; ++y)
+        {
+            for (int x = minCell.x_; x <= maxCell.x_; ++x)
+                newCells_.emplace_back(x, y);
+        }
+    }
+
+    ea::sort(newCells_.begin(), newCells_.end());
+    newCells_.erase(ea::unique(newCells_.begin(), newCells_.end()), newCells_.end());
+}
+
+void NetworkInterestArea::EnterObject(unsigned index)
+{
+    if (index >= isInterested_.size())
+    {
+        isInterested_.resize(index + 1);
+        isListed_.resize(index + 1);
+    }
+
+    isInterested_[index] = true;
+    if (!isListed_[index])
+    {
+        isListed_[index] = true;
+        objects_.push_back(index);
+    }
+}
+
+void NetworkInterestArea::LeaveObject(unsigned index)
+{
+    if (!IsInterested(index))
+        return;
+
+    isInterested_[index] = false;
+    leftObjects_.push_back(index);
+}
+
+} // namespace Urho3D
@@ -0,0 +1,91 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Urho3D.h"
+
+#include "Urho3D/Container/Hash.h"
+#include "Urho3D/Math/Vector2.h"
+#include "Urho3D/Math/Vector3.h"
+
+#include <EASTL/span.h>
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+/// Uniform hash grid of network objects on XZ plane, used by server to find objects in client area of interest.
+/// Objects are identified by NetworkId index. Grid keeps track of objects that changed cell since last reset.
+class URHO3D_API NetworkInterestGrid
+{
+public:
+    explicit NetworkInterestGrid(float cellSize);
+
+    /// Forget objects changed since previous reset.
+    void ResetChangedObjects();
+    /// Add object or update its position.
+    void UpdateObject(unsigned index, const Vector3& position);
+    /// Remove object from the grid.
+    void RemoveObject(unsigned index);
+
+    /// Return cell that contains position.
+    IntVector2 GetCell(const Vector3& position) const;
+    /// Return cell of the object. Object should be in the grid.
+    const IntVector2& GetObjectCell(unsigned index) const { return objectCells_[index]; }
+    /// Return whether the object is in the grid.
+    bool HasObject(unsigned index) const { return index < isInGrid_.size() && isInGrid_[index]; }
+    /// Return objects in the cell.
+    const ea::vector<unsigned>& GetObjectsInCell(const IntVector2& cell) const;
+    /// Return objects that were added or moved to another cell since last reset.
+    const ea::vector<unsigned>& GetChangedObjects() const { return changedObjects_; }
+    float GetCellSize() const { return cellSize_; }
+
+private:
+    const float cellSize_{};
+
+    ea::unordered_map<IntVector2, ea::vector<unsigned>> cells_;
+    ea::vector<IntVector2> objectCells_;
+    ea::vector<bool> isInGrid_;
+    ea::vector<unsigned> changedObjects_;
+};
+
+/// Area of interest of individual client in NetworkInterestGrid.
+/// Area is updated incrementally: only objects in cells that entered or left the area
+/// and objects that changed cell are re-evaluated.
+class URHO3D_API NetworkInterestArea
+{
+public:
+    /// Update area to cover all cells within the radius from any of the centers.
+    void Update(const NetworkInterestGrid& grid, ea::span<const Vector3> centers, float radius);
+    /// Forget removed object.
+    void RemoveObject(unsigned index);
+
+    /// Return whether the object is in the area.
+    bool IsInterested(unsigned index) const { return index < isInterested_.size() && isInterested_[index]; }
+    /// Return objects in the area as of last update.
+    const ea::vector<unsigned>& GetObjects() const { return objects_; }
+    /// Return objects that left the area during last update.
+    /// Object may re-enter the area during the same update, check IsInterested.
+    const ea::vector<unsigned>& GetLeftObjects() const { return leftObjects_; }
+    /// Return sorted cells in the area.
+    const ea::vector<IntVector2>& GetCells() const { return cells_; }
+
+private:
+    void CalculateCells(const NetworkInterestGrid& grid, ea::span<const Vector3> centers, float radius);
+    void EnterObject(unsigned index);
+    void LeaveObject(unsigned index);
+
+    ea::vector<IntVector2> cells_;
+    ea::vector<IntVector2> newCells_;
+    ea::vector<IntVector2> changedCells_;
+
+    ea::vector<bool> isInterested_;
+    ea::vector<bool> isListed_;
+    ea::vector<unsigned> objects_;
+    ea::vector<unsigned> leftObjects_;
+};
+
+} // namespace Urho3D
@@ -72,6 +72,12 @@ public:
 
     /// Server-only: set owner connection which is allowed to send feedback for this object.
     void SetOwner(AbstractConnection* owner);
+    /// Server-only: set whether the object is global.
+    /// Global objects are not culled by interest grid of ReplicationManager, custom filters still apply.
+    void SetGlobal(bool isGlobal) { isGlobal_ = isGlobal; }
+    /// Server-only: set base priority of unreliable updates.
+    /// Used only if bandwidth of client connection is limited, objects with higher priority are sent more often.
+    void SetUpdatePriority(float priority) { updatePriority_ = priority; }
 
     static void RegisterObject(Context* context);
 
@@ -97,6 +103,8 @@ public:
     const ea::vector<WeakPtr<NetworkObject>>& GetChildrenNetworkObjects() const { return childrenNetworkObjects_; }
     AbstractConnection* GetOwnerConnection() const { return ownerConnection_; }
     unsigned GetOwnerConnectionId() const { return ownerConnection_ ? ownerConnection_->GetObjectID() : 0; }
+    bool IsGlobal() const { return isGlobal_; }
+    float GetUpdatePriority() const { return updatePriority_; }
 
     /// Return network mode.
     /// Network mode is configured only *after* InitializeOnServer and InitializeFromSnapshot callbacks.
@@ -130,6 +138,8 @@ private:
     /// ReplicationManager corresponding to the NetworkObject.
     NetworkObjectMode networkMode_{};
     WeakPtr<AbstractConnection> ownerConnection_{};
+    bool isGlobal_{};
+    float updatePriority_{1.0f};
 
     /// NetworkObject hierarchy
     /// @{
@@ -0,0 +1,60 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Replica/NetworkPriorityAccumulator.h"
+
+#include <EASTL/sort.h>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+void NetworkPriorityAccumulator::AddObject(unsigned index, float priority, unsigned size, bool isEligible)
+{
+    if (index >= priorities_.size())
+        priorities_.resize(index + 1);
+
+    priorities_[index] += priority;
+    if (isEligible)
+        candidates_.push_back(Candidate{index, size});
+}
+
+void NetworkPriorityAccumulator::SelectObjects(unsigned budget, ea::vector<unsigned>& selectedObjects)
+{
+    selectedObjects.clear();
+
+    // Order by index on ties to keep selection deterministic
+    const auto isBefore = [&](const Candidate& lhs, const Candidate& rhs)
+    {
+        const float lhsPriority = priorities_[lhs.index_];
+        const float rhsPriority = priorities_[rhs.index_];
+        return lhsPriority != rhsPriority ? lhsPriority > rhsPriority : lhs.index_ < rhs.index_;
+    };
+    ea::sort(candidates_.begin(), candidates_.end(), isBefore);
+
+    // Smaller objects may still fit after larger one is skipped
+    unsigned remainingBudget = budget;
+    for (const Candidate& candidate : candidates_)
+    {
+        if (candidate.size_ > remainingBudget && !selectedObjects.empty())
+            continue;
+
+        remainingBudget -= ea::min(candidate.size_, remainingBudget);
+        priorities_[candidate.index_] = 0.0f;
+        selectedObjects.push_back(candidate.index_);
+    }
+
+    candidates_.clear();
+}
+
+void NetworkPriorityAccumulator::RemoveObject(unsigned index)
+{
+    if (index < priorities_.size())
+        priorities_[index] = 0.0f;
+}
+
+} // namespace Urho3D
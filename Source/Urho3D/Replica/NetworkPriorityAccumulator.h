@@ -0,0 +1,45 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Urho3D.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+/// Schedules updates of network objects within limited byte budget.
+/// Priority of each object grows every frame the object has pending update and is reset when update is sent,
+/// so objects that were not sent for a long time eventually win over objects with higher base priority.
+/// Objects are identified by NetworkId index.
+class URHO3D_API NetworkPriorityAccumulator
+{
+public:
+    /// Accumulate priority of the object that has pending update of given size.
+    /// Object may be selected in current frame only if it is eligible.
+    void AddObject(unsigned index, float priority, unsigned size, bool isEligible = true);
+    /// Select eligible objects with highest accumulated priority that fit into the budget.
+    /// Objects are returned in the order of decreasing priority. Accumulated priority of selected objects is reset.
+    /// At least one object is selected if there are any eligible objects, even if it doesn't fit into the budget.
+    void SelectObjects(unsigned budget, ea::vector<unsigned>& selectedObjects);
+    /// Forget accumulated priority of the object.
+    void RemoveObject(unsigned index);
+
+    /// Return accumulated priority of the object.
+    float GetPriority(unsigned index) const { return index < priorities_.size() ? priorities_[index] : 0.0f; }
+
+private:
+    struct Candidate
+    {
+        unsigned index_{};
+        unsigned size_{};
+    };
+
+    ea::vector<float> priorities_;
+    ea::vector<Candidate> candidates_;
+};
+
+} // namespace Urho3D
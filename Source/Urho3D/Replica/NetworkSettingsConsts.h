@@ -81,6 +81,10 @@ URHO3D_NETWORK_SETTING(InterpolationLimit, float, 0.25f);
 URHO3D_NETWORK_SETTING(MaxInputFrames, unsigned, 256);
 /// Maximum number of input frames sent to server including relevant frame.
 URHO3D_NETWORK_SETTING(MaxInputRedundancy, unsigned, 32);
+/// Whether unreliable updates are encoded as deltas against updates acknowledged by the client.
+URHO3D_NETWORK_SETTING(BaselineCompression, bool, false);
+/// Whether static NetworkObjects are sent to joining clients as single shared snapshot.
+URHO3D_NETWORK_SETTING(JoinSnapshot, bool, false);
 
 /// @}
 
@@ -105,6 +109,10 @@ URHO3D_NETWORK_SETTING(InputBufferingMax, unsigned, 8);
 URHO3D_NETWORK_SETTING(RelevanceTimeout, float, 5.0f);
 /// Duration in seconds of value tracking on server. Used for lag compensation.
 URHO3D_NETWORK_SETTING(ServerTracingDuration, float, 5.0f);
+/// Max age in seconds of join snapshot that is reused for joining clients.
+URHO3D_NETWORK_SETTING(JoinSnapshotInterval, float, 5.0f);
+/// Max size in bytes of join snapshot data sent to client and not acknowledged yet.
+URHO3D_NETWORK_SETTING(JoinSnapshotWindowSize, unsigned, 64 * 1024);
 
 /// @}
 
@@ -125,6 +133,8 @@ URHO3D_NETWORK_SETTING(InterpolationDelay, float, 0.1f);
 URHO3D_NETWORK_SETTING(ClientTracingDuration, float, 3.0f);
 /// Duration in seconds of value extrapolation. Beyond this limit the value stays fixed.
 URHO3D_NETWORK_SETTING(ExtrapolationLimit, float, 0.5f);
+/// Time in seconds spent on creation of objects from join snapshot per frame. At least one object is created.
+URHO3D_NETWORK_SETTING(JoinSnapshotTimeBudget, float, 0.004f);
 
 /// @}
 
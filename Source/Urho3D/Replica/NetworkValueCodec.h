@@ -0,0 +1,142 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/IO/BitStream.h"
+#include "Urho3D/Replica/NetworkValue.h"
+
+namespace Urho3D
+{
+
+/// Bit-packed encoding of values stored in NetworkValue.
+/// Codec parameters should match on the server and the client.
+/// Zero number of bits means that the value is stored as raw floats.
+/// @{
+template <class T> struct NetworkValueBitCodec;
+
+template <>
+struct NetworkValueBitCodec<float>
+{
+    float range_{};
+    unsigned numBits_{};
+
+    void Write(BitWriter& dest, float value) const
+    {
+        if (numBits_ != 0)
+            dest.WriteQuantizedFloat(value, range_, numBits_);
+        else
+            dest.WriteFloat(value);
+    }
+
+    float Read(BitReader& src) const
+    {
+        return numBits_ != 0 ? static_cast<float>(src.ReadQuantizedFloat(range_, numBits_)) : src.ReadFloat();
+    }
+};
+
+template <>
+struct NetworkValueBitCodec<DoubleVector3>
+{
+    double range_{};
+    unsigned numBits_{};
+
+    void Write(BitWriter& dest, const DoubleVector3& value) const
+    {
+        if (numBits_ != 0)
+            dest.WriteQuantizedVector3(value, range_, numBits_);
+        else
+        {
+            dest.WriteFloat(static_cast<float>(value.x_));
+            dest.WriteFloat(static_cast<float>(value.y_));
+            dest.WriteFloat(static_cast<float>(value.z_));
+        }
+    }
+
+    DoubleVector3 Read(BitReader& src) const
+    {
+        if (numBits_ != 0)
+            return src.ReadQuantizedVector3(range_, numBits_);
+
+        DoubleVector3 result;
+        result.x_ = src.ReadFloat();
+        result.y_ = src.ReadFloat();
+        result.z_ = src.ReadFloat();
+        return result;
+    }
+};
+
+template <>
+struct NetworkValueBitCodec<Vector3>
+{
+    float range_{};
+    unsigned numBits_{};
+
+    void Write(BitWriter& dest, const Vector3& value) const
+    {
+        NetworkValueBitCodec<DoubleVector3>{range_, numBits_}.Write(dest, value.Cast<DoubleVector3>());
+    }
+
+    Vector3 Read(BitReader& src) const
+    {
+        return NetworkValueBitCodec<DoubleVector3>{range_, numBits_}.Read(src).Cast<Vector3>();
+    }
+};
+
+template <>
+struct NetworkValueBitCodec<Quaternion>
+{
+    unsigned numBits_{};
+
+    void Write(BitWriter& dest, const Quaternion& value) const
+    {
+        if (numBits_ != 0)
+            dest.WriteQuantizedQuaternion(value, numBits_);
+        else
+        {
+            dest.WriteFloat(value.w_);
+            dest.WriteFloat(value.x_);
+            dest.WriteFloat(value.y_);
+            dest.WriteFloat(value.z_);
+        }
+    }
+
+    Quaternion Read(BitReader& src) const
+    {
+        if (numBits_ != 0)
+            return src.ReadQuantizedQuaternion(numBits_);
+
+        const float w = src.ReadFloat();
+        const float x = src.ReadFloat();
+        const float y = src.ReadFloat();
+        const float z = src.ReadFloat();
+        return Quaternion{w, x, y, z};
+    }
+};
+
+template <class T>
+struct NetworkValueBitCodec<ValueWithDerivative<T>>
+{
+    using DerivativeType = decltype(ValueWithDerivative<T>::derivative_);
+
+    NetworkValueBitCodec<T> value_;
+    NetworkValueBitCodec<DerivativeType> derivative_;
+
+    void Write(BitWriter& dest, const ValueWithDerivative<T>& value) const
+    {
+        value_.Write(dest, value.value_);
+        derivative_.Write(dest, value.derivative_);
+    }
+
+    ValueWithDerivative<T> Read(BitReader& src) const
+    {
+        ValueWithDerivative<T> result;
+        result.value_ = value_.Read(src);
+        result.derivative_ = derivative_.Read(src);
+        return result;
+    }
+};
+/// @}
+
+} // namespace Urho3D
@@ -191,7 +191,10 @@ void PredictedKinematicController::CheckAndCorrectController(NetworkFrame frame)
         return;
 
     if (AdjustConfirmedFrame(*latestConfirmedFrame, *nextInputFrame))
+    {
         client_.latestAffectedFrame_ = frame;
+        ++client_.numCorrections_;
+    }
     client_.latestConfirmedFrame_ = *latestConfirmedFrame;
 }
 
@@ -53,6 +53,8 @@ public:
     /// Velocity is synchronized between server and replicating client,
     /// but is not synchronized for owner client.
     const Vector3& GetVelocity() const { return effectiveVelocity_; }
+    /// Owner client only: return number of times the predicted position was corrected to match the server.
+    unsigned GetNumCorrections() const { return client_.numCorrections_; }
 
     /// Implementation of NetworkObject
     /// @{
@@ -98,6 +100,8 @@ private:
 
         ea::optional<NetworkFrame> latestConfirmedFrame_;
         ea::optional<NetworkFrame> latestAffectedFrame_;
+
+        unsigned numCorrections_{};
     } client_;
 };
 
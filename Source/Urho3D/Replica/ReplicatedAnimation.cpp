@@ -10,6 +10,7 @@
 #include "Urho3D/Graphics/AnimatedModel.h"
 #include "Urho3D/Graphics/Animation.h"
 #include "Urho3D/Graphics/AnimationController.h"
+#include "Urho3D/IO/BitStream.h"
 #include "Urho3D/Network/NetworkEvents.h"
 #include "Urho3D/Resource/ResourceCache.h"
 #ifdef URHO3D_IK
@@ -39,6 +40,7 @@ void ReplicatedAnimation::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Replicate Owner", bool, replicateOwner_, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Smoothing Time", float, smoothingTime_, DefaultSmoothingTime, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Layers", GetLayersAttr, SetLayersAttr, VariantVector, Variant::emptyVariantVector, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Bit Packing", bool, bitPacking_, DefaultBitPacking, AM_DEFAULT);
     // clang-format on
 }
 
@@ -86,6 +88,7 @@ void ReplicatedAnimation::WriteSnapshot(NetworkFrame frame, Serializer& dest)
     if (!animationController_)
         return;
 
+    dest.WriteBool(bitPacking_);
     dest.WriteVLE(animationLookup_.size());
     for (const auto& [nameHash, name] : animationLookup_)
         dest.WriteString(name);
@@ -106,6 +109,7 @@ void ReplicatedAnimation::InitializeFromSnapshot(NetworkFrame frame, Deserialize
     client_.animationTrace_.Resize(traceDuration);
     client_.latestAppliedFrame_ = ea::nullopt;
 
+    bitPacking_ = src.ReadBool();
     ReadLookupsOnClient(src);
 
     // Read initial animations
@@ -191,6 +195,12 @@ Animation* ReplicatedAnimation::GetAnimationByHash(StringHash nameHash) const
 
 void ReplicatedAnimation::WriteSnapshot(Serializer& dest)
 {
+    if (bitPacking_)
+    {
+        WriteSnapshotBits(dest);
+        return;
+    }
+
     server_.snapshotBuffer_.Clear();
 
     const unsigned numAnimations = animationController_->GetNumAnimations();
@@ -207,6 +217,29 @@ void ReplicatedAnimation::WriteSnapshot(Serializer& dest)
     dest.WriteBuffer(server_.snapshotBuffer_.GetBuffer());
 }
 
+void ReplicatedAnimation::WriteSnapshotBits(Serializer& dest)
+{
+    server_.bitBuffer_.clear();
+    BitWriter writer{server_.bitBuffer_};
+
+    // Each animation is prefixed with continuation bit
+    const unsigned numAnimations = animationController_->GetNumAnimations();
+    for (unsigned i = 0; i < numAnimations; ++i)
+    {
+        const AnimationParameters& params = animationController_->GetAnimationParameters(i);
+        if (!layers_.empty() && !layers_.contains(params.layer_))
+            continue;
+
+        writer.WriteBool(true);
+        writer.WriteBits(params.GetAnimationName().Value(), 32);
+        params.SerializeBits(writer);
+    }
+    writer.WriteBool(false);
+    writer.Flush();
+
+    dest.WriteBuffer(server_.bitBuffer_);
+}
+
 ReplicatedAnimation::AnimationSnapshot ReplicatedAnimation::ReadSnapshot(Deserializer& src) const
 {
     const unsigned size = src.ReadVLE();
@@ -220,6 +253,19 @@ void ReplicatedAnimation::DecodeSnapshot(
     const AnimationSnapshot& snapshot, ea::vector<AnimationParameters>& result) const
 {
     result.clear();
+    if (bitPacking_)
+    {
+        BitReader src{ConstByteSpan{snapshot.data(), snapshot.size()}};
+        while (src.ReadBool() && !src.IsOverflow())
+        {
+            Animation* animation = GetAnimationByHash(StringHash{src.ReadBits(32)});
+            const auto params = AnimationParameters::DeserializeBits(animation, src);
+            if (animation && !src.IsOverflow())
+                result.push_back(params);
+        }
+        return;
+    }
+
     MemoryBuffer src{snapshot.data(), snapshot.size()};
     while (!src.IsEof())
     {
@@ -26,6 +26,7 @@ public:
     static constexpr unsigned SmallSnapshotSize = 256;
     static constexpr unsigned DefaultNumUploadAttempts = 4;
     static constexpr float DefaultSmoothingTime = 0.2f;
+    static constexpr bool DefaultBitPacking = false;
 
     static constexpr NetworkCallbackFlags CallbackMask = NetworkCallbackMask::ReliableDelta
         | NetworkCallbackMask::UnreliableDelta | NetworkCallbackMask::InterpolateState
@@ -46,6 +47,9 @@ public:
     const ea::vector<unsigned>& GetLayers() const { return layers_; }
     void SetLayersAttr(const VariantVector& layers);
     const VariantVector& GetLayersAttr() const;
+    /// Pack animation parameters without byte alignment and with quantized weights.
+    void SetBitPacking(bool value) { bitPacking_ = value; }
+    bool GetBitPacking() const { return bitPacking_; }
 
     const StringMap& GetAnimationLookup() const { return animationLookup_; }
 
@@ -80,6 +84,7 @@ private:
     bool IsAnimationReplicated() const;
     Animation* GetAnimationByHash(StringHash nameHash) const;
     void WriteSnapshot(Serializer& dest);
+    void WriteSnapshotBits(Serializer& dest);
     AnimationSnapshot ReadSnapshot(Deserializer& src) const;
     void DecodeSnapshot(const AnimationSnapshot& snapshot, ea::vector<AnimationParameters>& result) const;
 
@@ -97,6 +102,11 @@ private:
     ea::vector<unsigned> layers_;
     /// @}
 
+    /// Attributes matching on the client and the server. Replicated automatically.
+    /// @{
+    bool bitPacking_{DefaultBitPacking};
+    /// @}
+
     StringMap animationLookup_;
 
     struct ServerData
@@ -105,6 +115,7 @@ private:
         unsigned latestRevision_{};
         ea::vector<ea::string> newAnimationLookups_;
         VectorBuffer snapshotBuffer_;
+        ByteVector bitBuffer_;
     } server_;
 
     struct ClientData
@@ -85,6 +85,13 @@ void ReplicatedTransform::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Velocity Encoding Parameter", float, velocityEncodingParameter_, DefaultVelocityEncodingParameter, AM_DEFAULT);
     URHO3D_ENUM_ATTRIBUTE("Angular Velocity Encoding", angularVelocityEncoding_, vectorEncodingNames, DefaultAngularVelocityEncoding, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Angular Velocity Encoding Parameter", float, angularVelocityEncodingParameter_, DefaultAngularVelocityEncodingParameter, AM_DEFAULT);
+
+    URHO3D_ATTRIBUTE("Bit Packing", bool, bitPacking_, DefaultBitPacking, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Position Bits", GetPositionBits, SetPositionBits, unsigned, DefaultPositionBits, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Velocity Bits", GetVelocityBits, SetVelocityBits, unsigned, DefaultVelocityBits, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Rotation Bits", GetRotationBits, SetRotationBits, unsigned, DefaultRotationBits, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Angular Velocity Bits", GetAngularVelocityBits, SetAngularVelocityBits, unsigned,
+        DefaultAngularVelocityBits, AM_DEFAULT);
 }
 
 void ReplicatedTransform::InitializeOnServer()
@@ -117,6 +124,7 @@ void ReplicatedTransform::WriteSnapshot(NetworkFrame frame, Serializer& dest)
     flags[3] = extrapolateRotation_;
     flags[4] = includePreviousFrame_;
     flags[5] = synchronizeScale_;
+    flags[6] = bitPacking_;
     dest.WriteVLE(flags.to_uint32());
 }
 
@@ -131,6 +139,7 @@ void ReplicatedTransform::InitializeFromSnapshot(NetworkFrame frame, Deserialize
     extrapolateRotation_ = flags[3];
     includePreviousFrame_ = flags[4];
     synchronizeScale_ = flags[5];
+    bitPacking_ = flags[6];
 
     const auto replicationManager = GetNetworkObject()->GetReplicationManager();
     const unsigned updateFrequency = replicationManager->GetUpdateFrequency();
@@ -309,8 +318,63 @@ void ReplicatedTransform::ReadUnreliableDeltaForFrame(NetworkFrame frame, Deseri
     }
 }
 
+void ReplicatedTransform::WriteUnreliableDeltaForFrame(NetworkFrame frame, BitWriter& dest)
+{
+    if (synchronizePosition_)
+    {
+        const PositionAndVelocity defaultPositionData{server_.position_, server_.velocity_};
+        GetPositionCodec().Write(dest, positionTrace_.GetRaw(frame).value_or(defaultPositionData));
+    }
+
+    if (synchronizeRotation_ == ReplicatedRotationMode::XYZ)
+    {
+        const RotationAndVelocity defaultRotationData{server_.rotation_, server_.angularVelocity_};
+        GetRotationCodec().Write(dest, rotationTrace_.GetRaw(frame).value_or(defaultRotationData));
+    }
+
+    if (synchronizeScale_)
+    {
+        const float defaultScaleData = server_.scale_;
+        dest.WriteFloat(scaleTrace_.GetRaw(frame).value_or(defaultScaleData));
+    }
+}
+
+void ReplicatedTransform::ReadUnreliableDeltaForFrame(NetworkFrame frame, BitReader& src)
+{
+    if (synchronizePosition_)
+        positionTrace_.Set(frame, GetPositionCodec().Read(src));
+
+    if (synchronizeRotation_ == ReplicatedRotationMode::XYZ)
+        rotationTrace_.Set(frame, GetRotationCodec().Read(src));
+
+    if (synchronizeScale_)
+        scaleTrace_.Set(frame, src.ReadFloat());
+}
+
+NetworkValueBitCodec<PositionAndVelocity> ReplicatedTransform::GetPositionCodec() const
+{
+    return {{positionEncodingParameter_, positionBits_}, {velocityEncodingParameter_, velocityBits_}};
+}
+
+NetworkValueBitCodec<RotationAndVelocity> ReplicatedTransform::GetRotationCodec() const
+{
+    return {{rotationBits_}, {angularVelocityEncodingParameter_, angularVelocityBits_}};
+}
+
 void ReplicatedTransform::WriteUnreliableDelta(NetworkFrame frame, Serializer& dest)
 {
+    if (bitPacking_)
+    {
+        bitBuffer_.clear();
+        BitWriter writer{bitBuffer_};
+        WriteUnreliableDeltaForFrame(frame, writer);
+        if (includePreviousFrame_)
+            WriteUnreliableDeltaForFrame(frame - 1, writer);
+        writer.Flush();
+        dest.WriteBuffer(bitBuffer_);
+        return;
+    }
+
     WriteUnreliableDeltaForFrame(frame, dest);
     if (includePreviousFrame_)
         WriteUnreliableDeltaForFrame(frame - 1, dest);
@@ -318,6 +382,16 @@ void ReplicatedTransform::WriteUnreliableDelta(NetworkFrame frame, Serializer& d
 
 void ReplicatedTransform::ReadUnreliableDelta(NetworkFrame frame, Deserializer& src)
 {
+    if (bitPacking_)
+    {
+        src.ReadBuffer(bitBuffer_);
+        BitReader reader{bitBuffer_};
+        ReadUnreliableDeltaForFrame(frame, reader);
+        if (includePreviousFrame_)
+            ReadUnreliableDeltaForFrame(frame - 1, reader);
+        return;
+    }
+
     ReadUnreliableDeltaForFrame(frame, src);
     if (includePreviousFrame_)
         ReadUnreliableDeltaForFrame(frame - 1, src);
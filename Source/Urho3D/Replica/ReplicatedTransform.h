@@ -27,6 +27,7 @@
 #include "Urho3D/IO/IODefs.h"
 #include "Urho3D/Replica/BehaviorNetworkObject.h"
 #include "Urho3D/Replica/NetworkValue.h"
+#include "Urho3D/Replica/NetworkValueCodec.h"
 
 namespace Urho3D
 {
@@ -71,6 +72,12 @@ public:
     static constexpr float DefaultVelocityEncodingParameter = 100.0f;
     static constexpr float DefaultAngularVelocityEncodingParameter = 100.0f;
 
+    static constexpr bool DefaultBitPacking = false;
+    static constexpr unsigned DefaultPositionBits = 0;
+    static constexpr unsigned DefaultVelocityBits = 16;
+    static constexpr unsigned DefaultRotationBits = 12;
+    static constexpr unsigned DefaultAngularVelocityBits = 16;
+
     static constexpr NetworkCallbackFlags CallbackMask =
         NetworkCallbackMask::UpdateTransformOnServer | NetworkCallbackMask::UnreliableDelta | NetworkCallbackMask::InterpolateState;
 
@@ -125,6 +132,20 @@ public:
     float GetVelocityEncodingParameter() const { return velocityEncodingParameter_; }
     void SetAngularVelocityEncodingParameter(float value) { angularVelocityEncodingParameter_ = value; }
     float GetAngularVelocityEncodingParameter() const { return angularVelocityEncodingParameter_; }
+
+    /// Bit packing replaces encodings above with quantized values packed without byte alignment.
+    /// Ranges are taken from encoding parameters. Zero number of bits means raw float,
+    /// other values are clamped to [2, 32].
+    void SetBitPacking(bool value) { bitPacking_ = value; }
+    bool GetBitPacking() const { return bitPacking_; }
+    void SetPositionBits(unsigned value) { positionBits_ = SanitizeNumBits(value); }
+    unsigned GetPositionBits() const { return positionBits_; }
+    void SetVelocityBits(unsigned value) { velocityBits_ = SanitizeNumBits(value); }
+    unsigned GetVelocityBits() const { return velocityBits_; }
+    void SetRotationBits(unsigned value) { rotationBits_ = SanitizeNumBits(value); }
+    unsigned GetRotationBits() const { return rotationBits_; }
+    void SetAngularVelocityBits(unsigned value) { angularVelocityBits_ = SanitizeNumBits(value); }
+    unsigned GetAngularVelocityBits() const { return angularVelocityBits_; }
     /// @}
 
     /// Implement NetworkBehavior.
@@ -153,11 +174,19 @@ public:
     /// @}
 
 private:
+    /// Return number of bits supported by quantized floats: zero for raw float or in range [2, 32].
+    static unsigned SanitizeNumBits(unsigned value) { return value == 0 ? 0 : Clamp(value, 2u, 32u); }
+
     void InitializeCommon();
     void OnServerFrameEnd(NetworkFrame frame);
 
     void WriteUnreliableDeltaForFrame(NetworkFrame frame, Serializer& dest);
     void ReadUnreliableDeltaForFrame(NetworkFrame frame, Deserializer& src);
+    void WriteUnreliableDeltaForFrame(NetworkFrame frame, BitWriter& dest);
+    void ReadUnreliableDeltaForFrame(NetworkFrame frame, BitReader& src);
+
+    NetworkValueBitCodec<PositionAndVelocity> GetPositionCodec() const;
+    NetworkValueBitCodec<RotationAndVelocity> GetRotationCodec() const;
 
     /// Attributes independent on the client and the server.
     /// @{
@@ -178,6 +207,7 @@ private:
     bool extrapolatePosition_{DefaultExtrapolatePosition};
     bool extrapolateRotation_{DefaultExtrapolateRotation};
     bool synchronizeScale_{DefaultSynchronizeScale};
+    bool bitPacking_{DefaultBitPacking};
     bool includePreviousFrame_{}; // Deduced from numUploadAttempts_
     /// @}
 
@@ -192,8 +222,15 @@ private:
     float positionEncodingParameter_{DefaultPositionEncodingParameter};
     float velocityEncodingParameter_{DefaultVelocityEncodingParameter};
     float angularVelocityEncodingParameter_{DefaultAngularVelocityEncodingParameter};
+
+    unsigned positionBits_{DefaultPositionBits};
+    unsigned velocityBits_{DefaultVelocityBits};
+    unsigned rotationBits_{DefaultRotationBits};
+    unsigned angularVelocityBits_{DefaultAngularVelocityBits};
     /// @}
 
+    ByteVector bitBuffer_;
+
     NetworkValue<PositionAndVelocity> positionTrace_;
     NetworkValue<RotationAndVelocity> rotationTrace_;
     NetworkValue<float> scaleTrace_;
@@ -171,6 +171,12 @@ void ReplicationManager::RegisterObject(Context* context)
     // clang-format off
     URHO3D_ATTRIBUTE("Is Fixed Update Server", bool, attributes_.isFixedUpdateServer_, Attributes{}.isFixedUpdateServer_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Allow Zero Updates On Server", bool, attributes_.allowZeroUpdatesOnServer_, Attributes{}.allowZeroUpdatesOnServer_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Interest Cell Size", float, attributes_.interestCellSize_, Attributes{}.interestCellSize_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Interest Radius", float, attributes_.interestRadius_, Attributes{}.interestRadius_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Baseline Compression", bool, attributes_.baselineCompression_, Attributes{}.baselineCompression_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Threaded Update", bool, attributes_.threadedUpdate_, Attributes{}.threadedUpdate_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Lag Compensation", bool, attributes_.lagCompensation_, Attributes{}.lagCompensation_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Join Snapshot", bool, attributes_.joinSnapshot_, Attributes{}.joinSnapshot_, AM_DEFAULT);
     // clang-format on
 }
 
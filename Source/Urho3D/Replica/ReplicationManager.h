@@ -117,6 +117,30 @@ public:
     void SetFixedUpdateServer(bool fixed) { attributes_.isFixedUpdateServer_ = fixed; }
     bool IsAllowZeroUpdatesOnServer() const { return attributes_.allowZeroUpdatesOnServer_; }
     void SetAllowZeroUpdatesOnServer(bool allow) { attributes_.allowZeroUpdatesOnServer_ = allow; }
+    /// Interest grid is used by server to skip relevance checks for objects far from all objects owned by client.
+    /// Zero cell size disables the grid. Changes are applied when server is started.
+    float GetInterestCellSize() const { return attributes_.interestCellSize_; }
+    void SetInterestCellSize(float cellSize) { attributes_.interestCellSize_ = cellSize; }
+    float GetInterestRadius() const { return attributes_.interestRadius_; }
+    void SetInterestRadius(float radius) { attributes_.interestRadius_ = radius; }
+    /// Baseline compression encodes unreliable updates as deltas against updates acknowledged by the client.
+    /// Changes are applied when server is started.
+    bool IsBaselineCompression() const { return attributes_.baselineCompression_; }
+    void SetBaselineCompression(bool enabled) { attributes_.baselineCompression_ = enabled; }
+    /// Threaded update processes client connections of the server in WorkQueue threads.
+    /// NetworkObject callbacks used by server replication, e.g. GetRelevanceForClient and WriteSnapshot,
+    /// must be safe to call from multiple threads. Changes are applied when server is started.
+    bool IsThreadedUpdate() const { return attributes_.threadedUpdate_; }
+    void SetThreadedUpdate(bool enabled) { attributes_.threadedUpdate_ = enabled; }
+    /// Lag compensation records hitboxes of network objects on server so hits can be evaluated in the past.
+    /// See ServerReplicator::GetLagCompensation. Changes are applied when server is started.
+    bool IsLagCompensation() const { return attributes_.lagCompensation_; }
+    void SetLagCompensation(bool enabled) { attributes_.lagCompensation_ = enabled; }
+    /// Join snapshot sends all StaticNetworkObject-s to joining clients as single compressed buffer,
+    /// which is built periodically and shared between clients. Objects are created on the client in batches.
+    /// Changes are applied when server is started.
+    bool IsJoinSnapshot() const { return attributes_.joinSnapshot_; }
+    void SetJoinSnapshot(bool enabled) { attributes_.joinSnapshot_ = enabled; }
     /// @}
 
     /// Return current state specific to client or server.
@@ -170,6 +194,12 @@ private:
     {
         bool isFixedUpdateServer_{true};
         bool allowZeroUpdatesOnServer_{};
+        float interestCellSize_{};
+        float interestRadius_{100.0f};
+        bool baselineCompression_{};
+        bool threadedUpdate_{};
+        bool lagCompensation_{};
+        bool joinSnapshot_{};
     } attributes_;
 
     ReplicationManagerMode mode_{};
@@ -10,12 +10,14 @@
 #include "Urho3D/Core/CoreEvents.h"
 #include "Urho3D/Core/Exception.h"
 #include "Urho3D/Core/Timer.h"
+#include "Urho3D/Core/WorkQueue.h"
 #include "Urho3D/IO/Log.h"
 #include "Urho3D/Math/RandomEngine.h"
 #include "Urho3D/Network/Connection.h"
 #include "Urho3D/Network/MessageUtils.h"
 #include "Urho3D/Network/Network.h"
 #include "Urho3D/Network/NetworkEvents.h"
+#include "Urho3D/Replica/LagCompensation.h"
 #include "Urho3D/Replica/NetworkObject.h"
 #include "Urho3D/Replica/NetworkSettingsConsts.h"
 #include "Urho3D/Replica/ReplicationManager.h"
@@ -23,6 +25,7 @@
 #include "Urho3D/Scene/SceneEvents.h"
 
 #include <EASTL/numeric.h>
+#include <EASTL/sort.h>
 
 namespace Urho3D
 {
@@ -35,6 +38,9 @@ unsigned GetIndex(NetworkId networkId)
     return DeconstructComponentReference(networkId).first;
 }
 
+/// Frame, total size, uncompressed size and offset of join snapshot chunk, with VLE at max size.
+constexpr unsigned MaxJoinSnapshotChunkHeaderSize = 8 + 5 + 5 + 5;
+
 } // namespace
 
 SharedReplicationState::SharedReplicationState(NetworkObjectRegistry* objectRegistry)
@@ -56,6 +62,9 @@ void SharedReplicationState::OnNetworkObjectAdded(NetworkObject* networkObject)
 
 void SharedReplicationState::OnNetworkObjectRemoved(NetworkObject* networkObject)
 {
+    if (interestGrid_)
+        interestGrid_->RemoveObject(GetIndex(networkObject->GetNetworkId()));
+
     if (recentlyAddedObjects_.erase(networkObject->GetNetworkId()) == 0)
         recentlyRemovedObjects_.insert(networkObject->GetNetworkId());
 
@@ -77,6 +86,42 @@ void SharedReplicationState::PrepareForUpdate()
 
     objectRegistry_->UpdateNetworkObjects();
     objectRegistry_->GetSortedNetworkObjects(sortedNetworkObjects_);
+
+    UpdateInterestGrid();
+}
+
+void SharedReplicationState::EnableInterestGrid(float cellSize, float radius)
+{
+    interestGrid_ = ea::make_unique<NetworkInterestGrid>(cellSize);
+    interestRadius_ = radius;
+}
+
+void SharedReplicationState::UpdateInterestGrid()
+{
+    if (!interestGrid_)
+        return;
+
+    URHO3D_PROFILE("UpdateInterestGrid");
+
+    // Positions are checked once per frame for all clients, grid itself changes only if objects change cells
+    interestGrid_->ResetChangedObjects();
+    globalObjects_.clear();
+    sortedOrder_.resize(GetIndexUpperBound());
+
+    for (unsigned i = 0; i < sortedNetworkObjects_.size(); ++i)
+    {
+        NetworkObject* networkObject = sortedNetworkObjects_[i];
+        const unsigned index = GetIndex(networkObject->GetNetworkId());
+        sortedOrder_[index] = i;
+
+        if (networkObject->IsGlobal())
+        {
+            interestGrid_->RemoveObject(index);
+            globalObjects_.push_back(index);
+        }
+        else
+            interestGrid_->UpdateObject(index, networkObject->GetNode()->GetWorldPosition());
+    }
 }
 
 void SharedReplicationState::ResetFrameBuffers()
@@ -198,6 +243,7 @@ ClientSynchronizationState::ClientSynchronizationState(
     , connection_(connection)
     , settings_(settings)
     , updateFrequency_(GetSetting(NetworkSettings::UpdateFrequency).GetUInt())
+    , configurationMagic_(MakeMagic())
     , inputDelayFilter_(GetSetting(NetworkSettings::InputDelayFilterBufferSize).GetUInt())
     , inputStats_(GetSetting(NetworkSettings::InputBufferingWindowSize).GetUInt(), InputStatsSafetyLimit)
     , inputBufferFilter_(GetSetting(NetworkSettings::InputBufferingFilterBufferSize).GetUInt())
@@ -223,7 +269,7 @@ void ClientSynchronizationState::SendMessages()
     // Send configuration on startup once
     if (!synchronizationMagic_)
     {
-        const unsigned magic = MakeMagic();
+        const unsigned magic = configurationMagic_;
         WriteSerializedMessage(
             *connection_, MSG_CONFIGURE, MsgConfigure{magic, settings_}, PacketType::ReliableUnordered);
         synchronizationMagic_ = magic;
@@ -309,6 +355,8 @@ unsigned ClientSynchronizationState::MakeMagic() const
 ClientReplicationState::ClientReplicationState(
     NetworkObjectRegistry* objectRegistry, AbstractConnection* connection, const VariantMap& settings)
     : ClientSynchronizationState(objectRegistry, connection, settings)
+    , baselineCompression_(GetSetting(NetworkSettings::BaselineCompression).GetBool())
+    , joinSnapshotEnabled_(GetSetting(NetworkSettings::JoinSnapshot).GetBool())
 {
 }
 
@@ -318,7 +366,9 @@ void ClientReplicationState::SendMessages(NetworkFrame currentFrame, const Share
 
     ClientSynchronizationState::SendMessages();
 
-    if (IsSynchronized())
+    if (IsSynchronized() && joinSnapshotEnabled_ && !isJoinSnapshotApplied_)
+        SendJoinSnapshot();
+    else if (IsSynchronized())
     {
         SendRemoveObjects();
         SendAddObjects();
@@ -338,6 +388,10 @@ bool ClientReplicationState::ProcessMessage(NetworkMessageId messageId, MemoryBu
         ProcessObjectsFeedbackUnreliable(messageData);
         return true;
 
+    case MSG_JOIN_SNAPSHOT_ACK:
+        ProcessJoinSnapshotAck(messageData);
+        return true;
+
     default: return false;
     }
 }
@@ -351,6 +405,23 @@ void ClientReplicationState::ProcessObjectsFeedbackUnreliable(MemoryBuffer& mess
     }
 
     const auto feedbackFrame = static_cast<NetworkFrame>(messageData.ReadInt64());
+    if (baselineCompression_ && messageData.ReadBool())
+    {
+        const unsigned short latestSequence = messageData.ReadUShort();
+        const unsigned sequenceMask = messageData.ReadUInt();
+
+        ProcessUnreliableUpdatesAck(latestSequence);
+        for (unsigned i = 0; i < NetworkSequenceAcks::MaskSize; ++i)
+        {
+            if (sequenceMask & (1u << i))
+                ProcessUnreliableUpdatesAck(static_cast<unsigned short>(latestSequence - i - 1));
+        }
+    }
+
+    // Message may contain only acknowledgements, it shouldn't affect input statistics
+    if (messageData.IsEof())
+        return;
+
     OnInputReceived(feedbackFrame);
 
     while (!messageData.IsEof())
@@ -379,6 +450,82 @@ void ClientReplicationState::ProcessObjectsFeedbackUnreliable(MemoryBuffer& mess
     }
 }
 
+void ClientReplicationState::ProcessJoinSnapshotAck(MemoryBuffer& messageData)
+{
+    const unsigned receivedSize = messageData.ReadVLE();
+    const bool isLoaded = messageData.ReadBool();
+
+    if (!joinSnapshot_ || isJoinSnapshotApplied_)
+    {
+        URHO3D_LOGWARNING("Connection {}: Received unexpected join snapshot acknowledgement", connection_->ToString());
+        return;
+    }
+
+    joinSnapshotAckedSize_ = ea::max(joinSnapshotAckedSize_, ea::min(receivedSize, joinSnapshotSentSize_));
+    isJoinSnapshotLoaded_ = isLoaded && joinSnapshotAckedSize_ == joinSnapshot_->GetSize();
+}
+
+bool ClientReplicationState::IsWaitingForJoinSnapshot() const
+{
+    return joinSnapshotEnabled_ && IsSynchronized() && !joinSnapshot_ && !isJoinSnapshotApplied_;
+}
+
+void ClientReplicationState::SendJoinSnapshot()
+{
+    if (!joinSnapshot_)
+        return;
+
+    // Keep limited amount of data in flight, so the client connection is not flooded
+    const unsigned snapshotSize = joinSnapshot_->GetSize();
+    const unsigned windowSize = GetSetting(NetworkSettings::JoinSnapshotWindowSize).GetUInt();
+    const unsigned chunkSize = connection_->GetMaxMessageSize() - MaxJoinSnapshotChunkHeaderSize;
+    const unsigned bandwidthLimit = connection_->GetBandwidthLimit();
+    unsigned budget = bandwidthLimit != 0 ? ea::max(1u, bandwidthLimit / updateFrequency_) : M_MAX_UNSIGNED;
+
+    VectorBuffer& msg = connection_->GetOutgoingMessageBuffer();
+    while (joinSnapshotSentSize_ < snapshotSize && joinSnapshotSentSize_ - joinSnapshotAckedSize_ < windowSize
+        && budget > 0)
+    {
+        const unsigned size = ea::min(chunkSize, snapshotSize - joinSnapshotSentSize_);
+
+        msg.Clear();
+        joinSnapshot_->WriteChunk(msg, joinSnapshotSentSize_, size);
+        connection_->SendMessage(MSG_JOIN_SNAPSHOT, msg, PacketType::ReliableOrdered);
+
+        joinSnapshotSentSize_ += size;
+        budget -= ea::min(budget, size);
+    }
+}
+
+void ClientReplicationState::ApplyJoinSnapshot(const NetworkInterestGrid* interestGrid)
+{
+    const float relevanceTimeout = GetSetting(NetworkSettings::RelevanceTimeout).GetFloat();
+
+    // Objects may be removed after the snapshot was built or be outside of the area of interest,
+    // client should remove them too
+    for (NetworkId networkId : joinSnapshot_->GetNetworkIds())
+    {
+        const unsigned index = GetIndex(networkId);
+        NetworkObject* networkObject = objectRegistry_->GetNetworkObject(networkId);
+        const bool isOutsideArea = interestGrid && interestGrid->HasObject(index) && !interestArea_.IsInterested(index);
+        const NetworkObjectRelevance relevance = networkObject && !isOutsideArea
+            ? networkObject->GetRelevanceForClient(connection_).value_or(NetworkObjectRelevance::NormalUpdates)
+            : NetworkObjectRelevance::Irrelevant;
+
+        if (relevance == NetworkObjectRelevance::Irrelevant)
+        {
+            pendingRemovedObjects_.push_back(networkId);
+            continue;
+        }
+
+        objectsRelevance_[index] = relevance;
+        objectsRelevanceTimeouts_[index] = relevanceTimeout;
+    }
+
+    joinSnapshot_ = nullptr;
+    isJoinSnapshotApplied_ = true;
+}
+
 void ClientReplicationState::SendRemoveObjects()
 {
     MultiMessageWriter writer{*connection_, MSG_REMOVE_OBJECTS, PacketType::ReliableOrdered};
@@ -481,6 +628,19 @@ void ClientReplicationState::SendUpdateObjectsReliable(const SharedReplicationSt
 
 void ClientReplicationState::SendUpdateObjectsUnreliable(
     NetworkFrame currentFrame, const SharedReplicationState& sharedState)
+{
+    if (connection_->GetBandwidthLimit() != 0)
+        SelectUnreliableUpdatesInBudget(currentFrame, sharedState);
+    else
+        SelectUnreliableUpdates(currentFrame, sharedState);
+
+    if (baselineCompression_)
+        WriteUnreliableUpdatesWithBaselines(sharedState);
+    else
+        WriteUnreliableUpdates(sharedState);
+}
+
+void ClientReplicationState::WriteUnreliableUpdates(const SharedReplicationState& sharedState)
 {
     MultiMessageWriter writer{*connection_, MSG_UPDATE_OBJECTS_UNRELIABLE, PacketType::UnreliableUnordered};
 
@@ -490,6 +650,164 @@ void ClientReplicationState::SendUpdateObjectsUnreliable(
     msg.WriteInt64(static_cast<long long>(GetCurrentFrame()));
     writer.CompleteHeader();
 
+    for (unsigned index : unreliableUpdateIndices_)
+    {
+        NetworkObject* networkObject = objectRegistry_->GetNetworkObjectByIndex(index);
+        const auto updateSpan = sharedState.GetUnreliableUpdateByIndex(index);
+        URHO3D_ASSERT(networkObject && updateSpan);
+
+        msg.WriteUInt(static_cast<unsigned>(networkObject->GetNetworkId()));
+        msg.WriteStringHash(networkObject->GetType());
+
+        msg.WriteVLE(updateSpan->size());
+        msg.Write(updateSpan->data(), updateSpan->size());
+
+        if (debugInfo)
+        {
+            if (!debugInfo->empty())
+                debugInfo->append(", ");
+            debugInfo->append(ToString(networkObject->GetNetworkId()));
+        }
+
+        writer.CompletePayload();
+    }
+}
+
+void ClientReplicationState::WriteUnreliableUpdatesWithBaselines(const SharedReplicationState& sharedState)
+{
+    // Object ID, type hash, baseline age and size of the update, with VLE at max size
+    static constexpr unsigned MaxUpdateHeaderSize = 4 + 4 + 5 + 5;
+
+    const NetworkFrame currentFrame = GetCurrentFrame();
+    for (const auto& [networkObject, isSnapshot] : pendingUpdatedObjects_)
+    {
+        if (isSnapshot)
+            ResetObjectBaseline(GetIndex(networkObject->GetNetworkId()), networkObject->GetNetworkId());
+    }
+
+    if (unreliableUpdateIndices_.empty())
+        return;
+
+    // Each message has its own sequence number and is acknowledged separately,
+    // so the messages are split manually instead of using MultiMessageWriter.
+    VectorBuffer& msg = connection_->GetOutgoingMessageBuffer();
+#ifdef URHO3D_LOGGING
+    ea::string* debugInfo = &connection_->GetDebugInfoBuffer();
+#else
+    ea::string* debugInfo = nullptr;
+#endif
+
+    SentUnreliableMessage* sentMessage = nullptr;
+    const auto beginMessage = [&]
+    {
+        sentMessage = &sentUnreliableMessages_[nextUnreliableSequence_ % MaxSentUnreliableMessages];
+        sentMessage->sequence_ = nextUnreliableSequence_;
+        sentMessage->isPending_ = true;
+        sentMessage->frame_ = currentFrame;
+        sentMessage->updates_.clear();
+        sentMessage->data_.clear();
+
+        msg.Clear();
+        msg.WriteInt64(static_cast<long long>(currentFrame));
+        msg.WriteUShort(nextUnreliableSequence_);
+        if (debugInfo)
+            debugInfo->clear();
+    };
+    const auto sendMessage = [&]
+    {
+        connection_->SendMessage(MSG_UPDATE_OBJECTS_UNRELIABLE, msg, PacketType::UnreliableUnordered,
+            debugInfo ? ea::string_view{*debugInfo} : ea::string_view{});
+        ++nextUnreliableSequence_;
+    };
+
+    beginMessage();
+    const unsigned headerSize = msg.GetSize();
+    for (unsigned index : unreliableUpdateIndices_)
+    {
+        NetworkObject* networkObject = objectRegistry_->GetNetworkObjectByIndex(index);
+        const auto updateSpan = sharedState.GetUnreliableUpdateByIndex(index);
+        URHO3D_ASSERT(networkObject && updateSpan);
+
+        const NetworkId networkId = networkObject->GetNetworkId();
+        const unsigned maxUpdateSize = MaxUpdateHeaderSize + updateSpan->size();
+        if (msg.GetSize() != headerSize && msg.GetSize() + maxUpdateSize > connection_->GetMaxMessageSize())
+        {
+            sendMessage();
+            beginMessage();
+        }
+
+        // Baseline is usable only if the client still remembers it
+        const ObjectBaseline& baseline = objectBaselines_[index];
+        const bool hasBaseline = baseline.networkId_ == networkId && baseline.frame_ > baseline.resetFrame_
+            && baseline.data_.size() == updateSpan->size()
+            && currentFrame - baseline.frame_ < NetworkBaselineHistory::MaxSize;
+
+        msg.WriteUInt(static_cast<unsigned>(networkId));
+        msg.WriteStringHash(networkObject->GetType());
+        if (hasBaseline)
+        {
+            EncodeBaselineDelta(baseline.data_, *updateSpan, baselineDelta_);
+            msg.WriteVLE(static_cast<unsigned>(currentFrame - baseline.frame_));
+            msg.WriteVLE(baselineDelta_.size());
+            msg.Write(baselineDelta_.data(), baselineDelta_.size());
+        }
+        else
+        {
+            msg.WriteVLE(0);
+            msg.WriteVLE(updateSpan->size());
+            msg.Write(updateSpan->data(), updateSpan->size());
+        }
+
+        sentMessage->updates_.push_back(
+            SentUnreliableUpdate{index, networkId, static_cast<unsigned>(sentMessage->data_.size()), updateSpan->size()});
+        sentMessage->data_.insert(sentMessage->data_.end(), updateSpan->begin(), updateSpan->end());
+
+        if (debugInfo)
+        {
+            if (!debugInfo->empty())
+                debugInfo->append(", ");
+            debugInfo->append(ToString(networkId));
+        }
+    }
+    sendMessage();
+}
+
+void ClientReplicationState::ResetObjectBaseline(unsigned index, NetworkId networkId)
+{
+    ObjectBaseline& baseline = objectBaselines_[index];
+    baseline.networkId_ = networkId;
+    baseline.resetFrame_ = GetCurrentFrame();
+    baseline.frame_ = baseline.resetFrame_;
+    baseline.data_.clear();
+}
+
+void ClientReplicationState::ProcessUnreliableUpdatesAck(unsigned short sequence)
+{
+    SentUnreliableMessage& sentMessage = sentUnreliableMessages_[sequence % MaxSentUnreliableMessages];
+    if (!sentMessage.isPending_ || sentMessage.sequence_ != sequence)
+        return;
+
+    sentMessage.isPending_ = false;
+    for (const SentUnreliableUpdate& update : sentMessage.updates_)
+    {
+        if (update.index_ >= objectBaselines_.size())
+            continue;
+
+        // Ignore acknowledgements of outdated updates, including ones sent before baseline reset
+        ObjectBaseline& baseline = objectBaselines_[update.index_];
+        if (baseline.networkId_ != update.networkId_ || sentMessage.frame_ <= baseline.frame_)
+            continue;
+
+        const auto data = ConstByteSpan{sentMessage.data_}.subspan(update.offset_, update.size_);
+        baseline.frame_ = sentMessage.frame_;
+        baseline.data_.assign(data.begin(), data.end());
+    }
+}
+
+void ClientReplicationState::SelectUnreliableUpdates(
+    NetworkFrame currentFrame, const SharedReplicationState& sharedState)
+{
+    unreliableUpdateIndices_.clear();
     for (const auto& [networkObject, isSnapshot] : pendingUpdatedObjects_)
     {
         // Skip redundant updates, both if update is empty or if snapshot was already sent
@@ -497,8 +815,7 @@ void ClientReplicationState::SendUpdateObjectsUnreliable(
         if (isSnapshot)
             continue;
 
-        const auto updateSpan = sharedState.GetUnreliableUpdateByIndex(index);
-        if (!updateSpan)
+        if (!sharedState.GetUnreliableUpdateByIndex(index))
             continue;
 
         const NetworkObjectRelevance relevance = objectsRelevance_[index];
@@ -509,24 +826,51 @@ void ClientReplicationState::SendUpdateObjectsUnreliable(
         if (static_cast<long long>(currentFrame) % static_cast<unsigned>(relevance) != 0)
             continue;
 
-        msg.WriteUInt(static_cast<unsigned>(networkObject->GetNetworkId()));
-        msg.WriteStringHash(networkObject->GetType());
+        unreliableUpdateIndices_.push_back(index);
+    }
+}
 
-        msg.WriteVLE(updateSpan->size());
-        msg.Write(updateSpan->data(), updateSpan->size());
+void ClientReplicationState::SelectUnreliableUpdatesInBudget(
+    NetworkFrame currentFrame, const SharedReplicationState& sharedState)
+{
+    // Object ID, type hash and size of the update
+    static constexpr unsigned UpdateHeaderSize = 4 + 4 + 2;
 
-        if (debugInfo)
+    for (const auto& [networkObject, isSnapshot] : pendingUpdatedObjects_)
+    {
+        // Snapshot contains the most recent state, so the object starts from scratch
+        const unsigned index = GetIndex(networkObject->GetNetworkId());
+        if (isSnapshot)
         {
-            if (!debugInfo->empty())
-                debugInfo->append(", ");
-            debugInfo->append(ToString(networkObject->GetNetworkId()));
+            priorityAccumulator_.RemoveObject(index);
+            objectsLastUnreliableFrames_[index] = currentFrame;
+            continue;
         }
 
-        writer.CompletePayload();
+        const auto updateSpan = sharedState.GetUnreliableUpdateByIndex(index);
+        if (!updateSpan)
+            continue;
+
+        const NetworkObjectRelevance relevance = objectsRelevance_[index];
+        URHO3D_ASSERT(relevance != NetworkObjectRelevance::Irrelevant);
+        if (relevance == NetworkObjectRelevance::NoUpdates)
+            continue;
+
+        // Update period is both the upper limit of update frequency and the divisor of priority
+        const auto period = static_cast<unsigned>(relevance);
+        const bool isEligible = currentFrame - objectsLastUnreliableFrames_[index] >= period;
+        const float priority = networkObject->GetUpdatePriority() / period;
+        priorityAccumulator_.AddObject(index, priority, updateSpan->size() + UpdateHeaderSize, isEligible);
     }
+
+    const unsigned budget = connection_->GetBandwidthLimit() / updateFrequency_;
+    priorityAccumulator_.SelectObjects(budget, unreliableUpdateIndices_);
+
+    for (unsigned index : unreliableUpdateIndices_)
+        objectsLastUnreliableFrames_[index] = currentFrame;
 }
 
-void ClientReplicationState::UpdateNetworkObjects(SharedReplicationState& sharedState)
+void ClientReplicationState::UpdateNetworkObjects(const SharedReplicationState& sharedState)
 {
     if (!IsSynchronized())
         return;
@@ -539,10 +883,17 @@ void ClientReplicationState::UpdateNetworkObjects(SharedReplicationState& shared
     const unsigned indexUpperBound = sharedState.GetIndexUpperBound();
     objectsRelevance_.resize(indexUpperBound, NetworkObjectRelevance::Irrelevant);
     objectsRelevanceTimeouts_.resize(indexUpperBound);
+    objectsLastUnreliableFrames_.resize(indexUpperBound);
+    if (baselineCompression_)
+        objectBaselines_.resize(indexUpperBound);
 
     pendingRemovedObjects_.clear();
     pendingUpdatedObjects_.clear();
 
+    // Objects are not replicated until join snapshot is loaded by the client
+    if (joinSnapshotEnabled_ && !isJoinSnapshotApplied_ && !isJoinSnapshotLoaded_)
+        return;
+
     // Process removed components first
     for (NetworkId networkId : sharedState.GetRecentlyRemovedObjects())
     {
@@ -552,10 +903,21 @@ void ClientReplicationState::UpdateNetworkObjects(SharedReplicationState& shared
             objectsRelevance_[index] = NetworkObjectRelevance::Irrelevant;
             pendingRemovedObjects_.push_back(networkId);
         }
+        // Index may be reused by another object, which should not inherit accumulated priority
+        priorityAccumulator_.RemoveObject(index);
+        interestArea_.RemoveObject(index);
     }
 
-    // Process active components
-    for (NetworkObject* networkObject : sharedState.GetSortedObjects())
+    // Process active components, only ones in the area of interest if interest grid is enabled
+    const NetworkInterestGrid* interestGrid = sharedState.GetInterestGrid();
+    if (interestGrid)
+        UpdateInterestArea(sharedState, *interestGrid);
+
+    // Snapshot objects are evaluated against the area of interest, so it should be updated first
+    if (joinSnapshotEnabled_ && !isJoinSnapshotApplied_)
+        ApplyJoinSnapshot(interestGrid);
+
+    for (NetworkObject* networkObject : interestGrid ? interestedObjects_ : sharedState.GetSortedObjects())
     {
         const NetworkId networkId = networkObject->GetNetworkId();
         const NetworkId parentNetworkId = networkObject->GetParentNetworkId();
@@ -590,19 +952,70 @@ void ClientReplicationState::UpdateNetworkObjects(SharedReplicationState& shared
                 {
                     // Remove irrelevant component
                     pendingRemovedObjects_.push_back(networkId);
+                    priorityAccumulator_.RemoveObject(index);
                     continue;
                 }
 
                 objectsRelevanceTimeouts_[index] = relevanceTimeout;
             }
 
-            // Queue non-snapshot update
-            sharedState.QueueDeltaUpdate(networkObject);
             pendingUpdatedObjects_.push_back({networkObject, false});
         }
     }
 }
 
+void ClientReplicationState::QueueDeltaUpdates(SharedReplicationState& sharedState) const
+{
+    for (const auto& [networkObject, isSnapshot] : pendingUpdatedObjects_)
+    {
+        if (!isSnapshot)
+            sharedState.QueueDeltaUpdate(networkObject);
+    }
+}
+
+void ClientReplicationState::UpdateInterestArea(
+    const SharedReplicationState& sharedState, const NetworkInterestGrid& interestGrid)
+{
+    URHO3D_PROFILE("UpdateInterestArea");
+
+    interestCenters_.clear();
+    for (NetworkObject* networkObject : sharedState.GetOwnedObjectsByConnection(connection_))
+        interestCenters_.push_back(networkObject->GetNode()->GetWorldPosition());
+    interestArea_.Update(interestGrid, interestCenters_, sharedState.GetInterestRadius());
+
+    // Objects outside of the area are removed without evaluating custom filters
+    for (unsigned index : interestArea_.GetLeftObjects())
+    {
+        if (interestArea_.IsInterested(index) || objectsRelevance_[index] == NetworkObjectRelevance::Irrelevant)
+            continue;
+
+        NetworkObject* networkObject = objectRegistry_->GetNetworkObjectByIndex(index);
+        URHO3D_ASSERT(networkObject);
+
+        objectsRelevance_[index] = NetworkObjectRelevance::Irrelevant;
+        pendingRemovedObjects_.push_back(networkObject->GetNetworkId());
+        priorityAccumulator_.RemoveObject(index);
+    }
+
+    // Objects should be processed in the same order as without the grid, so parents go before children
+    interestedIndices_.clear();
+    interestedIndices_.insert(
+        interestedIndices_.end(), interestArea_.GetObjects().begin(), interestArea_.GetObjects().end());
+    for (unsigned index : sharedState.GetGlobalObjects())
+    {
+        if (!interestArea_.IsInterested(index))
+            interestedIndices_.push_back(index);
+    }
+
+    const auto isBefore = [&](unsigned lhs, unsigned rhs)
+    { return sharedState.GetSortedOrderByIndex(lhs) < sharedState.GetSortedOrderByIndex(rhs); };
+    ea::sort(interestedIndices_.begin(), interestedIndices_.end(), isBefore);
+
+    interestedObjects_.clear();
+    for (unsigned index : interestedIndices_)
+        interestedObjects_.push_back(objectRegistry_->GetNetworkObjectByIndex(index));
+}
+
 ServerReplicator::ServerReplicator(Scene* scene)
     : Object(scene->GetContext())
     , network_(GetSubsystem<Network>())
@@ -620,8 +1033,27 @@ ServerReplicator::ServerReplicator(Scene* scene)
         updateSync_ = MakeShared<SceneUpdateSynchronizer>(scene_, params);
     }
 
+    if (replicationManager_->IsThreadedUpdate())
+        workQueue_ = GetSubsystem<WorkQueue>();
+
+    if (replicationManager_->GetInterestCellSize() > 0.0f)
+    {
+        sharedState_->EnableInterestGrid(
+            replicationManager_->GetInterestCellSize(), replicationManager_->GetInterestRadius());
+    }
+
     SetDefaultNetworkSetting(settings_, NetworkSettings::InternalProtocolVersion);
     SetNetworkSetting(settings_, NetworkSettings::UpdateFrequency, updateFrequency_);
+    SetNetworkSetting(settings_, NetworkSettings::BaselineCompression, replicationManager_->IsBaselineCompression());
+    SetNetworkSetting(settings_, NetworkSettings::JoinSnapshot, replicationManager_->IsJoinSnapshot());
+
+    if (replicationManager_->IsLagCompensation())
+    {
+        // Keep hitboxes for as long as other server traces
+        const float traceDuration = GetSetting(NetworkSettings::ServerTracingDuration).GetFloat();
+        const unsigned historyLength = ea::max(1, CeilToInt(traceDuration * updateFrequency_));
+        lagCompensation_ = ea::make_unique<LagCompensation>(historyLength, GetSubsystem<WorkQueue>());
+    }
 
     SubscribeToEvent(E_INPUTREADY,
         [this](VariantMap& eventData)
@@ -680,13 +1112,66 @@ void ServerReplicator::OnNetworkUpdate()
     eventData[P_FRAME] = static_cast<long long>(currentFrame_);
     network_->SendEvent(E_ENDSERVERNETWORKFRAME, eventData);
 
+    if (lagCompensation_)
+        lagCompensation_->RecordObjects(currentFrame_, replicationManager_->GetNetworkObjects());
+
     sharedState_->PrepareForUpdate();
+    ProvideJoinSnapshots();
+
+    clientStates_.clear();
     for (auto& [connection, clientState] : connections_)
-        clientState->UpdateNetworkObjects(*sharedState_);
+        clientStates_.push_back(clientState);
+
+    // Clients are independent from each other, so they may be processed in parallel
+    const auto forEachClient = [&](const auto& callback)
+    {
+        if (workQueue_)
+            ForEachParallel(workQueue_, clientStates_, [&](unsigned, ClientReplicationState* clientState) { callback(clientState); });
+        else
+            ea::for_each(clientStates_.begin(), clientStates_.end(), callback);
+    };
+
+    forEachClient([&](ClientReplicationState* clientState) { clientState->UpdateNetworkObjects(*sharedState_); });
+    for (ClientReplicationState* clientState : clientStates_)
+        clientState->QueueDeltaUpdates(*sharedState_);
     sharedState_->CookDeltaUpdates(currentFrame_);
 
+    // Transport is not thread-safe, so messages are passed to it from main thread
+    if (workQueue_)
+    {
+        for (auto& [connection, clientState] : connections_)
+            connection->BeginDeferredSend();
+    }
+
+    forEachClient([&](ClientReplicationState* clientState) { clientState->SendMessages(currentFrame_, *sharedState_); });
+
+    if (workQueue_)
+    {
+        for (auto& [connection, clientState] : connections_)
+            connection->FlushDeferredMessages();
+    }
+}
+
+void ServerReplicator::ProvideJoinSnapshots()
+{
     for (auto& [connection, clientState] : connections_)
-        clientState->SendMessages(currentFrame_, *sharedState_);
+    {
+        if (!clientState->IsWaitingForJoinSnapshot())
+            continue;
+
+        // Snapshot is rebuilt only if it's too old, changes since then are replicated to the client as usual
+        const float snapshotInterval = GetSetting(NetworkSettings::JoinSnapshotInterval).GetFloat();
+        const auto maxSnapshotAge = static_cast<long long>(snapshotInterval * updateFrequency_);
+        if (!joinSnapshot_ || currentFrame_ - joinSnapshot_->GetFrame() > maxSnapshotAge)
+        {
+            URHO3D_PROFILE("BuildJoinSnapshot");
+            joinSnapshot_ = ea::make_shared<NetworkJoinSnapshot>(currentFrame_, sharedState_->GetSortedObjects());
+            URHO3D_LOGINFO("Join snapshot of {} objects is built: {} bytes, {} bytes uncompressed",
+                joinSnapshot_->GetNetworkIds().size(), joinSnapshot_->GetSize(), joinSnapshot_->GetUncompressedSize());
+        }
+
+        clientState->SetJoinSnapshot(joinSnapshot_);
+    }
 }
 
 void ServerReplicator::AddConnection(AbstractConnection* connection)
@@ -29,13 +29,20 @@
 #include "../IO/MemoryBuffer.h"
 #include "../IO/VectorBuffer.h"
 #include "../Network/ClockSynchronizer.h"
+#include "../Replica/BaselineCompression.h"
 #include "../Replica/ClientInputStatistics.h"
+#include "../Replica/JoinSnapshot.h"
+#include "../Replica/NetworkInterestGrid.h"
+#include "../Replica/NetworkPriorityAccumulator.h"
 #include "../Replica/NetworkId.h"
 #include "../Replica/TickSynchronizer.h"
 #include "../Replica/ProtocolMessages.h"
 
+#include <EASTL/array.h>
 #include <EASTL/bitvector.h>
 #include <EASTL/optional.h>
+#include <EASTL/shared_ptr.h>
+#include <EASTL/unique_ptr.h>
 #include <EASTL/vector.h>
 #include <EASTL/bonus/ring_buffer.h>
 
@@ -43,11 +50,13 @@ namespace Urho3D
 {
 
 class AbstractConnection;
+class LagCompensation;
 class Network;
 class NetworkObject;
 class NetworkObjectRegistry;
 class ReplicationManager;
 class Scene;
+class WorkQueue;
 struct NetworkSetting;
 
 /// Replication state shared between all clients.
@@ -62,6 +71,8 @@ public:
     void QueueDeltaUpdate(NetworkObject* networkObject);
     /// Cook all requested delta updates.
     void CookDeltaUpdates(NetworkFrame currentFrame);
+    /// Enable interest grid. Clients will only consider objects within the radius from the objects they own.
+    void EnableInterestGrid(float cellSize, float radius);
 
     /// Return state of the current frame.
     /// @{
@@ -71,6 +82,10 @@ public:
     const ea::unordered_set<NetworkObject*>& GetOwnedObjectsByConnection(AbstractConnection* connection) const;
     ea::optional<ConstByteSpan> GetReliableUpdateByIndex(unsigned index) const;
     ea::optional<ConstByteSpan> GetUnreliableUpdateByIndex(unsigned index) const;
+    const NetworkInterestGrid* GetInterestGrid() const { return interestGrid_.get(); }
+    float GetInterestRadius() const { return interestRadius_; }
+    const ea::vector<unsigned>& GetGlobalObjects() const { return globalObjects_; }
+    unsigned GetSortedOrderByIndex(unsigned index) const { return sortedOrder_[index]; }
     /// @}
 
 private:
@@ -86,6 +101,7 @@ private:
 
     void ResetFrameBuffers();
     void InitializeNewObjects();
+    void UpdateInterestGrid();
 
     ConstByteSpan GetSpanData(const DeltaBufferSpan& span) const;
 
@@ -105,6 +121,14 @@ private:
     ea::vector<DeltaBufferSpan> unreliableDeltaUpdateData_;
 
     ea::unordered_map<AbstractConnection*, ea::unordered_set<NetworkObject*>> ownedObjectsByConnection_;
+
+    /// Interest management, optional.
+    /// @{
+    ea::unique_ptr<NetworkInterestGrid> interestGrid_;
+    float interestRadius_{};
+    ea::vector<unsigned> globalObjects_;
+    ea::vector<unsigned> sortedOrder_;
+    /// @}
 };
 
 /// Clock synchronization state specific to individual client connection.
@@ -147,6 +171,9 @@ private:
 
     static constexpr unsigned InputStatsSafetyLimit = 64;
 
+    /// Magic is generated in advance because messages may be sent from worker thread.
+    const unsigned configurationMagic_{};
+
     ea::optional<unsigned> synchronizationMagic_;
     bool synchronized_{};
 
@@ -172,7 +199,10 @@ public:
         NetworkObjectRegistry* objectRegistry, AbstractConnection* connection, const VariantMap& settings);
 
     /// Perform network update from the perspective of this client connection.
-    void UpdateNetworkObjects(SharedReplicationState& sharedState);
+    /// May be called from worker thread, object updates are queued separately.
+    void UpdateNetworkObjects(const SharedReplicationState& sharedState);
+    /// Queue delta updates of objects replicated to this client.
+    void QueueDeltaUpdates(SharedReplicationState& sharedState) const;
 
     /// Process messages for this client.
     bool ProcessMessage(NetworkMessageId messageId, MemoryBuffer& messageData);
@@ -185,12 +215,28 @@ public:
     float GetReportedInputLoss() const { return reportedLoss_;}
     /// @}
 
+    /// Join snapshot is streamed to synchronized client before any other objects are replicated.
+    /// @{
+    bool IsWaitingForJoinSnapshot() const;
+    void SetJoinSnapshot(const ea::shared_ptr<const NetworkJoinSnapshot>& joinSnapshot) { joinSnapshot_ = joinSnapshot; }
+    /// @}
+
 private:
     void ProcessObjectsFeedbackUnreliable(MemoryBuffer& messageData);
+    void ProcessJoinSnapshotAck(MemoryBuffer& messageData);
+    void SendJoinSnapshot();
+    void ApplyJoinSnapshot(const NetworkInterestGrid* interestGrid);
     void SendRemoveObjects();
     void SendAddObjects();
     void SendUpdateObjectsReliable(const SharedReplicationState& sharedState);
     void SendUpdateObjectsUnreliable(NetworkFrame currentFrame, const SharedReplicationState& sharedState);
+    void SelectUnreliableUpdates(NetworkFrame currentFrame, const SharedReplicationState& sharedState);
+    void SelectUnreliableUpdatesInBudget(NetworkFrame currentFrame, const SharedReplicationState& sharedState);
+    void WriteUnreliableUpdates(const SharedReplicationState& sharedState);
+    void WriteUnreliableUpdatesWithBaselines(const SharedReplicationState& sharedState);
+    void ResetObjectBaseline(unsigned index, NetworkId networkId);
+    void ProcessUnreliableUpdatesAck(unsigned short sequence);
+    void UpdateInterestArea(const SharedReplicationState& sharedState, const NetworkInterestGrid& interestGrid);
 
     ea::vector<NetworkObjectRelevance> objectsRelevance_;
     ea::vector<float> objectsRelevanceTimeouts_;
@@ -198,6 +244,66 @@ private:
     ea::vector<NetworkId> pendingRemovedObjects_;
     ea::vector<ea::pair<NetworkObject*, bool>> pendingUpdatedObjects_;
 
+    /// Unreliable updates scheduling, accumulator is used only if connection bandwidth is limited.
+    /// @{
+    NetworkPriorityAccumulator priorityAccumulator_;
+    ea::vector<NetworkFrame> objectsLastUnreliableFrames_;
+    ea::vector<unsigned> unreliableUpdateIndices_;
+    /// @}
+
+    /// Baseline compression of unreliable updates.
+    /// @{
+    struct ObjectBaseline
+    {
+        NetworkId networkId_{};
+        /// Updates sent before this frame are not baselines, e.g. if the object was re-added.
+        NetworkFrame resetFrame_{};
+        /// Latest acknowledged update, if any.
+        NetworkFrame frame_{};
+        ByteVector data_;
+    };
+
+    struct SentUnreliableUpdate
+    {
+        unsigned index_{};
+        NetworkId networkId_{};
+        unsigned offset_{};
+        unsigned size_{};
+    };
+
+    struct SentUnreliableMessage
+    {
+        unsigned short sequence_{};
+        bool isPending_{};
+        NetworkFrame frame_{};
+        ea::vector<SentUnreliableUpdate> updates_;
+        ByteVector data_;
+    };
+
+    static constexpr unsigned MaxSentUnreliableMessages = 64;
+
+    bool baselineCompression_{};
+    unsigned short nextUnreliableSequence_{};
+    ea::vector<ObjectBaseline> objectBaselines_;
+    ea::array<SentUnreliableMessage, MaxSentUnreliableMessages> sentUnreliableMessages_;
+    ByteVector baselineDelta_;
+    /// @}
+
+    /// Join snapshot streaming.
+    /// @{
+    bool joinSnapshotEnabled_{};
+    ea::shared_ptr<const NetworkJoinSnapshot> joinSnapshot_;
+    unsigned joinSnapshotSentSize_{};
+    unsigned joinSnapshotAckedSize_{};
+    bool isJoinSnapshotLoaded_{};
+    bool isJoinSnapshotApplied_{};
+    /// @}
+
+    NetworkInterestArea interestArea_;
+    ea::vector<Vector3> interestCenters_;
+    ea::vector<unsigned> interestedIndices_;
+    ea::vector<NetworkObject*> interestedObjects_;
+
     VectorBuffer componentBuffer_;
 
     float reportedLoss_{};
@@ -230,11 +336,16 @@ public:
     NetworkTime GetServerTime() const { return NetworkTime{currentFrame_}; }
     unsigned GetUpdateFrequency() const { return updateFrequency_; }
     NetworkFrame GetCurrentFrame() const { return currentFrame_; }
+    /// Return history of hitboxes if lag compensation is enabled in ReplicationManager.
+    const LagCompensation* GetLagCompensation() const { return lagCompensation_.get(); }
+    /// Return latest join snapshot if it's enabled in ReplicationManager and was requested by any client.
+    const NetworkJoinSnapshot* GetJoinSnapshot() const { return joinSnapshot_.get(); }
     /// @}
 
 private:
     void OnInputReady(float timeStep, bool isUpdateNow, float overtime);
     void OnNetworkUpdate();
+    void ProvideJoinSnapshots();
 
     ClientReplicationState* GetClientState(AbstractConnection* connection) const;
 
@@ -251,6 +362,15 @@ private:
 
     SharedPtr<SharedReplicationState> sharedState_;
     ea::unordered_map<AbstractConnection*, SharedPtr<ClientReplicationState>> connections_;
+
+    /// Work queue used to process clients in parallel, if enabled.
+    WorkQueue* workQueue_{};
+    ea::vector<ClientReplicationState*> clientStates_;
+
+    ea::unique_ptr<LagCompensation> lagCompensation_;
+
+    /// Join snapshot shared between all clients joining while it's fresh.
+    ea::shared_ptr<const NetworkJoinSnapshot> joinSnapshot_;
 };
 
 }
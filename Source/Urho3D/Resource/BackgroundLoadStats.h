@@ -0,0 +1,40 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Urho3D.h"
+
+#include <EASTL/array.h>
+
+namespace Urho3D
+{
+
+/// Statistics of background resource loading.
+struct URHO3D_API BackgroundLoadStats
+{
+    /// Number of latency histogram buckets.
+    static constexpr unsigned NumLatencyBuckets = 12;
+
+    /// Number of resources finished successfully.
+    unsigned numLoaded_{};
+    /// Number of resources failed to load.
+    unsigned numFailed_{};
+    /// Number of cancelled resources.
+    unsigned numCancelled_{};
+    /// Total time spent in Resource::BeginLoad on all threads, in microseconds.
+    long long loadTime_{};
+    /// Time between the first queued and the last finished resource, in microseconds.
+    long long elapsedTime_{};
+    /// Histogram of latency between queueing and finishing of a resource.
+    /// Bucket N counts resources finished in less than 2^N milliseconds, the last bucket counts all the rest.
+    ea::array<unsigned, NumLatencyBuckets> latencyHistogram_{};
+
+    /// Return number of finished resources per second.
+    float GetThroughput() const;
+    /// Return latency in milliseconds that is not exceeded by given fraction of resources, rounded up to the bucket.
+    unsigned GetLatencyPercentile(float fraction) const;
+};
+
+} // namespace Urho3D
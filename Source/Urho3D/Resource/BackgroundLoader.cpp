@@ -24,16 +24,46 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/Thread.h"
+#include "../Core/WorkQueue.h"
 #include "../IO/Log.h"
 #include "../Resource/BackgroundLoader.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/ResourceEvents.h"
 
+#include <EASTL/heap.h>
+#include <EASTL/sort.h>
+
 #include "../DebugNew.h"
 
 namespace Urho3D
 {
 
+float BackgroundLoadStats::GetThroughput() const
+{
+    const unsigned numFinished = numLoaded_ + numFailed_;
+    return elapsedTime_ > 0 ? numFinished * 1000000.0f / elapsedTime_ : 0.0f;
+}
+
+unsigned BackgroundLoadStats::GetLatencyPercentile(float fraction) const
+{
+    unsigned total = 0;
+    for (unsigned count : latencyHistogram_)
+        total += count;
+    if (total == 0)
+        return 0;
+
+    const unsigned threshold = Max(1u, static_cast<unsigned>(CeilToInt(total * Clamp(fraction, 0.0f, 1.0f))));
+    unsigned accumulated = 0;
+    for (unsigned i = 0; i + 1 < NumLatencyBuckets; ++i)
+    {
+        accumulated += latencyHistogram_[i];
+        if (accumulated >= threshold)
+            return 1u << i;
+    }
+    return M_MAX_UNSIGNED;
+}
+
 #ifdef URHO3D_BACKGROUND_LOADER
 
 BackgroundLoader::BackgroundLoader(ResourceCache* owner) :
@@ -43,89 +73,63 @@ BackgroundLoader::BackgroundLoader(ResourceCache* owner) :
 
 BackgroundLoader::~BackgroundLoader()
 {
-    MutexLock lock(backgroundLoadMutex_);
-
-    backgroundLoadQueue_.clear();
+    Shutdown();
 }
 
-void BackgroundLoader::ThreadFunction()
+void BackgroundLoader::Shutdown()
 {
-    URHO3D_PROFILE_THREAD("BackgroundLoader Thread");
+    shutdown_ = true;
 
-    while (shouldRun_)
+    // Resources that are being loaded by worker threads may access the owner, wait for them
+    for (;;)
     {
-        backgroundLoadMutex_.Acquire();
-
-        // Search for a queued resource that has not been loaded yet
-        auto i = backgroundLoadQueue_.begin();
-        while (i != backgroundLoadQueue_.end())
         {
-            if (i->second.resource_->GetAsyncLoadState() == ASYNC_QUEUED)
-                break;
-            else
-                ++i;
-        }
-
-        if (i == backgroundLoadQueue_.end())
-        {
-            // No resources to load found
-            backgroundLoadMutex_.Release();
-            Time::Sleep(5);
-        }
-        else
-        {
-            BackgroundLoadItem& item = i->second;
-            Resource* resource = item.resource_;
-            // We can be sure that the item is not removed from the queue as long as it is in the
-            // "queued" or "loading" state
-            backgroundLoadMutex_.Release();
-
-            bool success = false;
-            AbstractFilePtr file = owner_->GetFile(resource->GetName(), item.sendEventOnFailure_);
-            if (file)
-            {
-                resource->SetAsyncLoadState(ASYNC_LOADING);
-                success = resource->BeginLoad(*file);
-            }
-
-            // Process dependencies now
-            // Need to lock the queue again when manipulating other entries
-            ea::pair<StringHash, StringHash> key = ea::make_pair(resource->GetType(), resource->GetNameHash());
-            backgroundLoadMutex_.Acquire();
-            if (item.dependents_.size())
+            MutexLock lock(backgroundLoadMutex_);
+            if (numRunningTasks_ == 0)
             {
-                for (auto i = item.dependents_.begin(); i != item.dependents_.end(); ++i)
-                {
-                    auto j = backgroundLoadQueue_.find(*i);
-                    if (j != backgroundLoadQueue_.end())
-                        j->second.dependencies_.erase(key);
-                }
-
-                item.dependents_.clear();
+                backgroundLoadQueue_.clear();
+                priorityQueue_.clear();
+                numQueuedResources_ = 0;
+                break;
             }
-
-            resource->SetAsyncLoadState(success ? ASYNC_SUCCESS : ASYNC_FAIL);
-            backgroundLoadMutex_.Release();
         }
+        Time::Sleep(1);
     }
 }
 
-bool BackgroundLoader::QueueResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller)
+bool BackgroundLoader::QueueResource(StringHash type, const ea::string& name, bool sendEventOnFailure,
+    Resource* caller, float priority, Resource* existingResource)
 {
     StringHash nameHash(name);
     ea::pair<StringHash, StringHash> key = ea::make_pair(type, nameHash);
 
     MutexLock lock(backgroundLoadMutex_);
 
-    // Check if already exists in the queue
-    if (backgroundLoadQueue_.find(key) != backgroundLoadQueue_.end())
+    if (shutdown_)
         return false;
 
+    // Check if already exists in the queue. Raise priority if needed
+    const auto existing = backgroundLoadQueue_.find(key);
+    if (existing != backgroundLoadQueue_.end())
+    {
+        BackgroundLoadItem& existingItem = existing->second;
+        if (existingItem.resource_->GetAsyncLoadState() == ASYNC_QUEUED && priority > existingItem.priority_)
+        {
+            existingItem.priority_ = priority;
+            PushQueueEntry(key, priority);
+        }
+        return false;
+    }
+
     BackgroundLoadItem& item = backgroundLoadQueue_[key];
     item.sendEventOnFailure_ = sendEventOnFailure;
+    item.restore_ = existingResource != nullptr;
 
     // Make sure the pointer is non-null and is a Resource subclass
-    item.resource_ = DynamicCast<Resource>(owner_->GetContext()->CreateObject(type));
+    if (existingResource)
+        item.resource_ = existingResource;
+    else
+        item.resource_ = DynamicCast<Resource>(owner_->GetContext()->CreateObject(type));
     if (!item.resource_)
     {
         URHO3D_LOGERROR("Could not load unknown resource type " + type.ToString());
@@ -143,7 +147,7 @@ bool BackgroundLoader::QueueResource(StringHash type, const ea::string& name, bo
         return false;
     }
 
-    URHO3D_LOGDEBUG("Background loading resource " + name);
+    URHO3D_LOGDEBUG("Background {} resource {}", item.restore_ ? "restoring" : "loading", name);
 
     item.resource_->SetName(name);
     item.resource_->SetAsyncLoadState(ASYNC_QUEUED);
@@ -159,15 +163,66 @@ bool BackgroundLoader::QueueResource(StringHash type, const ea::string& name, bo
             BackgroundLoadItem& callerItem = j->second;
             item.dependents_.insert(callerKey);
             callerItem.dependencies_.insert(key);
+            // Dependency blocks the caller, so it should be loaded at least as soon
+            priority = Max(priority, callerItem.priority_);
         }
         else
             URHO3D_LOGWARNING("Resource " + caller->GetName() +
                        " requested for a background loaded resource but was not in the background load queue");
     }
 
-    // Start the background loader thread now
-    if (!IsStarted())
-        Run();
+    item.priority_ = priority;
+    item.queueTime_ = GetTime();
+    if (firstQueueTime_ < 0)
+        firstQueueTime_ = item.queueTime_;
+
+    ++numQueuedResources_;
+    PushQueueEntry(key, priority);
+    DispatchTasks();
+
+    return true;
+}
+
+bool BackgroundLoader::SetPriority(StringHash type, StringHash nameHash, float priority)
+{
+    const ResourceKey key{type, nameHash};
+
+    MutexLock lock(backgroundLoadMutex_);
+
+    const auto iter = backgroundLoadQueue_.find(key);
+    if (iter == backgroundLoadQueue_.end())
+        return false;
+
+    BackgroundLoadItem& item = iter->second;
+    if (item.resource_->GetAsyncLoadState() != ASYNC_QUEUED)
+        return false;
+
+    if (item.priority_ != priority)
+    {
+        item.priority_ = priority;
+        PushQueueEntry(key, priority);
+    }
+    return true;
+}
+
+bool BackgroundLoader::CancelResource(StringHash type, StringHash nameHash)
+{
+    const ResourceKey key{type, nameHash};
+
+    MutexLock lock(backgroundLoadMutex_);
+
+    const auto iter = backgroundLoadQueue_.find(key);
+    if (iter == backgroundLoadQueue_.end() || iter->second.cancelled_)
+        return false;
+
+    ++stats_.numCancelled_;
+
+    // Resource that is being loaded is discarded when loading is complete
+    BackgroundLoadItem& item = iter->second;
+    if (item.resource_->GetAsyncLoadState() == ASYNC_LOADING)
+        item.cancelled_ = true;
+    else
+        RemoveResource(key);
 
     return true;
 }
@@ -179,88 +234,304 @@ void BackgroundLoader::WaitForResource(StringHash type, StringHash nameHash)
     // Check if the resource in question is being background loaded
     ea::pair<StringHash, StringHash> key = ea::make_pair(type, nameHash);
     auto i = backgroundLoadQueue_.find(key);
-    if (i != backgroundLoadQueue_.end())
+    if (i == backgroundLoadQueue_.end())
     {
         backgroundLoadMutex_.Release();
+        return;
+    }
 
-        {
-            Resource* resource = i->second.resource_;
-            HiresTimer waitTimer;
-            bool didWait = false;
+    BackgroundLoadItem& item = i->second;
+    Resource* resource = item.resource_;
+    HiresTimer waitTimer;
+    bool didWait = false;
 
-            for (;;)
-            {
-                unsigned numDeps = i->second.dependencies_.size();
-                AsyncLoadState state = resource->GetAsyncLoadState();
-                if (numDeps > 0 || state == ASYNC_QUEUED || state == ASYNC_LOADING)
-                {
-                    didWait = true;
-                    Time::Sleep(1);
-                }
-                else
-                    break;
-            }
+    for (;;)
+    {
+        const AsyncLoadState state = resource->GetAsyncLoadState();
+
+        // Load the resource or its dependencies right away if they are not picked up by worker threads yet
+        BackgroundLoadItem* itemToLoad = state == ASYNC_QUEUED ? &item : nullptr;
+        for (auto j = item.dependencies_.begin(); !itemToLoad && j != item.dependencies_.end(); ++j)
+        {
+            auto dependency = backgroundLoadQueue_.find(*j);
+            if (dependency != backgroundLoadQueue_.end()
+                && dependency->second.resource_->GetAsyncLoadState() == ASYNC_QUEUED)
+                itemToLoad = &dependency->second;
+        }
 
-            if (didWait)
-                URHO3D_LOGDEBUG("Waited " + ea::to_string(waitTimer.GetUSec(false) / 1000) + " ms for background loaded resource " +
-                         resource->GetName());
+        if (itemToLoad)
+        {
+            ClaimResource(*itemToLoad);
+            backgroundLoadMutex_.Release();
+            LoadResource(*itemToLoad);
+            backgroundLoadMutex_.Acquire();
+            continue;
         }
 
-        // This may take a long time and may potentially wait on other resources, so it is important we do not hold the mutex during this
-        FinishBackgroundLoading(i->second);
+        if (item.dependencies_.empty() && state != ASYNC_LOADING)
+            break;
 
-        backgroundLoadMutex_.Acquire();
-        // Erasing by key since queue may change since iterator been acquired.
-        backgroundLoadQueue_.erase(key);
         backgroundLoadMutex_.Release();
+        didWait = true;
+        Time::Sleep(1);
+        backgroundLoadMutex_.Acquire();
     }
-    else
-        backgroundLoadMutex_.Release();
+
+    backgroundLoadMutex_.Release();
+
+    if (didWait)
+        URHO3D_LOGDEBUG("Waited " + ea::to_string(waitTimer.GetUSec(false) / 1000) + " ms for background loaded resource " +
+                 resource->GetName());
+
+    // This may take a long time and may potentially wait on other resources, so it is important we do not hold the mutex during this
+    if (!item.cancelled_)
+        FinishBackgroundLoading(item);
+
+    MutexLock lock(backgroundLoadMutex_);
+    // Erasing by key since queue may change since iterator been acquired.
+    RemoveResource(key);
 }
 
 void BackgroundLoader::FinishResources(int maxMs)
 {
-    if (IsStarted())
+    HiresTimer timer;
+    const long long maxUSec = maxMs * 1000LL;
+
+    // Without worker threads, resources are loaded here within the same time budget
+    if (!GetWorkerQueue())
     {
-        HiresTimer timer;
+        for (;;)
+        {
+            backgroundLoadMutex_.Acquire();
+            BackgroundLoadItem* item = !shutdown_ ? TakeQueuedResource() : nullptr;
+            backgroundLoadMutex_.Release();
 
-        backgroundLoadMutex_.Acquire();
+            if (!item)
+                break;
+
+            LoadResource(*item);
+            if (timer.GetUSec(false) >= maxUSec)
+                break;
+        }
+    }
+
+    // Collect resources that are ready to finish, higher priority first
+    {
+        MutexLock lock(backgroundLoadMutex_);
 
-        for (auto i = backgroundLoadQueue_.begin(); i != backgroundLoadQueue_.end();
-             i = backgroundLoadQueue_.begin())
+        readyResources_.clear();
+        for (const auto& [key, item] : backgroundLoadQueue_)
         {
-            const auto key = i->first;
-            Resource* resource = i->second.resource_;
-            unsigned numDeps = i->second.dependencies_.size();
-            AsyncLoadState state = resource->GetAsyncLoadState();
-            if (numDeps > 0 || state == ASYNC_QUEUED || state == ASYNC_LOADING)
-                ++i;
-            else
-            {
-                // Finishing a resource may need it to wait for other resources to load, in which case we can not
-                // hold on to the mutex
-                backgroundLoadMutex_.Release();
-                FinishBackgroundLoading(i->second);
-                backgroundLoadMutex_.Acquire();
-                // Erasing by key because the queue may change since last time
-                backgroundLoadQueue_.erase(key);
-            }
+            const AsyncLoadState state = item.resource_->GetAsyncLoadState();
+            if (item.dependencies_.empty() && (state == ASYNC_SUCCESS || state == ASYNC_FAIL))
+                readyResources_.emplace_back(item.priority_, key);
+        }
+    }
 
-            // Break when the time limit passed so that we keep sufficient FPS
-            if (timer.GetUSec(false) >= maxMs * 1000LL)
-                break;
+    ea::stable_sort(readyResources_.begin(), readyResources_.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+    for (const auto& [priority, key] : readyResources_)
+    {
+        backgroundLoadMutex_.Acquire();
+        const auto i = backgroundLoadQueue_.find(key);
+        if (i == backgroundLoadQueue_.end())
+        {
+            backgroundLoadMutex_.Release();
+            continue;
         }
 
+        // Finishing a resource may need it to wait for other resources to load, in which case we can not
+        // hold on to the mutex
+        BackgroundLoadItem& item = i->second;
+        backgroundLoadMutex_.Release();
+
+        if (!item.cancelled_)
+            FinishBackgroundLoading(item);
+
+        backgroundLoadMutex_.Acquire();
+        // Erasing by key because the queue may change since last time
+        RemoveResource(key);
         backgroundLoadMutex_.Release();
+
+        // Break when the time limit passed so that we keep sufficient FPS
+        if (timer.GetUSec(false) >= maxUSec)
+            break;
     }
 }
 
+void BackgroundLoader::SetMaxConcurrentLoads(unsigned count)
+{
+    MutexLock lock(backgroundLoadMutex_);
+    maxConcurrentLoads_ = count;
+    DispatchTasks();
+}
+
 unsigned BackgroundLoader::GetNumQueuedResources() const
 {
     MutexLock lock(backgroundLoadMutex_);
     return backgroundLoadQueue_.size();
 }
 
+BackgroundLoadStats BackgroundLoader::GetStats() const
+{
+    MutexLock lock(backgroundLoadMutex_);
+    return stats_;
+}
+
+void BackgroundLoader::ResetStats()
+{
+    MutexLock lock(backgroundLoadMutex_);
+    stats_ = {};
+    firstQueueTime_ = backgroundLoadQueue_.empty() ? -1 : GetTime();
+}
+
+WorkQueue* BackgroundLoader::GetWorkerQueue() const
+{
+    auto workQueue = owner_->GetSubsystem<WorkQueue>();
+    return workQueue && workQueue->IsMultithreaded() ? workQueue : nullptr;
+}
+
+void BackgroundLoader::PushQueueEntry(const ResourceKey& key, float priority)
+{
+    priorityQueue_.push_back(QueueEntry{priority, nextOrder_++, key});
+    ea::push_heap(priorityQueue_.begin(), priorityQueue_.end());
+}
+
+BackgroundLoadItem* BackgroundLoader::TakeQueuedResource()
+{
+    while (!priorityQueue_.empty())
+    {
+        ea::pop_heap(priorityQueue_.begin(), priorityQueue_.end());
+        const QueueEntry entry = priorityQueue_.back();
+        priorityQueue_.pop_back();
+
+        // Skip entries of resources that are already loaded, removed or re-prioritized
+        const auto i = backgroundLoadQueue_.find(entry.key_);
+        if (i == backgroundLoadQueue_.end())
+            continue;
+
+        BackgroundLoadItem& item = i->second;
+        if (item.resource_->GetAsyncLoadState() != ASYNC_QUEUED || item.priority_ != entry.priority_)
+            continue;
+
+        ClaimResource(item);
+        return &item;
+    }
+    return nullptr;
+}
+
+void BackgroundLoader::ClaimResource(BackgroundLoadItem& item)
+{
+    item.resource_->SetAsyncLoadState(ASYNC_LOADING);
+
+    // Drop outdated entries when nothing is left to load
+    if (--numQueuedResources_ == 0)
+        priorityQueue_.clear();
+}
+
+void BackgroundLoader::DispatchTasks()
+{
+    if (shutdown_)
+        return;
+
+    WorkQueue* workQueue = GetWorkerQueue();
+    if (!workQueue)
+        return;
+
+    const unsigned maxLoads = maxConcurrentLoads_ != 0 ? maxConcurrentLoads_ : workQueue->GetNumProcessingThreads() - 1;
+    while (numPendingTasks_ < numQueuedResources_ && numPendingTasks_ + numRunningTasks_ < maxLoads)
+    {
+        // Task picks the resource when started, so priority changes are respected until the last moment
+        ++numPendingTasks_;
+        workQueue->PostTask([self = SharedPtr<BackgroundLoader>(this)](unsigned, WorkQueue*) { self->ProcessTask(); },
+            TaskPriority::Low);
+    }
+}
+
+void BackgroundLoader::ProcessTask()
+{
+    URHO3D_PROFILE("BackgroundLoadResource");
+
+    BackgroundLoadItem* item = nullptr;
+    {
+        MutexLock lock(backgroundLoadMutex_);
+        --numPendingTasks_;
+        if (shutdown_)
+            return;
+
+        // We can be sure that the item is not removed from the queue as long as it is in the "loading" state
+        item = TakeQueuedResource();
+        if (!item)
+            return;
+        ++numRunningTasks_;
+    }
+
+    LoadResource(*item);
+
+    MutexLock lock(backgroundLoadMutex_);
+    --numRunningTasks_;
+    DispatchTasks();
+}
+
+void BackgroundLoader::LoadResource(BackgroundLoadItem& item)
+{
+    Resource* resource = item.resource_;
+    const long long startTime = GetTime();
+
+    bool success = false;
+    AbstractFilePtr file = owner_->GetFile(resource->GetName(), item.sendEventOnFailure_);
+    if (file)
+        success = resource->BeginLoad(*file);
+
+    const long long loadTime = GetTime() - startTime;
+
+    // Process dependencies now
+    // Need to lock the queue again when manipulating other entries
+    ea::pair<StringHash, StringHash> key = ea::make_pair(resource->GetType(), resource->GetNameHash());
+    MutexLock lock(backgroundLoadMutex_);
+    for (auto i = item.dependents_.begin(); i != item.dependents_.end(); ++i)
+    {
+        auto j = backgroundLoadQueue_.find(*i);
+        if (j != backgroundLoadQueue_.end())
+            j->second.dependencies_.erase(key);
+    }
+    item.dependents_.clear();
+
+    stats_.loadTime_ += loadTime;
+    resource->SetAsyncLoadState(success ? ASYNC_SUCCESS : ASYNC_FAIL);
+}
+
+void BackgroundLoader::RemoveResource(const ResourceKey& key)
+{
+    const auto i = backgroundLoadQueue_.find(key);
+    if (i == backgroundLoadQueue_.end())
+        return;
+
+    BackgroundLoadItem& item = i->second;
+    if (item.resource_->GetAsyncLoadState() == ASYNC_QUEUED && --numQueuedResources_ == 0)
+        priorityQueue_.clear();
+
+    // Restored resource stays in the cache even if loading was cancelled
+    if (item.restore_)
+        item.resource_->SetAsyncLoadState(ASYNC_DONE);
+
+    for (const ResourceKey& dependentKey : item.dependents_)
+    {
+        auto j = backgroundLoadQueue_.find(dependentKey);
+        if (j != backgroundLoadQueue_.end())
+            j->second.dependencies_.erase(key);
+    }
+    for (const ResourceKey& dependencyKey : item.dependencies_)
+    {
+        auto j = backgroundLoadQueue_.find(dependencyKey);
+        if (j != backgroundLoadQueue_.end())
+            j->second.dependents_.erase(key);
+    }
+
+    backgroundLoadQueue_.erase(i);
+}
+
 void BackgroundLoader::FinishBackgroundLoading(BackgroundLoadItem& item)
 {
     Resource* resource = item.resource_;
@@ -276,6 +547,11 @@ void BackgroundLoader::FinishBackgroundLoading(BackgroundLoadItem& item)
     }
     resource->SetAsyncLoadState(ASYNC_DONE);
 
+    {
+        MutexLock lock(backgroundLoadMutex_);
+        RecordFinished(item, success);
+    }
+
     if (!success && item.sendEventOnFailure_)
     {
         using namespace LoadFailed;
@@ -285,8 +561,11 @@ void BackgroundLoader::FinishBackgroundLoading(BackgroundLoadItem& item)
         owner_->SendEvent(E_LOADFAILED, eventData);
     }
 
-    // Store to the cache just before sending the event; use same mechanism as for manual resources
-    if (success || owner_->GetReturnFailedResources())
+    // Store to the cache just before sending the event; use same mechanism as for manual resources.
+    // Restored resource is already in the cache
+    if (item.restore_)
+        owner_->FinishRestoreResource(resource, success);
+    else if (success || owner_->GetReturnFailedResources())
         owner_->AddManualResource(resource);
 
     // Send event, either success or failure
@@ -301,6 +580,29 @@ void BackgroundLoader::FinishBackgroundLoading(BackgroundLoadItem& item)
     }
 }
 
+void BackgroundLoader::RecordFinished(const BackgroundLoadItem& item, bool success)
+{
+    const long long currentTime = GetTime();
+    if (success)
+        ++stats_.numLoaded_;
+    else
+        ++stats_.numFailed_;
+
+    const long long latencyMs = (currentTime - item.queueTime_) / 1000;
+    unsigned bucket = 0;
+    while (bucket + 1 < BackgroundLoadStats::NumLatencyBuckets && latencyMs >= (1ll << bucket))
+        ++bucket;
+    ++stats_.latencyHistogram_[bucket];
+
+    if (firstQueueTime_ >= 0)
+        stats_.elapsedTime_ = currentTime - firstQueueTime_;
+}
+
+long long BackgroundLoader::GetTime() const
+{
+    return clock_.GetUSec(false);
+}
+
 #endif
 
 }
@@ -24,14 +24,17 @@
 
 #include <EASTL/hash_set.h>
 #include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
 
 #include "../Core/Mutex.h"
+#include "../Core/Timer.h"
 #include "../Container/Ptr.h"
-#include "../Core/Thread.h"
 #include "../Math/StringHash.h"
+#include "../Resource/BackgroundLoadStats.h"
+
+#include <atomic>
 
 // BackgroundLoader is not supported for Web now.
-// TODO: Migrate BackgroundLoader to WorkQueue and avoid this extra toggle
 #if defined(URHO3D_THREADING) && !defined(URHO3D_PLATFORM_WEB)
     #define URHO3D_BACKGROUND_LOADER
 #endif
@@ -42,6 +45,7 @@ namespace Urho3D
 
 class Resource;
 class ResourceCache;
+class WorkQueue;
 
 /// Queue item for background loading of a resource.
 struct URHO3D_API BackgroundLoadItem
@@ -54,11 +58,21 @@ struct URHO3D_API BackgroundLoadItem
     ea::hash_set<ea::pair<StringHash, StringHash> > dependents_;
     /// Whether to send failure event.
     bool sendEventOnFailure_;
+    /// Loading priority. Resources with higher priority are loaded and finished first.
+    float priority_{};
+    /// Whether the loading was cancelled while the resource was being loaded.
+    bool cancelled_{};
+    /// Whether the resource is already in the cache and its released data is being loaded.
+    bool restore_{};
+    /// Time when the resource was queued, in microseconds.
+    long long queueTime_{};
 };
 
 /// Background loader of resources. Owned by the ResourceCache.
+/// Resources are loaded by WorkQueue worker threads in the order of priority.
+/// If WorkQueue has no worker threads, resources are loaded on the main thread within the finish time budget.
 /// @nobind
-class URHO3D_API BackgroundLoader : public RefCounted, public Thread
+class URHO3D_API BackgroundLoader : public RefCounted
 {
 public:
     /// Construct.
@@ -67,22 +81,73 @@ public:
     /// Destruct. Forcibly clear the load queue.
     ~BackgroundLoader() override;
 
-    /// Resource background loading loop.
-    void ThreadFunction() override;
+    /// Stop loading and wait for completion of resources that are being loaded. Should be called before owner is destroyed.
+    void Shutdown();
 
     /// Queue loading of a resource. The name must be sanitated to ensure consistent format. Return true if queued (not a duplicate and resource was a known type).
-    bool QueueResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller);
+    /// If existing resource is specified, its data released due to memory budget is loaded instead of creating new resource.
+    bool QueueResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller,
+        float priority = 0.0f, Resource* existingResource = nullptr);
+    /// Change priority of the resource that is not loaded yet. Return true if the resource is still queued.
+    bool SetPriority(StringHash type, StringHash nameHash, float priority);
+    /// Cancel loading of a resource. Resource will not be stored in the cache and no events will be sent. Return true if cancelled.
+    bool CancelResource(StringHash type, StringHash nameHash);
     /// Wait and finish possible loading of a resource when being requested from the cache.
     void WaitForResource(StringHash type, StringHash nameHash);
     /// Process resources that are ready to finish.
     void FinishResources(int maxMs);
 
+    /// Set maximum number of resources loaded simultaneously. Zero means the number of WorkQueue worker threads.
+    void SetMaxConcurrentLoads(unsigned count);
+    /// Return maximum number of resources loaded simultaneously.
+    unsigned GetMaxConcurrentLoads() const { return maxConcurrentLoads_; }
+
     /// Return amount of resources in the load queue.
     unsigned GetNumQueuedResources() const;
+    /// Return loading statistics.
+    BackgroundLoadStats GetStats() const;
+    /// Reset loading statistics.
+    void ResetStats();
 
 private:
+    using ResourceKey = ea::pair<StringHash, StringHash>;
+
+    /// Entry of the priority queue. Entries with outdated priority are skipped.
+    struct QueueEntry
+    {
+        float priority_{};
+        unsigned order_{};
+        ResourceKey key_;
+
+        /// Compare for max-heap: higher priority first, then first queued first.
+        bool operator<(const QueueEntry& rhs) const
+        {
+            return priority_ != rhs.priority_ ? priority_ < rhs.priority_ : order_ > rhs.order_;
+        }
+    };
+
+    /// Return WorkQueue if it has worker threads.
+    WorkQueue* GetWorkerQueue() const;
+    /// Push resource to the priority queue. Should be called under mutex.
+    void PushQueueEntry(const ResourceKey& key, float priority);
+    /// Take queued resource with the highest priority and mark it as loading. Should be called under mutex.
+    BackgroundLoadItem* TakeQueuedResource();
+    /// Mark queued resource as loading. Should be called under mutex.
+    void ClaimResource(BackgroundLoadItem& item);
+    /// Post loading tasks up to the concurrency limit. Should be called under mutex.
+    void DispatchTasks();
+    /// Load one resource with the highest priority. Called from worker threads.
+    void ProcessTask();
+    /// Execute BeginLoad of claimed resource. Should be called without mutex.
+    void LoadResource(BackgroundLoadItem& item);
+    /// Remove resource from the queue and unlink dependencies. Should be called under mutex.
+    void RemoveResource(const ResourceKey& key);
     /// Finish one background loaded resource.
     void FinishBackgroundLoading(BackgroundLoadItem& item);
+    /// Record finished resource in statistics. Should be called under mutex.
+    void RecordFinished(const BackgroundLoadItem& item, bool success);
+    /// Return current time in microseconds.
+    long long GetTime() const;
 
     /// Resource cache.
     ResourceCache* owner_;
@@ -90,6 +155,29 @@ private:
     mutable Mutex backgroundLoadMutex_;
     /// Resources that are queued for background loading.
     ea::unordered_map<ea::pair<StringHash, StringHash>, BackgroundLoadItem> backgroundLoadQueue_;
+    /// Max-heap of resources that are not loaded yet.
+    ea::vector<QueueEntry> priorityQueue_;
+    /// Order of the next queue entry.
+    unsigned nextOrder_{};
+    /// Number of resources that are not loaded yet.
+    unsigned numQueuedResources_{};
+    /// Number of tasks posted to WorkQueue but not started yet.
+    unsigned numPendingTasks_{};
+    /// Number of tasks that are loading resources.
+    unsigned numRunningTasks_{};
+    /// Maximum number of resources loaded simultaneously.
+    unsigned maxConcurrentLoads_{};
+    /// Whether the loader is shut down.
+    std::atomic<bool> shutdown_{};
+
+    /// Timer used for timestamps.
+    mutable HiresTimer clock_;
+    /// Loading statistics.
+    BackgroundLoadStats stats_;
+    /// Time when the first resource was queued since statistics reset, or -1.
+    long long firstQueueTime_{-1};
+    /// Temporary list of resources ready to finish.
+    ea::vector<ea::pair<float, ResourceKey>> readyResources_;
 };
 
 }
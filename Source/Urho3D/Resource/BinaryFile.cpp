@@ -67,6 +67,14 @@ bool BinaryFile::Save(Serializer& dest) const
     return true;
 }
 
+bool BinaryFile::ReleaseData()
+{
+    buffer_.Clear();
+    buffer_.GetBuffer().shrink_to_fit();
+    SetMemoryUse(0);
+    return true;
+}
+
 bool BinaryFile::SaveObjectCallback(const ea::function<void(Archive&)> serializeValue)
 {
     try
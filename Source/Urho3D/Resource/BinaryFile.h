@@ -51,6 +51,8 @@ public:
     bool BeginLoad(Deserializer& source) override;
     /// Save resource to a stream.
     bool Save(Serializer& dest) const override;
+    /// Release binary data.
+    bool ReleaseData() override;
 
     /// Save/load objects using Archive serialization.
     /// @{
@@ -631,6 +631,15 @@ bool Image::BeginLoad(Deserializer& source)
     return true;
 }
 
+bool Image::ReleaseData()
+{
+    data_.reset();
+    nextLevel_.Reset();
+    nextSibling_.Reset();
+    SetMemoryUse(0);
+    return true;
+}
+
 bool Image::Save(Serializer& dest) const
 {
     URHO3D_PROFILE("SaveImage");
@@ -74,6 +74,8 @@ public:
     bool BeginLoad(Deserializer& source) override;
     /// Save the image to a stream. Regardless of original format, the image is saved as png. Compressed image data is not supported. Return true if successful.
     bool Save(Serializer& dest) const override;
+    /// Release pixel data and mip levels. Image dimensions and format are kept.
+    bool ReleaseData() override;
     /// Save the image to a file. Format of the image is determined by file extension. JPG is saved with maximum quality.
     bool SaveFile(const FileIdentifier& fileName) const override;
 
@@ -33,6 +33,9 @@
 #include "../Resource/ResourceCache.h"
 
 #include <rapidjson/document.h>
+#include <rapidjson/encodedstream.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/prettywriter.h>
 
@@ -55,61 +58,136 @@ void JSONFile::RegisterObject(Context* context)
     context->AddFactoryReflection<JSONFile>();
 }
 
-// Convert rapidjson value to JSON value.
-static void ToJSONValue(JSONValue& jsonValue, const rapidjson::Value& rapidjsonValue)
+/// SAX handler that builds JSON value directly, without intermediate rapidjson document.
+class JSONValueBuilder : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, JSONValueBuilder>
 {
-    switch (rapidjsonValue.GetType())
+public:
+    explicit JSONValueBuilder(JSONValue& root)
+        : root_(root)
     {
-    case kNullType:
-        // Reset to null type
-        jsonValue.SetType(JSON_NULL);
-        break;
+    }
 
-    case kFalseType:
-        jsonValue = false;
-        break;
+    bool Null()
+    {
+        NextValue().SetType(JSON_NULL);
+        return true;
+    }
 
-    case kTrueType:
-        jsonValue = true;
-        break;
+    bool Bool(bool value)
+    {
+        NextValue() = value;
+        return true;
+    }
 
-    case kNumberType:
-        if (rapidjsonValue.IsInt())
-            jsonValue = rapidjsonValue.GetInt();
-        else if (rapidjsonValue.IsUint())
-            jsonValue = rapidjsonValue.GetUint();
+    bool Int(int value)
+    {
+        NextValue() = value;
+        return true;
+    }
+
+    bool Uint(unsigned value)
+    {
+        // Keep number types consistent with rapidjson document
+        if (value <= static_cast<unsigned>(M_MAX_INT))
+            NextValue() = static_cast<int>(value);
         else
-            jsonValue = rapidjsonValue.GetDouble();
-        break;
+            NextValue() = value;
+        return true;
+    }
 
-    case kStringType:
-        jsonValue = rapidjsonValue.GetString();
-        break;
+    bool Int64(int64_t value)
+    {
+        NextValue() = static_cast<double>(value);
+        return true;
+    }
 
-    case kArrayType:
-        {
-            jsonValue.Resize(rapidjsonValue.Size());
-            for (unsigned i = 0; i < rapidjsonValue.Size(); ++i)
-            {
-                ToJSONValue(jsonValue[i], rapidjsonValue[i]);
-            }
-        }
-        break;
+    bool Uint64(uint64_t value)
+    {
+        NextValue() = static_cast<double>(value);
+        return true;
+    }
 
-    case kObjectType:
+    bool Double(double value)
+    {
+        NextValue() = value;
+        return true;
+    }
+
+    bool String(const char* value, rapidjson::SizeType length, bool copy)
+    {
+        NextValue() = ea::string(value, length);
+        return true;
+    }
+
+    bool StartObject()
+    {
+        JSONValue& value = NextValue();
+        value.SetType(JSON_OBJECT);
+        stack_.push_back(&value);
+        return true;
+    }
+
+    bool Key(const char* value, rapidjson::SizeType length, bool copy)
+    {
+        key_.assign(value, length);
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType memberCount)
+    {
+        stack_.pop_back();
+        return true;
+    }
+
+    bool StartArray()
+    {
+        JSONValue& value = NextValue();
+        value.SetType(JSON_ARRAY);
+        stack_.push_back(&value);
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType elementCount)
+    {
+        stack_.pop_back();
+        return true;
+    }
+
+private:
+    /// Return value to be filled. Array elements are appended, object members are created with the last key.
+    JSONValue& NextValue()
+    {
+        if (stack_.empty())
+            return root_;
+
+        JSONValue& parent = *stack_.back();
+        if (parent.IsArray())
         {
-            jsonValue.SetType(JSON_OBJECT);
-            for (rapidjson::Value::ConstMemberIterator i = rapidjsonValue.MemberBegin(); i != rapidjsonValue.MemberEnd(); ++i)
-            {
-                JSONValue& value = jsonValue[ea::string(i->name.GetString())];
-                ToJSONValue(value, i->value);
-            }
+            parent.Push(JSONValue{});
+            return parent[parent.Size() - 1];
         }
-        break;
-
-    default:
-        break;
+        return parent[key_];
     }
+
+    JSONValue& root_;
+    ea::vector<JSONValue*> stack_;
+    ea::string key_;
+};
+
+/// Parse JSON into value. Return parse result.
+template <unsigned ParseFlags>
+static rapidjson::ParseResult ParseJSONValue(const char* data, unsigned size, JSONValue& value)
+{
+    value = JSONValue::EMPTY;
+
+    rapidjson::MemoryStream memoryStream(data, size);
+    rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream> stream(memoryStream);
+    JSONValueBuilder builder(value);
+    rapidjson::Reader reader;
+    const rapidjson::ParseResult result = reader.Parse<ParseFlags>(stream, builder);
+    if (result.IsError())
+        value = JSONValue::EMPTY;
+    return result;
 }
 
 bool JSONFile::BeginLoad(Deserializer& source)
@@ -121,20 +199,29 @@ bool JSONFile::BeginLoad(Deserializer& source)
         return false;
     }
 
-    ea::shared_array<char> buffer(new char[dataSize + 1]);
-    if (source.Read(buffer.get(), dataSize) != dataSize)
-        return false;
-    buffer[dataSize] = '\0';
+    // Parse in place if possible, otherwise read data into temporary buffer
+    ea::shared_array<char> buffer;
+    const char* data = nullptr;
+    if (const ConstByteSpan sourceData = source.GetContiguousData(); sourceData.size() == dataSize)
+    {
+        data = reinterpret_cast<const char*>(sourceData.data());
+        source.Seek(dataSize);
+    }
+    else
+    {
+        buffer.reset(new char[dataSize]);
+        if (source.Read(buffer.get(), dataSize) != dataSize)
+            return false;
+        data = buffer.get();
+    }
 
-    rapidjson::Document document;
-    if (document.Parse<kParseCommentsFlag | kParseTrailingCommasFlag>(buffer.get()).HasParseError())
+    // Values are built while parsing, so the whole document is never stored twice
+    if (ParseJSONValue<kParseCommentsFlag | kParseTrailingCommasFlag>(data, dataSize, root_).IsError())
     {
         URHO3D_LOGERROR("Could not parse JSON data from " + source.GetName());
         return false;
     }
 
-    ToJSONValue(root_, document);
-
     SetMemoryUse(dataSize);
 
     return true;
@@ -273,15 +360,14 @@ bool JSONFile::FromString(const ea::string & source)
 
 bool JSONFile::ParseJSON(const ea::string& json, JSONValue& value, bool reportError)
 {
-    rapidjson::Document document;
-    if (document.Parse<0>(json.c_str()).HasParseError())
+    const rapidjson::ParseResult result = ParseJSONValue<kParseDefaultFlags>(json.c_str(), json.length(), value);
+    if (result.IsError())
     {
         if (reportError)
-            URHO3D_LOGERRORF("Could not parse JSON data from string with error: %s", document.GetParseError());
+            URHO3D_LOGERRORF("Could not parse JSON data from string with error: %d", result.Code());
 
         return false;
     }
-    ToJSONValue(value, document);
     return true;
 }
 
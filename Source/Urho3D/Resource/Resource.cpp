@@ -128,6 +128,8 @@ bool Resource::Load(Deserializer& source)
     if (success)
         success &= EndLoad();
     SetAsyncLoadState(ASYNC_DONE);
+    if (success)
+        resident_ = true;
 
     return success;
 }
@@ -180,6 +182,12 @@ void Resource::ResetUseTimer()
     useTimer_.Reset();
 }
 
+void Resource::MarkUsed()
+{
+    useTimer_.Reset();
+    ++useCount_;
+}
+
 void Resource::SetAsyncLoadState(AsyncLoadState newState)
 {
     asyncLoadState_ = newState;
@@ -114,6 +114,14 @@ public:
     void SetMemoryUse(unsigned size);
     /// Reset last used timer.
     void ResetUseTimer();
+    /// Reset last used timer and increment use count. Called by ResourceCache when the resource is requested.
+    void MarkUsed();
+    /// Set whether the resource data is resident in memory. Called by ResourceCache.
+    void SetResident(bool resident) { resident_ = resident; }
+    /// Release loaded data to reduce memory use, keeping name and metadata.
+    /// Non-resident resource is reloaded by ResourceCache when requested next time.
+    /// Return false if not supported by the resource type.
+    virtual bool ReleaseData() { return false; }
     /// Set the asynchronous loading state. Called by ResourceCache. Resources in the middle of asynchronous loading are not normally returned to user.
     void SetAsyncLoadState(AsyncLoadState newState);
     /// Set absolute file name.
@@ -134,6 +142,12 @@ public:
     /// @property
     unsigned GetUseTimer();
 
+    /// Return how many times the resource was requested from ResourceCache.
+    unsigned GetUseCount() const { return useCount_; }
+
+    /// Return whether the resource data is resident in memory.
+    bool IsResident() const { return resident_; }
+
     /// Return the asynchronous loading state.
     AsyncLoadState GetAsyncLoadState() const { return asyncLoadState_; }
 
@@ -151,6 +165,10 @@ private:
     Timer useTimer_;
     /// Memory use in bytes.
     unsigned memoryUse_;
+    /// Number of requests from the resource cache.
+    unsigned useCount_{};
+    /// Whether the resource data is resident in memory.
+    bool resident_{true};
     /// Asynchronous loading state.
     AsyncLoadState asyncLoadState_;
 };
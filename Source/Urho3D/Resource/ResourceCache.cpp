@@ -26,6 +26,7 @@
 #include <Urho3D/Core/Context.h>
 #include <Urho3D/Core/CoreEvents.h>
 #include <Urho3D/Core/Profiler.h>
+#include <Urho3D/Core/Thread.h>
 #include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/IO/Log.h>
 #include <Urho3D/IO/PackageFile.h>
@@ -44,6 +45,8 @@
 #include <Urho3D/Resource/ResourceEvents.h>
 #include <Urho3D/Resource/XMLFile.h>
 
+#include <EASTL/sort.h>
+
 #include "../DebugNew.h"
 
 #include <cstdio>
@@ -101,6 +104,7 @@ ResourceCache::~ResourceCache()
 {
 #ifdef URHO3D_BACKGROUND_LOADER
     // Shut down the background loader first
+    backgroundLoader_->Shutdown();
     backgroundLoader_.Reset();
 #endif
 }
@@ -321,6 +325,10 @@ void ResourceCache::ReloadResourceWithDependencies(const ea::string& fileName)
     FindMatchingResources(fileNameHash, resources);
     for (Resource* resource : resources)
     {
+        // Released resource will load actual data on next request
+        if (!resource->IsResident())
+            continue;
+
         URHO3D_LOGDEBUG("Reloading changed {} resource {}", resource->GetTypeName(), fileName);
         ReloadResource(resource);
     }
@@ -347,6 +355,20 @@ void ResourceCache::SetMemoryBudget(StringHash type, unsigned long long budget)
     resourceGroups_[type].memoryBudget_ = budget;
 }
 
+void ResourceCache::SetSoftEviction(StringHash type, bool enable)
+{
+    resourceGroups_[type].softEviction_ = enable;
+}
+
+void ResourceCache::EnforceMemoryBudgets()
+{
+    for (const auto& [type, group] : resourceGroups_)
+    {
+        if (group.memoryBudget_ && group.memoryUse_ > group.memoryBudget_)
+            UpdateResourceGroup(type);
+    }
+}
+
 void ResourceCache::AddResourceRouter(ResourceRouter* router, bool addAsFirst)
 {
     // Check for duplicate
@@ -445,9 +467,15 @@ Resource* ResourceCache::GetResource(StringHash type, const ea::string& name, bo
     backgroundLoader_->WaitForResource(type, nameHash);
 #endif
 
-    const SharedPtr<Resource>& existing = FindSpecificResource(type, nameHash);
-    if (existing)
-        return existing;
+    if (const SharedPtr<Resource>& existing = FindSpecificResource(type, nameHash))
+    {
+        // If restoring fails, the resource is removed from the cache and is loaded from scratch
+        if (existing->IsResident() || RestoreResource(existing))
+        {
+            existing->MarkUsed();
+            return existing;
+        }
+    }
 
     SharedPtr<Resource> resource;
     // Make sure the pointer is non-null and is a Resource subclass
@@ -494,14 +522,15 @@ Resource* ResourceCache::GetResource(StringHash type, const ea::string& name, bo
     }
 
     // Store to cache
-    resource->ResetUseTimer();
+    resource->MarkUsed();
     resourceGroups_[type].resources_[nameHash] = resource;
     UpdateResourceGroup(type);
 
     return resource;
 }
 
-bool ResourceCache::BackgroundLoadResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller)
+bool ResourceCache::BackgroundLoadResource(
+    StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller, float priority)
 {
 #ifdef URHO3D_BACKGROUND_LOADER
     // If empty name, fail immediately
@@ -509,12 +538,13 @@ bool ResourceCache::BackgroundLoadResource(StringHash type, const ea::string& na
     if (sanitatedName.empty())
         return false;
 
-    // First check if already exists as a loaded resource
+    // First check if already exists as a loaded resource. Released resource data is loaded in place
     StringHash nameHash(sanitatedName);
-    if (FindSpecificResource(type, nameHash) != noResource)
+    const SharedPtr<Resource>& existing = FindSpecificResource(type, nameHash);
+    if (existing && existing->IsResident())
         return false;
 
-    return backgroundLoader_->QueueResource(type, sanitatedName, sendEventOnFailure, caller);
+    return backgroundLoader_->QueueResource(type, sanitatedName, sendEventOnFailure, caller, priority, existing);
 #else
     // When threading not supported, fall back to synchronous loading
     return GetResource(type, name, sendEventOnFailure);
@@ -584,6 +614,58 @@ unsigned ResourceCache::GetNumBackgroundLoadResources() const
 #endif
 }
 
+bool ResourceCache::SetBackgroundLoadPriority(StringHash type, const ea::string& name, float priority)
+{
+#ifdef URHO3D_BACKGROUND_LOADER
+    const ea::string sanitatedName = SanitateResourceName(name);
+    return backgroundLoader_->SetPriority(type, StringHash(sanitatedName), priority);
+#else
+    return false;
+#endif
+}
+
+bool ResourceCache::CancelBackgroundLoadResource(StringHash type, const ea::string& name)
+{
+#ifdef URHO3D_BACKGROUND_LOADER
+    const ea::string sanitatedName = SanitateResourceName(name);
+    return backgroundLoader_->CancelResource(type, StringHash(sanitatedName));
+#else
+    return false;
+#endif
+}
+
+BackgroundLoadStats ResourceCache::GetBackgroundLoadStats() const
+{
+#ifdef URHO3D_BACKGROUND_LOADER
+    return backgroundLoader_->GetStats();
+#else
+    return {};
+#endif
+}
+
+void ResourceCache::ResetBackgroundLoadStats()
+{
+#ifdef URHO3D_BACKGROUND_LOADER
+    backgroundLoader_->ResetStats();
+#endif
+}
+
+void ResourceCache::SetMaxConcurrentBackgroundLoads(unsigned count)
+{
+#ifdef URHO3D_BACKGROUND_LOADER
+    backgroundLoader_->SetMaxConcurrentLoads(count);
+#endif
+}
+
+unsigned ResourceCache::GetMaxConcurrentBackgroundLoads() const
+{
+#ifdef URHO3D_BACKGROUND_LOADER
+    return backgroundLoader_->GetMaxConcurrentLoads();
+#else
+    return 0;
+#endif
+}
+
 void ResourceCache::GetResources(ea::vector<Resource*>& result, StringHash type) const
 {
     result.clear();
@@ -627,6 +709,36 @@ unsigned long long ResourceCache::GetTotalMemoryUse() const
     return total;
 }
 
+bool ResourceCache::GetSoftEviction(StringHash type) const
+{
+    auto i = resourceGroups_.find(type);
+    return i != resourceGroups_.end() && i->second.softEviction_;
+}
+
+ResourceEvictionStats ResourceCache::GetEvictionStats(StringHash type) const
+{
+    auto i = resourceGroups_.find(type);
+    return i != resourceGroups_.end() ? i->second.evictionStats_ : ResourceEvictionStats{};
+}
+
+ResourceEvictionStats ResourceCache::GetEvictionStats() const
+{
+    ResourceEvictionStats total;
+    for (const auto& [type, group] : resourceGroups_)
+    {
+        total.numEvicted_ += group.evictionStats_.numEvicted_;
+        total.numSoftEvicted_ += group.evictionStats_.numSoftEvicted_;
+        total.numRestored_ += group.evictionStats_.numRestored_;
+    }
+    return total;
+}
+
+void ResourceCache::ResetEvictionStats()
+{
+    for (auto& [type, group] : resourceGroups_)
+        group.evictionStats_ = {};
+}
+
 ea::string ResourceCache::GetResourceFileName(const ea::string& name) const
 {
     const auto vfs = context_->GetSubsystem<VirtualFileSystem>();
@@ -798,40 +910,100 @@ void ResourceCache::UpdateResourceGroup(StringHash type)
     if (i == resourceGroups_.end())
         return;
 
-    for (;;)
+    ResourceGroup& group = i->second;
+    group.memoryUse_ = 0;
+    for (const auto& [nameHash, resource] : group.resources_)
+        group.memoryUse_ += resource->GetMemoryUse();
+
+    if (!group.memoryBudget_ || group.memoryUse_ <= group.memoryBudget_)
+        return;
+
+    // Collect resident resources that are not used outside of the cache
+    // (resources in use always return a zero timer and can not be released)
+    ea::vector<ea::pair<unsigned, Resource*>> candidates;
+    for (const auto& [nameHash, resource] : group.resources_)
     {
-        unsigned totalSize = 0;
-        unsigned oldestTimer = 0;
-        auto oldestResource = i->second.resources_.end();
+        if (!resource->IsResident() || resource->GetMemoryUse() == 0)
+            continue;
 
-        for (auto j = i->second.resources_.begin();
-             j != i->second.resources_.end(); ++j)
-        {
-            totalSize += j->second->GetMemoryUse();
-            unsigned useTimer = j->second->GetUseTimer();
-            if (useTimer > oldestTimer)
-            {
-                oldestTimer = useTimer;
-                oldestResource = j;
-            }
-        }
+        const unsigned useTimer = resource->GetUseTimer();
+        if (useTimer > 0)
+            candidates.emplace_back(useTimer, resource.Get());
+    }
 
-        i->second.memoryUse_ = totalSize;
+    // Release least recently used resources first, then least frequently used ones
+    const auto isBetterCandidate = [](const ea::pair<unsigned, Resource*>& lhs, const ea::pair<unsigned, Resource*>& rhs)
+    {
+        if (lhs.first != rhs.first)
+            return lhs.first > rhs.first;
+        return lhs.second->GetUseCount() < rhs.second->GetUseCount();
+    };
+    ea::sort(candidates.begin(), candidates.end(), isBetterCandidate);
 
-        // If memory budget defined and is exceeded, remove the oldest resource and loop again
-        // (resources in use always return a zero timer and can not be removed)
-        if (i->second.memoryBudget_ && i->second.memoryUse_ > i->second.memoryBudget_ &&
-            oldestResource != i->second.resources_.end())
+    for (const auto& [useTimer, resource] : candidates)
+    {
+        if (group.memoryUse_ <= group.memoryBudget_)
+            break;
+
+        const unsigned memoryUse = resource->GetMemoryUse();
+        if (group.softEviction_ && resource->ReleaseData())
         {
-            URHO3D_LOGDEBUG("Resource group " + oldestResource->second->GetTypeName() + " over memory budget, releasing resource " +
-                     oldestResource->second->GetName());
-            i->second.resources_.erase(oldestResource);
+            URHO3D_LOGDEBUG("Resource group {} over memory budget, releasing data of resource {}",
+                resource->GetTypeName(), resource->GetName());
+
+            resource->SetResident(false);
+            group.memoryUse_ -= memoryUse - ea::min(resource->GetMemoryUse(), memoryUse);
+            ++group.evictionStats_.numSoftEvicted_;
         }
         else
-            break;
+        {
+            URHO3D_LOGDEBUG("Resource group {} over memory budget, releasing resource {}",
+                resource->GetTypeName(), resource->GetName());
+
+            group.memoryUse_ -= memoryUse;
+            ++group.evictionStats_.numEvicted_;
+            group.resources_.erase(resource->GetNameHash());
+        }
     }
 }
 
+bool ResourceCache::RestoreResource(Resource* resource)
+{
+    URHO3D_LOGDEBUG("Restoring released {} resource {}", resource->GetTypeName(), resource->GetName());
+
+    const AbstractFilePtr file = GetFile(resource->GetName());
+    const bool success = file && resource->Load(*file);
+    FinishRestoreResource(resource, success);
+    return success;
+}
+
+void ResourceCache::FinishRestoreResource(Resource* resource, bool success)
+{
+    ResourceGroup& group = resourceGroups_[resource->GetType()];
+
+    // Resource may be removed from the cache while its data is loaded in background
+    const auto iter = group.resources_.find(resource->GetNameHash());
+    if (iter == group.resources_.end() || iter->second != resource)
+        return;
+
+    if (success)
+    {
+        // Budget is enforced later so the restored resource is not released before it's returned
+        resource->SetResident(true);
+        resource->ResetUseTimer();
+        ++group.evictionStats_.numRestored_;
+    }
+    else
+    {
+        URHO3D_LOGERROR("Failed to restore released resource {}", resource->GetName());
+        group.resources_.erase(iter);
+    }
+
+    group.memoryUse_ = 0;
+    for (const auto& [nameHash, groupResource] : group.resources_)
+        group.memoryUse_ += groupResource->GetMemoryUse();
+}
+
 void ResourceCache::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
 {
     // Check for background loaded resources that can be finished
@@ -841,6 +1013,8 @@ void ResourceCache::HandleBeginFrame(StringHash eventType, VariantMap& eventData
         backgroundLoader_->FinishResources(finishBackgroundResourcesMs_);
     }
 #endif
+
+    EnforceMemoryBudgets();
 }
 
 void ResourceCache::HandleFileChanged(StringHash eventType, VariantMap& eventData)
@@ -29,10 +29,12 @@
 #include "Urho3D/IO/File.h"
 #include "Urho3D/IO/FileIdentifier.h"
 #include "Urho3D/IO/ScanFlags.h"
+#include "Urho3D/Resource/BackgroundLoadStats.h"
 #include "Urho3D/Resource/Resource.h"
 
 #include <EASTL/hash_set.h>
 #include <EASTL/unique_ptr.h>
+#include <EASTL/unordered_map.h>
 #include <EASTL/unordered_set.h>
 
 namespace Urho3D
@@ -45,6 +47,17 @@ class PackageFile;
 /// Sets to priority so that a package or file is pushed to the end of the vector.
 static const unsigned PRIORITY_LAST = 0xffffffff;
 
+/// Statistics of resources released due to memory budget.
+struct URHO3D_API ResourceEvictionStats
+{
+    /// Number of resources removed from the cache.
+    unsigned numEvicted_{};
+    /// Number of resources which data was released while the resource was kept in the cache.
+    unsigned numSoftEvicted_{};
+    /// Number of released resources loaded again on request.
+    unsigned numRestored_{};
+};
+
 /// Container of resources with specific type.
 struct ResourceGroup
 {
@@ -59,6 +72,10 @@ struct ResourceGroup
     unsigned long long memoryBudget_;
     /// Current memory use.
     unsigned long long memoryUse_;
+    /// Whether to release resource data instead of removing resources when over memory budget.
+    bool softEviction_{};
+    /// Eviction statistics.
+    ResourceEvictionStats evictionStats_;
     /// Resources.
     ea::unordered_map<StringHash, SharedPtr<Resource> > resources_;
 };
@@ -114,6 +131,13 @@ public:
     /// Set memory budget for a specific resource type, default 0 is unlimited.
     /// @property
     void SetMemoryBudget(StringHash type, unsigned long long budget);
+    /// Set whether unused resources of specific type over memory budget keep their metadata in the cache
+    /// and only release their data, if supported by the resource. Released resource is reloaded on request.
+    /// Supported only by resources with CPU-side data (BinaryFile and Image), other resources are removed from the cache.
+    void SetSoftEviction(StringHash type, bool enable);
+    /// Release least recently used resources from resource groups that are over memory budget.
+    /// Called automatically every frame.
+    void EnforceMemoryBudgets();
     /// Enable or disable returning resources that failed to load. Default false. This may be useful in editing to not lose resource ref attributes.
     /// @property
     void SetReturnFailedResources(bool enable) { returnFailedResources_ = enable; }
@@ -125,6 +149,8 @@ public:
     /// Set how many milliseconds maximum per frame to spend on finishing background loaded resources.
     /// @property
     void SetFinishBackgroundResourcesMs(int ms) { finishBackgroundResourcesMs_ = Max(ms, 1); }
+    /// Set maximum number of resources loaded in background simultaneously. Zero means the number of worker threads.
+    void SetMaxConcurrentBackgroundLoads(unsigned count);
 
     /// Add a resource router object. By default there is none, so the routing process is skipped.
     void AddResourceRouter(ResourceRouter* router, bool addAsFirst = false);
@@ -138,13 +164,22 @@ public:
     /// Load a resource without storing it in the resource cache. Return null if not found or if fails. Can be called from outside the main thread if the resource itself is safe to load completely (it does not possess for example GPU data).
     SharedPtr<Resource> GetTempResource(StringHash type, const ea::string& name, bool sendEventOnFailure = true);
     /// Background load a resource. An event will be sent when complete. Return true if successfully stored to the load queue, false if eg. already exists. Can be called from outside the main thread.
-    bool BackgroundLoadResource(StringHash type, const ea::string& name, bool sendEventOnFailure = true, Resource* caller = nullptr);
+    /// Resources with higher priority are loaded first. Data of the resource released due to memory budget is loaded again.
+    bool BackgroundLoadResource(StringHash type, const ea::string& name, bool sendEventOnFailure = true, Resource* caller = nullptr, float priority = 0.0f);
+    /// Change priority of a background loaded resource that is not loaded yet. Return true if the resource is still queued.
+    bool SetBackgroundLoadPriority(StringHash type, const ea::string& name, float priority);
+    /// Cancel background loading of a resource. Return true if cancelled. Can be called only from the main thread.
+    bool CancelBackgroundLoadResource(StringHash type, const ea::string& name);
     /// Return number of pending background-loaded resources.
     /// @property
     unsigned GetNumBackgroundLoadResources() const;
+    /// Return statistics of background loading.
+    BackgroundLoadStats GetBackgroundLoadStats() const;
+    /// Reset statistics of background loading.
+    void ResetBackgroundLoadStats();
     /// Return all loaded resources of a specific type.
     void GetResources(ea::vector<Resource*>& result, StringHash type) const;
-    /// Return an already loaded resource of specific type & name, or null if not found. Will not load if does not exist. Specifying zero type will search all types.
+    /// Return an already loaded resource of specific type & name, or null if not found. Will not load if does not exist. Specifying zero type will search all types. Returned resource may be not resident if its data was released due to memory budget.
     Resource* GetExistingResource(StringHash type, const ea::string& name);
 
     /// Return all loaded resources.
@@ -159,7 +194,11 @@ public:
     /// Template version of releasing a resource by name.
     template <class T> void ReleaseResource(const ea::string& resourceName, bool force = false);
     /// Template version of queueing a resource background load.
-    template <class T> bool BackgroundLoadResource(const ea::string& name, bool sendEventOnFailure = true, Resource* caller = nullptr);
+    template <class T> bool BackgroundLoadResource(const ea::string& name, bool sendEventOnFailure = true, Resource* caller = nullptr, float priority = 0.0f);
+    /// Template version of changing priority of a background loaded resource.
+    template <class T> bool SetBackgroundLoadPriority(const ea::string& name, float priority);
+    /// Template version of cancelling a resource background load.
+    template <class T> bool CancelBackgroundLoadResource(const ea::string& name);
     /// Template version of returning loaded resources of a specific type.
     template <class T> void GetResources(ea::vector<T*>& result) const;
     /// Return whether a file exists in the resource directories or package files. Does not check manually added in-memory resources.
@@ -173,6 +212,14 @@ public:
     /// Return total memory use for all resources.
     /// @property
     unsigned long long GetTotalMemoryUse() const;
+    /// Return whether soft eviction is enabled for a resource type.
+    bool GetSoftEviction(StringHash type) const;
+    /// Return eviction statistics for a resource type.
+    ResourceEvictionStats GetEvictionStats(StringHash type) const;
+    /// Return eviction statistics for all resource types.
+    ResourceEvictionStats GetEvictionStats() const;
+    /// Reset eviction statistics.
+    void ResetEvictionStats();
     /// Return full absolute file name of resource if possible, or empty if not found.
     ea::string GetResourceFileName(const ea::string& name) const;
 
@@ -187,6 +234,8 @@ public:
     /// Return how many milliseconds maximum to spend on finishing background loaded resources.
     /// @property
     int GetFinishBackgroundResourcesMs() const { return finishBackgroundResourcesMs_; }
+    /// Return maximum number of resources loaded in background simultaneously.
+    unsigned GetMaxConcurrentBackgroundLoads() const;
 
     /// Return a resource router by index.
     ResourceRouter* GetResourceRouter(unsigned index) const;
@@ -221,6 +270,8 @@ public:
     FileIdentifier GetResolvedIdentifier(const FileIdentifier& name) const;
 
 private:
+    friend class BackgroundLoader;
+
     /// Find a resource.
     const SharedPtr<Resource>& FindSpecificResource(StringHash type, StringHash nameHash);
     /// Find a resource by name only. Searches all type groups.
@@ -229,7 +280,11 @@ private:
     void ReleasePackageResources(PackageFile* package, bool force = false);
     /// Update a resource group. Recalculate memory use and release resources if over memory budget.
     void UpdateResourceGroup(StringHash type);
-    /// Handle begin frame event. The finalization of background loaded resources are processed here.
+    /// Load data of the resource released due to memory budget. Resource is removed from the cache on failure.
+    bool RestoreResource(Resource* resource);
+    /// Update cache state after loading data of the resource released due to memory budget.
+    void FinishRestoreResource(Resource* resource, bool success);
+    /// Handle begin frame event. The finalization of background loaded resources and memory budgets are processed here.
     void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
     /// Handle file changed to reload resource.
     void HandleFileChanged(StringHash eventType, VariantMap& eventData);
@@ -285,10 +340,22 @@ template <class T> SharedPtr<T> ResourceCache::GetTempResource(const ea::string&
     return StaticCast<T>(GetTempResource(type, name, sendEventOnFailure));
 }
 
-template <class T> bool ResourceCache::BackgroundLoadResource(const ea::string& name, bool sendEventOnFailure, Resource* caller)
+template <class T> bool ResourceCache::BackgroundLoadResource(const ea::string& name, bool sendEventOnFailure, Resource* caller, float priority)
+{
+    StringHash type = T::GetTypeStatic();
+    return BackgroundLoadResource(type, name, sendEventOnFailure, caller, priority);
+}
+
+template <class T> bool ResourceCache::SetBackgroundLoadPriority(const ea::string& name, float priority)
+{
+    StringHash type = T::GetTypeStatic();
+    return SetBackgroundLoadPriority(type, name, priority);
+}
+
+template <class T> bool ResourceCache::CancelBackgroundLoadResource(const ea::string& name)
 {
     StringHash type = T::GetTypeStatic();
-    return BackgroundLoadResource(type, name, sendEventOnFailure, caller);
+    return CancelBackgroundLoadResource(type, name);
 }
 
 template <class T> void ResourceCache::GetResources(ea::vector<T*>& result) const
@@ -85,11 +85,23 @@ bool XMLFile::BeginLoad(Deserializer& source)
         return false;
     }
 
-    ea::shared_array<char> buffer(new char[dataSize]);
-    if (source.Read(buffer.get(), dataSize) != dataSize)
-        return false;
+    // Parse in place if possible, otherwise read data into temporary buffer
+    ea::shared_array<char> buffer;
+    const void* data = nullptr;
+    if (const ConstByteSpan sourceData = source.GetContiguousData(); sourceData.size() == dataSize)
+    {
+        data = sourceData.data();
+        source.Seek(dataSize);
+    }
+    else
+    {
+        buffer.reset(new char[dataSize]);
+        if (source.Read(buffer.get(), dataSize) != dataSize)
+            return false;
+        data = buffer.get();
+    }
 
-    if (!document_->load_buffer(buffer.get(), dataSize))
+    if (!document_->load_buffer(data, dataSize))
     {
         URHO3D_LOGERROR("Could not parse XML data from " + source.GetName());
         document_->reset();
@@ -0,0 +1,499 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Scene/CompactPrefab.h"
+
+#include "Urho3D/Core/Exception.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/IO/MemoryBuffer.h"
+#include "Urho3D/IO/VectorBuffer.h"
+
+#include <EASTL/unordered_map.h>
+
+#include <zstd.h>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const unsigned CompactPrefabVersion = 1;
+const unsigned char CompressedFlag = 1 << 0;
+const unsigned MaxDecompressedPayloadSize = 256 * 1024 * 1024;
+const unsigned char IdentifierTypeOffset = 6;
+
+/// Helper to write compact prefab.
+class CompactPrefabWriter
+{
+public:
+    void WriteNode(const NodePrefab& node)
+    {
+        WriteSerializable(node.GetNode());
+
+        const auto& components = node.GetComponents();
+        structure_.WriteVLE(components.size());
+        for (const SerializablePrefab& component : components)
+            WriteSerializable(component);
+
+        const auto& children = node.GetChildren();
+        structure_.WriteVLE(children.size());
+        for (const NodePrefab& child : children)
+            WriteNode(child);
+    }
+
+    void WritePayload(VectorBuffer& dest) const
+    {
+        dest.WriteVLE(strings_.size());
+        for (const ea::string& string : strings_)
+            dest.WriteString(string);
+
+        dest.WriteVLE(schemas_.size());
+        for (const Schema& schema : schemas_)
+        {
+            dest.Write(schema.description_.GetData(), schema.description_.GetSize());
+            dest.WriteVLE(schema.numInstances_);
+        }
+
+        WriteBuffer(dest, structure_);
+
+        for (const Schema& schema : schemas_)
+        {
+            for (const VectorBuffer& column : schema.columns_)
+                WriteBuffer(dest, column);
+        }
+    }
+
+private:
+    struct Schema
+    {
+        VectorBuffer description_;
+        unsigned numInstances_{};
+        ea::vector<VectorBuffer> columns_;
+    };
+
+    static void WriteBuffer(VectorBuffer& dest, const VectorBuffer& buffer)
+    {
+        dest.WriteVLE(buffer.GetSize());
+        dest.Write(buffer.GetData(), buffer.GetSize());
+    }
+
+    void WriteSerializable(const SerializablePrefab& prefab)
+    {
+        const unsigned schemaIndex = GetOrCreateSchema(prefab);
+        structure_.WriteVLE(schemaIndex);
+        structure_.WriteVLE(static_cast<unsigned>(prefab.GetId()));
+
+        Schema& schema = schemas_[schemaIndex];
+        const auto& attributes = prefab.GetAttributes();
+        for (unsigned i = 0; i < attributes.size(); ++i)
+            WriteValue(schema.columns_[i], attributes[i].GetValue());
+        ++schema.numInstances_;
+    }
+
+    unsigned GetOrCreateSchema(const SerializablePrefab& prefab)
+    {
+        const auto& attributes = prefab.GetAttributes();
+
+        // Schema is described with indices in string table, so the description is also used as a key
+        VectorBuffer description;
+        const ea::string& typeName = prefab.GetTypeName();
+        description.WriteVLE(typeName.empty() ? 0 : AddString(typeName) + 1);
+        if (typeName.empty())
+            description.WriteStringHash(prefab.GetTypeNameHash());
+
+        description.WriteVLE(attributes.size());
+        for (const AttributePrefab& attribute : attributes)
+        {
+            const AttributePrefab::IdentifierType identifierType = attribute.GetIdentifierType();
+            description.WriteUByte(static_cast<unsigned char>(attribute.GetType() & MAX_VAR_MASK)
+                | (static_cast<unsigned char>(identifierType) << IdentifierTypeOffset));
+
+            switch (identifierType)
+            {
+            case AttributePrefab::IdentifierType::Id:
+                description.WriteVLE(static_cast<unsigned>(attribute.GetId()));
+                break;
+            case AttributePrefab::IdentifierType::Name:
+                description.WriteVLE(AddString(attribute.GetName()));
+                break;
+            default:
+                description.WriteStringHash(attribute.GetNameHash());
+                break;
+            }
+        }
+
+        const ea::string key{reinterpret_cast<const char*>(description.GetData()), description.GetSize()};
+        const auto [iter, inserted] = schemaIndices_.emplace(key, schemas_.size());
+        if (inserted)
+        {
+            Schema& schema = schemas_.emplace_back();
+            schema.description_ = ea::move(description);
+            schema.columns_.resize(attributes.size());
+        }
+        return iter->second;
+    }
+
+    void WriteValue(VectorBuffer& dest, const Variant& value)
+    {
+        switch (value.GetType())
+        {
+        case VAR_STRING:
+            dest.WriteVLE(AddString(value.GetString()));
+            break;
+
+        case VAR_RESOURCEREF:
+        {
+            const ResourceRef& ref = value.GetResourceRef();
+            dest.WriteStringHash(ref.type_);
+            dest.WriteVLE(AddString(ref.name_));
+            break;
+        }
+
+        case VAR_RESOURCEREFLIST:
+        {
+            const ResourceRefList& refList = value.GetResourceRefList();
+            dest.WriteStringHash(refList.type_);
+            dest.WriteVLE(refList.names_.size());
+            for (const ea::string& name : refList.names_)
+                dest.WriteVLE(AddString(name));
+            break;
+        }
+
+        case VAR_STRINGVECTOR:
+        {
+            const StringVector& strings = value.GetStringVector();
+            dest.WriteVLE(strings.size());
+            for (const ea::string& string : strings)
+                dest.WriteVLE(AddString(string));
+            break;
+        }
+
+        default:
+            dest.WriteVariantData(value);
+            break;
+        }
+    }
+
+    unsigned AddString(const ea::string& string)
+    {
+        const auto [iter, inserted] = stringIndices_.emplace(string, strings_.size());
+        if (inserted)
+            strings_.push_back(string);
+        return iter->second;
+    }
+
+    ea::vector<ea::string> strings_;
+    ea::unordered_map<ea::string, unsigned> stringIndices_;
+    ea::vector<Schema> schemas_;
+    ea::unordered_map<ea::string, unsigned> schemaIndices_;
+    VectorBuffer structure_;
+};
+
+/// Helper to read compact prefab. Throws ArchiveException on error.
+class CompactPrefabReader
+{
+public:
+    explicit CompactPrefabReader(Context* context) : context_(context) {}
+
+    void ReadPayload(MemoryBuffer& source, NodePrefab& prefab)
+    {
+        strings_.resize(ReadCount(source));
+        for (ea::string& string : strings_)
+            string = source.ReadString();
+
+        schemas_.resize(ReadCount(source));
+        for (Schema& schema : schemas_)
+            ReadSchema(source, schema);
+
+        // Create all objects first, then fill attributes column by column
+        MemoryBuffer structure = ReadBuffer(source);
+        ReadNode(structure, prefab);
+
+        for (Schema& schema : schemas_)
+        {
+            if (schema.instances_.size() != schema.numInstances_)
+                throw ArchiveException("Compact prefab structure doesn't match schema");
+
+            for (unsigned attributeIndex = 0; attributeIndex < schema.attributes_.size(); ++attributeIndex)
+            {
+                const VariantType type = schema.types_[attributeIndex];
+                MemoryBuffer column = ReadBuffer(source);
+                for (SerializablePrefab* instance : schema.instances_)
+                    instance->GetMutableAttributes()[attributeIndex].SetValue(ReadValue(column, type));
+                if (!column.IsEof())
+                    throw ArchiveException("Compact prefab column is corrupted");
+            }
+        }
+    }
+
+private:
+    struct Schema
+    {
+        ea::string typeName_;
+        StringHash typeNameHash_;
+        ea::vector<AttributePrefab> attributes_;
+        ea::vector<VariantType> types_;
+        unsigned numInstances_{};
+        ea::vector<SerializablePrefab*> instances_;
+    };
+
+    static unsigned ReadCount(Deserializer& source)
+    {
+        // Each element takes at least one byte
+        const unsigned count = source.ReadVLE();
+        if (count > source.GetSize() - source.GetPosition())
+            throw ArchiveException("Compact prefab is truncated");
+        return count;
+    }
+
+    static MemoryBuffer ReadBuffer(MemoryBuffer& source)
+    {
+        const unsigned size = source.ReadVLE();
+        if (size > source.GetSize() - source.GetPosition())
+            throw ArchiveException("Compact prefab is truncated");
+
+        MemoryBuffer buffer{source.GetData() + source.GetPosition(), size};
+        source.Seek(source.GetPosition() + size);
+        return buffer;
+    }
+
+    const ea::string& GetString(unsigned index) const
+    {
+        if (index >= strings_.size())
+            throw ArchiveException("Invalid string index {} in compact prefab", index);
+        return strings_[index];
+    }
+
+    void ReadSchema(Deserializer& source, Schema& schema)
+    {
+        const unsigned typeNameIndex = source.ReadVLE();
+        if (typeNameIndex != 0)
+        {
+            schema.typeName_ = GetString(typeNameIndex - 1);
+            schema.typeNameHash_ = StringHash{schema.typeName_};
+        }
+        else
+            schema.typeNameHash_ = source.ReadStringHash();
+
+        const unsigned numAttributes = ReadCount(source);
+        schema.attributes_.reserve(numAttributes);
+        schema.types_.reserve(numAttributes);
+        for (unsigned i = 0; i < numAttributes; ++i)
+        {
+            const unsigned char descriptor = source.ReadUByte();
+            const auto type = static_cast<VariantType>(descriptor & MAX_VAR_MASK);
+            const auto identifierType = static_cast<AttributePrefab::IdentifierType>(descriptor >> IdentifierTypeOffset);
+            if (type >= MAX_VAR_TYPES)
+                throw ArchiveException("Invalid attribute type in compact prefab");
+
+            switch (identifierType)
+            {
+            case AttributePrefab::IdentifierType::Id:
+                schema.attributes_.emplace_back(static_cast<AttributeId>(source.ReadVLE()));
+                break;
+            case AttributePrefab::IdentifierType::Name:
+                schema.attributes_.emplace_back(GetString(source.ReadVLE()));
+                break;
+            case AttributePrefab::IdentifierType::NameHash:
+                schema.attributes_.emplace_back(source.ReadStringHash());
+                break;
+            default:
+                throw ArchiveException("Invalid attribute identifier in compact prefab");
+            }
+            schema.types_.push_back(type);
+        }
+
+        schema.numInstances_ = source.ReadVLE();
+    }
+
+    void ReadSerializable(Deserializer& source, SerializablePrefab& prefab)
+    {
+        const unsigned schemaIndex = source.ReadVLE();
+        if (schemaIndex >= schemas_.size())
+            throw ArchiveException("Invalid schema index {} in compact prefab", schemaIndex);
+
+        Schema& schema = schemas_[schemaIndex];
+        if (!schema.typeName_.empty())
+            prefab.SetType(schema.typeName_);
+        else
+            prefab.SetType(schema.typeNameHash_);
+        prefab.SetId(static_cast<SerializableId>(source.ReadVLE()));
+        prefab.GetMutableAttributes() = schema.attributes_;
+        schema.instances_.push_back(&prefab);
+    }
+
+    void ReadNode(Deserializer& source, NodePrefab& node)
+    {
+        ReadSerializable(source, node.GetMutableNode());
+
+        auto& components = node.GetMutableComponents();
+        components.resize(ReadCount(source));
+        for (SerializablePrefab& component : components)
+            ReadSerializable(source, component);
+
+        // Children are not resized after this point, so pointers to serializables stay valid
+        auto& children = node.GetMutableChildren();
+        children.resize(ReadCount(source));
+        for (NodePrefab& child : children)
+            ReadNode(source, child);
+    }
+
+    Variant ReadValue(Deserializer& source, VariantType type) const
+    {
+        switch (type)
+        {
+        case VAR_STRING:
+            return GetString(source.ReadVLE());
+
+        case VAR_RESOURCEREF:
+        {
+            const StringHash refType = source.ReadStringHash();
+            return ResourceRef{refType, GetString(source.ReadVLE())};
+        }
+
+        case VAR_RESOURCEREFLIST:
+        {
+            ResourceRefList refList;
+            refList.type_ = source.ReadStringHash();
+            refList.names_.resize(ReadCount(source));
+            for (ea::string& name : refList.names_)
+                name = GetString(source.ReadVLE());
+            return refList;
+        }
+
+        case VAR_STRINGVECTOR:
+        {
+            StringVector strings(ReadCount(source));
+            for (ea::string& string : strings)
+                string = GetString(source.ReadVLE());
+            return strings;
+        }
+
+        default:
+            return source.ReadVariant(type, context_);
+        }
+    }
+
+    Context* context_{};
+    ea::vector<ea::string> strings_;
+    ea::vector<Schema> schemas_;
+};
+
+}
+
+bool CompactPrefab::IsCompactPrefab(Deserializer& source)
+{
+    const unsigned position = source.GetPosition();
+    const bool isCompact = source.ReadFileID() == "UCPF";
+    source.Seek(position);
+    return isCompact;
+}
+
+bool CompactPrefab::Save(Serializer& dest, const NodePrefab& prefab, bool compress)
+{
+    CompactPrefabWriter writer;
+    writer.WriteNode(prefab);
+
+    VectorBuffer payload;
+    writer.WritePayload(payload);
+
+    ByteVector compressedPayload;
+    if (compress)
+    {
+        compressedPayload.resize(ZSTD_compressBound(payload.GetSize()));
+        const size_t compressedSize = ZSTD_compress(
+            compressedPayload.data(), compressedPayload.size(), payload.GetData(), payload.GetSize(), 0);
+        if (ZSTD_isError(compressedSize))
+        {
+            URHO3D_LOGERROR("Failed to compress prefab: {}", ZSTD_getErrorName(compressedSize));
+            return false;
+        }
+        compressedPayload.resize(compressedSize);
+    }
+
+    bool success = dest.WriteFileID("UCPF");
+    success = success && dest.WriteVLE(CompactPrefabVersion);
+    success = success && dest.WriteUByte(compress ? CompressedFlag : 0);
+    success = success && dest.WriteVLE(payload.GetSize());
+    if (compress)
+    {
+        success = success && dest.WriteVLE(compressedPayload.size());
+        success = success && dest.Write(compressedPayload.data(), compressedPayload.size()) == compressedPayload.size();
+    }
+    else
+        success = success && dest.Write(payload.GetData(), payload.GetSize()) == payload.GetSize();
+    return success;
+}
+
+bool CompactPrefab::Load(Deserializer& source, NodePrefab& prefab, Context* context)
+{
+    if (source.ReadFileID() != "UCPF")
+    {
+        URHO3D_LOGERROR("{} is not a compact prefab", source.GetName());
+        return false;
+    }
+
+    const unsigned version = source.ReadVLE();
+    if (version > CompactPrefabVersion)
+    {
+        URHO3D_LOGERROR("Unsupported version {} of compact prefab {}", version, source.GetName());
+        return false;
+    }
+
+    const unsigned char flags = source.ReadUByte();
+    const unsigned payloadSize = source.ReadVLE();
+    const unsigned storedSize = (flags & CompressedFlag) ? source.ReadVLE() : payloadSize;
+    if (storedSize > source.GetSize() - source.GetPosition())
+    {
+        URHO3D_LOGERROR("Compact prefab {} is truncated", source.GetName());
+        return false;
+    }
+
+    ByteVector payload(storedSize);
+    if (source.Read(payload.data(), storedSize) != storedSize)
+        return false;
+
+    if (flags & CompressedFlag)
+    {
+        // Don't allocate memory for untrusted size unless it matches the ZSTD frame and is reasonable
+        const unsigned long long frameContentSize = ZSTD_getFrameContentSize(payload.data(), payload.size());
+        if (frameContentSize != payloadSize || payloadSize > MaxDecompressedPayloadSize)
+        {
+            URHO3D_LOGERROR("Compact prefab {} has invalid payload size", source.GetName());
+            return false;
+        }
+
+        ByteVector decompressedPayload(payloadSize);
+        const size_t decompressedSize =
+            ZSTD_decompress(decompressedPayload.data(), payloadSize, payload.data(), payload.size());
+        if (ZSTD_isError(decompressedSize) || decompressedSize != payloadSize)
+        {
+            URHO3D_LOGERROR("Failed to decompress compact prefab {}", source.GetName());
+            return false;
+        }
+        payload = ea::move(decompressedPayload);
+    }
+
+    try
+    {
+        prefab.Clear();
+        MemoryBuffer payloadBuffer{payload};
+        CompactPrefabReader reader{context};
+        reader.ReadPayload(payloadBuffer, prefab);
+        return true;
+    }
+    catch (const ArchiveException& e)
+    {
+        prefab.Clear();
+        URHO3D_LOGERROR("Failed to load compact prefab {}: {}", source.GetName(), e.what());
+        return false;
+    }
+}
+
+} // namespace Urho3D
@@ -0,0 +1,32 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Scene/NodePrefab.h"
+
+namespace Urho3D
+{
+
+class Deserializer;
+class Serializer;
+
+/// Compact binary container of prefab.
+/// - Serializables with the same type and the same list of attributes share schema, which is stored once.
+/// - Attribute values are stored in columns per schema attribute.
+/// - All strings are stored once in the global string table.
+/// - Content may be compressed with ZSTD. Compressed content is limited to 256 MB when decompressed.
+/// Temporary flag of serializables is not stored.
+class URHO3D_API CompactPrefab
+{
+public:
+    /// Return whether the stream contains compact prefab. Stream position is not changed.
+    static bool IsCompactPrefab(Deserializer& source);
+    /// Save prefab to stream.
+    static bool Save(Serializer& dest, const NodePrefab& prefab, bool compress = false);
+    /// Load prefab from stream.
+    static bool Load(Deserializer& source, NodePrefab& prefab, Context* context = nullptr);
+};
+
+} // namespace Urho3D
@@ -24,6 +24,7 @@
 
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/IO/Log.h>
+#include <Urho3D/Scene/CompactPrefab.h>
 #include <Urho3D/Scene/PrefabReference.h>
 #include <Urho3D/Scene/PrefabResource.h>
 #include <Urho3D/Scene/Scene.h>
@@ -94,9 +95,19 @@ const NodePrefab& PrefabResource::GetNodePrefabSlice(ea::string_view path) const
     return nodePrefab.FindChild(path);
 }
 
+bool PrefabResource::SaveCompact(Serializer& dest, bool compress) const
+{
+    return CompactPrefab::Save(dest, prefab_, compress);
+}
+
 bool PrefabResource::BeginLoad(Deserializer& source)
 {
-    if (!SimpleResource::BeginLoad(source))
+    if (CompactPrefab::IsCompactPrefab(source))
+    {
+        if (!CompactPrefab::Load(source, prefab_, context_))
+            return false;
+    }
+    else if (!SimpleResource::BeginLoad(source))
         return false;
 
     if (GetAsyncLoadState() == ASYNC_LOADING)
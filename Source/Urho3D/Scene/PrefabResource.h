@@ -49,6 +49,8 @@ public:
     void NormalizeIds();
 
     void SerializeInBlock(Archive& archive) override;
+    /// Save as compact prefab, optionally compressed. Return true if successful.
+    bool SaveCompact(Serializer& dest, bool compress = false) const;
 
     const NodePrefab& GetScenePrefab() const { return prefab_; }
     NodePrefab& GetMutableScenePrefab() { return prefab_; }
@@ -38,12 +38,16 @@
 #include "Urho3D/Resource/ResourceEvents.h"
 #include "Urho3D/Resource/XMLArchive.h"
 #include "Urho3D/Resource/XMLFile.h"
+#include "Urho3D/Scene/CompactPrefab.h"
 #include "Urho3D/Scene/Component.h"
 #include "Urho3D/Scene/ObjectAnimation.h"
+#include "Urho3D/Scene/PrefabReader.h"
+#include "Urho3D/Scene/PrefabWriter.h"
 #include "Urho3D/Scene/PrefabReference.h"
 #include "Urho3D/Scene/PrefabResource.h"
 #include "Urho3D/Scene/SceneEvents.h"
 #include "Urho3D/Scene/SceneResource.h"
+#include "Urho3D/Scene/SceneStreamer.h"
 #include "Urho3D/Scene/ShakeComponent.h"
 #include "Urho3D/Scene/SplinePath.h"
 #include "Urho3D/Scene/UnknownComponent.h"
@@ -229,6 +233,24 @@ bool Scene::Load(Deserializer& source)
 
     StopAsyncLoading();
 
+    if (CompactPrefab::IsCompactPrefab(source))
+    {
+        URHO3D_LOGINFO("Loading compact scene from " + source.GetName());
+
+        NodePrefab prefab;
+        if (!CompactPrefab::Load(source, prefab, context_))
+            return false;
+
+        Clear();
+
+        PrefabReaderFromMemory reader{prefab};
+        if (!Node::Load(reader))
+            return false;
+
+        FinishLoading(&source);
+        return true;
+    }
+
     constexpr BinaryMagic sceneBinaryMagic{{'U', 'S', 'C', 'N'}};
 
     const InternalResourceFormat format = PeekResourceFormat(source, sceneBinaryMagic);
@@ -280,6 +302,22 @@ bool Scene::Save(Serializer& dest) const
         return false;
 }
 
+bool Scene::SaveCompact(Serializer& dest, bool compress) const
+{
+    URHO3D_PROFILE("SaveSceneCompact");
+
+    NodePrefab prefab;
+    PrefabWriterToMemory writer{prefab};
+    if (!Node::Save(writer) || !CompactPrefab::Save(dest, prefab, compress))
+    {
+        URHO3D_LOGERROR("Could not save compact scene");
+        return false;
+    }
+
+    FinishSaving(&dest);
+    return true;
+}
+
 bool Scene::LoadXML(const XMLElement& source)
 {
     URHO3D_PROFILE("LoadSceneXML");
@@ -513,6 +551,12 @@ bool Scene::LoadAsync(AbstractFilePtr file, LoadMode mode)
 
     StopAsyncLoading();
 
+    if (CompactPrefab::IsCompactPrefab(*file))
+    {
+        URHO3D_LOGERROR("Asynchronous loading of compact scene {} is not supported, use Load", file->GetName());
+        return false;
+    }
+
     // Check ID
     bool isSceneFile = file->ReadFileID() == "USCN";
     if (!isSceneFile)
@@ -1531,6 +1575,7 @@ void RegisterSceneLibrary(Context* context)
     PrefabReference::RegisterObject(context);
     PrefabResource::RegisterObject(context);
     ShakeComponent::RegisterObject(context);
+    SceneStreamer::RegisterObject(context);
     WorldOrigin::RegisterObject(context);
 }
 
@@ -133,6 +133,8 @@ public:
     bool Load(Deserializer& source) override;
     /// Save to binary data. Return true if successful.
     bool Save(Serializer& dest) const override;
+    /// Save to compact binary data, optionally compressed. Loaded via Load. Return true if successful.
+    bool SaveCompact(Serializer& dest, bool compress = false) const;
     /// Load from XML data. Removes all existing child nodes and components first. Return true if successful.
     bool LoadXML(const XMLElement& source) override;
     /// Load from JSON data. Removes all existing child nodes and components first. Return true if successful.
@@ -177,6 +179,7 @@ public:
     /// Save to a JSON file. Return true if successful.
     bool SaveJSON(Serializer& dest, const ea::string& indentation = "\t") const;
     /// Load from a binary file asynchronously. Return true if started successfully. The LOAD_RESOURCES_ONLY mode can also be used to preload resources from object prefab files.
+    /// Compact scenes saved by SaveCompact are not supported and should be loaded with Load.
     bool LoadAsync(AbstractFilePtr file, LoadMode mode = LOAD_SCENE_AND_RESOURCES);
     /// Load from an XML file asynchronously. Return true if started successfully. The LOAD_RESOURCES_ONLY mode can also be used to preload resources from object prefab files.
     bool LoadAsyncXML(AbstractFilePtr file, LoadMode mode = LOAD_SCENE_AND_RESOURCES);
@@ -0,0 +1,290 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Scene/SceneStreamer.h"
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/Core/Timer.h"
+#include "Urho3D/Core/WorkQueue.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/Resource/ResourceCache.h"
+#include "Urho3D/Scene/Node.h"
+#include "Urho3D/Scene/PrefabReader.h"
+#include "Urho3D/Scene/PrefabResource.h"
+
+#include <EASTL/sort.h>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+bool LoadCellPrefab(Context* context, const SceneCellLoader& loader, const ea::string& resourceFormat,
+    const IntVector2& index, NodePrefab& prefab)
+{
+    if (loader)
+        return loader(index, prefab);
+
+    if (resourceFormat.empty())
+        return false;
+
+    ea::string resourceName;
+    try
+    {
+        resourceName = Format(resourceFormat, index.x_, index.y_);
+    }
+    catch (const std::exception& e)
+    {
+        URHO3D_LOGERROR("Invalid cell resource format '{}': {}", resourceFormat, e.what());
+        return false;
+    }
+
+    // Missing file is an empty cell
+    const AbstractFilePtr file = context->GetSubsystem<ResourceCache>()->GetFile(resourceName, false);
+    if (!file)
+        return false;
+
+    auto resource = MakeShared<PrefabResource>(context);
+    resource->SetName(resourceName);
+    if (!resource->Load(*file))
+        return false;
+
+    prefab = ea::move(resource->GetMutableNodePrefab());
+    return true;
+}
+
+}
+
+SceneStreamer::SceneStreamer(Context* context)
+    : LogicComponent(context)
+{
+    SetUpdateEventMask(USE_UPDATE);
+}
+
+SceneStreamer::~SceneStreamer()
+{
+    for (const auto& [index, cell] : cells_)
+        cell->cancelled_ = true;
+}
+
+void SceneStreamer::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<ClassName>(Category_Scene);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Cell Size", GetCellSize, SetCellSize, float, DefaultCellSize, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE(
+        "Load Distance", GetLoadDistance, SetLoadDistance, float, DefaultLoadDistance, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE(
+        "Unload Distance", GetUnloadDistance, SetUnloadDistance, float, DefaultUnloadDistance, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Attach Budget Ms", float, attachBudgetMs_, DefaultAttachBudgetMs, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE(
+        "Max Pending Cells", GetMaxPendingCells, SetMaxPendingCells, unsigned, DefaultMaxPendingCells, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Cell Resource Format", ea::string, cellResourceFormat_, EMPTY_STRING, AM_DEFAULT);
+}
+
+void SceneStreamer::SetLoadDistance(float distance)
+{
+    loadDistance_ = ea::max(distance, 0.0f);
+    unloadDistance_ = ea::max(unloadDistance_, loadDistance_);
+}
+
+void SceneStreamer::SetUnloadDistance(float distance)
+{
+    if (distance < loadDistance_)
+    {
+        URHO3D_LOGWARNING("Unload distance {} is less than load distance {}", distance, loadDistance_);
+        distance = loadDistance_;
+    }
+    unloadDistance_ = distance;
+}
+
+void SceneStreamer::Update(float timeStep)
+{
+    Node* focusNode = focusNode_ ? focusNode_.Get() : node_;
+    UpdateStreaming(node_->WorldToLocal(focusNode->GetWorldPosition()));
+}
+
+void SceneStreamer::UpdateStreaming(const Vector3& focusPosition)
+{
+    // Unload cells that are too far, including ones that are not loaded yet
+    cellsToUnload_.clear();
+    for (const auto& [index, cell] : cells_)
+    {
+        if (GetCellDistance(index, focusPosition) > unloadDistance_)
+            cellsToUnload_.push_back(index);
+    }
+    for (const IntVector2& index : cellsToUnload_)
+    {
+        const auto iter = cells_.find(index);
+        Cell& cell = *iter->second;
+        cell.cancelled_ = true;
+        if (cell.node_)
+            cell.node_->Remove();
+        cells_.erase(iter);
+    }
+
+    // Start loading the closest missing cells
+    unsigned numPendingCells = GetNumPendingCells();
+    if (numPendingCells < maxPendingCells_)
+    {
+        const IntVector2 minCell = GetCellIndex(focusPosition - Vector3::ONE * loadDistance_);
+        const IntVector2 maxCell = GetCellIndex(focusPosition + Vector3::ONE * loadDistance_);
+
+        cellsToLoad_.clear();
+        for (int y = minCell.y_; y <= maxCell.y_; ++y)
+        {
+            for (int x = minCell.x_; x <= maxCell.x_; ++x)
+            {
+                const IntVector2 index{x, y};
+                const float distance = GetCellDistance(index, focusPosition);
+                if (distance <= loadDistance_ && !cells_.contains(index))
+                    cellsToLoad_.emplace_back(distance, index);
+            }
+        }
+        ea::sort(cellsToLoad_.begin(), cellsToLoad_.end());
+
+        for (const auto& [distance, index] : cellsToLoad_)
+        {
+            if (numPendingCells >= maxPendingCells_)
+                break;
+
+            auto cell = ea::make_shared<Cell>();
+            cell->index_ = index;
+            cells_.emplace(index, cell);
+            StartLoading(cell);
+            ++numPendingCells;
+        }
+    }
+
+    // Attach loaded cells, the closest first
+    cellsToAttach_.clear();
+    for (const auto& [index, cell] : cells_)
+    {
+        if (!cell->attached_ && cell->loaded_.load(std::memory_order_acquire))
+            cellsToAttach_.emplace_back(GetCellDistance(index, focusPosition), cell.get());
+    }
+    ea::sort(cellsToAttach_.begin(), cellsToAttach_.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    // At least one node is attached per update so streaming always makes progress
+    HiresTimer timer;
+    const auto budgetUSec = static_cast<long long>(attachBudgetMs_ * 1000.0f);
+    for (const auto& [distance, cell] : cellsToAttach_)
+    {
+        while (!cell->attached_)
+        {
+            cell->attached_ = AttachNext(*cell);
+            if (timer.GetUSec(false) >= budgetUSec)
+                return;
+        }
+    }
+}
+
+void SceneStreamer::UnloadAllCells()
+{
+    for (const auto& [index, cell] : cells_)
+    {
+        cell->cancelled_ = true;
+        if (cell->node_)
+            cell->node_->Remove();
+    }
+    cells_.clear();
+}
+
+IntVector2 SceneStreamer::GetCellIndex(const Vector3& position) const
+{
+    return {FloorToInt(position.x_ / cellSize_), FloorToInt(position.z_ / cellSize_)};
+}
+
+Node* SceneStreamer::GetCellNode(const IntVector2& cell) const
+{
+    const auto iter = cells_.find(cell);
+    return iter != cells_.end() ? iter->second->node_.Get() : nullptr;
+}
+
+unsigned SceneStreamer::GetNumAttachedCells() const
+{
+    return ea::count_if(cells_.begin(), cells_.end(), [](const auto& item) { return item.second->attached_; });
+}
+
+unsigned SceneStreamer::GetNumPendingCells() const
+{
+    return cells_.size() - GetNumAttachedCells();
+}
+
+void SceneStreamer::StartLoading(const ea::shared_ptr<Cell>& cell)
+{
+    // Task doesn't access the component, it may be destroyed before the task is executed
+    auto loadCell = [context = context_, loader = cellLoader_, format = cellResourceFormat_, cell]()
+    {
+        if (!cell->cancelled_)
+        {
+            NodePrefab prefab;
+            if (LoadCellPrefab(context, loader, format, cell->index_, prefab))
+            {
+                cell->children_ = ea::move(prefab.GetMutableChildren());
+                prefab.GetMutableChildren().clear();
+                cell->prefab_ = ea::move(prefab);
+            }
+        }
+        cell->loaded_.store(true, std::memory_order_release);
+    };
+
+    if (auto workQueue = GetSubsystem<WorkQueue>())
+        workQueue->PostTask(ea::move(loadCell), TaskPriority::Low);
+    else
+        loadCell();
+}
+
+bool SceneStreamer::AttachNext(Cell& cell)
+{
+    if (!cell.node_)
+    {
+        // Empty cells are not attached
+        if (cell.prefab_.IsEmpty() && cell.children_.empty())
+            return true;
+
+        Node* cellNode = node_->CreateChild();
+        PrefabReaderFromMemory reader{cell.prefab_};
+        if (!cellNode->Load(reader))
+            URHO3D_LOGERROR("Failed to load cell {} {}", cell.index_.x_, cell.index_.y_);
+        cellNode->SetName(Format("Cell_{}_{}", cell.index_.x_, cell.index_.y_));
+        cellNode->SetTemporary(true);
+        cell.node_ = cellNode;
+        cell.prefab_.Clear();
+    }
+    else if (cell.nextChild_ < cell.children_.size())
+    {
+        Node* childNode = cell.node_->CreateChild();
+        PrefabReaderFromMemory reader{cell.children_[cell.nextChild_]};
+        if (!childNode->Load(reader))
+        {
+            URHO3D_LOGERROR("Failed to load node of cell {} {}", cell.index_.x_, cell.index_.y_);
+            childNode->Remove();
+        }
+        else
+            childNode->SetTemporary(true);
+        ++cell.nextChild_;
+    }
+
+    if (cell.nextChild_ < cell.children_.size())
+        return false;
+
+    cell.children_.clear();
+    return true;
+}
+
+float SceneStreamer::GetCellDistance(const IntVector2& index, const Vector3& position) const
+{
+    const Vector2 center = (index.ToVector2() + Vector2::ONE * 0.5f) * cellSize_;
+    return (center - Vector2{position.x_, position.z_}).Length();
+}
+
+} // namespace Urho3D
@@ -0,0 +1,130 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Scene/LogicComponent.h"
+#include "Urho3D/Scene/NodePrefab.h"
+
+#include <EASTL/shared_ptr.h>
+#include <EASTL/unordered_map.h>
+
+#include <atomic>
+
+namespace Urho3D
+{
+
+/// Callback that fills prefab of the cell. Called from worker threads. Return false if the cell is empty.
+using SceneCellLoader = ea::function<bool(const IntVector2& cell, NodePrefab& prefab)>;
+
+/// Component that streams the world partitioned into cells of XZ grid.
+/// Each cell is a prefab. Prefabs are loaded and deserialized on worker threads,
+/// top-level nodes of the cell are attached on the main thread within per-frame time budget.
+/// References between different top-level nodes of the cell are not resolved.
+class URHO3D_API SceneStreamer : public LogicComponent
+{
+    URHO3D_OBJECT(SceneStreamer, LogicComponent)
+
+public:
+    static constexpr float DefaultCellSize = 64.0f;
+    static constexpr float DefaultLoadDistance = 256.0f;
+    static constexpr float DefaultUnloadDistance = 320.0f;
+    static constexpr float DefaultAttachBudgetMs = 2.0f;
+    static constexpr unsigned DefaultMaxPendingCells = 8;
+
+    explicit SceneStreamer(Context* context);
+    ~SceneStreamer() override;
+
+    static void RegisterObject(Context* context);
+
+    /// Implement LogicComponent.
+    /// @{
+    void Update(float timeStep) override;
+    /// @}
+
+    /// Set node which position is used as streaming focus. Streamer node is used if null.
+    void SetFocusNode(Node* node) { focusNode_ = node; }
+    Node* GetFocusNode() const { return focusNode_; }
+    /// Set custom cell loader. Resource file is loaded via cell resource name format if null.
+    void SetCellLoader(SceneCellLoader loader) { cellLoader_ = ea::move(loader); }
+
+    /// Load, attach and unload cells around the position in local space of the streamer node.
+    void UpdateStreaming(const Vector3& focusPosition);
+    /// Unload all cells.
+    void UnloadAllCells();
+
+    /// Return cell that contains the position in local space.
+    IntVector2 GetCellIndex(const Vector3& position) const;
+    /// Return node of the cell. Return null if cell is not attached yet.
+    Node* GetCellNode(const IntVector2& cell) const;
+    /// Return number of completely attached cells.
+    unsigned GetNumAttachedCells() const;
+    /// Return number of cells being loaded or attached.
+    unsigned GetNumPendingCells() const;
+
+    /// Attributes.
+    /// @{
+    void SetCellSize(float size) { cellSize_ = ea::max(size, M_EPSILON); }
+    float GetCellSize() const { return cellSize_; }
+    /// Set load distance. Unload distance is raised to match if needed.
+    void SetLoadDistance(float distance);
+    float GetLoadDistance() const { return loadDistance_; }
+    /// Set unload distance. Values below load distance are rejected to avoid reloading cells every frame.
+    void SetUnloadDistance(float distance);
+    float GetUnloadDistance() const { return unloadDistance_; }
+    void SetAttachBudgetMs(float budget) { attachBudgetMs_ = budget; }
+    float GetAttachBudgetMs() const { return attachBudgetMs_; }
+    void SetMaxPendingCells(unsigned count) { maxPendingCells_ = ea::max(count, 1u); }
+    unsigned GetMaxPendingCells() const { return maxPendingCells_; }
+    void SetCellResourceFormat(const ea::string& format) { cellResourceFormat_ = format; }
+    const ea::string& GetCellResourceFormat() const { return cellResourceFormat_; }
+    /// @}
+
+private:
+    struct Cell
+    {
+        IntVector2 index_;
+        /// Set by worker thread when prefab is ready.
+        std::atomic_bool loaded_{};
+        /// Set by main thread when cell is unloaded before load is finished.
+        std::atomic_bool cancelled_{};
+
+        /// Root node prefab without children.
+        NodePrefab prefab_;
+        /// Top-level nodes of the cell.
+        ea::vector<NodePrefab> children_;
+        /// Index of the next child to attach.
+        unsigned nextChild_{};
+        /// Cell node, created when the cell is attached.
+        WeakPtr<Node> node_;
+        bool attached_{};
+    };
+
+    /// Post task to load the cell.
+    void StartLoading(const ea::shared_ptr<Cell>& cell);
+    /// Attach next part of the cell. Return true if the cell is completely attached.
+    bool AttachNext(Cell& cell);
+    /// Return distance from cell center to position.
+    float GetCellDistance(const IntVector2& index, const Vector3& position) const;
+
+    WeakPtr<Node> focusNode_;
+    SceneCellLoader cellLoader_;
+
+    float cellSize_{DefaultCellSize};
+    float loadDistance_{DefaultLoadDistance};
+    float unloadDistance_{DefaultUnloadDistance};
+    float attachBudgetMs_{DefaultAttachBudgetMs};
+    unsigned maxPendingCells_{DefaultMaxPendingCells};
+    ea::string cellResourceFormat_;
+
+    ea::unordered_map<IntVector2, ea::shared_ptr<Cell>> cells_;
+    /// Temporary buffers.
+    /// @{
+    ea::vector<ea::pair<float, IntVector2>> cellsToLoad_;
+    ea::vector<ea::pair<float, Cell*>> cellsToAttach_;
+    ea::vector<IntVector2> cellsToUnload_;
+    /// @}
+};
+
+} // namespace Urho3D
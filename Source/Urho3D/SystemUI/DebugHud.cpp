@@ -34,6 +34,7 @@
 #include "../Graphics/Renderer.h"
 #include "../IO/Log.h"
 #include "../RenderAPI/RenderDevice.h"
+#include "../Resource/ResourceCache.h"
 #include "../SystemUI/SystemUI.h"
 #include "../UI/UI.h"
 
@@ -170,6 +171,16 @@ void DebugHud::RenderUI(DebugHudModeFlags mode)
         ui::Text("Animations %u(%u)", stats.animations_, numChangedAnimations_[0]);
         ui::SetCursorPosX(left_offset);
 
+        if (auto cache = GetSubsystem<ResourceCache>())
+        {
+            const ResourceEvictionStats evictionStats = cache->GetEvictionStats();
+            ui::Text("Resources %s", GetFileSizeString(cache->GetTotalMemoryUse()).c_str());
+            ui::SetCursorPosX(left_offset);
+            ui::Text("Evicted %u(%u) Restored %u", evictionStats.numEvicted_, evictionStats.numSoftEvicted_,
+                evictionStats.numRestored_);
+            ui::SetCursorPosX(left_offset);
+        }
+
         for (auto i = appStats_.begin(); i != appStats_.end(); ++i)
         {
             ui::Text("%s %s", i->first.c_str(), i->second.c_str());
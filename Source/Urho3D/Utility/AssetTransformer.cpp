@@ -27,6 +27,7 @@
 #include "../IO/ArchiveSerialization.h"
 #include "../IO/Base64Archive.h"
 #include "../IO/Log.h"
+#include "../Utility/DerivedDataCache.h"
 
 #include <EASTL/sort.h>
 #include <EASTL/unordered_set.h>
@@ -146,12 +147,16 @@ bool AssetTransformer::ExecuteTransformers(const AssetTransformerInput& input, A
 }
 
 bool AssetTransformer::ExecuteTransformersAndStore(const AssetTransformerInput& input, const ea::string& outputPath,
-    AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+    AssetTransformerOutput& output, const AssetTransformerVector& transformers, DerivedDataCache* cache)
 {
     URHO3D_ASSERT(!transformers.empty());
     Context* context = transformers[0]->GetContext();
     auto fs = context->GetSubsystem<FileSystem>();
 
+    const ea::string cacheKey = cache ? cache->GetKey(input, transformers) : EMPTY_STRING;
+    if (cache && cache->Restore(cacheKey, input, outputPath, output))
+        return true;
+
     const TemporaryDir tempFolderHolder{context, input.tempPath_};
     if (!AssetTransformer::ExecuteTransformers(input, output, transformers, false))
         return false;
@@ -162,6 +167,9 @@ bool AssetTransformer::ExecuteTransformersAndStore(const AssetTransformerInput&
     for (const ea::string& fileName : copiedFiles)
         output.outputResourceNames_.push_back(fileName.substr(outputPath.length()));
 
+    if (cache)
+        cache->Store(cacheKey, input, outputPath, output);
+
     return true;
 }
 
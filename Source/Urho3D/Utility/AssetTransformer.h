@@ -32,6 +32,7 @@ namespace Urho3D
 {
 
 class AssetTransformer;
+class DerivedDataCache;
 using AssetTransformerVector = ea::vector<AssetTransformer*>;
 
 /// Transformer execution inputs (should be serializable on its own).
@@ -106,8 +107,9 @@ public:
     static bool ExecuteTransformers(const AssetTransformerInput& input, AssetTransformerOutput& output,
         const AssetTransformerVector& transformers, bool isNestedExecution);
     /// Execute transformer array on the asset and copy results in the output path.
+    /// If derived data cache is provided, results are restored from the cache if possible and stored there otherwise.
     static bool ExecuteTransformersAndStore(const AssetTransformerInput& input, const ea::string& outputPath,
-        AssetTransformerOutput& output, const AssetTransformerVector& transformers);
+        AssetTransformerOutput& output, const AssetTransformerVector& transformers, DerivedDataCache* cache = nullptr);
 
     /// Return whether the transformer can be applied to the given asset. Should be as fast as possible.
     virtual bool IsApplicable(const AssetTransformerInput& input) { return false; }
@@ -124,6 +126,9 @@ public:
 
     /// Return whether this transformer should be executed in post-processing pass.
     virtual bool IsPostTransform() { return false; }
+    /// Return version of the transformer output. Bump it whenever the output changes for the same input
+    /// and engine revision, otherwise stale results are restored from the derived data cache.
+    virtual unsigned GetVersion() const { return 0; }
 
     /// Manage requirement flavor of the transformer.
     /// @{
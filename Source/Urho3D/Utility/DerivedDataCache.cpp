@@ -0,0 +1,362 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Utility/DerivedDataCache.h"
+
+#include "Urho3D/Core/ProcessUtils.h"
+#include "Urho3D/IO/File.h"
+#include "Urho3D/IO/FileSystem.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/IO/MemoryBuffer.h"
+#include "Urho3D/IO/VectorBuffer.h"
+
+#include <EASTL/sort.h>
+
+#include "librevision.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const ea::string entryFileId = "UDDC";
+
+/// 128-bit FNV-1a hash of arbitrary data.
+/// Keys are shared between machines, so 64-bit hash is too narrow to rule out collisions.
+class ContentHasher
+{
+public:
+    void Append(const void* data, unsigned size)
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (unsigned i = 0; i < size; ++i)
+        {
+            low_ ^= bytes[i];
+            MultiplyByPrime();
+        }
+    }
+
+    void Append(unsigned value) { Append(&value, sizeof(value)); }
+
+    void Append(ea::string_view value)
+    {
+        // Length is hashed to keep adjacent strings unambiguous
+        Append(static_cast<unsigned>(value.size()));
+        Append(value.data(), value.size());
+    }
+
+    ea::string GetHashString() const { return Format("{:016x}{:016x}", high_, low_); }
+
+private:
+    /// Multiply by FNV prime 2^88 + 0x13b modulo 2^128.
+    void MultiplyByPrime()
+    {
+        static constexpr unsigned long long primeLow = 0x13b;
+
+        // Low 64 bits of the prime are small, so 64x64 product is split in 32-bit halves
+        const unsigned long long lowCarry =
+            ((low_ >> 32) * primeLow + (((low_ & 0xffffffffull) * primeLow) >> 32)) >> 32;
+        high_ = high_ * primeLow + lowCarry + (low_ << 24);
+        low_ *= primeLow;
+    }
+
+    unsigned long long high_{0x6c62272e07bb0142ull};
+    unsigned long long low_{0x62b821756295c58dull};
+};
+
+bool ReadFileContent(Context* context, const ea::string& fileName, ByteVector& data)
+{
+    File file(context);
+    if (!file.Open(fileName, FILE_READ))
+        return false;
+
+    data.resize(file.GetSize());
+    return file.Read(data.data(), data.size()) == data.size();
+}
+
+bool WriteFileContent(Context* context, const ea::string& fileName, const ByteVector& data)
+{
+    File file(context);
+    if (!file.Open(fileName, FILE_WRITE))
+        return false;
+
+    return file.Write(data.data(), data.size()) == data.size();
+}
+
+ea::string HashFileContent(Context* context, const ea::string& fileName)
+{
+    ByteVector data;
+    if (!ReadFileContent(context, fileName, data))
+        return EMPTY_STRING;
+
+    ContentHasher hasher;
+    hasher.Append(data.data(), data.size());
+    return hasher.GetHashString();
+}
+
+ea::string GetDataFolder(const AssetTransformerInput& input)
+{
+    return input.originalInputFileName_.substr(
+        0, input.originalInputFileName_.length() - input.originalResourceName_.length());
+}
+
+} // namespace
+
+DerivedDataBackend::DerivedDataBackend(Context* context)
+    : Object(context)
+{
+}
+
+DirectoryDerivedDataBackend::DirectoryDerivedDataBackend(Context* context, const ea::string& path)
+    : DerivedDataBackend(context)
+    , path_(AddTrailingSlash(path))
+{
+}
+
+ea::string DirectoryDerivedDataBackend::GetEntryFileName(const ea::string& key) const
+{
+    // Spread entries between subdirectories to keep directories small
+    return Format("{}{}/{}.ddc", path_, key.substr(0, 2), key);
+}
+
+bool DirectoryDerivedDataBackend::Load(const ea::string& key, ByteVector& data)
+{
+    const ea::string fileName = GetEntryFileName(key);
+
+    auto fs = GetSubsystem<FileSystem>();
+    if (!fs->FileExists(fileName))
+        return false;
+
+    return ReadFileContent(context_, fileName, data);
+}
+
+bool DirectoryDerivedDataBackend::Store(const ea::string& key, const ByteVector& data)
+{
+    auto fs = GetSubsystem<FileSystem>();
+
+    const ea::string fileName = GetEntryFileName(key);
+    if (!fs->CreateDirsRecursive(Urho3D::GetPath(fileName)))
+        return false;
+
+    // Write to unique temporary file and rename it so concurrent readers never see partial entry
+    const ea::string tempFileName = Format("{}.{}.tmp", fileName, GenerateUUID());
+    if (!WriteFileContent(context_, tempFileName, data))
+    {
+        fs->Delete(tempFileName);
+        return false;
+    }
+
+    if (fs->FileExists(fileName))
+        fs->Delete(fileName);
+    if (!fs->Rename(tempFileName, fileName))
+    {
+        fs->Delete(tempFileName);
+        return false;
+    }
+
+    return true;
+}
+
+DerivedDataCache::DerivedDataCache(Context* context)
+    : Object(context)
+{
+}
+
+ea::string DerivedDataCache::GetKey(
+    const AssetTransformerInput& input, const AssetTransformerVector& transformers) const
+{
+    // Post-transformers read files by pattern, so their inputs are not known in advance
+    if (input.isPostTransform_)
+        return EMPTY_STRING;
+
+    ByteVector content;
+    if (!ReadFileContent(context_, input.inputFileName_, content))
+        return EMPTY_STRING;
+
+    ContentHasher hasher;
+    hasher.Append(entryFileId);
+    hasher.Append(FormatVersion);
+    hasher.Append(ea::string_view{revision});
+
+    hasher.Append(input.flavor_.ToString());
+    hasher.Append(input.resourceName_);
+    hasher.Append(input.outputResourceName_);
+    hasher.Append(static_cast<unsigned>(content.size()));
+    hasher.Append(content.data(), content.size());
+
+    VectorBuffer attributes;
+    for (AssetTransformer* transformer : transformers)
+    {
+        attributes.Clear();
+        transformer->Save(attributes);
+
+        hasher.Append(transformer->GetTypeName());
+        hasher.Append(transformer->GetVersion());
+        hasher.Append(static_cast<unsigned>(attributes.GetSize()));
+        hasher.Append(attributes.GetData(), attributes.GetSize());
+    }
+
+    return hasher.GetHashString();
+}
+
+bool DerivedDataCache::LoadEntry(const ea::string& key, ByteVector& data)
+{
+    if (localBackend_ && localBackend_->Load(key, data))
+        return true;
+
+    if (remoteBackend_ && remoteBackend_->Load(key, data))
+    {
+        numRemoteHits_.fetch_add(1, std::memory_order_relaxed);
+        if (localBackend_)
+            localBackend_->Store(key, data);
+        return true;
+    }
+
+    return false;
+}
+
+bool DerivedDataCache::Restore(const ea::string& key, const AssetTransformerInput& input,
+    const ea::string& outputPath, AssetTransformerOutput& output)
+{
+    if (key.empty())
+        return false;
+
+    ByteVector data;
+    if (!LoadEntry(key, data))
+    {
+        numMisses_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const auto miss = [&]
+    {
+        numMisses_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    };
+
+    MemoryBuffer source(data);
+    if (source.ReadFileID() != entryFileId || source.ReadVLE() != FormatVersion)
+        return miss();
+    if (source.ReadString() != key || source.ReadString() != input.resourceName_)
+        return miss();
+
+    AssetTransformerOutput result;
+
+    const unsigned numAppliedTransformers = source.ReadVLE();
+    for (unsigned i = 0; i < numAppliedTransformers && !source.IsEof(); ++i)
+        result.appliedTransformers_.insert(source.ReadString());
+
+    // Dependencies are not part of the key, so they are validated here
+    auto fs = GetSubsystem<FileSystem>();
+    const ea::string dataFolder = GetDataFolder(input);
+    const unsigned numDependencies = source.ReadVLE();
+    for (unsigned i = 0; i < numDependencies; ++i)
+    {
+        const ea::string dependencyName = source.ReadString();
+        const ea::string contentHash = source.ReadString();
+        if (source.IsEof() || HashFileContent(context_, dataFolder + dependencyName) != contentHash)
+            return miss();
+
+        result.dependencyModificationTimes_[dependencyName] =
+            fs->GetLastModifiedTime(dataFolder + dependencyName, true);
+    }
+
+    const unsigned numFiles = source.ReadVLE();
+    if (numFiles > source.GetSize() - source.GetPosition())
+        return miss();
+
+    ea::vector<ea::pair<ea::string, ByteVector>> files(numFiles);
+    for (auto& [fileName, content] : files)
+    {
+        fileName = source.ReadString();
+        const unsigned size = source.ReadVLE();
+        if (fileName.empty() || size > source.GetSize() - source.GetPosition())
+            return miss();
+
+        content.resize(size);
+        source.Read(content.data(), size);
+    }
+
+    for (const auto& [fileName, content] : files)
+    {
+        const ea::string outputFileName = outputPath + fileName;
+        if (!fs->CreateDirsRecursive(GetPath(outputFileName)) || !WriteFileContent(context_, outputFileName, content))
+        {
+            URHO3D_LOGERROR("Failed to write cached output '{}' of asset '{}'", outputFileName, input.resourceName_);
+            return miss();
+        }
+        result.outputResourceNames_.push_back(fileName);
+    }
+
+    output = ea::move(result);
+    numHits_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool DerivedDataCache::Store(const ea::string& key, const AssetTransformerInput& input,
+    const ea::string& outputPath, const AssetTransformerOutput& output)
+{
+    if (key.empty() || (!localBackend_ && !remoteBackend_))
+        return false;
+
+    // Side effects outside of the output directory cannot be replayed
+    if (output.sourceModified_ || !output.modifiedResourceNames_.empty())
+        return false;
+
+    VectorBuffer dest;
+    dest.WriteFileID(entryFileId);
+    dest.WriteVLE(FormatVersion);
+    dest.WriteString(key);
+    dest.WriteString(input.resourceName_);
+
+    StringVector appliedTransformers(output.appliedTransformers_.begin(), output.appliedTransformers_.end());
+    ea::sort(appliedTransformers.begin(), appliedTransformers.end());
+    dest.WriteVLE(appliedTransformers.size());
+    for (const ea::string& transformer : appliedTransformers)
+        dest.WriteString(transformer);
+
+    const ea::string dataFolder = GetDataFolder(input);
+    StringVector dependencies;
+    for (const auto& [dependencyName, _] : output.dependencyModificationTimes_)
+        dependencies.push_back(dependencyName);
+    ea::sort(dependencies.begin(), dependencies.end());
+    dest.WriteVLE(dependencies.size());
+    for (const ea::string& dependencyName : dependencies)
+    {
+        dest.WriteString(dependencyName);
+        dest.WriteString(HashFileContent(context_, dataFolder + dependencyName));
+    }
+
+    ByteVector content;
+    dest.WriteVLE(output.outputResourceNames_.size());
+    for (const ea::string& fileName : output.outputResourceNames_)
+    {
+        if (!ReadFileContent(context_, outputPath + fileName, content))
+            return false;
+
+        dest.WriteString(fileName);
+        dest.WriteBuffer(content);
+    }
+
+    bool success = false;
+    if (localBackend_)
+        success = localBackend_->Store(key, dest.GetBuffer()) || success;
+    if (remoteBackend_)
+        success = remoteBackend_->Store(key, dest.GetBuffer()) || success;
+    return success;
+}
+
+void DerivedDataCache::ResetStats()
+{
+    numHits_ = 0;
+    numRemoteHits_ = 0;
+    numMisses_ = 0;
+}
+
+} // namespace Urho3D
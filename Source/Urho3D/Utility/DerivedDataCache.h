@@ -0,0 +1,107 @@
+// Copyright (c) 2026-2026 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Container/ByteVector.h"
+#include "Urho3D/Core/Object.h"
+#include "Urho3D/Utility/AssetTransformer.h"
+
+#include <atomic>
+
+namespace Urho3D
+{
+
+/// Storage of derived data cache entries. Should be safe to call from multiple threads.
+class URHO3D_API DerivedDataBackend : public Object
+{
+    URHO3D_OBJECT(DerivedDataBackend, Object);
+
+public:
+    explicit DerivedDataBackend(Context* context);
+
+    /// Load entry with the given key. Return false if there is no such entry.
+    virtual bool Load(const ea::string& key, ByteVector& data) = 0;
+    /// Store entry with the given key. Existing entry is replaced.
+    virtual bool Store(const ea::string& key, const ByteVector& data) = 0;
+};
+
+/// Backend that stores entries as files in the directory.
+/// The directory may be local or shared between machines, e.g. mounted from file server.
+class URHO3D_API DirectoryDerivedDataBackend : public DerivedDataBackend
+{
+    URHO3D_OBJECT(DirectoryDerivedDataBackend, DerivedDataBackend);
+
+public:
+    DirectoryDerivedDataBackend(Context* context, const ea::string& path);
+
+    /// Implement DerivedDataBackend.
+    /// @{
+    bool Load(const ea::string& key, ByteVector& data) override;
+    bool Store(const ea::string& key, const ByteVector& data) override;
+    /// @}
+
+    const ea::string& GetPath() const { return path_; }
+
+private:
+    ea::string GetEntryFileName(const ea::string& key) const;
+
+    const ea::string path_;
+};
+
+/// Content-addressed cache of asset transformer outputs.
+/// Key is the hash of input file content, resource name, flavor, engine revision,
+/// transformer types, versions and attributes.
+/// Files used by transformers via dependencies are not part of the key, they are validated by content on lookup.
+/// Post-transform pass is not cached.
+/// Entries are looked up in the local backend first, then in the remote backend.
+/// Entries found in the remote backend are copied to the local one.
+class URHO3D_API DerivedDataCache : public Object
+{
+    URHO3D_OBJECT(DerivedDataCache, Object);
+
+public:
+    /// Version of the entry format. Entries of other versions are never matched.
+    static constexpr unsigned FormatVersion = 2;
+
+    explicit DerivedDataCache(Context* context);
+
+    /// Set backends. Cache is disabled if there are no backends.
+    /// @{
+    void SetLocalBackend(DerivedDataBackend* backend) { localBackend_ = backend; }
+    DerivedDataBackend* GetLocalBackend() const { return localBackend_; }
+    void SetRemoteBackend(DerivedDataBackend* backend) { remoteBackend_ = backend; }
+    DerivedDataBackend* GetRemoteBackend() const { return remoteBackend_; }
+    /// @}
+
+    /// Return key of transformers execution on the asset.
+    /// Return empty string if the asset cannot be read or if the execution cannot be cached.
+    ea::string GetKey(const AssetTransformerInput& input, const AssetTransformerVector& transformers) const;
+    /// Write cached output files to the output path and fill the output. Return false on cache miss.
+    bool Restore(const ea::string& key, const AssetTransformerInput& input, const ea::string& outputPath,
+        AssetTransformerOutput& output);
+    /// Store output files from the output path. Outputs that modify other files are not cached.
+    bool Store(const ea::string& key, const AssetTransformerInput& input, const ea::string& outputPath,
+        const AssetTransformerOutput& output);
+
+    /// Return statistics.
+    /// @{
+    unsigned GetNumHits() const { return numHits_.load(std::memory_order_relaxed); }
+    unsigned GetNumRemoteHits() const { return numRemoteHits_.load(std::memory_order_relaxed); }
+    unsigned GetNumMisses() const { return numMisses_.load(std::memory_order_relaxed); }
+    void ResetStats();
+    /// @}
+
+private:
+    bool LoadEntry(const ea::string& key, ByteVector& data);
+
+    SharedPtr<DerivedDataBackend> localBackend_;
+    SharedPtr<DerivedDataBackend> remoteBackend_;
+
+    std::atomic<unsigned> numHits_{};
+    std::atomic<unsigned> numRemoteHits_{};
+    std::atomic<unsigned> numMisses_{};
+};
+
+} // namespace Urho3D